@@ -0,0 +1,488 @@
+/******************************************************************************
+  * @file    CMix_blackbox.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix故障黑匣子模块实现文件
+  *          实现波形采集环、故障触发冻结、快照后台写入和分块读出
+  ******************************************************************************
+  * @attention
+  *
+  * CMix故障黑匣子模块实现
+  * post_remaining是采集与写入之间唯一的握手: 0xFFFF为连续采集, 触发后置为
+  * 触发后样本数并逐个递减, 减到0即冻结, 控制中断不再写环. 后台任务看到冻结
+  * 后才读环, 写入完成后重新置为0xFFFF. 触发在关中断下检查并设置, 两个保护
+  * 中断同时触发时只有先到的生效.
+  *
+  * 快照按字写入的顺序: 样本 (按时间顺序), 快照头第1~7字, 最后是标识字.
+  * 样本的CRC随写入分段计算, 不需要把环复制成连续缓冲.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_blackbox.h"
+#include "CMix_crc.h"
+#include "CMix_main.h"
+
+#if CMIX_BLACKBOX_ENABLE
+
+/* ========================= 私有定义 ========================= */
+
+#define CMIX_BLACKBOX_MASK              (CMIX_BLACKBOX_SAMPLES - 1)
+#define CMIX_BLACKBOX_FREE_RUNNING      0xFFFF          // post_remaining: 连续采集
+#define CMIX_BLACKBOX_SAMPLE_WORDS      (sizeof(CMix_Blackbox_Sample_t) / 4)
+#define CMIX_BLACKBOX_PAGE_COUNT        (CMIX_BLACKBOX_FLASH_SIZE / CMIX_BLACKBOX_PAGE_SIZE)
+#define CMIX_BLACKBOX_BLANK             0xFFFFFFFFU
+#define CMIX_BLACKBOX_IFMC_LOCK_KEY     0xEA2D0000U     // KR2上锁键 (IFMC_ErasePage返回时未上锁)
+
+#define CMIX_BLACKBOX_WORD_ADDR(word)   (CMIX_BLACKBOX_FLASH_BASE + (uint32_t)(word) * 4)
+
+/* 黑匣子状态 */
+typedef struct {
+    volatile uint32_t head;                 // 环写入位置 (自由递增, 仅控制中断修改)
+    volatile uint16_t post_remaining;       // 触发后还需采集的样本数 (0 = 冻结, 0xFFFF = 连续采集)
+    uint32_t arm_head;                      // 开始采集时的写入位置 (环未写满时限制触发前样本数)
+    uint32_t trigger_head;                  // 触发时的写入位置
+    uint32_t trigger_ms;
+    uint8_t fault_code;
+
+    CMix_Blackbox_Header_t header;          // 正在写入的快照头
+    uint32_t first;                         // 快照第一个样本的环位置
+    uint16_t image_words;                   // 快照字数 (快照头+样本)
+    uint16_t program_pos;                   // 写入顺序中的下一字
+    uint16_t crc;                           // 已写入样本的CRC
+    bool committing;                        // 冻结窗口待写入或写入中
+    bool clear_pending;                     // 协议请求清除快照区
+
+    uint8_t region;                         // 快照区状态
+    uint8_t erase_page;                     // 擦除进度 (下一个擦除的页)
+    uint32_t last_sequence;                 // 最大快照序号
+    bool ready;
+} CMix_Blackbox_t;
+
+/* ========================= 私有变量 ========================= */
+
+static CMix_Blackbox_Sample_t g_blackbox_ring[CMIX_BLACKBOX_SAMPLES];
+static CMix_Blackbox_t g_blackbox;
+static CMix_Blackbox_Stats_t g_blackbox_stats;
+
+/* ========================= 私有函数声明 ========================= */
+
+static void CMix_Blackbox_Scan(void);
+static bool CMix_Blackbox_Region_Blank(void);
+static void CMix_Blackbox_Freeze(void);
+static uint32_t CMix_Blackbox_Image_Word(uint16_t word);
+static uint16_t CMix_Blackbox_Order_Word(uint16_t pos);
+static void CMix_Blackbox_Program_Next(void);
+static void CMix_Blackbox_Erase_Next(void);
+static void CMix_Blackbox_Arm(void);
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 启动扫描快照区并开始采集
+ * @param None
+ * @retval None
+ * @note  需在CMix_CRC_Init之后调用. 调用前采集和触发均不动作
+ */
+void CMix_Blackbox_Init(void)
+{
+    g_blackbox.post_remaining = 0;
+    memset(&g_blackbox_stats, 0, sizeof(g_blackbox_stats));
+    g_blackbox.committing = false;
+    g_blackbox.clear_pending = false;
+    g_blackbox.erase_page = 0;
+    g_blackbox.last_sequence = 0;
+
+    CMix_Blackbox_Scan();
+
+    g_blackbox.ready = true;
+    CMix_Blackbox_Arm();
+}
+
+/**
+ * @brief 采集一个样本 (控制步结束时调用)
+ * @param status: DCDC状态 (本控制步的测量值和输出)
+ * @retval None
+ * @note  冻结时直接返回. 电压/电流只做移位, 不做除法和限幅
+ */
+void CMix_Blackbox_Capture(const CMix_DCDC_Status_t *status)
+{
+    uint16_t post = g_blackbox.post_remaining;
+    CMix_Blackbox_Sample_t *sample;
+
+    if (post == 0) {
+        return;
+    }
+
+    sample = &g_blackbox_ring[g_blackbox.head & CMIX_BLACKBOX_MASK];
+    sample->vin = (uint16_t)(status->input_voltage >> CMIX_BLACKBOX_VOLTAGE_SHIFT);
+    sample->vout = (uint16_t)(status->output_voltage >> CMIX_BLACKBOX_VOLTAGE_SHIFT);
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    sample->ia = (int16_t)(status->phase_current_a >> CMIX_BLACKBOX_CURRENT_SHIFT);
+    sample->ib = (int16_t)(status->phase_current_b >> CMIX_BLACKBOX_CURRENT_SHIFT);
+#else
+    sample->ia = (int16_t)((int32_t)status->input_current >> CMIX_BLACKBOX_CURRENT_SHIFT);
+    sample->ib = (int16_t)((int32_t)status->output_current >> CMIX_BLACKBOX_CURRENT_SHIFT);
+#endif
+    sample->duty = (uint16_t)(status->pwm_duty_buck + status->pwm_duty_boost);
+    sample->state = (uint16_t)((uint8_t)status->state | ((uint16_t)status->active_mode << 8));
+    g_blackbox.head++;
+
+    /* 读取后被触发抢占时post为连续采集, 不覆盖触发设置的计数 */
+    if (post != CMIX_BLACKBOX_FREE_RUNNING) {
+        g_blackbox.post_remaining = post - 1;
+    }
+}
+
+/**
+ * @brief 故障触发: 再采集CMIX_BLACKBOX_POST_SAMPLES个样本后冻结
+ * @param fault_code: 故障代码 (写入快照头)
+ * @retval None
+ * @note  由进入故障状态的路径调用 (保护中断或控制步). 已触发、冻结或写入期间忽略
+ */
+void CMix_Blackbox_Trigger(uint8_t fault_code)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (g_blackbox.post_remaining != CMIX_BLACKBOX_FREE_RUNNING) {
+        g_blackbox_stats.ignored++;
+    } else {
+        g_blackbox.trigger_head = g_blackbox.head;
+        g_blackbox.trigger_ms = CMix_Main_Get_System_Tick();
+        g_blackbox.fault_code = fault_code;
+        g_blackbox.post_remaining = CMIX_BLACKBOX_POST_SAMPLES;
+        g_blackbox_stats.triggers++;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 后台写入: 至多执行一次Flash操作
+ * @param program_ok: 允许写入 (CPU停顿两个字编程时间)
+ * @param erase_ok: 允许擦除 (CPU停顿一次页擦除时间)
+ * @retval None
+ * @note  快照区非空时先逐页擦除, 再按写入顺序每次写两字
+ */
+void CMix_Blackbox_Step(bool program_ok, bool erase_ok)
+{
+    if (!g_blackbox.ready) {
+        return;
+    }
+
+    if (!g_blackbox.committing && g_blackbox.post_remaining == 0) {
+        CMix_Blackbox_Freeze();
+    }
+
+    if (g_blackbox.committing) {
+        if (g_blackbox.program_pos == 0 && g_blackbox.region != CMIX_BLACKBOX_REGION_BLANK) {
+            if (erase_ok) {
+                CMix_Blackbox_Erase_Next();
+            }
+        } else if (program_ok) {
+            CMix_Blackbox_Program_Next();
+        }
+    } else if (g_blackbox.clear_pending) {
+        if (g_blackbox.region == CMIX_BLACKBOX_REGION_BLANK) {
+            g_blackbox.clear_pending = false;
+        } else if (erase_ok) {
+            CMix_Blackbox_Erase_Next();
+        }
+    }
+}
+
+/**
+ * @brief 是否有冻结窗口待写入或正在写入
+ * @param None
+ * @retval true = 忙
+ */
+bool CMix_Blackbox_Is_Busy(void)
+{
+    return g_blackbox.committing || g_blackbox.post_remaining == 0;
+}
+
+/**
+ * @brief 请求清除快照区 (后台擦除, 之后的故障快照无需等待擦除即可写入)
+ * @param None
+ * @retval true = 已接受, false = 正在写入快照
+ */
+bool CMix_Blackbox_Clear(void)
+{
+    if (!g_blackbox.ready || CMix_Blackbox_Is_Busy()) {
+        return false;
+    }
+    if (g_blackbox.region != CMIX_BLACKBOX_REGION_BLANK) {
+        g_blackbox.clear_pending = true;
+        g_blackbox.erase_page = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief 快照分块数
+ * @param None
+ * @retval 分块数 (0 = 快照区无完整快照)
+ */
+uint8_t CMix_Blackbox_Get_Chunk_Count(void)
+{
+    uint32_t bytes;
+
+    if (!g_blackbox.ready || g_blackbox.region != CMIX_BLACKBOX_REGION_STORED || g_blackbox.clear_pending) {
+        return 0;
+    }
+    bytes = (uint32_t)(CMIX_BLACKBOX_HEADER_WORDS * 4) + (uint32_t)g_blackbox_stats.pre_samples * sizeof(CMix_Blackbox_Sample_t) +
+            (uint32_t)g_blackbox_stats.post_samples * sizeof(CMix_Blackbox_Sample_t);
+    return (uint8_t)((bytes + CMIX_BLACKBOX_CHUNK_BYTES - 1) / CMIX_BLACKBOX_CHUNK_BYTES);
+}
+
+/**
+ * @brief 读出一块快照 (Flash原样, 小端)
+ * @param index: 块序号
+ * @param buffer: 输出缓冲 (不小于CMIX_BLACKBOX_CHUNK_BYTES)
+ * @retval 块字节数 (0 = 序号无效), 最后一块可能不足CMIX_BLACKBOX_CHUNK_BYTES
+ */
+uint8_t CMix_Blackbox_Read_Chunk(uint8_t index, uint8_t *buffer)
+{
+    uint8_t count = CMix_Blackbox_Get_Chunk_Count();
+    uint32_t offset = (uint32_t)index * CMIX_BLACKBOX_CHUNK_BYTES;
+    uint32_t end = (uint32_t)(CMIX_BLACKBOX_HEADER_WORDS * 4) +
+                   ((uint32_t)g_blackbox_stats.pre_samples + g_blackbox_stats.post_samples) * sizeof(CMix_Blackbox_Sample_t);
+    uint8_t length = 0;
+
+    if (index >= count) {
+        return 0;
+    }
+    while (length < CMIX_BLACKBOX_CHUNK_BYTES && offset < end) {
+        uint32_t word = IFMC_ReadWord(CMIX_BLACKBOX_FLASH_BASE + offset);
+
+        buffer[length++] = (uint8_t)(word & 0xFF);
+        buffer[length++] = (uint8_t)((word >> 8) & 0xFF);
+        buffer[length++] = (uint8_t)((word >> 16) & 0xFF);
+        buffer[length++] = (uint8_t)(word >> 24);
+        offset += 4;
+    }
+    return length;
+}
+
+/**
+ * @brief 获取黑匣子统计
+ * @param stats: 统计输出指针
+ * @retval None
+ */
+void CMix_Blackbox_Get_Stats(CMix_Blackbox_Stats_t *stats)
+{
+    *stats = g_blackbox_stats;
+    stats->region = g_blackbox.region;
+    stats->capturing = (g_blackbox.ready && !CMix_Blackbox_Is_Busy()) ? 1 : 0;
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 启动扫描: 快照头完整且CRC正确为有效快照, 全空为已擦除, 其余待擦除
+ */
+static void CMix_Blackbox_Scan(void)
+{
+    CMix_Blackbox_Header_t header;
+    uint32_t *words = (uint32_t *)&header;
+    uint16_t count, i, crc = CMIX_CRC16_MODBUS_INIT;
+
+    for (i = 0; i < CMIX_BLACKBOX_HEADER_WORDS; i++) {
+        words[i] = IFMC_ReadWord(CMIX_BLACKBOX_WORD_ADDR(i));
+    }
+    count = (uint16_t)(header.info >> 16);
+
+    if (header.magic == CMIX_BLACKBOX_MAGIC && ((header.info >> 8) & 0xFF) == CMIX_BLACKBOX_VERSION &&
+        count <= CMIX_BLACKBOX_SAMPLES && count == (header.window & 0xFFFF) + (header.window >> 16)) {
+        for (i = 0; i < count * CMIX_BLACKBOX_SAMPLE_WORDS; i++) {
+            uint32_t word = IFMC_ReadWord(CMIX_BLACKBOX_WORD_ADDR(CMIX_BLACKBOX_HEADER_WORDS + i));
+            crc = CMix_CRC16_Modbus_Update(crc, (const uint8_t *)&word, 4);
+        }
+        crc = CMix_CRC16_Modbus_Update(crc, (const uint8_t *)&words[1], 6 * 4);
+        if (header.crc == crc) {
+            g_blackbox.region = CMIX_BLACKBOX_REGION_STORED;
+            g_blackbox.last_sequence = header.sequence;
+            g_blackbox_stats.sequence = header.sequence;
+            g_blackbox_stats.trigger_ms = header.trigger_ms;
+            g_blackbox_stats.fault_code = (uint8_t)(header.info & 0xFF);
+            g_blackbox_stats.pre_samples = (uint16_t)(header.window & 0xFFFF);
+            g_blackbox_stats.post_samples = (uint16_t)(header.window >> 16);
+            return;
+        }
+    }
+
+    g_blackbox.region = CMix_Blackbox_Region_Blank() ? CMIX_BLACKBOX_REGION_BLANK : CMIX_BLACKBOX_REGION_DIRTY;
+}
+
+/**
+ * @brief 检查整个快照区是否为已擦除状态
+ */
+static bool CMix_Blackbox_Region_Blank(void)
+{
+    uint32_t address;
+
+    for (address = CMIX_BLACKBOX_FLASH_BASE; address < CMIX_BLACKBOX_FLASH_BASE + CMIX_BLACKBOX_FLASH_SIZE; address += 4) {
+        if (IFMC_ReadWord(address) != CMIX_BLACKBOX_BLANK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 冻结: 确定快照窗口并生成快照头 (CRC在样本写完后补上)
+ * @note  环未写满 (采集开始后不足一环即触发) 时触发前样本数相应减少
+ */
+static void CMix_Blackbox_Freeze(void)
+{
+    uint32_t captured = g_blackbox.trigger_head - g_blackbox.arm_head;
+    uint16_t pre = (captured < CMIX_BLACKBOX_SAMPLES - CMIX_BLACKBOX_POST_SAMPLES) ?
+                   (uint16_t)captured : (uint16_t)(CMIX_BLACKBOX_SAMPLES - CMIX_BLACKBOX_POST_SAMPLES);
+    uint16_t count = pre + CMIX_BLACKBOX_POST_SAMPLES;
+
+    g_blackbox.first = g_blackbox.trigger_head - pre;
+    g_blackbox.image_words = (uint16_t)(CMIX_BLACKBOX_HEADER_WORDS + count * CMIX_BLACKBOX_SAMPLE_WORDS);
+    g_blackbox.program_pos = 0;
+    g_blackbox.crc = CMIX_CRC16_MODBUS_INIT;
+    g_blackbox.erase_page = 0;
+    g_blackbox.clear_pending = false;
+
+    g_blackbox.header.magic = CMIX_BLACKBOX_MAGIC;
+    g_blackbox.header.sequence = g_blackbox.last_sequence + 1;
+    g_blackbox.header.trigger_ms = g_blackbox.trigger_ms;
+    g_blackbox.header.info = (uint32_t)g_blackbox.fault_code | ((uint32_t)CMIX_BLACKBOX_VERSION << 8) |
+                             ((uint32_t)count << 16);
+    g_blackbox.header.window = (uint32_t)pre | ((uint32_t)CMIX_BLACKBOX_POST_SAMPLES << 16);
+    g_blackbox.header.rate_hz = (uint32_t)CMIX_CONTROL_RATE_HZ;
+    g_blackbox.header.scale = (uint32_t)CMIX_BLACKBOX_VOLTAGE_SHIFT | ((uint32_t)CMIX_BLACKBOX_CURRENT_SHIFT << 8) |
+                              ((uint32_t)sizeof(CMix_Blackbox_Sample_t) << 16);
+    g_blackbox.header.crc = CMIX_BLACKBOX_BLANK;
+    g_blackbox.committing = true;
+}
+
+/**
+ * @brief 快照第word字 (快照头或按时间顺序的样本)
+ */
+static uint32_t CMix_Blackbox_Image_Word(uint16_t word)
+{
+    const uint8_t *bytes;
+    uint16_t index;
+
+    if (word < CMIX_BLACKBOX_HEADER_WORDS) {
+        return ((const uint32_t *)&g_blackbox.header)[word];
+    }
+    index = (uint16_t)(word - CMIX_BLACKBOX_HEADER_WORDS);
+    bytes = (const uint8_t *)&g_blackbox_ring[(g_blackbox.first + index / CMIX_BLACKBOX_SAMPLE_WORDS) & CMIX_BLACKBOX_MASK] +
+            (index % CMIX_BLACKBOX_SAMPLE_WORDS) * 4;
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/**
+ * @brief 写入顺序: 样本, 快照头第1~7字, 标识字
+ * @param pos: 写入顺序中的位置
+ * @retval 快照中的字序号
+ */
+static uint16_t CMix_Blackbox_Order_Word(uint16_t pos)
+{
+    uint16_t sample_words = (uint16_t)(g_blackbox.image_words - CMIX_BLACKBOX_HEADER_WORDS);
+
+    if (pos < sample_words) {
+        return (uint16_t)(CMIX_BLACKBOX_HEADER_WORDS + pos);
+    }
+    if (pos < g_blackbox.image_words - 1) {
+        return (uint16_t)(1 + pos - sample_words);
+    }
+    return 0;
+}
+
+/**
+ * @brief 按写入顺序写入下一段 (至多两个连续字) 并回读校验
+ * @note  校验失败时放弃本次写入, 快照区待擦除后从头重写
+ */
+static void CMix_Blackbox_Program_Next(void)
+{
+    uint16_t sample_words = (uint16_t)(g_blackbox.image_words - CMIX_BLACKBOX_HEADER_WORDS);
+    uint16_t word, i;
+    uint32_t data[2];
+    uint8_t count = 1;
+
+    /* 样本写完: 补上快照头CRC */
+    if (g_blackbox.program_pos == sample_words) {
+        g_blackbox.header.crc = CMix_CRC16_Modbus_Update(g_blackbox.crc, (const uint8_t *)&g_blackbox.header.sequence, 6 * 4);
+    }
+
+    word = CMix_Blackbox_Order_Word(g_blackbox.program_pos);
+    data[0] = CMix_Blackbox_Image_Word(word);
+    if (g_blackbox.program_pos + 1 < g_blackbox.image_words &&
+        CMix_Blackbox_Order_Word(g_blackbox.program_pos + 1) == word + 1) {
+        data[1] = CMix_Blackbox_Image_Word(word + 1);
+        count = 2;
+    }
+
+    g_blackbox.region = CMIX_BLACKBOX_REGION_DIRTY;
+    IFMC_ProgramWords(CMIX_BLACKBOX_WORD_ADDR(word), data, count);
+    for (i = 0; i < count; i++) {
+        if (IFMC_ReadWord(CMIX_BLACKBOX_WORD_ADDR(word + i)) != data[i]) {
+            g_blackbox_stats.program_errors++;
+            g_blackbox.program_pos = 0;
+            g_blackbox.crc = CMIX_CRC16_MODBUS_INIT;
+            g_blackbox.erase_page = 0;
+            return;
+        }
+    }
+
+    if (word >= CMIX_BLACKBOX_HEADER_WORDS) {
+        g_blackbox.crc = CMix_CRC16_Modbus_Update(g_blackbox.crc, (const uint8_t *)data, (uint16_t)(count * 4));
+    }
+    g_blackbox.program_pos += count;
+
+    if (g_blackbox.program_pos >= g_blackbox.image_words) {
+        g_blackbox.region = CMIX_BLACKBOX_REGION_STORED;
+        g_blackbox.last_sequence = g_blackbox.header.sequence;
+        g_blackbox_stats.sequence = g_blackbox.header.sequence;
+        g_blackbox_stats.trigger_ms = g_blackbox.header.trigger_ms;
+        g_blackbox_stats.fault_code = (uint8_t)(g_blackbox.header.info & 0xFF);
+        g_blackbox_stats.pre_samples = (uint16_t)(g_blackbox.header.window & 0xFFFF);
+        g_blackbox_stats.post_samples = (uint16_t)(g_blackbox.header.window >> 16);
+        g_blackbox_stats.commits++;
+        g_blackbox.committing = false;
+        CMix_Blackbox_Arm();
+    }
+}
+
+/**
+ * @brief 擦除快照区下一页, 最后一页擦除后检查整个快照区
+ */
+static void CMix_Blackbox_Erase_Next(void)
+{
+    IFMC_ErasePage(CMIX_BLACKBOX_FLASH_BASE + (uint32_t)g_blackbox.erase_page * CMIX_BLACKBOX_PAGE_SIZE);
+    IFMC->KR2 = CMIX_BLACKBOX_IFMC_LOCK_KEY;
+    while ((IFMC->KR2 & IFMC_KR2_LOCK1) == 0);
+    g_blackbox_stats.erases++;
+
+    if (++g_blackbox.erase_page < CMIX_BLACKBOX_PAGE_COUNT) {
+        g_blackbox.region = CMIX_BLACKBOX_REGION_DIRTY;
+        return;
+    }
+    g_blackbox.erase_page = 0;
+    if (CMix_Blackbox_Region_Blank()) {
+        g_blackbox.region = CMIX_BLACKBOX_REGION_BLANK;
+        g_blackbox_stats.sequence = 0;
+    } else {
+        g_blackbox_stats.program_errors++;
+    }
+}
+
+/**
+ * @brief 重新开始采集 (环内容作废)
+ */
+static void CMix_Blackbox_Arm(void)
+{
+    g_blackbox.arm_head = g_blackbox.head;
+    g_blackbox.post_remaining = CMIX_BLACKBOX_FREE_RUNNING;
+}
+
+#endif /* CMIX_BLACKBOX_ENABLE */
@@ -0,0 +1,114 @@
+/******************************************************************************
+  * @file    CMix_blackbox.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix故障黑匣子模块头文件
+  *          控制中断连续记录最近的波形样本, 故障后冻结, 快照后台写入内部Flash
+  ******************************************************************************
+  * @attention
+  *
+  * CMix故障黑匣子模块
+  * 采集: 控制步结束时向RAM环写入一个样本, 只有移位和存储, 常开. 进入故障
+  * 状态时记下触发位置, 再采集CMIX_BLACKBOX_POST_SAMPLES个样本后冻结.
+  *
+  * 写入: 后台任务把冻结的窗口按时间顺序写入快照区 (每次至多一次Flash操作),
+  * 快照头最后写入, 写入中途掉电的快照在启动扫描时被丢弃. 快照区只保存一份,
+  * 新快照覆盖旧快照; 写入完成后RAM环重新开始采集. 冻结和写入期间的触发被忽略.
+  *
+  * 读出: 协议命令按CMIX_BLACKBOX_CHUNK_BYTES分块读出快照原样 (快照头+样本).
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_BLACKBOX_H
+#define __CMIX_BLACKBOX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CMix_config.h"
+#include "CMix_dcdc.h"
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_BLACKBOX_MAGIC         0x42584D43U     // 快照头标识 "CMXB"
+#define CMIX_BLACKBOX_VERSION       1               // 快照格式版本
+#define CMIX_BLACKBOX_HEADER_WORDS  8               // 快照头字数
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 波形样本 (12字节, 小端, 快照中按时间顺序排列) */
+typedef struct {
+    uint16_t vin;                           // 输入电压 (单位1mV << CMIX_BLACKBOX_VOLTAGE_SHIFT)
+    uint16_t vout;                          // 输出电压 (同上)
+    int16_t  ia;                            // 电流A (单位1mA << CMIX_BLACKBOX_CURRENT_SHIFT): 两相交错为相A, 否则为输入电流
+    int16_t  ib;                            // 电流B: 两相交错为相B, 否则为输出电流
+    uint16_t duty;                          // 占空比 (0-10000): BUCK与BOOST之和, 两者不同时非零
+    uint16_t state;                         // 系统状态[7:0] | 激活模式[15:8]
+} CMix_Blackbox_Sample_t;
+
+/* 快照头 (快照区开头, 各字小端) */
+typedef struct {
+    uint32_t magic;                         // CMIX_BLACKBOX_MAGIC, 最后写入
+    uint32_t sequence;                      // 快照序号
+    uint32_t trigger_ms;                    // 触发时的系统时间 (ms)
+    uint32_t info;                          // 故障代码[7:0] | 格式版本[15:8] | 样本数[31:16]
+    uint32_t window;                        // 触发前样本数[15:0] | 触发后样本数[31:16]
+    uint32_t rate_hz;                       // 采样频率 (控制频率)
+    uint32_t scale;                         // 电压移位[7:0] | 电流移位[15:8] | 样本字节数[23:16]
+    uint32_t crc;                           // CRC16-Modbus[15:0]: 全部样本, 然后sequence~scale
+} CMix_Blackbox_Header_t;
+
+/* 快照区状态 */
+typedef enum {
+    CMIX_BLACKBOX_REGION_BLANK = 0,         // 已擦除, 可直接写入
+    CMIX_BLACKBOX_REGION_STORED,            // 有完整快照
+    CMIX_BLACKBOX_REGION_DIRTY              // 写入中或写入中断, 需擦除
+} CMix_Blackbox_Region_t;
+
+/* 黑匣子统计 */
+typedef struct {
+    uint8_t  region;                        // 快照区状态 (CMix_Blackbox_Region_t)
+    uint8_t  capturing;                     // RAM环是否在采集 (0 = 冻结待写入或写入中)
+    uint8_t  fault_code;                    // 快照区中快照的故障代码
+    uint8_t  reserved;
+    uint32_t sequence;                      // 快照区中快照序号 (0 = 无)
+    uint32_t trigger_ms;                    // 快照区中快照的触发时刻 (ms)
+    uint16_t pre_samples;                   // 快照区中快照的触发前样本数
+    uint16_t post_samples;                  // 快照区中快照的触发后样本数
+    uint32_t triggers;                      // 触发次数
+    uint32_t ignored;                       // 冻结或写入期间被忽略的触发次数
+    uint32_t commits;                       // 写入完成的快照数
+    uint32_t erases;                        // 页擦除次数
+    uint32_t program_errors;                // 写入或擦除后校验失败次数
+} CMix_Blackbox_Stats_t;
+
+/* ========================= 函数声明 ========================= */
+
+/* 启动扫描快照区并开始采集 */
+void CMix_Blackbox_Init(void);
+
+/* 采集与触发 (中断上下文) */
+void CMix_Blackbox_Capture(const CMix_DCDC_Status_t *status);
+void CMix_Blackbox_Trigger(uint8_t fault_code);
+
+/* 后台写入: 是否允许写入/擦除由调用方按运行状态决定 */
+void CMix_Blackbox_Step(bool program_ok, bool erase_ok);
+bool CMix_Blackbox_Is_Busy(void);
+bool CMix_Blackbox_Clear(void);
+
+/* 分块读出 */
+uint8_t CMix_Blackbox_Get_Chunk_Count(void);
+uint8_t CMix_Blackbox_Read_Chunk(uint8_t index, uint8_t *buffer);
+
+/* 统计 */
+void CMix_Blackbox_Get_Stats(CMix_Blackbox_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_BLACKBOX_H */
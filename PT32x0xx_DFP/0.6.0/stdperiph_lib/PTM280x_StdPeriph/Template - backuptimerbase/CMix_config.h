@@ -90,7 +90,7 @@ typedef CMix_Working_Mode_t CMix_Mode_t;
 typedef CMix_State_t CMix_System_State_t;
 
 /* ========================= 调试与功能开关 ========================= */
-#define CMIX_DEBUG_ENABLE           1   // 启用调试输出
+#define CMIX_DEBUG_ENABLE           1   // 启用调试输出 (二进制跟踪记录, 主机按格式表还原文本)
 #define CMIX_UART_ENABLE            1   // 启用UART通信
 #define CMIX_MODBUS_ENABLE          1   // 启用Modbus协议
 #define CMIX_SAFETY_ENABLE          1   // 启用安全保护功能
@@ -98,6 +98,25 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_CMP_PROTECTION_ENABLE  1   // 启用硬件比较器保护
 #define CMIX_OVER_CURRENT_ENABLE    1   // 启用过流保护
 #define CMIX_WATCHDOG_ENABLE        1   // 启用看门狗
+#define CMIX_PI_FIXED_POINT_ENABLE  1   // 启用定点PI控制器 (0 = 浮点参考实现)
+#define CMIX_DUTY_FEEDFORWARD_ENABLE 1  // 电压环占空比前馈 (BUCK: Vout/Vin, BOOST: 1-Vin/Vout)
+#define CMIX_CONTROL_ISR_ENABLE     1   // 控制环在ADC扫描结束中断中执行 (0 = 1ms任务轮询)
+#define CMIX_ADC_DMA_ENABLE         0   // ADC扫描结果由DMA搬运到乒乓缓冲 (需CMIX_CONTROL_ISR_ENABLE)
+#define CMIX_ADC_SEQUENCER_ENABLE   1   // 多速率采样: 快速通道注入组每周期转换, 慢速通道规则组轮转 (替代DMA扫描)
+#define CMIX_ADC_AWD_ENABLE         1   // ADC模拟看门狗: 快速通道轮流按协议限值监视, 越限转换即软件刹车关断PWM
+#define CMIX_UART_TX_ASYNC_ENABLE   1   // UART发送经环形缓冲由TXE中断发出 (0 = 阻塞发送)
+#define CMIX_PROTOCOL_DEFERRED_ENABLE 1 // 命令帧由主循环执行, 中断仅校验入队 (0 = 中断内执行)
+#define CMIX_CRC_HW_ENABLE          1   // 协议CRC16使用硬件CRC单元 (0 = 仅查表)
+#define CMIX_PWM_PRELOAD_ENABLE     1   // 比较值预装载: 四路占空比暂存后一次提交, 下一更新事件同时生效 (0 = 逐路立即写入)
+#define CMIX_PWM_CENTER_ALIGNED_ENABLE 1 // 中心对齐PWM: ADC在计数谷点 (上管导通中点) 采样, 电感电流等于周期平均值 (0 = 边沿对齐, 更新事件采样)
+#define CMIX_PWM_DOUBLE_UPDATE_ENABLE 0 // 中心对齐双更新: 谷点和峰点各采样一次并装载比较值, 控制环每PWM周期最多执行两次
+#ifndef CMIX_PWM_INTERLEAVE_ENABLE      // 主机构建可由编译选项覆盖 (交错变体)
+#define CMIX_PWM_INTERLEAVE_ENABLE  0   // 两相交错: 相A/相B并联为同步BUCK, 相B导通中心在峰点 (180°), 控制中断内均流修正 (0 = 四开关升降压)
+#endif
+#define CMIX_PARAM_STORE_ENABLE     1   // 参数存储: 协议设置的参数以记录追加写入内部Flash末尾轮换页, 复位后恢复 (0 = 复位恢复默认值)
+#define CMIX_BLACKBOX_ENABLE        1   // 故障黑匣子: 控制中断连续记录波形, 故障后冻结并后台写入Flash, 协议分块读出
+#define CMIX_TELEMETRY_ENABLE       1   // 遥测流: 上位机订阅信号及各自分频, 控制中断按分频采样定点值, 后台打包成帧连续发送
+#define CMIX_SCOPE_ENABLE           1   // 片内示波器: 上位机设置探针/触发/触发前比例/分频, 控制中断采集到RAM缓冲, 冻结后分块读出
 
 /* ========================= 硬件引脚配置 ========================= */
 
@@ -107,9 +126,34 @@ typedef CMix_State_t CMix_System_State_t;
 /* PWM配置 */
 #define CMIX_PWM_FREQUENCY_HZ       100000      // 100kHz PWM频率
 #define CMIX_PWM_PERIOD             480         // PWM周期计数值 (48MHz/100kHz)
+#if CMIX_PWM_CENTER_ALIGNED_ENABLE
+#define CMIX_PWM_COMPARE_SCALE      (CMIX_PWM_PERIOD / 2)   // 100%占空比对应的比较值 (= ARR, 先加后减各ARR个计数)
+#else
+#define CMIX_PWM_COMPARE_SCALE      CMIX_PWM_PERIOD         // 100%占空比对应的比较值 (ARR = 周期 - 1)
+#endif
+#if CMIX_PWM_DOUBLE_UPDATE_ENABLE
+#define CMIX_PWM_UPDATES_PER_PERIOD 2           // 每PWM周期的采样/比较值装载次数 (谷点和峰点)
+#else
+#define CMIX_PWM_UPDATES_PER_PERIOD 1
+#endif
 #define CMIX_PWM_DEADTIME_NS        200         // 死区时间200ns
 #define CMIX_PWM_MAX_DUTY           95          // 最大占空比95%
 #define CMIX_PWM_MIN_DUTY           5           // 最小占空比5%
+#if CMIX_PWM_DOUBLE_UPDATE_ENABLE
+#define CMIX_PWM_COMMIT_GUARD       32          // 提交保护窗 (计数): 双更新时半周期只有240计数, 仅保留四路写入所需时间
+#else
+#define CMIX_PWM_COMMIT_GUARD       48          // 提交保护窗 (计数, 0.75us): 距更新事件不足该值时等到更新之后再写, 记为错过
+#endif
+
+/* 两相交错均流: 纯积分, 相A电流偏大时相A占空比减小、相B增大 (修正量单位同占空比, 0.01%).
+ * 一个计数的相电压差 (Vin/240) 在毫欧级相电阻上即有十安级环流. 两相比较值均按1/16计数
+ * 累加余数抖动输出, 平均分辨率经LC滤波后远小于一个计数 (单计数量化在四开关模式下
+ * 即造成输出电压极限环) */
+#define CMIX_PHASE_SHARE_KI_SHIFT   16          // 积分增益 2^-16 (占空比单位/mA/控制步)
+#define CMIX_PHASE_SHARE_MAX_TRIM   300         // 修正量上限 (3%)
+#define CMIX_PHASE_SHARE_DEADBAND_MA 100        // 相电流差死区 (mA), 死区内积分保持
+#define CMIX_PHASE_SHARE_ERROR_MAX_MA 5000      // 单步相电流差限幅 (mA), 瞬态不冲积分
+#define CMIX_PWM_DITHER_BITS        4           // 相A/相B比较值抖动小数位 (1/16计数)
 
 /* TIM1 PWM引脚配置 */
 #define CMIX_PWM_PHASE_A_PORT       GPIOA       // 相A PWM引脚组
@@ -145,11 +189,19 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_ADC_CURRENT_B_PIN      GPIO_Pin_3  // PA3 = ADC0_IN3
 #define CMIX_ADC_CURRENT_B_CHANNEL  3           // ADC0_IN3
 
+/* 内部1.0V基准 (慢速通道, 按其码值监测VDDA) */
+#define CMIX_ADC_BANDGAP_CHANNEL    62          // ADC_Channel_BG1v0
+#define CMIX_ADC_BANDGAP_MV         1000        // 基准电压 (mV)
+
 /* TP181A1电流放大器参数 */
 #define CMIX_CURRENT_SENSE_RS       0.00025f    // 分流电阻 0.25mΩ
 #define CMIX_CURRENT_SENSE_GAIN     50.0f       // TP181A1增益
 #define CMIX_CURRENT_SENSE_VREF     2.5f        // 参考电压 VDDA/2 = 2.5V
 
+/* 电压采样分压 (Vin/Vout经1:20分压后进入ADC, 按3.3V满量程换算) */
+#define CMIX_VOLTAGE_SENSE_RATIO    20          // 分压比
+#define CMIX_VOLTAGE_SENSE_VREF_MV  3300        // 换算参考电压 (mV)
+
 /* 电流感应兼容别名 */
 #define CMIX_CURRENT_VREF           CMIX_CURRENT_SENSE_VREF
 
@@ -157,6 +209,68 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_ADC_RESOLUTION         4095        // 12位ADC分辨率
 #define CMIX_ADC_VREF               5.0f        // ADC参考电压5V
 #define CMIX_ADC_SAMPLE_TIME        239         // ADC采样时间 239.5周期
+#if CMIX_PWM_DOUBLE_UPDATE_ENABLE
+#define CMIX_ADC_SMP_SETTING        9           // ADC_SampleTime设置值: 双更新时注入组扫描须在半个PWM周期内完成
+#else
+#define CMIX_ADC_SMP_SETTING        33          // ADC_SampleTime设置值: 适配TP181A1输出阻抗
+#endif
+
+/* ADC码值换算常数 (编译期由上面的参数计算, 运行时: 工程值 = (码值 * SCALE - OFFSET) >> SHIFT)
+ * 电压: 码值 * VREF_MV * RATIO / RESOLUTION (mV)
+ * 电流: (码值 * ADC_VREF / RESOLUTION - SENSE_VREF) / (RS * GAIN) (mA)
+ */
+#define CMIX_ADC_SCALE_SHIFT        12
+#define CMIX_ADC_VOLTAGE_SCALE      ((int32_t)((double)CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO * \
+                                               (1 << CMIX_ADC_SCALE_SHIFT) / CMIX_ADC_RESOLUTION + 0.5))
+#define CMIX_ADC_CURRENT_SCALE      ((int32_t)((double)CMIX_ADC_VREF * 1000.0 * (1 << CMIX_ADC_SCALE_SHIFT) / \
+                                               ((double)CMIX_ADC_RESOLUTION * CMIX_CURRENT_SENSE_RS * CMIX_CURRENT_SENSE_GAIN) + 0.5))
+#define CMIX_ADC_CURRENT_OFFSET     ((int32_t)((double)CMIX_CURRENT_SENSE_VREF * 1000.0 * (1 << CMIX_ADC_SCALE_SHIFT) / \
+                                               ((double)CMIX_CURRENT_SENSE_RS * CMIX_CURRENT_SENSE_GAIN) + 0.5))
+#define CMIX_ADC_CURRENT_LIMIT_MA   100000      // 电流换算结果限幅 ±100A
+
+/* 电流通道查表 (4096项int16_t, 8KB flash, 编译期生成): 传感器非线性时启用,
+ * 并将CMIX_ADC_CURRENT_CURVE_MA替换为实测曲线 (码值 -> mA, 常量表达式) */
+#define CMIX_ADC_CURRENT_TABLE_ENABLE 0
+#define CMIX_ADC_CURRENT_TABLE_LSB_MA 10        // 表项单位 (mA)
+#define CMIX_ADC_CURRENT_CURVE_MA(code) \
+    (((double)(code) * CMIX_ADC_VREF / CMIX_ADC_RESOLUTION - CMIX_CURRENT_SENSE_VREF) * 1000.0 / \
+     ((double)CMIX_CURRENT_SENSE_RS * CMIX_CURRENT_SENSE_GAIN))
+
+/* ADC过采样抽取 (盒式滤波, 即一阶CIC): DMA中断内每个采样累加一次, 满2^N个输出一次并清零.
+ * 输出为扩展码值 (码值 << CMIX_ADC_EXT_SHIFT, 即1/16 LSB), 抽取比4/16分别增加约1/2位有效分辨率.
+ * 控制通道的抽取比不大于CMIX_CONTROL_DECIMATION, 输出与控制环同拍, 不增加延时;
+ * 监测通道可取更大的抽取比. 关闭时扩展码值为单次采样左移 */
+#define CMIX_ADC_OVERSAMPLE_ENABLE  1
+#define CMIX_ADC_EXT_SHIFT          4           // 扩展码值小数位 (0-65520)
+#define CMIX_ADC_VIN_OSR_LOG2       4           // 输入电压 (监测/前馈): 16倍
+#define CMIX_ADC_CURRENT_A_OSR_LOG2 2           // 相A电流 (电流环): 4倍
+#define CMIX_ADC_VOUT_OSR_LOG2      2           // 输出电压 (电压环): 4倍
+#define CMIX_ADC_CURRENT_B_OSR_LOG2 2           // 相B电流 (输出电流): 4倍
+
+/* 扩展码值换算常数: 65520码时乘积不超过uint32, 电流减去零点后不超过int32.
+ * 电流零点按取整后的斜率折算 (零点码值 * SCALE), 斜率取整误差只随偏离零点的码值增长 */
+#define CMIX_ADC_VOLTAGE_EXT_SHIFT  15
+#define CMIX_ADC_VOLTAGE_SCALE_EXT  ((uint32_t)((double)CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO * \
+                                                (1 << CMIX_ADC_VOLTAGE_EXT_SHIFT) / \
+                                                ((double)CMIX_ADC_RESOLUTION * (1 << CMIX_ADC_EXT_SHIFT)) + 0.5))
+#define CMIX_ADC_CURRENT_EXT_SHIFT  13
+#define CMIX_ADC_CURRENT_SCALE_EXT  ((uint32_t)((double)CMIX_ADC_VREF * 1000.0 * (1 << CMIX_ADC_CURRENT_EXT_SHIFT) / \
+                                                ((double)CMIX_ADC_RESOLUTION * (1 << CMIX_ADC_EXT_SHIFT) * \
+                                                 CMIX_CURRENT_SENSE_RS * CMIX_CURRENT_SENSE_GAIN) + 0.5))
+#define CMIX_ADC_CURRENT_OFFSET_EXT ((uint32_t)((double)CMIX_ADC_CURRENT_SCALE_EXT * CMIX_CURRENT_SENSE_VREF * \
+                                                CMIX_ADC_RESOLUTION * (1 << CMIX_ADC_EXT_SHIFT) / CMIX_ADC_VREF + 0.5))
+
+/* 模拟看门狗窗口换算常数 (工程值 -> 码值, Q16): 限值在主循环中换算, 无除法.
+ * 电压: 码值 = mV * VOLTAGE_CODE >> 16; 电流: 码值 = 零点 ± mA * CURRENT_CODE >> 16 */
+#define CMIX_ADC_AWD_VOLTAGE_CODE_Q16 ((uint32_t)((double)CMIX_ADC_RESOLUTION * 65536.0 / \
+                                                  ((double)CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO) + 0.5))
+#define CMIX_ADC_AWD_CURRENT_CODE_Q16 ((uint32_t)((double)CMIX_ADC_RESOLUTION * CMIX_CURRENT_SENSE_RS * \
+                                                  CMIX_CURRENT_SENSE_GAIN * 65536.0 / (CMIX_ADC_VREF * 1000.0) + 0.5))
+#define CMIX_ADC_AWD_CURRENT_ZERO_Q16 ((uint32_t)((double)CMIX_CURRENT_SENSE_VREF * CMIX_ADC_RESOLUTION * 65536.0 / \
+                                                  CMIX_ADC_VREF + 0.5))
+
+/* 通道号转换为库函数ADC_Channel_x编码 (CHS位于CFGR2[21:16]) */
+#define CMIX_ADC_CHANNEL_SEL(ch)    ((u32)(ch) << 16)
 
 /* ========================= UART配置 ========================= */
 #define CMIX_UART_PORT              UART0       // UART0
@@ -165,6 +279,11 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_UART_TX_PIN            GPIO_Pin_15 // PA15 = UART0_TX
 #define CMIX_UART_RX_PORT           GPIOB       // RX引脚端口
 #define CMIX_UART_RX_PIN            GPIO_Pin_2  // PB2 = UART0_RX
+#define CMIX_UART_TX_BUFFER_SIZE    512         // 发送环形缓冲大小 (2的幂)
+
+#if (CMIX_UART_TX_BUFFER_SIZE & (CMIX_UART_TX_BUFFER_SIZE - 1)) != 0
+#error "CMIX_UART_TX_BUFFER_SIZE must be a power of 2"
+#endif
 
 /* ========================= Modbus协议配置 ========================= */
 #define CMIX_PROTOCOL_MAX_DATA_LEN  64          // 最大数据长度
@@ -172,6 +291,156 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_PROTOCOL_FRAME_HEADER  0x7E        // 帧头标识
 #define CMIX_MODBUS_SLAVE_ADDRESS   1           // Modbus从站地址
 #define CMIX_MODBUS_TIMEOUT_MS      1000        // Modbus超时时间
+#define CMIX_PROTOCOL_RX_QUEUE_DEPTH 4          // 接收命令队列深度 (2的幂)
+#define CMIX_PROTOCOL_CMDS_PER_SLOT 2           // 主循环每轮最多执行的命令数
+#define CMIX_CRC_DMA_MIN_LEN        16          // 不小于此长度的数据由DMA写入CRC单元
+
+#if (CMIX_PROTOCOL_RX_QUEUE_DEPTH & (CMIX_PROTOCOL_RX_QUEUE_DEPTH - 1)) != 0
+#error "CMIX_PROTOCOL_RX_QUEUE_DEPTH must be a power of 2"
+#endif
+
+/* ========================= 参数存储配置 ========================= */
+/* 参数区占主Flash最后几页, MDK工程的IROM不含参数区 (及其前的故障快照区, 见下), 程序不会链接到参数区.
+ * 每页63条记录; 6个参数时换页复制后一页还可容纳57次修改, 4页轮换下每页约每230次修改擦除一次.
+ * 记录写入 (两字) 期间CPU停顿约两个字编程时间, 控制中断随之推迟, 不到一个UART字节时间;
+ * 擦除停顿为毫秒级, 其间UART接收溢出, 只在变换器未开关且通信空闲时进行 */
+#define CMIX_PARAM_FLASH_BASE       0x00007800  // 参数区起始地址 (页对齐)
+#define CMIX_PARAM_FLASH_END        0x00008000  // 主Flash结束地址+1 (PTM280x6x7: 32KB)
+#define CMIX_PARAM_PAGE_SIZE        512         // Flash页大小 (字节)
+#define CMIX_PARAM_PAGE_COUNT       4           // 轮换页数 (不少于2)
+#define CMIX_PARAM_STEP_MS          5           // 后台写入任务周期 (ms), 每次至多一次Flash操作
+#define CMIX_PARAM_STEP_DEADLINE_US 10000       // 后台写入任务截止时间: 包含一次页擦除的CPU停顿
+#define CMIX_PARAM_PROGRAM_WHILE_SWITCHING 1    // 变换器开关时允许写记录 (0 = 写入也推迟到输出关闭)
+#define CMIX_PARAM_ERASE_IDLE_MS    200         // 擦除前要求UART已空闲的时间 (ms)
+
+#if CMIX_PARAM_STORE_ENABLE
+#if (CMIX_PARAM_FLASH_BASE % CMIX_PARAM_PAGE_SIZE) != 0
+#error "CMIX_PARAM_FLASH_BASE must be page aligned"
+#endif
+#if (CMIX_PARAM_PAGE_COUNT < 2) || (CMIX_PARAM_FLASH_BASE + CMIX_PARAM_PAGE_COUNT * CMIX_PARAM_PAGE_SIZE > CMIX_PARAM_FLASH_END)
+#error "CMIX_PARAM_PAGE_COUNT must be at least 2 and the parameter area must fit in main flash"
+#endif
+#endif
+
+/* ========================= 故障黑匣子配置 ========================= */
+/* 控制中断每周期向RAM环写入一个12字节样本 (Vin, Vout, Ia, Ib, 占空比, 状态), 进入故障状态时
+ * 再采集CMIX_BLACKBOX_POST_SAMPLES个样本后冻结. 默认128个样本在25kHz控制频率下为5.12ms窗口
+ * (故障前3.84ms, 故障后1.28ms), 占RAM 1.5KB.
+ * 快照区位于参数区之前, MDK工程的IROM大小相应减小 (0x7000). 写入与参数存储相同:
+ * 每次两字, CPU停顿不到一个UART字节时间; 快照区有旧快照时先擦除, 只在变换器未开关且通信空闲时进行 */
+#define CMIX_BLACKBOX_SAMPLES       128         // RAM环样本数 (2的幂)
+#define CMIX_BLACKBOX_POST_SAMPLES  32          // 触发后采集的样本数 (小于CMIX_BLACKBOX_SAMPLES)
+#define CMIX_BLACKBOX_VOLTAGE_SHIFT 2           // 电压样本单位 = 1mV << 2 (分压后ADC分辨率约16mV)
+#define CMIX_BLACKBOX_CURRENT_SHIFT 4           // 电流样本单位 = 1mA << 4 (有符号)
+#define CMIX_BLACKBOX_FLASH_BASE    0x00007000  // 快照区起始地址 (页对齐)
+#define CMIX_BLACKBOX_FLASH_SIZE    0x00000800  // 快照区大小 (页大小的整数倍)
+#define CMIX_BLACKBOX_PAGE_SIZE     512         // Flash页大小 (字节)
+#define CMIX_BLACKBOX_STEP_MS       1           // 后台写入任务周期 (ms), 每次至多一次Flash操作
+#define CMIX_BLACKBOX_STEP_DEADLINE_US 5000     // 后台写入任务截止时间: 包含一次页擦除的CPU停顿
+#define CMIX_BLACKBOX_ERASE_IDLE_MS 200         // 擦除前要求UART已空闲的时间 (ms)
+#define CMIX_BLACKBOX_CHUNK_BYTES   48          // 协议读出每块字节数 (4字节的整数倍)
+
+#if CMIX_BLACKBOX_ENABLE
+#if !CMIX_CONTROL_ISR_ENABLE
+#error "CMIX_BLACKBOX_ENABLE requires CMIX_CONTROL_ISR_ENABLE"
+#endif
+#if (CMIX_BLACKBOX_SAMPLES & (CMIX_BLACKBOX_SAMPLES - 1)) != 0 || CMIX_BLACKBOX_POST_SAMPLES >= CMIX_BLACKBOX_SAMPLES
+#error "CMIX_BLACKBOX_SAMPLES must be a power of 2 and larger than CMIX_BLACKBOX_POST_SAMPLES"
+#endif
+#if (CMIX_BLACKBOX_FLASH_BASE % CMIX_BLACKBOX_PAGE_SIZE) != 0 || (CMIX_BLACKBOX_FLASH_SIZE % CMIX_BLACKBOX_PAGE_SIZE) != 0
+#error "CMIX_BLACKBOX_FLASH_BASE and CMIX_BLACKBOX_FLASH_SIZE must be page aligned"
+#endif
+#if 32 + CMIX_BLACKBOX_SAMPLES * 12 > CMIX_BLACKBOX_FLASH_SIZE
+#error "CMIX_BLACKBOX_FLASH_SIZE must hold the 32-byte header and CMIX_BLACKBOX_SAMPLES samples"
+#endif
+#if CMIX_PARAM_STORE_ENABLE && (CMIX_BLACKBOX_FLASH_BASE + CMIX_BLACKBOX_FLASH_SIZE > CMIX_PARAM_FLASH_BASE)
+#error "the black-box area must end below the parameter area"
+#endif
+#if (CMIX_BLACKBOX_CHUNK_BYTES % 4) != 0 || CMIX_BLACKBOX_CHUNK_BYTES + 2 > CMIX_PROTOCOL_MAX_DATA_LEN
+#error "CMIX_BLACKBOX_CHUNK_BYTES must be a multiple of 4 and fit in one frame with the chunk header"
+#endif
+#endif
+
+/* ========================= 跟踪记录配置 ========================= */
+/* 调试输出 (CMIX_DEBUG_ENABLE) 为二进制跟踪记录: 记录点只写格式ID、时间和原始参数字, 不做格式化,
+ * 文本由主机按CMix_trace_fmt.h还原. 记录在关中断下写入RAM环, 中断中也可调用; 后台任务把整条记录
+ * 打包成协议帧, 发送队列空间不足时留在环中等下一周期, 环满时新记录丢弃并计数 */
+#define CMIX_TRACE_BUFFER_WORDS     128         // 记录环大小 (字, 2的幂)
+#define CMIX_TRACE_MAX_ARGS         6           // 每条记录最多参数个数
+#define CMIX_TRACE_FRAME_BYTES      60          // 每帧数据上限 (字节, 含帧序号和丢失计数)
+#define CMIX_TRACE_FLUSH_MS         5           // 后台发送任务周期 (ms)
+#define CMIX_TRACE_FLUSH_DEADLINE_US 2000       // 后台发送任务截止时间
+
+#if CMIX_DEBUG_ENABLE
+#if (CMIX_TRACE_BUFFER_WORDS & (CMIX_TRACE_BUFFER_WORDS - 1)) != 0 || CMIX_TRACE_BUFFER_WORDS < 1 + CMIX_TRACE_MAX_ARGS
+#error "CMIX_TRACE_BUFFER_WORDS must be a power of 2 and hold the largest record"
+#endif
+#if CMIX_TRACE_FRAME_BYTES < 2 + 4 * (1 + CMIX_TRACE_MAX_ARGS) || CMIX_TRACE_FRAME_BYTES > CMIX_PROTOCOL_MAX_DATA_LEN
+#error "CMIX_TRACE_FRAME_BYTES must hold the largest record and fit in one frame"
+#endif
+#endif
+
+/* ========================= 信号探针配置 ========================= */
+/* 遥测流和示波器经CMix_DCDC_Probe读取内部信号的16位定点值 (CMix_DCDC_Probe_t), 只用移位换算 */
+#define CMIX_PROBE_VOLTAGE_SHIFT    2           // 电压单位 = 1mV << 2 (无符号, 满量程262V)
+#define CMIX_PROBE_CURRENT_SHIFT    4           // 电流单位 = 1mA << 4 (有符号, 满量程±524A)
+#define CMIX_PROBE_POWER_SHIFT      4           // 功率单位 = 1mW << 4 (无符号, 满量程1048W)
+
+/* ========================= 遥测流配置 ========================= */
+/* 上位机用CMIX_CMD_TELEMETRY订阅至多CMIX_TELEMETRY_MAX_SIGNALS个信号, 每个信号有各自的分频
+ * (相对控制频率). 控制中断结束时对到期的信号取16位定点值写入RAM字节环, 后台任务把整条记录打包
+ * 成帧发送: 凑满一帧才发送, 不满一帧的记录最多等待CMIX_TELEMETRY_LATENCY_MS; 发送队列积压超过
+ * CMIX_TELEMETRY_TX_BACKLOG时暂停, 应答和状态上报的排队延迟不超过该积压的发送时间. 环满时新记录
+ * 丢弃并计数. 订阅按最坏情况 (各信号记录互不重合) 估算记录字节率, 超过CMIX_TELEMETRY_MAX_BYTES_PER_S
+ * 时拒绝; 默认8000B/s加上约12%的帧开销约为115200波特率的80% */
+#define CMIX_TELEMETRY_MAX_SIGNALS  8           // 最多订阅信号数 (记录的到期掩码为1字节)
+#define CMIX_TELEMETRY_BUFFER_BYTES 512         // 记录环大小 (字节, 2的幂)
+#define CMIX_TELEMETRY_FRAME_BYTES  60          // 每帧数据上限 (字节, 含帧序号和丢失计数)
+#define CMIX_TELEMETRY_MAX_BYTES_PER_S 8000     // 订阅允许的最坏情况记录字节率
+#define CMIX_TELEMETRY_TX_BACKLOG   128         // 发送队列积压不超过该字节数时才加入遥测帧 (约11ms)
+#define CMIX_TELEMETRY_LATENCY_MS   10          // 不满一帧的记录最长等待时间 (ms)
+#define CMIX_TELEMETRY_FLUSH_MS     2           // 后台发送任务周期 (ms)
+#define CMIX_TELEMETRY_FLUSH_DEADLINE_US 1000   // 后台发送任务截止时间
+
+#if CMIX_TELEMETRY_ENABLE
+#if !CMIX_CONTROL_ISR_ENABLE || !CMIX_PROTOCOL_DEFERRED_ENABLE
+#error "CMIX_TELEMETRY_ENABLE requires CMIX_CONTROL_ISR_ENABLE and CMIX_PROTOCOL_DEFERRED_ENABLE"
+#endif
+#if (CMIX_TELEMETRY_BUFFER_BYTES & (CMIX_TELEMETRY_BUFFER_BYTES - 1)) != 0 || CMIX_TELEMETRY_BUFFER_BYTES < 3 + 2 * CMIX_TELEMETRY_MAX_SIGNALS
+#error "CMIX_TELEMETRY_BUFFER_BYTES must be a power of 2 and hold the largest record"
+#endif
+#if CMIX_TELEMETRY_MAX_SIGNALS > 8 || 3 * CMIX_TELEMETRY_MAX_SIGNALS > CMIX_PROTOCOL_MAX_DATA_LEN
+#error "CMIX_TELEMETRY_MAX_SIGNALS must fit in the 8-bit due mask and one subscription frame"
+#endif
+#if CMIX_TELEMETRY_FRAME_BYTES < 2 + 3 + 2 * CMIX_TELEMETRY_MAX_SIGNALS || CMIX_TELEMETRY_FRAME_BYTES > CMIX_PROTOCOL_MAX_DATA_LEN
+#error "CMIX_TELEMETRY_FRAME_BYTES must hold the largest record and fit in one frame"
+#endif
+#if CMIX_TELEMETRY_TX_BACKLOG < CMIX_TELEMETRY_FRAME_BYTES + 5 || CMIX_TELEMETRY_TX_BACKLOG > CMIX_UART_TX_BUFFER_SIZE
+#error "CMIX_TELEMETRY_TX_BACKLOG must hold one telemetry frame and fit in the UART TX buffer"
+#endif
+#endif
+
+/* ========================= 片内示波器配置 ========================= */
+/* 上位机用CMIX_CMD_SCOPE设置至多CMIX_SCOPE_CHANNELS个探针、触发通道与条件、触发前比例和采样分频,
+ * 控制中断每"分频"个控制步写入一组样本, 触发并采满后冻结, 上位机查询状态后分块读出.
+ * 缓冲由各通道均分: 记录深度 = CMIX_SCOPE_BUFFER_SAMPLES / 通道数 (4通道192组, 1通道768组).
+ * 与遥测流相比不受UART带宽限制, 可以逐控制步记录瞬态; 未启动时控制中断只有一次比较 */
+#define CMIX_SCOPE_CHANNELS         4           // 最多通道数
+#define CMIX_SCOPE_BUFFER_SAMPLES   768         // 缓冲样本数 (各通道合计, 每个16位)
+#define CMIX_SCOPE_CHUNK_BYTES      48          // 每次读出的字节数
+
+#if CMIX_SCOPE_ENABLE
+#if !CMIX_CONTROL_ISR_ENABLE || !CMIX_PROTOCOL_DEFERRED_ENABLE
+#error "CMIX_SCOPE_ENABLE requires CMIX_CONTROL_ISR_ENABLE and CMIX_PROTOCOL_DEFERRED_ENABLE"
+#endif
+#if CMIX_SCOPE_CHANNELS < 1 || CMIX_SCOPE_CHANNELS > 4 || CMIX_SCOPE_BUFFER_SAMPLES < 2 * CMIX_SCOPE_CHANNELS
+#error "CMIX_SCOPE_CHANNELS must be 1..4 (one arm frame) and the buffer must hold two samples per channel"
+#endif
+#if CMIX_SCOPE_CHUNK_BYTES + 3 > CMIX_PROTOCOL_MAX_DATA_LEN || (CMIX_SCOPE_CHUNK_BYTES & 1) != 0 || \
+    (2 * CMIX_SCOPE_BUFFER_SAMPLES + CMIX_SCOPE_CHUNK_BYTES - 1) / CMIX_SCOPE_CHUNK_BYTES > 255
+#error "CMIX_SCOPE_CHUNK_BYTES must be even, fit in one frame and split the buffer into at most 255 chunks"
+#endif
+#endif
 
 /* ========================= 比较器配置 ========================= */
 #define CMIX_CMP_VIN_OVERVOLTAGE    CMP1        // Vin过压保护比较器
@@ -191,14 +460,25 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_CMP0_INPUT_PORT        GPIOB       // CMP0输入引脚端口  
 #define CMIX_CMP0_INPUT_PIN         GPIO_Pin_4  // PB4 = CMP0_IN
 
+/* CMP阈值: LDAC0 (5位, VDDA参考) 同时接CMP1 (Vin过压) 与CMP0 (Vout过压) 负端,
+ * 器件只有这一个LDAC, 两路共用一个动作点. 正端与ADC电压通道同一分压,
+ * 码值 = 电压(mV) * LDAC级数 / (VREF_MV * RATIO), 向下取整, 每级约2.06V.
+ * 共用动作点只作硬件后备, 取最高码值31 (约63.9V), 高于Vin/Vout工作上限;
+ * 分别设置的限值由ADC模拟看门狗按协议参数执行 (Vout), 以及软件保护 (Vin/Vout,
+ * 见CMIX_MAX_INPUT_VOLTAGE/CMIX_MAX_OUTPUT_VOLTAGE).
+ * 代价: 分压满量程66V, Vin工作上限只能定在后备动作点以下, 见CMIX_MAX_INPUT_VOLTAGE.
+ * 实际动作电压启动时打印 ("CMP: ...") */
+#define CMIX_CMP_LDAC_STEPS         32          // LDAC级数 (5位)
+#define CMIX_CMP_THRESHOLD_V        64.0f       // Vin/Vout共用过压后备动作电压 (V)
+#define CMIX_CMP_THRESHOLD_MV       ((uint32_t)(CMIX_CMP_THRESHOLD_V * 1000.0f))
+
 /* ========================= OPA配置 ========================= */
 #define CMIX_OPA_UNIT               OPA0        // OPA单元
 #define CMIX_OPA_INPUT_PORT         GPIOA       // OPA输入引脚端口
 #define CMIX_OPA_INPUT_PIN          GPIO_Pin_3  // PA3 = OPA0_IN
 
 /* ========================= 保护阈值 ========================= */
-#define CMIX_VIN_OVERVOLTAGE_V      60.0f       // Vin过压保护阈值60V
-#define CMIX_VOUT_UNDERVOLTAGE_V    55.0f       // Vout欠压保护阈值55V
+/* Vin/Vout过压: 软件保护按下面的工作上限, 比较器后备见CMIX_CMP_THRESHOLD_V */
 #define CMIX_CURRENT_LIMIT_A        40.0f       // 电流限制40A
 #define CMIX_TEMP_LIMIT_C           85.0f       // 温度限制85°C
 
@@ -206,7 +486,7 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_MIN_OUTPUT_VOLTAGE     12.0f       // 最小输出电压12V
 #define CMIX_MAX_OUTPUT_VOLTAGE     60.0f       // 最大输出电压60V
 #define CMIX_MIN_INPUT_VOLTAGE      10.0f       // 最小输入电压10V
-#define CMIX_MAX_INPUT_VOLTAGE      70.0f       // 最大输入电压70V
+#define CMIX_MAX_INPUT_VOLTAGE      62.0f       // 最大输入电压62V (分压满量程66V, 须低于比较器后备动作点)
 #define CMIX_MIN_CURRENT_LIMIT      1.0f        // 最小电流限制1A
 #define CMIX_MAX_CURRENT_LIMIT      50.0f       // 最大电流限制50A
 #define CMIX_MAX_INPUT_CURRENT      50.0f       // 最大输入电流50A
@@ -220,23 +500,71 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_MAX_ERROR_COUNT        10          // 最大错误计数
 #define CMIX_MAX_TEMPERATURE        80.0f       // 最大温度
 #define CMIX_MAX_MEMORY_USAGE       80          // 最大内存使用率%
-#define CMIX_FAULT_THRESHOLD        5           // 故障阈值计数
+#define CMIX_FAULT_THRESHOLD_MS     5           // 软件过压/过流持续超过该时间才停机 (ms)
 
 /* 紧急状态代码 */
 #define CMIX_EMERGENCY_TOO_MANY_ERRORS     1    // 错误过多
 #define CMIX_EMERGENCY_OVERTEMPERATURE     2    // 过温
 
+/* ========================= 控制中断配置 ========================= */
+#define CMIX_CONTROL_DECIMATION     4           // 控制环分频: 每1/2/4次采样执行一次 (双更新时每PWM周期采样两次)
+#define CMIX_NVIC_PRIORITY_CMP      0           // CMP保护中断 (最高)
+#define CMIX_NVIC_PRIORITY_ADC      1           // ADC扫描结束/DMA传输中断 (控制环)
+#define CMIX_NVIC_PRIORITY_UART     2           // UART通信中断
+
+#if (CMIX_CONTROL_DECIMATION != 1) && (CMIX_CONTROL_DECIMATION != 2) && (CMIX_CONTROL_DECIMATION != 4)
+#error "CMIX_CONTROL_DECIMATION must be 1, 2 or 4"
+#endif
+
+#if CMIX_ADC_DMA_ENABLE && !CMIX_CONTROL_ISR_ENABLE
+#error "CMIX_ADC_DMA_ENABLE requires CMIX_CONTROL_ISR_ENABLE"
+#endif
+
+#if CMIX_ADC_SEQUENCER_ENABLE && (!CMIX_CONTROL_ISR_ENABLE || CMIX_ADC_DMA_ENABLE)
+#error "CMIX_ADC_SEQUENCER_ENABLE requires CMIX_CONTROL_ISR_ENABLE and excludes CMIX_ADC_DMA_ENABLE"
+#endif
+
+#if CMIX_PWM_DOUBLE_UPDATE_ENABLE && !CMIX_PWM_CENTER_ALIGNED_ENABLE
+#error "CMIX_PWM_DOUBLE_UPDATE_ENABLE requires CMIX_PWM_CENTER_ALIGNED_ENABLE"
+#endif
+
+#if CMIX_PWM_INTERLEAVE_ENABLE && (!CMIX_PWM_CENTER_ALIGNED_ENABLE || !CMIX_PWM_PRELOAD_ENABLE)
+#error "CMIX_PWM_INTERLEAVE_ENABLE requires CMIX_PWM_CENTER_ALIGNED_ENABLE and CMIX_PWM_PRELOAD_ENABLE"
+#endif
+
+#if CMIX_ADC_AWD_ENABLE && !CMIX_CONTROL_ISR_ENABLE
+#error "CMIX_ADC_AWD_ENABLE requires CMIX_CONTROL_ISR_ENABLE"
+#endif
+
+#if (CMIX_ADC_VIN_OSR_LOG2 > 8) || (CMIX_ADC_CURRENT_A_OSR_LOG2 > 8) || \
+    (CMIX_ADC_VOUT_OSR_LOG2 > 8) || (CMIX_ADC_CURRENT_B_OSR_LOG2 > 8)
+#error "CMIX_ADC_*_OSR_LOG2 must be 0..8"
+#endif
+
 /* ========================= 软启动配置 ========================= */
 #define CMIX_SOFT_START_TIME_MS     1000        // 软启动时间1秒
 #define CMIX_SOFT_START_TIME        1000        // 软启动时间1秒 (兼容别名)
 #define CMIX_SOFT_START_STEP        1           // 软启动步长1%
 
 /* ========================= 控制算法参数 ========================= */
+#if CMIX_CONTROL_ISR_ENABLE
+#define CMIX_CONTROL_RATE_HZ        (CMIX_PWM_FREQUENCY_HZ * CMIX_PWM_UPDATES_PER_PERIOD / CMIX_CONTROL_DECIMATION)  // 控制频率
+#define CMIX_CONTROL_PERIOD         (1.0f / (float)CMIX_CONTROL_RATE_HZ)                // 控制周期
+#define CMIX_SOFT_START_STEPS       ((uint32_t)CMIX_SOFT_START_TIME_MS * (CMIX_CONTROL_RATE_HZ / 1000))
+#define CMIX_FAULT_THRESHOLD        ((uint32_t)CMIX_FAULT_THRESHOLD_MS * (CMIX_CONTROL_RATE_HZ / 1000))  // 安全检查每控制步执行
+#else
 #define CMIX_CONTROL_PERIOD         0.0001f     // 控制周期100μs (10kHz)
-#define CMIX_VOLTAGE_PI_KP          0.5f        // 电压环P参数
-#define CMIX_VOLTAGE_PI_KI          0.1f        // 电压环I参数
-#define CMIX_CURRENT_PI_KP          0.3f        // 电流环P参数
-#define CMIX_CURRENT_PI_KI          0.05f       // 电流环I参数
+#define CMIX_SOFT_START_STEPS       CMIX_SOFT_START_TIME  // 软启动步数 (1ms任务)
+#define CMIX_FAULT_THRESHOLD        CMIX_FAULT_THRESHOLD_MS  // 安全检查每1ms执行
+#endif
+/* PI参数 (占空比单位0.01% / mV或mA, Ki单位1/s), 由cmix_sweep在默认功率级上整定:
+ * LC谐振Q值约20, 电压环Kp超过约0.1后谐振处增益越过1而振荡; 前馈给出大部分占空比, 电压环只做修正 */
+#define CMIX_VOLTAGE_PI_KP          0.02f       // 电压环P参数
+#define CMIX_VOLTAGE_PI_KI          20.0f       // 电压环I参数
+#define CMIX_CURRENT_PI_KP          0.05f       // 电流环P参数 (仅限流, 积分预置在上限)
+#define CMIX_CURRENT_PI_KI          20.0f       // 电流环I参数
+#define CMIX_FF_MIN_DIVISOR_MV      1000        // 前馈除数下限 (mV), 低于时前馈为0
+#define CMIX_FF_DEADBAND_MV         8           // 除数变化不超过该值时不更新倒数 (mV)
 
 /* ========================= 看门狗配置 ========================= */
 #define CMIX_IWDG_TIMEOUT_MS        2000        // 看门狗超时2秒
@@ -256,6 +584,8 @@ typedef CMix_State_t CMix_System_State_t;
 #define CMIX_GPIO_RELAY_PIN         GPIO_Pin_6  // PA6
 
 /* ========================= 工具宏定义 ========================= */
+#define CMIX_V_TO_MV(v)             ((uint32_t)((v) * 1000.0f))    // V限值换算为mV (控制环单位)
+#define CMIX_A_TO_MA(a)             ((uint32_t)((a) * 1000.0f))    // A限值换算为mA
 #define CMIX_SET_BIT(reg, bit)      ((reg) |= (1U << (bit)))
 #define CMIX_CLEAR_BIT(reg, bit)    ((reg) &= ~(1U << (bit)))
 #define CMIX_READ_BIT(reg, bit)     (((reg) >> (bit)) & 1U)
@@ -0,0 +1,394 @@
+/******************************************************************************
+  * @file    CMix_crc.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix CRC16计算模块实现文件
+  *          实现查表、硬件CRC单元和硬件CRC+DMA三种Modbus CRC16后端
+  ******************************************************************************
+  * @attention
+  *
+  * CMix CRC16计算模块实现
+  * 硬件CRC单元由主循环和UART中断共用, 通过占用标志互斥; 被占用时本次
+  * 计算回退到查表, 调用方无需等待
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_crc.h"
+
+/* ========================= 私有定义 ========================= */
+
+#define CMIX_CRC_DMA_CHANNEL        DMA0_CH1        // DMA0_CH0已用于ADC扫描
+#define CMIX_CRC_DMA_FLAG_TC        DMA_FLAG_TC1F
+#define CMIX_CRC_DMA_FLAG_TE        DMA_FLAG_TE1F
+#define CMIX_CRC_DMA_TIMEOUT        10000           // DMA完成等待上限 (轮询次数)
+
+/* ========================= 私有变量 ========================= */
+
+/* Modbus-RTU CRC16查表 */
+static const uint16_t crc16_table[256] = {
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+
+/* Modbus CRC16标准校验串 */
+static const uint8_t g_crc_check_string[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+#if CMIX_CRC_HW_ENABLE
+static bool g_crc_hw_available = false;         // 硬件CRC已初始化且自检通过
+static volatile bool g_crc_hw_busy = false;     // 硬件CRC单元占用标志
+#endif
+
+/* ========================= 私有函数声明 ========================= */
+
+static uint16_t CMix_CRC16_Table(const uint8_t *data, uint16_t length);
+#if CMIX_CRC_HW_ENABLE
+static bool CMix_CRC_Hardware_Acquire(void);
+static void CMix_CRC_Hardware_Release(void);
+static uint16_t CMix_CRC16_Hardware(const uint8_t *data, uint16_t length);
+static bool CMix_CRC16_Hardware_DMA(const uint8_t *data, uint16_t length, uint16_t *crc);
+#endif
+static uint32_t CMix_CRC_Cycles_Since(uint32_t start);
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief CRC模块初始化
+ * @param None
+ * @retval None
+ * @note  配置硬件CRC单元为Modbus CRC16, 并用标准校验串验证;
+ *        验证失败时后续计算全部使用查表
+ */
+void CMix_CRC_Init(void)
+{
+#if CMIX_CRC_HW_ENABLE
+    CRC_InitTypeDef CRC_InitStruct;
+
+    RCC_APBPeriph4ClockCmd(RCC_APBPeriph4_CRC, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA0, ENABLE);
+
+    /* IBM16多项式 + 输入/输出位反转 = 反射多项式0xA001 */
+    CRC_InitStruct.CRC_Input = CRC_Input_8b;
+    CRC_InitStruct.CRC_InputBitSequenceReversal = CRC_InputBitSequenceReversal_Enable;
+    CRC_InitStruct.CRC_InputByteSequenceReversal = CRC_InputByteSequenceReversal_Disable;
+    CRC_InitStruct.CRC_OutputBitSequenceReversal = CRC_OutputBitSequenceReversal_Enable;
+    CRC_InitStruct.CRC_Seed = CMIX_CRC16_MODBUS_INIT;
+    CRC_InitStruct.CRC_Poly = CRC_Poly_IBM16;
+    CRC_Init(CRC, &CRC_InitStruct);
+    CRC_Cmd(CRC, ENABLE);
+
+    g_crc_hw_busy = false;
+    g_crc_hw_available = (CMix_CRC16_Hardware(g_crc_check_string, sizeof(g_crc_check_string))
+                          == CMIX_CRC16_MODBUS_CHECK);
+#endif
+}
+
+/**
+ * @brief 硬件CRC是否可用
+ * @param None
+ * @retval true=硬件后端可用
+ */
+bool CMix_CRC_Is_Hardware_Available(void)
+{
+#if CMIX_CRC_HW_ENABLE
+    return g_crc_hw_available;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Modbus CRC16计算 (自动选择后端)
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval CRC16值
+ * @note  长度不小于CMIX_CRC_DMA_MIN_LEN时使用DMA, 否则CPU写入硬件CRC单元
+ */
+uint16_t CMix_CRC16_Modbus(const uint8_t *data, uint16_t length)
+{
+    if (length >= CMIX_CRC_DMA_MIN_LEN) {
+        return CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_HW_DMA, data, length);
+    }
+    return CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_HW, data, length);
+}
+
+/**
+ * @brief Modbus CRC16计算 (指定后端)
+ * @param backend: 计算后端
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval CRC16值
+ * @note  硬件不可用或被另一上下文占用时回退到查表, 结果相同
+ */
+uint16_t CMix_CRC16_Modbus_Backend(CMix_CRC_Backend_t backend, const uint8_t *data, uint16_t length)
+{
+#if CMIX_CRC_HW_ENABLE
+    uint16_t crc;
+
+    if (backend != CMIX_CRC_BACKEND_TABLE && length > 0 &&
+        g_crc_hw_available && CMix_CRC_Hardware_Acquire()) {
+        if (backend == CMIX_CRC_BACKEND_HW_DMA && CMix_CRC16_Hardware_DMA(data, length, &crc)) {
+            CMix_CRC_Hardware_Release();
+            return crc;
+        }
+        crc = CMix_CRC16_Hardware(data, length);
+        CMix_CRC_Hardware_Release();
+        return crc;
+    }
+#else
+    (void)backend;
+#endif
+
+    return CMix_CRC16_Table(data, length);
+}
+
+/**
+ * @brief Modbus CRC16分段计算 (查表)
+ * @param crc: 前一段的结果, 第一段传入CMIX_CRC16_MODBUS_INIT
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval 到本段为止的CRC16值
+ * @note  用于数据不连续或分多次到达的场合, 各段依次计算与整体一次计算结果相同
+ */
+uint16_t CMix_CRC16_Modbus_Update(uint16_t crc, const uint8_t *data, uint16_t length)
+{
+    uint16_t i;
+
+    for (i = 0; i < length; i++) {
+        crc = (crc >> 8) ^ crc16_table[(crc ^ data[i]) & 0xFF];
+    }
+
+    return crc;
+}
+
+/**
+ * @brief CRC自检 - 各后端与Modbus CRC16标准值逐位比较
+ * @param None
+ * @retval 0=全部一致; bit0=查表错误, bit1=硬件错误, bit2=硬件+DMA错误
+ */
+uint8_t CMix_CRC_Self_Test(void)
+{
+    uint8_t pattern[CMIX_PROTOCOL_MAX_DATA_LEN];
+    uint8_t result = 0;
+    uint16_t expected;
+    uint16_t i;
+
+    /* 标准校验值 */
+    if (CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_TABLE, g_crc_check_string,
+                                  sizeof(g_crc_check_string)) != CMIX_CRC16_MODBUS_CHECK) {
+        result |= 0x01;
+    }
+    if (CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_HW, g_crc_check_string,
+                                  sizeof(g_crc_check_string)) != CMIX_CRC16_MODBUS_CHECK) {
+        result |= 0x02;
+    }
+
+    /* 长数据: 覆盖DMA路径 */
+    for (i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 37 + 11);
+    }
+    expected = CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_TABLE, pattern, sizeof(pattern));
+    if (CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_HW, pattern, sizeof(pattern)) != expected) {
+        result |= 0x02;
+    }
+    if (CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_HW_DMA, pattern, sizeof(pattern)) != expected) {
+        result |= 0x04;
+    }
+
+    return result;
+}
+
+/**
+ * @brief CRC后端性能对比
+ * @param data: 测试数据
+ * @param length: 测试数据长度
+ * @param result: 对比结果输出
+ * @retval None
+ * @note  以SysTick计数测量, SysTick未运行时临时以最大重装值自由运行.
+ *        单次测量时间需小于一个SysTick重装周期
+ */
+void CMix_CRC_Benchmark(const uint8_t *data, uint16_t length, CMix_CRC_Benchmark_t *result)
+{
+    uint32_t systick_ctrl = SysTick->CTRL;
+    uint32_t systick_load = SysTick->LOAD;
+    uint32_t start;
+    uint16_t crc_table, crc_hw, crc_dma;
+
+    if ((systick_ctrl & SysTick_CTRL_ENABLE_Msk) == 0) {
+        SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+        SysTick->VAL = 0;
+        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    }
+
+    start = SysTick->VAL;
+    crc_table = CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_TABLE, data, length);
+    result->table_cycles = CMix_CRC_Cycles_Since(start);
+
+    start = SysTick->VAL;
+    crc_hw = CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_HW, data, length);
+    result->hw_cycles = CMix_CRC_Cycles_Since(start);
+
+    start = SysTick->VAL;
+    crc_dma = CMix_CRC16_Modbus_Backend(CMIX_CRC_BACKEND_HW_DMA, data, length);
+    result->hw_dma_cycles = CMix_CRC_Cycles_Since(start);
+
+    if ((systick_ctrl & SysTick_CTRL_ENABLE_Msk) == 0) {
+        SysTick->CTRL = systick_ctrl;
+        SysTick->LOAD = systick_load;
+    }
+
+    result->length = length;
+    result->hw_available = CMix_CRC_Is_Hardware_Available() ? 1 : 0;
+    result->match = (crc_table == crc_hw && crc_table == crc_dma) ? 1 : 0;
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 查表计算Modbus CRC16
+ */
+static uint16_t CMix_CRC16_Table(const uint8_t *data, uint16_t length)
+{
+    return CMix_CRC16_Modbus_Update(CMIX_CRC16_MODBUS_INIT, data, length);
+}
+
+#if CMIX_CRC_HW_ENABLE
+/**
+ * @brief 占用硬件CRC单元
+ * @retval true=占用成功, false=已被其他上下文占用
+ */
+static bool CMix_CRC_Hardware_Acquire(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    bool acquired = false;
+
+    __disable_irq();
+    if (!g_crc_hw_busy) {
+        g_crc_hw_busy = true;
+        acquired = true;
+    }
+    __set_PRIMASK(primask);
+
+    return acquired;
+}
+
+/**
+ * @brief 释放硬件CRC单元
+ */
+static void CMix_CRC_Hardware_Release(void)
+{
+    g_crc_hw_busy = false;
+}
+
+/**
+ * @brief 硬件CRC单元计算 (CPU逐字节写入)
+ */
+static uint16_t CMix_CRC16_Hardware(const uint8_t *data, uint16_t length)
+{
+    uint16_t i;
+
+    CRC_ResetDout(CRC);
+    for (i = 0; i < length; i++) {
+        CRC->DINR = data[i];
+    }
+
+    return (uint16_t)CRC_GetCRC(CRC);
+}
+
+/**
+ * @brief 硬件CRC单元计算 (DMA存储器到存储器写入数据寄存器)
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @param crc: CRC输出
+ * @retval true=完成, false=DMA错误或超时 (调用方改用CPU写入)
+ */
+static bool CMix_CRC16_Hardware_DMA(const uint8_t *data, uint16_t length, uint16_t *crc)
+{
+    DMA_InitTypeDef DMA_InitStruct;
+    uint32_t timeout = CMIX_CRC_DMA_TIMEOUT;
+
+    if ((CMIX_CRC_DMA_CHANNEL->CCR & DMA_CCR_EN) != 0) {
+        return false;
+    }
+
+    CRC_ResetDout(CRC);
+
+    DMA_InitStruct.DMA_SourceBaseAddress = (u32)data;
+    DMA_InitStruct.DMA_DestinationBaseAddress = (u32)&CRC->DINR;
+    DMA_InitStruct.DMA_NumberOfData = length;
+    DMA_InitStruct.DMA_SourceDataSize = DMA_SourceDataSize_Byte;
+    DMA_InitStruct.DMA_DestinationDataSize = DMA_DestinationDataSize_Byte;
+    DMA_InitStruct.DMA_SourceAddressIncrement = DMA_SourceAddressIncrement_Enable;
+    DMA_InitStruct.DMA_DestinationAddressIncrement = DMA_DestinationAddressIncrement_Disable;
+    DMA_InitStruct.DMA_Direction = DMA_Direction_MemoryToMemory;
+    DMA_InitStruct.DMA_CircularMode = DMA_CircularMode_Disable;
+    DMA_InitStruct.DMA_ChannelPriority = DMA_ChannelPriority_0;
+    DMA_InitStruct.DMA_Burst = DMA_Burst_1Unit;
+    DMA_Init(CMIX_CRC_DMA_CHANNEL, &DMA_InitStruct);
+
+    DMA_ClearITFlag(DMA0, CMIX_CRC_DMA_FLAG_TC | CMIX_CRC_DMA_FLAG_TE);
+    DMA_Cmd(CMIX_CRC_DMA_CHANNEL, ENABLE);
+
+    while (DMA_GetFlagStatus(DMA0, CMIX_CRC_DMA_FLAG_TC | CMIX_CRC_DMA_FLAG_TE) == RESET) {
+        if (--timeout == 0) {
+            break;
+        }
+    }
+
+    DMA_Cmd(CMIX_CRC_DMA_CHANNEL, DISABLE);
+
+    if (timeout == 0 || DMA_GetFlagStatus(DMA0, CMIX_CRC_DMA_FLAG_TE) != RESET) {
+        DMA_ClearITFlag(DMA0, CMIX_CRC_DMA_FLAG_TC | CMIX_CRC_DMA_FLAG_TE);
+        return false;
+    }
+
+    DMA_ClearITFlag(DMA0, CMIX_CRC_DMA_FLAG_TC);
+    *crc = (uint16_t)CRC_GetCRC(CRC);
+    return true;
+}
+#endif
+
+/**
+ * @brief 计算自start以来经过的SysTick计数 (SysTick为递减计数器)
+ */
+static uint32_t CMix_CRC_Cycles_Since(uint32_t start)
+{
+    uint32_t now = SysTick->VAL;
+
+    if (start >= now) {
+        return start - now;
+    }
+    return start + (SysTick->LOAD + 1) - now;
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+  * @file    CMix_crc.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix CRC16计算模块头文件
+  *          定义Modbus CRC16计算后端 (查表/硬件CRC单元/硬件CRC+DMA) 接口
+  ******************************************************************************
+  * @attention
+  *
+  * CMix CRC16计算模块
+  * 硬件CRC单元配置为IBM16多项式(0x8005)、输入输出位反转、初值0xFFFF,
+  * 与Modbus CRC16 (反射多项式0xA001) 结果逐位一致. 长帧由DMA0_CH1以
+  * 存储器到存储器方式写入CRC数据寄存器. 硬件不可用、被占用或自检失败时
+  * 自动回退到查表实现.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_CRC_H
+#define __CMIX_CRC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CMix_config.h"
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_CRC16_MODBUS_INIT      0xFFFF      // Modbus CRC16初值
+#define CMIX_CRC16_MODBUS_CHECK     0x4B37      // "123456789"的Modbus CRC16校验值
+
+/* ========================= 数据结构定义 ========================= */
+
+/* CRC计算后端 */
+typedef enum {
+    CMIX_CRC_BACKEND_TABLE = 0,             // 软件查表
+    CMIX_CRC_BACKEND_HW,                    // 硬件CRC单元, CPU逐字节写入
+    CMIX_CRC_BACKEND_HW_DMA                 // 硬件CRC单元, DMA写入
+} CMix_CRC_Backend_t;
+
+/* CRC后端性能对比结果 (SysTick计数, 即CPU周期) */
+typedef struct {
+    uint16_t length;                        // 测试数据长度 (字节)
+    uint8_t  hw_available;                  // 硬件后端是否可用
+    uint8_t  match;                         // 各后端结果是否一致
+    uint32_t table_cycles;                  // 查表耗时
+    uint32_t hw_cycles;                     // 硬件CRC单元耗时
+    uint32_t hw_dma_cycles;                 // 硬件CRC单元+DMA耗时
+} CMix_CRC_Benchmark_t;
+
+/* ========================= 函数声明 ========================= */
+
+void CMix_CRC_Init(void);
+bool CMix_CRC_Is_Hardware_Available(void);
+
+/* 自动选择后端 */
+uint16_t CMix_CRC16_Modbus(const uint8_t *data, uint16_t length);
+
+/* 指定后端 (硬件不可用时回退到查表) */
+uint16_t CMix_CRC16_Modbus_Backend(CMix_CRC_Backend_t backend, const uint8_t *data, uint16_t length);
+
+/* 分段计算 (查表) */
+uint16_t CMix_CRC16_Modbus_Update(uint16_t crc, const uint8_t *data, uint16_t length);
+
+/* 自检和性能对比 */
+uint8_t CMix_CRC_Self_Test(void);
+void CMix_CRC_Benchmark(const uint8_t *data, uint16_t length, CMix_CRC_Benchmark_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_CRC_H */
@@ -18,26 +18,66 @@
 #include "CMix_dcdc.h"
 #include "CMix_hardware.h"
 #include "CMix_protocol.h"
+#include "CMix_pid.h"
+#include "CMix_blackbox.h"
+#include "CMix_telemetry.h"
+#include "CMix_scope.h"
+#include "CMix_trace.h"
 #include <math.h>
-#include <stdio.h>  // 支持sprintf函数
+
+/* ========================= 私有定义 ========================= */
+
+/* 前馈时电压环只输出修正量, 下限为负 */
+#if CMIX_DUTY_FEEDFORWARD_ENABLE
+#define CMIX_DCDC_VOLTAGE_PI_MIN    (-10000)
+#else
+#define CMIX_DCDC_VOLTAGE_PI_MIN    0
+#endif
+
+#if CMIX_PWM_INTERLEAVE_ENABLE
+/* 占空比 (0-10000) 换算为Q15: 乘2^29/10000后右移14位, 10000对应0x7FFF, 32位内不溢出 */
+#define CMIX_DCDC_DUTY_Q15_MUL      53687U
+#define CMIX_DCDC_DUTY_Q15_SHIFT    14
+#endif
 
 /* ========================= 私有变量 ========================= */
 
+#if CMIX_PI_FIXED_POINT_ENABLE
+static CMix_PID_Q_t g_voltage_pi;
+static CMix_PID_Q_t g_current_pi;
+#else
 static CMix_PI_Controller_t g_voltage_pi;
 static CMix_PI_Controller_t g_current_pi;
+#endif
 static CMix_DCDC_Status_t g_dcdc_status = {0};
 static CMix_DCDC_Control_t g_dcdc_control = {0};
 static CMix_Safety_Monitor_t g_safety_monitor = {0};
+static uint32_t g_soft_start_steps = 0;     // 软启动已执行的控制步 (控制步中递增)
+static uint32_t g_soft_start_ms = 0;        // 软启动已持续的时间 (1ms状态机中递增)
+#if CMIX_DUTY_FEEDFORWARD_ENABLE
+static CMix_Recip_t g_ff_recip;             // 前馈除数倒数 (BUCK: Vin, BOOST: 设定电压)
+#endif
+#if CMIX_PWM_INTERLEAVE_ENABLE
+static CMix_Share_t g_phase_share;          // 两相均流积分器
+#endif
 
 /* ========================= 私有函数声明 ========================= */
 
-static void CMix_DCDC_PI_Controller_Init(CMix_PI_Controller_t *pi, float kp, float ki, float min, float max);
-static float CMix_DCDC_PI_Controller_Update(CMix_PI_Controller_t *pi, float setpoint, float feedback);
 static void CMix_DCDC_Update_Measurements(void);
 static void CMix_DCDC_Mode_Selection(void);
 static void CMix_DCDC_PWM_Update(void);
-static uint16_t CMix_DCDC_Convert_Voltage(uint16_t adc_value);
-static uint16_t CMix_DCDC_Convert_Current(uint16_t adc_value);
+static void CMix_DCDC_Latch_Fault(uint8_t fault_code);
+static bool CMix_DCDC_Transition(CMix_System_State_t from, CMix_System_State_t to);
+#if CMIX_DUTY_FEEDFORWARD_ENABLE
+static int32_t CMix_DCDC_Duty_Feedforward(void);
+#endif
+#if CMIX_PI_FIXED_POINT_ENABLE
+static int32_t CMix_DCDC_Gain_To_Q15(float gain);
+static int32_t CMix_DCDC_Gain_To_Q31(float gain);
+#endif
+static uint32_t CMix_DCDC_Convert_Voltage(uint16_t adc_value);
+static uint32_t CMix_DCDC_Convert_Current(int32_t current_ma);
+static uint16_t CMix_DCDC_Probe_Unsigned(uint32_t value, uint8_t shift);
 
 /* ========================= 公共函数实现 ========================= */
 
@@ -49,10 +89,25 @@ static uint16_t CMix_DCDC_Convert_Current(uint16_t adc_value);
 void CMix_DCDC_Init(void)
 {
     /* 初始化PI控制器 */
-    CMix_DCDC_PI_Controller_Init(&g_voltage_pi, CMIX_VOLTAGE_PI_KP, CMIX_VOLTAGE_PI_KI, 
-                                 0.0f, 10000.0f);
-    CMix_DCDC_PI_Controller_Init(&g_current_pi, CMIX_CURRENT_PI_KP, CMIX_CURRENT_PI_KI, 
-                                 0.0f, 10000.0f);
+#if CMIX_PI_FIXED_POINT_ENABLE
+    /* 定点系数在编译期由浮点参数换算, Ki已乘以控制周期 */
+    CMix_PID_Init(&g_voltage_pi, CMIX_Q15(CMIX_VOLTAGE_PI_KP),
+                  CMIX_Q31(CMIX_VOLTAGE_PI_KI * CMIX_CONTROL_PERIOD), 0, CMIX_DCDC_VOLTAGE_PI_MIN, 10000);
+    CMix_PID_Init(&g_current_pi, CMIX_Q15(CMIX_CURRENT_PI_KP),
+                  CMIX_Q31(CMIX_CURRENT_PI_KI * CMIX_CONTROL_PERIOD), 0, 0, 10000);
+#else
+    CMix_DCDC_PI_Init(&g_voltage_pi, CMIX_VOLTAGE_PI_KP, CMIX_VOLTAGE_PI_KI, 
+                      (float)CMIX_DCDC_VOLTAGE_PI_MIN, 10000.0f);
+    CMix_DCDC_PI_Init(&g_current_pi, CMIX_CURRENT_PI_KP, CMIX_CURRENT_PI_KI, 
+                      0.0f, 10000.0f);
+#endif
+#if CMIX_DUTY_FEEDFORWARD_ENABLE
+    CMix_Recip_Init(&g_ff_recip, CMIX_FF_MIN_DIVISOR_MV, CMIX_FF_DEADBAND_MV);
+#endif
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    CMix_Share_Init(&g_phase_share, CMIX_PHASE_SHARE_KI_SHIFT, CMIX_PHASE_SHARE_MAX_TRIM,
+                    CMIX_PHASE_SHARE_DEADBAND_MA, CMIX_PHASE_SHARE_ERROR_MAX_MA);
+#endif
 
     /* 初始化DCDC状态 */
     g_dcdc_status.mode = CMIX_MODE_AUTO;
@@ -73,18 +128,19 @@ void CMix_DCDC_Init(void)
     g_safety_monitor.fault_flags = 0;
 
     /* 设置初始PWM为0 */
-    CMix_Hardware_Set_PWM_Duty(0, 0);  /* BUCK上管 */
-    CMix_Hardware_Set_PWM_Duty(1, 0);  /* BUCK下管 */
-    CMix_Hardware_Set_PWM_Duty(2, 0);  /* BOOST上管 */
-    CMix_Hardware_Set_PWM_Duty(3, 0);  /* BOOST下管 */
+    CMix_Hardware_Set_PWM_Duty(1, 0);  /* BUCK上管 */
+    CMix_Hardware_Set_PWM_Duty(2, 0);  /* BUCK下管 */
+    CMix_Hardware_Set_PWM_Duty(3, 0);  /* BOOST上管 */
+    CMix_Hardware_Set_PWM_Duty(4, 0);  /* BOOST下管 */
 }
 
 /**
- * @brief CMix DCDC主控制任务
+ * @brief CMix DCDC快速控制步 (测量、保护、模式选择、PWM输出)
  * @param None
  * @retval None
+ * @note  CMIX_CONTROL_ISR_ENABLE时在ADC扫描结束中断中调用, 否则由1ms任务调用
  */
-void CMix_DCDC_Control_Task(void)
+void CMix_DCDC_Control_Step(void)
 {
     /* 更新测量值 */
     CMix_DCDC_Update_Measurements();
@@ -98,6 +154,69 @@ void CMix_DCDC_Control_Task(void)
     /* PWM更新 */
     CMix_DCDC_PWM_Update();
 
+#if CMIX_BLACKBOX_ENABLE
+    /* 黑匣子记录本周期测量值和输出 */
+    CMix_Blackbox_Capture(&g_dcdc_status);
+#endif
+
+#if CMIX_TELEMETRY_ENABLE
+    /* 遥测流采样到期的订阅信号 */
+    CMix_Telemetry_Capture();
+#endif
+
+#if CMIX_SCOPE_ENABLE
+    /* 片内示波器写入一组样本并判断触发 */
+    CMix_Scope_Capture();
+#endif
+}
+
+#if CMIX_CONTROL_ISR_ENABLE
+/**
+ * @brief ADC扫描结束回调 (中断上下文, PWM同步)
+ * @param None
+ * @retval None
+ */
+void CMix_Hardware_ADC_Conversion_Complete_Callback(void)
+{
+    CMix_DCDC_Control_Step();
+}
+#endif
+
+#if CMIX_ADC_AWD_ENABLE
+/**
+ * @brief ADC模拟看门狗越限回调 (中断上下文, 输出已由TIM1刹车关断)
+ * @param channel: 越限通道号
+ * @retval None
+ */
+void CMix_Hardware_ADC_AWD_Trip_Callback(uint8_t channel)
+{
+    CMix_DCDC_Latch_Fault((channel == CMIX_ADC_VOUT_CHANNEL) ? CMIX_ERROR_OVERVOLTAGE : CMIX_ERROR_OVERCURRENT);
+}
+#endif
+
+/**
+ * @brief 比较器越限回调 (中断上下文, 输出已由TIM1刹车关断)
+ * @param unit: 比较器单元号 (0=Vout, 1=Vin)
+ * @retval None
+ */
+void CMix_Hardware_CMP_Trip_Callback(uint8_t unit)
+{
+    (void)unit;
+    CMix_DCDC_Latch_Fault(CMIX_ERROR_OVERVOLTAGE);
+}
+
+/**
+ * @brief CMix DCDC主控制任务
+ * @param None
+ * @retval None
+ */
+void CMix_DCDC_Control_Task(void)
+{
+#if !CMIX_CONTROL_ISR_ENABLE
+    /* 轮询模式: 在任务中执行控制步 */
+    CMix_DCDC_Control_Step();
+#endif
+
     /* 更新效率计算 */
     CMix_DCDC_Calculate_Efficiency();
 
@@ -119,7 +238,7 @@ void CMix_DCDC_Control_Task(void)
  */
 void CMix_DCDC_Set_Output_Voltage(uint32_t voltage)
 {
-    if (voltage >= CMIX_MIN_OUTPUT_VOLTAGE && voltage <= CMIX_MAX_OUTPUT_VOLTAGE) {
+    if (voltage >= CMIX_V_TO_MV(CMIX_MIN_OUTPUT_VOLTAGE) && voltage <= CMIX_V_TO_MV(CMIX_MAX_OUTPUT_VOLTAGE)) {
         g_dcdc_control.voltage_setpoint = voltage;
     }
 }
@@ -131,11 +250,33 @@ void CMix_DCDC_Set_Output_Voltage(uint32_t voltage)
  */
 void CMix_DCDC_Set_Current_Limit(uint32_t current)
 {
-    if (current >= CMIX_MIN_CURRENT_LIMIT && current <= CMIX_MAX_CURRENT_LIMIT) {
+    if (current >= CMIX_A_TO_MA(CMIX_MIN_CURRENT_LIMIT) && current <= CMIX_A_TO_MA(CMIX_MAX_CURRENT_LIMIT)) {
         g_dcdc_control.current_limit = current;
     }
 }
 
+/**
+ * @brief CMix设置PI参数 (运行时整定, 积分项清零)
+ * @param voltage_kp: 电压环比例系数
+ * @param voltage_ki: 电压环积分系数 (1/s)
+ * @param current_kp: 电流环比例系数
+ * @param current_ki: 电流环积分系数 (1/s)
+ * @retval None
+ * @note  输出范围与CMix_DCDC_Init相同; 应在控制中断不会同时运行时调用
+ */
+void CMix_DCDC_Set_PI_Gains(float voltage_kp, float voltage_ki, float current_kp, float current_ki)
+{
+#if CMIX_PI_FIXED_POINT_ENABLE
+    CMix_PID_Init(&g_voltage_pi, CMix_DCDC_Gain_To_Q15(voltage_kp),
+                  CMix_DCDC_Gain_To_Q31(voltage_ki * CMIX_CONTROL_PERIOD), 0, CMIX_DCDC_VOLTAGE_PI_MIN, 10000);
+    CMix_PID_Init(&g_current_pi, CMix_DCDC_Gain_To_Q15(current_kp),
+                  CMix_DCDC_Gain_To_Q31(current_ki * CMIX_CONTROL_PERIOD), 0, 0, 10000);
+#else
+    CMix_DCDC_PI_Init(&g_voltage_pi, voltage_kp, voltage_ki, (float)CMIX_DCDC_VOLTAGE_PI_MIN, 10000.0f);
+    CMix_DCDC_PI_Init(&g_current_pi, current_kp, current_ki, 0.0f, 10000.0f);
+#endif
+}
+
 /**
  * @brief CMix使能/禁用DCDC
  * @param enable: 1-使能, 0-禁用
@@ -152,7 +293,9 @@ void CMix_DCDC_Enable(uint8_t enable)
         CMix_Hardware_Set_PWM_Duty(3, 0);
         CMix_Hardware_Set_PWM_Duty(4, 0);
         
-        g_dcdc_status.state = CMIX_STATE_IDLE;
+        /* 软启动/运行回到空闲; 已锁存的故障保持, 只能由CMix_DCDC_Reset_Fault清除 */
+        (void)CMix_DCDC_Transition(CMIX_STATE_SOFT_START, CMIX_STATE_IDLE);
+        (void)CMix_DCDC_Transition(CMIX_STATE_RUNNING, CMIX_STATE_IDLE);
     }
 }
 
@@ -188,6 +331,52 @@ CMix_Safety_Monitor_t* CMix_DCDC_Get_Safety_Status(void)
     return &g_safety_monitor;
 }
 
+/**
+ * @brief 读取一个内部信号的16位定点值 (超出量程时饱和)
+ * @param probe: 探针ID (CMix_DCDC_Probe_t)
+ * @retval 定点值 (有符号探针为补码)
+ * @note  控制步结束时由遥测流/示波器在控制中断中调用, 只有移位和饱和
+ */
+uint16_t CMix_DCDC_Probe(uint8_t probe)
+{
+    switch (probe) {
+        case CMIX_PROBE_VIN:
+            return CMix_DCDC_Probe_Unsigned(g_dcdc_status.input_voltage, CMIX_PROBE_VOLTAGE_SHIFT);
+        case CMIX_PROBE_VOUT:
+            return CMix_DCDC_Probe_Unsigned(g_dcdc_status.output_voltage, CMIX_PROBE_VOLTAGE_SHIFT);
+        case CMIX_PROBE_IIN:
+            return (uint16_t)CMix_Sat16((int32_t)g_dcdc_status.input_current >> CMIX_PROBE_CURRENT_SHIFT);
+        case CMIX_PROBE_IOUT:
+            return (uint16_t)CMix_Sat16((int32_t)g_dcdc_status.output_current >> CMIX_PROBE_CURRENT_SHIFT);
+        case CMIX_PROBE_IA:
+            return (uint16_t)CMix_Sat16(g_dcdc_status.phase_current_a >> CMIX_PROBE_CURRENT_SHIFT);
+        case CMIX_PROBE_IB:
+            return (uint16_t)CMix_Sat16(g_dcdc_status.phase_current_b >> CMIX_PROBE_CURRENT_SHIFT);
+        case CMIX_PROBE_DUTY_BUCK:
+            return g_dcdc_status.pwm_duty_buck;
+        case CMIX_PROBE_DUTY_BOOST:
+            return g_dcdc_status.pwm_duty_boost;
+        case CMIX_PROBE_PHASE_TRIM:
+            return (uint16_t)CMix_Sat16(g_dcdc_status.phase_trim);
+        case CMIX_PROBE_POWER:
+            return CMix_DCDC_Probe_Unsigned(g_dcdc_status.output_power, CMIX_PROBE_POWER_SHIFT);
+#if CMIX_PI_FIXED_POINT_ENABLE
+        case CMIX_PROBE_VOLTAGE_PI_INTEGRAL:
+            return (uint16_t)CMix_Sat16(g_voltage_pi.integral_q15 >> CMIX_Q15_SHIFT);
+        case CMIX_PROBE_CURRENT_PI_INTEGRAL:
+            return (uint16_t)CMix_Sat16(g_current_pi.integral_q15 >> CMIX_Q15_SHIFT);
+#else
+        case CMIX_PROBE_VOLTAGE_PI_INTEGRAL:
+            return (uint16_t)CMix_Sat16((int32_t)g_voltage_pi.integral);
+        case CMIX_PROBE_CURRENT_PI_INTEGRAL:
+            return (uint16_t)CMix_Sat16((int32_t)g_current_pi.integral);
+#endif
+        case CMIX_PROBE_STATE:
+        default:
+            return (uint16_t)((uint8_t)g_dcdc_status.state | ((uint16_t)g_dcdc_status.active_mode << 8));
+    }
+}
+
 /**
  * @brief CMix计算DCDC效率
  * @param None
@@ -222,9 +411,29 @@ void CMix_DCDC_Emergency_Stop(uint8_t fault_code)
     CMix_Hardware_Set_PWM_Duty(2, 0);
     CMix_Hardware_Set_PWM_Duty(3, 0);
     CMix_Hardware_Set_PWM_Duty(4, 0);
-    
-    /* 设置故障状态 */
+
+    CMix_DCDC_Latch_Fault(fault_code);
+}
+
+/**
+ * @brief 锁存故障: 进入故障状态并停止控制, 不写PWM
+ * @param fault_code: 故障代码
+ * @retval None
+ * @note  硬件刹车已关断输出时由保护中断回调直接调用
+ */
+static void CMix_DCDC_Latch_Fault(uint8_t fault_code)
+{
+#if CMIX_BLACKBOX_ENABLE
+    /* 进入故障状态时触发黑匣子, 已在故障状态时的重复保护动作不再触发 */
+    if (g_dcdc_status.state != CMIX_STATE_FAULT) {
+        CMix_Blackbox_Trigger(fault_code);
+    }
+#endif
+
+    /* 设置故障状态, 中断的软启动下次从头开始 */
     g_dcdc_status.state = CMIX_STATE_FAULT;
+    g_soft_start_steps = 0;
+    g_soft_start_ms = 0;
     g_safety_monitor.fault_flags |= fault_code;
     
     /* 点亮故障LED */
@@ -241,14 +450,25 @@ void CMix_DCDC_Emergency_Stop(uint8_t fault_code)
  */
 void CMix_DCDC_Soft_Start(void)
 {
-    /* 实现软启动逻辑 */
-    if (g_dcdc_status.state == CMIX_STATE_IDLE && g_dcdc_control.enable) {
-        g_dcdc_status.state = CMIX_STATE_SOFT_START;
-        
-        /* 重置PI控制器 */
-        g_voltage_pi.integral = 0.0f;
-        g_current_pi.integral = 0.0f;
+    /* 实现软启动逻辑: 计数在进入软启动前清零, 每次启动都从0占空比开始爬升 */
+    if (!g_dcdc_control.enable || g_dcdc_status.state != CMIX_STATE_IDLE) {
+        return;
     }
+    g_soft_start_steps = 0;
+    g_soft_start_ms = 0;
+
+    /* 重置PI控制器 (空闲时控制步不运行PI); 电流环只作限流, 积分预置在上限,
+     * 电流低于限值时输出饱和在满占空比, 不限制电压环 */
+#if CMIX_PI_FIXED_POINT_ENABLE
+    CMix_PID_Reset(&g_voltage_pi);
+    CMix_PID_Reset(&g_current_pi);
+    CMix_PID_Set_Integral(&g_current_pi, 10000);
+#else
+    CMix_DCDC_PI_Reset(&g_voltage_pi);
+    CMix_DCDC_PI_Reset(&g_current_pi);
+    g_current_pi.integral = g_current_pi.output_max;
+#endif
+    (void)CMix_DCDC_Transition(CMIX_STATE_IDLE, CMIX_STATE_SOFT_START);
 }
 
 /**
@@ -258,6 +478,11 @@ void CMix_DCDC_Soft_Start(void)
  */
 void CMix_DCDC_Reset_Fault(void)
 {
+    /* 先释放硬件刹车; 比较器仍越限时故障保持 */
+    if (!CMix_Hardware_PWM_Release_Break()) {
+        return;
+    }
+
     /* 清除故障标志 */
     g_safety_monitor.fault_flags = 0;
     g_safety_monitor.overvoltage_count = 0;
@@ -267,42 +492,39 @@ void CMix_DCDC_Reset_Fault(void)
     /* 关闭故障LED */
     CMix_Hardware_GPIO_Write(CMIX_GPIO_FAULT_LED_PORT, CMIX_GPIO_FAULT_LED_PIN, 0);
     
-    /* 如果DCDC使能，进入软启动 */
-    if (g_dcdc_control.enable) {
-        g_dcdc_status.state = CMIX_STATE_IDLE;
+    /* 故障回到空闲; 如果DCDC使能，进入软启动 */
+    if (CMix_DCDC_Transition(CMIX_STATE_FAULT, CMIX_STATE_IDLE)) {
         CMix_DCDC_Soft_Start();
     }
 }
 
-/* ========================= 私有函数实现 ========================= */
-
 /**
- * @brief PI控制器初始化
+ * @brief 浮点PI控制器初始化 (定点控制器的参考实现)
  * @param pi: PI控制器指针
  * @param kp: 比例系数
- * @param ki: 积分系数
- * @param min: 输出最小值
- * @param max: 输出最大值
+ * @param ki: 积分系数 (1/s)
+ * @param output_min: 输出最小值
+ * @param output_max: 输出最大值
  * @retval None
  */
-static void CMix_DCDC_PI_Controller_Init(CMix_PI_Controller_t *pi, float kp, float ki, float min, float max)
+void CMix_DCDC_PI_Init(CMix_PI_Controller_t *pi, float kp, float ki, float output_min, float output_max)
 {
     pi->kp = kp;
     pi->ki = ki;
-    pi->integral = 0.0f;
-    pi->output_min = min;
-    pi->output_max = max;
-    pi->last_error = 0.0f;
+    pi->output_min = output_min;
+    pi->output_max = output_max;
+    CMix_DCDC_PI_Reset(pi);
 }
 
 /**
- * @brief PI控制器更新
+ * @brief 浮点PI控制器更新
  * @param pi: PI控制器指针
  * @param setpoint: 设定值
  * @param feedback: 反馈值
  * @retval 控制输出
+ * @note  抗积分饱和与CMix_PID_Update相同: 条件积分加积分限幅
  */
-static float CMix_DCDC_PI_Controller_Update(CMix_PI_Controller_t *pi, float setpoint, float feedback)
+float CMix_DCDC_PI_Update(CMix_PI_Controller_t *pi, float setpoint, float feedback)
 {
     float error = setpoint - feedback;
     float output;
@@ -310,8 +532,10 @@ static float CMix_DCDC_PI_Controller_Update(CMix_PI_Controller_t *pi, float setp
     /* 比例项 */
     float proportional = pi->kp * error;
     
-    /* 积分项 */
-    pi->integral += pi->ki * error * CMIX_CONTROL_PERIOD;
+    /* 积分项: 输出已饱和且误差继续推向饱和方向时停止积分 */
+    if (!((pi->output >= pi->output_max && error > 0.0f) || (pi->output <= pi->output_min && error < 0.0f))) {
+        pi->integral += pi->ki * error * CMIX_CONTROL_PERIOD;
+    }
     
     /* 积分限幅 */
     if (pi->integral > pi->output_max) {
@@ -330,11 +554,28 @@ static float CMix_DCDC_PI_Controller_Update(CMix_PI_Controller_t *pi, float setp
         output = pi->output_min;
     }
     
+    pi->error_prev = pi->last_error;
     pi->last_error = error;
+    pi->output = output;
     
     return output;
 }
 
+/**
+ * @brief 浮点PI控制器复位 (清除积分和历史状态, 保留参数)
+ * @param pi: PI控制器指针
+ * @retval None
+ */
+void CMix_DCDC_PI_Reset(CMix_PI_Controller_t *pi)
+{
+    pi->integral = 0.0f;
+    pi->output = 0.0f;
+    pi->error_prev = 0.0f;
+    pi->last_error = 0.0f;
+}
+
+/* ========================= 私有函数实现 ========================= */
+
 /**
  * @brief 更新测量值
  * @param None
@@ -348,8 +589,19 @@ static void CMix_DCDC_Update_Measurements(void)
     /* 转换ADC值为实际物理量 */
     g_dcdc_status.input_voltage = CMix_DCDC_Convert_Voltage(voltage_sensors.input_voltage);
     g_dcdc_status.output_voltage = CMix_DCDC_Convert_Voltage(voltage_sensors.output_voltage);
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    /* 两相并联: 输出电流为两相之和; 无输入电流采样, 按BUCK变比折算 (效率计算用) */
+    g_dcdc_status.phase_current_a = current_sensors.input_current;
+    g_dcdc_status.phase_current_b = current_sensors.output_current;
+    g_dcdc_status.output_current = CMix_DCDC_Convert_Current(current_sensors.input_current +
+                                                             current_sensors.output_current);
+    g_dcdc_status.input_current = (uint32_t)(((uint64_t)g_dcdc_status.output_current *
+        (((uint32_t)g_dcdc_status.pwm_duty_buck * CMIX_DCDC_DUTY_Q15_MUL) >> CMIX_DCDC_DUTY_Q15_SHIFT)) >>
+        CMIX_Q15_SHIFT);
+#else
     g_dcdc_status.input_current = CMix_DCDC_Convert_Current(current_sensors.input_current);
     g_dcdc_status.output_current = CMix_DCDC_Convert_Current(current_sensors.output_current);
+#endif
 }
 
 /**
@@ -362,8 +614,8 @@ void CMix_DCDC_Safety_Check(void)
     uint8_t fault_detected = 0;
     
     /* 过压保护 */
-    if (g_dcdc_status.input_voltage > CMIX_MAX_INPUT_VOLTAGE || 
-        g_dcdc_status.output_voltage > CMIX_MAX_OUTPUT_VOLTAGE) {
+    if (g_dcdc_status.input_voltage > CMIX_V_TO_MV(CMIX_MAX_INPUT_VOLTAGE) || 
+        g_dcdc_status.output_voltage > CMIX_V_TO_MV(CMIX_MAX_OUTPUT_VOLTAGE)) {
         g_safety_monitor.overvoltage_count++;
         if (g_safety_monitor.overvoltage_count > CMIX_FAULT_THRESHOLD) {
             fault_detected = 1;
@@ -374,8 +626,8 @@ void CMix_DCDC_Safety_Check(void)
     }
     
     /* 过流保护 */
-    if (g_dcdc_status.input_current > CMIX_MAX_INPUT_CURRENT || 
-        g_dcdc_status.output_current > CMIX_MAX_OUTPUT_CURRENT) {
+    if (g_dcdc_status.input_current > CMIX_A_TO_MA(CMIX_MAX_INPUT_CURRENT) || 
+        g_dcdc_status.output_current > CMIX_A_TO_MA(CMIX_MAX_OUTPUT_CURRENT)) {
         g_safety_monitor.overcurrent_count++;
         if (g_safety_monitor.overcurrent_count > CMIX_FAULT_THRESHOLD) {
             fault_detected = 1;
@@ -386,7 +638,7 @@ void CMix_DCDC_Safety_Check(void)
     }
     
     /* 欠压保护 */
-    if (g_dcdc_status.input_voltage < CMIX_MIN_INPUT_VOLTAGE) {
+    if (g_dcdc_status.input_voltage < CMIX_V_TO_MV(CMIX_MIN_INPUT_VOLTAGE)) {
         fault_detected = 1;
         g_safety_monitor.fault_flags |= CMIX_ERROR_HARDWARE;
     }
@@ -406,9 +658,9 @@ static void CMix_DCDC_Mode_Selection(void)
 {
     if (g_dcdc_status.mode == CMIX_MODE_AUTO) {
         /* 自动模式：根据输入输出电压自动选择BUCK或BOOST */
-        if (g_dcdc_status.input_voltage > g_dcdc_control.voltage_setpoint + CMIX_VOLTAGE_HYSTERESIS) {
+        if (g_dcdc_status.input_voltage > g_dcdc_control.voltage_setpoint + CMIX_V_TO_MV(CMIX_VOLTAGE_HYSTERESIS)) {
             g_dcdc_status.active_mode = CMIX_MODE_BUCK;
-        } else if (g_dcdc_status.input_voltage < g_dcdc_control.voltage_setpoint - CMIX_VOLTAGE_HYSTERESIS) {
+        } else if (g_dcdc_status.input_voltage < g_dcdc_control.voltage_setpoint - CMIX_V_TO_MV(CMIX_VOLTAGE_HYSTERESIS)) {
             g_dcdc_status.active_mode = CMIX_MODE_BOOST;
         }
         /* 在滞回区间内保持当前模式 */
@@ -425,110 +677,239 @@ static void CMix_DCDC_Mode_Selection(void)
  */
 static void CMix_DCDC_PWM_Update(void)
 {
-    float voltage_error, current_error;
-    float voltage_output, current_output;
+    int32_t voltage_output, current_output;
     uint16_t pwm_duty = 0;
     
-    if (!g_dcdc_control.enable || g_dcdc_status.state == CMIX_STATE_FAULT) {
-        /* 禁用状态，关闭所有PWM */
-        CMix_Hardware_Set_PWM_Duty(1, 0);
-        CMix_Hardware_Set_PWM_Duty(2, 0);
-        CMix_Hardware_Set_PWM_Duty(3, 0);
-        CMix_Hardware_Set_PWM_Duty(4, 0);
+    if (!g_dcdc_control.enable ||
+        (g_dcdc_status.state != CMIX_STATE_SOFT_START && g_dcdc_status.state != CMIX_STATE_RUNNING)) {
+        /* 禁用/空闲/故障状态，关闭所有PWM; 只有软启动和运行状态输出 */
+        CMix_Hardware_PWM_Stage(1, 0);
+        CMix_Hardware_PWM_Stage(2, 0);
+        CMix_Hardware_PWM_Stage(3, 0);
+        CMix_Hardware_PWM_Stage(4, 0);
+        CMix_Hardware_PWM_Commit();
+#if CMIX_PWM_INTERLEAVE_ENABLE
+        CMix_Share_Reset(&g_phase_share);
+        g_dcdc_status.phase_trim = 0;
+#endif
         return;
     }
     
+#if CMIX_PI_FIXED_POINT_ENABLE
     /* 电压环控制 */
-    voltage_output = CMix_DCDC_PI_Controller_Update(&g_voltage_pi, 
-                                                    (float)g_dcdc_control.voltage_setpoint,
-                                                    (float)g_dcdc_status.output_voltage);
+    voltage_output = CMix_PID_Update(&g_voltage_pi,
+                                     (int32_t)g_dcdc_control.voltage_setpoint,
+                                     (int32_t)g_dcdc_status.output_voltage);
     
     /* 电流环控制 */
-    current_output = CMix_DCDC_PI_Controller_Update(&g_current_pi, 
-                                                    (float)g_dcdc_control.current_limit,
-                                                    (float)g_dcdc_status.output_current);
+    current_output = CMix_PID_Update(&g_current_pi,
+                                     (int32_t)g_dcdc_control.current_limit,
+                                     (int32_t)g_dcdc_status.output_current);
+#else
+    /* 电压环控制 */
+    voltage_output = (int32_t)CMix_DCDC_PI_Update(&g_voltage_pi, 
+                                                  (float)g_dcdc_control.voltage_setpoint,
+                                                  (float)g_dcdc_status.output_voltage);
+    
+    /* 电流环控制 */
+    current_output = (int32_t)CMix_DCDC_PI_Update(&g_current_pi, 
+                                                  (float)g_dcdc_control.current_limit,
+                                                  (float)g_dcdc_status.output_current);
+#endif
+
+#if CMIX_DUTY_FEEDFORWARD_ENABLE
+    /* 电压环输出为前馈占空比上的修正量 */
+    voltage_output = CMix_Clamp32(voltage_output + CMix_DCDC_Duty_Feedforward(), 0, 10000);
+#endif
     
     /* 取电压环和电流环输出的最小值 */
     pwm_duty = (uint16_t)(voltage_output < current_output ? voltage_output : current_output);
     
     /* 软启动处理 */
     if (g_dcdc_status.state == CMIX_STATE_SOFT_START) {
-        static uint16_t soft_start_counter = 0;
-        uint16_t max_duty = (soft_start_counter * 10000) / CMIX_SOFT_START_TIME;
+        uint16_t max_duty = (uint16_t)((g_soft_start_steps * 10000) / CMIX_SOFT_START_STEPS);
         
         if (pwm_duty > max_duty) {
             pwm_duty = max_duty;
         }
         
-        soft_start_counter++;
-        if (soft_start_counter >= CMIX_SOFT_START_TIME) {
-            g_dcdc_status.state = CMIX_STATE_RUNNING;
-            soft_start_counter = 0;
+        g_soft_start_steps++;
+        if (g_soft_start_steps >= CMIX_SOFT_START_STEPS) {
+            (void)CMix_DCDC_Transition(CMIX_STATE_SOFT_START, CMIX_STATE_RUNNING);
         }
     }
+
+    /* 电压环抗积分饱和 (反算): 占空比被软启动或限流压低时, 积分减去超出量,
+     * 电压环输出跟随实际占空比, 限制解除时无积分累积造成的过冲 */
+    if (voltage_output > (int32_t)pwm_duty) {
+#if CMIX_PI_FIXED_POINT_ENABLE
+        CMix_PID_Set_Integral(&g_voltage_pi, (g_voltage_pi.integral_q15 >> CMIX_Q15_SHIFT) -
+                                             (voltage_output - (int32_t)pwm_duty));
+#else
+        g_voltage_pi.integral -= (float)(voltage_output - (int32_t)pwm_duty);
+        if (g_voltage_pi.integral < g_voltage_pi.output_min) {
+            g_voltage_pi.integral = g_voltage_pi.output_min;
+        }
+#endif
+    }
     
-    /* 根据模式设置PWM */
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    /* 两相交错: 两相并联为同步BUCK, 共用占空比加均流修正; 该拓扑不能升压, BOOST时关断 */
     if (g_dcdc_status.active_mode == CMIX_MODE_BUCK) {
-        /* BUCK模式 */
+        int32_t trim = CMix_Share_Update(&g_phase_share, g_dcdc_status.phase_current_a,
+                                         g_dcdc_status.phase_current_b);
+
+        g_dcdc_status.pwm_duty_buck = pwm_duty;
+        g_dcdc_status.phase_trim = trim;
+        CMix_Hardware_PWM_Stage(1, (uint16_t)CMix_Clamp32((int32_t)pwm_duty - trim, 0, 10000));  /* 相A */
+        CMix_Hardware_PWM_Stage(2, (uint16_t)CMix_Clamp32((int32_t)pwm_duty + trim, 0, 10000));  /* 相B */
+    } else {
+        g_dcdc_status.pwm_duty_buck = 0;
+        g_dcdc_status.phase_trim = 0;
+        CMix_Share_Reset(&g_phase_share);
+        CMix_Hardware_PWM_Stage(1, 0);
+        CMix_Hardware_PWM_Stage(2, 0);
+    }
+    g_dcdc_status.pwm_duty_boost = 0;
+#else
+    /* 根据模式设置PWM: 两个互补半桥暂存后一次提交, 同一更新事件生效.
+     * 相A (CH1/CH1N) 为输入侧半桥, 相B (CH2/CH2N) 为输出侧半桥, 占空比均为上管导通占比 */
+    if (g_dcdc_status.active_mode == CMIX_MODE_BUCK) {
+        /* BUCK模式: 相A斩波, 相B上管常通 */
         g_dcdc_status.pwm_duty_buck = pwm_duty;
         g_dcdc_status.pwm_duty_boost = 0;
         
-        CMix_Hardware_Set_PWM_Duty(1, pwm_duty);           /* BUCK上管 */
-        CMix_Hardware_Set_PWM_Duty(2, 10000 - pwm_duty);   /* BUCK下管 */
-        CMix_Hardware_Set_PWM_Duty(3, 0);                  /* BOOST上管关闭 */
-        CMix_Hardware_Set_PWM_Duty(4, 10000);              /* BOOST下管常开 */
+        CMix_Hardware_PWM_Stage(1, pwm_duty);              /* 相A上管占空比D */
+        CMix_Hardware_PWM_Stage(2, 10000);                 /* 相B上管常通 */
         
     } else if (g_dcdc_status.active_mode == CMIX_MODE_BOOST) {
-        /* BOOST模式 */
+        /* BOOST模式: 相A上管常通, 相B下管占空比D */
         g_dcdc_status.pwm_duty_buck = 0;
         g_dcdc_status.pwm_duty_boost = pwm_duty;
         
-        CMix_Hardware_Set_PWM_Duty(1, 10000);              /* BUCK上管常开 */
-        CMix_Hardware_Set_PWM_Duty(2, 0);                  /* BUCK下管关闭 */
-        CMix_Hardware_Set_PWM_Duty(3, pwm_duty);           /* BOOST上管 */
-        CMix_Hardware_Set_PWM_Duty(4, 10000 - pwm_duty);   /* BOOST下管 */
+        CMix_Hardware_PWM_Stage(1, 10000);                 /* 相A上管常通 */
+        CMix_Hardware_PWM_Stage(2, 10000 - pwm_duty);      /* 相B上管1-D, 下管D */
     }
+#endif
+    CMix_Hardware_PWM_Commit();
 }
 
+#if CMIX_DUTY_FEEDFORWARD_ENABLE
+/**
+ * @brief 占空比前馈 (理想变换比)
+ * @param None
+ * @retval 前馈占空比 (0-10000), 除数低于CMIX_FF_MIN_DIVISOR_MV时为0
+ * @note  BUCK: D = Vset / Vin, BOOST: D = 1 - Vin / Vset.
+ *        除数的倒数仅在除数变化超过死区时迭代更新, 每步只有一次乘法
+ */
+static int32_t CMix_DCDC_Duty_Feedforward(void)
+{
+    uint32_t ratio;
+
+    if (g_dcdc_status.active_mode == CMIX_MODE_BUCK) {
+        CMix_Recip_Update(&g_ff_recip, g_dcdc_status.input_voltage);
+        ratio = CMix_Recip_Mul(&g_ff_recip, g_dcdc_control.voltage_setpoint * 10000U);
+    } else if (g_dcdc_status.active_mode == CMIX_MODE_BOOST) {
+        CMix_Recip_Update(&g_ff_recip, g_dcdc_control.voltage_setpoint);
+        ratio = CMix_Recip_Mul(&g_ff_recip, g_dcdc_status.input_voltage * 10000U);
+        ratio = (ratio < 10000U) ? (10000U - ratio) : 0U;
+    } else {
+        return 0;
+    }
+
+    if (!CMix_Recip_Is_Valid(&g_ff_recip)) {
+        return 0;
+    }
+    return (ratio > 10000U) ? 10000 : (int32_t)ratio;
+}
+#endif
+
+#if CMIX_PI_FIXED_POINT_ENABLE
+/**
+ * @brief 运行时增益转换为Q15 (限制在0 ~ 65535)
+ * @param gain: 增益
+ * @retval Q15值
+ */
+static int32_t CMix_DCDC_Gain_To_Q15(float gain)
+{
+    if (gain <= 0.0f) {
+        return 0;
+    }
+    if (gain >= 65535.0f) {
+        return CMIX_Q31_MAX;
+    }
+    return (int32_t)(gain * 32768.0f + 0.5f);
+}
+
+/**
+ * @brief 运行时增益转换为Q31 (限制在0 ~ 1.0)
+ * @param gain: 增益 (Ki * Ts)
+ * @retval Q31值
+ */
+static int32_t CMix_DCDC_Gain_To_Q31(float gain)
+{
+    if (gain <= 0.0f) {
+        return 0;
+    }
+    if (gain >= 1.0f) {
+        return CMIX_Q31_MAX;
+    }
+    return (int32_t)(gain * 2147483648.0f);
+}
+#endif
+
 /**
  * @brief 电压ADC值转换
- * @param adc_value: ADC原始值
+ * @param adc_value: 过采样扩展码值 (1/16 LSB)
  * @retval 电压值 (mV)
  */
-static uint16_t CMix_DCDC_Convert_Voltage(uint16_t adc_value)
+static uint32_t CMix_DCDC_Convert_Voltage(uint16_t adc_value)
+{
+    /* 12位ADC, 分压比和换算参考见CMix_config.h; 满量程66V超出uint16_t, 按uint32_t返回 */
+    return CMix_Hardware_Convert_Voltage_Ext_mV(adc_value);
+}
+
+/**
+ * @brief 电流方向处理
+ * @param current_ma: TP181A1换算后的电流 (mA, CMix_Hardware_Convert_Current_mA)
+ * @retval 电流值 (mA), 反向电流按0处理
+ */
+static uint32_t CMix_DCDC_Convert_Current(int32_t current_ma)
 {
-    /* 假设ADC参考电压3.3V，12位ADC，电压分压比1:20 */
-    uint32_t voltage_mv = (adc_value * 3300 * 20) / 4095;
-    return (uint16_t)voltage_mv;
+    if (current_ma <= 0) {
+        return 0;
+    }
+    return (uint32_t)current_ma;
 }
 
 /**
- * @brief 电流ADC值转换
- * @param adc_value: ADC原始值
- * @retval 电流值 (mA)
+ * @brief 无符号探针值移位后饱和到16位
+ * @param value: 原值
+ * @param shift: 移位
+ * @retval 16位值
  */
-static uint16_t CMix_DCDC_Convert_Current(uint16_t adc_value)
+static uint16_t CMix_DCDC_Probe_Unsigned(uint32_t value, uint8_t shift)
 {
-    /* 假设电流传感器灵敏度10mV/A，偏置电压1.65V */
-    int32_t current_ma = ((int32_t)adc_value * 3300 / 4095 - 1650) * 100;
-    if (current_ma < 0) current_ma = 0;
-    return (uint16_t)current_ma;
+    value >>= shift;
+    return (value > 0xFFFF) ? 0xFFFF : (uint16_t)value;
 }
 
 /**
  * @brief CMix DCDC状态机处理
  * @param None
  * @retval None
+ * @note  在1ms任务中执行, 保护中断可能随时锁存故障; 每次迁移都经CMix_DCDC_Transition,
+ *        状态已被改为故障时不覆盖
  */
 void CMix_DCDC_State_Machine(void)
 {
-    static uint32_t state_timer = 0;
+    CMix_System_State_t state = g_dcdc_status.state;
     
-    switch (g_dcdc_status.state) {
+    switch (state) {
         case CMIX_STATE_INIT:
             /* 初始化状态 */
             if (g_dcdc_control.enable) {
-                g_dcdc_status.state = CMIX_STATE_IDLE;
+                (void)CMix_DCDC_Transition(CMIX_STATE_INIT, CMIX_STATE_IDLE);
             }
             break;
             
@@ -541,17 +922,16 @@ void CMix_DCDC_State_Machine(void)
             
         case CMIX_STATE_SOFT_START:
             /* 软启动状态 */
-            state_timer++;
-            if (state_timer >= CMIX_SOFT_START_TIME) {
-                g_dcdc_status.state = CMIX_STATE_RUNNING;
-                state_timer = 0;
+            g_soft_start_ms++;
+            if (g_soft_start_ms >= CMIX_SOFT_START_TIME) {
+                (void)CMix_DCDC_Transition(CMIX_STATE_SOFT_START, CMIX_STATE_RUNNING);
             }
             break;
             
         case CMIX_STATE_RUNNING:
             /* 正常运行状态 */
             if (!g_dcdc_control.enable) {
-                g_dcdc_status.state = CMIX_STATE_IDLE;
+                (void)CMix_DCDC_Transition(CMIX_STATE_RUNNING, CMIX_STATE_IDLE);
             }
             break;
             
@@ -561,11 +941,32 @@ void CMix_DCDC_State_Machine(void)
             break;
             
         default:
-            g_dcdc_status.state = CMIX_STATE_INIT;
+            (void)CMix_DCDC_Transition(state, CMIX_STATE_INIT);
             break;
     }
 }
 
+/**
+ * @brief 状态迁移 (比较并设置)
+ * @param from: 期望的当前状态
+ * @param to: 新状态
+ * @retval true = 已迁移; false = 状态已被改变 (例如保护中断锁存了故障)
+ * @note  关中断下比较和写入, 与CMix_DCDC_Latch_Fault互斥
+ */
+static bool CMix_DCDC_Transition(CMix_System_State_t from, CMix_System_State_t to)
+{
+    uint32_t primask = __get_PRIMASK();
+    bool done = false;
+
+    __disable_irq();
+    if (g_dcdc_status.state == from) {
+        g_dcdc_status.state = to;
+        done = true;
+    }
+    __set_PRIMASK(primask);
+    return done;
+}
+
 /**
  * @brief CMix DCDC参数调试输出
  * @param None
@@ -574,28 +975,13 @@ void CMix_DCDC_State_Machine(void)
 void CMix_DCDC_Debug_Print(void)
 {
     #if CMIX_DEBUG_ENABLE
-    char msg_buffer[128];
-    
-    CMix_Protocol_Send_Debug_Message("=== CMix DCDC Status ===");
-    
-    sprintf(msg_buffer, "Mode: %d, State: %d", g_dcdc_status.mode, g_dcdc_status.state);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Vin: %dmV, Vout: %dmV", g_dcdc_status.input_voltage, g_dcdc_status.output_voltage);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Iin: %dmA, Iout: %dmA", g_dcdc_status.input_current, g_dcdc_status.output_current);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Power: %dW, Efficiency: %d%%", g_dcdc_status.output_power, g_dcdc_status.efficiency);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "PWM Buck: %d, Boost: %d", g_dcdc_status.pwm_duty_buck, g_dcdc_status.pwm_duty_boost);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Faults: 0x%02X", g_safety_monitor.fault_flags);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    CMix_Protocol_Send_Debug_Message("=======================");
+    CMIX_TRACE0(CMIX_TRACE_DCDC_BANNER);
+    CMIX_TRACE2(CMIX_TRACE_DCDC_MODE, g_dcdc_status.mode, g_dcdc_status.state);
+    CMIX_TRACE2(CMIX_TRACE_DCDC_VOLTAGE, g_dcdc_status.input_voltage, g_dcdc_status.output_voltage);
+    CMIX_TRACE2(CMIX_TRACE_DCDC_CURRENT, g_dcdc_status.input_current, g_dcdc_status.output_current);
+    CMIX_TRACE2(CMIX_TRACE_DCDC_POWER, g_dcdc_status.output_power, g_dcdc_status.efficiency);
+    CMIX_TRACE2(CMIX_TRACE_DCDC_PWM, g_dcdc_status.pwm_duty_buck, g_dcdc_status.pwm_duty_boost);
+    CMIX_TRACE1(CMIX_TRACE_DCDC_FAULTS, g_safety_monitor.fault_flags);
+    CMIX_TRACE0(CMIX_TRACE_DCDC_END);
     #endif
 }
\ No newline at end of file
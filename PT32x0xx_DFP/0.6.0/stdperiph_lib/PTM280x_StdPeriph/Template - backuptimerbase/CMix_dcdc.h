@@ -60,6 +60,9 @@ typedef struct {
     uint32_t output_power;                  // 输出功率 (mW)
     uint16_t pwm_duty_buck;                 // BUCK PWM占空比
     uint16_t pwm_duty_boost;                // BOOST PWM占空比
+    int32_t phase_current_a;                // 两相交错: 相A电流 (mA, 有符号)
+    int32_t phase_current_b;                // 两相交错: 相B电流 (mA, 有符号)
+    int32_t phase_trim;                     // 两相交错: 均流修正量 (占空比单位, 相A减、相B加)
     uint8_t efficiency;                     // 效率百分比
     CMix_Working_Mode_t mode;               // 工作模式
     CMix_Working_Mode_t active_mode;        // 当前激活模式
@@ -91,6 +94,30 @@ typedef struct {
     bool adc_ready;                         // ADC数据就绪标志
 } CMix_DCDC_Measurements_t;
 
+/* 内部信号探针 (遥测流和示波器共用, 16位定点值, 单位移位见CMix_config.h信号探针配置) */
+typedef enum {
+    CMIX_PROBE_VIN = 0,                     // 输入电压 (无符号, 1mV << CMIX_PROBE_VOLTAGE_SHIFT)
+    CMIX_PROBE_VOUT,                        // 输出电压 (同上)
+    CMIX_PROBE_IIN,                         // 输入电流 (有符号, 1mA << CMIX_PROBE_CURRENT_SHIFT)
+    CMIX_PROBE_IOUT,                        // 输出电流 (同上)
+    CMIX_PROBE_IA,                          // 两相交错相A电流 (同上)
+    CMIX_PROBE_IB,                          // 两相交错相B电流 (同上)
+    CMIX_PROBE_DUTY_BUCK,                   // BUCK占空比 (0-10000)
+    CMIX_PROBE_DUTY_BOOST,                  // BOOST占空比 (0-10000)
+    CMIX_PROBE_PHASE_TRIM,                  // 两相均流修正量 (有符号, 占空比单位)
+    CMIX_PROBE_POWER,                       // 输出功率 (无符号, 1mW << CMIX_PROBE_POWER_SHIFT)
+    CMIX_PROBE_STATE,                       // 系统状态[7:0] | 激活模式[15:8]
+    CMIX_PROBE_VOLTAGE_PI_INTEGRAL,         // 电压环积分项 (有符号, 占空比单位)
+    CMIX_PROBE_CURRENT_PI_INTEGRAL,         // 电流环积分项 (有符号, 占空比单位)
+    CMIX_PROBE_COUNT
+} CMix_DCDC_Probe_t;
+
+/* 有符号 (补码) 的探针 */
+#define CMIX_PROBE_SIGNED_MASK      ((1UL << CMIX_PROBE_IIN) | (1UL << CMIX_PROBE_IOUT) | (1UL << CMIX_PROBE_IA) | \
+                                     (1UL << CMIX_PROBE_IB) | (1UL << CMIX_PROBE_PHASE_TRIM) | \
+                                     (1UL << CMIX_PROBE_VOLTAGE_PI_INTEGRAL) | (1UL << CMIX_PROBE_CURRENT_PI_INTEGRAL))
+#define CMIX_PROBE_IS_SIGNED(probe) (((CMIX_PROBE_SIGNED_MASK >> (probe)) & 1UL) != 0)
+
 /* ========================= 函数声明 ========================= */
 
 /* DCDC初始化和配置 */
@@ -100,9 +127,11 @@ void CMix_DCDC_Enable_Control(bool enable);
 void CMix_DCDC_Enable(uint8_t enable);
 void CMix_DCDC_Set_Output_Voltage(uint32_t voltage);
 void CMix_DCDC_Set_Current_Limit(uint32_t current);
+void CMix_DCDC_Set_PI_Gains(float voltage_kp, float voltage_ki, float current_kp, float current_ki);
 
 /* DCDC控制算法 */
 void CMix_DCDC_Control_Loop(void);
+void CMix_DCDC_Control_Step(void);
 void CMix_DCDC_Control_Task(void);
 void CMix_DCDC_State_Machine(void);
 void CMix_DCDC_Mode_Auto_Switch(void);
@@ -116,9 +145,10 @@ void CMix_DCDC_Set_Mode(CMix_Working_Mode_t mode);
 void CMix_DCDC_Safety_Check(void);
 void CMix_DCDC_Emergency_Shutdown(void);
 void CMix_DCDC_Emergency_Stop(uint8_t emergency_code);
+void CMix_DCDC_Reset_Fault(void);
 bool CMix_DCDC_Is_Safe_To_Operate(void);
 
-/* PI控制器 */
+/* 浮点PI控制器 (定点控制器的参考实现, CMIX_PI_FIXED_POINT_ENABLE为0时控制环使用) */
 void CMix_DCDC_PI_Init(CMix_PI_Controller_t *pi, float kp, float ki, float output_min, float output_max);
 float CMix_DCDC_PI_Update(CMix_PI_Controller_t *pi, float setpoint, float feedback);
 void CMix_DCDC_PI_Reset(CMix_PI_Controller_t *pi);
@@ -128,6 +158,7 @@ CMix_DCDC_Control_t* CMix_DCDC_Get_Control_Status(void);
 CMix_DCDC_Measurements_t* CMix_DCDC_Get_Measurements(void);
 CMix_DCDC_Status_t* CMix_DCDC_Get_Status(void);
 CMix_Safety_Monitor_t* CMix_DCDC_Get_Safety_Status(void);
+uint16_t CMix_DCDC_Probe(uint8_t probe);
 void CMix_DCDC_Set_Target_Voltage(uint32_t voltage_mv);
 void CMix_DCDC_Set_Target_Current(uint16_t current_ma);
 
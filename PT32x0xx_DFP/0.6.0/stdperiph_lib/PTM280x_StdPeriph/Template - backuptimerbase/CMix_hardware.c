@@ -17,6 +17,9 @@
 
 #include "CMix_hardware.h"
 #include "CMix_protocol.h"
+#include "CMix_main.h"
+#include "CMix_crc.h"
+#include "CMix_trace.h"
 #include "CMix_config.h"
 #include "system_PT32x0xx.h"
 
@@ -28,10 +31,119 @@
 static uint32_t g_system_clock_freq = 0;
 static bool g_clock_config_ok = false;
 
+#if CMIX_ADC_CURRENT_TABLE_ENABLE
+/* 电流通道换算表 (编译期由CMIX_ADC_CURRENT_CURVE_MA生成, 位于flash) */
+const int16_t g_cmix_adc_current_table[4096] = {
+    CMIX_ADC_TABLE_4096(CMIX_ADC_CURRENT_TABLE_ENTRY)
+};
+#endif
+
+#if CMIX_CONTROL_ISR_ENABLE
+#if CMIX_ADC_SEQUENCER_ENABLE
+/* 快速通道: 注入组槽位 -> 通道号, 每个TIM1 TRGO全部转换 */
+static const uint8_t g_adc_fast_channels[CMIX_ADC_FAST_COUNT] = {
+    CMIX_ADC_CURRENT_A_CHANNEL,
+    CMIX_ADC_VOUT_CHANNEL,
+    CMIX_ADC_CURRENT_B_CHANNEL
+};
+
+/* 慢速通道: 规则组单通道转换, 每个TIM1 TRGO转换一个, 依次轮转 */
+static const uint8_t g_adc_slow_channels[CMIX_ADC_SLOW_COUNT] = {
+    CMIX_ADC_VIN_CHANNEL,
+    CMIX_ADC_BANDGAP_CHANNEL
+};
+static uint8_t g_adc_slow_slot = 0;                 // 规则组当前选择的慢速通道
+static bool g_adc_slow_seeded = false;              // 慢速通道已完成一轮 (抽取器已预置)
+static volatile uint16_t g_adc_bandgap_raw = 0;     // 内部基准码值
+#else
+/* ADC扫描序列: 扫描槽位 -> 通道号 */
+static const uint8_t g_adc_scan_channels[CMIX_ADC_SCAN_COUNT] = {
+    CMIX_ADC_VIN_CHANNEL,
+    CMIX_ADC_CURRENT_A_CHANNEL,
+    CMIX_ADC_VOUT_CHANNEL,
+    CMIX_ADC_CURRENT_B_CHANNEL
+};
+#endif
+
+#if CMIX_ADC_DMA_ENABLE
+/* DMA乒乓缓冲 [半区][扫描槽位]: DMA循环写入, 半传输/传输完成中断发布就绪半区 */
+static volatile uint16_t g_adc_dma_buffer[CMIX_ADC_DMA_HALF_COUNT][CMIX_ADC_SCAN_COUNT] = {{0}};
+static volatile uint8_t g_adc_ready_half = 0;      // 最近一次完整扫描所在半区 (DMA正在写另一半区)
+static uint8_t g_adc_channel_slot[CMIX_ADC_SCAN_COUNT];  // 通道号 -> 扫描槽位
+#else
+/* 最近一次扫描结果 (按通道号索引, ADC中断写入) */
+static volatile uint16_t g_adc_scan_result[CMIX_ADC_SCAN_COUNT] = {0};
+#endif
+
+/* 扫描序号 (每发布一次完整扫描加1, 用于快照一致性校验) */
+static volatile uint32_t g_adc_sequence = 0;
+
+/* 过采样抽取器和抽取比 (按通道号索引, 扫描中断内更新) */
+static CMix_ADC_Decimator_t g_adc_decimator[CMIX_ADC_SCAN_COUNT];
+static const uint8_t g_adc_osr_log2[CMIX_ADC_SCAN_COUNT] = CMIX_ADC_OSR_LOG2_INIT;
+
+#if CMIX_ADC_AWD_ENABLE
+/* 模拟看门狗轮流监视的通道: 每次扫描后切换, 每个通道每CMIX_ADC_AWD_COUNT次扫描监视一次 */
+static const uint8_t g_adc_awd_channels[CMIX_ADC_AWD_COUNT] = {
+    CMIX_ADC_CURRENT_A_CHANNEL,
+    CMIX_ADC_VOUT_CHANNEL,
+    CMIX_ADC_CURRENT_B_CHANNEL
+};
+static volatile uint32_t g_adc_awd_window[CMIX_ADC_SCAN_COUNT];  // AWDTR值 (高16位上限, 低16位下限), 按通道号索引
+static uint8_t g_adc_awd_slot = 0;                  // 当前监视的通道
+static CMix_ADC_AWD_Stats_t g_adc_awd_stats = {{0}};
+#endif
+#endif
+
+#if CMIX_PWM_CENTER_ALIGNED_ENABLE
+/* 中心对齐: 谷点 (向下计数溢出) 触发ADC; 双更新时注入组在峰点 (向上计数溢出) 再触发一次,
+ * 规则组 (慢速通道) 仍每周期一次 */
+#if CMIX_PWM_DOUBLE_UPDATE_ENABLE
+#define CMIX_PWM_ADC_JTRIGGER       (TIM_ADCTrigger_DOAE | TIM_ADCTrigger_UOAE)
+#else
+#define CMIX_PWM_ADC_JTRIGGER       TIM_ADCTrigger_DOAE
+#endif
+#define CMIX_PWM_ADC_TRIGGER        TIM_ADCTrigger_DOAE
+#endif
+
+/* PWM两阶段提交: 暂存的比较值 (TIM1计数) 和提交统计 */
+static uint16_t g_pwm_staged[CMIX_PWM_CHANNEL_COUNT] = {0};
+static CMix_PWM_Commit_Stats_t g_pwm_commit_stats = {0, 0, 0xFFFF};
+
+/* 相A/相B比较值的抖动余数 (1/2^CMIX_PWM_DITHER_BITS计数) */
+#define CMIX_PWM_DITHER_MASK        ((1U << CMIX_PWM_DITHER_BITS) - 1)
+static uint16_t g_pwm_dither[2] = {0};
+
+/* 比较器保护: 两路共用的LDAC阈值码和越限统计 */
+static uint8_t g_cmp_ldac_code = 0;
+static CMix_CMP_Stats_t g_cmp_stats = {{0}};
+
+#if CMIX_UART_TX_ASYNC_ENABLE
+/* UART发送环形缓冲: 读写位置自由递增, 取模后索引 */
+#define CMIX_UART_TX_MASK           (CMIX_UART_TX_BUFFER_SIZE - 1)
+static uint8_t g_uart_tx_buffer[CMIX_UART_TX_BUFFER_SIZE];
+static volatile uint16_t g_uart_tx_head = 0;    // 写入位置 (发送方)
+static volatile uint16_t g_uart_tx_tail = 0;    // 读取位置 (TXE中断)
+static CMix_UART_TX_Stats_t g_uart_tx_stats = {0};
+#endif
+
 /* ========================= 私有函数声明 ========================= */
 
 static void CMix_Hardware_GPIO_Config(void);
 static void CMix_Hardware_Clock_Config(void);
+static uint16_t CMix_Hardware_PWM_Compare(uint8_t channel, uint16_t pulse);
+#if CMIX_ADC_DMA_ENABLE
+static void CMix_Hardware_ADC_DMA_Config(void);
+#endif
+#if CMIX_ADC_SEQUENCER_ENABLE
+static void CMix_Hardware_ADC_Slow_Complete(uint16_t sample);
+#endif
+#if CMIX_ADC_AWD_ENABLE
+static bool CMix_Hardware_ADC_AWD_Is_Watched(uint8_t channel);
+static void CMix_Hardware_ADC_AWD_Trip(uint8_t channel);
+static void CMix_Hardware_ADC_AWD_Next(void);
+#endif
+static void CMix_Hardware_CMP_Trip(uint8_t unit);
 
 /* ========================= 公共函数实现 ========================= */
 
@@ -48,6 +160,9 @@ void CMix_Hardware_Init(void)
     /* GPIO配置 */
     CMix_Hardware_GPIO_Config();
 
+    /* CRC初始化 - 协议帧校验使用硬件CRC单元 */
+    CMix_CRC_Init();
+
     /* UART初始化 */
     CMix_Hardware_UART_Init();
 
@@ -116,7 +231,7 @@ void CMix_Hardware_UART_Init(void)
     /* 配置UART中断优先级 */
     NVIC_InitTypeDef NVIC_InitStruct;
     NVIC_InitStruct.NVIC_IRQChannel = UART0_IRQn;
-    NVIC_InitStruct.NVIC_IRQChannelPriority = 1;
+    NVIC_InitStruct.NVIC_IRQChannelPriority = CMIX_NVIC_PRIORITY_UART;
     NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStruct);
 
@@ -156,15 +271,85 @@ void CMix_Hardware_ADC_Init(void)
     ADC_InitTypeDef ADC_InitStruct;
     ADC_InitStruct.ADC_Mode = ADC_Mode_Single;
     ADC_InitStruct.ADC_RVSPS = ADC_RVSPS_VDDA;    // 使用VDDA作为参考电压 (5.0V)
-    ADC_InitStruct.ADC_Channel = CMIX_ADC_VIN_CHANNEL;  // 默认配置Vin通道
+    ADC_InitStruct.ADC_Channel = CMIX_ADC_CHANNEL_SEL(CMIX_ADC_VIN_CHANNEL);  // 默认配置Vin通道
     ADC_InitStruct.ADC_Prescaler = 1;
     ADC_InitStruct.ADC_ChannelSetupTime = 1;
-    ADC_InitStruct.ADC_SampleTime = 33;  // 🔧 统一采样时间：239.5周期，适配TP181A1输出阻抗
+    ADC_InitStruct.ADC_SampleTime = CMIX_ADC_SMP_SETTING;  // 🔧 统一采样时间 (双更新时缩短)
     ADC_Init(ADC0, &ADC_InitStruct);
 
+#if CMIX_CONTROL_ISR_ENABLE
+    uint8_t i;
+    NVIC_InitTypeDef NVIC_InitStruct;
+#if CMIX_ADC_SEQUENCER_ENABLE
+    /* 多速率采样: TIM1 TRGO同时触发注入组 (全部快速通道) 和规则组 (一个慢速通道), 注入组优先.
+     * 慢速通道在注入组结束中断中切换, 距下一次触发约一个PWM周期, 通道切换和输入建立
+     * 不占用转换时间; 扫描长度只随快速通道数增长 */
+    ADC_InjectedScanCmd(ADC0, ENABLE);
+    ADC_JSCNTConfig(ADC0, CMIX_ADC_FAST_COUNT);
+    for (i = 0; i < CMIX_ADC_FAST_COUNT; i++) {
+        ADC_InjectScanChannelConfig(ADC0, i, CMIX_ADC_CHANNEL_SEL(g_adc_fast_channels[i]));
+    }
+    ADC_InjectedTriggerSource(ADC0, ADC_InjectedTriggerSource_Timer);
+    ADC_InjectedTimerTriggerSource(ADC0, ADC_InjectedTimerTriggerSource_TIM1);
+
+    ADC_ChannelConfig(ADC0, CMIX_ADC_CHANNEL_SEL(g_adc_slow_channels[0]));
+    ADC_RegularTriggerSource(ADC0, ADC_RegularTriggerSource_Timer);
+    ADC_RegularTimerTriggerSource(ADC0, ADC_RegularTimerTriggerSource_TIM1);
+
+    /* 注入组扫描结束中断运行控制环, 规则组转换结束中断轮转慢速通道 */
+    ADC_ITConfig(ADC0, ADC_IT_JEOS | ADC_IT_EOC, ENABLE);
+    NVIC_InitStruct.NVIC_IRQChannel = ADC0_IRQn;
+#else
+    /* 规则组扫描: 每个TIM1 TRGO转换全部通道, 扫描结束中断运行控制环 */
+    ADC_RegularScanCmd(ADC0, ENABLE);
+    ADC_RSCNTConfig(ADC0, CMIX_ADC_SCAN_COUNT);
+    for (i = 0; i < CMIX_ADC_SCAN_COUNT; i++) {
+        ADC_ScanChannelConfig(ADC0, i, CMIX_ADC_CHANNEL_SEL(g_adc_scan_channels[i]));
+    }
+    ADC_RegularTriggerSource(ADC0, ADC_RegularTriggerSource_Timer);
+    ADC_RegularTimerTriggerSource(ADC0, ADC_RegularTimerTriggerSource_TIM1);
+
+#if CMIX_ADC_DMA_ENABLE
+    /* 每次转换结果由DMA搬运, 传输中断代替扫描结束中断 */
+    for (i = 0; i < CMIX_ADC_SCAN_COUNT; i++) {
+        g_adc_channel_slot[g_adc_scan_channels[i]] = i;
+    }
+    CMix_Hardware_ADC_DMA_Config();
+    ADC_DMACmd(ADC0, ENABLE);
+    NVIC_InitStruct.NVIC_IRQChannel = DMA_IRQn;
+#else
+    /* 使能扫描结束中断 */
+    ADC_ITConfig(ADC0, ADC_IT_EOS, ENABLE);
+    NVIC_InitStruct.NVIC_IRQChannel = ADC0_IRQn;
+#endif
+#endif
+
+#if CMIX_ADC_AWD_ENABLE
+    /* 模拟看门狗: 单通道模式, 越限转换结束即中断, 不等待扫描结束.
+     * 协议设置限值之前窗口为满量程 (不触发) */
+    for (i = 0; i < CMIX_ADC_SCAN_COUNT; i++) {
+        g_adc_awd_window[i] = (uint32_t)CMIX_ADC_RESOLUTION << 16;
+    }
+    ADC_AnalogWatchdogChannelControl(ADC0, ADC_Channel_Single);
+    ADC_AnalogWatchdogChannelSelect(ADC0, CMIX_ADC_CHANNEL_SEL(g_adc_awd_channels[0]));
+    ADC_AnalogWatchdogLowerThreshold(ADC0, 0);
+    ADC_AnalogWatchdogHigherThreshold(ADC0, CMIX_ADC_RESOLUTION);
+    ADC_AnalogWatchdogCmd(ADC0, ENABLE);
+    ADC_ITConfig(ADC0, ADC_IT_AWD, ENABLE);
+#endif
+    NVIC_InitStruct.NVIC_IRQChannelPriority = CMIX_NVIC_PRIORITY_ADC;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+#if CMIX_ADC_AWD_ENABLE && CMIX_ADC_DMA_ENABLE
+    /* DMA模式下ADC中断只用于模拟看门狗 */
+    NVIC_InitStruct.NVIC_IRQChannel = ADC0_IRQn;
+    NVIC_Init(&NVIC_InitStruct);
+#endif
+#else
     /* 🔧 修正：配置ADC使用TIM1 TRGO触发 */
     ADC_RegularTimerTriggerSource(ADC0, ADC_RegularTimerTriggerSource_TIM1);
     /* 注意：PT32x不需要单独的TriggerCmd，定时器触发源配置后自动生效 */
+#endif
 
     /* 使能ADC */
     ADC_Cmd(ADC0, ENABLE);
@@ -173,6 +358,41 @@ void CMix_Hardware_ADC_Init(void)
     while(ADC_GetFlagStatus(ADC0, ADC_FLAG_RDY) == RESET);
 }
 
+#if CMIX_ADC_DMA_ENABLE
+/**
+ * @brief ADC扫描DMA配置 - DMA0_CH0循环搬运ADC0数据寄存器到乒乓缓冲
+ * @param None
+ * @retval None
+ * @note  传输总数为两个半区, 半传输中断表示半区0就绪, 传输完成中断表示半区1就绪
+ */
+static void CMix_Hardware_ADC_DMA_Config(void)
+{
+    DMA_InitTypeDef DMA_InitStruct;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA0, ENABLE);
+
+    DMA_Cmd(DMA0_CH0, DISABLE);
+    DMA_PeripheralConfig(DMA0, DMA_CHNUM_0, DMA_CH_ADC0);
+
+    DMA_InitStruct.DMA_SourceBaseAddress = (u32)&ADC0->DR;
+    DMA_InitStruct.DMA_DestinationBaseAddress = (u32)&g_adc_dma_buffer[0][0];
+    DMA_InitStruct.DMA_NumberOfData = CMIX_ADC_DMA_HALF_COUNT * CMIX_ADC_SCAN_COUNT;
+    DMA_InitStruct.DMA_SourceDataSize = DMA_SourceDataSize_Half;
+    DMA_InitStruct.DMA_DestinationDataSize = DMA_DestinationDataSize_Half;
+    DMA_InitStruct.DMA_SourceAddressIncrement = DMA_SourceAddressIncrement_Disable;
+    DMA_InitStruct.DMA_DestinationAddressIncrement = DMA_DestinationAddressIncrement_Enable;
+    DMA_InitStruct.DMA_Direction = DMA_Direction_PeripheralToMemory;
+    DMA_InitStruct.DMA_CircularMode = DMA_CircularMode_Enable;
+    DMA_InitStruct.DMA_ChannelPriority = DMA_ChannelPriority_1;
+    DMA_InitStruct.DMA_Burst = DMA_Burst_1Unit;
+    DMA_Init(DMA0_CH0, &DMA_InitStruct);
+
+    DMA_ClearITFlag(DMA0, DMA_FLAG_C0THF | DMA_FLAG_TC0F | DMA_FLAG_TE0F);
+    DMA_ITConfig(DMA0, DMA_IT_TH0E | DMA_IT_TC0E, ENABLE);
+    DMA_Cmd(DMA0_CH0, ENABLE);
+}
+#endif
+
 /**
  * @brief CMix OPA初始化 - 电压跟随器配置
  * @param None
@@ -212,13 +432,15 @@ void CMix_Hardware_OPA_Init(void)
  * @brief CMix CMP初始化 - 过压保护配置
  * @param None
  * @retval None
+ * @note  比较器输出直连TIM1刹车 (见CMix_Hardware_TIM_Init), 关断不经过中断;
+ *        中断只记录越限/恢复事件
  */
 void CMix_Hardware_CMP_Init(void)
 {
     /* 🔧 CMP过压保护配置 - 硬件快速响应 */
     
-    /* 使能CMP时钟 */
-    RCC_APBPeriph3ClockCmd(RCC_APBPeriph3_CMP0, ENABLE);
+    /* 使能CMP和LDAC时钟 */
+    RCC_APBPeriph3ClockCmd(RCC_APBPeriph3_CMP0 | RCC_APBPeriph3_CMP1 | RCC_APBPeriph3_LDAC, ENABLE);
     
     /* 使能GPIO时钟 */
     RCC_AHBPeriphClockCmd(RCC_AHBPeriph_GPIOA | RCC_AHBPeriph_GPIOB, ENABLE);
@@ -238,16 +460,21 @@ void CMix_Hardware_CMP_Init(void)
     GPIO_InitStruct.GPIO_Pull = GPIO_Pull_NoPull;
     GPIO_Init(CMIX_CMP0_INPUT_PORT, &GPIO_InitStruct);  // GPIOB
 
-    /* 配置CMP1 - Vin过压保护 (60V阈值) */
+    /* LDAC阈值: 按配置电压换算码值, 比较器使能前写入 */
+    LDAC_Cmd(LDAC0, ENABLE);
+    CMix_Hardware_CMP_Set_Threshold(CMIX_CMP_THRESHOLD_MV);
+    memset(&g_cmp_stats, 0, sizeof(g_cmp_stats));
+
+    /* 配置CMP1 - Vin过压保护 */
     CMP_InitTypeDef CMP_InitStruct;
-    CMP_InitStruct.CMP_DigitalFilter = CMP_DigitalFilter_16;          // 数字滤波
+    CMP_InitStruct.CMP_DigitalFilter = CMP_DigitalFilter_16;          // 数字滤波16个采样时钟 (48MHz下约0.33us)
     CMP_InitStruct.CMP_InitializationDelayTime = 20;                 // 初始化延时
     CMP_InitStruct.CMP_NegativeInput = CMP_NegativeInput_LDAC;       // 负端接LDAC
-    CMP_InitStruct.CMP_OutputPolarity = CMP_OutputPolarity_Normal;   // 正常极性
+    CMP_InitStruct.CMP_OutputPolarity = CMP_OutputPolarity_Inverted; // 反相: 越限输出低, 与刹车低有效一致
     CMP_InitStruct.CMP_PositiveInput = CMP_PositiveInput_CMPxP0;          // 正端接PA8
     CMP_Init(CMIX_CMP1_UNIT, &CMP_InitStruct);
 
-    /* 配置CMP0 - Vout过压保护 (55V阈值) */
+    /* 配置CMP0 - Vout过压保护 (与CMP1共用LDAC阈值) */
     CMP_InitStruct.CMP_PositiveInput = CMP_PositiveInput_CMPxP1;          // 正端接PB4
     CMP_Init(CMIX_CMP0_UNIT, &CMP_InitStruct);
 
@@ -256,13 +483,13 @@ void CMix_Hardware_CMP_Init(void)
     
     /* CMP1中断配置 */
     NVIC_InitStruct.NVIC_IRQChannel = CMP1_IRQn;
-    NVIC_InitStruct.NVIC_IRQChannelPriority = 0;  // 最高优先级
+    NVIC_InitStruct.NVIC_IRQChannelPriority = CMIX_NVIC_PRIORITY_CMP;  // 最高优先级
     NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStruct);
     
     /* CMP0中断配置 */
     NVIC_InitStruct.NVIC_IRQChannel = CMP0_IRQn;
-    NVIC_InitStruct.NVIC_IRQChannelPriority = 0;  // 最高优先级
+    NVIC_InitStruct.NVIC_IRQChannelPriority = CMIX_NVIC_PRIORITY_CMP;  // 最高优先级
     NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStruct);
 
@@ -282,32 +509,18 @@ void CMix_Hardware_CMP_Init(void)
  * @brief CMP1中断处理函数 - Vin过压保护
  * @param None
  * @retval None
+ * @note  越限时TIM1已由CMP1刹车输入关断输出, 这里只记录事件
  */
 void CMP1_Handler(void)
 {
     if (CMP_GetITStatus(CMIX_CMP1_UNIT, CMP_IT_COF) != RESET) {
-        /* Vin超过60V阈值 - 立即保护动作 */
-        
-        /* 🚨 立即关闭所有PWM输出 */
-        CMix_Hardware_Set_PWM_Duty(1, 0);
-        CMix_Hardware_Set_PWM_Duty(2, 0);
-        CMix_Hardware_Set_PWM_Duty(3, 0);
-        CMix_Hardware_Set_PWM_Duty(4, 0);
-        
-        /* 点亮故障LED */
-        CMix_Hardware_GPIO_Write(CMIX_GPIO_FAULT_LED_PORT, CMIX_GPIO_FAULT_LED_PIN, 1);
-        
-        /* 设置故障状态 - 需要在DCDC模块中实现 */
-        // CMix_DCDC_Set_Fault_State(CMIX_FAULT_VIN_OVERVOLTAGE);
-        
-        /* 清除中断标志 */
+        CMix_Hardware_CMP_Trip(1);
         CMP_ClearFlag(CMIX_CMP1_UNIT, CMP_IT_COF);
     }
     
     if (CMP_GetITStatus(CMIX_CMP1_UNIT, CMP_IT_COR) != RESET) {
-        /* Vin恢复正常 - 但需要ADC二次确认 */
-        
-        /* 清除中断标志 */
+        /* Vin恢复正常 - 刹车锁存至复位, 只计数 */
+        g_cmp_stats.recoveries[1]++;
         CMP_ClearFlag(CMIX_CMP1_UNIT, CMP_IT_COR);
     }
 }
@@ -316,32 +529,18 @@ void CMP1_Handler(void)
  * @brief CMP0中断处理函数 - Vout过压保护
  * @param None  
  * @retval None
+ * @note  越限时TIM1已由CMP0刹车输入关断输出, 这里只记录事件
  */
 void CMP0_Handler(void)
 {
     if (CMP_GetITStatus(CMIX_CMP0_UNIT, CMP_IT_COF) != RESET) {
-        /* Vout超过55V阈值 - 立即保护动作 */
-        
-        /* 🚨 立即关闭所有PWM输出 */
-        CMix_Hardware_Set_PWM_Duty(1, 0);
-        CMix_Hardware_Set_PWM_Duty(2, 0);
-        CMix_Hardware_Set_PWM_Duty(3, 0);
-        CMix_Hardware_Set_PWM_Duty(4, 0);
-        
-        /* 点亮故障LED */
-        CMix_Hardware_GPIO_Write(CMIX_GPIO_FAULT_LED_PORT, CMIX_GPIO_FAULT_LED_PIN, 1);
-        
-        /* 设置故障状态 */
-        // CMix_DCDC_Set_Fault_State(CMIX_FAULT_VOUT_OVERVOLTAGE);
-        
-        /* 清除中断标志 */
+        CMix_Hardware_CMP_Trip(0);
         CMP_ClearFlag(CMIX_CMP0_UNIT, CMP_IT_COF);
     }
     
     if (CMP_GetITStatus(CMIX_CMP0_UNIT, CMP_IT_COR) != RESET) {
-        /* Vout恢复正常 - 但需要ADC二次确认 */
-        
-        /* 清除中断标志 */
+        /* Vout恢复正常 - 刹车锁存至复位, 只计数 */
+        g_cmp_stats.recoveries[0]++;
         CMP_ClearFlag(CMIX_CMP0_UNIT, CMP_IT_COR);
     }
 }
@@ -377,6 +576,14 @@ void CMix_Hardware_TIM_Init(void)
     /* 配置PWM引脚的复用功能 */
     GPIO_DigitalRemapConfig(AFIOA, GPIO_Pin_5, AFIO_AF_2, ENABLE);  // TIM1_CH1
     GPIO_DigitalRemapConfig(AFIOA, GPIO_Pin_7, AFIO_AF_2, ENABLE);  // TIM1_CH1N
+
+    /* 🔧 相B TIM1_CH2/CH2N (四开关时为输出侧半桥, 交错时为并联第二相) */
+    GPIO_InitStruct.GPIO_Pin = CMIX_PWM_PHASE_B_HIGH_PIN | CMIX_PWM_PHASE_B_LOW_PIN;
+    GPIO_InitStruct.GPIO_Mode = GPIO_Mode_OutPP;     // 推挽输出模式
+    GPIO_InitStruct.GPIO_Pull = GPIO_Pull_NoPull;
+    GPIO_Init(CMIX_PWM_PHASE_B_PORT, &GPIO_InitStruct);
+    GPIO_DigitalRemapConfig(AFIOA, CMIX_PWM_PHASE_B_HIGH_PIN, AFIO_AF_2, ENABLE);  // TIM1_CH2
+    GPIO_DigitalRemapConfig(AFIOA, CMIX_PWM_PHASE_B_LOW_PIN, AFIO_AF_2, ENABLE);   // TIM1_CH2N
     
     /* 🔧 配置BKIN保护引脚 - PA8 (CMP1输出直接连接) */
     GPIO_InitStruct.GPIO_Pin = GPIO_Pin_8;        // PA8 作为BKIN输入(CMP1输出)
@@ -392,20 +599,44 @@ void CMix_Hardware_TIM_Init(void)
 
     /* TIM1基础配置 - 🔧 修正PWM频率为100kHz */
     TIM_TimeBaseInitTypeDef TIM_TimeBaseStruct;
+#if CMIX_PWM_CENTER_ALIGNED_ENABLE
+    // 中心对齐: 0 -> 240 -> 0, 48MHz / (0+1) / (2*240) = 100kHz PWM频率
+    TIM_TimeBaseStruct.TIM_AutoReloadValue = CMIX_PWM_COMPARE_SCALE;   // ARR = 240
+    TIM_TimeBaseStruct.TIM_Prescaler = 0;              // PSC = 0 (不分频)
+    TIM_TimeBaseStruct.TIM_Direction = TIM_Direction_Up;
+#if CMIX_PWM_DOUBLE_UPDATE_ENABLE
+    TIM_TimeBaseStruct.TIM_CenterAlignedMode = TIM_CenterAlignedMode3_Enable;  // 谷点和峰点都产生更新事件
+#else
+    TIM_TimeBaseStruct.TIM_CenterAlignedMode = TIM_CenterAlignedMode1_Enable;  // 谷点产生更新事件
+#endif
+#else
     // 48MHz / (0+1) / (479+1) = 100kHz PWM频率
     TIM_TimeBaseStruct.TIM_AutoReloadValue = 479;      // ARR = 479 (480个计数)
     TIM_TimeBaseStruct.TIM_Prescaler = 0;              // PSC = 0 (不分频)
     TIM_TimeBaseStruct.TIM_Direction = TIM_Direction_Up;
     TIM_TimeBaseStruct.TIM_CenterAlignedMode = TIM_CenterAlignedMode_Disable;
+#endif
     TIM_TimeBaseInit(TIM1, &TIM_TimeBaseStruct);
 
+#if CMIX_PWM_PRELOAD_ENABLE
+    /* 🔧 比较值预装载: OCR写入影子寄存器, 更新事件时四路同时生效 (库无对应接口, 直接置位CPC) */
+    TIM1->CR |= TIM_CR_CPC;
+#endif
+
+#if CMIX_PWM_CENTER_ALIGNED_ENABLE
+    /* 🔧 计数溢出直接触发ADC注入组和规则组: 谷点为上管导通中点, 峰点为下管导通中点,
+     * 两处的电感电流瞬时值都等于周期平均值, 采样避开开关边沿 */
+    TIM_ADCTrigger(TIM1, CMIX_PWM_ADC_JTRIGGER, TIM_ScanMode_Inject, ENABLE);
+    TIM_ADCTrigger(TIM1, CMIX_PWM_ADC_TRIGGER, TIM_ScanMode_Regular, ENABLE);
+#else
     /* 🔧 配置TIM1 TRGO用于触发ADC - 每个PWM周期触发一次ADC */
     TIM_MasterModeInitTypeDef TIM_MasterModeInitStruct;
     TIM_MasterModeInitStruct.TIM_Synchronization = 0;
     TIM_MasterModeInitStruct.TIM_MasterMode = TIM_MasterMode_Update;  // 更新事件产生TRGO
     TIM_MasterModeInit(TIM1, &TIM_MasterModeInitStruct);
+#endif
 
-    /* PWM模式配置 - 只使用TIM1_CH1及其互补输出 */
+    /* PWM模式配置 - 相A TIM1_CH1、相B TIM1_CH2及各自互补输出 */
     TIM_OCInitTypeDef TIM_OCInitStruct;
     TIM_OCInitStruct.TIM_Channel = TIM_Channel_1;
     TIM_OCInitStruct.TIM_OCMode = TIM_OCMode_PWM1;
@@ -416,14 +647,29 @@ void CMix_Hardware_TIM_Init(void)
     TIM_OCInitStruct.TIM_UpOCValue = 0;    // 初始占空比为0
     TIM_OCInitStruct.TIM_DownOCValue = 0;
 
-    /* 只初始化TIM1_CH1通道 (PA5主输出 + PA7互补输出) */
+    /* 相A: TIM1_CH1 (PA5主输出 + PA7互补输出) */
+    TIM_OCInit(TIM1, &TIM_OCInitStruct);
+
+    /* 相B: TIM1_CH2, 四开关时同为PWM1 (BUCK上管常通, BOOST时下管斩波) */
+    TIM_OCInitStruct.TIM_Channel = TIM_Channel_2;
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    /* 两相交错: PWM2模式, 比较值为满量程时无输出 (见CMix_Hardware_PWM_Compare) */
+    TIM_OCInitStruct.TIM_OCMode = TIM_OCMode_PWM2;
+    TIM_OCInitStruct.TIM_UpOCValue = CMIX_PWM_COMPARE_SCALE;
+    TIM_OCInitStruct.TIM_DownOCValue = CMIX_PWM_COMPARE_SCALE;
+#endif
     TIM_OCInit(TIM1, &TIM_OCInitStruct);
 
     /* 🔧 配置BKIN和刹车功能 - 关键安全功能！ */
     TIM_BKICRInitTypeDef TIM_BKICRInitStruct;
     TIM_BKICRInitStruct.TIM_Break = TIM_Break_Enable;                                    // 使能刹车功能
     TIM_BKICRInitStruct.TIM_BreakPolarity = TIM_BreakPolarity_Low;                      // 低电平触发刹车
+#if CMIX_ADC_AWD_ENABLE
+    TIM_BKICRInitStruct.TIM_BreakSource = TIM_BreakSource_CMP0 | TIM_BreakSource_CMP1 |  // CMP0和CMP1触发刹车,
+                                          TIM_BreakSource_Software;                      // ADC模拟看门狗软件刹车
+#else
     TIM_BKICRInitStruct.TIM_BreakSource = TIM_BreakSource_CMP0 | TIM_BreakSource_CMP1;  // CMP0和CMP1触发刹车
+#endif
     TIM_BKICRInitStruct.TIM_BreakInputControl = TIM_BreakInput_TIMOFF;                  // 刹车时关闭TIM输出
     TIM_BKICRInitStruct.TIM_Breakfilter = TIM_Breakfilter_None;                         // 无滤波
     TIM_BKICRInit(TIM1, &TIM_BKICRInitStruct);
@@ -446,11 +692,15 @@ void CMix_Hardware_TIM_Init(void)
  */
 void CMix_Hardware_UART_Send_Byte(uint8_t byte)
 {
+#if CMIX_UART_TX_ASYNC_ENABLE
+    CMix_Hardware_UART_Write(&byte, 1);
+#else
     /* 等待发送完成 */
     while (UART_GetFlagStatus(UART0, UART_FLAG_TXE) == RESET);
     
     /* 发送数据 */
     UART_SendData(UART0, byte);
+#endif
 }
 
 /**
@@ -460,9 +710,94 @@ void CMix_Hardware_UART_Send_Byte(uint8_t byte)
  */
 void CMix_Hardware_UART_Send_String(const char *str)
 {
-    while (*str) {
-        CMix_Hardware_UART_Send_Byte(*str++);
+    CMix_Hardware_UART_Write((const uint8_t *)str, (uint16_t)strlen(str));
+}
+
+/**
+ * @brief CMix UART写入发送队列 (不阻塞)
+ * @param data: 数据指针
+ * @param len: 数据长度
+ * @retval true=整块已入队, false=缓冲空间不足, 整块丢弃并计入溢出统计
+ * @note  整块入队或整块丢弃, 协议帧不会被截断. 入队期间仅屏蔽UART中断,
+ *        控制环中断不受影响; 调用方只能是主循环或UART中断
+ */
+bool CMix_Hardware_UART_Write(const uint8_t *data, uint16_t len)
+{
+#if CMIX_UART_TX_ASYNC_ENABLE
+    uint16_t head, used, i;
+    bool queued = false;
+
+    if (len == 0) {
+        return true;
     }
+
+    NVIC_DisableIRQ(UART0_IRQn);
+
+    head = g_uart_tx_head;
+    used = (uint16_t)(head - g_uart_tx_tail);
+
+    if (len <= (uint16_t)(CMIX_UART_TX_BUFFER_SIZE - used)) {
+        for (i = 0; i < len; i++) {
+            g_uart_tx_buffer[(uint16_t)(head + i) & CMIX_UART_TX_MASK] = data[i];
+        }
+        g_uart_tx_head = (uint16_t)(head + len);
+
+        used += len;
+        if (used > g_uart_tx_stats.high_water) {
+            g_uart_tx_stats.high_water = used;
+        }
+        g_uart_tx_stats.bytes_queued += len;
+        g_uart_tx_stats.frames_queued++;
+        queued = true;
+
+        /* 启动发送: TXE中断逐字节取出 */
+        UART_ITConfig(UART0, UART_IT_TXE, ENABLE);
+    } else {
+        g_uart_tx_stats.bytes_dropped += len;
+        g_uart_tx_stats.frames_dropped++;
+    }
+
+    NVIC_EnableIRQ(UART0_IRQn);
+
+    return queued;
+#else
+    uint16_t i;
+
+    for (i = 0; i < len; i++) {
+        CMix_Hardware_UART_Send_Byte(data[i]);
+    }
+    return true;
+#endif
+}
+
+/**
+ * @brief CMix UART发送队列剩余空间
+ * @param None
+ * @retval 可入队字节数
+ */
+uint16_t CMix_Hardware_UART_TX_Free(void)
+{
+#if CMIX_UART_TX_ASYNC_ENABLE
+    return (uint16_t)(CMIX_UART_TX_BUFFER_SIZE - (uint16_t)(g_uart_tx_head - g_uart_tx_tail));
+#else
+    return 0xFFFF;
+#endif
+}
+
+/**
+ * @brief CMix获取UART发送队列统计
+ * @param stats: 统计输出指针
+ * @retval None
+ */
+void CMix_Hardware_UART_Get_TX_Stats(CMix_UART_TX_Stats_t *stats)
+{
+#if CMIX_UART_TX_ASYNC_ENABLE
+    NVIC_DisableIRQ(UART0_IRQn);
+    *stats = g_uart_tx_stats;
+    NVIC_EnableIRQ(UART0_IRQn);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
 }
 
 /**
@@ -474,11 +809,18 @@ uint16_t CMix_Hardware_ADC_Read(uint8_t channel)
 {
     if (channel > 3) return 0;
 
+#if CMIX_ADC_DMA_ENABLE
+    /* 读取就绪半区, DMA只写另一半区, 无需等待 */
+    return g_adc_dma_buffer[g_adc_ready_half][g_adc_channel_slot[channel]];
+#elif CMIX_CONTROL_ISR_ENABLE
+    /* 扫描模式下直接返回最近一次扫描结果, 不能重新配置ADC */
+    return g_adc_scan_result[channel];
+#else
     /* 配置ADC通道 */
     ADC_InitTypeDef ADC_InitStruct;
     ADC_InitStruct.ADC_Mode = ADC_Mode_Single;
     ADC_InitStruct.ADC_RVSPS = ADC_RVSPS_VDDA;
-    ADC_InitStruct.ADC_Channel = channel;
+    ADC_InitStruct.ADC_Channel = CMIX_ADC_CHANNEL_SEL(channel);
     ADC_InitStruct.ADC_Prescaler = 1;
     ADC_InitStruct.ADC_ChannelSetupTime = 1;
     ADC_InitStruct.ADC_SampleTime = 33;  // Longer sample time for accuracy
@@ -492,6 +834,206 @@ uint16_t CMix_Hardware_ADC_Read(uint8_t channel)
 
     /* 返回转换结果 */
     return ADC_GetConversionValue(ADC0);
+#endif
+}
+
+/**
+ * @brief CMix获取ADC扫描快照 (全部通道来自同一次扫描)
+ * @param snapshot: 快照输出指针
+ * @retval None
+ * @note  控制中断内调用时就绪半区不会变化; 主循环调用时若复制期间发布了
+ *        新扫描则重新复制, 保证各通道数据一致
+ */
+void CMix_Hardware_ADC_Get_Snapshot(CMix_ADC_Snapshot_t *snapshot)
+{
+    uint8_t i;
+
+#if CMIX_CONTROL_ISR_ENABLE
+    uint32_t sequence;
+
+    do {
+        sequence = g_adc_sequence;
+        for (i = 0; i < CMIX_ADC_SCAN_COUNT; i++) {
+            snapshot->raw[i] = CMix_Hardware_ADC_Read(i);
+            snapshot->ext[i] = g_adc_decimator[i].output;
+        }
+    } while (sequence != g_adc_sequence);
+
+    snapshot->sequence = sequence;
+#else
+    /* 轮询模式无扫描中断, 扩展码值取单次采样 */
+    for (i = 0; i < CMIX_ADC_SCAN_COUNT; i++) {
+        snapshot->raw[i] = CMix_Hardware_ADC_Read(i);
+        snapshot->ext[i] = (uint16_t)(snapshot->raw[i] << CMIX_ADC_EXT_SHIFT);
+    }
+    snapshot->sequence = 0;
+#endif
+}
+
+/**
+ * @brief CMix获取ADC参考电压 (VDDA)
+ * @param None
+ * @retval VDDA (mV), 按内部1.0V基准码值反算; 未测得基准时返回标称值
+ * @note  含一次除法, 仅在主循环中调用
+ */
+uint16_t CMix_Hardware_ADC_Get_Reference_Voltage(void)
+{
+#if CMIX_ADC_SEQUENCER_ENABLE
+    uint16_t raw = g_adc_bandgap_raw;
+
+    if (raw != 0) {
+        return (uint16_t)(((uint32_t)CMIX_ADC_BANDGAP_MV * CMIX_ADC_RESOLUTION + raw / 2) / raw);
+    }
+#endif
+    return (uint16_t)(CMIX_ADC_VREF * 1000.0f);
+}
+
+/**
+ * @brief 设置电压通道模拟看门狗上限
+ * @param channel: ADC通道号
+ * @param max_mv: 电压上限 (mV), 超出ADC量程时该通道不触发
+ * @retval true = 该通道由模拟看门狗监视
+ * @note  下限为0; 新窗口在该通道下次被选中时写入寄存器
+ */
+bool CMix_Hardware_ADC_AWD_Set_Voltage_Limit(uint8_t channel, uint32_t max_mv)
+{
+#if CMIX_ADC_AWD_ENABLE
+    uint32_t high;
+
+    if (!CMix_Hardware_ADC_AWD_Is_Watched(channel)) {
+        return false;
+    }
+    if (max_mv > 1000000U) {
+        max_mv = 1000000U;                          // 远超量程, 防止乘法溢出
+    }
+    high = (max_mv * CMIX_ADC_AWD_VOLTAGE_CODE_Q16) >> 16;
+    if (high > CMIX_ADC_RESOLUTION) {
+        high = CMIX_ADC_RESOLUTION;
+    }
+    g_adc_awd_window[channel] = high << 16;
+    return true;
+#else
+    (void)channel;
+    (void)max_mv;
+    return false;
+#endif
+}
+
+/**
+ * @brief 设置电流通道模拟看门狗限值 (双向, 零点两侧对称)
+ * @param channel: ADC通道号
+ * @param max_ma: 电流限值 (mA), 超出ADC量程时该方向不触发
+ * @retval true = 该通道由模拟看门狗监视
+ * @note  上限向下取整、下限向上取整, 码值落在窗口外即电流超过限值
+ */
+bool CMix_Hardware_ADC_AWD_Set_Current_Limit(uint8_t channel, uint32_t max_ma)
+{
+#if CMIX_ADC_AWD_ENABLE
+    uint32_t delta, low, high;
+
+    if (!CMix_Hardware_ADC_AWD_Is_Watched(channel)) {
+        return false;
+    }
+    if (max_ma > 1000000U) {
+        max_ma = 1000000U;                          // 远超量程, 防止乘法溢出
+    }
+    delta = max_ma * CMIX_ADC_AWD_CURRENT_CODE_Q16;
+    high = (CMIX_ADC_AWD_CURRENT_ZERO_Q16 + delta) >> 16;
+    if (high > CMIX_ADC_RESOLUTION) {
+        high = CMIX_ADC_RESOLUTION;
+    }
+    low = (delta < CMIX_ADC_AWD_CURRENT_ZERO_Q16) ? (CMIX_ADC_AWD_CURRENT_ZERO_Q16 - delta + 0xFFFFU) >> 16 : 0;
+    g_adc_awd_window[channel] = (high << 16) | low;
+    return true;
+#else
+    (void)channel;
+    (void)max_ma;
+    return false;
+#endif
+}
+
+/**
+ * @brief 获取模拟看门狗越限统计
+ * @param stats: 统计输出指针
+ * @retval None
+ */
+void CMix_Hardware_ADC_AWD_Get_Stats(CMix_ADC_AWD_Stats_t *stats)
+{
+#if CMIX_ADC_AWD_ENABLE
+    NVIC_DisableIRQ(ADC0_IRQn);
+    *stats = g_adc_awd_stats;
+    NVIC_EnableIRQ(ADC0_IRQn);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/**
+ * @brief 设置比较器保护阈值 (两路共用LDAC0)
+ * @param max_mv: 动作电压 (mV, 与ADC电压通道同一换算)
+ * @retval 实际动作电压 (mV), 按LDAC分辨率向下取整
+ * @note  LDAC码值变化时比较器可能立即翻转, 运行中修改前应确认电压低于新阈值
+ */
+uint32_t CMix_Hardware_CMP_Set_Threshold(uint32_t max_mv)
+{
+    uint32_t code;
+
+    if (max_mv > CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO) {
+        max_mv = CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO;
+    }
+    code = max_mv * CMIX_CMP_LDAC_STEPS / (CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO);
+    if (code > CMIX_CMP_LDAC_STEPS - 1) {
+        code = CMIX_CMP_LDAC_STEPS - 1;
+    }
+    g_cmp_ldac_code = (uint8_t)code;
+    LDAC_SetData(LDAC0, code);
+    return CMix_Hardware_CMP_Get_Threshold();
+}
+
+/**
+ * @brief 获取比较器保护阈值
+ * @param None
+ * @retval 当前LDAC码值对应的动作电压 (mV)
+ */
+uint32_t CMix_Hardware_CMP_Get_Threshold(void)
+{
+    return (uint32_t)g_cmp_ldac_code * CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO / CMIX_CMP_LDAC_STEPS;
+}
+
+/**
+ * @brief 获取比较器越限统计
+ * @param stats: 统计输出指针
+ * @retval None
+ */
+void CMix_Hardware_CMP_Get_Stats(CMix_CMP_Stats_t *stats)
+{
+    NVIC_DisableIRQ(CMP0_IRQn);
+    NVIC_DisableIRQ(CMP1_IRQn);
+    *stats = g_cmp_stats;
+    NVIC_EnableIRQ(CMP1_IRQn);
+    NVIC_EnableIRQ(CMP0_IRQn);
+}
+
+/**
+ * @brief 释放TIM1刹车, 恢复PWM输出 (故障清除)
+ * @param None
+ * @retval true = 刹车已释放; false = 比较器仍越限, 输出保持关断
+ * @note  清除软件刹车BKSC (模拟看门狗置位) 和刹车标志BIF. 本器件TIM1没有MOE位,
+ *        刹车状态直接门控输出: 刹车源全部无效且BIF清零后输出恢复, 计数器被刹车
+ *        关闭时重新使能. 比较器输出仍为有效电平时不清BIF, 避免刹车立即再次触发
+ */
+bool CMix_Hardware_PWM_Release_Break(void)
+{
+    TIM_SoftwareBreakCMD(TIM1, DISABLE);
+
+    /* 比较器反相输出: CRS=0表示仍越限 */
+    if (CMP_GetFlagStatus(CMIX_CMP1_UNIT, CMP_FLAG_CRS) == RESET ||
+        CMP_GetFlagStatus(CMIX_CMP0_UNIT, CMP_FLAG_CRS) == RESET) {
+        return false;
+    }
+    TIM_ClearFlag(TIM1, TIM_FLAG_BIF);
+    TIM_Cmd(TIM1, ENABLE);
+    return true;
 }
 
 /**
@@ -509,16 +1051,160 @@ uint16_t CMix_Hardware_ADC_Get_Value(uint8_t channel)
  * @param channel: PWM通道 (1-4)
  * @param duty_cycle: 占空比 (0-10000, 对应0-100.00%)
  * @retval None
+ * @note  单路写入, 预装载时在下一更新事件生效; 多路需同周期生效时用CMix_Hardware_PWM_Stage/Commit
  */
 void CMix_Hardware_Set_PWM_Duty(uint8_t channel, uint16_t duty_cycle)
 {
-    uint16_t pulse = (duty_cycle * CMIX_PWM_PERIOD) / 10000;
+    uint16_t pulse = (duty_cycle * CMIX_PWM_COMPARE_SCALE) / 10000;
 
     if (channel >= 1 && channel <= 4) {
-        TIM_SetOCxValue(TIM1, channel, pulse);
+        /* 通道1-4对应TIM_Channel_1-4 (编号0-3) */
+        TIM_SetOCxValue(TIM1, channel - 1, CMix_Hardware_PWM_Compare(channel, pulse));
     }
 }
 
+/**
+ * @brief CMix暂存PWM占空比 (不写寄存器)
+ * @param channel: PWM通道 (1-4)
+ * @param duty_cycle: 占空比 (0-10000, 对应0-100.00%)
+ * @retval None
+ * @note  相A/相B按1/16计数换算, 余数累加到下次暂存 (一阶sigma-delta),
+ *        多个控制步平均后的分辨率为1/16计数
+ */
+void CMix_Hardware_PWM_Stage(uint8_t channel, uint16_t duty_cycle)
+{
+    uint16_t pulse;
+
+    if (channel < 1 || channel > CMIX_PWM_CHANNEL_COUNT) {
+        return;
+    }
+    if (channel <= 2) {
+        uint32_t fine = ((uint32_t)duty_cycle * (CMIX_PWM_COMPARE_SCALE << CMIX_PWM_DITHER_BITS)) / 10000 +
+                        g_pwm_dither[channel - 1];
+
+        g_pwm_dither[channel - 1] = (uint16_t)(fine & CMIX_PWM_DITHER_MASK);
+        pulse = (uint16_t)(fine >> CMIX_PWM_DITHER_BITS);
+        if (pulse > CMIX_PWM_COMPARE_SCALE) {
+            pulse = CMIX_PWM_COMPARE_SCALE;
+        }
+        g_pwm_staged[channel - 1] = CMix_Hardware_PWM_Compare(channel, pulse);
+        return;
+    }
+    pulse = (uint16_t)((duty_cycle * CMIX_PWM_COMPARE_SCALE) / 10000);
+    g_pwm_staged[channel - 1] = CMix_Hardware_PWM_Compare(channel, pulse);
+}
+
+/**
+ * @brief 导通计数换算为比较值
+ * @param channel: PWM通道 (1-4)
+ * @param pulse: 导通计数 (0 - CMIX_PWM_COMPARE_SCALE)
+ * @retval 比较值
+ * @note  两相交错时相B为PWM2模式 (计数大于比较值时有效), 比较值取补,
+ *        导通区间以峰点为中心, 与以谷点为中心的相A相差半个周期
+ */
+static uint16_t CMix_Hardware_PWM_Compare(uint8_t channel, uint16_t pulse)
+{
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    if (channel == 2) {
+        return (uint16_t)(CMIX_PWM_COMPARE_SCALE - pulse);
+    }
+#else
+    (void)channel;
+#endif
+    return pulse;
+}
+
+#if CMIX_PWM_PRELOAD_ENABLE
+/**
+ * @brief 距下一更新事件 (比较值装载) 的剩余计数
+ * @param None
+ * @retval 剩余计数, 更新事件后跳回最大值
+ * @note  中心对齐时DIR只读, 指示当前计数方向
+ */
+static uint16_t CMix_Hardware_PWM_Headroom(void)
+{
+    uint16_t count = (uint16_t)TIM1->CNTR;
+
+#if CMIX_PWM_CENTER_ALIGNED_ENABLE
+    if (TIM1->CR & TIM_CR_DIR) {
+        return count;                                   // 向下计数, 到谷点
+    }
+#if CMIX_PWM_DOUBLE_UPDATE_ENABLE
+    return (uint16_t)(CMIX_PWM_COMPARE_SCALE - count);  // 向上计数, 到峰点
+#else
+    return (uint16_t)(2 * CMIX_PWM_COMPARE_SCALE - count);  // 向上计数, 经峰点回到谷点
+#endif
+#else
+    return (uint16_t)(CMIX_PWM_PERIOD - count);
+#endif
+}
+#endif
+
+/**
+ * @brief CMix提交暂存的四路PWM比较值
+ * @param None
+ * @retval true = 在目标周期生效, false = 落入保护窗, 推迟一个周期生效
+ * @note  预装载时四路写入影子寄存器, 下一更新事件同时装载, 不会出现新旧混合的周期.
+ *        距更新事件不足CMIX_PWM_COMMIT_GUARD计数时写入可能跨越更新事件,
+ *        先等待更新事件过去再写 (最长等待保护窗长度)
+ */
+bool CMix_Hardware_PWM_Commit(void)
+{
+    bool on_time = true;
+    uint8_t i;
+#if CMIX_PWM_PRELOAD_ENABLE
+    uint32_t primask = __get_PRIMASK();
+    uint16_t headroom, last, now;
+
+    __disable_irq();
+    headroom = CMix_Hardware_PWM_Headroom();
+    if ((TIM1->CR & TIM_CR_EN) && headroom < CMIX_PWM_COMMIT_GUARD) {
+        /* 剩余计数跳回最大值即更新事件已过 */
+        now = headroom;
+        do {
+            last = now;
+            now = CMix_Hardware_PWM_Headroom();
+        } while (now <= last);
+        on_time = false;
+        g_pwm_commit_stats.missed++;
+    }
+
+    /* 直接写OCR: 上/下计数比较值相同 (同TIM_SetOCxValue) */
+    for (i = 0; i < CMIX_PWM_CHANNEL_COUNT; i++) {
+        TIM1->OCR[i] = g_pwm_staged[i] | ((uint32_t)g_pwm_staged[i] << 16);
+    }
+
+    g_pwm_commit_stats.commits++;
+    if (headroom < g_pwm_commit_stats.min_headroom) {
+        g_pwm_commit_stats.min_headroom = headroom;
+    }
+    __set_PRIMASK(primask);
+#else
+    for (i = 0; i < CMIX_PWM_CHANNEL_COUNT; i++) {
+        TIM_SetOCxValue(TIM1, i, g_pwm_staged[i]);
+    }
+    g_pwm_commit_stats.commits++;
+#endif
+
+    return on_time;
+}
+
+/**
+ * @brief CMix获取PWM提交统计
+ * @param stats: 统计输出指针
+ * @retval None
+ * @note  提交在控制环所在的中断 (ADC0或DMA, 随配置) 或主循环中执行,
+ *        复制期间短暂关全局中断, 不依赖具体中断号
+ */
+void CMix_Hardware_PWM_Get_Commit_Stats(CMix_PWM_Commit_Stats_t *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *stats = g_pwm_commit_stats;
+    __set_PRIMASK(primask);
+}
+
 /**
  * @brief CMix GPIO写引脚
  * @param port: GPIO端口
@@ -590,9 +1276,11 @@ void CMix_Hardware_System_Reset(void)
 CMix_Voltage_Sensors_t CMix_Hardware_Get_Voltage_Sensors(void)
 {
     CMix_Voltage_Sensors_t sensors;
+    CMix_ADC_Snapshot_t snapshot;
     
-    sensors.input_voltage = CMix_Hardware_ADC_Read(0);
-    sensors.output_voltage = CMix_Hardware_ADC_Read(2);
+    CMix_Hardware_ADC_Get_Snapshot(&snapshot);
+    sensors.input_voltage = snapshot.ext[CMIX_ADC_VIN_CHANNEL];
+    sensors.output_voltage = snapshot.ext[CMIX_ADC_VOUT_CHANNEL];
     
     return sensors;
 }
@@ -606,13 +1294,16 @@ CMix_Current_Sensors_t CMix_Hardware_Get_Current_Sensors(void)
 {
     CMix_Current_Sensors_t sensors;
     
-    /* 获取ADC原始值 */
-    uint16_t adc_current_a = CMix_Hardware_ADC_Read(CMIX_ADC_CURRENT_A_CHANNEL);
-    uint16_t adc_current_b = CMix_Hardware_ADC_Read(CMIX_ADC_CURRENT_B_CHANNEL);
+    CMix_ADC_Snapshot_t snapshot;
+    
+    /* 获取过采样扩展码值 (同一次扫描) */
+    CMix_Hardware_ADC_Get_Snapshot(&snapshot);
+    uint16_t adc_current_a = snapshot.ext[CMIX_ADC_CURRENT_A_CHANNEL];
+    uint16_t adc_current_b = snapshot.ext[CMIX_ADC_CURRENT_B_CHANNEL];
     
-    /* 使用TP181A1换算公式转换为实际电流 */
-    sensors.input_current = CMix_Hardware_Convert_Current(adc_current_a);   // 相A电流
-    sensors.output_current = CMix_Hardware_Convert_Current(adc_current_b);  // 相B电流
+    /* TP181A1换算为实际电流 (编译期常数, 无浮点和除法) */
+    sensors.input_current = CMix_Hardware_Convert_Current_Ext_mA(adc_current_a);   // 相A电流
+    sensors.output_current = CMix_Hardware_Convert_Current_Ext_mA(adc_current_b);  // 相B电流
     
     return sensors;
 }
@@ -624,20 +1315,8 @@ CMix_Current_Sensors_t CMix_Hardware_Get_Current_Sensors(void)
  */
 float CMix_Hardware_Convert_Current(uint16_t adc_raw)
 {
-    /* ADC转电压：ADC_RAW * VDDA / 4095 */
-    float vadc = (float)adc_raw * 5.0f / 4095.0f;
-    
-    /* 减去基准电压（VDDA/2） */
-    float vdiff = vadc - CMIX_CURRENT_VREF;
-    
-    /* 电流计算：I = (Vadc - Vref) / (Rs * Gain) */
-    float current = vdiff / (CMIX_CURRENT_SENSE_RS * CMIX_CURRENT_SENSE_GAIN);
-    
-    /* 溢出保护 */
-    if (current > 100.0f) current = 100.0f;      // 最大100A保护
-    if (current < -100.0f) current = -100.0f;    // 最小-100A保护
-    
-    return current;
+    /* I = (Vadc - Vref) / (Rs * Gain), 换算常数见CMix_config.h, 已限幅±100A */
+    return (float)CMix_Hardware_Convert_Current_mA(adc_raw) * 0.001f;
 }
 
 /**
@@ -767,7 +1446,249 @@ void UART0_Handler(void)
         CMix_Protocol_Receive_Handler(received_byte);
         UART_ClearFlag(UART0, UART_FLAG_RXNE);
     }
+
+#if CMIX_UART_TX_ASYNC_ENABLE
+    /* 发送寄存器空: 取出下一字节, 队列空时关闭TXE中断 */
+    if (UART_GetITStatus(UART0, UART_IT_TXE) != RESET) {
+        if (g_uart_tx_tail != g_uart_tx_head) {
+            UART_SendData(UART0, g_uart_tx_buffer[g_uart_tx_tail & CMIX_UART_TX_MASK]);
+            g_uart_tx_tail++;
+        } else {
+            UART_ITConfig(UART0, UART_IT_TXE, DISABLE);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief ADC中断处理函数 - 规则组扫描结束
+ * @param None
+ * @retval None
+ * @note  扫描由TIM1 TRGO触发, 每CMIX_CONTROL_DECIMATION次扫描执行一次控制环
+ */
+void ADC0_Handler(void)
+{
+#if CMIX_ADC_AWD_ENABLE
+    /* 模拟看门狗越限先于扫描结果处理: 越限转换结束即进入, 立即刹车 */
+    if (ADC_GetFlagStatus(ADC0, ADC_FLAG_AWD) != RESET) {
+        CMix_Hardware_ADC_AWD_Trip(ADC_GetAnalogWatchdogChannel(ADC0));
+        ADC_ClearFlag(ADC0, ADC_FLAG_AWD);
+    }
+#endif
+
+#if CMIX_ADC_SEQUENCER_ENABLE
+    static uint8_t decimation_counter = 0;
+    uint8_t i;
+
+    /* 慢速通道: 规则组此时空闲, 取结果后切换到下一个通道 */
+    if (ADC_GetFlagStatus(ADC0, ADC_FLAG_EOC) != RESET) {
+        ADC0->SR = ADC_FLAG_EOC;
+        CMix_Hardware_ADC_Slow_Complete(ADC_GetConversionValue(ADC0));
+    }
+
+    if (ADC_GetFlagStatus(ADC0, ADC_FLAG_JEOS) != RESET) {
+        /* 快速通道: 锁存注入组结果并送入抽取器 */
+        for (i = 0; i < CMIX_ADC_FAST_COUNT; i++) {
+            uint8_t channel = g_adc_fast_channels[i];
+
+            g_adc_scan_result[channel] = ADC_GetInjectScanConversionValue(ADC0, i);
+            if (g_adc_sequence == 0) {
+                CMix_Hardware_ADC_Decimator_Seed(&g_adc_decimator[channel], g_adc_scan_result[channel]);
+            }
+            CMix_Hardware_ADC_Decimate(&g_adc_decimator[channel], g_adc_scan_result[channel],
+                                       g_adc_osr_log2[channel]);
+        }
+
+        ADC0->SR = ADC_FLAG_JEOS | ADC_FLAG_JEOC;
+        g_adc_sequence++;
+#if CMIX_ADC_AWD_ENABLE
+        CMix_Hardware_ADC_AWD_Next();
+#endif
+
+        /* 分频后执行控制环 */
+        if (++decimation_counter >= CMIX_CONTROL_DECIMATION) {
+            decimation_counter = 0;
+            CMix_Hardware_ADC_Conversion_Complete_Callback();
+        }
+    }
+#elif CMIX_CONTROL_ISR_ENABLE && !CMIX_ADC_DMA_ENABLE
+    static uint8_t decimation_counter = 0;
+    uint8_t i;
+
+    if (ADC_GetFlagStatus(ADC0, ADC_FLAG_EOS) != RESET) {
+        /* 锁存扫描结果并送入抽取器 */
+        for (i = 0; i < CMIX_ADC_SCAN_COUNT; i++) {
+            uint8_t channel = g_adc_scan_channels[i];
+
+            g_adc_scan_result[channel] = ADC_GetRegularScanConversionValue(ADC0, i);
+            if (g_adc_sequence == 0) {
+                CMix_Hardware_ADC_Decimator_Seed(&g_adc_decimator[channel], g_adc_scan_result[channel]);
+            }
+            CMix_Hardware_ADC_Decimate(&g_adc_decimator[channel], g_adc_scan_result[channel],
+                                       g_adc_osr_log2[channel]);
+        }
+
+        /* 清除标志 (写1清零, 库函数ADC_ClearFlag仅接受AWD) */
+        ADC0->SR = ADC_FLAG_EOS | ADC_FLAG_EOC;
+        g_adc_sequence++;
+#if CMIX_ADC_AWD_ENABLE
+        CMix_Hardware_ADC_AWD_Next();
+#endif
+
+        /* 分频后执行控制环 */
+        if (++decimation_counter >= CMIX_CONTROL_DECIMATION) {
+            decimation_counter = 0;
+            CMix_Hardware_ADC_Conversion_Complete_Callback();
+        }
+    }
+#endif
+}
+
+#if CMIX_ADC_SEQUENCER_ENABLE
+/**
+ * @brief 慢速通道转换结束: 保存结果, 规则组切换到下一个慢速通道
+ * @param sample: 转换结果
+ * @retval None
+ * @note  在规则组转换结束中断中调用, 下一次TIM1 TRGO之前规则组不会启动
+ */
+static void CMix_Hardware_ADC_Slow_Complete(uint16_t sample)
+{
+    uint8_t channel = g_adc_slow_channels[g_adc_slow_slot];
+
+    if (channel == CMIX_ADC_BANDGAP_CHANNEL) {
+        g_adc_bandgap_raw = sample;
+    } else {
+        g_adc_scan_result[channel] = sample;
+        if (!g_adc_slow_seeded) {
+            CMix_Hardware_ADC_Decimator_Seed(&g_adc_decimator[channel], sample);
+        }
+        CMix_Hardware_ADC_Decimate(&g_adc_decimator[channel], sample, g_adc_osr_log2[channel]);
+    }
+
+    if (++g_adc_slow_slot >= CMIX_ADC_SLOW_COUNT) {
+        g_adc_slow_slot = 0;
+        g_adc_slow_seeded = true;
+    }
+    ADC_ChannelConfig(ADC0, CMIX_ADC_CHANNEL_SEL(g_adc_slow_channels[g_adc_slow_slot]));
+}
+#endif
+
+#if CMIX_ADC_AWD_ENABLE
+/**
+ * @brief 通道是否在模拟看门狗轮转表中
+ * @param channel: ADC通道号
+ * @retval true = 监视
+ */
+static bool CMix_Hardware_ADC_AWD_Is_Watched(uint8_t channel)
+{
+    uint8_t i;
+
+    for (i = 0; i < CMIX_ADC_AWD_COUNT; i++) {
+        if (g_adc_awd_channels[i] == channel) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 模拟看门狗越限: 软件刹车关断PWM, 记录通道统计
+ * @param channel: 越限通道号 (ADC_SR.AWDCH)
+ * @retval None
+ * @note  刹车由TIM1硬件关断输出, 不经过控制环; 时刻和扫描序号只记录首次越限
+ */
+static void CMix_Hardware_ADC_AWD_Trip(uint8_t channel)
+{
+    TIM_SoftwareBreakCMD(TIM1, ENABLE);
+
+    if (channel < CMIX_ADC_SCAN_COUNT) {
+        if (g_adc_awd_stats.trips[channel]++ == 0) {
+            g_adc_awd_stats.tick_ms[channel] = CMix_Main_Get_System_Tick();
+            g_adc_awd_stats.sequence[channel] = g_adc_sequence;
+        }
+    }
+    CMix_Hardware_ADC_AWD_Trip_Callback(channel);
+}
+
+/**
+ * @brief 模拟看门狗切换到下一个监视通道
+ * @param None
+ * @retval None
+ * @note  扫描结果处理后调用, 下一次TIM1 TRGO之前快速通道不会转换.
+ *        每次扫描执行, 直接写寄存器 (库函数每项一次读改写)
+ */
+static void CMix_Hardware_ADC_AWD_Next(void)
+{
+    uint8_t channel;
+
+    if (++g_adc_awd_slot >= CMIX_ADC_AWD_COUNT) {
+        g_adc_awd_slot = 0;
+    }
+    channel = g_adc_awd_channels[g_adc_awd_slot];
+
+    ADC0->AWDTR = g_adc_awd_window[channel];
+    ADC0->AWDCR = ADC_AWDCR_AWDE | ADC_Channel_Single | CMIX_ADC_CHANNEL_SEL(channel);
+}
+#endif
+
+/**
+ * @brief 比较器越限: 记录统计并通知应用层
+ * @param unit: 比较器单元号 (0=CMP0, 1=CMP1)
+ * @retval None
+ * @note  PWM已由比较器刹车输入硬件关断; 时刻只记录首次越限
+ */
+static void CMix_Hardware_CMP_Trip(uint8_t unit)
+{
+    if (g_cmp_stats.trips[unit]++ == 0) {
+        g_cmp_stats.tick_ms[unit] = CMix_Main_Get_System_Tick();
+    }
+    CMix_Hardware_CMP_Trip_Callback(unit);
+}
+
+#if CMIX_ADC_DMA_ENABLE
+/**
+ * @brief DMA中断处理函数 - ADC扫描半区就绪
+ * @param None
+ * @retval None
+ * @note  半传输: 半区0就绪; 传输完成: 半区1就绪. 两者同时置位说明中断响应
+ *        超过一次扫描, 以较新的半区1为准
+ */
+void DMA_Handler(void)
+{
+    static uint8_t decimation_counter = 0;
+    uint32_t status = DMA0->SR & (DMA_FLAG_C0THF | DMA_FLAG_TC0F);
+    uint8_t half;
+    uint8_t i;
+
+    if (status != 0) {
+        DMA_ClearITFlag(DMA0, status);
+
+        /* 就绪半区送入抽取器 (各通道抽取比见CMix_config.h), 首次扫描预置输出 */
+        half = (status & DMA_FLAG_TC0F) ? 1 : 0;
+        for (i = 0; i < CMIX_ADC_SCAN_COUNT; i++) {
+            uint8_t channel = g_adc_scan_channels[i];
+
+            if (g_adc_sequence == 0) {
+                CMix_Hardware_ADC_Decimator_Seed(&g_adc_decimator[channel], g_adc_dma_buffer[half][i]);
+            }
+            CMix_Hardware_ADC_Decimate(&g_adc_decimator[channel], g_adc_dma_buffer[half][i],
+                                       g_adc_osr_log2[channel]);
+        }
+
+        g_adc_ready_half = half;
+        g_adc_sequence++;
+#if CMIX_ADC_AWD_ENABLE
+        CMix_Hardware_ADC_AWD_Next();
+#endif
+
+        /* 分频后执行控制环 */
+        if (++decimation_counter >= CMIX_CONTROL_DECIMATION) {
+            decimation_counter = 0;
+            CMix_Hardware_ADC_Conversion_Complete_Callback();
+        }
+    }
 }
+#endif
 
 /**
  * @brief 硬故障中断处理函数
@@ -831,7 +1752,8 @@ uint8_t CMix_Hardware_Self_Test(void)
 {
     uint8_t result = 0;
     
-    /* ADC自检 */
+    /* ADC自检 (TIM1刚启动, 先等待首次扫描结果写入缓冲) */
+    CMix_Hardware_Delay_ms(1);
     uint16_t adc_test = CMix_Hardware_ADC_Read(0);
     if (adc_test == 0 || adc_test == 0xFFF) {
         result |= 0x01;  /* ADC故障 */
@@ -889,16 +1811,16 @@ void CMix_Hardware_Debug_PrintSystemInfo(void)
     CMix_Protocol_Send_System_Info(g_system_clock_freq, g_clock_config_ok, __DATE__, __TIME__);
     
     /* 发送各个调试信息 */
-    CMix_Protocol_Send_Debug_Message("=== CMix硬件初始化完成 ===");
+    CMIX_TRACE0(CMIX_TRACE_HW_BANNER);
     
     #ifdef PTM280x
-    CMix_Protocol_Send_Debug_Message("目标芯片: PTM280x LQFP32 (GPIOA/B可用)");
+    CMIX_TRACE1(CMIX_TRACE_HW_CHIP, CMIX_TRACE_STR_CHIP_PTM280X);
     #else
-    CMix_Protocol_Send_Debug_Message("目标芯片: 未知类型");
+    CMIX_TRACE1(CMIX_TRACE_HW_CHIP, CMIX_TRACE_STR_CHIP_UNKNOWN);
     #endif
     
-    CMix_Protocol_Send_Debug_Message("硬件版本: CMix V1.0");
-    CMix_Protocol_Send_Debug_Message("初始化状态: UART/ADC/TIM/GPIO/OPA/CMP 已配置");
-    CMix_Protocol_Send_Debug_Message("========================");
+    CMIX_TRACE0(CMIX_TRACE_HW_VERSION);
+    CMIX_TRACE0(CMIX_TRACE_HW_CONFIGURED);
+    CMIX_TRACE0(CMIX_TRACE_HW_END);
 }
 #endif
\ No newline at end of file
@@ -35,6 +35,9 @@ void CMix_Hardware_GPIO_Init(void);
 /* UART硬件初始化 */
 void CMix_Hardware_UART_Init(void);
 void CMix_Hardware_UART_Send_Byte(uint8_t byte);
+void CMix_Hardware_UART_Send_String(const char *str);
+bool CMix_Hardware_UART_Write(const uint8_t *data, uint16_t len);
+uint16_t CMix_Hardware_UART_TX_Free(void);
 bool CMix_Hardware_UART_Is_TX_Ready(void);
 
 /* TIM硬件初始化 */
@@ -42,6 +45,21 @@ void CMix_Hardware_TIM_Init(void);
 void CMix_Hardware_Set_PWM_Duty(uint8_t channel, uint16_t duty_cycle);
 void CMix_Hardware_TIM_Enable_PWM(bool enable);
 
+/* PWM占空比两阶段提交: 先暂存四路, 再一次写入 (预装载时下一更新事件同时生效) */
+#define CMIX_PWM_CHANNEL_COUNT      4       // TIM1比较通道数
+void CMix_Hardware_PWM_Stage(uint8_t channel, uint16_t duty_cycle);
+bool CMix_Hardware_PWM_Commit(void);
+
+/* ADC扫描序列 (TIM1 TRGO触发, 结果按通道号保存) */
+#define CMIX_ADC_SCAN_COUNT         4       // 扫描通道数: Vin, Ia, Vout, Ib
+#define CMIX_ADC_DMA_HALF_COUNT     2       // DMA乒乓缓冲半区数
+#define CMIX_ADC_FAST_COUNT         3       // 多速率: 快速通道数 (注入组): Ia, Vout, Ib
+#define CMIX_ADC_SLOW_COUNT         2       // 多速率: 慢速通道数 (规则组轮转): Vin, 内部基准
+#define CMIX_ADC_AWD_COUNT          3       // 模拟看门狗轮流监视的通道数: Ia, Vout, Ib
+
+/* 比较器保护 (CMP0: Vout, CMP1: Vin, 输出直连TIM1刹车) */
+#define CMIX_CMP_COUNT              2       // 比较器数, 统计按单元号索引
+
 /* ADC硬件初始化 */
 void CMix_Hardware_ADC_Init(void);
 uint16_t CMix_Hardware_ADC_Read(uint8_t channel);
@@ -83,19 +101,64 @@ void CMix_Hardware_Enter_Stop_Mode(void);
 
 /* 电压传感器数据结构 */
 typedef struct {
-    uint16_t input_voltage;             // 输入电压ADC值
-    uint16_t output_voltage;            // 输出电压ADC值
+    uint16_t input_voltage;             // 输入电压扩展码值 (过采样, 1/16 LSB)
+    uint16_t output_voltage;            // 输出电压扩展码值 (过采样, 1/16 LSB)
 } CMix_Voltage_Sensors_t;
 
 /* 电流传感器数据结构 */
 typedef struct {
-    float input_current;                // 相A电流值 (A)
-    float output_current;               // 相B电流值 (A)
+    int32_t input_current;              // 相A电流值 (mA), 负值表示反向电流
+    int32_t output_current;             // 相B电流值 (mA)
 } CMix_Current_Sensors_t;
 
+/* UART发送队列统计 */
+typedef struct {
+    uint32_t bytes_queued;              // 已入队字节数
+    uint32_t frames_queued;             // 已入队帧数 (每次写入计一帧)
+    uint32_t bytes_dropped;             // 因缓冲满丢弃的字节数
+    uint32_t frames_dropped;            // 因缓冲满丢弃的帧数 (溢出次数)
+    uint16_t high_water;                // 缓冲最大占用字节数
+} CMix_UART_TX_Stats_t;
+
+/* ADC扫描快照 (同一次扫描的全部通道) */
+typedef struct {
+    uint16_t raw[CMIX_ADC_SCAN_COUNT];  // ADC原始值 (按通道号索引)
+    uint16_t ext[CMIX_ADC_SCAN_COUNT];  // 最近一次抽取输出的扩展码值 (按通道号索引)
+    uint32_t sequence;                  // 扫描序号 (每完成一次扫描加1)
+} CMix_ADC_Snapshot_t;
+
+/* ADC过采样抽取器 (每通道一个) */
+typedef struct {
+    uint32_t sum;                       // 本轮累加和
+    uint16_t count;                     // 本轮已累加采样数
+    uint16_t output;                    // 最近一次输出 (扩展码值)
+} CMix_ADC_Decimator_t;
+
+/* ADC模拟看门狗越限统计 (按通道号索引) */
+typedef struct {
+    uint32_t trips[CMIX_ADC_SCAN_COUNT];        // 越限转换次数 (持续越限时每次被监视都计数)
+    uint32_t tick_ms[CMIX_ADC_SCAN_COUNT];      // 首次越限时的系统节拍 (ms)
+    uint32_t sequence[CMIX_ADC_SCAN_COUNT];     // 首次越限所在的扫描序号 (PWM周期分辨率)
+} CMix_ADC_AWD_Stats_t;
+
+/* PWM提交统计 */
+typedef struct {
+    uint32_t commits;                           // 提交次数
+    uint32_t missed;                            // 落入保护窗、推迟一个周期生效的提交次数
+    uint16_t min_headroom;                      // 提交时距更新事件的最小剩余计数
+} CMix_PWM_Commit_Stats_t;
+
+/* 比较器越限统计 (按单元号索引: 0=CMP0, 1=CMP1) */
+typedef struct {
+    uint32_t trips[CMIX_CMP_COUNT];             // 越限次数 (输出下降沿)
+    uint32_t recoveries[CMIX_CMP_COUNT];        // 恢复次数 (输出上升沿)
+    uint32_t tick_ms[CMIX_CMP_COUNT];           // 首次越限时的系统节拍 (ms)
+} CMix_CMP_Stats_t;
+
 /* ========================= 硬件状态查询 ========================= */
 
 /* 传感器读取 */
+void CMix_Hardware_ADC_Get_Snapshot(CMix_ADC_Snapshot_t *snapshot);
 CMix_Voltage_Sensors_t CMix_Hardware_Get_Voltage_Sensors(void);
 CMix_Current_Sensors_t CMix_Hardware_Get_Current_Sensors(void);
 
@@ -106,6 +169,9 @@ float CMix_Hardware_Get_Current_A(void);
 float CMix_Hardware_Get_Current_B(void);
 uint8_t CMix_Hardware_Check_Overcurrent(float current_a, float current_b, float trip_threshold);
 
+/* UART发送队列状态 */
+void CMix_Hardware_UART_Get_TX_Stats(CMix_UART_TX_Stats_t *stats);
+
 /* 系统状态 */
 bool CMix_Hardware_Is_System_Ready(void);
 uint32_t CMix_Hardware_Get_System_Clock(void);
@@ -119,10 +185,177 @@ uint8_t CMix_Hardware_Self_Test(void);
 bool CMix_Hardware_ADC_Is_Ready(void);
 uint16_t CMix_Hardware_ADC_Get_Reference_Voltage(void);
 
+/* ADC模拟看门狗 */
+bool CMix_Hardware_ADC_AWD_Set_Voltage_Limit(uint8_t channel, uint32_t max_mv);
+bool CMix_Hardware_ADC_AWD_Set_Current_Limit(uint8_t channel, uint32_t max_ma);
+void CMix_Hardware_ADC_AWD_Get_Stats(CMix_ADC_AWD_Stats_t *stats);
+
+/* 比较器保护 */
+uint32_t CMix_Hardware_CMP_Set_Threshold(uint32_t max_mv);
+uint32_t CMix_Hardware_CMP_Get_Threshold(void);
+void CMix_Hardware_CMP_Get_Stats(CMix_CMP_Stats_t *stats);
+bool CMix_Hardware_PWM_Release_Break(void);
+
 /* PWM状态 */
+void CMix_Hardware_PWM_Get_Commit_Stats(CMix_PWM_Commit_Stats_t *stats);
 bool CMix_Hardware_PWM_Is_Enabled(void);
 uint16_t CMix_Hardware_PWM_Get_Frequency(void);
 
+/* ========================= ADC码值换算 ========================= */
+
+/* 查表生成: f(0) ~ f(4095), 由编译器在编译期计算 */
+#define CMIX_ADC_TABLE_4(f, n)      f(n), f((n) + 1), f((n) + 2), f((n) + 3)
+#define CMIX_ADC_TABLE_16(f, n)     CMIX_ADC_TABLE_4(f, n), CMIX_ADC_TABLE_4(f, (n) + 4), \
+                                    CMIX_ADC_TABLE_4(f, (n) + 8), CMIX_ADC_TABLE_4(f, (n) + 12)
+#define CMIX_ADC_TABLE_256(f, n)    CMIX_ADC_TABLE_16(f, n), CMIX_ADC_TABLE_16(f, (n) + 16), \
+                                    CMIX_ADC_TABLE_16(f, (n) + 32), CMIX_ADC_TABLE_16(f, (n) + 48), \
+                                    CMIX_ADC_TABLE_16(f, (n) + 64), CMIX_ADC_TABLE_16(f, (n) + 80), \
+                                    CMIX_ADC_TABLE_16(f, (n) + 96), CMIX_ADC_TABLE_16(f, (n) + 112), \
+                                    CMIX_ADC_TABLE_16(f, (n) + 128), CMIX_ADC_TABLE_16(f, (n) + 144), \
+                                    CMIX_ADC_TABLE_16(f, (n) + 160), CMIX_ADC_TABLE_16(f, (n) + 176), \
+                                    CMIX_ADC_TABLE_16(f, (n) + 192), CMIX_ADC_TABLE_16(f, (n) + 208), \
+                                    CMIX_ADC_TABLE_16(f, (n) + 224), CMIX_ADC_TABLE_16(f, (n) + 240)
+#define CMIX_ADC_TABLE_4096(f)      CMIX_ADC_TABLE_256(f, 0), CMIX_ADC_TABLE_256(f, 256), \
+                                    CMIX_ADC_TABLE_256(f, 512), CMIX_ADC_TABLE_256(f, 768), \
+                                    CMIX_ADC_TABLE_256(f, 1024), CMIX_ADC_TABLE_256(f, 1280), \
+                                    CMIX_ADC_TABLE_256(f, 1536), CMIX_ADC_TABLE_256(f, 1792), \
+                                    CMIX_ADC_TABLE_256(f, 2048), CMIX_ADC_TABLE_256(f, 2304), \
+                                    CMIX_ADC_TABLE_256(f, 2560), CMIX_ADC_TABLE_256(f, 2816), \
+                                    CMIX_ADC_TABLE_256(f, 3072), CMIX_ADC_TABLE_256(f, 3328), \
+                                    CMIX_ADC_TABLE_256(f, 3584), CMIX_ADC_TABLE_256(f, 3840)
+
+/* 电流表项: 曲线值按表项单位四舍五入并限幅 */
+#define CMIX_ADC_CURRENT_TABLE_ENTRY(code) \
+    ((int16_t)((CMIX_ADC_CURRENT_CURVE_MA(code) >= CMIX_ADC_CURRENT_LIMIT_MA) ? \
+                   CMIX_ADC_CURRENT_LIMIT_MA / CMIX_ADC_CURRENT_TABLE_LSB_MA : \
+               (CMIX_ADC_CURRENT_CURVE_MA(code) <= -CMIX_ADC_CURRENT_LIMIT_MA) ? \
+                   -CMIX_ADC_CURRENT_LIMIT_MA / CMIX_ADC_CURRENT_TABLE_LSB_MA : \
+               CMIX_ADC_CURRENT_CURVE_MA(code) / CMIX_ADC_CURRENT_TABLE_LSB_MA + \
+                   ((CMIX_ADC_CURRENT_CURVE_MA(code) >= 0) ? 0.5 : -0.5)))
+
+#if CMIX_ADC_CURRENT_TABLE_ENABLE
+extern const int16_t g_cmix_adc_current_table[4096];
+#endif
+
+/**
+ * @brief 电压码值换算 (一次乘法和移位, 无除法)
+ * @param adc_raw: ADC原始值 (0-4095)
+ * @retval 电压 (mV)
+ */
+static __inline uint32_t CMix_Hardware_Convert_Voltage_mV(uint16_t adc_raw)
+{
+    return ((uint32_t)adc_raw * CMIX_ADC_VOLTAGE_SCALE + (1U << (CMIX_ADC_SCALE_SHIFT - 1))) >> CMIX_ADC_SCALE_SHIFT;
+}
+
+/**
+ * @brief TP181A1电流码值换算 (一次乘法和移位或查表, 无除法)
+ * @param adc_raw: ADC原始值 (0-4095)
+ * @retval 电流 (mA), 负值表示反向电流, 限幅 ±CMIX_ADC_CURRENT_LIMIT_MA
+ */
+static __inline int32_t CMix_Hardware_Convert_Current_mA(uint16_t adc_raw)
+{
+#if CMIX_ADC_CURRENT_TABLE_ENABLE
+    return (int32_t)g_cmix_adc_current_table[adc_raw & 0x0FFF] * CMIX_ADC_CURRENT_TABLE_LSB_MA;
+#else
+    int32_t current = ((int32_t)adc_raw * CMIX_ADC_CURRENT_SCALE - CMIX_ADC_CURRENT_OFFSET +
+                       (1 << (CMIX_ADC_SCALE_SHIFT - 1))) >> CMIX_ADC_SCALE_SHIFT;
+
+    if (current > CMIX_ADC_CURRENT_LIMIT_MA) {
+        current = CMIX_ADC_CURRENT_LIMIT_MA;
+    } else if (current < -CMIX_ADC_CURRENT_LIMIT_MA) {
+        current = -CMIX_ADC_CURRENT_LIMIT_MA;
+    }
+    return current;
+#endif
+}
+
+/**
+ * @brief 扩展码值电压换算
+ * @param adc_ext: 扩展码值 (0-65520, 1/16 LSB)
+ * @retval 电压 (mV)
+ */
+static __inline uint32_t CMix_Hardware_Convert_Voltage_Ext_mV(uint16_t adc_ext)
+{
+    return ((uint32_t)adc_ext * CMIX_ADC_VOLTAGE_SCALE_EXT + (1U << (CMIX_ADC_VOLTAGE_EXT_SHIFT - 1))) >>
+           CMIX_ADC_VOLTAGE_EXT_SHIFT;
+}
+
+/**
+ * @brief 扩展码值TP181A1电流换算
+ * @param adc_ext: 扩展码值 (0-65520, 1/16 LSB)
+ * @retval 电流 (mA), 负值表示反向电流, 限幅 ±CMIX_ADC_CURRENT_LIMIT_MA
+ * @note  查表模式在相邻表项间按小数位线性插值
+ */
+static __inline int32_t CMix_Hardware_Convert_Current_Ext_mA(uint16_t adc_ext)
+{
+#if CMIX_ADC_CURRENT_TABLE_ENABLE
+    uint16_t index = (adc_ext >> CMIX_ADC_EXT_SHIFT) & 0x0FFF;
+    int32_t frac = adc_ext & ((1U << CMIX_ADC_EXT_SHIFT) - 1);
+    int32_t lower = g_cmix_adc_current_table[index];
+    int32_t upper = (index < 0x0FFF) ? g_cmix_adc_current_table[index + 1] : lower;
+
+    return (lower + (((upper - lower) * frac) >> CMIX_ADC_EXT_SHIFT)) * CMIX_ADC_CURRENT_TABLE_LSB_MA;
+#else
+    int32_t current = (int32_t)((uint32_t)adc_ext * CMIX_ADC_CURRENT_SCALE_EXT - CMIX_ADC_CURRENT_OFFSET_EXT +
+                                (1U << (CMIX_ADC_CURRENT_EXT_SHIFT - 1))) >> CMIX_ADC_CURRENT_EXT_SHIFT;
+
+    if (current > CMIX_ADC_CURRENT_LIMIT_MA) {
+        current = CMIX_ADC_CURRENT_LIMIT_MA;
+    } else if (current < -CMIX_ADC_CURRENT_LIMIT_MA) {
+        current = -CMIX_ADC_CURRENT_LIMIT_MA;
+    }
+    return current;
+#endif
+}
+
+/**
+ * @brief 过采样抽取: 累加一个采样, 满2^osr_log2个时输出扩展码值
+ * @param dec: 抽取器
+ * @param sample: ADC原始值 (0-4095)
+ * @param osr_log2: 抽取比 (log2, 0-8)
+ * @retval true = 本次产生新输出
+ * @note  每个采样固定一次加法和一次比较, 输出时再一次移位
+ */
+static __inline bool CMix_Hardware_ADC_Decimate(CMix_ADC_Decimator_t *dec, uint16_t sample, uint8_t osr_log2)
+{
+    dec->sum += sample;
+    if (++dec->count < (1U << osr_log2)) {
+        return false;
+    }
+
+    if (osr_log2 <= CMIX_ADC_EXT_SHIFT) {
+        dec->output = (uint16_t)(dec->sum << (CMIX_ADC_EXT_SHIFT - osr_log2));
+    } else {
+        dec->output = (uint16_t)(dec->sum >> (osr_log2 - CMIX_ADC_EXT_SHIFT));
+    }
+    dec->sum = 0;
+    dec->count = 0;
+    return true;
+}
+
+/**
+ * @brief 抽取器预置: 首次抽取输出之前以单次采样作为输出
+ * @param dec: 抽取器
+ * @param sample: ADC原始值 (0-4095)
+ * @retval None
+ */
+static __inline void CMix_Hardware_ADC_Decimator_Seed(CMix_ADC_Decimator_t *dec, uint16_t sample)
+{
+    dec->sum = 0;
+    dec->count = 0;
+    dec->output = (uint16_t)(sample << CMIX_ADC_EXT_SHIFT);
+}
+
+/* 各通道抽取比 (按通道号索引的初始化列表) */
+#if CMIX_ADC_OVERSAMPLE_ENABLE
+#define CMIX_ADC_OSR_LOG2_INIT      { [CMIX_ADC_VIN_CHANNEL] = CMIX_ADC_VIN_OSR_LOG2, \
+                                      [CMIX_ADC_CURRENT_A_CHANNEL] = CMIX_ADC_CURRENT_A_OSR_LOG2, \
+                                      [CMIX_ADC_VOUT_CHANNEL] = CMIX_ADC_VOUT_OSR_LOG2, \
+                                      [CMIX_ADC_CURRENT_B_CHANNEL] = CMIX_ADC_CURRENT_B_OSR_LOG2 }
+#else
+#define CMIX_ADC_OSR_LOG2_INIT      { 0 }
+#endif
+
 /* ========================= 中断回调函数 ========================= */
 
 /* UART中断回调 */
@@ -135,6 +368,10 @@ void CMix_Hardware_TIM_PWM_Callback(void);
 
 /* ADC中断回调 */
 void CMix_Hardware_ADC_Conversion_Complete_Callback(void);
+void CMix_Hardware_ADC_AWD_Trip_Callback(uint8_t channel);
+
+/* CMP中断回调 */
+void CMix_Hardware_CMP_Trip_Callback(uint8_t unit);
 
 /* GPIO中断回调 */
 void CMix_Hardware_GPIO_EXTI_Callback(uint16_t pin);
@@ -19,14 +19,22 @@
 #include "CMix_hardware.h"
 #include "CMix_protocol.h"
 #include "CMix_dcdc.h"
+#include "CMix_crc.h"
+#include "CMix_param.h"
+#include "CMix_blackbox.h"
+#include "CMix_telemetry.h"
+#include "CMix_trace.h"
 #include "CMix_config.h"
-#include <stdio.h>  // 支持sprintf函数
 
 /* ========================= 私有变量 ========================= */
 
 static CMix_Application_State_t g_app_state = CMIX_APP_STATE_INIT;
 static CMix_Task_Scheduler_t g_task_scheduler = {0};
 static CMix_System_Monitor_t g_system_monitor = {0};
+static volatile uint32_t g_systick_ms = 0;     // SysTick毫秒计数 (SysTick中断递增)
+#if CMIX_PARAM_STORE_ENABLE
+static uint32_t g_param_scan_cycles = 0;        // 参数区启动扫描耗时 (CPU周期)
+#endif
 
 /* ========================= 私有函数声明 ========================= */
 
@@ -36,9 +44,51 @@ static void CMix_Main_Task_1ms(void);
 static void CMix_Main_Task_10ms(void);
 static void CMix_Main_Task_100ms(void);
 static void CMix_Main_Task_1000ms(void);
+#if CMIX_PARAM_STORE_ENABLE
+static void CMix_Main_Task_Param(void);
+#endif
+#if CMIX_BLACKBOX_ENABLE
+static void CMix_Main_Task_Blackbox(void);
+#endif
+#if CMIX_DEBUG_ENABLE
+static void CMix_Main_Task_Trace(void);
+#endif
+#if CMIX_TELEMETRY_ENABLE
+static void CMix_Main_Task_Telemetry(void);
+#endif
+#if CMIX_PARAM_STORE_ENABLE || CMIX_BLACKBOX_ENABLE
+static bool CMix_Main_Converter_Switching(void);
+#endif
 static void CMix_Main_System_Monitor(void);
 static void CMix_Main_LED_Control(void);
 static void CMix_Main_Watchdog_Handler(void);
+static void CMix_Main_SysTick_Init(void);
+static uint32_t CMix_Main_Get_Cycle_Stamp(void);
+static bool CMix_Main_Task_Due(void);
+
+/* ========================= 任务表 ========================= */
+
+#define CMIX_TASK_COUNT     (sizeof(g_task_table) / sizeof(g_task_table[0]))
+
+static CMix_Task_t g_task_table[] = {
+    /* 名称      任务函数               周期ms  截止us */
+    {"1ms",    CMix_Main_Task_1ms,    1,      500},
+    {"10ms",   CMix_Main_Task_10ms,   10,     2000},
+    {"100ms",  CMix_Main_Task_100ms,  100,    20000},
+    {"1000ms", CMix_Main_Task_1000ms, 1000,   50000},
+#if CMIX_PARAM_STORE_ENABLE
+    {"param",  CMix_Main_Task_Param,  CMIX_PARAM_STEP_MS, CMIX_PARAM_STEP_DEADLINE_US},
+#endif
+#if CMIX_BLACKBOX_ENABLE
+    {"blackbox", CMix_Main_Task_Blackbox, CMIX_BLACKBOX_STEP_MS, CMIX_BLACKBOX_STEP_DEADLINE_US},
+#endif
+#if CMIX_DEBUG_ENABLE
+    {"trace",  CMix_Main_Task_Trace,  CMIX_TRACE_FLUSH_MS, CMIX_TRACE_FLUSH_DEADLINE_US},
+#endif
+#if CMIX_TELEMETRY_ENABLE
+    {"telemetry", CMix_Main_Task_Telemetry, CMIX_TELEMETRY_FLUSH_MS, CMIX_TELEMETRY_FLUSH_DEADLINE_US},
+#endif
+};
 
 /* ========================= 主函数 ========================= */
 
@@ -60,14 +110,20 @@ int main(void)
         /* 任务调度器 */
         CMix_Main_Task_Scheduler();
         
+        /* 执行上位机命令 (每轮限量, 避免阻塞任务调度) */
+        CMix_Protocol_Process_Pending(CMIX_PROTOCOL_CMDS_PER_SLOT);
+        
         /* 看门狗处理 */
         CMix_Main_Watchdog_Handler();
         
-        /* CPU空闲时可以进入低功耗模式 */
-        if (g_task_scheduler.idle_time > CMIX_IDLE_THRESHOLD) {
-            /* 进入低功耗模式 */
+        /* 无到期任务且无待处理命令时休眠, SysTick每1ms唤醒.
+         * 关中断后再检查, 避免检查与WFI之间到来的中断被错过 */
+        __disable_irq();
+        if (!CMix_Main_Task_Due() && !CMix_Protocol_Has_Pending()) {
+            g_task_scheduler.sleep_count++;
             __WFI();
         }
+        __enable_irq();
     }
 }
 
@@ -76,52 +132,107 @@ int main(void)
 /**
  * @brief CMix任务调度器
  * @param None
- * @retval None
+ * @retval 本次执行的任务数
+ * @note  按任务表顺序执行到期任务. 释放时刻按周期累加, 不随执行时间漂移;
+ *        延迟超过整周期时跳过错过的释放并计数, 不补执行
  */
-void CMix_Main_Task_Scheduler(void)
+uint8_t CMix_Main_Task_Scheduler(void)
 {
-    static uint32_t last_tick = 0;
-    uint32_t current_tick = CMix_Main_Get_System_Tick();
-    uint32_t elapsed_time = current_tick - last_tick;
-    
-    /* 更新任务计数器 */
-    g_task_scheduler.tick_1ms += elapsed_time;
-    g_task_scheduler.tick_10ms += elapsed_time;
-    g_task_scheduler.tick_100ms += elapsed_time;
-    g_task_scheduler.tick_1000ms += elapsed_time;
-    
-    last_tick = current_tick;
-    
-    /* 1ms任务 */
-    if (g_task_scheduler.tick_1ms >= 1) {
-        g_task_scheduler.tick_1ms = 0;
-        CMix_Main_Task_1ms();
-        g_task_scheduler.task_counter_1ms++;
-    }
-    
-    /* 10ms任务 */
-    if (g_task_scheduler.tick_10ms >= 10) {
-        g_task_scheduler.tick_10ms = 0;
-        CMix_Main_Task_10ms();
-        g_task_scheduler.task_counter_10ms++;
+    uint32_t now_ms = CMix_Main_Get_System_Tick();
+    uint32_t cycles_per_ms = g_task_scheduler.cycles_per_ms;
+    uint8_t executed = 0;
+    uint8_t i;
+    
+    g_system_monitor.system_tick = now_ms;
+    
+    for (i = 0; i < CMIX_TASK_COUNT; i++) {
+        CMix_Task_t *task = &g_task_table[i];
+        CMix_Task_Stats_t *stats = &task->stats;
+        uint32_t lateness = now_ms - task->next_release_ms;
+        uint32_t release_ms, start, end, exec_cycles;
+        
+        /* 未到释放时刻 */
+        if ((int32_t)lateness < 0) {
+            continue;
+        }
+        
+        /* 跳过错过的整周期 */
+        release_ms = task->next_release_ms;
+        if (lateness >= task->period_ms) {
+            uint32_t missed = lateness / task->period_ms;
+            stats->skipped_count += missed;
+            release_ms += missed * task->period_ms;
+        }
+        task->next_release_ms = release_ms + task->period_ms;
+        
+        /* 执行并测量 */
+        start = CMix_Main_Get_Cycle_Stamp();
+        task->function();
+        end = CMix_Main_Get_Cycle_Stamp();
+        exec_cycles = end - start;
+        
+        /* 截止时间: 从释放时刻到完成时刻 */
+        if (end - release_ms * cycles_per_ms > (uint32_t)task->deadline_us * (cycles_per_ms / 1000)) {
+            stats->overrun_count++;
+        }
+        
+        if (stats->run_count == 0) {
+            stats->exec_min_cycles = exec_cycles;
+            stats->exec_max_cycles = exec_cycles;
+            stats->exec_avg_cycles = exec_cycles;
+        } else {
+            if (exec_cycles < stats->exec_min_cycles) {
+                stats->exec_min_cycles = exec_cycles;
+            }
+            if (exec_cycles > stats->exec_max_cycles) {
+                stats->exec_max_cycles = exec_cycles;
+            }
+            stats->exec_avg_cycles = stats->exec_avg_cycles - (stats->exec_avg_cycles >> 3) + (exec_cycles >> 3);
+        }
+        stats->run_count++;
+        
+        g_task_scheduler.busy_cycles += exec_cycles;
+        executed++;
     }
     
-    /* 100ms任务 */
-    if (g_task_scheduler.tick_100ms >= 100) {
-        g_task_scheduler.tick_100ms = 0;
-        CMix_Main_Task_100ms();
-        g_task_scheduler.task_counter_100ms++;
+    return executed;
+}
+
+/**
+ * @brief CMix获取任务数量
+ * @param None
+ * @retval 任务表中的任务数
+ */
+uint8_t CMix_Main_Get_Task_Count(void)
+{
+    return (uint8_t)CMIX_TASK_COUNT;
+}
+
+/**
+ * @brief CMix获取任务描述及统计
+ * @param index: 任务序号
+ * @retval 任务指针, 序号无效时返回NULL
+ */
+const CMix_Task_t* CMix_Main_Get_Task(uint8_t index)
+{
+    if (index >= CMIX_TASK_COUNT) {
+        return NULL;
     }
+    return &g_task_table[index];
+}
+
+/**
+ * @brief CMix清除全部任务执行统计
+ * @param None
+ * @retval None
+ */
+void CMix_Main_Reset_Task_Stats(void)
+{
+    uint8_t i;
     
-    /* 1000ms任务 */
-    if (g_task_scheduler.tick_1000ms >= 1000) {
-        g_task_scheduler.tick_1000ms = 0;
-        CMix_Main_Task_1000ms();
-        g_task_scheduler.task_counter_1000ms++;
+    for (i = 0; i < CMIX_TASK_COUNT; i++) {
+        memset(&g_task_table[i].stats, 0, sizeof(g_task_table[i].stats));
     }
-    
-    /* 计算空闲时间 */
-    g_task_scheduler.idle_time = 100 - g_task_scheduler.cpu_usage;
 }
 
 /**
@@ -171,8 +282,7 @@ CMix_Task_Scheduler_t* CMix_Main_Get_Task_Scheduler(void)
  */
 uint32_t CMix_Main_Get_System_Tick(void)
 {
-    /* 返回系统滴答计数，需要SysTick中断支持 */
-    return g_system_monitor.system_tick;
+    return g_systick_ms;
 }
 
 /**
@@ -235,30 +345,19 @@ void CMix_Main_Emergency_Handler(uint8_t emergency_code)
  */
 void CMix_Main_Performance_Monitor(void)
 {
-    static uint32_t last_performance_check = 0;
     uint32_t current_time = CMix_Main_Get_System_Tick();
+    uint32_t window_ms = current_time - g_task_scheduler.window_start_ms;
     
-    if (current_time - last_performance_check >= 1000) {
-        /* 每秒更新一次性能指标 */
-        
-        /* 计算CPU使用率 */
-        uint32_t total_tasks = g_task_scheduler.task_counter_1ms + 
-                              g_task_scheduler.task_counter_10ms * 10 +
-                              g_task_scheduler.task_counter_100ms * 100 +
-                              g_task_scheduler.task_counter_1000ms * 1000;
-        
-        g_task_scheduler.cpu_usage = (total_tasks * 100) / 1000;
-        if (g_task_scheduler.cpu_usage > 100) {
-            g_task_scheduler.cpu_usage = 100;
-        }
+    if (window_ms >= 1000) {
+        /* 每秒更新一次: 任务执行周期数 / 窗口总周期数 */
+        uint32_t window_percent = window_ms * (g_task_scheduler.cycles_per_ms / 100);
+        uint32_t usage = (window_percent > 0) ? (g_task_scheduler.busy_cycles / window_percent) : 0;
         
-        /* 重置计数器 */
-        g_task_scheduler.task_counter_1ms = 0;
-        g_task_scheduler.task_counter_10ms = 0;
-        g_task_scheduler.task_counter_100ms = 0;
-        g_task_scheduler.task_counter_1000ms = 0;
+        g_task_scheduler.cpu_usage = (usage > 100) ? 100 : (uint8_t)usage;
+        g_task_scheduler.idle_time = 100 - g_task_scheduler.cpu_usage;
         
-        last_performance_check = current_time;
+        g_task_scheduler.busy_cycles = 0;
+        g_task_scheduler.window_start_ms = current_time;
     }
 }
 
@@ -270,32 +369,15 @@ void CMix_Main_Performance_Monitor(void)
 void CMix_Main_Debug_Print(void)
 {
     #if CMIX_DEBUG_ENABLE
-    char msg_buffer[128];
-    
-    CMix_Protocol_Send_Debug_Message("=== CMix System Status ===");
-    
-    sprintf(msg_buffer, "App State: %d", g_app_state);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Runtime: %d seconds", g_system_monitor.runtime_seconds);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "CPU Usage: %d%%", g_task_scheduler.cpu_usage);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Memory Usage: %d%%", g_system_monitor.memory_usage);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Temperature: %d°C", g_system_monitor.temperature);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Emergency Count: %d", g_system_monitor.emergency_count);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    sprintf(msg_buffer, "Error Count: %d", g_system_monitor.error_count);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
-    
-    CMix_Protocol_Send_Debug_Message("========================");
+    CMIX_TRACE0(CMIX_TRACE_SYS_BANNER);
+    CMIX_TRACE1(CMIX_TRACE_SYS_APP_STATE, g_app_state);
+    CMIX_TRACE1(CMIX_TRACE_SYS_RUNTIME, g_system_monitor.runtime_seconds);
+    CMIX_TRACE1(CMIX_TRACE_SYS_CPU, g_task_scheduler.cpu_usage);
+    CMIX_TRACE1(CMIX_TRACE_SYS_MEMORY, g_system_monitor.memory_usage);
+    CMIX_TRACE1(CMIX_TRACE_SYS_TEMPERATURE, g_system_monitor.temperature);
+    CMIX_TRACE1(CMIX_TRACE_SYS_EMERGENCIES, g_system_monitor.emergency_count);
+    CMIX_TRACE1(CMIX_TRACE_SYS_ERRORS, g_system_monitor.error_count);
+    CMIX_TRACE0(CMIX_TRACE_SYS_END);
     #endif
 }
 
@@ -311,9 +393,20 @@ static void CMix_Main_System_Init(void)
     /* 硬件初始化 */
     CMix_Hardware_Init();
     
+    /* SysTick 1ms时基 */
+    CMix_Main_SysTick_Init();
+    
     /* 协议初始化 */
     CMix_Protocol_Init();
     
+    /* 恢复已保存的参数 (覆盖协议默认值) */
+    CMix_Main_Load_Parameters();
+    
+#if CMIX_BLACKBOX_ENABLE
+    /* 扫描故障快照区, 开始记录波形 */
+    CMix_Blackbox_Init();
+#endif
+    
     /* DCDC初始化 */
     CMix_DCDC_Init();
     
@@ -321,7 +414,7 @@ static void CMix_Main_System_Init(void)
     CMix_Main_Task_Scheduler_Init();
     
     /* 系统监控初始化 */
-    g_system_monitor.system_tick = 0;
+    g_system_monitor.system_tick = CMix_Main_Get_System_Tick();
     g_system_monitor.runtime_seconds = 0;
     g_system_monitor.temperature = 25;  /* 默认温度 */
     g_system_monitor.memory_usage = 50; /* 默认内存使用率 */
@@ -342,12 +435,46 @@ static void CMix_Main_System_Init(void)
     
     /* 发送启动信息 */
     #if CMIX_DEBUG_ENABLE
-    char msg_buffer[64];
+    CMIX_TRACE0(CMIX_TRACE_STARTED);
+    CMIX_TRACE1(CMIX_TRACE_SYSTEM_CLOCK, CMix_Hardware_Get_System_Clock() / 1000000);
     
-    CMix_Protocol_Send_Debug_Message("CMix DCDC Controller V1.0.0 Started");
+    /* 比较器实际动作电压: 两路与ADC电压通道同一分压, 共用LDAC0码值 */
+    CMIX_TRACE3(CMIX_TRACE_CMP_THRESHOLD, CMix_Hardware_CMP_Get_Threshold(), CMix_Hardware_CMP_Get_Threshold(),
+                CMIX_CMP_THRESHOLD_MV);
     
-    sprintf(msg_buffer, "System Clock: %d MHz", CMix_Hardware_Get_System_Clock() / 1000000);
-    CMix_Protocol_Send_Debug_Message(msg_buffer);
+    #if CMIX_PARAM_STORE_ENABLE
+    /* 参数区启动扫描结果 */
+    {
+        CMix_Param_Stats_t param_stats;
+        
+        CMix_Param_Get_Stats(&param_stats);
+        CMIX_TRACE5(CMIX_TRACE_PARAM_SCAN, param_stats.stored_keys, param_stats.boot_records,
+                    param_stats.boot_invalid, param_stats.page_sequence, g_param_scan_cycles);
+    }
+    #endif
+    
+    #if CMIX_BLACKBOX_ENABLE
+    /* 故障快照区扫描结果 */
+    {
+        CMix_Blackbox_Stats_t blackbox_stats;
+        
+        CMix_Blackbox_Get_Stats(&blackbox_stats);
+        CMIX_TRACE6(CMIX_TRACE_BLACKBOX_SCAN, blackbox_stats.region, blackbox_stats.sequence,
+                    blackbox_stats.fault_code, blackbox_stats.pre_samples, blackbox_stats.post_samples,
+                    blackbox_stats.trigger_ms);
+    }
+    #endif
+    
+    /* CRC后端自检与耗时对比 (最大数据长度帧) */
+    {
+        uint8_t crc_test_data[CMIX_PROTOCOL_MAX_DATA_LEN];
+        CMix_CRC_Benchmark_t crc_bench;
+        
+        memset(crc_test_data, 0x5A, sizeof(crc_test_data));
+        CMix_CRC_Benchmark(crc_test_data, sizeof(crc_test_data), &crc_bench);
+        CMIX_TRACE6(CMIX_TRACE_CRC_BENCH, crc_bench.length, crc_bench.hw_available, CMix_CRC_Self_Test(),
+                    crc_bench.table_cycles, crc_bench.hw_cycles, crc_bench.hw_dma_cycles);
+    }
     #endif
 }
 
@@ -358,16 +485,20 @@ static void CMix_Main_System_Init(void)
  */
 static void CMix_Main_Task_Scheduler_Init(void)
 {
-    g_task_scheduler.tick_1ms = 0;
-    g_task_scheduler.tick_10ms = 0;
-    g_task_scheduler.tick_100ms = 0;
-    g_task_scheduler.tick_1000ms = 0;
-    g_task_scheduler.task_counter_1ms = 0;
-    g_task_scheduler.task_counter_10ms = 0;
-    g_task_scheduler.task_counter_100ms = 0;
-    g_task_scheduler.task_counter_1000ms = 0;
+    uint32_t now_ms = CMix_Main_Get_System_Tick();
+    uint8_t i;
+    
+    g_task_scheduler.busy_cycles = 0;
+    g_task_scheduler.window_start_ms = now_ms;
+    g_task_scheduler.sleep_count = 0;
     g_task_scheduler.cpu_usage = 0;
     g_task_scheduler.idle_time = 100;
+    
+    /* 首次释放在下一毫秒 */
+    for (i = 0; i < CMIX_TASK_COUNT; i++) {
+        g_task_table[i].next_release_ms = now_ms + 1;
+    }
+    CMix_Main_Reset_Task_Stats();
 }
 
 /**
@@ -377,9 +508,6 @@ static void CMix_Main_Task_Scheduler_Init(void)
  */
 static void CMix_Main_Task_1ms(void)
 {
-    /* 系统滴答计数 */
-    g_system_monitor.system_tick++;
-    
     /* DCDC控制任务 */
     CMix_DCDC_Control_Task();
     
@@ -387,6 +515,77 @@ static void CMix_Main_Task_1ms(void)
     CMix_DCDC_State_Machine();
 }
 
+#if CMIX_PARAM_STORE_ENABLE
+/**
+ * @brief CMix参数存储任务: 每次至多一次Flash操作
+ * @param None
+ * @retval None
+ * @note  擦除时CPU取指停顿数毫秒: 变换器开关期间不擦除, 通信未空闲时也推迟,
+ *        避免停顿期间UART接收溢出丢帧
+ */
+static void CMix_Main_Task_Param(void)
+{
+    bool switching = CMix_Main_Converter_Switching();
+    
+    CMix_Param_Step(!switching || CMIX_PARAM_PROGRAM_WHILE_SWITCHING,
+                    !switching && CMix_Protocol_Get_RX_Idle_ms() >= CMIX_PARAM_ERASE_IDLE_MS);
+}
+#endif
+
+#if CMIX_BLACKBOX_ENABLE
+/**
+ * @brief CMix黑匣子任务: 冻结的故障窗口写入Flash, 每次至多一次Flash操作
+ * @param None
+ * @retval None
+ * @note  写入随时允许 (故障后变换器已停止开关); 擦除条件与参数存储相同
+ */
+static void CMix_Main_Task_Blackbox(void)
+{
+    bool switching = CMix_Main_Converter_Switching();
+    
+    CMix_Blackbox_Step(true, !switching && CMix_Protocol_Get_RX_Idle_ms() >= CMIX_BLACKBOX_ERASE_IDLE_MS);
+}
+#endif
+
+#if CMIX_DEBUG_ENABLE
+/**
+ * @brief CMix跟踪记录任务: 积压的记录打包发送, 不等待发送队列
+ * @param None
+ * @retval None
+ */
+static void CMix_Main_Task_Trace(void)
+{
+    CMix_Trace_Flush();
+}
+#endif
+
+#if CMIX_TELEMETRY_ENABLE
+/**
+ * @brief CMix遥测流任务: 积压的记录打包发送, 为其他帧保留发送队列空间
+ * @param None
+ * @retval None
+ */
+static void CMix_Main_Task_Telemetry(void)
+{
+    CMix_Telemetry_Flush();
+}
+#endif
+
+#if CMIX_PARAM_STORE_ENABLE || CMIX_BLACKBOX_ENABLE
+/**
+ * @brief 变换器是否在开关 (Flash擦除停顿期间PWM比较值不能更新)
+ * @param None
+ * @retval true = 软启动或运行中
+ */
+static bool CMix_Main_Converter_Switching(void)
+{
+    uint8_t state = CMix_DCDC_Get_Status()->state;
+    
+    return (state == CMIX_STATE_SOFT_START || state == CMIX_STATE_RUNNING ||
+            state == CMIX_STATE_BUCK || state == CMIX_STATE_BOOST);
+}
+#endif
+
 /**
  * @brief CMix 10ms任务
  * @param None
@@ -423,26 +622,25 @@ static void CMix_Main_Task_100ms(void)
         debug_counter = 0;
         
         /* 获取系统状态 */
-        float vin = CMix_Hardware_ADC_Get_Value(CMIX_ADC_VIN_CHANNEL) * 5.0f / 4095.0f * 20.0f;  // 假设20:1分压
-        float vout = CMix_Hardware_ADC_Get_Value(CMIX_ADC_VOUT_CHANNEL) * 5.0f / 4095.0f * 20.0f;
+        CMix_Voltage_Sensors_t voltages = CMix_Hardware_Get_Voltage_Sensors();
+        float vin = (float)CMix_Hardware_Convert_Voltage_Ext_mV(voltages.input_voltage) * 0.001f;
+        float vout = (float)CMix_Hardware_Convert_Voltage_Ext_mV(voltages.output_voltage) * 0.001f;
         float current_a = CMix_Hardware_Get_Current_A();  // 相A电流 (A)
         float current_b = CMix_Hardware_Get_Current_B();  // 相B电流 (A)
         
         /* 获取DCDC状态 */
         CMix_DCDC_Status_t* dcdc_status = CMix_DCDC_Get_Status();
-        char msg_buffer[128];
         
-        /* UART输出系统状态 */
-        sprintf(msg_buffer, "[%s] Vin=%.2fV, Vout=%.2fV, Ia=%.3fA, Ib=%.3fA, Mode=%s",
-               (g_app_state == CMIX_APP_STATE_RUNNING) ? "RUN" : "IDLE",
-               vin, vout, current_a, current_b,
-               (dcdc_status->mode == CMIX_MODE_BUCK) ? "BUCK" : "BOOST");
-        CMix_Protocol_Send_Debug_Message(msg_buffer);
+        /* UART输出系统状态 (浮点按位模式记录, 主机格式化) */
+        CMIX_TRACE6(CMIX_TRACE_STATUS,
+                    (g_app_state == CMIX_APP_STATE_RUNNING) ? CMIX_TRACE_STR_RUN : CMIX_TRACE_STR_IDLE,
+                    CMIX_TRACE_F32(vin), CMIX_TRACE_F32(vout),
+                    CMIX_TRACE_F32(current_a), CMIX_TRACE_F32(current_b),
+                    (dcdc_status->mode == CMIX_MODE_BUCK) ? CMIX_TRACE_STR_BUCK : CMIX_TRACE_STR_BOOST);
                
         /* 检查过流状态 */
         if (CMix_Hardware_Check_Overcurrent(current_a, current_b, 40.0f)) {
-            sprintf(msg_buffer, "[FAULT] Overcurrent detected! Ia=%.3fA, Ib=%.3fA", current_a, current_b);
-            CMix_Protocol_Send_Debug_Message(msg_buffer);
+            CMIX_TRACE2(CMIX_TRACE_OVERCURRENT, CMIX_TRACE_F32(current_a), CMIX_TRACE_F32(current_b));
         }
     }
     #endif
@@ -476,7 +674,6 @@ static void CMix_Main_Task_1000ms(void)
 static void CMix_Main_System_Monitor(void)
 {
     /* 监控系统关键参数 */
-    CMix_DCDC_Status_t *dcdc_status = CMix_DCDC_Get_Status();
     CMix_Safety_Monitor_t *safety_status = CMix_DCDC_Get_Safety_Status();
     
     /* 检查系统错误 */
@@ -567,7 +764,55 @@ static void CMix_Main_Watchdog_Handler(void)
 void SysTick_Handler(void)
 {
     /* 系统时钟中断，提供1ms时基 */
-    /* 这个函数由硬件自动调用 */
+    g_systick_ms++;
+}
+
+/**
+ * @brief SysTick初始化 - 1ms中断, 最低中断优先级
+ * @param None
+ * @retval None
+ */
+static void CMix_Main_SysTick_Init(void)
+{
+    g_task_scheduler.cycles_per_ms = CMix_Hardware_Get_System_Clock() / 1000;
+    SysTick_Config(g_task_scheduler.cycles_per_ms);
+}
+
+/**
+ * @brief 获取CPU周期时间戳 (毫秒计数 * 每毫秒周期数 + SysTick已计数值)
+ * @param None
+ * @retval 周期时间戳 (32位回绕, 仅用于求差)
+ * @note  两次读取毫秒计数一致才返回, 避免SysTick重装边界上的不一致
+ */
+static uint32_t CMix_Main_Get_Cycle_Stamp(void)
+{
+    uint32_t cycles_per_ms = g_task_scheduler.cycles_per_ms;
+    uint32_t ms, val;
+    
+    do {
+        ms = g_systick_ms;
+        val = SysTick->VAL;
+    } while (ms != g_systick_ms);
+    
+    return ms * cycles_per_ms + (cycles_per_ms - 1 - val);
+}
+
+/**
+ * @brief 是否有任务到达释放时刻
+ * @param None
+ * @retval true=有任务待执行
+ */
+static bool CMix_Main_Task_Due(void)
+{
+    uint32_t now_ms = g_systick_ms;
+    uint8_t i;
+    
+    for (i = 0; i < CMIX_TASK_COUNT; i++) {
+        if ((int32_t)(now_ms - g_task_table[i].next_release_ms) >= 0) {
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
@@ -594,22 +839,72 @@ const char* CMix_Main_Get_Build_Info(void)
  * @brief CMix系统参数保存
  * @param None
  * @retval 保存结果 (0:成功, 非0:失败)
+ * @note  只更新参数存储的RAM值, 由参数存储任务在后台写入Flash; 未改变的参数不产生记录
  */
 uint8_t CMix_Main_Save_Parameters(void)
 {
-    /* 这里可以添加参数保存到EEPROM或Flash的代码 */
-    /* 目前返回成功 */
+    #if CMIX_PARAM_STORE_ENABLE
+    CMix_System_Parameters_t *params = CMix_Protocol_Get_System_Parameters();
+    uint8_t failed = 0;
+    
+    failed |= !CMix_Param_Set(CMIX_PARAM_KEY_INPUT_VOLTAGE, params->input_voltage_threshold);
+    failed |= !CMix_Param_Set(CMIX_PARAM_KEY_OUTPUT_VOLTAGE, params->output_voltage_threshold);
+    failed |= !CMix_Param_Set(CMIX_PARAM_KEY_MAX_INPUT_CURRENT, params->max_input_current);
+    failed |= !CMix_Param_Set(CMIX_PARAM_KEY_MAX_OUTPUT_CURRENT, params->max_output_current);
+    failed |= !CMix_Param_Set(CMIX_PARAM_KEY_MAX_OUTPUT_POWER, params->max_output_power);
+    failed |= !CMix_Param_Set(CMIX_PARAM_KEY_WORKING_MODE, params->working_mode);
+    return failed;
+    #else
     return 0;
+    #endif
 }
 
 /**
  * @brief CMix系统参数加载
  * @param None
- * @retval 加载结果 (0:成功, 非0:失败)
+ * @retval 加载结果 (0:成功, 非0:参数区无记录, 保持默认值)
+ * @note  需在CMix_Protocol_Init之后调用; 只覆盖有记录的参数
  */
 uint8_t CMix_Main_Load_Parameters(void)
 {
-    /* 这里可以添加从EEPROM或Flash加载参数的代码 */
-    /* 目前返回成功 */
+    #if CMIX_PARAM_STORE_ENABLE
+    CMix_System_Parameters_t *params = CMix_Protocol_Get_System_Parameters();
+    uint8_t loaded = 0;
+    uint32_t start, value;
+    
+    start = CMix_Main_Get_Cycle_Stamp();
+    CMix_Param_Init();
+    g_param_scan_cycles = CMix_Main_Get_Cycle_Stamp() - start;
+    
+    if (CMix_Param_Get(CMIX_PARAM_KEY_INPUT_VOLTAGE, &value)) {
+        params->input_voltage_threshold = value;
+        loaded++;
+    }
+    if (CMix_Param_Get(CMIX_PARAM_KEY_OUTPUT_VOLTAGE, &value)) {
+        params->output_voltage_threshold = value;
+        loaded++;
+    }
+    if (CMix_Param_Get(CMIX_PARAM_KEY_MAX_INPUT_CURRENT, &value)) {
+        params->max_input_current = value;
+        loaded++;
+    }
+    if (CMix_Param_Get(CMIX_PARAM_KEY_MAX_OUTPUT_CURRENT, &value)) {
+        params->max_output_current = value;
+        loaded++;
+    }
+    if (CMix_Param_Get(CMIX_PARAM_KEY_MAX_OUTPUT_POWER, &value)) {
+        params->max_output_power = value;
+        loaded++;
+    }
+    if (CMix_Param_Get(CMIX_PARAM_KEY_WORKING_MODE, &value) && value <= CMIX_MODE_AUTO) {
+        params->working_mode = (uint8_t)value;
+        CMix_Protocol_Get_System_Status()->working_mode = (uint8_t)value;
+        loaded++;
+    }
+    CMix_Protocol_Apply_AWD_Limits();
+    
+    return (loaded > 0) ? 0 : 1;
+    #else
     return 0;
+    #endif
 }
\ No newline at end of file
@@ -40,18 +40,34 @@ typedef CMix_App_State_t CMix_Application_State_t;
 
 /* 任务调度器结构体 */
 typedef struct {
-    uint32_t tick_1ms;                  // 1ms任务计数器
-    uint32_t tick_10ms;                 // 10ms任务计数器
-    uint32_t tick_100ms;                // 100ms任务计数器
-    uint32_t tick_1000ms;               // 1000ms任务计数器
-    uint32_t task_counter_1ms;          // 1ms任务执行计数
-    uint32_t task_counter_10ms;         // 10ms任务执行计数
-    uint32_t task_counter_100ms;        // 100ms任务执行计数
-    uint32_t task_counter_1000ms;       // 1000ms任务执行计数
-    uint8_t cpu_usage;                  // CPU使用率
-    uint8_t idle_time;                  // 空闲时间
+    uint32_t cycles_per_ms;             // 每毫秒SysTick计数 (CPU周期)
+    uint32_t busy_cycles;               // 当前统计窗口内任务执行周期数
+    uint32_t window_start_ms;           // 当前统计窗口起始时间 (ms)
+    uint32_t sleep_count;               // 主循环进入WFI次数
+    uint8_t cpu_usage;                  // CPU使用率 (%, 按任务执行时间实测)
+    uint8_t idle_time;                  // 空闲时间 (%)
 } CMix_Task_Scheduler_t;
 
+/* 任务执行统计 (时间单位: CPU周期, 由SysTick->VAL测量) */
+typedef struct {
+    uint32_t run_count;                 // 执行次数
+    uint32_t overrun_count;             // 完成时间超过截止时间的次数
+    uint32_t skipped_count;             // 因延迟而跳过的释放周期数
+    uint32_t exec_min_cycles;           // 最短执行时间
+    uint32_t exec_avg_cycles;           // 平均执行时间 (1/8指数滑动平均)
+    uint32_t exec_max_cycles;           // 最长执行时间
+} CMix_Task_Stats_t;
+
+/* 周期任务描述 */
+typedef struct {
+    const char *name;                   // 任务名称
+    void (*function)(void);             // 任务函数
+    uint16_t period_ms;                 // 释放周期 (ms)
+    uint16_t deadline_us;               // 相对释放时刻的截止时间 (us)
+    uint32_t next_release_ms;           // 下次释放时刻 (ms)
+    CMix_Task_Stats_t stats;            // 执行统计
+} CMix_Task_t;
+
 /* 系统监控结构体 */
 typedef struct {
     uint32_t system_tick;               // 系统滴答计数
@@ -96,7 +112,11 @@ void CMix_System_Stop(void);
 void CMix_System_Reset(void);
 
 /* 任务调度 */
-void CMix_Main_Task_Scheduler(void);
+uint8_t CMix_Main_Task_Scheduler(void);
+uint8_t CMix_Main_Get_Task_Count(void);
+const CMix_Task_t* CMix_Main_Get_Task(uint8_t index);
+void CMix_Main_Reset_Task_Stats(void);
+CMix_Task_Scheduler_t* CMix_Main_Get_Task_Scheduler(void);
 void CMix_Task_Scheduler(void);
 void CMix_Task_Control(void);
 void CMix_Task_Communication(void);
@@ -124,6 +144,10 @@ void CMix_System_Fault_Handler(void);
 void CMix_Power_Save_Mode(void);
 void CMix_Power_Normal_Mode(void);
 
+/* 参数存储 */
+uint8_t CMix_Main_Save_Parameters(void);
+uint8_t CMix_Main_Load_Parameters(void);
+
 /* 系统测试 */
 void CMix_System_Self_Test(void);
 bool CMix_System_Health_Check(void);
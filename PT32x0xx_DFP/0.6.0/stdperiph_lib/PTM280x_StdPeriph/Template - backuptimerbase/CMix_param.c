@@ -0,0 +1,457 @@
+/******************************************************************************
+  * @file    CMix_param.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix参数存储模块实现文件
+  *          实现参数区启动扫描、记录追加、换页复制和旧页擦除
+  ******************************************************************************
+  * @attention
+  *
+  * CMix参数存储模块实现
+  * 页状态只有三种: 已擦除 (全0xFF)、有效 (页头标识和序号完整)、待擦除
+  * (其余情况, 如擦除或写页头时掉电). 记录在页内只追加, 同一键的新记录
+  * 排在旧记录之后; 页按序号排序, 因此扫描顺序即写入顺序.
+  *
+  * 掩码按位表示键 (位号 = 键值): stored为Flash中有记录的键, in_active为
+  * 最新记录位于活动页的键, dirty为RAM值尚未写入的键. 需要写入的键为
+  * dirty | (stored & ~in_active); 后者为空时活动页之外的有效页都已过时.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_param.h"
+#include "CMix_crc.h"
+
+#if CMIX_PARAM_STORE_ENABLE
+
+/* ========================= 私有定义 ========================= */
+
+#define CMIX_PARAM_PAGE_MAGIC       0x50584D43U     // 页头标识 "CMXP"
+#define CMIX_PARAM_RECORD_VERSION   1               // 记录格式版本, 格式变更时递增 (旧记录被忽略)
+#define CMIX_PARAM_BLANK            0xFFFFFFFFU     // 已擦除字
+#define CMIX_PARAM_HEADER_BYTES     8               // 页头: 标识, 序号
+#define CMIX_PARAM_RECORD_BYTES     8               // 记录: 值, 键|版本|CRC16
+#define CMIX_PARAM_SLOT_COUNT       ((CMIX_PARAM_PAGE_SIZE - CMIX_PARAM_HEADER_BYTES) / CMIX_PARAM_RECORD_BYTES)
+#define CMIX_PARAM_NO_PAGE          0xFF
+#define CMIX_PARAM_IFMC_LOCK_KEY    0xEA2D0000U     // KR2上锁键 (库内私有定义, IFMC_ErasePage返回时未上锁)
+
+#define CMIX_PARAM_PAGE_ADDR(page)        (CMIX_PARAM_FLASH_BASE + (uint32_t)(page) * CMIX_PARAM_PAGE_SIZE)
+#define CMIX_PARAM_SLOT_ADDR(page, slot)  (CMIX_PARAM_PAGE_ADDR(page) + CMIX_PARAM_HEADER_BYTES + \
+                                           (uint32_t)(slot) * CMIX_PARAM_RECORD_BYTES)
+#define CMIX_PARAM_KEY_BIT(key)           (1UL << (key))
+
+/* 页状态 */
+typedef enum {
+    CMIX_PARAM_PAGE_ERASED = 0,             // 全0xFF, 可作为新页
+    CMIX_PARAM_PAGE_VALID,                  // 页头完整
+    CMIX_PARAM_PAGE_DIRTY                   // 待擦除
+} CMix_Param_Page_State_t;
+
+/* 存储状态 */
+typedef struct {
+    uint32_t value[CMIX_PARAM_KEY_COUNT];   // 各键当前值 (RAM)
+    uint32_t stored;                        // Flash中有记录的键
+    uint32_t in_active;                     // 最新记录位于活动页的键
+    uint32_t dirty;                         // RAM值尚未写入的键
+    uint32_t sequence[CMIX_PARAM_PAGE_COUNT];
+    uint8_t state[CMIX_PARAM_PAGE_COUNT];
+    uint32_t last_sequence;                 // 最大页序号
+    uint8_t active;                         // 活动页 (CMIX_PARAM_NO_PAGE = 无)
+    uint8_t next_slot;                      // 活动页下一个空记录槽
+    uint8_t last_key;                       // 上次写入的键 (轮询起点)
+    bool ready;
+} CMix_Param_Store_t;
+
+/* ========================= 私有变量 ========================= */
+
+static CMix_Param_Store_t g_param;
+static CMix_Param_Stats_t g_param_stats;
+
+/* ========================= 私有函数声明 ========================= */
+
+static uint32_t CMix_Param_Meta(uint8_t key, uint32_t value);
+static bool CMix_Param_Page_Blank(uint8_t page);
+static uint32_t CMix_Param_Work_Mask(void);
+static uint8_t CMix_Param_Next_Key(uint32_t work);
+static bool CMix_Param_Write_Record(uint8_t key);
+static bool CMix_Param_Open_Page(void);
+static bool CMix_Param_Erase_Obsolete(void);
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 启动扫描: 按页序号从旧到新读一遍参数区, 重建各键最新值和写入位置
+ * @param None
+ * @retval None
+ * @note  需在CMix_CRC_Init之后调用. 只读Flash, 待擦除页和空间整理由后台任务完成
+ */
+void CMix_Param_Init(void)
+{
+    uint8_t order[CMIX_PARAM_PAGE_COUNT];
+    uint8_t order_count = 0;
+    uint8_t last_page[CMIX_PARAM_KEY_COUNT];
+    uint8_t page, slot, key, i;
+
+    memset(&g_param, 0, sizeof(g_param));
+    memset(&g_param_stats, 0, sizeof(g_param_stats));
+    memset(last_page, CMIX_PARAM_NO_PAGE, sizeof(last_page));
+    g_param.active = CMIX_PARAM_NO_PAGE;
+
+    /* 页头分类, 有效页按序号插入排序 */
+    for (page = 0; page < CMIX_PARAM_PAGE_COUNT; page++) {
+        uint32_t magic = IFMC_ReadWord(CMIX_PARAM_PAGE_ADDR(page));
+        uint32_t sequence = IFMC_ReadWord(CMIX_PARAM_PAGE_ADDR(page) + 4);
+
+        if (magic == CMIX_PARAM_PAGE_MAGIC && sequence != CMIX_PARAM_BLANK) {
+            g_param.state[page] = CMIX_PARAM_PAGE_VALID;
+            g_param.sequence[page] = sequence;
+            for (i = order_count; i > 0 && g_param.sequence[order[i - 1]] > sequence; i--) {
+                order[i] = order[i - 1];
+            }
+            order[i] = page;
+            order_count++;
+        } else if (magic == CMIX_PARAM_BLANK && sequence == CMIX_PARAM_BLANK && CMix_Param_Page_Blank(page)) {
+            g_param.state[page] = CMIX_PARAM_PAGE_ERASED;
+        } else {
+            g_param.state[page] = CMIX_PARAM_PAGE_DIRTY;
+        }
+    }
+
+    /* 记录扫描: 后出现的覆盖先出现的. 空槽跳过而不结束扫描, 写入位置取最后一个非空槽之后 */
+    for (i = 0; i < order_count; i++) {
+        page = order[i];
+        g_param.next_slot = 0;
+        for (slot = 0; slot < CMIX_PARAM_SLOT_COUNT; slot++) {
+            uint32_t value = IFMC_ReadWord(CMIX_PARAM_SLOT_ADDR(page, slot));
+            uint32_t meta = IFMC_ReadWord(CMIX_PARAM_SLOT_ADDR(page, slot) + 4);
+
+            if (value == CMIX_PARAM_BLANK && meta == CMIX_PARAM_BLANK) {
+                continue;
+            }
+            g_param.next_slot = slot + 1;
+
+            key = (uint8_t)(meta & 0xFF);
+            if (key == 0 || key >= CMIX_PARAM_KEY_COUNT || meta != CMix_Param_Meta(key, value)) {
+                g_param_stats.boot_invalid++;
+                continue;
+            }
+            g_param.value[key] = value;
+            g_param.stored |= CMIX_PARAM_KEY_BIT(key);
+            last_page[key] = page;
+            g_param_stats.boot_records++;
+        }
+    }
+
+    if (order_count > 0) {
+        g_param.active = order[order_count - 1];
+        g_param.last_sequence = g_param.sequence[g_param.active];
+        for (key = 1; key < CMIX_PARAM_KEY_COUNT; key++) {
+            if (last_page[key] == g_param.active) {
+                g_param.in_active |= CMIX_PARAM_KEY_BIT(key);
+            }
+        }
+    }
+
+    g_param.ready = true;
+}
+
+/**
+ * @brief 读取参数
+ * @param key: 参数键
+ * @param value: 输出值
+ * @retval true = 有值 (已保存或已设置), false = 无记录 (调用方保持默认值)
+ */
+bool CMix_Param_Get(uint8_t key, uint32_t *value)
+{
+    if (!g_param.ready || key == 0 || key >= CMIX_PARAM_KEY_COUNT ||
+        ((g_param.stored | g_param.dirty) & CMIX_PARAM_KEY_BIT(key)) == 0) {
+        return false;
+    }
+    *value = g_param.value[key];
+    return true;
+}
+
+/**
+ * @brief 设置参数 (只更新RAM值并标记待写, 不等待Flash)
+ * @param key: 参数键
+ * @param value: 参数值
+ * @retval true = 已接受, false = 键无效或未扫描
+ * @note  与已有值相同时不产生新记录. 可在中断中调用
+ */
+bool CMix_Param_Set(uint8_t key, uint32_t value)
+{
+    uint32_t bit = CMIX_PARAM_KEY_BIT(key);
+    uint32_t primask;
+
+    if (!g_param.ready || key == 0 || key >= CMIX_PARAM_KEY_COUNT) {
+        return false;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (((g_param.stored | g_param.dirty) & bit) == 0 || g_param.value[key] != value) {
+        g_param.value[key] = value;
+        g_param.dirty |= bit;
+    }
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+/**
+ * @brief 是否有尚未写入Flash的参数
+ * @param None
+ * @retval true = 有待写入
+ */
+bool CMix_Param_Is_Pending(void)
+{
+    return g_param.ready && CMix_Param_Work_Mask() != 0;
+}
+
+/**
+ * @brief 后台写入: 至多执行一次Flash操作
+ * @param program_ok: 允许写记录和页头 (CPU停顿两个字编程时间)
+ * @param erase_ok: 允许擦除 (CPU停顿一次页擦除时间)
+ * @retval None
+ * @note  优先级: 写记录 > 换页写页头 > 擦除待擦除页和过时页.
+ *        换页后先复制未复制的键, 再写新值; 同类键轮询, 频繁修改的键不会饿死其他键.
+ *        活动页满且没有已擦除页时待写参数保留在RAM中, 输出关闭后擦除旧页再写入
+ */
+void CMix_Param_Step(bool program_ok, bool erase_ok)
+{
+    uint32_t work;
+
+    if (!g_param.ready) {
+        return;
+    }
+
+    work = CMix_Param_Work_Mask();
+    if (work != 0 && program_ok) {
+        if (g_param.active != CMIX_PARAM_NO_PAGE && g_param.next_slot < CMIX_PARAM_SLOT_COUNT) {
+            CMix_Param_Write_Record(CMix_Param_Next_Key(work));
+            return;
+        }
+        if (CMix_Param_Open_Page()) {
+            return;
+        }
+    }
+
+    if (erase_ok) {
+        CMix_Param_Erase_Obsolete();
+    }
+}
+
+/**
+ * @brief 获取参数存储统计
+ * @param stats: 统计输出指针
+ * @retval None
+ */
+void CMix_Param_Get_Stats(CMix_Param_Stats_t *stats)
+{
+    uint32_t work = g_param.ready ? CMix_Param_Work_Mask() : 0;
+    uint8_t key;
+
+    *stats = g_param_stats;
+    stats->active_page = g_param.active;
+    stats->page_sequence = (g_param.active != CMIX_PARAM_NO_PAGE) ? g_param.sequence[g_param.active] : 0;
+    stats->free_slots = (g_param.active != CMIX_PARAM_NO_PAGE) ? (uint8_t)(CMIX_PARAM_SLOT_COUNT - g_param.next_slot) : 0;
+    stats->stored_keys = 0;
+    stats->pending_keys = 0;
+    for (key = 1; key < CMIX_PARAM_KEY_COUNT; key++) {
+        if (g_param.stored & CMIX_PARAM_KEY_BIT(key)) {
+            stats->stored_keys++;
+        }
+        if (work & CMIX_PARAM_KEY_BIT(key)) {
+            stats->pending_keys++;
+        }
+    }
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 记录第二字: 键[7:0] | 格式版本[15:8] | CRC16[31:16]
+ * @param key: 参数键
+ * @param value: 参数值
+ * @retval 记录第二字
+ * @note  CRC16-Modbus覆盖值 (小端4字节)、键和格式版本
+ */
+static uint32_t CMix_Param_Meta(uint8_t key, uint32_t value)
+{
+    uint8_t data[6];
+
+    data[0] = (uint8_t)(value & 0xFF);
+    data[1] = (uint8_t)((value >> 8) & 0xFF);
+    data[2] = (uint8_t)((value >> 16) & 0xFF);
+    data[3] = (uint8_t)(value >> 24);
+    data[4] = key;
+    data[5] = CMIX_PARAM_RECORD_VERSION;
+
+    return (uint32_t)key | ((uint32_t)CMIX_PARAM_RECORD_VERSION << 8) |
+           ((uint32_t)CMix_CRC16_Modbus(data, sizeof(data)) << 16);
+}
+
+/**
+ * @brief 检查整页是否为已擦除状态
+ */
+static bool CMix_Param_Page_Blank(uint8_t page)
+{
+    uint32_t address;
+
+    for (address = CMIX_PARAM_PAGE_ADDR(page); address < CMIX_PARAM_PAGE_ADDR(page + 1); address += 4) {
+        if (IFMC_ReadWord(address) != CMIX_PARAM_BLANK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 需要写入活动页的键: 新值和换页后尚未复制的键
+ */
+static uint32_t CMix_Param_Work_Mask(void)
+{
+    return g_param.dirty | (g_param.stored & ~g_param.in_active);
+}
+
+/**
+ * @brief 选择下一个写入的键: 优先换页复制, 从上次写入的键之后轮询
+ * @param work: 需要写入的键 (非空)
+ * @retval 参数键
+ */
+static uint8_t CMix_Param_Next_Key(uint32_t work)
+{
+    uint32_t uncopied = g_param.stored & ~g_param.in_active;
+    uint8_t key = g_param.last_key;
+    uint8_t i;
+
+    if (uncopied != 0) {
+        work = uncopied;
+    }
+    for (i = 0; i < CMIX_PARAM_KEY_COUNT; i++) {
+        key = (uint8_t)((key + 1) % CMIX_PARAM_KEY_COUNT);
+        if (work & CMIX_PARAM_KEY_BIT(key)) {
+            break;
+        }
+    }
+    g_param.last_key = key;
+    return key;
+}
+
+/**
+ * @brief 在活动页追加一条记录并回读校验
+ * @param key: 参数键
+ * @retval true = 写入成功
+ * @note  校验失败的槽位作废 (启动扫描时因CRC错误跳过), 该键下次写入下一槽
+ */
+static bool CMix_Param_Write_Record(uint8_t key)
+{
+    uint32_t address = CMIX_PARAM_SLOT_ADDR(g_param.active, g_param.next_slot);
+    uint32_t bit = CMIX_PARAM_KEY_BIT(key);
+    uint32_t record[2];
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    record[0] = g_param.value[key];
+    __set_PRIMASK(primask);
+    record[1] = CMix_Param_Meta(key, record[0]);
+
+    IFMC_ProgramWords(address, record, 2);
+    g_param.next_slot++;
+
+    if (IFMC_ReadWord(address) != record[0] || IFMC_ReadWord(address + 4) != record[1]) {
+        g_param_stats.program_errors++;
+        return false;
+    }
+
+    /* 写入期间值又被修改时保持待写 */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (g_param.value[key] == record[0]) {
+        g_param.dirty &= ~bit;
+    }
+    __set_PRIMASK(primask);
+
+    g_param.stored |= bit;
+    g_param.in_active |= bit;
+    g_param_stats.records_written++;
+    return true;
+}
+
+/**
+ * @brief 换页: 在环中活动页之后的第一个已擦除页写入页头
+ * @param None
+ * @retval true = 执行了Flash操作, false = 没有已擦除页
+ * @note  新页序号为最大序号加一; 此后全部已保存的键都需复制到新页
+ */
+static bool CMix_Param_Open_Page(void)
+{
+    uint8_t first = (g_param.active == CMIX_PARAM_NO_PAGE) ? 0 : (uint8_t)(g_param.active + 1);
+    uint32_t header[2];
+    uint8_t i;
+
+    for (i = 0; i < CMIX_PARAM_PAGE_COUNT; i++) {
+        uint8_t page = (uint8_t)((first + i) % CMIX_PARAM_PAGE_COUNT);
+        uint32_t address = CMIX_PARAM_PAGE_ADDR(page);
+
+        if (g_param.state[page] != CMIX_PARAM_PAGE_ERASED) {
+            continue;
+        }
+
+        header[0] = CMIX_PARAM_PAGE_MAGIC;
+        header[1] = g_param.last_sequence + 1;
+        IFMC_ProgramWords(address, header, 2);
+
+        if (IFMC_ReadWord(address) != header[0] || IFMC_ReadWord(address + 4) != header[1]) {
+            g_param.state[page] = CMIX_PARAM_PAGE_DIRTY;
+            g_param_stats.program_errors++;
+            return true;
+        }
+
+        g_param.state[page] = CMIX_PARAM_PAGE_VALID;
+        g_param.sequence[page] = header[1];
+        g_param.last_sequence = header[1];
+        g_param.active = page;
+        g_param.next_slot = 0;
+        g_param.in_active = 0;
+        g_param_stats.rotations++;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 擦除一个待擦除页或过时页 (全部键的最新值都已在活动页时, 其余有效页过时)
+ * @param None
+ * @retval true = 执行了擦除
+ */
+static bool CMix_Param_Erase_Obsolete(void)
+{
+    bool obsolete = (g_param.stored & ~g_param.in_active) == 0;
+    uint8_t page;
+
+    for (page = 0; page < CMIX_PARAM_PAGE_COUNT; page++) {
+        if (page == g_param.active || g_param.state[page] == CMIX_PARAM_PAGE_ERASED ||
+            (g_param.state[page] == CMIX_PARAM_PAGE_VALID && !obsolete)) {
+            continue;
+        }
+
+        IFMC_ErasePage(CMIX_PARAM_PAGE_ADDR(page));
+        IFMC->KR2 = CMIX_PARAM_IFMC_LOCK_KEY;
+        while ((IFMC->KR2 & IFMC_KR2_LOCK1) == 0);
+        g_param_stats.erases++;
+        if (CMix_Param_Page_Blank(page)) {
+            g_param.state[page] = CMIX_PARAM_PAGE_ERASED;
+        } else {
+            g_param.state[page] = CMIX_PARAM_PAGE_DIRTY;
+            g_param_stats.program_errors++;
+        }
+        return true;
+    }
+    return false;
+}
+
+#endif /* CMIX_PARAM_STORE_ENABLE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+  * @file    CMix_param.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix参数存储模块头文件
+  *          系统参数以键值记录追加写入内部Flash末尾的轮换页, 掉电保持
+  ******************************************************************************
+  * @attention
+  *
+  * CMix参数存储模块
+  * 参数区由CMIX_PARAM_PAGE_COUNT个Flash页组成环. 每页开头为页头 (标识字,
+  * 页序号), 其后为两字记录 (值, 键|格式版本|CRC16). 修改参数只更新RAM值并
+  * 标记待写, 后台任务每次至多执行一次Flash操作 (写一条记录、写新页页头或
+  * 擦除一页), 调用方不等待Flash.
+  *
+  * 活动页写满后换到环中下一个已擦除页, 先把各键最新值复制过去, 全部复制
+  * 完成后旧页才可擦除, 任何时刻掉电都至少保留一份完整的最新值. 擦除期间
+  * CPU取指停顿, 由调用方只在变换器未开关时允许. 启动时按页序号从旧到新线性扫描
+  * 一遍, 后出现的记录覆盖先出现的, CRC错误或写入中断的记录被跳过.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_PARAM_H
+#define __CMIX_PARAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CMix_config.h"
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 参数键 (记录中的8位键值, 0和0xFF保留) */
+typedef enum {
+    CMIX_PARAM_KEY_INPUT_VOLTAGE = 1,       // 输入电压阈值 (mV)
+    CMIX_PARAM_KEY_OUTPUT_VOLTAGE,          // 输出电压阈值 (mV)
+    CMIX_PARAM_KEY_MAX_INPUT_CURRENT,       // 最大输入电流 (mA)
+    CMIX_PARAM_KEY_MAX_OUTPUT_CURRENT,      // 最大输出电流 (mA)
+    CMIX_PARAM_KEY_MAX_OUTPUT_POWER,        // 最大输出功率 (mW)
+    CMIX_PARAM_KEY_WORKING_MODE,            // 工作模式
+    CMIX_PARAM_KEY_COUNT                    // 键数上界 (不含)
+} CMix_Param_Key_t;
+
+/* 参数存储统计 */
+typedef struct {
+    uint32_t page_sequence;                 // 活动页序号 (0 = 无活动页)
+    uint8_t  active_page;                   // 活动页编号 (0xFF = 无)
+    uint8_t  free_slots;                    // 活动页剩余记录槽
+    uint8_t  stored_keys;                   // Flash中有记录的键数
+    uint8_t  pending_keys;                  // 尚未写入活动页的键数
+    uint16_t boot_records;                  // 启动扫描的有效记录数
+    uint16_t boot_invalid;                  // 启动扫描跳过的记录数 (CRC错误/写入中断)
+    uint32_t records_written;               // 写入记录数 (含轮换复制)
+    uint32_t rotations;                     // 换页次数
+    uint32_t erases;                        // 页擦除次数
+    uint32_t program_errors;                // 写入或擦除后校验失败次数
+} CMix_Param_Stats_t;
+
+/* ========================= 函数声明 ========================= */
+
+/* 启动扫描 */
+void CMix_Param_Init(void);
+
+/* 参数读写 (写入只更新RAM值, 由后台任务写入Flash) */
+bool CMix_Param_Get(uint8_t key, uint32_t *value);
+bool CMix_Param_Set(uint8_t key, uint32_t value);
+bool CMix_Param_Is_Pending(void);
+
+/* 后台写入: 是否允许写记录/擦除由调用方按运行状态决定 */
+void CMix_Param_Step(bool program_ok, bool erase_ok);
+
+/* 统计 */
+void CMix_Param_Get_Stats(CMix_Param_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_PARAM_H */
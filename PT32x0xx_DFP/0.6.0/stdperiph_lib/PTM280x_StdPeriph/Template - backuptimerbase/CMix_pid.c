@@ -0,0 +1,318 @@
+/******************************************************************************
+  * @file    CMix_pid.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix定点PI/PID控制器实现文件
+  *          实现Q15/Q31饱和运算的PID控制器, 带积分限幅和条件积分抗饱和
+  ******************************************************************************
+  * @attention
+  *
+  * CMix定点控制模块实现
+  * 单次更新仅包含整数乘加与比较, 不调用软件浮点库
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_pid.h"
+
+/* ========================= 私有常量 ========================= */
+
+/* 倒数初值表: 65536 / (1 + (i + 0.5) / 32)
+ * 除数左移归一化到 [2^31, 2^32) 后, 以最高位之后的5位尾数为索引
+ */
+static const uint16_t g_recip_seed[1 << CMIX_RECIP_SEED_BITS] = {
+    64528, 62602, 60787, 59075, 57456, 55924, 54471, 53092,
+    51782, 50534, 49345, 48210, 47127, 46091, 45100, 44151,
+    43240, 42367, 41528, 40721, 39946, 39199, 38480, 37787,
+    37118, 36472, 35849, 35246, 34664, 34100, 33554, 33026
+};
+
+/* ========================= 私有函数声明 ========================= */
+
+static uint32_t CMix_Recip_Seed(uint32_t divisor);
+static uint32_t CMix_Recip_Newton(CMix_Recip_t *recip, uint32_t divisor, uint32_t estimate);
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 定点PID控制器初始化
+ * @param pid: PID控制器指针
+ * @param kp_q15: 比例系数 (Q15)
+ * @param ki_q31: 积分系数 Ki*Ts (Q31)
+ * @param kd_q15: 微分系数 Kd/Ts (Q15), 0表示纯PI
+ * @param output_min: 输出最小值
+ * @param output_max: 输出最大值
+ * @retval None
+ */
+void CMix_PID_Init(CMix_PID_Q_t *pid, int32_t kp_q15, int32_t ki_q31, int32_t kd_q15,
+                   int32_t output_min, int32_t output_max)
+{
+    pid->kp_q15 = kp_q15;
+    pid->ki_q31 = ki_q31;
+    pid->kd_q15 = kd_q15;
+    pid->output_min = output_min;
+    pid->output_max = output_max;
+    pid->integral_min_q15 = CMix_Sat32((int64_t)output_min << CMIX_Q15_SHIFT);
+    pid->integral_max_q15 = CMix_Sat32((int64_t)output_max << CMIX_Q15_SHIFT);
+
+    CMix_PID_Reset(pid);
+}
+
+/**
+ * @brief 定点PID控制器复位 (清除积分和历史状态, 保留参数)
+ * @param pid: PID控制器指针
+ * @retval None
+ */
+void CMix_PID_Reset(CMix_PID_Q_t *pid)
+{
+    pid->integral_q15 = 0;
+    pid->integral_frac = 0;
+    pid->last_error = 0;
+    pid->last_feedback = 0;
+    pid->output = 0;
+    pid->saturated = 0;
+}
+
+/**
+ * @brief 预置积分值 (用于无扰切换)
+ * @param pid: PID控制器指针
+ * @param value: 积分值 (输出单位)
+ * @retval None
+ */
+void CMix_PID_Set_Integral(CMix_PID_Q_t *pid, int32_t value)
+{
+    int32_t integral = CMix_Sat32((int64_t)value << CMIX_Q15_SHIFT);
+
+    pid->integral_q15 = CMix_Clamp32(integral, pid->integral_min_q15, pid->integral_max_q15);
+    pid->integral_frac = 0;
+}
+
+/**
+ * @brief 定点PID控制器更新
+ * @param pid: PID控制器指针
+ * @param setpoint: 设定值
+ * @param feedback: 反馈值
+ * @retval 控制输出 (已限幅到 output_min..output_max)
+ *
+ * 抗积分饱和采用两级措施:
+ *   1. 条件积分: 输出已饱和且误差继续推向饱和方向时停止积分
+ *   2. 积分限幅: 积分值限制在输出上下限范围内 (与浮点版本一致)
+ * 微分项作用于反馈值 (而非误差), 设定值阶跃时不产生微分冲击
+ */
+int32_t CMix_PID_Update(CMix_PID_Q_t *pid, int32_t setpoint, int32_t feedback)
+{
+    int32_t error = CMix_Sat32((int64_t)setpoint - feedback);
+    int64_t sum;
+    int32_t output;
+
+    /* 积分项: error * Ki*Ts (Q31) >> 16 = Q15, 移出的低位计入余数, 累计满1再进位
+     * (直接右移向负无穷舍入, 小的负误差每步减1而小的正误差不加, 积分会持续下漂) */
+    if (!((pid->saturated > 0 && error > 0) || (pid->saturated < 0 && error < 0))) {
+        int64_t scaled = (int64_t)error * pid->ki_q31 + pid->integral_frac;
+        int32_t increment = CMix_Sat32(scaled >> (CMIX_Q31_SHIFT - CMIX_Q15_SHIFT));
+        int32_t integral = CMix_Sat_Add32(pid->integral_q15, increment);
+
+        pid->integral_frac = (uint32_t)scaled & ((1U << (CMIX_Q31_SHIFT - CMIX_Q15_SHIFT)) - 1);
+        pid->integral_q15 = CMix_Clamp32(integral, pid->integral_min_q15, pid->integral_max_q15);
+        if (pid->integral_q15 != integral) {
+            pid->integral_frac = 0;         /* 到达积分限幅, 余数无意义 */
+        }
+    }
+
+    /* 比例项 + 积分项 (Q15) */
+    sum = (int64_t)error * pid->kp_q15 + pid->integral_q15;
+
+    /* 微分项 (作用于反馈) */
+    if (pid->kd_q15 != 0) {
+        int32_t delta = CMix_Sat32((int64_t)pid->last_feedback - feedback);
+        sum += (int64_t)delta * pid->kd_q15;
+    }
+
+    /* 输出限幅 */
+    output = CMix_Sat32(sum >> CMIX_Q15_SHIFT);
+    if (output >= pid->output_max) {
+        output = pid->output_max;
+        pid->saturated = 1;
+    } else if (output <= pid->output_min) {
+        output = pid->output_min;
+        pid->saturated = -1;
+    } else {
+        pid->saturated = 0;
+    }
+
+    pid->last_error = error;
+    pid->last_feedback = feedback;
+    pid->output = output;
+
+    return output;
+}
+
+/**
+ * @brief 倒数估计初始化
+ * @param recip: 倒数估计指针
+ * @param min_divisor: 除数下限 (小于2时按2处理), 低于时倒数无效
+ * @param deadband: 除数变化不超过该值时保持原倒数
+ * @retval None
+ */
+void CMix_Recip_Init(CMix_Recip_t *recip, uint32_t min_divisor, uint32_t deadband)
+{
+    recip->divisor = 0;
+    recip->recip = 0;
+    recip->min_divisor = (min_divisor < 2) ? 2 : min_divisor;
+    recip->deadband = deadband;
+    recip->reseeds = 0;
+    recip->iterations = 0;
+}
+
+/**
+ * @brief 更新倒数估计 (不含除法)
+ * @param recip: 倒数估计指针
+ * @param divisor: 新除数
+ * @retval None
+ * @note  与上次除数相差不超过1/8时以上次结果为初值迭代 (小幅变化通常1次),
+ *        否则查表取初值 (最多3次); 迭代后按余数修正为精确的floor(2^32 / divisor)
+ */
+void CMix_Recip_Update(CMix_Recip_t *recip, uint32_t divisor)
+{
+    uint32_t estimate;
+
+    if (divisor < recip->min_divisor) {
+        recip->divisor = 0;
+        recip->recip = 0;
+        return;
+    }
+
+    if (recip->divisor != 0) {
+        uint32_t delta = (divisor > recip->divisor) ? (divisor - recip->divisor) : (recip->divisor - divisor);
+
+        if (delta <= recip->deadband) {
+            return;
+        }
+        if (delta <= (recip->divisor >> 3)) {
+            estimate = recip->recip;
+        } else {
+            estimate = CMix_Recip_Seed(divisor);
+            recip->reseeds++;
+        }
+    } else {
+        estimate = CMix_Recip_Seed(divisor);
+        recip->reseeds++;
+    }
+
+    recip->recip = CMix_Recip_Newton(recip, divisor, estimate);
+    recip->divisor = divisor;
+}
+
+/**
+ * @brief 两相均流积分器初始化
+ * @param share: 均流积分器指针
+ * @param gain_shift: 积分增益 2^-gain_shift
+ * @param max_trim: 修正量上限 (占空比单位), 下限为其相反数
+ * @param deadband: 相电流差死区 (mA)
+ * @param error_max: 单步相电流差限幅 (mA)
+ * @retval None
+ * @note  max_trim << gain_shift 须在int32_t范围内
+ */
+void CMix_Share_Init(CMix_Share_t *share, uint8_t gain_shift, int32_t max_trim, int32_t deadband, int32_t error_max)
+{
+    share->gain_shift = gain_shift;
+    share->limit = max_trim << gain_shift;
+    share->deadband = deadband;
+    share->error_max = error_max;
+    CMix_Share_Reset(share);
+}
+
+/**
+ * @brief 两相均流积分器清零 (停机或退出交错运行时)
+ * @param share: 均流积分器指针
+ * @retval None
+ */
+void CMix_Share_Reset(CMix_Share_t *share)
+{
+    share->accumulator = 0;
+    share->trim = 0;
+}
+
+/**
+ * @brief 两相均流积分一步
+ * @param share: 均流积分器指针
+ * @param current_a: 相A电流 (mA, 有符号)
+ * @param current_b: 相B电流 (mA, 有符号)
+ * @retval 修正量 (占空比单位)
+ * @note  按有符号电流差积分, 反向 (回馈) 运行时同样使两相电流趋于相等
+ */
+int32_t CMix_Share_Update(CMix_Share_t *share, int32_t current_a, int32_t current_b)
+{
+    int32_t error = current_a - current_b;
+
+    if (error > share->deadband || error < -share->deadband) {
+        share->accumulator = CMix_Clamp32(share->accumulator + CMix_Clamp32(error, -share->error_max, share->error_max),
+                                          -share->limit, share->limit);
+        share->trim = share->accumulator >> share->gain_shift;
+    }
+    return share->trim;
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 查表取倒数初值
+ * @param divisor: 除数 (>= 2)
+ * @retval 2^32 / divisor 的近似值 (相对误差 < 1/64)
+ */
+static uint32_t CMix_Recip_Seed(uint32_t divisor)
+{
+    uint32_t normalized = divisor;
+    uint32_t shift = 0;
+
+    /* 归一化到 [2^31, 2^32) (M0无CLZ指令, 二分查找) */
+    if ((normalized & 0xFFFF0000U) == 0) { normalized <<= 16; shift += 16; }
+    if ((normalized & 0xFF000000U) == 0) { normalized <<= 8;  shift += 8; }
+    if ((normalized & 0xF0000000U) == 0) { normalized <<= 4;  shift += 4; }
+    if ((normalized & 0xC0000000U) == 0) { normalized <<= 2;  shift += 2; }
+    if ((normalized & 0x80000000U) == 0) { normalized <<= 1;  shift += 1; }
+
+    /* 2^32 / divisor = 2^(shift + 1) / m, m = normalized / 2^31 ∈ [1, 2) */
+    return (uint32_t)(((uint64_t)g_recip_seed[(normalized >> (31 - CMIX_RECIP_SEED_BITS)) &
+                                              ((1U << CMIX_RECIP_SEED_BITS) - 1)] << (shift + 1)) >> 16);
+}
+
+/**
+ * @brief 牛顿迭代求倒数并修正为精确值
+ * @param recip: 倒数估计指针 (统计迭代次数)
+ * @param divisor: 除数 (>= 2)
+ * @param estimate: 初值 (相对误差 < 1/8)
+ * @retval floor(2^32 / divisor)
+ * @note  y' = y + y * e / 2^32, e = 2^32 - divisor * y; |e| < divisor时y与精确值相差不超过1
+ */
+static uint32_t CMix_Recip_Newton(CMix_Recip_t *recip, uint32_t divisor, uint32_t estimate)
+{
+    int64_t y = estimate;
+    int64_t error = ((int64_t)1 << CMIX_RECIP_SHIFT) - (int64_t)divisor * y;
+    int64_t step;
+    uint8_t i;
+
+    for (i = 0; i < CMIX_RECIP_MAX_ITERATIONS && (error < 0 || error >= (int64_t)divisor); i++) {
+        step = (y * error) >> CMIX_RECIP_SHIFT;
+        if (step == 0) {
+            break;                          /* 误差小于1, 由余数修正 */
+        }
+        y += step;
+        error = ((int64_t)1 << CMIX_RECIP_SHIFT) - (int64_t)divisor * y;
+        recip->iterations++;
+    }
+
+    /* 余数修正: 0 <= error < divisor */
+    while (error < 0) {
+        y--;
+        error += divisor;
+    }
+    while (error >= (int64_t)divisor) {
+        y++;
+        error -= divisor;
+    }
+
+    return (uint32_t)y;
+}
@@ -0,0 +1,196 @@
+/******************************************************************************
+  * @file    CMix_pid.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix定点PI/PID控制器头文件
+  *          定义Q15/Q31定点格式、饱和运算、定点PID控制器、倒数估计和两相均流接口
+  ******************************************************************************
+  * @attention
+  *
+  * CMix定点控制模块
+  * Cortex-M0无FPU, 控制环全部采用整数饱和运算, 以满足PWM速率的控制周期
+  *
+  * 定点格式约定:
+  *   Kp/Kd      : Q15  (实际值 * 32768, 允许大于1.0)
+  *   Ki * Ts    : Q31  (实际值 * 2^31, 必须小于1.0)
+  *   积分累计值 : Q15  (输出单位 * 32768), 另保留Q31增量的低16位余数,
+  *                逐步累加不丢失小数部分, 小误差时积分不偏向负方向
+  *   误差       : 饱和到 int32_t 范围 (单位与设定值相同, 如mV/mA),
+  *                与系数的乘积按64位计算
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_PID_H
+#define __CMIX_PID_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CMix_config.h"
+
+/* ========================= 定点格式定义 ========================= */
+
+typedef int16_t CMix_Q15_t;                 // Q15定点数
+typedef int32_t CMix_Q31_t;                 // Q31定点数
+
+#define CMIX_Q15_SHIFT              15
+#define CMIX_Q31_SHIFT              31
+#define CMIX_Q15_MAX                ((int32_t)0x7FFF)
+#define CMIX_Q15_MIN                ((int32_t)-0x8000)
+#define CMIX_Q31_MAX                ((int32_t)0x7FFFFFFF)
+#define CMIX_Q31_MIN                ((int32_t)(-0x7FFFFFFF - 1))
+
+/* 浮点常数转换为定点 (编译期计算, 仅用于常量表达式) */
+#define CMIX_Q15(x)                 ((int32_t)((x) * 32768.0 + (((x) >= 0) ? 0.5 : -0.5)))
+#define CMIX_Q31(x)                 ((int32_t)((x) * 2147483648.0 + (((x) >= 0) ? 0.5 : -0.5)))
+
+/* ========================= 饱和运算 ========================= */
+
+/**
+ * @brief 64位中间值饱和到int32_t
+ */
+static __inline int32_t CMix_Sat32(int64_t value)
+{
+    if (value > CMIX_Q31_MAX) {
+        return CMIX_Q31_MAX;
+    }
+    if (value < CMIX_Q31_MIN) {
+        return CMIX_Q31_MIN;
+    }
+    return (int32_t)value;
+}
+
+/**
+ * @brief 32位值饱和到int16_t (Q15) 范围
+ */
+static __inline int32_t CMix_Sat16(int32_t value)
+{
+    if (value > CMIX_Q15_MAX) {
+        return CMIX_Q15_MAX;
+    }
+    if (value < CMIX_Q15_MIN) {
+        return CMIX_Q15_MIN;
+    }
+    return value;
+}
+
+/**
+ * @brief 32位饱和加法
+ */
+static __inline int32_t CMix_Sat_Add32(int32_t a, int32_t b)
+{
+    int32_t sum = (int32_t)((uint32_t)a + (uint32_t)b);
+
+    /* 同号相加结果变号即溢出 */
+    if (((a ^ sum) & (b ^ sum)) < 0) {
+        return (a < 0) ? CMIX_Q31_MIN : CMIX_Q31_MAX;
+    }
+    return sum;
+}
+
+/**
+ * @brief 值限幅
+ */
+static __inline int32_t CMix_Clamp32(int32_t value, int32_t min, int32_t max)
+{
+    if (value > max) {
+        return max;
+    }
+    if (value < min) {
+        return min;
+    }
+    return value;
+}
+
+/* ========================= 定点PID控制器 ========================= */
+
+/* 定点PID控制器结构体 */
+typedef struct {
+    int32_t kp_q15;                         // 比例系数 Q15
+    int32_t ki_q31;                         // 积分系数 Ki*Ts Q31
+    int32_t kd_q15;                         // 微分系数 Kd/Ts Q15 (0 = 纯PI)
+    int32_t integral_q15;                   // 积分累计值 Q15 (输出单位)
+    uint32_t integral_frac;                 // 积分余数 (Q31增量右移16位舍去的低16位)
+    int32_t output_min;                     // 输出下限 (输出单位)
+    int32_t output_max;                     // 输出上限 (输出单位)
+    int32_t integral_min_q15;               // 积分下限 Q15 (由输出下限换算)
+    int32_t integral_max_q15;               // 积分上限 Q15 (由输出上限换算)
+    int32_t last_error;                     // 上次误差 (已饱和)
+    int32_t last_feedback;                  // 上次反馈值 (微分项使用)
+    int32_t output;                         // 控制输出 (输出单位)
+    int8_t saturated;                       // 输出饱和方向 (1=上限, -1=下限, 0=未饱和)
+} CMix_PID_Q_t;
+
+/* ========================= 倒数估计 ========================= */
+
+#define CMIX_RECIP_SHIFT            32          // 倒数格式: recip = floor(2^32 / divisor)
+#define CMIX_RECIP_SEED_BITS        5           // 初值表索引位数 (32项, 初值相对误差 < 1/64)
+#define CMIX_RECIP_MAX_ITERATIONS   4           // 单次更新牛顿迭代上限
+
+/* 倒数估计 (用于热路径中以乘法代替除法)
+ * 除数变化较小时由上次结果做牛顿迭代, 变化较大或首次更新时查表取初值
+ */
+typedef struct {
+    uint32_t divisor;                       // 当前倒数对应的除数 (0 = 无效)
+    uint32_t recip;                         // floor(2^32 / divisor), 无效时为0
+    uint32_t min_divisor;                   // 除数下限 (>= 2), 低于时倒数无效
+    uint32_t deadband;                      // 除数变化不超过该值时保持原倒数
+    uint32_t reseeds;                       // 查表取初值次数 (统计)
+    uint32_t iterations;                    // 牛顿迭代总次数 (统计)
+} CMix_Recip_t;
+
+/**
+ * @brief 乘以倒数: floor(x / divisor) 或小1, 倒数无效时为0
+ */
+static __inline uint32_t CMix_Recip_Mul(const CMix_Recip_t *recip, uint32_t x)
+{
+    return (uint32_t)(((uint64_t)x * recip->recip) >> CMIX_RECIP_SHIFT);
+}
+
+/**
+ * @brief 倒数是否有效 (除数不低于下限)
+ */
+static __inline bool CMix_Recip_Is_Valid(const CMix_Recip_t *recip)
+{
+    return recip->divisor != 0;
+}
+
+/* ========================= 两相均流 ========================= */
+
+/* 两相均流积分器 (控制中断内每步调用一次)
+ * 只有加减、比较和移位, 无乘除和循环, 每步耗时与输入无关.
+ * 修正量trim: 相A占空比减trim、相B加trim, 相A电流偏大时trim增大
+ */
+typedef struct {
+    int32_t accumulator;                    // 积分累计值 (trim << gain_shift)
+    int32_t limit;                          // 累计值上限 (max_trim << gain_shift)
+    int32_t deadband;                       // 相电流差死区 (mA), 死区内积分保持
+    int32_t error_max;                      // 单步相电流差限幅 (mA)
+    int32_t trim;                           // 当前修正量 (占空比单位)
+    uint8_t gain_shift;                     // 积分增益 2^-gain_shift (占空比单位/mA/步)
+} CMix_Share_t;
+
+/* ========================= 函数声明 ========================= */
+
+void CMix_PID_Init(CMix_PID_Q_t *pid, int32_t kp_q15, int32_t ki_q31, int32_t kd_q15,
+                   int32_t output_min, int32_t output_max);
+void CMix_PID_Reset(CMix_PID_Q_t *pid);
+void CMix_PID_Set_Integral(CMix_PID_Q_t *pid, int32_t value);
+int32_t CMix_PID_Update(CMix_PID_Q_t *pid, int32_t setpoint, int32_t feedback);
+
+void CMix_Recip_Init(CMix_Recip_t *recip, uint32_t min_divisor, uint32_t deadband);
+void CMix_Recip_Update(CMix_Recip_t *recip, uint32_t divisor);
+
+void CMix_Share_Init(CMix_Share_t *share, uint8_t gain_shift, int32_t max_trim, int32_t deadband, int32_t error_max);
+void CMix_Share_Reset(CMix_Share_t *share);
+int32_t CMix_Share_Update(CMix_Share_t *share, int32_t current_a, int32_t current_b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_PID_H */
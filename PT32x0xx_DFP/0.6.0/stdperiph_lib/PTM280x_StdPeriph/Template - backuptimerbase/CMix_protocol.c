@@ -17,6 +17,11 @@
 
 #include "CMix_protocol.h"
 #include "CMix_hardware.h"
+#include "CMix_crc.h"
+#include "CMix_main.h"
+#include "CMix_blackbox.h"
+#include "CMix_telemetry.h"
+#include "CMix_scope.h"
 #include <string.h>
 
 /* ========================= 私有变量 ========================= */
@@ -24,42 +29,16 @@
 static CMix_System_Status_t g_system_status = {0};
 static CMix_System_Parameters_t g_system_parameters = {0};
 static CMix_RX_Buffer_t g_rx_buffer = {0};
+static volatile uint32_t g_rx_last_ms = 0;      // 最近接收字节的系统时间 (ms)
 
-/* Modbus-RTU CRC16查表 */
-static const uint16_t crc16_table[256] = {
-    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
-    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
-    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
-    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
-    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
-    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
-    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
-    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
-    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
-    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
-    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
-    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
-    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
-    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
-    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
-    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
-    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
-    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
-    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
-    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
-    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
-    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
-    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
-    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
-    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
-    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
-    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
-    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
-    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
-    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
-    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
-    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
-};
+#if CMIX_PROTOCOL_DEFERRED_ENABLE
+/* 接收命令队列: 单生产者(UART中断)/单消费者(主循环), 读写位置自由递增 */
+#define CMIX_PROTOCOL_RX_QUEUE_MASK (CMIX_PROTOCOL_RX_QUEUE_DEPTH - 1)
+static CMix_RX_Frame_t g_rx_queue[CMIX_PROTOCOL_RX_QUEUE_DEPTH];
+static volatile uint8_t g_rx_queue_head = 0;    // 写入位置 (仅中断修改)
+static volatile uint8_t g_rx_queue_tail = 0;    // 读取位置 (仅主循环修改)
+static CMix_Protocol_RX_Stats_t g_rx_stats = {0};
+#endif
 
 /* ========================= 私有函数声明 ========================= */
 
@@ -70,6 +49,17 @@ static void CMix_Protocol_Handle_Set_Max_Output_Current(const uint8_t *data, uin
 static void CMix_Protocol_Handle_Set_Max_Output_Power(const uint8_t *data, uint8_t len);
 static void CMix_Protocol_Handle_Query_Status(void);
 static void CMix_Protocol_Handle_Mode_Switch(const uint8_t *data, uint8_t len);
+static void CMix_Protocol_Handle_Task_Stats(const uint8_t *data, uint8_t len);
+#if CMIX_BLACKBOX_ENABLE
+static void CMix_Protocol_Handle_Blackbox_Read(const uint8_t *data, uint8_t len);
+#endif
+#if CMIX_TELEMETRY_ENABLE
+static void CMix_Protocol_Handle_Telemetry(const uint8_t *data, uint8_t len);
+#endif
+#if CMIX_SCOPE_ENABLE
+static void CMix_Protocol_Handle_Scope(const uint8_t *data, uint8_t len);
+#endif
+static void CMix_Protocol_Dispatch_Frame(uint8_t status, uint8_t cmd, const uint8_t *data, uint8_t len);
 
 /* ========================= 公共函数实现 ========================= */
 
@@ -83,10 +73,11 @@ void CMix_Protocol_Init(void)
     /* 初始化系统参数 */
     g_system_parameters.input_voltage_threshold = 60000;    // 60V
     g_system_parameters.output_voltage_threshold = 60000;   // 60V
-    g_system_parameters.max_input_current = 150000;         // 150A
-    g_system_parameters.max_output_current = 150000;        // 150A
+    g_system_parameters.max_input_current = CMIX_A_TO_MA(CMIX_MAX_INPUT_CURRENT);   // 额定输入电流
+    g_system_parameters.max_output_current = CMIX_A_TO_MA(CMIX_MAX_OUTPUT_CURRENT); // 额定输出电流
     g_system_parameters.max_output_power = 450000;          // 450W
     g_system_parameters.working_mode = CMIX_MODE_AUTO;
+    CMix_Protocol_Apply_AWD_Limits();
 
     /* 初始化系统状态 */
     memset(&g_system_status, 0, sizeof(g_system_status));
@@ -106,14 +97,8 @@ void CMix_Protocol_Init(void)
  */
 uint16_t CMix_Protocol_Calculate_CRC16(const uint8_t *data, uint16_t length)
 {
-    uint16_t crc = 0xFFFF;
-    uint16_t i;
-    
-    for (i = 0; i < length; i++) {
-        crc = (crc >> 8) ^ crc16_table[(crc ^ data[i]) & 0xFF];
-    }
-    
-    return crc;
+    /* 硬件CRC单元优先, 不可用时回退查表 (见CMix_crc.c) */
+    return CMix_CRC16_Modbus(data, length);
 }
 
 /**
@@ -127,7 +112,7 @@ void CMix_Protocol_Send_Frame(uint8_t cmd, const uint8_t *data, uint8_t len)
 {
     uint8_t frame_buffer[CMIX_PROTOCOL_MAX_FRAME_LEN];
     uint16_t crc;
-    uint16_t i, frame_len;
+    uint16_t frame_len;
 
     /* 构建帧 */
     frame_buffer[0] = CMIX_PROTOCOL_FRAME_HEADER;
@@ -147,11 +132,9 @@ void CMix_Protocol_Send_Frame(uint8_t cmd, const uint8_t *data, uint8_t len)
     frame_buffer[frame_len] = (uint8_t)(crc & 0xFF);
     frame_buffer[frame_len + 1] = (uint8_t)(crc >> 8);
 
-    /* 发送帧 */
+    /* 整帧写入发送队列 (不阻塞, 队列满时整帧丢弃并计入统计) */
     frame_len += 2;
-    for (i = 0; i < frame_len; i++) {
-        CMix_Hardware_UART_Send_Byte(frame_buffer[i]);
-    }
+    CMix_Hardware_UART_Write(frame_buffer, frame_len);
 }
 
 /**
@@ -161,6 +144,8 @@ void CMix_Protocol_Send_Frame(uint8_t cmd, const uint8_t *data, uint8_t len)
  */
 void CMix_Protocol_Receive_Handler(uint8_t byte)
 {
+    g_rx_last_ms = CMix_Main_Get_System_Tick();
+
     switch (g_rx_buffer.state) {
         case CMIX_RX_STATE_WAIT_HEADER:
             if (byte == CMIX_PROTOCOL_FRAME_HEADER) {
@@ -178,7 +163,13 @@ void CMix_Protocol_Receive_Handler(uint8_t byte)
         case CMIX_RX_STATE_WAIT_LEN:
             g_rx_buffer.buffer[g_rx_buffer.index++] = byte;
             g_rx_buffer.expected_len = byte;
-            if (g_rx_buffer.expected_len == 0) {
+            if (g_rx_buffer.expected_len > CMIX_PROTOCOL_MAX_DATA_LEN) {
+                /* 长度超限: 丢弃本帧, 防止接收缓冲越界 */
+                CMix_Protocol_Dispatch_Frame(CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN,
+                                             g_rx_buffer.buffer[1], NULL, 0);
+                g_rx_buffer.state = CMIX_RX_STATE_WAIT_HEADER;
+                g_rx_buffer.index = 0;
+            } else if (g_rx_buffer.expected_len == 0) {
                 g_rx_buffer.state = CMIX_RX_STATE_WAIT_CRC_LOW;
             } else {
                 g_rx_buffer.state = CMIX_RX_STATE_WAIT_DATA;
@@ -214,9 +205,9 @@ void CMix_Protocol_Receive_Handler(uint8_t byte)
                 calculated_crc = CMix_Protocol_Calculate_CRC16(g_rx_buffer.buffer, crc_index);
 
                 if (received_crc == calculated_crc) {
-                    CMix_Protocol_Process_Command(cmd, data, len);
+                    CMix_Protocol_Dispatch_Frame(CMIX_PROTOCOL_ERROR_OK, cmd, data, len);
                 } else {
-                    CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_CRC_FAILED);
+                    CMix_Protocol_Dispatch_Frame(CMIX_PROTOCOL_ERROR_CRC_FAILED, cmd, NULL, 0);
                 }
             }
 
@@ -270,12 +261,107 @@ void CMix_Protocol_Process_Command(uint8_t cmd, const uint8_t *data, uint8_t len
             CMix_Protocol_Handle_Mode_Switch(data, len);
             break;
 
+        case CMIX_CMD_TASK_STATS:
+            CMix_Protocol_Handle_Task_Stats(data, len);
+            break;
+
+#if CMIX_BLACKBOX_ENABLE
+        case CMIX_CMD_BLACKBOX_READ:
+            CMix_Protocol_Handle_Blackbox_Read(data, len);
+            break;
+#endif
+
+#if CMIX_TELEMETRY_ENABLE
+        case CMIX_CMD_TELEMETRY:
+            CMix_Protocol_Handle_Telemetry(data, len);
+            break;
+#endif
+
+#if CMIX_SCOPE_ENABLE
+        case CMIX_CMD_SCOPE:
+            CMix_Protocol_Handle_Scope(data, len);
+            break;
+#endif
+
         default:
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_INVALID_CMD);
             break;
     }
 }
 
+/**
+ * @brief CMix执行接收队列中的命令 (主循环调用)
+ * @param max_frames: 本次最多执行的帧数
+ * @retval 实际执行的帧数
+ * @note  命令处理和应答均在主循环上下文完成, 接收中断只做校验和入队
+ */
+uint8_t CMix_Protocol_Process_Pending(uint8_t max_frames)
+{
+#if CMIX_PROTOCOL_DEFERRED_ENABLE
+    uint8_t count = 0;
+
+    while (count < max_frames && g_rx_queue_tail != g_rx_queue_head) {
+        const CMix_RX_Frame_t *frame = &g_rx_queue[g_rx_queue_tail & CMIX_PROTOCOL_RX_QUEUE_MASK];
+
+        if (frame->status == CMIX_PROTOCOL_ERROR_OK) {
+            CMix_Protocol_Process_Command(frame->cmd, (frame->len > 0) ? frame->data : NULL, frame->len);
+        } else {
+            CMix_Protocol_Send_ACK_Error((CMix_Protocol_Error_t)frame->status);
+        }
+
+        /* 帧处理完毕后才释放槽位 */
+        __DMB();
+        g_rx_queue_tail++;
+        g_rx_stats.frames_processed++;
+        count++;
+    }
+
+    return count;
+#else
+    (void)max_frames;
+    return 0;
+#endif
+}
+
+/**
+ * @brief CMix接收队列中是否有待执行的命令
+ * @param None
+ * @retval true=有待执行命令
+ */
+bool CMix_Protocol_Has_Pending(void)
+{
+#if CMIX_PROTOCOL_DEFERRED_ENABLE
+    return (g_rx_queue_head != g_rx_queue_tail);
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief CMix获取接收命令队列统计
+ * @param stats: 统计输出指针
+ * @retval None
+ */
+void CMix_Protocol_Get_RX_Stats(CMix_Protocol_RX_Stats_t *stats)
+{
+#if CMIX_PROTOCOL_DEFERRED_ENABLE
+    *stats = g_rx_stats;
+    stats->depth = (uint8_t)(g_rx_queue_head - g_rx_queue_tail);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/**
+ * @brief CMix获取通信空闲时间
+ * @param None
+ * @retval 距最近一个接收字节的时间 (ms), 上电后未接收时为运行时间
+ */
+uint32_t CMix_Protocol_Get_RX_Idle_ms(void)
+{
+    return CMix_Main_Get_System_Tick() - g_rx_last_ms;
+}
+
 /**
  * @brief CMix发送状态上报
  * @param None
@@ -334,6 +420,58 @@ CMix_System_Parameters_t* CMix_Protocol_Get_System_Parameters(void)
 
 /* ========================= 私有函数实现 ========================= */
 
+/**
+ * @brief 分发接收完成的帧 (接收中断调用)
+ * @param status: 接收结果, 非OK时只回复错误码
+ * @param cmd: 命令字
+ * @param data: 数据指针
+ * @param len: 数据长度
+ * @retval None
+ * @note  延迟执行模式下只入队, 队列满时丢弃并计数
+ */
+static void CMix_Protocol_Dispatch_Frame(uint8_t status, uint8_t cmd, const uint8_t *data, uint8_t len)
+{
+#if CMIX_PROTOCOL_DEFERRED_ENABLE
+    uint8_t head = g_rx_queue_head;
+    uint8_t depth = (uint8_t)(head - g_rx_queue_tail);
+    CMix_RX_Frame_t *frame;
+
+    if (status == CMIX_PROTOCOL_ERROR_CRC_FAILED) {
+        g_rx_stats.crc_errors++;
+    } else if (status == CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN) {
+        g_rx_stats.length_errors++;
+    }
+
+    if (depth >= CMIX_PROTOCOL_RX_QUEUE_DEPTH) {
+        g_rx_stats.frames_dropped++;
+        return;
+    }
+
+    frame = &g_rx_queue[head & CMIX_PROTOCOL_RX_QUEUE_MASK];
+    frame->cmd = cmd;
+    frame->len = len;
+    frame->status = status;
+    if (len > 0 && data != NULL) {
+        memcpy(frame->data, data, len);
+    }
+
+    /* 帧内容写完后才发布 */
+    __DMB();
+    g_rx_queue_head = (uint8_t)(head + 1);
+
+    g_rx_stats.frames_received++;
+    if (depth + 1 > g_rx_stats.high_water) {
+        g_rx_stats.high_water = depth + 1;
+    }
+#else
+    if (status == CMIX_PROTOCOL_ERROR_OK) {
+        CMix_Protocol_Process_Command(cmd, data, len);
+    } else {
+        CMix_Protocol_Send_ACK_Error((CMix_Protocol_Error_t)status);
+    }
+#endif
+}
+
 /**
  * @brief 处理设置输入电压阈值命令
  * @param data: 数据指针
@@ -346,6 +484,7 @@ static void CMix_Protocol_Handle_Set_Input_Voltage(const uint8_t *data, uint8_t
         uint32_t voltage = (uint32_t)data[0] | ((uint32_t)data[1] << 8);
         if (voltage >= 10000 && voltage <= 100000) { // 10V~100V
             g_system_parameters.input_voltage_threshold = voltage;
+            CMix_Main_Save_Parameters();
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_OK);
         } else {
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
@@ -367,6 +506,8 @@ static void CMix_Protocol_Handle_Set_Output_Voltage(const uint8_t *data, uint8_t
         uint32_t voltage = (uint32_t)data[0] | ((uint32_t)data[1] << 8);
         if (voltage >= 5000 && voltage <= 100000) { // 5V~100V
             g_system_parameters.output_voltage_threshold = voltage;
+            CMix_Protocol_Apply_AWD_Limits();
+            CMix_Main_Save_Parameters();
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_OK);
         } else {
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
@@ -388,6 +529,8 @@ static void CMix_Protocol_Handle_Set_Max_Input_Current(const uint8_t *data, uint
         uint32_t current = (uint32_t)data[0] | ((uint32_t)data[1] << 8);
         if (current >= 1000 && current <= 65535) { // 1A~65.535A (受16位限制)
             g_system_parameters.max_input_current = current;
+            CMix_Protocol_Apply_AWD_Limits();
+            CMix_Main_Save_Parameters();
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_OK);
         } else {
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
@@ -409,6 +552,8 @@ static void CMix_Protocol_Handle_Set_Max_Output_Current(const uint8_t *data, uin
         uint32_t current = (uint32_t)data[0] | ((uint32_t)data[1] << 8);
         if (current >= 1000 && current <= 65535) { // 1A~65.535A (受16位限制)
             g_system_parameters.max_output_current = current;
+            CMix_Protocol_Apply_AWD_Limits();
+            CMix_Main_Save_Parameters();
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_OK);
         } else {
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
@@ -430,6 +575,7 @@ static void CMix_Protocol_Handle_Set_Max_Output_Power(const uint8_t *data, uint8
         uint32_t power = (uint32_t)data[0] | ((uint32_t)data[1] << 8);
         if (power >= 10000 && power <= 65535) { // 10W~65.535W (受16位限制)
             g_system_parameters.max_output_power = power;
+            CMix_Main_Save_Parameters();
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_OK);
         } else {
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
@@ -439,6 +585,28 @@ static void CMix_Protocol_Handle_Set_Max_Output_Power(const uint8_t *data, uint8
     }
 }
 
+/**
+ * @brief 按系统参数设置ADC模拟看门狗窗口
+ * @param None
+ * @retval None
+ * @note  输入电流对应相A, 输出电流对应相B (与CMix_Hardware_Get_Current_Sensors一致);
+ *        Vin过压由CMP1刹车保护, 不在模拟看门狗轮转中;
+ *        电流限值先限幅到采样量程 (±CMIX_ADC_CURRENT_LIMIT_MA) 并回写,
+ *        超量程的限值 (如旧参数区中的值) 无法被采样判定, 不能原样保留
+ */
+void CMix_Protocol_Apply_AWD_Limits(void)
+{
+    if (g_system_parameters.max_input_current > CMIX_ADC_CURRENT_LIMIT_MA) {
+        g_system_parameters.max_input_current = CMIX_ADC_CURRENT_LIMIT_MA;
+    }
+    if (g_system_parameters.max_output_current > CMIX_ADC_CURRENT_LIMIT_MA) {
+        g_system_parameters.max_output_current = CMIX_ADC_CURRENT_LIMIT_MA;
+    }
+    CMix_Hardware_ADC_AWD_Set_Current_Limit(CMIX_ADC_CURRENT_A_CHANNEL, g_system_parameters.max_input_current);
+    CMix_Hardware_ADC_AWD_Set_Voltage_Limit(CMIX_ADC_VOUT_CHANNEL, g_system_parameters.output_voltage_threshold);
+    CMix_Hardware_ADC_AWD_Set_Current_Limit(CMIX_ADC_CURRENT_B_CHANNEL, g_system_parameters.max_output_current);
+}
+
 /**
  * @brief 处理查询状态命令
  * @param None
@@ -462,6 +630,7 @@ static void CMix_Protocol_Handle_Mode_Switch(const uint8_t *data, uint8_t len)
         if (mode <= CMIX_MODE_AUTO) {
             g_system_parameters.working_mode = mode;
             g_system_status.working_mode = mode;
+            CMix_Main_Save_Parameters();
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_OK);
         } else {
             CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
@@ -471,6 +640,223 @@ static void CMix_Protocol_Handle_Mode_Switch(const uint8_t *data, uint8_t len)
     }
 }
 
+/**
+ * @brief 处理任务统计查询命令
+ * @param data: 数据指针 (data[0]=任务序号, 可选data[1]!=0表示应答后清除统计)
+ * @param len: 数据长度
+ * @retval None
+ * @note  应答帧(小端): 序号(1) 任务数(1) CPU使用率(1) 周期ms(2) 截止us(2)
+ *        执行次数(4) 超时次数(4) 跳过次数(4) 最小/平均/最大周期数(4*3) 每毫秒周期数(4)
+ */
+static void CMix_Protocol_Handle_Task_Stats(const uint8_t *data, uint8_t len)
+{
+    const CMix_Task_t *task;
+    CMix_Task_Scheduler_t *scheduler;
+    uint8_t reply[41];
+    uint8_t index = 0;
+    uint32_t values[7];
+    uint8_t i;
+
+    if (len != 1 && len != 2) {
+        CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN);
+        return;
+    }
+
+    task = CMix_Main_Get_Task(data[0]);
+    if (task == NULL) {
+        CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
+        return;
+    }
+    scheduler = CMix_Main_Get_Task_Scheduler();
+
+    reply[index++] = data[0];
+    reply[index++] = CMix_Main_Get_Task_Count();
+    reply[index++] = scheduler->cpu_usage;
+    reply[index++] = task->period_ms & 0xFF;
+    reply[index++] = (task->period_ms >> 8) & 0xFF;
+    reply[index++] = task->deadline_us & 0xFF;
+    reply[index++] = (task->deadline_us >> 8) & 0xFF;
+
+    values[0] = task->stats.run_count;
+    values[1] = task->stats.overrun_count;
+    values[2] = task->stats.skipped_count;
+    values[3] = task->stats.exec_min_cycles;
+    values[4] = task->stats.exec_avg_cycles;
+    values[5] = task->stats.exec_max_cycles;
+    values[6] = scheduler->cycles_per_ms;
+    for (i = 0; i < 7; i++) {
+        reply[index++] = values[i] & 0xFF;
+        reply[index++] = (values[i] >> 8) & 0xFF;
+        reply[index++] = (values[i] >> 16) & 0xFF;
+        reply[index++] = (values[i] >> 24) & 0xFF;
+    }
+
+    CMix_Protocol_Send_Frame(CMIX_CMD_TASK_STATS, reply, index);
+
+    if (len == 2 && data[1] != 0) {
+        CMix_Main_Reset_Task_Stats();
+    }
+}
+
+#if CMIX_BLACKBOX_ENABLE
+/**
+ * @brief 处理故障快照读出命令
+ * @param data: 数据指针 (data[0]=块序号, 0xFF表示清除快照区)
+ * @param len: 数据长度
+ * @retval None
+ * @note  应答帧: 块序号(1) 块数(1) 快照数据(不超过CMIX_BLACKBOX_CHUNK_BYTES, Flash原样).
+ *        无快照时块0的应答块数为0且不带数据; 快照写入中应答系统忙.
+ *        清除在后台擦除, 应答OK后读出块数即为0
+ */
+static void CMix_Protocol_Handle_Blackbox_Read(const uint8_t *data, uint8_t len)
+{
+    uint8_t reply[2 + CMIX_BLACKBOX_CHUNK_BYTES];
+    uint8_t count;
+
+    if (len != 1) {
+        CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN);
+        return;
+    }
+
+    if (data[0] == 0xFF) {
+        CMix_Protocol_Send_ACK_Error(CMix_Blackbox_Clear() ? CMIX_PROTOCOL_ERROR_OK : CMIX_PROTOCOL_ERROR_SYSTEM_BUSY);
+        return;
+    }
+
+    count = CMix_Blackbox_Get_Chunk_Count();
+    if (count == 0 && CMix_Blackbox_Is_Busy()) {
+        CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_SYSTEM_BUSY);
+        return;
+    }
+    if (data[0] >= count && data[0] != 0) {
+        CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
+        return;
+    }
+
+    reply[0] = data[0];
+    reply[1] = count;
+    CMix_Protocol_Send_Frame(CMIX_CMD_BLACKBOX_READ, reply, (uint8_t)(2 + CMix_Blackbox_Read_Chunk(data[0], &reply[2])));
+}
+#endif
+
+#if CMIX_TELEMETRY_ENABLE
+/**
+ * @brief 处理遥测流订阅命令
+ * @param data: 数据指针 (N个 信号ID(1) + 分频(2, 小端), 为空时停止)
+ * @param len: 数据长度
+ * @retval None
+ * @note  应答OK之后发出的遥测帧都属于新订阅 (帧序号从0开始)
+ */
+static void CMix_Protocol_Handle_Telemetry(const uint8_t *data, uint8_t len)
+{
+    CMix_Protocol_Send_ACK_Error(CMix_Telemetry_Subscribe(data, len));
+}
+#endif
+
+#if CMIX_SCOPE_ENABLE
+/**
+ * @brief 处理片内示波器命令
+ * @param data: 数据指针, data[0]为子命令:
+ *        0x00 启动: 探针ID x4 (0xFF = 不用, 用到的通道须连续) + 触发通道(1) + 触发条件(1)
+ *             + 触发阈值(2, 小端) + 触发前百分比(1) + 分频(2, 小端), 应答ACK
+ *        0x01 状态: 回复 0x01 + 状态(1) + 通道数(1) + 块数(1) + 触发前组数(2) + 深度(2) + 分频(2)
+ *        0x02 强制触发: 应答ACK, 未启动时为参数超出范围
+ *        0x03 读出: 块序号(1), 回复 0x03 + 块序号(1) + 块数(1) + 数据; 未冻结时应答忙
+ *        0x04 停止: 应答ACK
+ * @param len: 数据长度
+ * @retval None
+ */
+static void CMix_Protocol_Handle_Scope(const uint8_t *data, uint8_t len)
+{
+    uint8_t reply[3 + CMIX_SCOPE_CHUNK_BYTES];
+    CMix_Scope_Config_t config;
+    CMix_Scope_Status_t status;
+    uint8_t i;
+
+    if (len == 0) {
+        CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN);
+        return;
+    }
+
+    switch (data[0]) {
+        case 0x00:
+            if (len != 12) {
+                CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN);
+                return;
+            }
+            config.channels = 0;
+            for (i = 0; i < CMIX_SCOPE_CHANNELS && data[1 + i] != 0xFF; i++) {
+                config.probe[i] = data[1 + i];
+                config.channels++;
+            }
+            for (; i < 4; i++) {
+                if (data[1 + i] != 0xFF) {
+                    config.channels = 0;                // 通道不连续或超过CMIX_SCOPE_CHANNELS
+                }
+            }
+            config.trigger_channel = data[5];
+            config.trigger_mode = data[6];
+            config.trigger_level = (uint16_t)(data[7] | (data[8] << 8));
+            config.pre_percent = data[9];
+            config.divisor = (uint16_t)(data[10] | (data[11] << 8));
+            CMix_Protocol_Send_ACK_Error(CMix_Scope_Arm(&config));
+            break;
+
+        case 0x01:
+            if (len != 1) {
+                CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN);
+                return;
+            }
+            CMix_Scope_Get_Status(&status);
+            reply[0] = 0x01;
+            reply[1] = status.state;
+            reply[2] = status.channels;
+            reply[3] = status.chunks;
+            reply[4] = (uint8_t)(status.pre_samples & 0xFF);
+            reply[5] = (uint8_t)(status.pre_samples >> 8);
+            reply[6] = (uint8_t)(status.depth & 0xFF);
+            reply[7] = (uint8_t)(status.depth >> 8);
+            reply[8] = (uint8_t)(status.divisor & 0xFF);
+            reply[9] = (uint8_t)(status.divisor >> 8);
+            CMix_Protocol_Send_Frame(CMIX_CMD_SCOPE, reply, 10);
+            break;
+
+        case 0x02:
+            CMix_Protocol_Send_ACK_Error(CMix_Scope_Force() ? CMIX_PROTOCOL_ERROR_OK : CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
+            break;
+
+        case 0x03:
+            if (len != 2) {
+                CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN);
+                return;
+            }
+            CMix_Scope_Get_Status(&status);
+            if (status.state != CMIX_SCOPE_DONE) {
+                CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_SYSTEM_BUSY);
+                return;
+            }
+            if (data[1] >= status.chunks) {
+                CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
+                return;
+            }
+            reply[0] = 0x03;
+            reply[1] = data[1];
+            reply[2] = status.chunks;
+            CMix_Protocol_Send_Frame(CMIX_CMD_SCOPE, reply, (uint8_t)(3 + CMix_Scope_Read_Chunk(data[1], &reply[3])));
+            break;
+
+        case 0x04:
+            CMix_Scope_Stop();
+            CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_OK);
+            break;
+
+        default:
+            CMix_Protocol_Send_ACK_Error(CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE);
+            break;
+    }
+}
+#endif
+
 /**
  * @brief CMix协议测试发送命令
  * @param None
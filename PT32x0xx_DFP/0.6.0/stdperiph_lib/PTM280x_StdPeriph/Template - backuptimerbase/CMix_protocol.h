@@ -37,7 +37,12 @@ typedef enum {
     CMIX_CMD_MODE_SWITCH            = 0x08,     // 模式切换
     CMIX_CMD_ACK_ERROR              = 0x09,     // ACK/错误码
     CMIX_CMD_DEBUG_INFO             = 0x0A,     // 调试信息输出
-    CMIX_CMD_SYSTEM_INFO            = 0x0B      // 系统信息上报
+    CMIX_CMD_SYSTEM_INFO            = 0x0B,     // 系统信息上报
+    CMIX_CMD_TASK_STATS             = 0x0C,     // 任务执行统计查询/上报
+    CMIX_CMD_BLACKBOX_READ          = 0x0D,     // 故障快照分块读出/清除
+    CMIX_CMD_TRACE                  = 0x0E,     // 跟踪记录 (格式ID+原始参数, 见CMix_trace.h)
+    CMIX_CMD_TELEMETRY              = 0x0F,     // 遥测流订阅/数据帧 (见CMix_telemetry.h)
+    CMIX_CMD_SCOPE                  = 0x10      // 片内示波器设置/状态/读出 (见CMix_scope.h)
 } CMix_Protocol_Command_t;
 
 /* 协议错误码 */
@@ -80,6 +85,25 @@ typedef struct {
     CMix_RX_State_t state;                       // 接收状态机状态
 } CMix_RX_Buffer_t;
 
+/* 已接收命令帧 (接收中断入队, 主循环执行) */
+typedef struct {
+    uint8_t cmd;                            // 命令字
+    uint8_t len;                            // 数据长度
+    uint8_t status;                         // 接收结果 (CMix_Protocol_Error_t, 非OK时仅回复错误码)
+    uint8_t data[CMIX_PROTOCOL_MAX_DATA_LEN]; // 数据
+} CMix_RX_Frame_t;
+
+/* 接收命令队列统计 */
+typedef struct {
+    uint32_t frames_received;               // 已入队帧数 (含校验失败帧)
+    uint32_t frames_processed;              // 已执行帧数
+    uint32_t frames_dropped;                // 队列满丢弃帧数
+    uint32_t crc_errors;                    // CRC校验失败次数
+    uint32_t length_errors;                 // 数据长度超限次数
+    uint8_t  depth;                         // 当前队列深度
+    uint8_t  high_water;                    // 队列最大深度
+} CMix_Protocol_RX_Stats_t;
+
 /* 系统状态结构体 */
 typedef struct {
     uint16_t input_voltage;                 // 输入电压 (mV)
@@ -112,6 +136,10 @@ uint16_t CMix_Protocol_Calculate_CRC16(const uint8_t *data, uint16_t length);
 void CMix_Protocol_Send_Frame(uint8_t cmd, const uint8_t *data, uint8_t len);
 void CMix_Protocol_Receive_Handler(uint8_t byte);
 void CMix_Protocol_Process_Command(uint8_t cmd, const uint8_t *data, uint8_t len);
+uint8_t CMix_Protocol_Process_Pending(uint8_t max_frames);
+bool CMix_Protocol_Has_Pending(void);
+void CMix_Protocol_Get_RX_Stats(CMix_Protocol_RX_Stats_t *stats);
+uint32_t CMix_Protocol_Get_RX_Idle_ms(void);
 
 /* 状态和参数管理 */
 void CMix_Protocol_Send_Status_Report(void);
@@ -124,6 +152,7 @@ void CMix_Protocol_Send_System_Info(uint32_t system_clock, bool clock_ok, const
 /* 系统状态和参数访问 */
 CMix_System_Status_t* CMix_Protocol_Get_System_Status(void);
 CMix_System_Parameters_t* CMix_Protocol_Get_System_Parameters(void);
+void CMix_Protocol_Apply_AWD_Limits(void);
 
 /* 协议测试和调试 */
 void CMix_Protocol_Test_Send_Commands(void);
@@ -0,0 +1,275 @@
+/******************************************************************************
+  * @file    CMix_scope.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix片内示波器模块实现文件
+  *          实现采集设置、控制中断触发判断和冻结后分块读出
+  ******************************************************************************
+  * @attention
+  *
+  * CMix片内示波器模块实现
+  * state是控制中断与主循环之间唯一的握手: 主循环在关中断下写好设置后置为
+  * ARMED; 控制中断在ARMED/TRIGGERED时写缓冲, 采满后置为DONE, 之后不再访问
+  * 缓冲; 主循环只在DONE时读缓冲. 缓冲是深度为depth组的环, 冻结时写入位置
+  * 即最早一组.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_scope.h"
+#include "CMix_main.h"
+
+#if CMIX_SCOPE_ENABLE
+
+/* ========================= 私有定义 ========================= */
+
+/* 示波器运行状态 */
+typedef struct {
+    volatile uint8_t state;                 // CMix_Scope_State_t
+    volatile bool force;                    // 强制触发请求
+    uint8_t probe[CMIX_SCOPE_CHANNELS];
+    uint8_t channels;
+    uint8_t trigger_channel;
+    uint8_t trigger_mode;
+    bool trigger_signed;                    // 触发通道探针为有符号
+    bool has_last;                          // last有效 (沿触发需要上一组)
+    int32_t trigger_level;                  // 阈值 (按触发通道有无符号扩展)
+    int32_t last;                           // 触发通道上一组的值
+    uint16_t divisor;
+    uint16_t countdown;                     // 距下一组的控制步数
+    uint16_t depth;                         // 记录深度 (组)
+    uint16_t pre_samples;                   // 触发样本之前的组数
+    uint16_t filled;                        // 启动后已写入的组数 (到pre_samples为止)
+    uint16_t position;                      // 下一组的写入位置 (组)
+    uint16_t post_remaining;                // 触发后还需采集的组数
+    uint32_t trigger_ms;
+    uint32_t captures;
+} CMix_Scope_t;
+
+/* ========================= 私有变量 ========================= */
+
+static uint16_t g_scope_buffer[CMIX_SCOPE_BUFFER_SAMPLES];
+static CMix_Scope_t g_scope;
+
+/* ========================= 私有函数声明 ========================= */
+
+static uint16_t CMix_Scope_Record_Bytes(void);
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 设置并启动一次采集 (替换当前采集, 缓冲中未读出的记录丢弃)
+ * @param config: 采集设置
+ * @retval 协议错误码: 通道数、探针ID、触发通道、触发条件、触发前比例或分频非法时为参数超出范围
+ */
+CMix_Protocol_Error_t CMix_Scope_Arm(const CMix_Scope_Config_t *config)
+{
+    uint32_t primask;
+    uint16_t depth, pre;
+    uint8_t i, trigger_probe;
+
+    if (config->channels == 0 || config->channels > CMIX_SCOPE_CHANNELS ||
+        config->trigger_channel >= config->channels || config->trigger_mode >= CMIX_SCOPE_TRIGGER_COUNT ||
+        config->pre_percent > 100 || config->divisor == 0) {
+        return CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE;
+    }
+    for (i = 0; i < config->channels; i++) {
+        if (config->probe[i] >= CMIX_PROBE_COUNT) {
+            return CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE;
+        }
+    }
+
+    depth = (uint16_t)(CMIX_SCOPE_BUFFER_SAMPLES / config->channels);
+    pre = (uint16_t)((uint32_t)depth * config->pre_percent / 100);
+    if (pre >= depth) {
+        pre = depth - 1;                                // 触发样本本身占一组
+    }
+    trigger_probe = config->probe[config->trigger_channel];
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    g_scope.state = CMIX_SCOPE_IDLE;
+    for (i = 0; i < config->channels; i++) {
+        g_scope.probe[i] = config->probe[i];
+    }
+    g_scope.channels = config->channels;
+    g_scope.trigger_channel = config->trigger_channel;
+    g_scope.trigger_mode = config->trigger_mode;
+    g_scope.trigger_signed = CMIX_PROBE_IS_SIGNED(trigger_probe);
+    g_scope.trigger_level = g_scope.trigger_signed ? (int32_t)(int16_t)config->trigger_level
+                                                   : (int32_t)config->trigger_level;
+    g_scope.has_last = false;
+    g_scope.force = false;
+    g_scope.divisor = config->divisor;
+    g_scope.countdown = 1;                              // 下一个控制步采第一组
+    g_scope.depth = depth;
+    g_scope.pre_samples = pre;
+    g_scope.filled = 0;
+    g_scope.position = 0;
+    g_scope.state = CMIX_SCOPE_ARMED;
+    __set_PRIMASK(primask);
+
+    return CMIX_PROTOCOL_ERROR_OK;
+}
+
+/**
+ * @brief 强制触发: 触发前样本采满后的第一组即为触发样本
+ * @param None
+ * @retval true = 已启动且未触发
+ */
+bool CMix_Scope_Force(void)
+{
+    if (g_scope.state != CMIX_SCOPE_ARMED) {
+        return false;
+    }
+    g_scope.force = true;
+    return true;
+}
+
+/**
+ * @brief 停止采集 (缓冲中的记录丢弃)
+ * @param None
+ * @retval None
+ */
+void CMix_Scope_Stop(void)
+{
+    g_scope.state = CMIX_SCOPE_IDLE;
+}
+
+/**
+ * @brief 写入一组样本并判断触发
+ * @param None
+ * @retval None
+ * @note  控制步结束时调用; 未启动或已冻结时只有一次比较
+ */
+void CMix_Scope_Capture(void)
+{
+    uint8_t state = g_scope.state;
+    uint16_t *sample;
+    int32_t value;
+    bool hit;
+    uint8_t i;
+
+    if (state != CMIX_SCOPE_ARMED && state != CMIX_SCOPE_TRIGGERED) {
+        return;
+    }
+    if (--g_scope.countdown != 0) {
+        return;
+    }
+    g_scope.countdown = g_scope.divisor;
+
+    sample = &g_scope_buffer[(uint32_t)g_scope.position * g_scope.channels];
+    for (i = 0; i < g_scope.channels; i++) {
+        sample[i] = CMix_DCDC_Probe(g_scope.probe[i]);
+    }
+    if (++g_scope.position == g_scope.depth) {
+        g_scope.position = 0;
+    }
+
+    if (state == CMIX_SCOPE_TRIGGERED) {
+        if (--g_scope.post_remaining == 0) {
+            g_scope.captures++;
+            g_scope.state = CMIX_SCOPE_DONE;
+        }
+        return;
+    }
+
+    /* 采满触发前样本后才判断触发 */
+    value = g_scope.trigger_signed ? (int32_t)(int16_t)sample[g_scope.trigger_channel]
+                                   : (int32_t)sample[g_scope.trigger_channel];
+    if (g_scope.filled < g_scope.pre_samples) {
+        g_scope.filled++;
+    } else {
+        switch (g_scope.trigger_mode) {
+            case CMIX_SCOPE_TRIGGER_RISING:
+                hit = g_scope.has_last && g_scope.last < g_scope.trigger_level && value >= g_scope.trigger_level;
+                break;
+            case CMIX_SCOPE_TRIGGER_FALLING:
+                hit = g_scope.has_last && g_scope.last > g_scope.trigger_level && value <= g_scope.trigger_level;
+                break;
+            case CMIX_SCOPE_TRIGGER_ABOVE:
+                hit = value > g_scope.trigger_level;
+                break;
+            default:
+                hit = value < g_scope.trigger_level;
+                break;
+        }
+        if (hit || g_scope.force) {
+            g_scope.trigger_ms = CMix_Main_Get_System_Tick();
+            g_scope.post_remaining = (uint16_t)(g_scope.depth - g_scope.pre_samples - 1);
+            if (g_scope.post_remaining == 0) {
+                g_scope.captures++;
+                g_scope.state = CMIX_SCOPE_DONE;
+            } else {
+                g_scope.state = CMIX_SCOPE_TRIGGERED;
+            }
+        }
+    }
+    g_scope.last = value;
+    g_scope.has_last = true;
+}
+
+/**
+ * @brief 获取示波器状态
+ * @param status: 状态输出
+ * @retval None
+ */
+void CMix_Scope_Get_Status(CMix_Scope_Status_t *status)
+{
+    status->state = g_scope.state;
+    status->channels = g_scope.channels;
+    status->chunks = (status->state == CMIX_SCOPE_DONE) ?
+                     (uint8_t)((CMix_Scope_Record_Bytes() + CMIX_SCOPE_CHUNK_BYTES - 1) / CMIX_SCOPE_CHUNK_BYTES) : 0;
+    status->reserved = 0;
+    status->depth = g_scope.depth;
+    status->pre_samples = g_scope.pre_samples;
+    status->divisor = g_scope.divisor;
+    status->trigger_ms = g_scope.trigger_ms;
+    status->captures = g_scope.captures;
+}
+
+/**
+ * @brief 读出一块记录 (按时间顺序展开环)
+ * @param index: 块序号
+ * @param buffer: 输出 (不小于CMIX_SCOPE_CHUNK_BYTES)
+ * @retval 本块字节数, 未冻结或序号超出时为0
+ */
+uint8_t CMix_Scope_Read_Chunk(uint8_t index, uint8_t *buffer)
+{
+    uint16_t total = CMix_Scope_Record_Bytes();
+    uint16_t offset = (uint16_t)index * CMIX_SCOPE_CHUNK_BYTES;
+    uint16_t length, word, group, i;
+    uint16_t value;
+
+    if (g_scope.state != CMIX_SCOPE_DONE || offset >= total) {
+        return 0;
+    }
+    length = (total - offset < CMIX_SCOPE_CHUNK_BYTES) ? (uint16_t)(total - offset) : CMIX_SCOPE_CHUNK_BYTES;
+
+    for (i = 0; i < length; i++) {
+        word = (uint16_t)((offset + i) >> 1);
+        group = (uint16_t)(g_scope.position + word / g_scope.channels);
+        if (group >= g_scope.depth) {
+            group -= g_scope.depth;
+        }
+        value = g_scope_buffer[(uint32_t)group * g_scope.channels + word % g_scope.channels];
+        buffer[i] = (((offset + i) & 1) != 0) ? (uint8_t)(value >> 8) : (uint8_t)(value & 0xFF);
+    }
+    return (uint8_t)length;
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 一次记录的字节数
+ * @param None
+ * @retval 深度 * 通道数 * 2
+ */
+static uint16_t CMix_Scope_Record_Bytes(void)
+{
+    return (uint16_t)(g_scope.depth * g_scope.channels * 2);
+}
+
+#endif /* CMIX_SCOPE_ENABLE */
@@ -0,0 +1,99 @@
+/******************************************************************************
+  * @file    CMix_scope.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix片内示波器模块头文件
+  *          控制中断按触发条件采集内部信号到RAM缓冲, 上位机分块读出
+  ******************************************************************************
+  * @attention
+  *
+  * CMix片内示波器模块
+  * 设置: 上位机选择1至CMIX_SCOPE_CHANNELS个探针 (CMix_DCDC_Probe_t)、触发通道
+  * 与条件 (上升沿/下降沿/高于/低于阈值, 阈值按该探针的有无符号比较)、触发前
+  * 比例和采样分频后启动. 缓冲深度 = CMIX_SCOPE_BUFFER_SAMPLES / 通道数.
+  *
+  * 采集: 控制步结束时每"分频"个控制步写入一组样本. 采满触发前样本后才判断
+  * 触发; 触发样本之后再采集 深度-触发前样本数-1 组即冻结, 缓冲中恰好是以
+  * 触发样本为第(触发前样本数)组的一整段记录. 强制触发在触发前样本采满后生效.
+  *
+  * 读出: 冻结后按CMIX_SCOPE_CHUNK_BYTES分块读出, 数据按时间顺序, 每组为各通道
+  * 的16位值 (小端, 按通道顺序).
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_SCOPE_H
+#define __CMIX_SCOPE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CMix_config.h"
+#include "CMix_dcdc.h"
+#include "CMix_protocol.h"
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 示波器状态 */
+typedef enum {
+    CMIX_SCOPE_IDLE = 0,                    // 未启动
+    CMIX_SCOPE_ARMED,                       // 已启动, 采集触发前样本/等待触发
+    CMIX_SCOPE_TRIGGERED,                   // 已触发, 采集触发后样本
+    CMIX_SCOPE_DONE                         // 采集完成, 缓冲冻结待读出
+} CMix_Scope_State_t;
+
+/* 触发条件 */
+typedef enum {
+    CMIX_SCOPE_TRIGGER_RISING = 0,          // 上一组 < 阈值 且 本组 >= 阈值
+    CMIX_SCOPE_TRIGGER_FALLING,             // 上一组 > 阈值 且 本组 <= 阈值
+    CMIX_SCOPE_TRIGGER_ABOVE,               // 本组 > 阈值
+    CMIX_SCOPE_TRIGGER_BELOW,               // 本组 < 阈值
+    CMIX_SCOPE_TRIGGER_COUNT
+} CMix_Scope_Trigger_t;
+
+/* 采集设置 */
+typedef struct {
+    uint8_t  probe[CMIX_SCOPE_CHANNELS];    // 各通道探针ID
+    uint8_t  channels;                      // 通道数 (1至CMIX_SCOPE_CHANNELS)
+    uint8_t  trigger_channel;               // 触发通道
+    uint8_t  trigger_mode;                  // 触发条件 (CMix_Scope_Trigger_t)
+    uint8_t  pre_percent;                   // 触发前样本占深度的百分比 (0-100)
+    uint16_t trigger_level;                 // 触发阈值 (与探针同一编码)
+    uint16_t divisor;                       // 采样分频 (控制步, >= 1)
+} CMix_Scope_Config_t;
+
+/* 示波器状态查询 */
+typedef struct {
+    uint8_t  state;                         // CMix_Scope_State_t
+    uint8_t  channels;                      // 通道数
+    uint8_t  chunks;                        // 可读出的块数 (冻结前为0)
+    uint8_t  reserved;
+    uint16_t depth;                         // 记录深度 (组)
+    uint16_t pre_samples;                   // 触发样本之前的组数
+    uint16_t divisor;                       // 采样分频
+    uint32_t trigger_ms;                    // 触发时的系统时间 (ms)
+    uint32_t captures;                      // 完成的记录数
+} CMix_Scope_Status_t;
+
+/* ========================= 函数声明 ========================= */
+
+/* 设置并启动 (主循环上下文) */
+CMix_Protocol_Error_t CMix_Scope_Arm(const CMix_Scope_Config_t *config);
+bool CMix_Scope_Force(void);
+void CMix_Scope_Stop(void);
+
+/* 采集 (控制中断, 每个控制步结束时调用一次) */
+void CMix_Scope_Capture(void);
+
+/* 状态与分块读出 */
+void CMix_Scope_Get_Status(CMix_Scope_Status_t *status);
+uint8_t CMix_Scope_Read_Chunk(uint8_t index, uint8_t *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_SCOPE_H */
@@ -0,0 +1,271 @@
+/******************************************************************************
+  * @file    CMix_telemetry.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix遥测流模块实现文件
+  *          实现订阅检查、控制中断采样和后台打包发送
+  ******************************************************************************
+  * @attention
+  *
+  * CMix遥测流模块实现
+  * 记录环按字节存放, head/tail自由递增. 写入方只有控制中断: 写完整条记录后
+  * 推进head; 读出方只有后台任务, 复制整条记录后推进tail. 订阅在关中断下替换
+  * 槽位、清空环并递增epoch; 发送在复制前记下epoch, 取帧序号和推进tail时在关
+  * 中断下复核, epoch变化说明复制期间环已被清空, 丢弃这一帧而不写回旧tail.
+  * 配置上要求命令帧延后执行, 订阅与发送同在主循环, 复核只作兜底.
+  *
+  * 每个槽位有一个递减计数, 减到0时到期并重装分频值; 环满时记录丢弃, 计数照常
+  * 推进, 控制步计数保持连续, 上位机据此定位丢失记录之后的样本时刻.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_telemetry.h"
+#include "CMix_hardware.h"
+#include "CMix_main.h"
+
+#if CMIX_TELEMETRY_ENABLE
+
+/* ========================= 私有定义 ========================= */
+
+#define CMIX_TELEMETRY_MASK             (CMIX_TELEMETRY_BUFFER_BYTES - 1)
+#define CMIX_TELEMETRY_FRAME_OVERHEAD   5               // 帧头+命令+长度+CRC16
+#define CMIX_TELEMETRY_RECORD_HEADER    3               // 控制步计数(2) + 到期掩码(1)
+
+/* 订阅槽位 */
+typedef struct {
+    uint8_t signal;                         // 信号ID (CMix_DCDC_Probe_t)
+    uint16_t decimation;                    // 分频 (控制步)
+    uint16_t countdown;                     // 距下次采样的控制步数
+} CMix_Telemetry_Slot_t;
+
+/* 遥测流状态 */
+typedef struct {
+    CMix_Telemetry_Slot_t slot[CMIX_TELEMETRY_MAX_SIGNALS];
+    uint8_t count;                          // 订阅的槽位数 (0 = 停止)
+    uint16_t step;                          // 控制步计数 (订阅时清零)
+    volatile uint16_t head;                 // 写入位置 (字节, 自由递增, 仅控制中断修改)
+    volatile uint16_t tail;                 // 读出位置 (字节, 自由递增, 仅后台任务修改)
+    volatile uint8_t epoch;                 // 订阅次数 (订阅清空环时递增)
+    uint8_t sequence;                       // 下一帧的帧序号
+    uint8_t lost_pending;                   // 上一帧之后丢弃的记录数 (饱和)
+    bool partial_waiting;                   // 有不满一帧的记录在等待
+    uint32_t partial_ms;                    // 开始等待的系统时间 (ms)
+} CMix_Telemetry_t;
+
+/* ========================= 私有变量 ========================= */
+
+static uint8_t g_telemetry_ring[CMIX_TELEMETRY_BUFFER_BYTES];
+static CMix_Telemetry_t g_telemetry;
+static CMix_Telemetry_Stats_t g_telemetry_stats;
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 订阅信号 (替换当前订阅)
+ * @param data: N个 (信号ID(1) + 分频(2, 小端)), 为空时停止
+ * @param len: 数据长度
+ * @retval 协议错误码: 长度不是3的倍数或超过槽位数为数据长度错误;
+ *         信号ID无效、分频为0或最坏情况字节率超过CMIX_TELEMETRY_MAX_BYTES_PER_S为参数超出范围
+ */
+CMix_Protocol_Error_t CMix_Telemetry_Subscribe(const uint8_t *data, uint8_t len)
+{
+    CMix_Telemetry_Slot_t slot[CMIX_TELEMETRY_MAX_SIGNALS];
+    uint32_t bytes_per_s = 0, primask;
+    uint8_t count, i;
+
+    if ((len % 3) != 0 || len / 3 > CMIX_TELEMETRY_MAX_SIGNALS) {
+        return CMIX_PROTOCOL_ERROR_INVALID_DATA_LEN;
+    }
+
+    count = len / 3;
+    for (i = 0; i < count; i++) {
+        slot[i].signal = data[i * 3];
+        slot[i].decimation = (uint16_t)(data[i * 3 + 1] | (data[i * 3 + 2] << 8));
+        slot[i].countdown = 1;                          // 第一个控制步全部到期
+        if (slot[i].signal >= CMIX_PROBE_COUNT || slot[i].decimation == 0) {
+            return CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE;
+        }
+
+        /* 最坏情况: 每个槽位单独成一条记录 */
+        bytes_per_s += ((uint32_t)CMIX_CONTROL_RATE_HZ + slot[i].decimation - 1) / slot[i].decimation *
+                       (CMIX_TELEMETRY_RECORD_HEADER + 2);
+    }
+    if (bytes_per_s > CMIX_TELEMETRY_MAX_BYTES_PER_S) {
+        return CMIX_PROTOCOL_ERROR_PARAMETER_OUT_RANGE;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (i = 0; i < count; i++) {
+        g_telemetry.slot[i] = slot[i];
+    }
+    g_telemetry.count = count;
+    g_telemetry.step = 0;
+    g_telemetry.head = 0;
+    g_telemetry.tail = 0;
+    g_telemetry.sequence = 0;
+    g_telemetry.lost_pending = 0;
+    g_telemetry.partial_waiting = false;
+    g_telemetry.epoch++;
+    __set_PRIMASK(primask);
+
+    return CMIX_PROTOCOL_ERROR_OK;
+}
+
+/**
+ * @brief 采样到期的槽位并写入一条记录
+ * @param None
+ * @retval None
+ * @note  控制步结束时调用; 无订阅时只有一次比较
+ */
+void CMix_Telemetry_Capture(void)
+{
+    uint8_t count = g_telemetry.count;
+    uint8_t mask = 0, due = 0, i;
+    uint16_t value[CMIX_TELEMETRY_MAX_SIGNALS];
+    uint16_t head, used, length, step;
+
+    if (count == 0) {
+        return;
+    }
+
+    step = g_telemetry.step++;
+    for (i = 0; i < count; i++) {
+        CMix_Telemetry_Slot_t *slot = &g_telemetry.slot[i];
+
+        if (--slot->countdown == 0) {
+            slot->countdown = slot->decimation;
+            mask |= (uint8_t)(1U << i);
+            value[due++] = CMix_DCDC_Probe(slot->signal);
+        }
+    }
+    if (mask == 0) {
+        return;
+    }
+
+    head = g_telemetry.head;
+    used = (uint16_t)(head - g_telemetry.tail);
+    length = (uint16_t)(CMIX_TELEMETRY_RECORD_HEADER + due * 2);
+    if (used + length > CMIX_TELEMETRY_BUFFER_BYTES) {
+        g_telemetry_stats.lost++;
+        if (g_telemetry.lost_pending != 0xFF) {
+            g_telemetry.lost_pending++;
+        }
+        return;
+    }
+
+    g_telemetry_ring[head++ & CMIX_TELEMETRY_MASK] = (uint8_t)(step & 0xFF);
+    g_telemetry_ring[head++ & CMIX_TELEMETRY_MASK] = (uint8_t)(step >> 8);
+    g_telemetry_ring[head++ & CMIX_TELEMETRY_MASK] = mask;
+    for (i = 0; i < due; i++) {
+        g_telemetry_ring[head++ & CMIX_TELEMETRY_MASK] = (uint8_t)(value[i] & 0xFF);
+        g_telemetry_ring[head++ & CMIX_TELEMETRY_MASK] = (uint8_t)(value[i] >> 8);
+    }
+
+    /* 记录写完后才推进head */
+    __DMB();
+    g_telemetry.head = head;
+    g_telemetry_stats.records++;
+    if (used + length > g_telemetry_stats.peak_bytes) {
+        g_telemetry_stats.peak_bytes = (uint16_t)(used + length);
+    }
+}
+
+/**
+ * @brief 后台发送: 积压的记录按整条装帧, 满帧立即发送, 不满一帧的记录等待CMIX_TELEMETRY_LATENCY_MS;
+ *        发送队列积压超过CMIX_TELEMETRY_TX_BACKLOG时留到下一周期
+ * @param None
+ * @retval None
+ */
+void CMix_Telemetry_Flush(void)
+{
+    uint8_t frame[CMIX_TELEMETRY_FRAME_BYTES];
+    uint16_t head, tail, length, len, i;
+    uint8_t mask, epoch;
+    bool full = false;
+    uint32_t primask, now;
+
+    for (;;) {
+        epoch = g_telemetry.epoch;
+        head = g_telemetry.head;
+        tail = g_telemetry.tail;
+        if (head == tail) {
+            return;
+        }
+
+        /* 装入整条记录直到帧满 */
+        len = 2;
+        while (tail != head) {
+            length = CMIX_TELEMETRY_RECORD_HEADER;
+            for (mask = g_telemetry_ring[(uint16_t)(tail + 2) & CMIX_TELEMETRY_MASK]; mask != 0; mask &= (uint8_t)(mask - 1)) {
+                length += 2;
+            }
+            if (len + length > CMIX_TELEMETRY_FRAME_BYTES) {
+                full = true;
+                break;
+            }
+            for (i = 0; i < length; i++) {
+                frame[len++] = g_telemetry_ring[(uint16_t)(tail + i) & CMIX_TELEMETRY_MASK];
+            }
+            tail = (uint16_t)(tail + length);
+        }
+
+        /* 不满一帧: 等待更多记录, 超时后发送 */
+        if (!full) {
+            now = CMix_Main_Get_System_Tick();
+            if (!g_telemetry.partial_waiting) {
+                g_telemetry.partial_waiting = true;
+                g_telemetry.partial_ms = now;
+            }
+            if (now - g_telemetry.partial_ms < CMIX_TELEMETRY_LATENCY_MS) {
+                return;
+            }
+        }
+        if (CMix_Hardware_UART_TX_Free() < CMIX_UART_TX_BUFFER_SIZE - CMIX_TELEMETRY_TX_BACKLOG +
+                                           len + CMIX_TELEMETRY_FRAME_OVERHEAD) {
+            return;
+        }
+
+        /* 复制期间重新订阅: 帧内是旧订阅的记录, 丢弃后按新环重来 */
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (g_telemetry.epoch != epoch) {
+            __set_PRIMASK(primask);
+            full = false;
+            continue;
+        }
+        frame[0] = g_telemetry.sequence++;
+        frame[1] = g_telemetry.lost_pending;
+        g_telemetry.lost_pending = 0;
+        __set_PRIMASK(primask);
+
+        CMix_Protocol_Send_Frame(CMIX_CMD_TELEMETRY, frame, (uint8_t)len);
+
+        /* 发送期间重新订阅时环已清空, 不写回旧tail */
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (g_telemetry.epoch == epoch) {
+            g_telemetry.tail = tail;
+            g_telemetry.partial_waiting = false;
+        }
+        __set_PRIMASK(primask);
+        g_telemetry_stats.frames++;
+        full = false;
+    }
+}
+
+/**
+ * @brief 获取遥测流统计
+ * @param stats: 统计输出
+ * @retval None
+ */
+void CMix_Telemetry_Get_Stats(CMix_Telemetry_Stats_t *stats)
+{
+    *stats = g_telemetry_stats;
+    stats->signals = g_telemetry.count;
+}
+
+#endif /* CMIX_TELEMETRY_ENABLE */
@@ -0,0 +1,68 @@
+/******************************************************************************
+  * @file    CMix_telemetry.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix遥测流模块头文件
+  *          上位机订阅信号和分频, 控制中断采样定点值, 后台连续发送
+  ******************************************************************************
+  * @attention
+  *
+  * CMix遥测流模块
+  * 订阅: CMIX_CMD_TELEMETRY命令数据为N个 (信号ID(1) + 分频(2, 小端)), N为1至
+  * CMIX_TELEMETRY_MAX_SIGNALS, 顺序即槽位号; 数据为空时停止. 订阅生效后各槽位
+  * 从下一个控制步起每"分频"个控制步采样一次, 第一个控制步所有槽位同时采样.
+  *
+  * 发送: CMIX_CMD_TELEMETRY帧数据为
+  *   帧序号(1) + 丢失记录数(1, 自上一帧起, 饱和到255) + 记录...
+  * 每条记录为 控制步计数低16位(2) + 到期掩码(1, 位i = 槽位i) + 到期槽位的
+  * 16位值 (按槽位顺序, 小端). 帧序号和控制步计数在每次订阅时清零.
+  *
+  * 信号ID和数值编码见CMix_DCDC_Probe_t, 单位移位见CMix_config.h信号探针配置.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_TELEMETRY_H
+#define __CMIX_TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CMix_config.h"
+#include "CMix_dcdc.h"
+#include "CMix_protocol.h"
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 遥测流统计 */
+typedef struct {
+    uint8_t  signals;                       // 当前订阅的信号数 (0 = 停止)
+    uint8_t  reserved;
+    uint16_t peak_bytes;                    // 环中最多同时积压的字节数
+    uint32_t records;                       // 写入环的记录数
+    uint32_t lost;                          // 环满丢弃的记录数
+    uint32_t frames;                        // 发送的帧数
+} CMix_Telemetry_Stats_t;
+
+/* ========================= 函数声明 ========================= */
+
+/* 订阅 (主循环上下文): 数据为空时停止 */
+CMix_Protocol_Error_t CMix_Telemetry_Subscribe(const uint8_t *data, uint8_t len);
+
+/* 采样 (控制中断, 每个控制步结束时调用一次) */
+void CMix_Telemetry_Capture(void);
+
+/* 后台发送: 发送队列空间允许时把积压的记录打包成帧 */
+void CMix_Telemetry_Flush(void);
+
+/* 统计 */
+void CMix_Telemetry_Get_Stats(CMix_Telemetry_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_TELEMETRY_H */
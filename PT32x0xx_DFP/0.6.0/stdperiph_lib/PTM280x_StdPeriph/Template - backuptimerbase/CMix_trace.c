@@ -0,0 +1,150 @@
+/******************************************************************************
+  * @file    CMix_trace.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix跟踪记录模块实现文件
+  *          实现记录环写入和后台打包发送
+  ******************************************************************************
+  * @attention
+  *
+  * CMix跟踪记录模块实现
+  * 记录环按字存放, head/tail自由递增. 写入方 (任意上下文) 在关中断下检查
+  * 空间、写入整条记录后推进head; 读出方只有后台任务, 复制整条记录后推进tail.
+  * 读出方不关中断: head只在记录写完后推进, 读到的head之前的字都已写入.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_trace.h"
+#include "CMix_hardware.h"
+#include "CMix_protocol.h"
+#include "CMix_main.h"
+
+#if CMIX_DEBUG_ENABLE
+
+/* ========================= 私有定义 ========================= */
+
+#define CMIX_TRACE_MASK                 (CMIX_TRACE_BUFFER_WORDS - 1)
+#define CMIX_TRACE_FRAME_OVERHEAD       5               // 帧头+命令+长度+CRC16
+
+/* 格式ID占头字低8位 */
+typedef char CMix_Trace_Format_Count_Check_t[(CMIX_TRACE_FORMAT_COUNT <= 256) ? 1 : -1];
+
+/* 跟踪记录状态 */
+typedef struct {
+    volatile uint16_t head;                 // 写入位置 (字, 自由递增)
+    volatile uint16_t tail;                 // 读出位置 (字, 自由递增, 仅后台任务修改)
+    uint8_t sequence;                       // 下一帧的帧序号
+    uint8_t lost_pending;                   // 上一帧之后丢弃的记录数 (饱和)
+} CMix_Trace_t;
+
+/* ========================= 私有变量 ========================= */
+
+static uint32_t g_trace_ring[CMIX_TRACE_BUFFER_WORDS];
+static CMix_Trace_t g_trace;
+static CMix_Trace_Stats_t g_trace_stats;
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 写入一条记录
+ * @param header: 头字 (CMIX_TRACE_HEADER, 高16位在此填入时间)
+ * @param args: 参数字 (个数见头字[15:8])
+ * @retval None
+ * @note  环中空间不足整条记录时丢弃, 计入下一帧的丢失记录数
+ */
+void CMix_Trace_Write(uint32_t header, const uint32_t *args)
+{
+    uint16_t argc = (uint16_t)((header >> 8) & 0xFF);
+    uint16_t head, used, i;
+    uint32_t stamp = CMix_Main_Get_System_Tick() << 16;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    head = g_trace.head;
+    used = (uint16_t)(head - g_trace.tail);
+    if (argc > CMIX_TRACE_MAX_ARGS || used + 1 + argc > CMIX_TRACE_BUFFER_WORDS) {
+        g_trace_stats.lost++;
+        if (g_trace.lost_pending != 0xFF) {
+            g_trace.lost_pending++;
+        }
+    } else {
+        g_trace_ring[head & CMIX_TRACE_MASK] = (header & 0xFFFF) | stamp;
+        for (i = 0; i < argc; i++) {
+            g_trace_ring[(uint16_t)(head + 1 + i) & CMIX_TRACE_MASK] = args[i];
+        }
+        g_trace.head = (uint16_t)(head + 1 + argc);
+        g_trace_stats.records++;
+        if (used + 1 + argc > g_trace_stats.peak_words) {
+            g_trace_stats.peak_words = (uint16_t)(used + 1 + argc);
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 后台发送: 积压的记录按整条装帧, 发送队列放不下一帧时留到下一周期
+ * @param None
+ * @retval None
+ */
+void CMix_Trace_Flush(void)
+{
+    uint8_t frame[CMIX_TRACE_FRAME_BYTES];
+    uint16_t head, tail, words, len, i;
+    uint32_t word, primask;
+
+    for (;;) {
+        head = g_trace.head;
+        tail = g_trace.tail;
+        if (head == tail) {
+            return;
+        }
+
+        /* 装入整条记录直到帧满 */
+        len = 2;
+        while (tail != head) {
+            words = (uint16_t)(1 + ((g_trace_ring[tail & CMIX_TRACE_MASK] >> 8) & 0xFF));
+            if (len + words * 4 > CMIX_TRACE_FRAME_BYTES) {
+                break;
+            }
+            for (i = 0; i < words; i++) {
+                word = g_trace_ring[(uint16_t)(tail + i) & CMIX_TRACE_MASK];
+                frame[len++] = (uint8_t)(word & 0xFF);
+                frame[len++] = (uint8_t)((word >> 8) & 0xFF);
+                frame[len++] = (uint8_t)((word >> 16) & 0xFF);
+                frame[len++] = (uint8_t)(word >> 24);
+            }
+            tail = (uint16_t)(tail + words);
+        }
+        if (CMix_Hardware_UART_TX_Free() < len + CMIX_TRACE_FRAME_OVERHEAD) {
+            return;
+        }
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        frame[0] = g_trace.sequence++;
+        frame[1] = g_trace.lost_pending;
+        g_trace.lost_pending = 0;
+        __set_PRIMASK(primask);
+
+        CMix_Protocol_Send_Frame(CMIX_CMD_TRACE, frame, (uint8_t)len);
+        g_trace.tail = tail;
+        g_trace_stats.frames++;
+    }
+}
+
+/**
+ * @brief 获取跟踪记录统计
+ * @param stats: 统计输出
+ * @retval None
+ */
+void CMix_Trace_Get_Stats(CMix_Trace_Stats_t *stats)
+{
+    *stats = g_trace_stats;
+    stats->pending_words = (uint16_t)(g_trace.head - g_trace.tail);
+}
+
+#endif /* CMIX_DEBUG_ENABLE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+  * @file    CMix_trace.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix跟踪记录模块头文件
+  *          记录点写入格式ID和原始参数, 文本格式化推迟到主机
+  ******************************************************************************
+  * @attention
+  *
+  * CMix跟踪记录模块
+  * 记录: CMIX_TRACEn(格式ID, 参数...) 在关中断下向RAM环写入1+n个字, 不做
+  * 格式化, 不占用栈上文本缓冲. 格式ID和格式串见CMix_trace_fmt.h.
+  *
+  * 发送: 后台任务把整条记录依次装入CMIX_CMD_TRACE帧, 帧数据为
+  *   帧序号(1) + 丢失记录数(1, 自上一帧起, 饱和到255) + 记录...
+  * 每条记录为头字 (格式ID[7:0] | 参数个数[15:8] | 系统时间ms低16位[31:16])
+  * 和参数字, 各字小端. 帧序号逐帧加1, 主机据此发现丢帧.
+  *
+  * CMIX_DEBUG_ENABLE为0时记录宏为空, 参数不求值.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_TRACE_H
+#define __CMIX_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CMix_config.h"
+
+/* ========================= 格式ID ========================= */
+
+typedef enum {
+#define CMIX_TRACE_FORMAT(id, format)   id,
+#define CMIX_TRACE_STRING(id, text)
+#include "CMix_trace_fmt.h"
+#undef CMIX_TRACE_FORMAT
+#undef CMIX_TRACE_STRING
+    CMIX_TRACE_FORMAT_COUNT
+} CMix_Trace_Format_t;
+
+typedef enum {
+#define CMIX_TRACE_FORMAT(id, format)
+#define CMIX_TRACE_STRING(id, text)     id,
+#include "CMix_trace_fmt.h"
+#undef CMIX_TRACE_FORMAT
+#undef CMIX_TRACE_STRING
+    CMIX_TRACE_STRING_COUNT
+} CMix_Trace_String_t;
+
+/* ========================= 记录宏 ========================= */
+
+/* 头字 (时间由写入时填入高16位) */
+#define CMIX_TRACE_HEADER(id, argc)     ((uint32_t)(id) | ((uint32_t)(argc) << 8))
+
+/* 单精度浮点参数 (位模式, 对应格式串中的f/e/g) */
+#define CMIX_TRACE_F32(value)           (((union { float f; uint32_t u; }){ .f = (float)(value) }).u)
+
+#if CMIX_DEBUG_ENABLE
+#define CMIX_TRACE0(id)                 CMix_Trace_Write(CMIX_TRACE_HEADER(id, 0), NULL)
+#define CMIX_TRACE1(id, a)              CMix_Trace_Write(CMIX_TRACE_HEADER(id, 1), \
+                                                         (const uint32_t[1]){ (uint32_t)(a) })
+#define CMIX_TRACE2(id, a, b)           CMix_Trace_Write(CMIX_TRACE_HEADER(id, 2), \
+                                                         (const uint32_t[2]){ (uint32_t)(a), (uint32_t)(b) })
+#define CMIX_TRACE3(id, a, b, c)        CMix_Trace_Write(CMIX_TRACE_HEADER(id, 3), \
+                                                         (const uint32_t[3]){ (uint32_t)(a), (uint32_t)(b), (uint32_t)(c) })
+#define CMIX_TRACE4(id, a, b, c, d)     CMix_Trace_Write(CMIX_TRACE_HEADER(id, 4), \
+                                                         (const uint32_t[4]){ (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), \
+                                                                              (uint32_t)(d) })
+#define CMIX_TRACE5(id, a, b, c, d, e)  CMix_Trace_Write(CMIX_TRACE_HEADER(id, 5), \
+                                                         (const uint32_t[5]){ (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), \
+                                                                              (uint32_t)(d), (uint32_t)(e) })
+#define CMIX_TRACE6(id, a, b, c, d, e, f) CMix_Trace_Write(CMIX_TRACE_HEADER(id, 6), \
+                                                         (const uint32_t[6]){ (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), \
+                                                                              (uint32_t)(d), (uint32_t)(e), (uint32_t)(f) })
+#else
+#define CMIX_TRACE0(id)                 ((void)0)
+#define CMIX_TRACE1(id, a)              ((void)0)
+#define CMIX_TRACE2(id, a, b)           ((void)0)
+#define CMIX_TRACE3(id, a, b, c)        ((void)0)
+#define CMIX_TRACE4(id, a, b, c, d)     ((void)0)
+#define CMIX_TRACE5(id, a, b, c, d, e)  ((void)0)
+#define CMIX_TRACE6(id, a, b, c, d, e, f) ((void)0)
+#endif
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 跟踪记录统计 */
+typedef struct {
+    uint32_t records;                       // 写入环的记录数
+    uint32_t lost;                          // 环满丢弃的记录数
+    uint32_t frames;                        // 发送的帧数
+    uint16_t peak_words;                    // 环中最多同时积压的字数
+    uint16_t pending_words;                 // 当前积压的字数
+} CMix_Trace_Stats_t;
+
+/* ========================= 函数声明 ========================= */
+
+/* 写入一条记录 (记录宏调用, 中断中也可调用) */
+void CMix_Trace_Write(uint32_t header, const uint32_t *args);
+
+/* 后台发送: 发送队列空间允许时把积压的记录打包成帧 */
+void CMix_Trace_Flush(void);
+
+/* 统计 */
+void CMix_Trace_Get_Stats(CMix_Trace_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_TRACE_H */
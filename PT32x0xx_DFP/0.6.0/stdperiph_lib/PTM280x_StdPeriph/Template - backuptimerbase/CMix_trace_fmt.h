@@ -0,0 +1,84 @@
+/******************************************************************************
+  * @file    CMix_trace_fmt.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix跟踪记录格式表
+  *          固件中展开为格式ID枚举, 主机解码程序中展开为格式串表
+  ******************************************************************************
+  * @attention
+  *
+  * 本文件不加包含保护, 包含前定义以下两个宏:
+  *   CMIX_TRACE_FORMAT(标识, 格式串)   一条记录格式, 标识即格式ID
+  *   CMIX_TRACE_STRING(标识, 文本)     %s参数可取的字符串, 记录中只传标识
+  *
+  * 固件只用标识, 格式串不进入Flash. 格式串为printf子集: 每个转换说明取一个
+  * 32位参数字, d/i有符号, u/x/X/c无符号, f/e/g为单精度浮点的位模式
+  * (CMIX_TRACE_F32), s为CMIX_TRACE_STRING的标识; 长度修饰符 (l/h) 被忽略.
+  * 参数个数不超过CMIX_TRACE_MAX_ARGS. 只允许在表尾追加或修改格式串,
+  * 已有标识的顺序不变, 旧版本固件的记录才能用新表解码.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+/* ========================= 字符串参数 ========================= */
+
+CMIX_TRACE_STRING(CMIX_TRACE_STR_RUN,           "RUN")
+CMIX_TRACE_STRING(CMIX_TRACE_STR_IDLE,          "IDLE")
+CMIX_TRACE_STRING(CMIX_TRACE_STR_BUCK,          "BUCK")
+CMIX_TRACE_STRING(CMIX_TRACE_STR_BOOST,         "BOOST")
+CMIX_TRACE_STRING(CMIX_TRACE_STR_CHIP_PTM280X,  "PTM280x LQFP32 (GPIOA/B可用)")
+CMIX_TRACE_STRING(CMIX_TRACE_STR_CHIP_UNKNOWN,  "未知类型")
+
+/* ========================= 硬件初始化 ========================= */
+
+CMIX_TRACE_FORMAT(CMIX_TRACE_HW_BANNER,         "=== CMix硬件初始化完成 ===")
+CMIX_TRACE_FORMAT(CMIX_TRACE_HW_CHIP,           "目标芯片: %s")
+CMIX_TRACE_FORMAT(CMIX_TRACE_HW_VERSION,        "硬件版本: CMix V1.0")
+CMIX_TRACE_FORMAT(CMIX_TRACE_HW_CONFIGURED,     "初始化状态: UART/ADC/TIM/GPIO/OPA/CMP 已配置")
+CMIX_TRACE_FORMAT(CMIX_TRACE_HW_END,            "========================")
+
+/* ========================= 启动信息 ========================= */
+
+CMIX_TRACE_FORMAT(CMIX_TRACE_STARTED,           "CMix DCDC Controller V1.0.0 Started")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYSTEM_CLOCK,      "System Clock: %u MHz")
+CMIX_TRACE_FORMAT(CMIX_TRACE_PARAM_SCAN,        "Param: keys=%u rec=%u bad=%u seq=%lu scan=%lu")
+CMIX_TRACE_FORMAT(CMIX_TRACE_BLACKBOX_SCAN,     "Blackbox: region=%u seq=%lu fault=%u window=%u+%u at=%lu")
+CMIX_TRACE_FORMAT(CMIX_TRACE_CRC_BENCH,         "CRC%u: hw=%u test=0x%02X tab=%lu hw=%lu dma=%lu")
+/* 已停用 (原ALU自检/耗时对比), 保留标识使后续格式ID不变 */
+CMIX_TRACE_FORMAT(CMIX_TRACE_RESERVED_0,        "(reserved 0)")
+CMIX_TRACE_FORMAT(CMIX_TRACE_RESERVED_1,        "(reserved 1)")
+CMIX_TRACE_FORMAT(CMIX_TRACE_RESERVED_2,        "(reserved 2)")
+
+/* ========================= 运行状态 ========================= */
+
+CMIX_TRACE_FORMAT(CMIX_TRACE_STATUS,            "[%s] Vin=%.2fV, Vout=%.2fV, Ia=%.3fA, Ib=%.3fA, Mode=%s")
+CMIX_TRACE_FORMAT(CMIX_TRACE_OVERCURRENT,       "[FAULT] Overcurrent detected! Ia=%.3fA, Ib=%.3fA")
+
+/* ========================= 系统状态 (CMix_Main_Debug_Print) ========================= */
+
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_BANNER,        "=== CMix System Status ===")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_APP_STATE,     "App State: %d")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_RUNTIME,       "Runtime: %lu seconds")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_CPU,           "CPU Usage: %u%%")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_MEMORY,        "Memory Usage: %u%%")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_TEMPERATURE,   "Temperature: %d°C")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_EMERGENCIES,   "Emergency Count: %lu")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_ERRORS,        "Error Count: %lu")
+CMIX_TRACE_FORMAT(CMIX_TRACE_SYS_END,           "========================")
+
+/* ========================= DCDC状态 (CMix_DCDC_Debug_Print) ========================= */
+
+CMIX_TRACE_FORMAT(CMIX_TRACE_DCDC_BANNER,       "=== CMix DCDC Status ===")
+CMIX_TRACE_FORMAT(CMIX_TRACE_DCDC_MODE,         "Mode: %d, State: %d")
+CMIX_TRACE_FORMAT(CMIX_TRACE_DCDC_VOLTAGE,      "Vin: %dmV, Vout: %dmV")
+CMIX_TRACE_FORMAT(CMIX_TRACE_DCDC_CURRENT,      "Iin: %dmA, Iout: %dmA")
+CMIX_TRACE_FORMAT(CMIX_TRACE_DCDC_POWER,        "Power: %dW, Efficiency: %d%%")
+CMIX_TRACE_FORMAT(CMIX_TRACE_DCDC_PWM,          "PWM Buck: %d, Boost: %d")
+CMIX_TRACE_FORMAT(CMIX_TRACE_DCDC_FAULTS,       "Faults: 0x%02X")
+CMIX_TRACE_FORMAT(CMIX_TRACE_DCDC_END,          "=======================")
+
+/* ========================= 比较器保护 ========================= */
+
+CMIX_TRACE_FORMAT(CMIX_TRACE_CMP_THRESHOLD,     "CMP: Vin过压=%lumV Vout过压=%lumV (LDAC0共用, 设定%lumV)")
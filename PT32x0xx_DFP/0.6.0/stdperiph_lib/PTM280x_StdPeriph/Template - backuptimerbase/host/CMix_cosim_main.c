@@ -0,0 +1,920 @@
+/******************************************************************************
+  * @file    CMix_cosim_main.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix控制与功率级闭环联合仿真运行程序
+  *          CMix_dcdc.c/CMix_pid.c原样编译, 与host/plant功率级模型逐PWM周期同步运行
+  ******************************************************************************
+  * @attention
+  *
+  * 用法: cmix_cosim [all|场景名] [-t 文件]
+  *   all         每个场景在独立子进程中运行 (固件静态变量互不影响)
+  *   -t 文件     每个控制步输出一行CSV波形 (时间/电压/电流/比较值/状态)
+  *
+  * 同步方式见plant/CMix_cosim.h.
+  *
+  * model场景检查功率级模型本身 (平均/开关模型一致性、解析稳态和纹波、
+  * 能量守恒); feedforward场景检查前馈倒数估计 (全输入范围、增量更新、
+  * 除数下限); pid场景逐步比较定点PI (CMix_PID_Update) 与浮点参考
+  * (CMix_DCDC_PI_Update) 的输出; 闭环场景检查同步关系、保护动作和稳压指标
+  * (稳态误差、稳定时间、纹波).
+  *
+  * 返回值: 0 = 全部场景通过, 1 = 有检查失败, 2 = 用法错误
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "CMix_dcdc.h"
+#include "CMix_hardware.h"
+#include "CMix_pid.h"
+#include "plant/CMix_cosim.h"
+#include "plant/CMix_plant_hw.h"
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_COSIM_SETTLING_BAND    0.02        // 稳定带 ±2%
+#define CMIX_COSIM_STEADY_WINDOW_S  0.1         // 稳态统计窗口
+#define CMIX_COSIM_DEFAULT_SETPOINT 24.0        // CMix_DCDC_Init默认电压设定值 (V)
+#define CMIX_COSIM_RIPPLE_MAX       0.01        // 稳态纹波上限 (峰峰值/设定值)
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 场景 */
+typedef struct {
+    const char *name;
+    bool (*run)(void);
+    const char *description;
+} CMix_Cosim_Scenario_t;
+
+/* ========================= 私有变量 ========================= */
+
+static CMix_Cosim_t g_cosim;
+static FILE *g_trace = NULL;
+static uint32_t g_failures = 0;
+
+/* ========================= 私有函数声明 ========================= */
+
+static void CMix_Cosim_Format_ms(char *buffer, size_t size, double seconds, const char *none);
+static void CMix_Cosim_Check(bool condition, const char *format, ...) __attribute__((format(printf, 2, 3)));
+static void CMix_Cosim_Check_Regulation(const CMix_Plant_Metrics_t *metrics, double settling_max_s);
+static void CMix_Cosim_Print_Result(const char *label, const CMix_Plant_Metrics_t *metrics);
+static void CMix_Cosim_Print_Summary(void);
+static bool CMix_Cosim_Check_Lockstep(void);
+static bool CMix_Cosim_Scenario_Model(void);
+static bool CMix_Cosim_Scenario_Feedforward(void);
+static bool CMix_Cosim_Scenario_PID(void);
+static bool CMix_Cosim_Startup(CMix_Plant_Model_t model, double battery_voltage, CMix_Plant_Metrics_t *metrics);
+static bool CMix_Cosim_Scenario_Buck_Start(void);
+static bool CMix_Cosim_Scenario_Buck_Start_Switching(void);
+static bool CMix_Cosim_Scenario_Setpoint_Step(void);
+static bool CMix_Cosim_Scenario_Load_Step(void);
+static bool CMix_Cosim_Scenario_Boost_Start(void);
+static bool CMix_Cosim_Scenario_Restart(void);
+#if CMIX_PWM_INTERLEAVE_ENABLE
+static bool CMix_Cosim_Scenario_Interleave(void);
+#endif
+static int CMix_Cosim_Run_Scenario(const CMix_Cosim_Scenario_t *scenario);
+
+static const CMix_Cosim_Scenario_t g_scenarios[] = {
+    {"model",         CMix_Cosim_Scenario_Model,               "开环: 平均/开关模型一致性、解析稳态与纹波、能量守恒、ADC换算与抽取"},
+    {"feedforward",   CMix_Cosim_Scenario_Feedforward,         "前馈倒数估计: 全输入范围、增量更新、除数下限"},
+    {"pid",           CMix_Cosim_Scenario_PID,                 "定点PI与浮点参考: 随机误差、大阶跃、饱和与抗积分饱和、小误差无漂移"},
+    {"buck_start",    CMix_Cosim_Scenario_Buck_Start,          "48V -> 24V软启动 (平均模型)"},
+    {"buck_start_sw", CMix_Cosim_Scenario_Buck_Start_Switching, "48V -> 24V软启动 (开关模型, 纹波)"},
+    {"setpoint_step", CMix_Cosim_Scenario_Setpoint_Step,       "稳态后设定值24V -> 30V"},
+    {"load_step",     CMix_Cosim_Scenario_Load_Step,           "稳态后恒流负载0A -> 5A"},
+    {"boost_start",   CMix_Cosim_Scenario_Boost_Start,         "12V -> 24V (BOOST模式)"},
+    {"restart",       CMix_Cosim_Scenario_Restart,             "软启动中故障: 禁用不清除故障, 复位后重新从0软启动"},
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    {"interleave",    CMix_Cosim_Scenario_Interleave,          "两相交错: 输出纹波抵消, 相B驱动失配下的均流"},
+#endif
+};
+
+#define CMIX_COSIM_SCENARIO_COUNT   (sizeof(g_scenarios) / sizeof(g_scenarios[0]))
+
+/* ========================= 程序入口 ========================= */
+
+int main(int argc, char **argv)
+{
+    const char *name = "all";
+    uint32_t i, failed = 0;
+    int arg;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    for (arg = 1; arg < argc; arg++) {
+        if (strcmp(argv[arg], "-t") == 0 && arg + 1 < argc) {
+            g_trace = fopen(argv[++arg], "w");
+            if (g_trace == NULL) {
+                perror(argv[arg]);
+                return 2;
+            }
+        } else if (argv[arg][0] != '-') {
+            name = argv[arg];
+        } else {
+            fprintf(stderr, "usage: %s [all|model|feedforward|pid|buck_start|buck_start_sw|setpoint_step|load_step|boost_start"
+#if CMIX_PWM_INTERLEAVE_ENABLE
+                            "|interleave"
+#endif
+                            "] [-t file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (strcmp(name, "all") != 0) {
+        for (i = 0; i < CMIX_COSIM_SCENARIO_COUNT; i++) {
+            if (strcmp(name, g_scenarios[i].name) == 0) {
+                return CMix_Cosim_Run_Scenario(&g_scenarios[i]);
+            }
+        }
+        fprintf(stderr, "unknown scenario: %s\n", name);
+        return 2;
+    }
+
+    /* 固件使用函数内静态变量 (软启动计数等), 每个场景在子进程中从初始化开始 */
+    for (i = 0; i < CMIX_COSIM_SCENARIO_COUNT; i++) {
+        pid_t pid;
+        int status = 0;
+
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) {
+            _exit(CMix_Cosim_Run_Scenario(&g_scenarios[i]));
+        }
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            printf("== %s: FAILED\n", g_scenarios[i].name);
+            failed++;
+        }
+    }
+    printf("== %u/%u scenarios passed\n", (unsigned)(CMIX_COSIM_SCENARIO_COUNT - failed),
+           (unsigned)CMIX_COSIM_SCENARIO_COUNT);
+    return failed == 0 ? 0 : 1;
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 时间格式化 (负值表示未发生)
+ * @param buffer: 输出缓冲
+ * @param size: 缓冲长度
+ * @param seconds: 时间 (s)
+ * @param none: 未发生时的文本
+ * @retval None
+ */
+static void CMix_Cosim_Format_ms(char *buffer, size_t size, double seconds, const char *none)
+{
+    if (seconds < 0.0) {
+        snprintf(buffer, size, "%s", none);
+    } else {
+        snprintf(buffer, size, "%.2f ms", seconds * 1e3);
+    }
+}
+
+/**
+ * @brief 检查并打印结果
+ * @param condition: 检查条件
+ * @param format: 描述
+ * @retval None
+ */
+static void CMix_Cosim_Check(bool condition, const char *format, ...)
+{
+    va_list args;
+
+    printf("  [%s] ", condition ? " OK " : "FAIL");
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+
+    if (!condition) {
+        g_failures++;
+    }
+}
+
+/**
+ * @brief 检查稳压指标: 稳态误差在稳定带内、限定时间内稳定、稳态纹波不超过上限
+ * @param metrics: 阶跃指标 (统计窗口已结束)
+ * @param settling_max_s: 稳定时间上限 (从阶跃开始计)
+ * @retval None
+ */
+static void CMix_Cosim_Check_Regulation(const CMix_Plant_Metrics_t *metrics, double settling_max_s)
+{
+    CMix_Plant_Result_t result;
+    double tolerance = metrics->band * fabs(metrics->target - metrics->initial);
+    double ripple_max = CMIX_COSIM_RIPPLE_MAX * fabs(metrics->target);
+    char settle[24];
+
+    CMix_Plant_Metrics_Result(metrics, &result);
+    CMix_Cosim_Format_ms(settle, sizeof(settle), result.settling_time_s, "未稳定");
+    CMix_Cosim_Check(fabs(result.steady_error) <= tolerance, "稳态 %.3f V, 误差 %+.3f V (上限 ±%.3f V)",
+                     result.final_value, result.steady_error, tolerance);
+    CMix_Cosim_Check(result.settling_time_s >= 0.0 && result.settling_time_s <= settling_max_s,
+                     "稳定时间 %s (上限 %.0f ms)", settle, settling_max_s * 1e3);
+    CMix_Cosim_Check(result.ripple_pp <= ripple_max, "稳态纹波 %.1f mVpp (上限 %.1f mVpp)",
+                     result.ripple_pp * 1e3, ripple_max * 1e3);
+}
+
+/**
+ * @brief 打印阶跃响应指标
+ * @param label: 标签
+ * @param metrics: 指标
+ * @retval None
+ */
+static void CMix_Cosim_Print_Result(const char *label, const CMix_Plant_Metrics_t *metrics)
+{
+    CMix_Plant_Result_t result;
+    char rise[24], settle[24];
+
+    CMix_Plant_Metrics_Result(metrics, &result);
+    CMix_Cosim_Format_ms(rise, sizeof(rise), result.rise_time_s, "未到达");
+    CMix_Cosim_Format_ms(settle, sizeof(settle), result.settling_time_s, "未稳定");
+    printf("  %s: %.2fV -> %.2fV\n", label, metrics->initial, metrics->target);
+    printf("    上升时间(10-90%%) %s, 超调 %.1f%%, 稳定时间(±%.0f%%) %s\n",
+           rise, result.overshoot_pct, metrics->band * 100.0, settle);
+    printf("    稳态 %.3f V (误差 %+.3f V), 纹波 %.1f mVpp\n", result.final_value, result.steady_error,
+           result.ripple_pp * 1e3);
+}
+
+/**
+ * @brief 打印运行汇总 (同步计数、故障、主机速度)
+ * @param None
+ * @retval None
+ */
+static void CMix_Cosim_Print_Summary(void)
+{
+    CMix_DCDC_Status_t *status = CMix_DCDC_Get_Status();
+    CMix_Safety_Monitor_t *safety = CMix_DCDC_Get_Safety_Status();
+    const CMix_Plant_t *plant = &g_cosim.plant;
+
+    printf("  仿真 %.0f ms / 主机 %.0f ms (%.0fx实时), PWM周期%llu, 控制步%llu, 1ms任务%llu\n",
+           plant->time_s * 1e3, g_cosim.host_s * 1e3, plant->time_s / g_cosim.host_s,
+           (unsigned long long)plant->periods, (unsigned long long)g_cosim.control_steps,
+           (unsigned long long)g_cosim.tasks);
+    printf("  状态 %u, 模式 %u, 故障标志 0x%02X, 电感电流峰值 %.1f A, 比较值 %u/%u\n",
+           (unsigned)status->state, (unsigned)status->active_mode, (unsigned)safety->fault_flags,
+           plant->il_peak, CMix_Plant_HW_Get_Compare(1), CMix_Plant_HW_Get_Compare(2));
+}
+
+/**
+ * @brief 检查同步关系: 控制步数与ADC扫描数、1ms任务数与仿真时间
+ * @param None
+ * @retval true = 通过
+ */
+static bool CMix_Cosim_Check_Lockstep(void)
+{
+    uint64_t expected_tasks = (uint64_t)(g_cosim.plant.time_s * 1e3 + 1e-6);
+    bool ok;
+
+#if CMIX_CONTROL_ISR_ENABLE
+    ok = (g_cosim.control_steps == g_cosim.scans / CMIX_CONTROL_DECIMATION);
+#else
+    ok = (g_cosim.control_steps == g_cosim.tasks);
+#endif
+    ok = ok && (g_cosim.tasks + 1 >= expected_tasks && g_cosim.tasks <= expected_tasks);
+    CMix_Cosim_Check(ok, "控制步%llu次/ADC扫描%llu次, 1ms任务%llu次",
+                     (unsigned long long)g_cosim.control_steps, (unsigned long long)g_cosim.scans,
+                     (unsigned long long)g_cosim.tasks);
+    return ok;
+}
+
+/* ========================= 场景 ========================= */
+
+/**
+ * @brief 模型场景: 固定比较值开环运行, 不经过固件
+ * @param None
+ * @retval true = 通过
+ */
+static bool CMix_Cosim_Scenario_Model(void)
+{
+    const uint16_t compare_a = CMIX_PWM_PERIOD / 3;
+    const uint16_t compare_b = CMIX_PWM_PERIOD * 2 / 3;
+    const double duration_s = 0.05;
+    const double window_s = 0.005;
+    CMix_Plant_Params_t params;
+    CMix_Plant_t models[2];
+    double mean[2] = {0.0, 0.0};
+    double ripple_il = 0.0, ripple_v = 0.0;
+    double da, db, il_dc, vout_dc, il_ripple_expected, host_start;
+    double error_mv = 0.0, error_ma = 0.0;
+    uint64_t periods, n;
+    uint32_t samples = 0, ext, outputs;
+    uint16_t code;
+    uint8_t osr_log2;
+    int m;
+
+    /* 解析值按四开关拓扑推导, 交错构建下同样检查四开关模型 */
+    CMix_Plant_Default_Params(&params);
+    params.topology = CMIX_PLANT_FOUR_SWITCH;
+    periods = (uint64_t)(duration_s / params.pwm_period_s);
+
+    host_start = CMix_Cosim_Host_Time();
+    for (m = 0; m < 2; m++) {
+        CMix_Plant_t *plant = &models[m];
+        double energy_error, stored0;
+
+        params.model = (m == 0) ? CMIX_PLANT_AVERAGED : CMIX_PLANT_SWITCHING;
+        CMix_Plant_Init(plant, &params);
+        stored0 = CMix_Plant_Stored_Energy(plant);
+        samples = 0;
+
+        for (n = 0; n < periods; n++) {
+            CMix_Plant_Step(plant, compare_a, compare_b, CMIX_PWM_PERIOD);
+            if (plant->time_s >= duration_s - window_s) {
+                mean[m] += plant->vout_avg;
+                samples++;
+                if (m == 1) {
+                    ripple_il = plant->il_max - plant->il_min;
+                    ripple_v = plant->vout_max - plant->vout_min;
+                }
+            }
+        }
+        mean[m] /= samples;
+
+        energy_error = plant->energy_in_j - plant->energy_load_j - plant->energy_loss_j -
+                       (CMix_Plant_Stored_Energy(plant) - stored0);
+        CMix_Cosim_Check(isfinite(plant->il) && isfinite(plant->vc) &&
+                         fabs(energy_error) < 1e-3 * plant->energy_in_j,
+                         "%s模型能量守恒: 输入%.3f J, 负载%.3f J, 损耗%.4f J, 残差%.2e J",
+                         m == 0 ? "平均" : "开关", plant->energy_in_j, plant->energy_load_j,
+                         plant->energy_loss_j, energy_error);
+    }
+    printf("  开环%.0f ms x 2个模型, 主机 %.1f ms\n", duration_s * 1e3, (CMix_Cosim_Host_Time() - host_start) * 1e3);
+
+    /* 解析稳态: 正向电流时死区使相A有效占空比减小、相B增大 */
+    da = (double)compare_a / CMIX_PWM_PERIOD - params.dead_time_s / params.pwm_period_s;
+    db = (double)compare_b / CMIX_PWM_PERIOD + params.dead_time_s / params.pwm_period_s;
+    il_dc = da * params.battery_voltage /
+            (da * da * params.battery_resistance + params.inductor_dcr_ohm + db * db * params.load_resistance);
+    vout_dc = db * il_dc * params.load_resistance;
+
+    CMix_Cosim_Check(fabs(mean[0] - vout_dc) < 0.005 * vout_dc,
+                     "平均模型稳态 %.3f V, 解析值 %.3f V", mean[0], vout_dc);
+    CMix_Cosim_Check(fabs(mean[1] - mean[0]) < 0.01 * mean[0],
+                     "开关模型均值 %.3f V, 平均模型 %.3f V", mean[1], mean[0]);
+
+    /* 相A上管导通且相B上管导通区间 [td, dA) 内电感承受Vin - Vout, 其余时间 -Vout 或 0 */
+    il_ripple_expected = (params.battery_voltage - mean[1]) * da * params.pwm_period_s / params.inductance_h;
+    CMix_Cosim_Check(fabs(ripple_il - il_ripple_expected) < 0.05 * il_ripple_expected,
+                     "电感电流纹波 %.3f App, 解析值 %.3f App", ripple_il, il_ripple_expected);
+    CMix_Cosim_Check(ripple_v > 0.0 && ripple_v < 0.05 * mean[1], "输出电压纹波 %.1f mVpp", ripple_v * 1e3);
+
+    /* 固件ADC换算 (编译期常数) 与浮点公式逐码值比较 */
+    for (code = 0; code <= CMIX_ADC_RESOLUTION; code++) {
+        double mv = (double)code * CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO / CMIX_ADC_RESOLUTION;
+        double ma = fmax(-CMIX_ADC_CURRENT_LIMIT_MA, fmin(CMIX_ADC_CURRENT_LIMIT_MA, CMIX_ADC_CURRENT_CURVE_MA(code)));
+
+        error_mv = fmax(error_mv, fabs(CMix_Hardware_Convert_Voltage_mV(code) - mv));
+        error_ma = fmax(error_ma, fabs(CMix_Hardware_Convert_Current_mA(code) - ma));
+    }
+#if CMIX_ADC_CURRENT_TABLE_ENABLE
+    CMix_Cosim_Check(error_mv <= 1.0 && error_ma <= CMIX_ADC_CURRENT_TABLE_LSB_MA,
+#else
+    CMix_Cosim_Check(error_mv <= 1.0 && error_ma <= 1.0,
+#endif
+                     "ADC换算 0~%u: 电压最大误差%.2f mV, 电流最大误差%.2f mA",
+                     (unsigned)CMIX_ADC_RESOLUTION, error_mv, error_ma);
+
+    /* 扩展码值换算 (1/16 LSB) 逐值比较 */
+    error_mv = 0.0;
+    error_ma = 0.0;
+    for (ext = 0; ext <= ((uint32_t)CMIX_ADC_RESOLUTION << CMIX_ADC_EXT_SHIFT); ext++) {
+        double fcode = (double)ext / (1 << CMIX_ADC_EXT_SHIFT);
+        double mv = fcode * CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO / CMIX_ADC_RESOLUTION;
+        double ma = fmax(-CMIX_ADC_CURRENT_LIMIT_MA, fmin(CMIX_ADC_CURRENT_LIMIT_MA, CMIX_ADC_CURRENT_CURVE_MA(fcode)));
+
+        error_mv = fmax(error_mv, fabs(CMix_Hardware_Convert_Voltage_Ext_mV((uint16_t)ext) - mv));
+        error_ma = fmax(error_ma, fabs(CMix_Hardware_Convert_Current_Ext_mA((uint16_t)ext) - ma));
+    }
+#if CMIX_ADC_CURRENT_TABLE_ENABLE
+    CMix_Cosim_Check(error_mv <= 1.0 && error_ma <= 2 * CMIX_ADC_CURRENT_TABLE_LSB_MA,
+#else
+    CMix_Cosim_Check(error_mv <= 1.0 && error_ma <= 1.0,
+#endif
+                     "扩展码值换算 0~%u: 电压最大误差%.2f mV, 电流最大误差%.2f mA",
+                     (unsigned)((uint32_t)CMIX_ADC_RESOLUTION << CMIX_ADC_EXT_SHIFT), error_mv, error_ma);
+
+    /* 抽取器: 码值1000/1001按1:3出现, 均值1000.75 LSB = 16012 (1/16 LSB) */
+    for (osr_log2 = 0; osr_log2 <= 8; osr_log2 += 2) {
+        CMix_ADC_Decimator_t dec = {0, 0, 0};
+        bool exact = true;
+
+        outputs = 0;
+        for (n = 0; n < 256; n++) {
+            if (CMix_Hardware_ADC_Decimate(&dec, (n & 3) == 0 ? 1000 : 1001, osr_log2)) {
+                outputs++;
+                exact = exact && (osr_log2 < 2 || dec.output == 16012);
+            }
+        }
+        CMix_Cosim_Check(outputs == (256U >> osr_log2) && exact,
+                         "抽取比%u: 输出%lu次, 末次%u (1/16 LSB)", 1U << osr_log2, (unsigned long)outputs,
+                         (unsigned)dec.output);
+    }
+    return true;
+}
+
+/**
+ * @brief 前馈场景: 倒数估计与精确除法逐值比较, 不经过功率级
+ * @param None
+ * @retval true = 通过
+ */
+static bool CMix_Cosim_Scenario_Feedforward(void)
+{
+    static const uint32_t setpoints[] = {12000, 24000, 48000, 60000};
+    const uint32_t full_range_mv = 70000;
+    const uint32_t walk_steps = 200000;
+    CMix_Recip_t recip;
+    uint32_t d, k, mismatches = 0, duty_errors = 0, updates = 0, guard_errors = 0;
+    uint32_t seed_max_iterations = 0;
+    uint64_t rng = 0x12345678;
+    uint32_t vin = 48000;
+    double mean_iterations;
+
+    /* 1. 查表初值: 2 ~ 2^32-1 (低段逐值, 高段按比例步进), 结果应为精确floor */
+    d = 2;
+    while (1) {
+        CMix_Recip_Init(&recip, 2, 0);
+        CMix_Recip_Update(&recip, d);
+        if (recip.recip != (uint32_t)(((uint64_t)1 << 32) / d)) {
+            mismatches++;
+        }
+        if (recip.iterations > seed_max_iterations) {
+            seed_max_iterations = recip.iterations;
+        }
+        if (d == 0xFFFFFFFFU) {
+            break;
+        }
+        k = (d < 1000000U) ? 1 : (d >> 12);
+        d = (d > 0xFFFFFFFFU - k) ? 0xFFFFFFFFU : d + k;
+    }
+    CMix_Cosim_Check(mismatches == 0, "查表初值: 除数2 ~ 2^32-1均得到精确floor(2^32/d), 最多迭代%u次",
+                     (unsigned)seed_max_iterations);
+
+    /* 2. BUCK前馈比值: 全输入电压范围逐mV, 与整数除法相差不超过1 (0.01%占空比) */
+    for (k = 0; k < sizeof(setpoints) / sizeof(setpoints[0]); k++) {
+        CMix_Recip_Init(&recip, CMIX_FF_MIN_DIVISOR_MV, 0);
+        for (d = CMIX_FF_MIN_DIVISOR_MV; d <= full_range_mv; d++) {
+            uint32_t expected = setpoints[k] * 10000U / d;
+            uint32_t actual;
+
+            CMix_Recip_Update(&recip, d);
+            actual = CMix_Recip_Mul(&recip, setpoints[k] * 10000U);
+            if (actual > expected || expected - actual > 1) {
+                duty_errors++;
+            }
+        }
+    }
+    CMix_Cosim_Check(duty_errors == 0, "前馈比值: %u ~ %u mV x %u个设定值, 与除法相差不超过1",
+                     (unsigned)CMIX_FF_MIN_DIVISOR_MV, (unsigned)full_range_mv,
+                     (unsigned)(sizeof(setpoints) / sizeof(setpoints[0])));
+
+    /* 3. 增量更新: 母线电压随机游走 (偶有跳变), 死区内保持, 超出死区后倒数精确 */
+    CMix_Recip_Init(&recip, CMIX_FF_MIN_DIVISOR_MV, CMIX_FF_DEADBAND_MV);
+    mismatches = 0;
+    for (k = 0; k < walk_steps; k++) {
+        uint32_t before = recip.divisor;
+
+        rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        if ((rng >> 54) == 0) {
+            vin = 10000 + (uint32_t)((rng >> 20) % 60000);          /* 跳变 */
+        } else {
+            vin = (uint32_t)CMix_Clamp32((int32_t)vin + (int32_t)((rng >> 33) % 101) - 50, 10000, 70000);
+        }
+        CMix_Recip_Update(&recip, vin);
+        if (recip.divisor != before) {
+            updates++;
+        }
+        if (recip.recip != (uint32_t)(((uint64_t)1 << 32) / recip.divisor) ||
+            (vin > recip.divisor ? vin - recip.divisor : recip.divisor - vin) > CMIX_FF_DEADBAND_MV) {
+            mismatches++;
+        }
+    }
+    mean_iterations = (double)recip.iterations / (updates ? updates : 1);
+    printf("  随机游走%u步: 更新%u次, 查表%u次, 牛顿迭代平均%.2f次/更新\n", (unsigned)walk_steps,
+           (unsigned)updates, (unsigned)recip.reseeds, mean_iterations);
+    CMix_Cosim_Check(mismatches == 0, "增量更新: 倒数精确, 除数与输入相差不超过死区%u mV",
+                     (unsigned)CMIX_FF_DEADBAND_MV);
+    CMix_Cosim_Check(mean_iterations < 1.5, "增量更新平均迭代少于1.5次");
+
+    /* 4. 除数下限: 5V -> 0V -> 5V, 低于下限时倒数无效且乘积为0, 回到下限以上后恢复 */
+    CMix_Recip_Init(&recip, CMIX_FF_MIN_DIVISOR_MV, CMIX_FF_DEADBAND_MV);
+    for (k = 0; k <= 2 * 5000; k++) {
+        d = (k <= 5000) ? 5000 - k : k - 5000;
+        CMix_Recip_Update(&recip, d);
+        if (d < CMIX_FF_MIN_DIVISOR_MV) {
+            if (CMix_Recip_Is_Valid(&recip) || CMix_Recip_Mul(&recip, 0xFFFFFFFFU) != 0) {
+                guard_errors++;
+            }
+        } else if (!CMix_Recip_Is_Valid(&recip) ||
+                   recip.recip != (uint32_t)(((uint64_t)1 << 32) / recip.divisor)) {
+            guard_errors++;
+        }
+    }
+    /* 下限小于2时按2处理, 除数0/1始终无效 */
+    CMix_Recip_Init(&recip, 0, 0);
+    CMix_Recip_Update(&recip, 0);
+    guard_errors += CMix_Recip_Is_Valid(&recip) ? 1 : 0;
+    CMix_Recip_Update(&recip, 1);
+    guard_errors += CMix_Recip_Is_Valid(&recip) ? 1 : 0;
+    CMix_Cosim_Check(guard_errors == 0, "除数下限: 低于%u mV时前馈为0, 除数0/1无效",
+                     (unsigned)CMIX_FF_MIN_DIVISOR_MV);
+    return true;
+}
+
+/**
+ * @brief 定点PI场景: 定点控制器与浮点参考以相同输入逐步运行, 输出相差不超过1 LSB
+ * @param None
+ * @retval true = 通过
+ * @note  定点输出向负无穷取整, 浮点输出同样向负无穷取整后比较 (前馈修正量为负时,
+ *        按控制环的用法截断会与定点取整方向相反, 另差1 LSB).
+ *        1 LSB的界要求单步积分增量 Ki*Ts*|误差| 远小于1 (固件增量下成立): 否则两者
+ *        在饱和边界上的一步条件积分判断不同, 积分值即相差一个增量
+ */
+static bool CMix_Cosim_Scenario_PID(void)
+{
+    static const struct {
+        const char *name;
+        float kp;
+        float ki;
+        int32_t output_min;
+        int32_t output_max;
+    } gains[] = {
+        {"电压环 (前馈修正量)", CMIX_VOLTAGE_PI_KP, CMIX_VOLTAGE_PI_KI, -10000, 10000},
+        {"电压环 (无前馈)",     CMIX_VOLTAGE_PI_KP, CMIX_VOLTAGE_PI_KI, 0, 10000},
+        {"电流环",              CMIX_CURRENT_PI_KP, CMIX_CURRENT_PI_KI, 0, 10000},
+    };
+    const uint32_t random_steps = 200000;
+    const uint32_t hold_steps = 50000;
+    const uint32_t drift_steps = 100000;
+    CMix_PID_Q_t fixed;
+    CMix_PI_Controller_t reference;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    uint32_t g, k, mismatches, drift_errors = 0;
+    int32_t setpoint, feedback, output, expected, diff, max_diff;
+    int32_t error;
+
+    for (g = 0; g < sizeof(gains) / sizeof(gains[0]); g++) {
+        CMix_PID_Init(&fixed, CMIX_Q15(gains[g].kp), CMIX_Q31(gains[g].ki * CMIX_CONTROL_PERIOD), 0,
+                      gains[g].output_min, gains[g].output_max);
+        CMix_DCDC_PI_Init(&reference, gains[g].kp, gains[g].ki, (float)gains[g].output_min,
+                          (float)gains[g].output_max);
+        mismatches = 0;
+        max_diff = 0;
+        setpoint = 24000;
+        feedback = 0;
+
+        /* 1. 随机: 设定值偶有0 ~ 60000跳变 (误差超出int16范围), 反馈向设定值收敛并带噪声
+         * 2. 饱和: 正向满量程误差保持, 再反向保持, 检查两者同样停止积分并同时退出饱和
+         * 3. 恢复: 设定值与反馈接近, 小误差运行 */
+        for (k = 0; k < random_steps + 3 * hold_steps; k++) {
+            rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+            if (k < random_steps) {
+                if ((rng >> 52) == 0) {
+                    setpoint = (int32_t)((rng >> 20) % 60001);
+                }
+                feedback += (setpoint - feedback) / 64 + (int32_t)((rng >> 33) % 401) - 200;
+            } else if (k < random_steps + hold_steps) {
+                setpoint = 60000;
+                feedback = 0;
+            } else if (k < random_steps + 2 * hold_steps) {
+                setpoint = 0;
+                feedback = 60000;
+            } else {
+                setpoint = 24000;
+                feedback = 24000 + (int32_t)((rng >> 33) % 41) - 20;
+            }
+            output = CMix_PID_Update(&fixed, setpoint, feedback);
+            expected = (int32_t)floorf(CMix_DCDC_PI_Update(&reference, (float)setpoint, (float)feedback));
+            diff = (output > expected) ? output - expected : expected - output;
+            if (diff > max_diff) {
+                max_diff = diff;
+            }
+            if (diff > 1) {
+                mismatches++;
+            }
+        }
+        CMix_Cosim_Check(mismatches == 0, "%s: %u步输出与浮点参考最大相差%ld LSB, 超过1 LSB %u步",
+                         gains[g].name, (unsigned)k, (long)max_diff, (unsigned)mismatches);
+
+        /* 4. 小误差无漂移: 正负对称的小误差交替, 积分值应精确回到初值
+         * (增量低于1 LSB时直接右移会使负误差每步减1而正误差不加) */
+        for (error = 1; error <= 20; error++) {
+            CMix_PID_Set_Integral(&fixed, 5000);
+            for (k = 0; k < drift_steps; k++) {
+                CMix_PID_Update(&fixed, 24000, 24000 - (((k & 1) == 0) ? error : -error));
+            }
+            if (fixed.integral_q15 != ((int32_t)5000 << CMIX_Q15_SHIFT)) {
+                drift_errors++;
+            }
+        }
+    }
+    CMix_Cosim_Check(drift_errors == 0, "±1 ~ ±20交替误差%u步后积分值不变", (unsigned)drift_steps);
+
+    /* 5. 大误差不截断: 误差±60000超出int16范围, 比例输出为 Kp * 误差 */
+    CMix_PID_Init(&fixed, CMIX_Q15(0.05f), 0, 0, -10000, 10000);
+    output = CMix_PID_Update(&fixed, 60000, 0);
+    expected = CMix_PID_Update(&fixed, 0, 60000);
+    CMix_Cosim_Check(output >= 2999 && output <= 3000 && expected >= -3000 && expected <= -2999,
+                     "Kp=0.05, 误差±60000: 输出 %ld / %ld (期望±3000)", (long)output, (long)expected);
+    return true;
+}
+
+/**
+ * @brief 从0V开始软启动到默认设定值
+ * @param model: 功率级模型
+ * @param battery_voltage: 电池电压
+ * @param metrics: 阶跃指标
+ * @retval true = 完成
+ */
+static bool CMix_Cosim_Startup(CMix_Plant_Model_t model, double battery_voltage, CMix_Plant_Metrics_t *metrics)
+{
+    const double duration_s = 1.5;
+    CMix_Plant_Params_t params;
+
+    CMix_Plant_Default_Params(&params);
+    params.model = model;
+    params.battery_voltage = battery_voltage;
+    CMix_Cosim_Start(&g_cosim, &params, g_trace);
+
+    CMix_Plant_Metrics_Start(metrics, 0.0, 0.0, CMIX_COSIM_DEFAULT_SETPOINT, CMIX_COSIM_SETTLING_BAND,
+                             duration_s - CMIX_COSIM_STEADY_WINDOW_S);
+    CMix_Cosim_Run(&g_cosim, duration_s, metrics);
+    CMix_Cosim_Check(metrics->finite, "功率级状态有限 (无NaN/Inf)");
+    return metrics->finite;
+}
+
+/**
+ * @brief 降压启动 (平均模型)
+ */
+static bool CMix_Cosim_Scenario_Buck_Start(void)
+{
+    CMix_Plant_Metrics_t metrics;
+
+    if (!CMix_Cosim_Startup(CMIX_PLANT_AVERAGED, 48.0, &metrics)) {
+        return false;
+    }
+    CMix_Cosim_Print_Summary();
+    CMix_Cosim_Print_Result("启动", &metrics);
+    CMix_Cosim_Check_Lockstep();
+    CMix_Cosim_Check(g_cosim.fault_time_s < 0.0, "无保护动作");
+    CMix_Cosim_Check(CMix_DCDC_Get_Status()->state == CMIX_STATE_RUNNING, "软启动结束进入运行状态");
+    CMix_Cosim_Check(CMix_DCDC_Get_Status()->active_mode == CMIX_MODE_BUCK, "自动选择BUCK模式");
+    CMix_Cosim_Check_Regulation(&metrics, 1.2);
+    return true;
+}
+
+/**
+ * @brief 降压启动 (开关模型)
+ */
+static bool CMix_Cosim_Scenario_Buck_Start_Switching(void)
+{
+    CMix_Plant_Metrics_t metrics;
+
+    if (!CMix_Cosim_Startup(CMIX_PLANT_SWITCHING, 48.0, &metrics)) {
+        return false;
+    }
+    CMix_Cosim_Print_Summary();
+    CMix_Cosim_Print_Result("启动", &metrics);
+    CMix_Cosim_Check_Lockstep();
+    CMix_Cosim_Check(g_cosim.fault_time_s < 0.0, "无保护动作");
+    CMix_Cosim_Check_Regulation(&metrics, 1.2);
+    return true;
+}
+
+/**
+ * @brief 设定值阶跃
+ */
+static bool CMix_Cosim_Scenario_Setpoint_Step(void)
+{
+    const double duration_s = 1.0;
+    CMix_Plant_Metrics_t metrics;
+    double t0, initial;
+
+    if (!CMix_Cosim_Startup(CMIX_PLANT_AVERAGED, 48.0, &metrics)) {
+        return false;
+    }
+    t0 = g_cosim.plant.time_s;
+    initial = g_cosim.plant.vout_avg;
+    CMix_DCDC_Set_Output_Voltage(30000);
+
+    CMix_Plant_Metrics_Start(&metrics, t0, initial, 30.0, CMIX_COSIM_SETTLING_BAND,
+                             t0 + duration_s - CMIX_COSIM_STEADY_WINDOW_S);
+    CMix_Cosim_Run(&g_cosim, duration_s, &metrics);
+    CMix_Cosim_Print_Summary();
+    CMix_Cosim_Print_Result("设定值阶跃", &metrics);
+    CMix_Cosim_Check(metrics.finite, "功率级状态有限 (无NaN/Inf)");
+    CMix_Cosim_Check_Lockstep();
+    CMix_Cosim_Check(g_cosim.fault_time_s < 0.0, "无保护动作");
+    CMix_Cosim_Check_Regulation(&metrics, 0.5);
+    return true;
+}
+
+/**
+ * @brief 负载阶跃
+ */
+static bool CMix_Cosim_Scenario_Load_Step(void)
+{
+    const double duration_s = 0.5;
+    CMix_Plant_Metrics_t metrics;
+    CMix_Plant_Result_t result;
+    double t0, initial, dip = 1e9;
+    char settle[24];
+
+    if (!CMix_Cosim_Startup(CMIX_PLANT_AVERAGED, 48.0, &metrics)) {
+        return false;
+    }
+    t0 = g_cosim.plant.time_s;
+    initial = g_cosim.plant.vout_avg;
+    g_cosim.plant.params.load_current = 5.0;
+
+    /* 恢复目标为阶跃前电压, 稳定带按阶跃前电压的2%计 */
+    CMix_Plant_Metrics_Start(&metrics, t0, initial * (1.0 - CMIX_COSIM_SETTLING_BAND) - 1e-9, initial, 1.0,
+                             t0 + duration_s - CMIX_COSIM_STEADY_WINDOW_S);
+    while (g_cosim.plant.time_s < t0 + duration_s - 1e-9) {
+        CMix_Cosim_Run(&g_cosim, 1e-3, &metrics);
+        if (g_cosim.plant.vout_avg < dip) {
+            dip = g_cosim.plant.vout_avg;
+        }
+    }
+    CMix_Plant_Metrics_Result(&metrics, &result);
+    CMix_Cosim_Format_ms(settle, sizeof(settle), result.settling_time_s, "未恢复");
+
+    CMix_Cosim_Print_Summary();
+    printf("  负载阶跃 +5A: 阶跃前 %.3f V, 最低 %.3f V (跌落 %.3f V), 恢复后 %.3f V, 恢复时间(±2%%) %s\n",
+           initial, dip, initial - dip, result.final_value, settle);
+    CMix_Cosim_Check(metrics.finite, "功率级状态有限 (无NaN/Inf)");
+    CMix_Cosim_Check_Lockstep();
+    CMix_Cosim_Check(g_cosim.fault_time_s < 0.0, "无保护动作");
+    CMix_Cosim_Check(initial >= CMIX_COSIM_DEFAULT_SETPOINT * (1.0 - CMIX_COSIM_SETTLING_BAND),
+                     "阶跃前已稳压 (%.3f V)", initial);
+    CMix_Cosim_Check_Regulation(&metrics, 0.2);
+    return true;
+}
+
+/**
+ * @brief 升压启动: 相A上管常通, 相B (CH2/CH2N) 斩波, 检查无保护动作和稳压
+ */
+static bool CMix_Cosim_Scenario_Boost_Start(void)
+{
+    CMix_Plant_Metrics_t metrics;
+
+    if (!CMix_Cosim_Startup(CMIX_PLANT_AVERAGED, 12.0, &metrics)) {
+        return false;
+    }
+    CMix_Cosim_Print_Summary();
+    CMix_Cosim_Print_Result("启动", &metrics);
+    CMix_Cosim_Check_Lockstep();
+    if (g_cosim.fault_time_s >= 0.0) {
+        printf("  保护动作时刻 %.3f ms\n", g_cosim.fault_time_s * 1e3);
+    }
+    CMix_Cosim_Check(CMix_DCDC_Get_Status()->active_mode == CMIX_MODE_BOOST, "自动选择BOOST模式");
+    CMix_Cosim_Check(g_cosim.fault_time_s < 0.0, "无保护动作");
+    CMix_Cosim_Check(CMix_Plant_HW_Get_Compare(1) == CMIX_PWM_COMPARE_SCALE, "相A上管常通 (比较值 %u)",
+                     (unsigned)CMix_Plant_HW_Get_Compare(1));
+    CMix_Cosim_Check_Regulation(&metrics, 1.2);
+    return true;
+}
+
+/**
+ * @brief 软启动中途故障后重启: 禁用不得清除锁存的故障, 复位故障后软启动从0占空比重新爬升
+ */
+static bool CMix_Cosim_Scenario_Restart(void)
+{
+    const double fault_at_s = 0.3;
+    const double ramp_check_s = 0.02;
+    const double duration_s = 1.5;
+    CMix_Plant_Params_t params;
+    CMix_Plant_Metrics_t metrics;
+    double t0, vout_before;
+
+    CMix_Plant_Default_Params(&params);
+    CMix_Cosim_Start(&g_cosim, &params, g_trace);
+    CMix_Cosim_Run(&g_cosim, fault_at_s, NULL);
+    vout_before = g_cosim.plant.vout_avg;
+    CMix_DCDC_Emergency_Stop(CMIX_ERROR_OVERCURRENT);
+
+    /* 禁用只回收软启动/运行状态, 故障保持锁存 */
+    CMix_DCDC_Enable(0);
+    CMix_Cosim_Run(&g_cosim, 0.01, NULL);
+    CMix_Cosim_Check(CMix_DCDC_Get_Status()->state == CMIX_STATE_FAULT, "禁用后故障保持锁存");
+
+    /* 故障状态下重新使能不输出 */
+    CMix_DCDC_Enable(1);
+    CMix_Cosim_Run(&g_cosim, 0.01, NULL);
+    CMix_Cosim_Check(CMix_DCDC_Get_Status()->state == CMIX_STATE_FAULT, "未复位故障时使能不退出故障状态");
+
+    /* 复位并让输出电容放电后重启 */
+    CMix_DCDC_Reset_Fault();
+    CMix_Cosim_Check(CMix_DCDC_Get_Status()->state == CMIX_STATE_SOFT_START, "复位故障后直接进入软启动");
+    CMix_DCDC_Enable(0);
+    g_cosim.plant.params.load_resistance = 0.5;
+    CMix_Cosim_Run(&g_cosim, 0.05, NULL);
+    g_cosim.plant.params.load_resistance = params.load_resistance;
+    CMix_Cosim_Check(CMix_DCDC_Get_Status()->state == CMIX_STATE_IDLE, "禁用后回到空闲");
+
+    t0 = g_cosim.plant.time_s;
+    CMix_DCDC_Enable(1);
+    CMix_Cosim_Run(&g_cosim, ramp_check_s, NULL);
+    printf("  故障前 %.3f V, 重启后%.0f ms %.3f V\n", vout_before, ramp_check_s * 1e3, g_cosim.plant.vout_avg);
+    CMix_Cosim_Check(g_cosim.plant.vout_avg < 0.1 * CMIX_COSIM_DEFAULT_SETPOINT,
+                     "重启后软启动从0开始 (%.0f ms时 %.3f V)", ramp_check_s * 1e3, g_cosim.plant.vout_avg);
+
+    CMix_Plant_Metrics_Start(&metrics, t0, 0.0, CMIX_COSIM_DEFAULT_SETPOINT, CMIX_COSIM_SETTLING_BAND,
+                             t0 + duration_s - CMIX_COSIM_STEADY_WINDOW_S);
+    CMix_Cosim_Run(&g_cosim, duration_s - ramp_check_s, &metrics);
+    CMix_Cosim_Print_Summary();
+    CMix_Cosim_Print_Result("重启", &metrics);
+    CMix_Cosim_Check(metrics.finite, "功率级状态有限 (无NaN/Inf)");
+    CMix_Cosim_Check(CMix_DCDC_Get_Status()->state == CMIX_STATE_RUNNING, "重启后软启动结束进入运行状态");
+    CMix_Cosim_Check_Regulation(&metrics, 1.2);
+    return true;
+}
+
+#if CMIX_PWM_INTERLEAVE_ENABLE
+/**
+ * @brief 两相交错: 开环比较同相与180°交错的输出纹波, 闭环检查相B驱动失配下的均流、
+ *        稳压和稳态纹波
+ */
+static bool CMix_Cosim_Scenario_Interleave(void)
+{
+    const double open_loop_s = 0.02;
+    const double duration_s = 1.5;
+    const double duty_offset = 0.002;       // 约20ns驱动延时失配
+    CMix_Plant_Params_t params;
+    CMix_Plant_Metrics_t metrics;
+    CMix_DCDC_Status_t *status;
+    double ripple[2], imbalance = 0.0, expected;
+    uint32_t samples = 0;
+    int m;
+
+    /* 1. 开环50%占空比: 交错时两相纹波电流互相抵消 */
+    CMix_Plant_Default_Params(&params);
+    params.model = CMIX_PLANT_SWITCHING;
+    for (m = 0; m < 2; m++) {
+        CMix_Plant_t plant;
+
+        params.phase_shift = (m == 0) ? 0.0 : 0.5;
+        CMix_Plant_Init(&plant, &params);
+        while (plant.time_s < open_loop_s) {
+            CMix_Plant_Step(&plant, CMIX_PWM_COMPARE_SCALE / 2, CMIX_PWM_COMPARE_SCALE / 2, CMIX_PWM_COMPARE_SCALE);
+        }
+        ripple[m] = plant.vout_max - plant.vout_min;
+    }
+    CMix_Cosim_Check(ripple[1] < 0.5 * ripple[0], "50%%占空比输出纹波: 同相 %.1f mVpp, 交错 %.1f mVpp",
+                     ripple[0] * 1e3, ripple[1] * 1e3);
+
+    /* 2. 闭环软启动, 相B有效占空比偏大: 开环时两相电流差约为 偏差 * Vin / DCR */
+    params.phase_shift = 0.5;
+    params.phase_b_duty_offset = duty_offset;
+    CMix_Cosim_Start(&g_cosim, &params, g_trace);
+    CMix_Plant_Metrics_Start(&metrics, 0.0, 0.0, CMIX_COSIM_DEFAULT_SETPOINT, CMIX_COSIM_SETTLING_BAND,
+                             duration_s - CMIX_COSIM_STEADY_WINDOW_S);
+    while (g_cosim.plant.time_s < duration_s - 1e-9) {
+        CMix_Cosim_Run(&g_cosim, 1e-3, &metrics);
+        if (g_cosim.plant.time_s >= duration_s - CMIX_COSIM_STEADY_WINDOW_S) {
+            imbalance += g_cosim.plant.ia_avg - g_cosim.plant.ib_avg;
+            samples++;
+        }
+    }
+    imbalance /= (samples ? samples : 1);
+    expected = duty_offset * params.battery_voltage / params.inductor_dcr_ohm;
+    status = CMix_DCDC_Get_Status();
+
+    CMix_Cosim_Check(metrics.finite, "功率级状态有限 (无NaN/Inf)");
+    CMix_Cosim_Print_Summary();
+    CMix_Cosim_Print_Result("启动", &metrics);
+    printf("  相电流 %.2f A / %.2f A, 均流修正 %+ld (0.01%%), 开环不均约 %.1f A\n",
+           g_cosim.plant.ia_avg, g_cosim.plant.ib_avg, (long)status->phase_trim, expected);
+    CMix_Cosim_Check_Lockstep();
+    CMix_Cosim_Check(g_cosim.fault_time_s < 0.0, "无保护动作");
+    CMix_Cosim_Check(status->state == CMIX_STATE_RUNNING, "软启动结束进入运行状态");
+    CMix_Cosim_Check(fabs(imbalance) < 0.5 && fabs(imbalance) < 0.05 * expected,
+                     "稳态两相电流差 %.3f A (开环约 %.1f A)", imbalance, expected);
+    CMix_Cosim_Check_Regulation(&metrics, 1.2);
+    return true;
+}
+#endif
+
+/**
+ * @brief 运行单个场景
+ * @param scenario: 场景
+ * @retval 0 = 通过, 1 = 失败
+ */
+static int CMix_Cosim_Run_Scenario(const CMix_Cosim_Scenario_t *scenario)
+{
+    bool completed;
+
+    printf("== %s: %s\n", scenario->name, scenario->description);
+    g_failures = 0;
+    completed = scenario->run();
+    if (g_trace != NULL) {
+        fflush(g_trace);
+    }
+    return (completed && g_failures == 0) ? 0 : 1;
+}
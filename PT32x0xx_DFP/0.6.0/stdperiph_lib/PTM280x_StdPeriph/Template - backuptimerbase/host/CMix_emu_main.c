@@ -0,0 +1,1840 @@
+/******************************************************************************
+  * @file    CMix_emu_main.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix主机仿真运行程序
+  *          在仿真器上运行完整固件, 按场景注入激励并检查协议输出和时序
+  ******************************************************************************
+  * @attention
+  *
+  * 用法: cmix_emu [all|boot|protocol|control|cmp_trip|pwm_commit|awd_trip|param_store|blackbox|telemetry|scope] [-v] [-o 文件]
+  *   all         每个场景在独立子进程中运行 (仿真器状态互不影响)
+  *   -v          打印固件调试帧
+  *   -o 文件     UART0发送的原始字节写入文件
+  *
+  * 返回值: 0 = 全部场景通过, 1 = 有检查失败, 2 = 用法错误
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "CMix_emu.h"
+#define main CMix_Firmware_Main         /* 固件main()在主机程序中改名 (见Makefile) */
+#include "CMix_main.h"
+#undef main
+#include "CMix_param.h"
+#include "CMix_blackbox.h"
+#include "CMix_telemetry.h"
+#include "CMix_scope.h"
+#include "trace/CMix_trace_decode.h"
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_RUNNER_FRAME_DATA_MAX      64          // 与CMIX_PROTOCOL_MAX_DATA_LEN一致
+#define CMIX_RUNNER_CMD_MAX             32          // 统计的命令码范围
+#define CMIX_RUNNER_DEBUG_MAX           32          // 保存的调试文本条数 (文本帧和还原的跟踪记录)
+
+/*
+ * 默认ADC输入: Vin = 48V (1:20分压, 3.3V换算), Vout = 0V,
+ * 电流通道取中点 (TP181A1零电流输出).
+ */
+#define CMIX_RUNNER_ADC_VIN_RAW         2978
+#define CMIX_RUNNER_ADC_VOUT_RAW        0
+#define CMIX_RUNNER_ADC_CURRENT_RAW     2048
+#define CMIX_RUNNER_ADC_BANDGAP_RAW     819         // 1.0V / 5.0V * 4095
+
+/* 比较器正端与ADC电压通道同一分压: 引脚mV = 电压mV * VDDA / (3.3V换算 * 20) */
+#define CMIX_RUNNER_VDDA_MV             5000
+#define CMIX_RUNNER_CMP_PIN_MV(mv)      ((uint32_t)((uint64_t)(mv) * CMIX_RUNNER_VDDA_MV / \
+                                                    ((uint32_t)CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO)))
+#define CMIX_RUNNER_CMP_VIN_MV          48000       // 默认Vin, 与CMIX_RUNNER_ADC_VIN_RAW一致
+#define CMIX_RUNNER_CMP_MARGIN_MV       20          // 阈值上下注入的引脚电压裕量 (mV)
+
+/* 模拟看门狗场景: 相A限流20A时注入30A, Vout限值60V时注入61.2V */
+#define CMIX_RUNNER_AWD_LIMIT_MA        20000
+#define CMIX_RUNNER_AWD_CURRENT_RAW     2355        // 2047.5 + 30A * 10.24码/A
+#define CMIX_RUNNER_AWD_VOUT_RAW        3800
+
+/* 参数存储场景: 突发修改输出功率, 突发之间的空闲超过CMIX_PARAM_ERASE_IDLE_MS以便擦除 */
+#define CMIX_RUNNER_PARAM_BURSTS        4
+#define CMIX_RUNNER_PARAM_BURST_SETS    60
+#define CMIX_RUNNER_PARAM_FRAME_MS      5           // 设置帧间隔 (ms)
+#define CMIX_RUNNER_PARAM_GAP_MS        250         // 突发之间的空闲 (ms)
+#define CMIX_RUNNER_PARAM_FLUSH_MS      2000        // 等待写入完成的上限 (ms)
+#define CMIX_RUNNER_PARAM_POWER_BASE    20000       // 突发中输出功率设置值的起点 (mW)
+
+/* 黑匣子场景: 触发前Vin阶跃到约53V, 经过CMIX_RUNNER_BLACKBOX_STEP_MS后Vin比较器越限 */
+#define CMIX_RUNNER_BLACKBOX_VIN_RAW    3300
+#define CMIX_RUNNER_BLACKBOX_STEP_MS    2
+#define CMIX_RUNNER_BLACKBOX_COMMIT_MS  1000        // 等待快照写入完成的上限 (ms)
+#define CMIX_RUNNER_BLACKBOX_READ_MS    10          // 每块读出等待应答的时间 (ms)
+#define CMIX_RUNNER_BLACKBOX_IMAGE_MAX  (CMIX_BLACKBOX_HEADER_WORDS * 4 + CMIX_BLACKBOX_SAMPLES * sizeof(CMix_Blackbox_Sample_t))
+
+/* 遥测流场景: 订阅Vin/输入电流/状态, 最坏情况字节率恰好等于上限 */
+#define CMIX_RUNNER_TELEMETRY_WINDOW_MS 200
+#define CMIX_RUNNER_TELEMETRY_ACK_MS    20          // 订阅命令等待应答的时间 (ms, 应答排在遥测帧积压之后)
+#define CMIX_RUNNER_TELEMETRY_LAG_MS    30          // 记录到发送完成的最大滞后 (凑帧等待 + 发送队列积压)
+
+/* 示波器场景: Vin从约48V阶跃到约53V, 在50V上升沿触发 */
+#define CMIX_RUNNER_SCOPE_VIN_RAW       3300
+#define CMIX_RUNNER_SCOPE_LEVEL         (50000 >> CMIX_PROBE_VOLTAGE_SHIFT)
+#define CMIX_RUNNER_SCOPE_REPLY_MS      10          // 每条命令等待应答/回复的时间 (ms)
+#define CMIX_RUNNER_SCOPE_DONE_MS       50          // 等待采集完成的上限 (ms)
+#define CMIX_RUNNER_SCOPE_DIVISOR       4           // 强制触发采集的分频
+#define CMIX_RUNNER_SCOPE_REPLY         0x100       // CMix_Runner_Scope_Request: 收到CMIX_CMD_SCOPE回复帧
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 协议帧解码器 (UART0发送方向) */
+typedef struct {
+    uint8_t buffer[CMIX_RUNNER_FRAME_DATA_MAX + 5];
+    uint16_t index;
+    uint32_t frames;                                    // CRC正确的帧数
+    uint32_t bad_frames;                                // CRC错误或长度非法
+    uint32_t cmd_count[CMIX_RUNNER_CMD_MAX];
+    uint64_t cmd_cycle[CMIX_RUNNER_CMD_MAX];            // 最近一帧最后字节的发送完成时刻
+    uint8_t cmd_data[CMIX_RUNNER_CMD_MAX][CMIX_RUNNER_FRAME_DATA_MAX];
+    uint8_t cmd_len[CMIX_RUNNER_CMD_MAX];
+    char debug[CMIX_RUNNER_DEBUG_MAX][CMIX_TRACE_DECODE_TEXT_MAX];
+    uint32_t debug_count;
+    CMix_Trace_Decoder_t trace;                         // 跟踪记录帧 (CMIX_CMD_TRACE)
+} CMix_Runner_Decoder_t;
+
+/* 遥测流接收 (CMIX_CMD_TELEMETRY, 按当前订阅拆分记录) */
+typedef struct {
+    uint8_t count;                                      // 订阅的槽位数
+    uint8_t signal[CMIX_RUNNER_FRAME_DATA_MAX / 3];
+    uint16_t decimation[CMIX_RUNNER_FRAME_DATA_MAX / 3];
+    uint32_t frames;
+    uint32_t bytes;                                     // 遥测帧总字节数 (含帧头和CRC)
+    uint32_t records;
+    uint32_t lost;                                      // 固件报告的丢失记录数
+    uint32_t sequence_gaps;
+    uint32_t bad_records;                               // 记录截断或掩码含未订阅槽位
+    uint32_t cadence_errors;                            // 槽位相邻两次采样的间隔不等于分频
+    uint32_t first_step;                                // 第一条记录的控制步计数
+    uint32_t step;                                      // 最近一条记录的控制步计数 (展开为32位)
+    uint32_t samples[CMIX_RUNNER_FRAME_DATA_MAX / 3];
+    uint32_t last_step[CMIX_RUNNER_FRAME_DATA_MAX / 3];
+    uint16_t last_value[CMIX_RUNNER_FRAME_DATA_MAX / 3];
+    uint8_t next_sequence;
+} CMix_Runner_Telemetry_t;
+
+/* 场景 */
+typedef struct {
+    const char *name;
+    bool (*run)(void);
+    const char *description;
+} CMix_Runner_Scenario_t;
+
+/* ========================= 全局变量 ========================= */
+
+static CMix_Runner_Decoder_t g_decoder;
+static bool g_verbose = false;
+static int g_output_fd = -1;
+static uint32_t g_failures = 0;
+static CMix_Runner_Telemetry_t g_telemetry_rx;
+
+/* ========================= 私有函数声明 ========================= */
+
+extern void SystemInit(void);
+
+static void CMix_Runner_Reset_Handler(void);
+static uint16_t CMix_Runner_CRC16(const uint8_t *data, uint16_t length);
+static void CMix_Runner_Decode_Byte(void *context, uint8_t byte, uint64_t cycle);
+static void CMix_Runner_Store_Debug(void *context, uint16_t ms, const char *text);
+static void CMix_Runner_Telemetry_Frame(const uint8_t *data, uint8_t len);
+static void CMix_Runner_Send_Frame(uint8_t cmd, const uint8_t *data, uint8_t len, bool corrupt);
+static bool CMix_Runner_Find_Debug(const char *text);
+static void CMix_Runner_Check(bool condition, const char *format, ...) __attribute__((format(printf, 2, 3)));
+static bool CMix_Runner_Boot(uint32_t ms);
+static bool CMix_Runner_Run_ms(uint32_t ms);
+static void CMix_Runner_Print_IRQ_Table(void);
+static bool CMix_Runner_Fork(bool (*phase)(void), const char *name);
+static bool CMix_Runner_Scenario_Boot(void);
+static bool CMix_Runner_Scenario_Protocol(void);
+static bool CMix_Runner_Scenario_Control(void);
+static bool CMix_Runner_Scenario_CMP_Trip(void);
+#if CMIX_PWM_PRELOAD_ENABLE
+static void CMix_Runner_Stage_PWM(const uint16_t *duty, uint16_t *pulse);
+static bool CMix_Runner_Compare_Equals(const uint16_t *pulse);
+static bool CMix_Runner_Scenario_PWM_Commit(void);
+#endif
+#if CMIX_ADC_AWD_ENABLE
+static bool CMix_Runner_AWD_Inject(uint8_t channel, uint16_t raw, const char *name);
+static bool CMix_Runner_Scenario_AWD_Trip(void);
+#endif
+#if CMIX_PARAM_STORE_ENABLE
+static bool CMix_Runner_Param_Set(uint8_t cmd, uint16_t value);
+static bool CMix_Runner_Param_Flush(uint32_t *elapsed_ms);
+static bool CMix_Runner_Param_First_Boot(void);
+static bool CMix_Runner_Param_Rotate(void);
+static bool CMix_Runner_Scenario_Param_Store(void);
+#endif
+#if CMIX_BLACKBOX_ENABLE
+static int CMix_Runner_Blackbox_Request(uint8_t index);
+static bool CMix_Runner_Blackbox_Read_All(uint8_t *image, uint32_t *length);
+static bool CMix_Runner_Blackbox_Capture(void);
+static bool CMix_Runner_Blackbox_Reboot(void);
+static bool CMix_Runner_Scenario_Blackbox(void);
+#endif
+#if CMIX_TELEMETRY_ENABLE
+static int CMix_Runner_Telemetry_Subscribe(const uint8_t *data, uint8_t len);
+static bool CMix_Runner_Scenario_Telemetry(void);
+#endif
+#if CMIX_SCOPE_ENABLE
+static int CMix_Runner_Scope_Request(const uint8_t *data, uint8_t len);
+static bool CMix_Runner_Scope_Read_All(uint8_t *record, uint32_t *length);
+static bool CMix_Runner_Scenario_Scope(void);
+#endif
+static int CMix_Runner_Run_Scenario(const CMix_Runner_Scenario_t *scenario);
+static int CMix_Runner(int argc, char **argv);
+
+static const CMix_Runner_Scenario_t g_scenarios[] = {
+    {"boot",     CMix_Runner_Scenario_Boot,     "启动自检、状态上报周期、系统节拍"},
+    {"protocol", CMix_Runner_Scenario_Protocol, "命令应答延迟、突发吞吐、CRC错误应答"},
+    {"control",  CMix_Runner_Scenario_Control,  "ADC扫描/控制中断速率与开销"},
+    {"cmp_trip", CMix_Runner_Scenario_CMP_Trip, "比较器保护: LDAC阈值、越限到刹车延迟、中断只记录事件"},
+#if CMIX_PWM_PRELOAD_ENABLE
+    {"pwm_commit", CMix_Runner_Scenario_PWM_Commit, "PWM两阶段提交: 四路同一更新事件生效、保护窗内提交推迟一周期"},
+#endif
+#if CMIX_ADC_AWD_ENABLE
+    {"awd_trip", CMix_Runner_Scenario_AWD_Trip, "ADC模拟看门狗保护: 协议限值、首次越限扫描、刹车延迟、通道统计"},
+#endif
+#if CMIX_PARAM_STORE_ENABLE
+    {"param_store", CMix_Runner_Scenario_Param_Store, "参数存储: 复位后恢复、后台写入延迟、换页与擦除均衡、编程停顿"},
+#endif
+#if CMIX_BLACKBOX_ENABLE
+    {"blackbox", CMix_Runner_Scenario_Blackbox, "故障黑匣子: 触发前后窗口、快照写入与CRC、复位后分块读出、清除"},
+#endif
+#if CMIX_TELEMETRY_ENABLE
+    {"telemetry", CMix_Runner_Scenario_Telemetry, "遥测流: 订阅检查、各信号按分频采样、帧序号连续、与状态上报共用发送队列、停止"},
+#endif
+#if CMIX_SCOPE_ENABLE
+    {"scope", CMix_Runner_Scenario_Scope, "片内示波器: 设置检查、沿触发位置与触发前样本、冻结后分块读出、强制触发与分频"},
+#endif
+};
+
+#define CMIX_RUNNER_SCENARIO_COUNT  (sizeof(g_scenarios) / sizeof(g_scenarios[0]))
+
+/* ========================= 程序入口 ========================= */
+
+int main(int argc, char **argv)
+{
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    return CMix_Emu_Main(CMix_Runner, argc, argv);
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 固件入口 (相当于启动文件中的Reset_Handler)
+ * @param None
+ * @retval None
+ */
+static void CMix_Runner_Reset_Handler(void)
+{
+    SystemInit();
+    CMix_Firmware_Main();
+}
+
+/**
+ * @brief CRC16-Modbus (独立于固件实现, 用于校验固件输出)
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval CRC16值
+ */
+static uint16_t CMix_Runner_CRC16(const uint8_t *data, uint16_t length)
+{
+    uint16_t crc = 0xFFFF;
+    uint16_t i;
+    uint8_t bit;
+
+    for (i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief UART0发送字节回调: 重组协议帧并统计
+ * @param context: 未使用
+ * @param byte: 发送完成的字节
+ * @param cycle: 发送完成时刻
+ * @retval None
+ */
+static void CMix_Runner_Decode_Byte(void *context, uint8_t byte, uint64_t cycle)
+{
+    CMix_Runner_Decoder_t *decoder = &g_decoder;
+    uint8_t cmd, len;
+    uint16_t crc;
+
+    (void)context;
+
+    if (decoder->index == 0 && byte != 0x7E) {
+        return;                                         // 等待帧头
+    }
+    decoder->buffer[decoder->index++] = byte;
+
+    if (decoder->index == 3 && decoder->buffer[2] > CMIX_RUNNER_FRAME_DATA_MAX) {
+        decoder->bad_frames++;
+        decoder->index = 0;
+        return;
+    }
+    if (decoder->index < 3 || decoder->index < (uint16_t)(decoder->buffer[2] + 5)) {
+        return;
+    }
+
+    /* 整帧接收完成 */
+    cmd = decoder->buffer[1];
+    len = decoder->buffer[2];
+    crc = (uint16_t)(decoder->buffer[3 + len] | (decoder->buffer[4 + len] << 8));
+    decoder->index = 0;
+
+    if (crc != CMix_Runner_CRC16(decoder->buffer, (uint16_t)(3 + len))) {
+        decoder->bad_frames++;
+        return;
+    }
+    decoder->frames++;
+    if (cmd >= CMIX_RUNNER_CMD_MAX) {
+        return;
+    }
+    decoder->cmd_count[cmd]++;
+    decoder->cmd_cycle[cmd] = cycle;
+    decoder->cmd_len[cmd] = len;
+    memcpy(decoder->cmd_data[cmd], &decoder->buffer[3], len);
+
+    if (g_verbose && cmd != 0x0A && cmd != 0x0E && cmd != 0x0F && cmd != 0x10) {
+        printf("    [%10.1f us] frame 0x%02X len %u\n", CMix_Emu_Cycles_To_us(cycle), cmd, len);
+    }
+    if (cmd == 0x0A) {
+        char text[CMIX_RUNNER_FRAME_DATA_MAX + 1];
+
+        memcpy(text, &decoder->buffer[3], len);
+        text[len] = '\0';
+        CMix_Runner_Store_Debug(&cycle, 0, text);
+    } else if (cmd == 0x0E) {
+        CMix_Trace_Decode_Frame(&decoder->trace, &decoder->buffer[3], len, CMix_Runner_Store_Debug, &cycle);
+    } else if (cmd == 0x0F) {
+        CMix_Runner_Telemetry_Frame(&decoder->buffer[3], len);
+    }
+}
+
+/**
+ * @brief 拆分一帧遥测数据: 检查帧序号、记录长度和各槽位的采样间隔
+ * @param data: 帧数据 (帧序号, 丢失记录数, 记录...)
+ * @param len: 帧数据长度
+ * @retval None
+ */
+static void CMix_Runner_Telemetry_Frame(const uint8_t *data, uint8_t len)
+{
+    CMix_Runner_Telemetry_t *rx = &g_telemetry_rx;
+    uint16_t pos = 2, step;
+    uint8_t mask, slot;
+
+    if (len < 2) {
+        rx->bad_records++;
+        return;
+    }
+    if (rx->frames > 0 && data[0] != rx->next_sequence) {
+        rx->sequence_gaps++;
+    }
+    rx->next_sequence = (uint8_t)(data[0] + 1);
+    rx->lost += data[1];
+    rx->frames++;
+    rx->bytes += (uint32_t)len + 5;
+
+    while (pos + 3 <= len) {
+        step = (uint16_t)(data[pos] | (data[pos + 1] << 8));
+        mask = data[pos + 2];
+        pos += 3;
+        if (rx->records == 0) {
+            rx->step = step;
+            rx->first_step = step;
+        } else {
+            rx->step += (uint16_t)(step - (uint16_t)rx->step);
+        }
+        rx->records++;
+        if (mask == 0 || (rx->count < 8 && (mask >> rx->count) != 0)) {
+            rx->bad_records++;
+            return;
+        }
+        for (slot = 0; slot < rx->count; slot++) {
+            if ((mask & (1U << slot)) == 0) {
+                continue;
+            }
+            if (pos + 2 > len) {
+                rx->bad_records++;
+                return;
+            }
+            if (rx->samples[slot] > 0 && rx->lost == 0 && rx->step - rx->last_step[slot] != rx->decimation[slot]) {
+                rx->cadence_errors++;
+            }
+            rx->last_value[slot] = (uint16_t)(data[pos] | (data[pos + 1] << 8));
+            rx->last_step[slot] = rx->step;
+            rx->samples[slot]++;
+            pos += 2;
+        }
+    }
+    if (pos != len) {
+        rx->bad_records++;
+    }
+}
+
+/**
+ * @brief 保存一条调试文本 (文本帧或还原的跟踪记录)
+ * @param context: 帧最后字节的发送完成时刻 (uint64_t *)
+ * @param ms: 跟踪记录的固件时间 (未使用, 按帧发送时刻打印)
+ * @param text: 文本
+ * @retval None
+ */
+static void CMix_Runner_Store_Debug(void *context, uint16_t ms, const char *text)
+{
+    char *slot = g_decoder.debug[g_decoder.debug_count % CMIX_RUNNER_DEBUG_MAX];
+
+    (void)ms;
+    snprintf(slot, CMIX_TRACE_DECODE_TEXT_MAX, "%s", text);
+    g_decoder.debug_count++;
+    if (g_verbose) {
+        printf("    [%10.1f us] %s\n", CMix_Emu_Cycles_To_us(*(const uint64_t *)context), slot);
+    }
+}
+
+/**
+ * @brief 向UART0接收方向注入一帧命令
+ * @param cmd: 命令码
+ * @param data: 数据
+ * @param len: 数据长度
+ * @param corrupt: true时破坏CRC
+ * @retval None
+ */
+static void CMix_Runner_Send_Frame(uint8_t cmd, const uint8_t *data, uint8_t len, bool corrupt)
+{
+    uint8_t frame[CMIX_RUNNER_FRAME_DATA_MAX + 5];
+    uint16_t crc;
+
+    frame[0] = 0x7E;
+    frame[1] = cmd;
+    frame[2] = len;
+    if (len > 0) {
+        memcpy(&frame[3], data, len);
+    }
+    crc = CMix_Runner_CRC16(frame, (uint16_t)(3 + len));
+    if (corrupt) {
+        crc ^= 0x5A5A;
+    }
+    frame[3 + len] = (uint8_t)(crc & 0xFF);
+    frame[4 + len] = (uint8_t)(crc >> 8);
+    CMix_Emu_UART_Inject(frame, (uint16_t)(5 + len));
+}
+
+/**
+ * @brief 查找包含指定文本的调试帧
+ * @param text: 文本
+ * @retval true = 找到
+ */
+static bool CMix_Runner_Find_Debug(const char *text)
+{
+    uint32_t count = g_decoder.debug_count;
+    uint32_t i;
+
+    if (count > CMIX_RUNNER_DEBUG_MAX) {
+        count = CMIX_RUNNER_DEBUG_MAX;
+    }
+    for (i = 0; i < count; i++) {
+        if (strstr(g_decoder.debug[i], text) != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 检查并打印结果
+ * @param condition: 检查条件
+ * @param format: 描述
+ * @retval None
+ */
+static void CMix_Runner_Check(bool condition, const char *format, ...)
+{
+    va_list args;
+
+    printf("  [%s] ", condition ? " OK " : "FAIL");
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+
+    if (!condition) {
+        g_failures++;
+    }
+}
+
+/**
+ * @brief 初始化仿真器并运行固件启动过程
+ * @param ms: 运行时长 (ms)
+ * @retval true = 运行到指定时间
+ */
+static bool CMix_Runner_Boot(uint32_t ms)
+{
+    uint8_t channel;
+
+    CMix_Emu_Init();
+    memset(&g_decoder, 0, sizeof(g_decoder));
+    CMix_Emu_UART_Set_TX_Hook(CMix_Runner_Decode_Byte, NULL);
+    CMix_Emu_UART_Set_Output(g_output_fd);
+
+    for (channel = 0; channel < 16; channel++) {
+        CMix_Emu_ADC_Set_Channel(channel, CMIX_RUNNER_ADC_CURRENT_RAW);
+    }
+    CMix_Emu_ADC_Set_Channel(CMIX_ADC_VIN_CHANNEL, CMIX_RUNNER_ADC_VIN_RAW);
+    CMix_Emu_ADC_Set_Channel(CMIX_ADC_VOUT_CHANNEL, CMIX_RUNNER_ADC_VOUT_RAW);
+    CMix_Emu_ADC_Set_Channel(CMIX_ADC_BANDGAP_CHANNEL, CMIX_RUNNER_ADC_BANDGAP_RAW);
+    CMix_Emu_CMP_Set_Input(1, CMIX_RUNNER_CMP_PIN_MV(CMIX_RUNNER_CMP_VIN_MV));
+    CMix_Emu_CMP_Set_Input(0, 0);
+
+    CMix_Emu_Start(CMix_Runner_Reset_Handler);
+    return CMix_Runner_Run_ms(ms);
+}
+
+/**
+ * @brief 继续运行固件
+ * @param ms: 运行时长 (ms)
+ * @retval true = 运行到指定时间
+ */
+static bool CMix_Runner_Run_ms(uint32_t ms)
+{
+    CMix_Emu_Stop_t stop = CMix_Emu_Run_For_us((uint64_t)ms * 1000);
+
+    if (stop != CMIX_EMU_STOP_TIME) {
+        CMix_Runner_Check(false, "固件在%.3f ms处停止: %s",
+                          CMix_Emu_Cycles_To_us(CMix_Emu_Cycle()) / 1000.0, CMix_Emu_Stop_Reason());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 打印中断统计表
+ * @param None
+ * @retval None
+ */
+static void CMix_Runner_Print_IRQ_Table(void)
+{
+    int irqn;
+
+    printf("  %-8s %8s %12s %12s %12s %10s\n", "IRQ", "entries", "lat_avg(cy)", "lat_max(cy)", "cycles/isr", "host ns");
+    for (irqn = CMIX_EMU_IRQ_SYSTICK; irqn < CMIX_EMU_IRQ_COUNT; irqn++) {
+        const CMix_Emu_IRQ_Stats_t *stats = CMix_Emu_Get_IRQ_Stats(irqn);
+        if (stats == NULL || stats->entries == 0) {
+            continue;
+        }
+        printf("  %-8d %8u %12.1f %12u %12.1f %10.0f\n", irqn, (unsigned)stats->entries,
+               (double)stats->latency_sum / stats->entries, (unsigned)stats->latency_max,
+               (double)stats->busy_cycles / stats->entries, (double)stats->host_ns / stats->entries);
+    }
+}
+
+/* ========================= 场景 ========================= */
+
+/**
+ * @brief 在子进程中从复位运行一个阶段 (Flash内容经共享映射保留给下一阶段, 相当于掉电重启)
+ * @param phase: 阶段函数
+ * @param name: 阶段名称
+ * @retval true = 阶段通过
+ */
+static bool CMix_Runner_Fork(bool (*phase)(void), const char *name)
+{
+    pid_t pid;
+    int status = 0;
+
+    printf("  -- %s\n", name);
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0) {
+        bool completed = phase();
+        CMix_Emu_UART_Set_Output(-1);
+        fflush(stdout);
+        _exit((completed && g_failures == 0) ? 0 : 1);
+    }
+    if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        CMix_Runner_Check(false, "%s失败", name);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 启动场景: 自检结果、启动信息、周期上报、系统节拍
+ * @param None
+ * @retval true = 通过
+ */
+static bool CMix_Runner_Scenario_Boot(void)
+{
+    const uint32_t run_ms = 1500;
+    const CMix_Emu_IRQ_Stats_t *dma;
+    CMix_Emu_Stats_t stats;
+    uint32_t tick, expected_tick, reports;
+
+    if (!CMix_Runner_Boot(run_ms)) {
+        return false;
+    }
+    CMix_Emu_Get_Stats(&stats);
+
+    CMix_Runner_Check(CMix_Runner_Find_Debug("Started"), "启动信息帧");
+    CMix_Runner_Check(CMix_Runner_Find_Debug("CRC64: hw=1 test=0x00"), "CRC硬件/DMA自检一致 (64字节)");
+    {
+        /* 两路实际动作电压 = 配置值向下取整到LDAC级 */
+        uint32_t full_mv = (uint32_t)CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO;
+        uint32_t trip_mv = CMIX_CMP_THRESHOLD_MV * CMIX_CMP_LDAC_STEPS / full_mv * full_mv / CMIX_CMP_LDAC_STEPS;
+        char cmp_line[96];
+
+        snprintf(cmp_line, sizeof(cmp_line), "CMP: Vin过压=%lumV Vout过压=%lumV",
+                 (unsigned long)trip_mv, (unsigned long)trip_mv);
+        CMix_Runner_Check(CMix_Runner_Find_Debug(cmp_line), "启动打印比较器实际动作电压 (%lu mV, 设定%lu mV)",
+                          (unsigned long)trip_mv, (unsigned long)CMIX_CMP_THRESHOLD_MV);
+    }
+    CMix_Runner_Check(g_decoder.bad_frames == 0, "发送帧CRC全部正确 (%u帧)", (unsigned)g_decoder.frames);
+    CMix_Runner_Check(g_decoder.trace.records > 0 && g_decoder.trace.bad_records == 0 &&
+                      g_decoder.trace.sequence_gaps == 0 && g_decoder.trace.lost == 0,
+                      "跟踪记录%u条 (%u帧) 全部按格式表还原, 无丢帧和丢失记录",
+                      (unsigned)g_decoder.trace.records, (unsigned)g_decoder.trace.frames);
+    CMix_Runner_Check(CMix_Runner_Find_Debug("[RUN] Vin=48.00V, Vout=0.00V") && CMix_Runner_Find_Debug("Mode=BOOST"),
+                      "每秒状态记录: 浮点参数和字符串参数还原");
+
+    /* 状态上报: 启动延时500ms之后每100ms一帧 */
+    reports = g_decoder.cmd_count[0x07];
+    CMix_Runner_Check(reports >= (run_ms - 600) / 100 && reports <= run_ms / 100,
+                      "状态上报帧数 %u", (unsigned)reports);
+
+    tick = CMix_Main_Get_System_Tick();
+    expected_tick = (uint32_t)(CMix_Emu_Cycle() * 1000 / CMix_Emu_Core_Clock());
+    CMix_Runner_Check(tick + 2 >= expected_tick && tick <= expected_tick,
+                      "系统节拍 %u ms (仿真时间 %u ms)", (unsigned)tick, (unsigned)expected_tick);
+
+#if CMIX_ADC_SEQUENCER_ENABLE
+    dma = CMix_Emu_Get_IRQ_Stats(ADC0_IRQn);
+    CMix_Runner_Check(dma->entries > 0 && dma->entries + 1 >= CMix_Emu_ADC_Injected_Scan_Count(),
+                      "ADC中断 %u次, 注入组扫描 %u次", (unsigned)dma->entries,
+                      (unsigned)CMix_Emu_ADC_Injected_Scan_Count());
+    CMix_Runner_Check(CMix_Hardware_ADC_Get_Reference_Voltage() == 5000,
+                      "内部基准换算VDDA %u mV", (unsigned)CMix_Hardware_ADC_Get_Reference_Voltage());
+#else
+    dma = CMix_Emu_Get_IRQ_Stats(DMA_IRQn);
+    CMix_Runner_Check(dma->entries > 0 && dma->entries + 1 >= CMix_Emu_ADC_Scan_Count(),
+                      "DMA中断 %u次, ADC扫描 %u次", (unsigned)dma->entries, (unsigned)CMix_Emu_ADC_Scan_Count());
+#endif
+
+    printf("  仿真 %.0f ms / 主机 %.0f ms, 寄存器访问 %llu读 %llu写, WFI %llu次 (休眠%.1f%%)\n",
+           CMix_Emu_Cycles_To_us(CMix_Emu_Cycle()) / 1000.0, stats.host_ns / 1e6,
+           (unsigned long long)stats.reads, (unsigned long long)stats.writes,
+           (unsigned long long)stats.wfi_count, 100.0 * stats.sleep_cycles / CMix_Emu_Cycle());
+    CMix_Runner_Print_IRQ_Table();
+    return true;
+}
+
+/**
+ * @brief 协议场景: 命令应答延迟、突发请求吞吐、CRC错误应答
+ * @param None
+ * @retval true = 通过
+ */
+static bool CMix_Runner_Scenario_Protocol(void)
+{
+    const uint8_t request[1] = {0};
+    const uint32_t samples = 20;
+    const uint32_t burst = 8;
+    double latency_min = 1e12, latency_max = 0, latency_sum = 0;
+    uint32_t i, before, replies;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+
+    /* 单条请求: 最后一个接收字节到应答最后一个字节发送完成 */
+    for (i = 0; i < samples; i++) {
+        uint64_t rx_done;
+        double latency;
+
+        before = g_decoder.cmd_count[0x0C];
+        CMix_Runner_Send_Frame(0x0C, request, sizeof(request), false);
+        if (!CMix_Runner_Run_ms(20)) {
+            return false;
+        }
+        if (g_decoder.cmd_count[0x0C] != before + 1) {
+            CMix_Runner_Check(false, "第%u条TASK_STATS请求无应答", (unsigned)i);
+            return false;
+        }
+        rx_done = CMix_Emu_UART_RX_Last_Cycle();
+        latency = CMix_Emu_Cycles_To_us(g_decoder.cmd_cycle[0x0C] - rx_done);
+        latency_sum += latency;
+        if (latency < latency_min) latency_min = latency;
+        if (latency > latency_max) latency_max = latency;
+    }
+    CMix_Runner_Check(g_decoder.cmd_len[0x0C] == 35, "TASK_STATS应答长度 %u", (unsigned)g_decoder.cmd_len[0x0C]);
+    printf("  应答延迟 (含40字节应答帧发送 %.0f us): min %.0f us, avg %.0f us, max %.0f us\n",
+           CMix_Emu_Cycles_To_us((uint64_t)CMix_Emu_UART_Byte_Cycles() * 40),
+           latency_min, latency_sum / samples, latency_max);
+
+    /* 突发: 连续注入多条请求, 统计应答数 (接收队列深度与发送队列容量决定) */
+    before = g_decoder.cmd_count[0x0C];
+    for (i = 0; i < burst; i++) {
+        CMix_Runner_Send_Frame(0x0C, request, sizeof(request), false);
+    }
+    if (!CMix_Runner_Run_ms(50)) {
+        return false;
+    }
+    replies = g_decoder.cmd_count[0x0C] - before;
+    CMix_Runner_Check(replies > 0, "突发%u条请求, 应答%u条, 接收溢出%u字节", (unsigned)burst,
+                      (unsigned)replies, (unsigned)CMix_Emu_UART_RX_Overrun_Count());
+
+    /* CRC错误帧 */
+    before = g_decoder.cmd_count[0x09];
+    CMix_Runner_Send_Frame(0x0C, request, sizeof(request), true);
+    if (!CMix_Runner_Run_ms(20)) {
+        return false;
+    }
+    CMix_Runner_Check(g_decoder.cmd_count[0x09] == before + 1 && g_decoder.cmd_data[0x09][0] == 0x03,
+                      "CRC错误帧应答ACK_ERROR(0x03)");
+    CMix_Runner_Check(g_decoder.bad_frames == 0, "发送帧CRC全部正确 (%u帧)", (unsigned)g_decoder.frames);
+    return true;
+}
+
+/**
+ * @brief 控制场景: ADC扫描由TIM1触发, 控制中断速率与中断开销
+ * @param None
+ * @retval true = 通过
+ * @note  多速率采样时检查注入组每周期一次、慢速通道按轮转比例转换
+ */
+static bool CMix_Runner_Scenario_Control(void)
+{
+    const uint32_t window_ms = 100;
+    const CMix_Emu_IRQ_Stats_t *irq;
+    uint32_t scans, updates, entries;
+    double pwm_khz;
+#if CMIX_ADC_SEQUENCER_ENABLE
+    uint32_t vin, bandgap, vout, periods;
+#endif
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+
+    CMix_Emu_Reset_Stats();
+#if CMIX_ADC_SEQUENCER_ENABLE
+    scans = CMix_Emu_ADC_Injected_Scan_Count();
+    vin = CMix_Emu_ADC_Channel_Count(CMIX_ADC_VIN_CHANNEL);
+    bandgap = CMix_Emu_ADC_Channel_Count(CMIX_ADC_BANDGAP_CHANNEL);
+    vout = CMix_Emu_ADC_Channel_Count(CMIX_ADC_VOUT_CHANNEL);
+#else
+    scans = CMix_Emu_ADC_Scan_Count();
+#endif
+    updates = CMix_Emu_TIM_Update_Count();
+    if (!CMix_Runner_Run_ms(window_ms)) {
+        return false;
+    }
+    updates = CMix_Emu_TIM_Update_Count() - updates;
+    pwm_khz = (double)CMix_Emu_Core_Clock() / CMix_Emu_TIM_Get_Period() / 1000.0;
+
+#if CMIX_ADC_SEQUENCER_ENABLE
+    scans = CMix_Emu_ADC_Injected_Scan_Count() - scans;
+    vin = CMix_Emu_ADC_Channel_Count(CMIX_ADC_VIN_CHANNEL) - vin;
+    bandgap = CMix_Emu_ADC_Channel_Count(CMIX_ADC_BANDGAP_CHANNEL) - bandgap;
+    vout = CMix_Emu_ADC_Channel_Count(CMIX_ADC_VOUT_CHANNEL) - vout;
+    periods = updates / CMIX_PWM_UPDATES_PER_PERIOD;
+    irq = CMix_Emu_Get_IRQ_Stats(ADC0_IRQn);
+    entries = irq->entries;
+
+    printf("  PWM %.1f kHz, %u ms内TIM1更新%u次, 注入组扫描%u次, 慢速通道 Vin %u次/基准 %u次, ADC中断%u次\n",
+           pwm_khz, (unsigned)window_ms, (unsigned)updates, (unsigned)scans, (unsigned)vin, (unsigned)bandgap,
+           (unsigned)entries);
+    CMix_Runner_Check(scans + 1 >= updates && scans <= updates + 1, "每个TIM1更新触发一次注入组扫描");
+    CMix_Runner_Check(vout + 1 >= updates && vout <= updates + 1, "快速通道每次更新转换 (Vout %u次)", (unsigned)vout);
+    CMix_Runner_Check(vin + bandgap + 1 >= periods && vin + bandgap <= periods + 1 &&
+                      vin + 1 >= bandgap && vin <= bandgap + 1, "慢速通道每周期一个, 依次轮转");
+    CMix_Runner_Check(CMix_Emu_ADC_Overrun_Count() == 0, "ADC无溢出");
+    CMix_Runner_Check(entries + 2 >= scans + periods && entries <= scans + periods + 2,
+                      "每次更新一次注入组中断, 每周期一次规则组中断");
+    if (entries > 0) {
+        printf("  ADC中断: 平均%.1f周期, 主机%.0f ns/次, 最大延迟%u周期\n",
+               (double)irq->busy_cycles / entries, (double)irq->host_ns / entries, (unsigned)irq->latency_max);
+    }
+#else
+    scans = CMix_Emu_ADC_Scan_Count() - scans;
+    irq = CMix_Emu_Get_IRQ_Stats(DMA_IRQn);
+    entries = irq->entries;
+
+    printf("  PWM %.1f kHz, %u ms内TIM1更新%u次, ADC扫描%u次, DMA中断%u次 (控制环%u次)\n",
+           pwm_khz, (unsigned)window_ms, (unsigned)updates, (unsigned)scans, (unsigned)entries,
+           (unsigned)(entries / CMIX_CONTROL_DECIMATION));
+    CMix_Runner_Check(scans + 1 >= updates && scans <= updates + 1, "每个TIM1更新触发一次ADC扫描");
+    CMix_Runner_Check(CMix_Emu_ADC_Overrun_Count() == 0, "ADC无溢出");
+    CMix_Runner_Check(entries + 1 >= scans && entries <= scans + 1, "每次扫描一个DMA半满/全满中断");
+    if (entries > 0) {
+        printf("  DMA中断: 平均%.1f周期, 主机%.0f ns/次, 最大延迟%u周期\n",
+               (double)irq->busy_cycles / entries, (double)irq->host_ns / entries, (unsigned)irq->latency_max);
+    }
+#endif
+    printf("  PWM比较值: %u %u %u %u\n", CMix_Emu_TIM_Get_Compare(0), CMix_Emu_TIM_Get_Compare(1),
+           CMix_Emu_TIM_Get_Compare(2), CMix_Emu_TIM_Get_Compare(3));
+    return true;
+}
+
+/**
+ * @brief 比较器保护场景: Vin在LDAC阈值上下注入, 测量越限到TIM1刹车的延迟
+ * @param None
+ * @retval true = 通过
+ * @note  刹车锁存到故障清除; 比较器仍越限时清除无效, 恢复后清除重新使能输出
+ */
+static bool CMix_Runner_Scenario_CMP_Trip(void)
+{
+    const CMix_Emu_IRQ_Stats_t *cmp;
+    CMix_CMP_Stats_t stats;
+    uint16_t led_mask = CMIX_GPIO_FAULT_LED_PIN;
+    uint8_t led_port = (CMIX_GPIO_FAULT_LED_PORT == GPIOA) ? 0 : 1;
+    uint32_t threshold, pin_mv;
+    uint64_t start, latency;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+    threshold = CMix_Hardware_CMP_Get_Threshold();
+    pin_mv = CMIX_RUNNER_CMP_PIN_MV(threshold);
+    CMix_Runner_Check(threshold <= CMIX_CMP_THRESHOLD_MV &&
+                      threshold + (uint32_t)CMIX_VOLTAGE_SENSE_VREF_MV * CMIX_VOLTAGE_SENSE_RATIO / CMIX_CMP_LDAC_STEPS >
+                      CMIX_CMP_THRESHOLD_MV,
+                      "LDAC阈值 %u mV (配置 %u mV, 引脚 %u mV)", (unsigned)threshold,
+                      (unsigned)CMIX_CMP_THRESHOLD_MV, (unsigned)pin_mv);
+    CMix_Runner_Check(threshold > CMIX_V_TO_MV(CMIX_MAX_INPUT_VOLTAGE) && threshold > CMIX_V_TO_MV(CMIX_MAX_OUTPUT_VOLTAGE),
+                      "后备动作点高于工作上限 (Vin %u mV, Vout %u mV)",
+                      (unsigned)CMIX_V_TO_MV(CMIX_MAX_INPUT_VOLTAGE), (unsigned)CMIX_V_TO_MV(CMIX_MAX_OUTPUT_VOLTAGE));
+    CMix_Runner_Check(CMix_Emu_TIM_Output_Enabled(), "触发前PWM输出使能");
+
+    CMix_Emu_CMP_Set_Input(1, pin_mv - CMIX_RUNNER_CMP_MARGIN_MV);
+    if (!CMix_Runner_Run_ms(1)) {
+        return false;
+    }
+    CMix_Hardware_CMP_Get_Stats(&stats);
+    CMix_Runner_Check(CMix_Emu_TIM_Output_Enabled() && stats.trips[1] == 0, "阈值下%u mV不动作",
+                      (unsigned)CMIX_RUNNER_CMP_MARGIN_MV);
+
+    start = CMix_Emu_Cycle();
+    CMix_Emu_CMP_Set_Input(1, pin_mv + CMIX_RUNNER_CMP_MARGIN_MV);
+    if (!CMix_Runner_Run_ms(1)) {
+        return false;
+    }
+    latency = CMix_Emu_TIM_Break_Cycle() - start;
+    CMix_Runner_Check(!CMix_Emu_TIM_Output_Enabled() && CMix_Emu_Cycles_To_us(latency) < 1.0,
+                      "越限到TIM1刹车 %u周期 (%.2f us)", (unsigned)latency, CMix_Emu_Cycles_To_us(latency));
+
+    cmp = CMix_Emu_Get_IRQ_Stats(CMP1_IRQn);
+    CMix_Runner_Check(cmp->entries == 1, "CMP1中断 %u次, 响应延迟%u周期 (%.2f us)", (unsigned)cmp->entries,
+                      (unsigned)cmp->latency_max, CMix_Emu_Cycles_To_us(cmp->latency_max));
+    CMix_Hardware_CMP_Get_Stats(&stats);
+    CMix_Runner_Check(stats.trips[1] == 1 && stats.trips[0] == 0, "越限统计 CMP1 %u次, CMP0 %u次",
+                      (unsigned)stats.trips[1], (unsigned)stats.trips[0]);
+    CMix_Runner_Check(CMix_DCDC_Get_Status()->state == CMIX_STATE_FAULT, "DCDC进入故障状态");
+    CMix_Runner_Check((CMix_Emu_GPIO_Get_Output(led_port) & led_mask) != 0, "故障LED点亮");
+
+    CMix_Emu_CMP_Set_Input(1, CMIX_RUNNER_CMP_PIN_MV(CMIX_RUNNER_CMP_VIN_MV));
+    CMix_Emu_CMP_Set_Input(0, pin_mv + CMIX_RUNNER_CMP_MARGIN_MV);
+    if (!CMix_Runner_Run_ms(10)) {
+        return false;
+    }
+    CMix_Hardware_CMP_Get_Stats(&stats);
+    CMix_Runner_Check(stats.recoveries[1] == 1 && stats.trips[0] == 1, "CMP1恢复%u次, CMP0共用阈值越限%u次",
+                      (unsigned)stats.recoveries[1], (unsigned)stats.trips[0]);
+    CMix_Runner_Check(!CMix_Emu_TIM_Output_Enabled(), "恢复后刹车保持锁存");
+
+    CMix_DCDC_Reset_Fault();
+    CMix_Runner_Check(!CMix_Emu_TIM_Output_Enabled() && CMix_DCDC_Get_Status()->state == CMIX_STATE_FAULT,
+                      "CMP0仍越限时故障清除无效, 输出保持关断");
+
+    CMix_Emu_CMP_Set_Input(0, 0);
+    if (!CMix_Runner_Run_ms(1)) {
+        return false;
+    }
+    CMix_DCDC_Reset_Fault();
+    CMix_Runner_Check(CMix_Emu_TIM_Output_Enabled() && CMix_DCDC_Get_Status()->state != CMIX_STATE_FAULT &&
+                      (CMix_Emu_GPIO_Get_Output(led_port) & led_mask) == 0,
+                      "越限解除后故障清除释放刹车, 输出恢复, 故障LED熄灭");
+    return true;
+}
+
+#if CMIX_PWM_PRELOAD_ENABLE
+/**
+ * @brief 暂存四路占空比, 同时换算期望的比较值
+ * @param duty: 四路占空比 (0-10000)
+ * @param pulse: 期望比较值输出
+ * @retval None
+ */
+static void CMix_Runner_Stage_PWM(const uint16_t *duty, uint16_t *pulse)
+{
+    uint8_t i;
+
+    for (i = 0; i < CMIX_PWM_CHANNEL_COUNT; i++) {
+        CMix_Hardware_PWM_Stage(i + 1, duty[i]);
+        pulse[i] = (uint16_t)((duty[i] * CMIX_PWM_COMPARE_SCALE) / 10000);
+    }
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    /* 两相交错: 相B为PWM2模式, 比较值取补 (场景占空比均为整计数, 抖动余数不影响) */
+    pulse[1] = CMIX_PWM_COMPARE_SCALE - pulse[1];
+#endif
+}
+
+/**
+ * @brief 生效的四路比较值是否等于给定值
+ */
+static bool CMix_Runner_Compare_Equals(const uint16_t *pulse)
+{
+    uint8_t i;
+
+    for (i = 0; i < CMIX_PWM_CHANNEL_COUNT; i++) {
+        if (CMix_Emu_TIM_Get_Compare(i) != pulse[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief PWM提交场景: 控制环提交全部在目标周期生效; 运行程序直接提交,
+ *        检查四路在同一更新事件装载、保护窗内的提交等到更新之后并计为错过
+ * @param None
+ * @retval true = 通过
+ * @note  运行程序访问寄存器时仿真时间前进, 但固件中断不执行, 暂存值不会被控制环覆盖
+ */
+static bool CMix_Runner_Scenario_PWM_Commit(void)
+{
+    static const uint16_t early_duty[CMIX_PWM_CHANNEL_COUNT] = {2500, 7500, 0, 10000};
+    static const uint16_t late_duty[CMIX_PWM_CHANNEL_COUNT] = {10000, 0, 4000, 6000};
+    const uint32_t window_ms = 10;
+    CMix_PWM_Commit_Stats_t stats, after;
+    uint16_t early[CMIX_PWM_CHANNEL_COUNT], late[CMIX_PWM_CHANNEL_COUNT];
+    uint32_t updates;
+    uint16_t count;
+    bool on_time;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+
+    /* 控制环: 每个控制周期提交一次 */
+    CMix_Hardware_PWM_Get_Commit_Stats(&stats);
+    updates = CMix_Emu_TIM_Update_Count();
+    if (!CMix_Runner_Run_ms(window_ms)) {
+        return false;
+    }
+    updates = CMix_Emu_TIM_Update_Count() - updates;
+    CMix_Hardware_PWM_Get_Commit_Stats(&after);
+    printf("  %u ms内TIM1更新%u次, 控制环提交%u次, 错过%u次, 距更新事件最少%u计数 (保护窗%u)\n",
+           (unsigned)window_ms, (unsigned)updates, (unsigned)(after.commits - stats.commits),
+           (unsigned)after.missed, (unsigned)after.min_headroom, (unsigned)CMIX_PWM_COMMIT_GUARD);
+    CMix_Runner_Check(after.commits - stats.commits + 1 >= updates / CMIX_CONTROL_DECIMATION &&
+                      after.commits - stats.commits <= updates / CMIX_CONTROL_DECIMATION + 1,
+                      "每个控制周期提交一次");
+    CMix_Runner_Check(after.missed == 0 && after.min_headroom >= CMIX_PWM_COMMIT_GUARD, "控制环提交全部在目标周期生效");
+
+    /* 远离更新事件时提交: 更新事件之前保持旧值, 更新事件时四路同时装载 */
+    while (CMix_Emu_TIM_Counts_To_Update() < 2 * CMIX_PWM_COMMIT_GUARD) {
+        (void)TIM1->CNTR;
+    }
+    CMix_Runner_Stage_PWM(early_duty, early);
+    updates = CMix_Emu_TIM_Update_Count();
+    on_time = CMix_Hardware_PWM_Commit();
+    CMix_Runner_Check(on_time && CMix_Emu_TIM_Update_Count() == updates, "保护窗外提交不等待");
+    CMix_Runner_Check(!CMix_Runner_Compare_Equals(early), "更新事件之前比较值不变");
+    while (CMix_Emu_TIM_Update_Count() == updates) {
+        (void)TIM1->CNTR;
+    }
+    CMix_Runner_Check(CMix_Runner_Compare_Equals(early), "更新事件后四路同时生效: %u %u %u %u",
+                      CMix_Emu_TIM_Get_Compare(0), CMix_Emu_TIM_Get_Compare(1),
+                      CMix_Emu_TIM_Get_Compare(2), CMix_Emu_TIM_Get_Compare(3));
+
+    /* 保护窗内提交: 等到更新事件之后写入, 推迟一个周期生效 */
+    while ((count = (uint16_t)CMix_Emu_TIM_Counts_To_Update()) > CMIX_PWM_COMMIT_GUARD / 2) {
+        (void)TIM1->CNTR;
+    }
+    CMix_Hardware_PWM_Get_Commit_Stats(&stats);
+    CMix_Runner_Stage_PWM(late_duty, late);
+    updates = CMix_Emu_TIM_Update_Count();
+    on_time = CMix_Hardware_PWM_Commit();
+    CMix_Hardware_PWM_Get_Commit_Stats(&after);
+    CMix_Runner_Check(!on_time && after.missed == stats.missed + 1, "距更新事件%u计数的提交计为错过", (unsigned)count);
+    CMix_Runner_Check(CMix_Emu_TIM_Update_Count() == updates + 1 && CMix_Runner_Compare_Equals(early),
+                      "写入在更新事件之后, 本周期保持原比较值");
+    while (CMix_Emu_TIM_Update_Count() == updates + 1) {
+        (void)TIM1->CNTR;
+    }
+    CMix_Runner_Check(CMix_Runner_Compare_Equals(late), "下一更新事件四路同时生效: %u %u %u %u",
+                      CMix_Emu_TIM_Get_Compare(0), CMix_Emu_TIM_Get_Compare(1),
+                      CMix_Emu_TIM_Get_Compare(2), CMix_Emu_TIM_Get_Compare(3));
+    return true;
+}
+#endif /* CMIX_PWM_PRELOAD_ENABLE */
+
+#if CMIX_ADC_AWD_ENABLE
+/**
+ * @brief 注入越限采样, 检查该通道的模拟看门狗统计
+ * @param channel: 注入通道号
+ * @param raw: 越限码值
+ * @param name: 通道名称
+ * @retval true = 运行完成
+ * @note  监视通道每次扫描轮换, 越限到首次触发不超过CMIX_ADC_AWD_COUNT次扫描
+ */
+static bool CMix_Runner_AWD_Inject(uint8_t channel, uint16_t raw, const char *name)
+{
+    CMix_ADC_AWD_Stats_t stats;
+    CMix_ADC_Snapshot_t snapshot;
+    uint32_t tick;
+
+    CMix_Hardware_ADC_Get_Snapshot(&snapshot);
+    tick = CMix_Main_Get_System_Tick();
+    CMix_Emu_ADC_Set_Channel(channel, raw);
+    if (!CMix_Runner_Run_ms(1)) {
+        return false;
+    }
+
+    CMix_Hardware_ADC_AWD_Get_Stats(&stats);
+    CMix_Runner_Check(stats.trips[channel] >= 1, "%s越限转换%u次", name, (unsigned)stats.trips[channel]);
+    CMix_Runner_Check(stats.sequence[channel] - snapshot.sequence <= CMIX_ADC_AWD_COUNT,
+                      "%s注入后第%u次扫描首次越限 (轮转%u个通道)", name,
+                      (unsigned)(stats.sequence[channel] - snapshot.sequence), (unsigned)CMIX_ADC_AWD_COUNT);
+    CMix_Runner_Check(stats.tick_ms[channel] - tick <= 1, "%s首次越限时刻 %u ms (注入时 %u ms)", name,
+                      (unsigned)stats.tick_ms[channel], (unsigned)tick);
+    return true;
+}
+
+/**
+ * @brief 模拟看门狗场景: 协议设置相A限流后注入过流, 刹车后再注入Vout过压
+ * @param None
+ * @retval true = 通过
+ * @note  刹车锁存至复位, Vout只检查越限统计 (窗口取协议默认的60V)
+ */
+static bool CMix_Runner_Scenario_AWD_Trip(void)
+{
+    const uint8_t limit[2] = {CMIX_RUNNER_AWD_LIMIT_MA & 0xFF, CMIX_RUNNER_AWD_LIMIT_MA >> 8};
+    CMix_ADC_AWD_Stats_t stats;
+    uint32_t before, trips = 0;
+    uint64_t start;
+    uint8_t i;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+    before = g_decoder.cmd_count[0x09];
+    CMix_Runner_Send_Frame(0x03, limit, sizeof(limit), false);
+    if (!CMix_Runner_Run_ms(20)) {
+        return false;
+    }
+    CMix_Runner_Check(g_decoder.cmd_count[0x09] == before + 1 && g_decoder.cmd_data[0x09][0] == 0x00,
+                      "设置最大输入电流%u mA应答OK", (unsigned)CMIX_RUNNER_AWD_LIMIT_MA);
+
+    CMix_Hardware_ADC_AWD_Get_Stats(&stats);
+    for (i = 0; i < CMIX_ADC_SCAN_COUNT; i++) {
+        trips += stats.trips[i];
+    }
+    CMix_Runner_Check(trips == 0 && CMix_Emu_ADC_Watchdog_Count() == 0 && CMix_Emu_TIM_Output_Enabled(),
+                      "注入前无越限, PWM输出使能");
+
+    start = CMix_Emu_Cycle();
+    if (!CMix_Runner_AWD_Inject(CMIX_ADC_CURRENT_A_CHANNEL, CMIX_RUNNER_AWD_CURRENT_RAW, "相A电流")) {
+        return false;
+    }
+    CMix_Runner_Check(!CMix_Emu_TIM_Output_Enabled(), "TIM1刹车关断输出 (注入后%.1f us)",
+                      CMix_Emu_Cycles_To_us(CMix_Emu_TIM_Break_Cycle() - start));
+    CMix_Runner_Check(CMix_DCDC_Get_Status()->state == CMIX_STATE_FAULT, "DCDC进入故障状态");
+
+    CMix_Hardware_ADC_AWD_Get_Stats(&stats);
+    CMix_Runner_Check(stats.trips[CMIX_ADC_VOUT_CHANNEL] == 0 && stats.trips[CMIX_ADC_CURRENT_B_CHANNEL] == 0,
+                      "未越限通道计数为0");
+    return CMix_Runner_AWD_Inject(CMIX_ADC_VOUT_CHANNEL, CMIX_RUNNER_AWD_VOUT_RAW, "Vout");
+}
+#endif /* CMIX_ADC_AWD_ENABLE */
+
+#if CMIX_PARAM_STORE_ENABLE
+/**
+ * @brief 发送一条设置命令并运行一个帧间隔
+ * @param cmd: 设置命令码 (0x01-0x05)
+ * @param value: 16位设置值
+ * @retval true = 应答OK
+ */
+static bool CMix_Runner_Param_Set(uint8_t cmd, uint16_t value)
+{
+    const uint8_t data[2] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8)};
+    uint32_t before = g_decoder.cmd_count[0x09];
+
+    CMix_Runner_Send_Frame(cmd, data, sizeof(data), false);
+    if (!CMix_Runner_Run_ms(CMIX_RUNNER_PARAM_FRAME_MS)) {
+        return false;
+    }
+    return g_decoder.cmd_count[0x09] == before + 1 && g_decoder.cmd_data[0x09][0] == 0x00;
+}
+
+/**
+ * @brief 运行到全部参数写入Flash
+ * @param elapsed_ms: 输出等待时间 (ms)
+ * @retval true = 在CMIX_RUNNER_PARAM_FLUSH_MS内完成
+ */
+static bool CMix_Runner_Param_Flush(uint32_t *elapsed_ms)
+{
+    *elapsed_ms = 0;
+    while (CMix_Param_Is_Pending()) {
+        if (*elapsed_ms >= CMIX_RUNNER_PARAM_FLUSH_MS || !CMix_Runner_Run_ms(1)) {
+            return false;
+        }
+        (*elapsed_ms)++;
+    }
+    return true;
+}
+
+/**
+ * @brief 第一次启动: 空参数区使用默认值, 设置五个参数后等待写入
+ * @param None
+ * @retval true = 运行完成
+ */
+static bool CMix_Runner_Param_First_Boot(void)
+{
+    static const uint16_t values[5] = {52000, 24000, 30000, 25000, 40000};
+    CMix_Param_Stats_t stats;
+    uint32_t acked = 0, elapsed_ms = 0;
+    uint8_t i;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+    CMix_Param_Get_Stats(&stats);
+    CMix_Runner_Check(stats.stored_keys == 0 && stats.active_page == 0xFF &&
+                      CMix_Protocol_Get_System_Parameters()->output_voltage_threshold == 60000,
+                      "空参数区启动, 保持默认值");
+    CMix_Runner_Check(CMix_Protocol_Get_System_Parameters()->max_input_current == CMIX_A_TO_MA(CMIX_MAX_INPUT_CURRENT) &&
+                      CMix_Protocol_Get_System_Parameters()->max_output_current == CMIX_A_TO_MA(CMIX_MAX_OUTPUT_CURRENT) &&
+                      CMIX_A_TO_MA(CMIX_MAX_INPUT_CURRENT) <= CMIX_ADC_CURRENT_LIMIT_MA &&
+                      CMIX_A_TO_MA(CMIX_MAX_OUTPUT_CURRENT) <= CMIX_ADC_CURRENT_LIMIT_MA,
+                      "默认电流限值为额定值, 不超出采样量程±%u mA", (unsigned)CMIX_ADC_CURRENT_LIMIT_MA);
+
+    for (i = 0; i < 5; i++) {
+        if (CMix_Runner_Param_Set((uint8_t)(0x01 + i), values[i])) {
+            acked++;
+        }
+    }
+    CMix_Runner_Check(acked == 5, "设置命令应答OK %u/5", (unsigned)acked);
+    CMix_Runner_Check(CMix_Runner_Param_Flush(&elapsed_ms), "最后一条应答后%.1f ms全部写入Flash",
+                      CMix_Emu_Cycles_To_us(CMix_Emu_Cycle() - g_decoder.cmd_cycle[0x09]) / 1000.0);
+
+    CMix_Param_Get_Stats(&stats);
+    CMix_Runner_Check(stats.page_sequence == 1 && stats.stored_keys == 6 && stats.program_errors == 0,
+                      "第1页保存%u个键, 写入%u条记录, 剩余%u槽", (unsigned)stats.stored_keys,
+                      (unsigned)stats.records_written, (unsigned)stats.free_slots);
+    return true;
+}
+
+/**
+ * @brief 第二次启动: 检查恢复值, 突发修改输出功率使参数区多次换页
+ * @param None
+ * @retval true = 运行完成
+ */
+static bool CMix_Runner_Param_Rotate(void)
+{
+    CMix_System_Parameters_t *params;
+    CMix_Param_Stats_t stats;
+    CMix_Emu_Flash_Stats_t flash;
+    const CMix_Emu_IRQ_Stats_t *irq;
+    uint32_t erase_min = UINT32_MAX, erase_max = 0, acked = 0, sets = 0, elapsed_ms = 0;
+    uint16_t burst, i;
+    uint8_t page;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+    params = CMix_Protocol_Get_System_Parameters();
+    CMix_Runner_Check(params->input_voltage_threshold == 52000 && params->output_voltage_threshold == 24000 &&
+                      params->max_input_current == 30000 && params->max_output_current == 25000 &&
+                      params->max_output_power == 40000, "复位后恢复全部设置值");
+    CMix_Runner_Check(CMix_Runner_Find_Debug("Param: keys=6 rec=6 bad=0 seq=1"), "启动扫描: 6个键, 6条记录, 无无效记录");
+    CMix_Emu_Reset_Stats();
+
+    for (burst = 0; burst < CMIX_RUNNER_PARAM_BURSTS; burst++) {
+        for (i = 0; i < CMIX_RUNNER_PARAM_BURST_SETS; i++) {
+            if (CMix_Runner_Param_Set(0x05, (uint16_t)(CMIX_RUNNER_PARAM_POWER_BASE + sets))) {
+                acked++;
+            }
+            sets++;
+        }
+        if (!CMix_Runner_Run_ms(CMIX_RUNNER_PARAM_GAP_MS)) {
+            return false;
+        }
+    }
+    CMix_Runner_Check(acked == sets, "突发设置%u次, 应答OK %u次", (unsigned)sets, (unsigned)acked);
+    CMix_Runner_Check(CMix_Runner_Param_Flush(&elapsed_ms), "最后一次突发后%u ms全部写入Flash",
+                      (unsigned)(CMIX_RUNNER_PARAM_GAP_MS + elapsed_ms));
+
+    CMix_Param_Get_Stats(&stats);
+    CMix_Emu_Flash_Get_Stats(&flash);
+    for (page = 0; page < CMIX_PARAM_PAGE_COUNT; page++) {
+        uint32_t count = CMix_Emu_Flash_Erase_Count(CMIX_PARAM_FLASH_BASE + page * CMIX_PARAM_PAGE_SIZE);
+        if (count < erase_min) erase_min = count;
+        if (count > erase_max) erase_max = count;
+    }
+    CMix_Runner_Check(stats.rotations >= CMIX_PARAM_PAGE_COUNT && stats.program_errors == 0,
+                      "换页%u次, 写入%u条记录 (含换页复制), 校验失败%u次", (unsigned)stats.rotations,
+                      (unsigned)stats.records_written, (unsigned)stats.program_errors);
+    CMix_Runner_Check(stats.erases >= CMIX_PARAM_PAGE_COUNT - 1 && erase_max - erase_min <= 1,
+                      "擦除%u次, 各页擦除次数%u~%u", (unsigned)stats.erases, (unsigned)erase_min, (unsigned)erase_max);
+    CMix_Runner_Check(flash.overwrites == 0 && flash.errors == 0, "无重复编程, 无IFMC键/地址错误");
+    CMix_Runner_Check(CMix_Emu_UART_RX_Overrun_Count() == 0, "擦除避开通信, UART接收无溢出");
+
+#if CMIX_ADC_SEQUENCER_ENABLE
+    irq = CMix_Emu_Get_IRQ_Stats(ADC0_IRQn);
+#else
+    irq = CMix_Emu_Get_IRQ_Stats(DMA_IRQn);
+#endif
+    printf("  Flash编程%u字, 擦除%u页; 控制中断最大响应延迟%.1f us (含编程/擦除停顿)\n",
+           (unsigned)flash.programs, (unsigned)flash.erases, CMix_Emu_Cycles_To_us(irq->latency_max));
+    return true;
+}
+
+/**
+ * @brief 参数存储场景: 空参数区启动并设置参数, 复位后检查恢复并突发修改, 再次复位检查最新值
+ * @param None
+ * @retval true = 通过
+ * @note  每次启动在独立子进程中运行, Flash内容经共享映射保留
+ */
+static bool CMix_Runner_Scenario_Param_Store(void)
+{
+    const uint16_t last_power = CMIX_RUNNER_PARAM_POWER_BASE + CMIX_RUNNER_PARAM_BURSTS * CMIX_RUNNER_PARAM_BURST_SETS - 1;
+    CMix_Param_Stats_t stats;
+    uint32_t i, count;
+
+    CMix_Emu_Init();
+    CMix_Emu_Flash_Erase(CMIX_PARAM_FLASH_BASE, CMIX_PARAM_PAGE_COUNT * CMIX_PARAM_PAGE_SIZE);
+
+    if (!CMix_Runner_Fork(CMix_Runner_Param_First_Boot, "第一次启动") ||
+        !CMix_Runner_Fork(CMix_Runner_Param_Rotate, "第二次启动")) {
+        return false;
+    }
+
+    printf("  -- 第三次启动\n");
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+    CMix_Param_Get_Stats(&stats);
+    CMix_Runner_Check(CMix_Protocol_Get_System_Parameters()->max_output_power == last_power &&
+                      CMix_Protocol_Get_System_Parameters()->output_voltage_threshold == 24000,
+                      "换页后恢复最新值 (输出功率%u mW)", (unsigned)CMix_Protocol_Get_System_Parameters()->max_output_power);
+    CMix_Runner_Check(stats.stored_keys == 6 && stats.boot_invalid == 0, "启动扫描%u条记录, 无无效记录",
+                      (unsigned)stats.boot_records);
+
+    count = (g_decoder.debug_count < CMIX_RUNNER_DEBUG_MAX) ? g_decoder.debug_count : CMIX_RUNNER_DEBUG_MAX;
+    for (i = 0; i < count; i++) {
+        if (strncmp(g_decoder.debug[i], "Param:", 6) == 0) {
+            printf("  %s (scan = 启动扫描CPU周期)\n", g_decoder.debug[i]);
+        }
+    }
+    return true;
+}
+#endif /* CMIX_PARAM_STORE_ENABLE */
+
+#if CMIX_BLACKBOX_ENABLE
+/**
+ * @brief 发送一条快照读出命令并等待应答
+ * @param index: 块序号 (0xFF = 清除)
+ * @retval 快照读出应答的数据长度, -1 = 无快照读出应答 (应答码见g_decoder.cmd_data[0x09])
+ */
+static int CMix_Runner_Blackbox_Request(uint8_t index)
+{
+    uint32_t before = g_decoder.cmd_count[0x0D];
+
+    CMix_Runner_Send_Frame(0x0D, &index, 1, false);
+    if (!CMix_Runner_Run_ms(CMIX_RUNNER_BLACKBOX_READ_MS) || g_decoder.cmd_count[0x0D] == before) {
+        return -1;
+    }
+    return g_decoder.cmd_len[0x0D];
+}
+
+/**
+ * @brief 逐块读出快照并拼接
+ * @param image: 快照输出 (不小于CMIX_RUNNER_BLACKBOX_IMAGE_MAX)
+ * @param length: 快照字节数输出
+ * @retval true = 各块序号连续且总长不超过快照区
+ */
+static bool CMix_Runner_Blackbox_Read_All(uint8_t *image, uint32_t *length)
+{
+    uint8_t index = 0, count = 1;
+    int len;
+
+    *length = 0;
+    while (index < count) {
+        len = CMix_Runner_Blackbox_Request(index);
+        if (len < 2 || g_decoder.cmd_data[0x0D][0] != index ||
+            *length + (uint32_t)(len - 2) > CMIX_RUNNER_BLACKBOX_IMAGE_MAX) {
+            return false;
+        }
+        count = g_decoder.cmd_data[0x0D][1];
+        memcpy(&image[*length], &g_decoder.cmd_data[0x0D][2], (size_t)(len - 2));
+        *length += (uint32_t)(len - 2);
+        index++;
+    }
+    return true;
+}
+
+/**
+ * @brief 第一次启动: Vin阶跃后比较器越限, 检查冻结窗口、写入和读出的快照内容
+ * @param None
+ * @retval true = 运行完成
+ */
+static bool CMix_Runner_Blackbox_Capture(void)
+{
+    static uint8_t image[CMIX_RUNNER_BLACKBOX_IMAGE_MAX];
+    static uint8_t crc_data[CMIX_RUNNER_BLACKBOX_IMAGE_MAX];
+    const CMix_Blackbox_Header_t *header = (const CMix_Blackbox_Header_t *)image;
+    const CMix_Blackbox_Sample_t *samples = (const CMix_Blackbox_Sample_t *)&image[sizeof(CMix_Blackbox_Header_t)];
+    CMix_Blackbox_Stats_t stats;
+    CMix_Emu_Flash_Stats_t flash;
+    uint32_t length = 0, elapsed_ms = 0, pin_mv, sample_bytes;
+    uint16_t pre, post, count, i, step = 0;
+    bool post_faulted = true, ok;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+    CMix_Blackbox_Get_Stats(&stats);
+    CMix_Runner_Check(stats.region == CMIX_BLACKBOX_REGION_BLANK && stats.capturing &&
+                      CMix_Runner_Blackbox_Request(0) == 2 && g_decoder.cmd_data[0x0D][1] == 0,
+                      "空快照区启动, 读出块数为0, 环在采集");
+    CMix_Emu_Reset_Stats();
+
+    /* Vin阶跃, 经过STEP_MS后Vin比较器越限 */
+    pin_mv = CMIX_RUNNER_CMP_PIN_MV(CMix_Hardware_CMP_Get_Threshold());
+    CMix_Emu_ADC_Set_Channel(CMIX_ADC_VIN_CHANNEL, CMIX_RUNNER_BLACKBOX_VIN_RAW);
+    if (!CMix_Runner_Run_ms(CMIX_RUNNER_BLACKBOX_STEP_MS)) {
+        return false;
+    }
+    CMix_Emu_CMP_Set_Input(1, pin_mv + CMIX_RUNNER_CMP_MARGIN_MV);
+    if (!CMix_Runner_Run_ms(2)) {
+        return false;
+    }
+    CMix_Blackbox_Get_Stats(&stats);
+    CMix_Runner_Check(stats.triggers == 1 && !stats.capturing && CMix_DCDC_Get_Status()->state == CMIX_STATE_FAULT,
+                      "比较器越限触发一次, 触发后%u个样本 (%.2f ms) 内冻结", (unsigned)CMIX_BLACKBOX_POST_SAMPLES,
+                      CMIX_BLACKBOX_POST_SAMPLES * 1000.0 / CMIX_CONTROL_RATE_HZ);
+
+    /* 故障状态下的后续保护动作不再触发 */
+    CMix_Emu_CMP_Set_Input(0, pin_mv + CMIX_RUNNER_CMP_MARGIN_MV);
+    CMix_Runner_Check(CMix_Runner_Blackbox_Request(0) < 0 && g_decoder.cmd_data[0x09][0] == 0x05,
+                      "写入中读出应答系统忙");
+    CMix_Blackbox_Get_Stats(&stats);
+    CMix_Runner_Check(stats.triggers == 1 && stats.ignored == 0, "已在故障状态时CMP0越限不触发");
+
+    while (CMix_Blackbox_Is_Busy()) {
+        if (elapsed_ms >= CMIX_RUNNER_BLACKBOX_COMMIT_MS || !CMix_Runner_Run_ms(1)) {
+            break;
+        }
+        elapsed_ms++;
+    }
+    CMix_Blackbox_Get_Stats(&stats);
+    CMix_Emu_Flash_Get_Stats(&flash);
+    CMix_Runner_Check(stats.commits == 1 && stats.region == CMIX_BLACKBOX_REGION_STORED && stats.capturing,
+                      "触发后约%u ms快照写入完成, 重新开始采集", (unsigned)(elapsed_ms + CMIX_RUNNER_BLACKBOX_READ_MS + 2));
+    CMix_Runner_Check(flash.erases == 0 && flash.overwrites == 0 && flash.errors == 0 && stats.program_errors == 0,
+                      "空快照区不擦除, 编程%u字, 无重复编程和IFMC错误", (unsigned)flash.programs);
+
+    /* 分块读出并校验 */
+    ok = CMix_Runner_Blackbox_Read_All(image, &length);
+    CMix_Runner_Check(ok, "分块读出%u字节", (unsigned)length);
+    if (length < sizeof(CMix_Blackbox_Header_t)) {
+        return true;
+    }
+    pre = (uint16_t)(header->window & 0xFFFF);
+    post = (uint16_t)(header->window >> 16);
+    count = (uint16_t)(header->info >> 16);
+    sample_bytes = (uint32_t)count * sizeof(CMix_Blackbox_Sample_t);
+    CMix_Runner_Check(header->magic == CMIX_BLACKBOX_MAGIC && header->sequence == 1 &&
+                      (header->info & 0xFF) == CMIX_ERROR_OVERVOLTAGE && length == sizeof(*header) + sample_bytes,
+                      "快照头: 序号%u, 故障代码%u, %u个样本", (unsigned)header->sequence,
+                      (unsigned)(header->info & 0xFF), (unsigned)count);
+    CMix_Runner_Check(pre == CMIX_BLACKBOX_SAMPLES - CMIX_BLACKBOX_POST_SAMPLES && post == CMIX_BLACKBOX_POST_SAMPLES &&
+                      count == pre + post && header->rate_hz == CMIX_CONTROL_RATE_HZ,
+                      "窗口: 触发前%u + 触发后%u个样本, 采样%u Hz", (unsigned)pre, (unsigned)post,
+                      (unsigned)header->rate_hz);
+    if (count != pre + post || count > CMIX_BLACKBOX_SAMPLES || length != sizeof(*header) + sample_bytes) {
+        return true;
+    }
+
+    memcpy(crc_data, samples, sample_bytes);
+    memcpy(&crc_data[sample_bytes], &header->sequence, 6 * 4);
+    CMix_Runner_Check(header->crc == CMix_Runner_CRC16(crc_data, (uint16_t)(sample_bytes + 6 * 4)),
+                      "快照CRC 0x%04X与独立计算一致", (unsigned)header->crc);
+
+    /* 波形: 窗口内可见Vin阶跃, 触发前未故障, 触发后全部为故障状态且占空比为0 */
+    for (i = 1; i < pre; i++) {
+        if (step == 0 && samples[i].vin > samples[0].vin + (2000 >> CMIX_BLACKBOX_VOLTAGE_SHIFT)) {
+            step = i;
+        }
+    }
+    for (i = pre; i < count; i++) {
+        if ((samples[i].state & 0xFF) != CMIX_STATE_FAULT || samples[i].duty != 0) {
+            post_faulted = false;
+        }
+    }
+    CMix_Runner_Check(step > 0 && (samples[pre - 1].state & 0xFF) != CMIX_STATE_FAULT,
+                      "Vin %u mV -> %u mV, 阶跃在触发前%.2f ms, 触发前状态%u",
+                      (unsigned)samples[0].vin << CMIX_BLACKBOX_VOLTAGE_SHIFT,
+                      (unsigned)samples[pre - 1].vin << CMIX_BLACKBOX_VOLTAGE_SHIFT,
+                      (pre - step) * 1000.0 / CMIX_CONTROL_RATE_HZ, (unsigned)(samples[pre - 1].state & 0xFF));
+    CMix_Runner_Check(post_faulted, "触发后%u个样本均为故障状态, 占空比0", (unsigned)post);
+    return true;
+}
+
+/**
+ * @brief 第二次启动: 启动扫描找到快照, 读出与Flash一致; 清除后快照区擦除
+ * @param None
+ * @retval true = 运行完成
+ */
+static bool CMix_Runner_Blackbox_Reboot(void)
+{
+    static uint8_t image[CMIX_RUNNER_BLACKBOX_IMAGE_MAX];
+    CMix_Blackbox_Stats_t stats;
+    CMix_Emu_Flash_Stats_t flash;
+    uint32_t length = 0, i;
+    bool same = true, ok;
+    char expected[64];
+    int len;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+    snprintf(expected, sizeof(expected), "Blackbox: region=1 seq=1 fault=%u window=%u+%u", (unsigned)CMIX_ERROR_OVERVOLTAGE,
+             (unsigned)(CMIX_BLACKBOX_SAMPLES - CMIX_BLACKBOX_POST_SAMPLES), (unsigned)CMIX_BLACKBOX_POST_SAMPLES);
+    CMix_Runner_Check(CMix_Runner_Find_Debug(expected), "启动扫描找到快照: %s", expected);
+
+    ok = CMix_Runner_Blackbox_Read_All(image, &length);
+    CMix_Runner_Check(ok && length > 0, "复位后分块读出%u字节", (unsigned)length);
+    for (i = 0; i + 4 <= length; i += 4) {
+        uint32_t word;
+
+        memcpy(&word, &image[i], 4);
+        if (word != CMix_Emu_Flash_Read(CMIX_BLACKBOX_FLASH_BASE + i)) {
+            same = false;
+        }
+    }
+    CMix_Runner_Check(same, "读出内容与Flash一致");
+
+    /* 清除: 通信空闲后逐页擦除 */
+    CMix_Emu_Reset_Stats();
+    len = CMix_Runner_Blackbox_Request(0xFF);
+    CMix_Runner_Check(len < 0 && g_decoder.cmd_data[0x09][0] == 0x00, "清除命令应答OK");
+    if (!CMix_Runner_Run_ms(CMIX_BLACKBOX_ERASE_IDLE_MS + 50)) {
+        return false;
+    }
+    CMix_Blackbox_Get_Stats(&stats);
+    CMix_Emu_Flash_Get_Stats(&flash);
+    CMix_Runner_Check(stats.region == CMIX_BLACKBOX_REGION_BLANK && flash.erases == CMIX_BLACKBOX_FLASH_SIZE / CMIX_BLACKBOX_PAGE_SIZE,
+                      "通信空闲后擦除%u页", (unsigned)flash.erases);
+    CMix_Runner_Check(CMix_Runner_Blackbox_Request(0) == 2 && g_decoder.cmd_data[0x0D][1] == 0 &&
+                      CMix_Emu_UART_RX_Overrun_Count() == 0, "清除后读出块数为0, UART接收无溢出");
+    return true;
+}
+
+/**
+ * @brief 黑匣子场景: 故障触发并写入快照, 复位后读出并清除
+ * @param None
+ * @retval true = 通过
+ * @note  每次启动在独立子进程中运行, Flash内容经共享映射保留
+ */
+static bool CMix_Runner_Scenario_Blackbox(void)
+{
+    CMix_Emu_Init();
+    CMix_Emu_Flash_Erase(CMIX_BLACKBOX_FLASH_BASE, CMIX_BLACKBOX_FLASH_SIZE);
+
+    return CMix_Runner_Fork(CMix_Runner_Blackbox_Capture, "第一次启动: 故障触发") &&
+           CMix_Runner_Fork(CMix_Runner_Blackbox_Reboot, "第二次启动: 读出与清除");
+}
+#endif /* CMIX_BLACKBOX_ENABLE */
+
+#if CMIX_TELEMETRY_ENABLE
+/**
+ * @brief 发送一条订阅命令并等待应答
+ * @param data: 订阅数据 (N个 信号ID(1) + 分频(2, 小端))
+ * @param len: 数据长度
+ * @retval 应答码, -1 = 无应答
+ * @note  清空遥测流接收状态并记下订阅, 之后收到的遥测帧按此订阅拆分
+ */
+static int CMix_Runner_Telemetry_Subscribe(const uint8_t *data, uint8_t len)
+{
+    uint32_t before = g_decoder.cmd_count[0x09];
+    uint8_t i;
+
+    memset(&g_telemetry_rx, 0, sizeof(g_telemetry_rx));
+    g_telemetry_rx.count = (uint8_t)(len / 3);
+    for (i = 0; i < g_telemetry_rx.count; i++) {
+        g_telemetry_rx.signal[i] = data[i * 3];
+        g_telemetry_rx.decimation[i] = (uint16_t)(data[i * 3 + 1] | (data[i * 3 + 2] << 8));
+    }
+
+    CMix_Runner_Send_Frame(0x0F, data, len, false);
+    if (!CMix_Runner_Run_ms(CMIX_RUNNER_TELEMETRY_ACK_MS) || g_decoder.cmd_count[0x09] == before) {
+        return -1;
+    }
+    return g_decoder.cmd_data[0x09][0];
+}
+
+/**
+ * @brief 遥测流场景: 非法订阅被拒绝; 按分频采样、帧序号连续、数值与控制器状态一致; 停止后不再发送
+ * @param None
+ * @retval true = 通过
+ */
+static bool CMix_Runner_Scenario_Telemetry(void)
+{
+    static const uint8_t bad_length[] = {CMIX_PROBE_VIN, 25, 0, CMIX_PROBE_VOUT};
+    static const uint8_t bad_signal[] = {CMIX_PROBE_COUNT, 25, 0};
+    static const uint8_t bad_decimation[] = {CMIX_PROBE_VIN, 0, 0};
+    static const uint8_t over_budget[] = {CMIX_PROBE_VIN, 1, 0};
+    /* 25kHz控制频率下1kHz + 500Hz + 100Hz, 最坏情况 (1000 + 500 + 100) * 5 = 8000 B/s */
+    static const uint8_t subscription[] = {CMIX_PROBE_VIN, 25, 0, CMIX_PROBE_IIN, 50, 0, CMIX_PROBE_STATE, 250, 0};
+    const CMix_DCDC_Status_t *status = CMix_DCDC_Get_Status();
+    CMix_Telemetry_Stats_t stats;
+    CMix_UART_TX_Stats_t tx;
+    uint32_t reports, steps, frames, slot, vin;
+    bool cadence = true;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+
+    CMix_Runner_Check(CMix_Runner_Telemetry_Subscribe(bad_length, sizeof(bad_length)) == 0x02,
+                      "订阅长度不是3的倍数: 应答数据长度错误");
+    CMix_Runner_Check(CMix_Runner_Telemetry_Subscribe(bad_signal, sizeof(bad_signal)) == 0x04 &&
+                      CMix_Runner_Telemetry_Subscribe(bad_decimation, sizeof(bad_decimation)) == 0x04,
+                      "信号ID无效或分频为0: 应答参数超出范围");
+    CMix_Runner_Check(CMix_Runner_Telemetry_Subscribe(over_budget, sizeof(over_budget)) == 0x04,
+                      "Vin每控制步采样 (%u B/s) 超过字节率上限%u B/s: 拒绝",
+                      (unsigned)(CMIX_CONTROL_RATE_HZ * 5), (unsigned)CMIX_TELEMETRY_MAX_BYTES_PER_S);
+    CMix_Telemetry_Get_Stats(&stats);
+    CMix_Runner_Check(stats.signals == 0 && g_telemetry_rx.frames == 0, "拒绝的订阅不生效, 无遥测帧");
+
+    /* 订阅后连续运行 */
+    CMix_Runner_Check(CMix_Runner_Telemetry_Subscribe(subscription, sizeof(subscription)) == 0x00,
+                      "订阅Vin/25, Iin/50, 状态/250: 应答OK");
+    reports = g_decoder.cmd_count[0x07];
+    if (!CMix_Runner_Run_ms(CMIX_RUNNER_TELEMETRY_WINDOW_MS)) {
+        return false;
+    }
+    reports = g_decoder.cmd_count[0x07] - reports;
+
+    steps = g_telemetry_rx.step - g_telemetry_rx.first_step;
+    printf("  %u ms内遥测帧%u (%u B, %.0f B/s), 记录%u, 覆盖%u个控制步; 样本 Vin %u / Iin %u / 状态 %u\n",
+           (unsigned)CMIX_RUNNER_TELEMETRY_WINDOW_MS, (unsigned)g_telemetry_rx.frames, (unsigned)g_telemetry_rx.bytes,
+           g_telemetry_rx.bytes * 1000.0 / CMIX_RUNNER_TELEMETRY_WINDOW_MS, (unsigned)g_telemetry_rx.records,
+           (unsigned)steps, (unsigned)g_telemetry_rx.samples[0], (unsigned)g_telemetry_rx.samples[1],
+           (unsigned)g_telemetry_rx.samples[2]);
+
+    CMix_Runner_Check(g_telemetry_rx.sequence_gaps == 0 && g_telemetry_rx.lost == 0 && g_telemetry_rx.bad_records == 0,
+                      "帧序号连续, 无丢失记录, 记录长度与掩码一致");
+    CMix_Telemetry_Get_Stats(&stats);
+    CMix_Runner_Check(g_telemetry_rx.first_step == 0 && (stats.records - g_telemetry_rx.records) *
+                      CMIX_RUNNER_TELEMETRY_WINDOW_MS <= g_telemetry_rx.records * CMIX_RUNNER_TELEMETRY_LAG_MS,
+                      "记录从订阅后第一个控制步开始, 未发出的记录不超过%u ms (%u条)", (unsigned)CMIX_RUNNER_TELEMETRY_LAG_MS,
+                      (unsigned)(stats.records - g_telemetry_rx.records));
+    for (slot = 0; slot < g_telemetry_rx.count; slot++) {
+        if (g_telemetry_rx.samples[slot] != steps / g_telemetry_rx.decimation[slot] + 1) {
+            cadence = false;
+        }
+    }
+    CMix_Runner_Check(cadence && g_telemetry_rx.cadence_errors == 0, "各信号每分频个控制步一个样本, 无多余或缺失");
+    vin = status->input_voltage >> CMIX_PROBE_VOLTAGE_SHIFT;
+    CMix_Runner_Check(g_telemetry_rx.last_value[0] + 4 >= vin && g_telemetry_rx.last_value[0] <= vin + 4 &&
+                      g_telemetry_rx.last_value[2] == (uint16_t)((uint8_t)status->state | ((uint16_t)status->active_mode << 8)),
+                      "Vin %u mV, 状态0x%04X与控制器一致", (unsigned)g_telemetry_rx.last_value[0] << CMIX_PROBE_VOLTAGE_SHIFT,
+                      (unsigned)g_telemetry_rx.last_value[2]);
+    CMix_Hardware_UART_Get_TX_Stats(&tx);
+    CMix_Runner_Check(reports + 1 >= CMIX_RUNNER_TELEMETRY_WINDOW_MS / 100 && tx.frames_dropped == 0,
+                      "遥测期间状态上报%u次, 发送队列无丢帧", (unsigned)reports);
+
+    /* 停止: 积压帧发完后不再发送 */
+    CMix_Runner_Check(CMix_Runner_Telemetry_Subscribe(NULL, 0) == 0x00, "停止订阅: 应答OK");
+    if (!CMix_Runner_Run_ms(CMIX_RUNNER_TELEMETRY_LAG_MS)) {
+        return false;
+    }
+    frames = g_telemetry_rx.frames;
+    if (!CMix_Runner_Run_ms(50)) {
+        return false;
+    }
+    CMix_Telemetry_Get_Stats(&stats);
+    CMix_Runner_Check(stats.signals == 0 && g_telemetry_rx.frames == frames && stats.lost == 0,
+                      "停止后无遥测帧; 固件统计: 记录%u, 帧%u, 环最多积压%u字节", (unsigned)stats.records,
+                      (unsigned)stats.frames, (unsigned)stats.peak_bytes);
+    return true;
+}
+#endif /* CMIX_TELEMETRY_ENABLE */
+
+#if CMIX_SCOPE_ENABLE
+/**
+ * @brief 发送一条示波器命令并等待应答或回复
+ * @param data: 命令数据 (子命令 + 参数)
+ * @param len: 数据长度
+ * @retval 应答码; CMIX_RUNNER_SCOPE_REPLY + 回复长度 = 收到回复帧; -1 = 无应答
+ */
+static int CMix_Runner_Scope_Request(const uint8_t *data, uint8_t len)
+{
+    uint32_t acks = g_decoder.cmd_count[0x09];
+    uint32_t replies = g_decoder.cmd_count[0x10];
+
+    CMix_Runner_Send_Frame(0x10, data, len, false);
+    if (!CMix_Runner_Run_ms(CMIX_RUNNER_SCOPE_REPLY_MS)) {
+        return -1;
+    }
+    if (g_decoder.cmd_count[0x10] != replies) {
+        return CMIX_RUNNER_SCOPE_REPLY + g_decoder.cmd_len[0x10];
+    }
+    if (g_decoder.cmd_count[0x09] != acks) {
+        return g_decoder.cmd_data[0x09][0];
+    }
+    return -1;
+}
+
+/**
+ * @brief 逐块读出冻结的记录并拼接
+ * @param record: 记录输出 (不小于2 * CMIX_SCOPE_BUFFER_SAMPLES)
+ * @param length: 记录字节数输出
+ * @retval true = 各块序号连续且总长不超过缓冲
+ */
+static bool CMix_Runner_Scope_Read_All(uint8_t *record, uint32_t *length)
+{
+    uint8_t request[2] = {0x03, 0};
+    uint8_t count = 1;
+    int len;
+
+    *length = 0;
+    while (request[1] < count) {
+        len = CMix_Runner_Scope_Request(request, sizeof(request)) - CMIX_RUNNER_SCOPE_REPLY;
+        if (len < 3 || g_decoder.cmd_data[0x10][0] != 0x03 || g_decoder.cmd_data[0x10][1] != request[1] ||
+            *length + (uint32_t)(len - 3) > 2 * CMIX_SCOPE_BUFFER_SAMPLES) {
+            return false;
+        }
+        count = g_decoder.cmd_data[0x10][2];
+        memcpy(&record[*length], &g_decoder.cmd_data[0x10][3], (size_t)(len - 3));
+        *length += (uint32_t)(len - 3);
+        request[1]++;
+    }
+    return true;
+}
+
+/**
+ * @brief 示波器场景: 非法设置被拒绝; Vin上升沿触发, 触发样本位于触发前组数处; 分块读出;
+ *        强制触发按分频采满整个深度
+ * @param None
+ * @retval true = 运行完成
+ */
+static bool CMix_Runner_Scenario_Scope(void)
+{
+    static const uint8_t bad_length[] = {0x00, CMIX_PROBE_VIN, 0xFF, 0xFF, 0xFF, 0, 0};
+    static const uint8_t bad_probe[] = {0x00, CMIX_PROBE_COUNT, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0, 25, 1, 0};
+    static const uint8_t bad_channel[] = {0x00, CMIX_PROBE_VIN, CMIX_PROBE_VOUT, 0xFF, 0xFF, 2, 0, 0, 0, 25, 1, 0};
+    static const uint8_t bad_gap[] = {0x00, CMIX_PROBE_VIN, 0xFF, CMIX_PROBE_VOUT, 0xFF, 0, 0, 0, 0, 25, 1, 0};
+    static const uint8_t bad_divisor[] = {0x00, CMIX_PROBE_VIN, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0, 25, 0, 0};
+    static const uint8_t arm[] = {0x00, CMIX_PROBE_VIN, CMIX_PROBE_VOUT, CMIX_PROBE_VOLTAGE_PI_INTEGRAL, CMIX_PROBE_STATE,
+                                  0, CMIX_SCOPE_TRIGGER_RISING, CMIX_RUNNER_SCOPE_LEVEL & 0xFF, CMIX_RUNNER_SCOPE_LEVEL >> 8,
+                                  25, 1, 0};
+    static const uint8_t status_request[] = {0x01};
+    static const uint8_t force[] = {0x02};
+    static const uint8_t read_first[] = {0x03, 0};
+    static const uint8_t stop[] = {0x04};
+    static uint8_t record[2 * CMIX_SCOPE_BUFFER_SAMPLES];
+    const CMix_DCDC_Status_t *dcdc = CMix_DCDC_Get_Status();
+    const uint8_t *reply = g_decoder.cmd_data[0x10];
+    uint8_t read_past[2] = {0x03, 0};
+    CMix_Scope_Config_t config;
+    CMix_Scope_Status_t status;
+    int result;
+    uint32_t length = 0, elapsed_ms = 0, steps, steps_per_ms, i;
+    uint16_t depth, pre, vin, state;
+    bool below = true, complete;
+
+    if (!CMix_Runner_Boot(600)) {
+        return false;
+    }
+
+    CMix_Runner_Check(CMix_Runner_Scope_Request(bad_length, sizeof(bad_length)) == 0x02,
+                      "启动命令长度不是12: 应答数据长度错误");
+    CMix_Runner_Check(CMix_Runner_Scope_Request(bad_probe, sizeof(bad_probe)) == 0x04 &&
+                      CMix_Runner_Scope_Request(bad_channel, sizeof(bad_channel)) == 0x04 &&
+                      CMix_Runner_Scope_Request(bad_gap, sizeof(bad_gap)) == 0x04 &&
+                      CMix_Runner_Scope_Request(bad_divisor, sizeof(bad_divisor)) == 0x04,
+                      "探针ID无效、触发通道未使用、通道不连续或分频为0: 应答参数超出范围");
+    CMix_Runner_Check(CMix_Runner_Scope_Request(read_first, sizeof(read_first)) == 0x05 &&
+                      CMix_Runner_Scope_Request(force, sizeof(force)) == 0x04,
+                      "未启动时读出应答忙, 强制触发应答参数超出范围");
+
+    /* Vin 50V上升沿触发, 触发前25% */
+    CMix_Runner_Check(CMix_Runner_Scope_Request(arm, sizeof(arm)) == 0x00,
+                      "启动: Vin/Vout/电压环积分/状态, Vin上升沿%u mV, 触发前25%%, 分频1: 应答OK",
+                      (unsigned)CMIX_RUNNER_SCOPE_LEVEL << CMIX_PROBE_VOLTAGE_SHIFT);
+    if (!CMix_Runner_Run_ms(5)) {
+        return false;
+    }
+    CMix_Runner_Check(CMix_Runner_Scope_Request(status_request, sizeof(status_request)) == CMIX_RUNNER_SCOPE_REPLY + 10 &&
+                      reply[1] == CMIX_SCOPE_ARMED && reply[2] == 4 && reply[3] == 0,
+                      "Vin %u mV未越过阈值: 保持等待触发, 块数为0", (unsigned)dcdc->input_voltage);
+    CMix_Runner_Check(CMix_Runner_Scope_Request(read_first, sizeof(read_first)) == 0x05, "等待触发时读出: 应答忙");
+
+    CMix_Emu_ADC_Set_Channel(CMIX_ADC_VIN_CHANNEL, CMIX_RUNNER_SCOPE_VIN_RAW);
+    CMix_Scope_Get_Status(&status);
+    while (status.state != CMIX_SCOPE_DONE && elapsed_ms < CMIX_RUNNER_SCOPE_DONE_MS) {
+        if (!CMix_Runner_Run_ms(1)) {
+            return false;
+        }
+        elapsed_ms++;
+        CMix_Scope_Get_Status(&status);
+    }
+    depth = CMIX_SCOPE_BUFFER_SAMPLES / 4;
+    pre = (uint16_t)(depth / 4);
+    result = CMix_Runner_Scope_Request(status_request, sizeof(status_request));
+    CMix_Runner_Check(result == CMIX_RUNNER_SCOPE_REPLY + 10 && reply[1] == CMIX_SCOPE_DONE && (uint16_t)(reply[4] | (reply[5] << 8)) == pre &&
+                      (uint16_t)(reply[6] | (reply[7] << 8)) == depth,
+                      "Vin阶跃后%u ms内冻结: 深度%u组, 触发前%u组, %u块", (unsigned)elapsed_ms, (unsigned)depth,
+                      (unsigned)pre, (unsigned)reply[3]);
+    read_past[1] = reply[3];
+
+    complete = CMix_Runner_Scope_Read_All(record, &length) && length == (uint32_t)depth * 4 * 2;
+    CMix_Runner_Check(complete, "分块读出%u块, %u字节 (%u组 x 4通道)", (unsigned)read_past[1], (unsigned)length,
+                      (unsigned)depth);
+    if (!complete) {
+        return true;
+    }
+    for (i = 0; i < pre; i++) {
+        if ((uint16_t)(record[i * 8] | (record[i * 8 + 1] << 8)) >= CMIX_RUNNER_SCOPE_LEVEL) {
+            below = false;
+        }
+    }
+    vin = (uint16_t)(record[pre * 8] | (record[pre * 8 + 1] << 8));
+    CMix_Runner_Check(below && vin >= CMIX_RUNNER_SCOPE_LEVEL,
+                      "触发前%u组Vin均低于阈值, 第%u组 %u mV为第一个越过阈值的样本", (unsigned)pre, (unsigned)pre,
+                      (unsigned)vin << CMIX_PROBE_VOLTAGE_SHIFT);
+    vin = (uint16_t)(record[(depth - 1) * 8] | (record[(depth - 1) * 8 + 1] << 8));
+    state = (uint16_t)(record[(depth - 1) * 8 + 6] | (record[(depth - 1) * 8 + 7] << 8));
+    CMix_Runner_Check(vin > CMIX_RUNNER_SCOPE_LEVEL &&
+                      state == (uint16_t)((uint8_t)dcdc->state | ((uint16_t)dcdc->active_mode << 8)),
+                      "最后一组Vin %u mV, 状态0x%04X与控制器一致", (unsigned)vin << CMIX_PROBE_VOLTAGE_SHIFT, (unsigned)state);
+    CMix_Runner_Check(CMix_Runner_Scope_Request(read_first, 1) == 0x02 &&
+                      CMix_Runner_Scope_Request(read_past, sizeof(read_past)) == 0x04 &&
+                      CMix_Runner_Scope_Request(force, sizeof(force)) == 0x04,
+                      "读出缺少块序号或序号超出, 冻结后强制触发: 应答错误");
+
+    /* 强制触发: 单通道全深度, 触发前采满一半后立即触发, 按分频采满整个深度 */
+    CMix_Runner_Check(CMix_Runner_Scope_Request(stop, sizeof(stop)) == 0x00 &&
+                      (CMix_Scope_Get_Status(&status), status.state == CMIX_SCOPE_IDLE), "停止: 应答OK, 记录丢弃");
+    memset(&config, 0, sizeof(config));
+    config.probe[0] = CMIX_PROBE_VIN;
+    config.channels = 1;
+    config.trigger_mode = CMIX_SCOPE_TRIGGER_BELOW;     // 无符号探针低于0: 只能强制触发
+    config.pre_percent = 50;
+    config.divisor = CMIX_RUNNER_SCOPE_DIVISOR;
+    CMix_Runner_Check(CMix_Scope_Arm(&config) == CMIX_PROTOCOL_ERROR_OK && CMix_Scope_Force(), "单通道启动并强制触发");
+    steps = CMix_Emu_TIM_Update_Count();
+    steps_per_ms = (uint32_t)(CMix_Emu_Core_Clock() / CMix_Emu_TIM_Get_Period() / CMIX_CONTROL_DECIMATION / 1000 + 1);
+    elapsed_ms = 0;
+    CMix_Scope_Get_Status(&status);
+    while (status.state != CMIX_SCOPE_DONE && elapsed_ms < 4 * CMIX_RUNNER_SCOPE_DONE_MS) {
+        if (!CMix_Runner_Run_ms(1)) {
+            return false;
+        }
+        elapsed_ms++;
+        CMix_Scope_Get_Status(&status);
+    }
+    steps = (CMix_Emu_TIM_Update_Count() - steps) / CMIX_CONTROL_DECIMATION;
+    depth = CMIX_SCOPE_BUFFER_SAMPLES;
+    CMix_Runner_Check(status.state == CMIX_SCOPE_DONE && status.depth == depth && status.pre_samples == depth / 2 &&
+                      steps + CMIX_RUNNER_SCOPE_DIVISOR >= (uint32_t)depth * CMIX_RUNNER_SCOPE_DIVISOR &&
+                      steps <= (uint32_t)depth * CMIX_RUNNER_SCOPE_DIVISOR + steps_per_ms,
+                      "深度%u组 x 分频%u: %u ms (%u个控制步) 后冻结, 完成记录%u次", (unsigned)depth,
+                      (unsigned)CMIX_RUNNER_SCOPE_DIVISOR, (unsigned)elapsed_ms, (unsigned)steps,
+                      (unsigned)status.captures);
+    return true;
+}
+#endif /* CMIX_SCOPE_ENABLE */
+
+/**
+ * @brief 运行单个场景
+ * @param scenario: 场景
+ * @retval 0 = 通过, 1 = 失败
+ */
+static int CMix_Runner_Run_Scenario(const CMix_Runner_Scenario_t *scenario)
+{
+    bool completed;
+
+    printf("== %s: %s\n", scenario->name, scenario->description);
+    g_failures = 0;
+    completed = scenario->run();
+    CMix_Emu_UART_Set_Output(-1);                       // 写出-o文件的缓存
+    return (completed && g_failures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief 运行程序主函数 (在仿真器低地址栈上执行)
+ * @param argc: 参数个数
+ * @param argv: 参数表
+ * @retval 进程返回值
+ */
+static int CMix_Runner(int argc, char **argv)
+{
+    const char *name = "all";
+    uint32_t i, failed = 0;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++) {
+        if (strcmp(argv[arg], "-v") == 0) {
+            g_verbose = true;
+        } else if (strcmp(argv[arg], "-o") == 0 && arg + 1 < argc) {
+            g_output_fd = open(argv[++arg], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (g_output_fd < 0) {
+                perror(argv[arg]);
+                return 2;
+            }
+        } else if (argv[arg][0] != '-') {
+            name = argv[arg];
+        } else {
+            fprintf(stderr, "usage: %s [all|boot|protocol|control|cmp_trip|pwm_commit|awd_trip|param_store|blackbox|telemetry|scope] [-v] [-o file]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    if (strcmp(name, "all") != 0) {
+        for (i = 0; i < CMIX_RUNNER_SCENARIO_COUNT; i++) {
+            if (strcmp(name, g_scenarios[i].name) == 0) {
+                return CMix_Runner_Run_Scenario(&g_scenarios[i]);
+            }
+        }
+        fprintf(stderr, "unknown scenario: %s\n", name);
+        return 2;
+    }
+
+    /* 每个场景在子进程中从复位开始运行 */
+    for (i = 0; i < CMIX_RUNNER_SCENARIO_COUNT; i++) {
+        pid_t pid;
+        int status = 0;
+
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) {
+            _exit(CMix_Runner_Run_Scenario(&g_scenarios[i]));
+        }
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            printf("== %s: FAILED\n", g_scenarios[i].name);
+            failed++;
+        }
+    }
+    printf("== %u/%u scenarios passed\n", (unsigned)(CMIX_RUNNER_SCENARIO_COUNT - failed),
+           (unsigned)CMIX_RUNNER_SCENARIO_COUNT);
+    return failed == 0 ? 0 : 1;
+}
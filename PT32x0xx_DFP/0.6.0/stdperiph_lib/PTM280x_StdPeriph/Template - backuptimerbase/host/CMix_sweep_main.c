@@ -0,0 +1,724 @@
+/******************************************************************************
+  * @file    CMix_sweep_main.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix控制参数扫描与蒙特卡洛运行程序
+  *          在全部主机核上并行运行闭环联合仿真, 结果按任务号写入CSV
+  ******************************************************************************
+  * @attention
+  *
+  * 用法: cmix_sweep [-j 进程数] [-n 每点样本数] [-s 种子] [-o 文件] [-m avg|sw]
+  *                  [-d 启动时长] [-l 负载阶跃时长] [-r 稳定任务数] 参数=规格 ...
+  *   规格: 值                 固定值
+  *         起:止:点数         线性网格
+  *         起:止:点数:log     对数网格
+  *         标称%容差          均匀分布 ±容差% (蒙特卡洛)
+  *   参数: kp_v ki_v kp_i ki_i vset vbat L C esr dcr rload istep
+  *   任务数 = 各网格点数之积 x 每点样本数
+  *   -r N: 要求至少N个任务启动稳定 (无保护动作, 统计窗口内在±2%稳定带内),
+  *         不指定参数时只有一个标称点任务, -r 1即检查固件默认参数能够稳压
+  *
+  * 每个任务: 从0V软启动到设定值 (启动时长), 然后加恒流负载istep
+  * (负载阶跃时长, istep = 0时跳过), 输出上升/超调/稳定/稳态误差/纹波、
+  * 负载跌落/恢复、保护动作和电感电流峰值.
+  *
+  * 调度: 任务号区间按进程均分, 每个进程从自己区间的前端取任务, 区间取空
+  * 后从剩余最多的进程区间后端窃取一半. 区间 (起, 止) 打包在一个64位字中,
+  * 取任务和窃取都用CAS, 无锁. 固件控制模块为单实例, 每个任务在工作进程
+  * fork出的子进程中从初始状态运行, 结果直接写入共享映射内存.
+  *
+  * 随机数由种子和任务号决定, 结果与进程数和调度顺序无关.
+  *
+  * 返回值: 0 = 全部任务完成, 1 = 有任务异常退出, 2 = 用法错误,
+  *         3 = 启动稳定的任务少于-r要求
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "CMix_dcdc.h"
+#include "plant/CMix_cosim.h"
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_SWEEP_MAX_WORKERS      256
+#define CMIX_SWEEP_MAX_JOBS         10000000U
+#define CMIX_SWEEP_SETTLING_BAND    0.02        // 稳定带 ±2%
+#define CMIX_SWEEP_STEADY_WINDOW_S  0.1         // 稳态统计窗口
+#define CMIX_SWEEP_RANK_COUNT       5           // 汇总输出的最优任务数
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 扫描参数 */
+typedef enum {
+    CMIX_SWEEP_KP_V = 0,
+    CMIX_SWEEP_KI_V,
+    CMIX_SWEEP_KP_I,
+    CMIX_SWEEP_KI_I,
+    CMIX_SWEEP_VSET,
+    CMIX_SWEEP_VBAT,
+    CMIX_SWEEP_L,
+    CMIX_SWEEP_C,
+    CMIX_SWEEP_ESR,
+    CMIX_SWEEP_DCR,
+    CMIX_SWEEP_RLOAD,
+    CMIX_SWEEP_ISTEP,
+    CMIX_SWEEP_PARAM_COUNT
+} CMix_Sweep_Param_t;
+
+/* 参数取值方式 */
+typedef enum {
+    CMIX_SWEEP_FIXED = 0,
+    CMIX_SWEEP_LINEAR,
+    CMIX_SWEEP_LOG,
+    CMIX_SWEEP_TOLERANCE
+} CMix_Sweep_Kind_t;
+
+/* 参数轴 */
+typedef struct {
+    const char *name;
+    CMix_Sweep_Kind_t kind;
+    double nominal;                         // 固定值/标称值
+    double lo, hi;                          // 网格范围
+    uint32_t points;                        // 网格点数
+    double tolerance;                       // 相对容差
+} CMix_Sweep_Axis_t;
+
+/* 任务结果 (共享映射内存) */
+typedef enum {
+    CMIX_SWEEP_PENDING = 0,
+    CMIX_SWEEP_DONE,
+    CMIX_SWEEP_CRASHED
+} CMix_Sweep_Status_t;
+
+typedef struct {
+    uint8_t status;
+    uint8_t fault_flags;
+    uint8_t finite;
+    double fault_ms;                        // 保护动作时刻 (-1 = 无)
+    double il_peak;
+    double rise_ms;                         // -1 = 未到达
+    double overshoot_pct;
+    double settle_ms;                       // -1 = 未稳定
+    double final_v;
+    double error_v;
+    double ripple_mv;
+    double dip_v;                           // 负载阶跃跌落
+    double recovery_ms;                     // 负载阶跃恢复 (-1 = 未恢复)
+} CMix_Sweep_Result_t;
+
+/* 工作进程任务区间 (独占缓存行) */
+typedef struct {
+    uint64_t range;                         // 高32位起, 低32位止
+    uint32_t jobs;                          // 已运行任务数
+    uint32_t steals;                        // 窃取次数
+    double busy_s;                          // 运行任务耗时
+} __attribute__((aligned(64))) CMix_Sweep_Queue_t;
+
+/* ========================= 私有变量 ========================= */
+
+static CMix_Sweep_Axis_t g_axes[CMIX_SWEEP_PARAM_COUNT] = {
+    [CMIX_SWEEP_KP_V]  = {"kp_v"},
+    [CMIX_SWEEP_KI_V]  = {"ki_v"},
+    [CMIX_SWEEP_KP_I]  = {"kp_i"},
+    [CMIX_SWEEP_KI_I]  = {"ki_i"},
+    [CMIX_SWEEP_VSET]  = {"vset"},
+    [CMIX_SWEEP_VBAT]  = {"vbat"},
+    [CMIX_SWEEP_L]     = {"L"},
+    [CMIX_SWEEP_C]     = {"C"},
+    [CMIX_SWEEP_ESR]   = {"esr"},
+    [CMIX_SWEEP_DCR]   = {"dcr"},
+    [CMIX_SWEEP_RLOAD] = {"rload"},
+    [CMIX_SWEEP_ISTEP] = {"istep"},
+};
+
+static CMix_Plant_Model_t g_model = CMIX_PLANT_AVERAGED;
+static uint32_t g_samples = 1;
+static uint64_t g_seed = 1;
+static double g_startup_s = 1.5;
+static double g_load_step_s = 0.5;
+static uint32_t g_workers = 0;
+static uint32_t g_required_settled = 0;
+static CMix_Sweep_Queue_t *g_queues = NULL;
+static CMix_Sweep_Result_t *g_results = NULL;
+
+/* ========================= 私有函数声明 ========================= */
+
+static void CMix_Sweep_Usage(const char *program);
+static bool CMix_Sweep_Parse_Axis(const char *text);
+static uint64_t CMix_Sweep_Grid_Points(void);
+static uint64_t CMix_Sweep_Random(uint64_t *state);
+static void CMix_Sweep_Job_Values(uint32_t job, double values[CMIX_SWEEP_PARAM_COUNT]);
+static void CMix_Sweep_Run_Job(uint32_t job, CMix_Sweep_Result_t *result);
+static bool CMix_Sweep_Pop(CMix_Sweep_Queue_t *queue, uint32_t *job);
+static bool CMix_Sweep_Steal(uint32_t self, uint32_t *job);
+static void CMix_Sweep_Worker(uint32_t self);
+static bool CMix_Sweep_Write_CSV(const char *path, uint32_t jobs);
+static uint32_t CMix_Sweep_Print_Summary(uint32_t jobs, double wall_s);
+
+/* ========================= 程序入口 ========================= */
+
+int main(int argc, char **argv)
+{
+    const char *output = "sweep.csv";
+    CMix_Plant_Params_t defaults;
+    uint64_t jobs64;
+    uint32_t jobs, i, crashed = 0, settled;
+    size_t shared_size;
+    double wall_start;
+    void *shared;
+    int opt;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    /* 标称值: 固件默认PI参数和功率级默认参数 */
+    CMix_Plant_Default_Params(&defaults);
+    g_axes[CMIX_SWEEP_KP_V].nominal = CMIX_VOLTAGE_PI_KP;
+    g_axes[CMIX_SWEEP_KI_V].nominal = CMIX_VOLTAGE_PI_KI;
+    g_axes[CMIX_SWEEP_KP_I].nominal = CMIX_CURRENT_PI_KP;
+    g_axes[CMIX_SWEEP_KI_I].nominal = CMIX_CURRENT_PI_KI;
+    g_axes[CMIX_SWEEP_VSET].nominal = 24.0;
+    g_axes[CMIX_SWEEP_VBAT].nominal = defaults.battery_voltage;
+    g_axes[CMIX_SWEEP_L].nominal = defaults.inductance_h;
+    g_axes[CMIX_SWEEP_C].nominal = defaults.capacitance_f;
+    g_axes[CMIX_SWEEP_ESR].nominal = defaults.capacitor_esr_ohm;
+    g_axes[CMIX_SWEEP_DCR].nominal = defaults.inductor_dcr_ohm;
+    g_axes[CMIX_SWEEP_RLOAD].nominal = defaults.load_resistance;
+    g_axes[CMIX_SWEEP_ISTEP].nominal = 5.0;
+
+    while ((opt = getopt(argc, argv, "j:n:s:o:m:d:l:r:h")) != -1) {
+        switch (opt) {
+            case 'j': g_workers = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'n': g_samples = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': g_seed = strtoull(optarg, NULL, 0); break;
+            case 'o': output = optarg; break;
+            case 'd': g_startup_s = strtod(optarg, NULL); break;
+            case 'l': g_load_step_s = strtod(optarg, NULL); break;
+            case 'r': g_required_settled = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'm':
+                if (strcmp(optarg, "avg") == 0) {
+                    g_model = CMIX_PLANT_AVERAGED;
+                } else if (strcmp(optarg, "sw") == 0) {
+                    g_model = CMIX_PLANT_SWITCHING;
+                } else {
+                    CMix_Sweep_Usage(argv[0]);
+                    return 2;
+                }
+                break;
+            default:
+                CMix_Sweep_Usage(argv[0]);
+                return 2;
+        }
+    }
+    for (; optind < argc; optind++) {
+        if (!CMix_Sweep_Parse_Axis(argv[optind])) {
+            fprintf(stderr, "bad parameter: %s\n", argv[optind]);
+            CMix_Sweep_Usage(argv[0]);
+            return 2;
+        }
+    }
+    if (g_samples == 0 || g_startup_s <= CMIX_SWEEP_STEADY_WINDOW_S) {
+        CMix_Sweep_Usage(argv[0]);
+        return 2;
+    }
+
+    jobs64 = CMix_Sweep_Grid_Points() * g_samples;
+    if (jobs64 == 0 || jobs64 > CMIX_SWEEP_MAX_JOBS) {
+        fprintf(stderr, "job count %llu out of range\n", (unsigned long long)jobs64);
+        return 2;
+    }
+    jobs = (uint32_t)jobs64;
+
+    if (g_workers == 0) {
+        g_workers = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (g_workers > jobs) {
+        g_workers = jobs;
+    }
+    if (g_workers > CMIX_SWEEP_MAX_WORKERS) {
+        g_workers = CMIX_SWEEP_MAX_WORKERS;
+    }
+
+    /* 任务区间和结果放在共享匿名映射中, 工作进程和任务子进程直接写入 */
+    shared_size = sizeof(CMix_Sweep_Queue_t) * g_workers + sizeof(CMix_Sweep_Result_t) * jobs;
+    shared = mmap(NULL, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    g_queues = (CMix_Sweep_Queue_t *)shared;
+    g_results = (CMix_Sweep_Result_t *)(g_queues + g_workers);
+    for (i = 0; i < g_workers; i++) {
+        uint64_t begin = (uint64_t)jobs * i / g_workers;
+        uint64_t end = (uint64_t)jobs * (i + 1) / g_workers;
+        g_queues[i].range = (begin << 32) | end;
+    }
+
+    printf("%u个任务 (%llu个网格点 x %u个样本), %u个工作进程, %s模型, 启动%.2f s + 负载阶跃%.2f s\n",
+           (unsigned)jobs, (unsigned long long)CMix_Sweep_Grid_Points(), (unsigned)g_samples,
+           (unsigned)g_workers, g_model == CMIX_PLANT_AVERAGED ? "平均" : "开关", g_startup_s, g_load_step_s);
+
+    wall_start = CMix_Cosim_Host_Time();
+    for (i = 0; i < g_workers; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            CMix_Sweep_Worker(i);
+            _exit(0);
+        }
+        if (pid < 0) {
+            perror("fork");
+            return 1;
+        }
+    }
+    while (wait(NULL) > 0 || errno == EINTR) {
+    }
+
+    for (i = 0; i < jobs; i++) {
+        if (g_results[i].status != CMIX_SWEEP_DONE) {
+            crashed++;
+        }
+    }
+    settled = CMix_Sweep_Print_Summary(jobs, CMix_Cosim_Host_Time() - wall_start);
+    if (!CMix_Sweep_Write_CSV(output, jobs)) {
+        return 1;
+    }
+    if (crashed > 0) {
+        printf("%u个任务异常退出\n", (unsigned)crashed);
+        return 1;
+    }
+    if (settled < g_required_settled) {
+        printf("启动稳定的任务%u个, 少于要求的%u个\n", (unsigned)settled, (unsigned)g_required_settled);
+        return 3;
+    }
+    return 0;
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 打印用法
+ */
+static void CMix_Sweep_Usage(const char *program)
+{
+    uint32_t p;
+
+    fprintf(stderr, "usage: %s [-j workers] [-n samples] [-s seed] [-o file.csv] [-m avg|sw]\n"
+                    "       [-d startup_s] [-l load_step_s] [-r min_settled] name=spec ...\n"
+                    "  spec: value | lo:hi:n | lo:hi:n:log | nominal%%tolerance\n"
+                    "  names:", program);
+    for (p = 0; p < CMIX_SWEEP_PARAM_COUNT; p++) {
+        fprintf(stderr, " %s", g_axes[p].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+/**
+ * @brief 解析"参数=规格"
+ * @param text: 命令行参数
+ * @retval true = 成功
+ */
+static bool CMix_Sweep_Parse_Axis(const char *text)
+{
+    const char *spec = strchr(text, '=');
+    CMix_Sweep_Axis_t *axis = NULL;
+    char log_suffix[8] = "";
+    double a, b, tolerance;
+    unsigned points;
+    uint32_t p;
+
+    if (spec == NULL) {
+        return false;
+    }
+    for (p = 0; p < CMIX_SWEEP_PARAM_COUNT; p++) {
+        if (strlen(g_axes[p].name) == (size_t)(spec - text) && strncmp(g_axes[p].name, text, spec - text) == 0) {
+            axis = &g_axes[p];
+        }
+    }
+    if (axis == NULL) {
+        return false;
+    }
+    spec++;
+
+    if (sscanf(spec, "%lf:%lf:%u:%7s", &a, &b, &points, log_suffix) == 4) {
+        if (strcmp(log_suffix, "log") != 0 || a <= 0.0 || b <= 0.0 || points == 0) {
+            return false;
+        }
+        axis->kind = CMIX_SWEEP_LOG;
+    } else if (sscanf(spec, "%lf:%lf:%u", &a, &b, &points) == 3) {
+        if (points == 0) {
+            return false;
+        }
+        axis->kind = CMIX_SWEEP_LINEAR;
+    } else if (sscanf(spec, "%lf%%%lf", &a, &tolerance) == 2) {
+        axis->kind = CMIX_SWEEP_TOLERANCE;
+        axis->nominal = a;
+        axis->tolerance = tolerance / 100.0;
+        return true;
+    } else if (sscanf(spec, "%lf", &a) == 1) {
+        axis->kind = CMIX_SWEEP_FIXED;
+        axis->nominal = a;
+        return true;
+    } else {
+        return false;
+    }
+    axis->lo = a;
+    axis->hi = b;
+    axis->points = points;
+    return true;
+}
+
+/**
+ * @brief 网格点数 (各网格轴点数之积)
+ */
+static uint64_t CMix_Sweep_Grid_Points(void)
+{
+    uint64_t points = 1;
+    uint32_t p;
+
+    for (p = 0; p < CMIX_SWEEP_PARAM_COUNT; p++) {
+        if (g_axes[p].kind == CMIX_SWEEP_LINEAR || g_axes[p].kind == CMIX_SWEEP_LOG) {
+            points *= g_axes[p].points;
+            if (points > CMIX_SWEEP_MAX_JOBS) {
+                return 0;
+            }
+        }
+    }
+    return points;
+}
+
+/**
+ * @brief splitmix64
+ */
+static uint64_t CMix_Sweep_Random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief 计算任务的参数值 (混合进制展开网格序号, 容差按种子和任务号抽样)
+ * @param job: 任务号
+ * @param values: 参数值
+ * @retval None
+ */
+static void CMix_Sweep_Job_Values(uint32_t job, double values[CMIX_SWEEP_PARAM_COUNT])
+{
+    uint64_t grid = job / g_samples;
+    uint64_t rng = g_seed * 0xD1B54A32D192ED03ULL ^ job;
+    uint32_t p;
+
+    for (p = 0; p < CMIX_SWEEP_PARAM_COUNT; p++) {
+        const CMix_Sweep_Axis_t *axis = &g_axes[p];
+        double u = (double)(CMix_Sweep_Random(&rng) >> 11) / 9007199254740992.0;   // [0,1)
+        double x;
+
+        switch (axis->kind) {
+            case CMIX_SWEEP_LINEAR:
+            case CMIX_SWEEP_LOG:
+                x = (axis->points > 1) ? (double)(grid % axis->points) / (axis->points - 1) : 0.0;
+                grid /= axis->points;
+                values[p] = (axis->kind == CMIX_SWEEP_LINEAR) ? axis->lo + (axis->hi - axis->lo) * x
+                                                              : axis->lo * pow(axis->hi / axis->lo, x);
+                break;
+            case CMIX_SWEEP_TOLERANCE:
+                values[p] = axis->nominal * (1.0 + axis->tolerance * (2.0 * u - 1.0));
+                break;
+            default:
+                values[p] = axis->nominal;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief 运行一个任务 (在任务子进程中调用)
+ * @param job: 任务号
+ * @param result: 结果
+ * @retval None
+ */
+static void CMix_Sweep_Run_Job(uint32_t job, CMix_Sweep_Result_t *result)
+{
+    double values[CMIX_SWEEP_PARAM_COUNT];
+    CMix_Plant_Params_t params;
+    CMix_Plant_Metrics_t metrics;
+    CMix_Plant_Result_t step;
+    CMix_Cosim_t cosim;
+    double setpoint;
+
+    CMix_Sweep_Job_Values(job, values);
+    setpoint = values[CMIX_SWEEP_VSET];
+
+    CMix_Plant_Default_Params(&params);
+    params.model = g_model;
+    params.battery_voltage = values[CMIX_SWEEP_VBAT];
+    params.inductance_h = values[CMIX_SWEEP_L];
+    params.capacitance_f = values[CMIX_SWEEP_C];
+    params.capacitor_esr_ohm = values[CMIX_SWEEP_ESR];
+    params.inductor_dcr_ohm = values[CMIX_SWEEP_DCR];
+    params.load_resistance = values[CMIX_SWEEP_RLOAD];
+    params.seed = (uint32_t)(job + 1);
+
+    CMix_Cosim_Start(&cosim, &params, NULL);
+    CMix_DCDC_Set_PI_Gains((float)values[CMIX_SWEEP_KP_V], (float)values[CMIX_SWEEP_KI_V],
+                           (float)values[CMIX_SWEEP_KP_I], (float)values[CMIX_SWEEP_KI_I]);
+    CMix_DCDC_Set_Output_Voltage((uint32_t)(setpoint * 1000.0 + 0.5));
+
+    /* 启动 */
+    CMix_Plant_Metrics_Start(&metrics, 0.0, 0.0, setpoint, CMIX_SWEEP_SETTLING_BAND,
+                             g_startup_s - CMIX_SWEEP_STEADY_WINDOW_S);
+    CMix_Cosim_Run(&cosim, g_startup_s, &metrics);
+    CMix_Plant_Metrics_Result(&metrics, &step);
+    result->finite = metrics.finite;
+    result->rise_ms = (step.rise_time_s < 0.0) ? -1.0 : step.rise_time_s * 1e3;
+    result->overshoot_pct = step.overshoot_pct;
+    result->settle_ms = (step.settling_time_s < 0.0) ? -1.0 : step.settling_time_s * 1e3;
+    result->final_v = step.final_value;
+    result->error_v = step.steady_error;
+    result->ripple_mv = step.ripple_pp * 1e3;
+    result->dip_v = 0.0;
+    result->recovery_ms = -1.0;
+
+    /* 负载阶跃: 恢复目标为阶跃前电压 */
+    if (values[CMIX_SWEEP_ISTEP] != 0.0 && g_load_step_s > 0.0 && cosim.fault_time_s < 0.0) {
+        double t0 = cosim.plant.time_s;
+        double initial = cosim.plant.vout_avg;
+        double dip = initial;
+
+        cosim.plant.params.load_current = values[CMIX_SWEEP_ISTEP];
+        CMix_Plant_Metrics_Start(&metrics, t0, initial * (1.0 - CMIX_SWEEP_SETTLING_BAND) - 1e-9, initial, 1.0,
+                                 t0 + g_load_step_s - CMIX_SWEEP_STEADY_WINDOW_S);
+        while (cosim.plant.time_s < t0 + g_load_step_s - 1e-9) {
+            CMix_Cosim_Run(&cosim, 1e-3, &metrics);
+            if (cosim.plant.vout_avg < dip) {
+                dip = cosim.plant.vout_avg;
+            }
+        }
+        CMix_Plant_Metrics_Result(&metrics, &step);
+        result->finite = result->finite && metrics.finite;
+        result->dip_v = initial - dip;
+        result->recovery_ms = (step.settling_time_s < 0.0) ? -1.0 : step.settling_time_s * 1e3;
+    }
+
+    result->fault_flags = CMix_DCDC_Get_Safety_Status()->fault_flags;
+    result->fault_ms = (cosim.fault_time_s < 0.0) ? -1.0 : cosim.fault_time_s * 1e3;
+    result->il_peak = cosim.plant.il_peak;
+    result->status = CMIX_SWEEP_DONE;
+}
+
+/**
+ * @brief 从本进程区间前端取一个任务
+ * @param queue: 任务区间
+ * @param job: 任务号
+ * @retval true = 取到
+ */
+static bool CMix_Sweep_Pop(CMix_Sweep_Queue_t *queue, uint32_t *job)
+{
+    uint64_t old = __atomic_load_n(&queue->range, __ATOMIC_ACQUIRE);
+
+    for (;;) {
+        uint32_t begin = (uint32_t)(old >> 32);
+        uint32_t end = (uint32_t)old;
+
+        if (begin >= end) {
+            return false;
+        }
+        if (__atomic_compare_exchange_n(&queue->range, &old, ((uint64_t)(begin + 1) << 32) | end, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *job = begin;
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief 从剩余任务最多的进程区间后端窃取一半
+ * @param self: 本进程序号
+ * @param job: 窃取区间的第一个任务号 (其余放入本进程区间)
+ * @retval true = 窃取成功, false = 所有区间为空
+ */
+static bool CMix_Sweep_Steal(uint32_t self, uint32_t *job)
+{
+    for (;;) {
+        uint32_t victim = self, best = 0, i;
+        uint64_t old;
+
+        for (i = 0; i < g_workers; i++) {
+            uint64_t range = __atomic_load_n(&g_queues[i].range, __ATOMIC_ACQUIRE);
+            uint32_t remaining = (uint32_t)range - (uint32_t)(range >> 32);
+
+            if (i != self && (uint32_t)(range >> 32) < (uint32_t)range && remaining > best) {
+                best = remaining;
+                victim = i;
+            }
+        }
+        if (victim == self) {
+            return false;
+        }
+
+        old = __atomic_load_n(&g_queues[victim].range, __ATOMIC_ACQUIRE);
+        {
+            uint32_t begin = (uint32_t)(old >> 32);
+            uint32_t end = (uint32_t)old;
+            uint32_t take;
+
+            if (begin >= end) {
+                continue;                                   // 已被取空, 重新选择
+            }
+            take = (end - begin + 1) / 2;
+            if (__atomic_compare_exchange_n(&g_queues[victim].range, &old,
+                                            ((uint64_t)begin << 32) | (end - take), false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                /* 本进程区间为空, 其他进程不会从中窃取, 直接写入 */
+                __atomic_store_n(&g_queues[self].range, ((uint64_t)(end - take + 1) << 32) | end,
+                                 __ATOMIC_RELEASE);
+                g_queues[self].steals++;
+                *job = end - take;
+                return true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 工作进程: 取任务并在子进程中运行, 直到所有区间为空
+ * @param self: 本进程序号
+ * @retval None
+ */
+static void CMix_Sweep_Worker(uint32_t self)
+{
+    CMix_Sweep_Queue_t *queue = &g_queues[self];
+    uint32_t job;
+
+    while (CMix_Sweep_Pop(queue, &job) || CMix_Sweep_Steal(self, &job)) {
+        double start = CMix_Cosim_Host_Time();
+        int status = 0;
+        pid_t pid;
+
+        pid = fork();
+        if (pid == 0) {
+            CMix_Sweep_Run_Job(job, &g_results[job]);
+            _exit(0);
+        }
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            g_results[job].status = CMIX_SWEEP_CRASHED;
+        }
+        queue->jobs++;
+        queue->busy_s += CMix_Cosim_Host_Time() - start;
+    }
+}
+
+/**
+ * @brief 按任务号顺序写出CSV (参数列 + 结果列)
+ * @param path: 文件路径
+ * @param jobs: 任务数
+ * @retval true = 成功
+ */
+static bool CMix_Sweep_Write_CSV(const char *path, uint32_t jobs)
+{
+    FILE *file = fopen(path, "w");
+    uint32_t job, p;
+
+    if (file == NULL) {
+        perror(path);
+        return false;
+    }
+
+    fprintf(file, "job");
+    for (p = 0; p < CMIX_SWEEP_PARAM_COUNT; p++) {
+        fprintf(file, ",%s", g_axes[p].name);
+    }
+    fprintf(file, ",status,finite,fault_flags,fault_ms,il_peak_a,rise_ms,overshoot_pct,settle_ms,"
+                  "final_v,error_v,ripple_mv,dip_v,recovery_ms\n");
+
+    for (job = 0; job < jobs; job++) {
+        const CMix_Sweep_Result_t *r = &g_results[job];
+        double values[CMIX_SWEEP_PARAM_COUNT];
+
+        CMix_Sweep_Job_Values(job, values);
+        fprintf(file, "%u", (unsigned)job);
+        for (p = 0; p < CMIX_SWEEP_PARAM_COUNT; p++) {
+            fprintf(file, ",%.6g", values[p]);
+        }
+        fprintf(file, ",%s,%u,0x%02X,%.3f,%.3f,%.3f,%.2f,%.3f,%.4f,%.4f,%.2f,%.4f,%.3f\n",
+                r->status == CMIX_SWEEP_DONE ? "done" : "crashed", (unsigned)r->finite, (unsigned)r->fault_flags,
+                r->fault_ms, r->il_peak, r->rise_ms, r->overshoot_pct, r->settle_ms, r->final_v, r->error_v,
+                r->ripple_mv, r->dip_v, r->recovery_ms);
+    }
+
+    fclose(file);
+    printf("结果写入 %s\n", path);
+    return true;
+}
+
+/**
+ * @brief 打印调度统计和最优任务
+ * @param jobs: 任务数
+ * @param wall_s: 总耗时
+ * @retval 启动稳定 (无保护动作) 的任务数
+ */
+static uint32_t CMix_Sweep_Print_Summary(uint32_t jobs, double wall_s)
+{
+    uint32_t rank[CMIX_SWEEP_RANK_COUNT];
+    uint32_t ranked = 0, faults = 0, settled = 0, job, i;
+    double busy = 0.0;
+
+    for (i = 0; i < g_workers; i++) {
+        busy += g_queues[i].busy_s;
+    }
+    printf("耗时 %.2f s, %.1f 任务/s, 并行度 %.2f (任务总耗时/墙钟)\n", wall_s, jobs / wall_s, busy / wall_s);
+    for (i = 0; i < g_workers; i++) {
+        printf("  进程%-3u 任务%6u 窃取%4u 忙 %.2f s\n", (unsigned)i, (unsigned)g_queues[i].jobs,
+               (unsigned)g_queues[i].steals, g_queues[i].busy_s);
+    }
+
+    /* 排序: 无保护动作且稳定的任务按稳定时间, 其余不参与 */
+    for (job = 0; job < jobs; job++) {
+        const CMix_Sweep_Result_t *r = &g_results[job];
+
+        if (r->status != CMIX_SWEEP_DONE || !r->finite || r->fault_ms >= 0.0) {
+            faults++;
+            continue;
+        }
+        if (r->settle_ms < 0.0) {
+            continue;
+        }
+        settled++;
+        for (i = ranked; i > 0 && g_results[rank[i - 1]].settle_ms > r->settle_ms; i--) {
+            if (i < CMIX_SWEEP_RANK_COUNT) {
+                rank[i] = rank[i - 1];
+            }
+        }
+        if (i < CMIX_SWEEP_RANK_COUNT) {
+            rank[i] = job;
+            if (ranked < CMIX_SWEEP_RANK_COUNT) {
+                ranked++;
+            }
+        }
+    }
+
+    printf("保护动作/异常 %u个, 稳定 (±%.0f%%) %u个, 其中稳定时间最短:\n", (unsigned)faults,
+           CMIX_SWEEP_SETTLING_BAND * 100.0, (unsigned)settled);
+    for (i = 0; i < ranked; i++) {
+        const CMix_Sweep_Result_t *r = &g_results[rank[i]];
+        double values[CMIX_SWEEP_PARAM_COUNT];
+
+        CMix_Sweep_Job_Values(rank[i], values);
+        printf("  任务%-7u kp_v %.4g ki_v %.4g kp_i %.4g ki_i %.4g: 稳定 %.1f ms, 超调 %.1f%%, 误差 %+.3f V\n",
+               (unsigned)rank[i], values[CMIX_SWEEP_KP_V], values[CMIX_SWEEP_KI_V], values[CMIX_SWEEP_KP_I],
+               values[CMIX_SWEEP_KI_I], r->settle_ms, r->overshoot_pct, r->error_v);
+    }
+    if (ranked == 0) {
+        printf("  (无)\n");
+    }
+    return settled;
+}
@@ -0,0 +1,158 @@
+/******************************************************************************
+  * @file    CMix_trace_main.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix跟踪记录解码程序
+  *          从UART发送字节流中提取协议帧, 把跟踪记录还原为文本
+  ******************************************************************************
+  * @attention
+  *
+  * 用法: cmix_trace [文件]
+  *   文件为固件UART发送方向的原始字节 (串口抓取, 或cmix_emu -o), 缺省读标准输入.
+  *   每条跟踪记录输出一行 "[ms] 文本", ms为固件系统时间低16位;
+  *   文本调试帧 (CMIX_CMD_DEBUG_INFO) 原样输出, 其他帧只计数.
+  *
+  * 格式表与固件同源 (CMix_trace_fmt.h), 解码的固件须与本程序同一版本构建.
+  *
+  * 返回值: 0 = 全部帧CRC正确且记录有效, 1 = 有错误帧/记录或丢帧, 2 = 用法错误
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "CMix_protocol.h"
+#include "trace/CMix_trace_decode.h"
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 字节流帧重组 */
+typedef struct {
+    uint8_t buffer[CMIX_PROTOCOL_MAX_DATA_LEN + 5];
+    uint16_t index;
+    uint32_t frames;
+    uint32_t bad_frames;
+    uint32_t debug_frames;
+} CMix_Trace_Stream_t;
+
+/* ========================= 私有函数声明 ========================= */
+
+static uint16_t CMix_Trace_CRC16(const uint8_t *data, uint16_t length);
+static void CMix_Trace_Print_Record(void *context, uint16_t ms, const char *text);
+static void CMix_Trace_Feed(CMix_Trace_Stream_t *stream, CMix_Trace_Decoder_t *decoder, uint8_t byte);
+
+/* ========================= 主函数 ========================= */
+
+int main(int argc, char **argv)
+{
+    CMix_Trace_Stream_t stream;
+    CMix_Trace_Decoder_t decoder;
+    FILE *input = stdin;
+    int byte;
+
+    if (argc > 2 || (argc == 2 && argv[1][0] == '-' && argv[1][1] != '\0')) {
+        fprintf(stderr, "usage: %s [file]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2 && strcmp(argv[1], "-") != 0) {
+        input = fopen(argv[1], "rb");
+        if (input == NULL) {
+            perror(argv[1]);
+            return 2;
+        }
+    }
+
+    memset(&stream, 0, sizeof(stream));
+    CMix_Trace_Decoder_Init(&decoder);
+    while ((byte = fgetc(input)) != EOF) {
+        CMix_Trace_Feed(&stream, &decoder, (uint8_t)byte);
+    }
+    if (input != stdin) {
+        fclose(input);
+    }
+
+    fprintf(stderr, "%u帧 (CRC错误%u), 跟踪帧%u/记录%u, 文本调试帧%u; 固件丢失记录%u, 丢帧%u, 无效记录%u\n",
+            (unsigned)stream.frames, (unsigned)stream.bad_frames, (unsigned)decoder.frames,
+            (unsigned)decoder.records, (unsigned)stream.debug_frames, (unsigned)decoder.lost,
+            (unsigned)decoder.sequence_gaps, (unsigned)decoder.bad_records);
+    return (stream.bad_frames == 0 && decoder.sequence_gaps == 0 && decoder.bad_records == 0) ? 0 : 1;
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief CRC16-Modbus (与固件协议一致)
+ * @param data: 数据
+ * @param length: 长度
+ * @retval CRC
+ */
+static uint16_t CMix_Trace_CRC16(const uint8_t *data, uint16_t length)
+{
+    uint16_t crc = 0xFFFF;
+    uint16_t i;
+    uint8_t bit;
+
+    for (i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 输出一条还原的记录
+ */
+static void CMix_Trace_Print_Record(void *context, uint16_t ms, const char *text)
+{
+    (void)context;
+    printf("[%5u] %s\n", (unsigned)ms, text);
+}
+
+/**
+ * @brief 输入一个字节, 整帧收齐后校验并解码
+ * @param stream: 帧重组状态
+ * @param decoder: 跟踪记录解码器
+ * @param byte: 字节
+ * @retval None
+ */
+static void CMix_Trace_Feed(CMix_Trace_Stream_t *stream, CMix_Trace_Decoder_t *decoder, uint8_t byte)
+{
+    uint8_t cmd, len;
+    uint16_t crc;
+
+    if (stream->index == 0 && byte != CMIX_PROTOCOL_FRAME_HEADER) {
+        return;                                         // 等待帧头
+    }
+    stream->buffer[stream->index++] = byte;
+
+    if (stream->index == 3 && stream->buffer[2] > CMIX_PROTOCOL_MAX_DATA_LEN) {
+        stream->bad_frames++;
+        stream->index = 0;
+        return;
+    }
+    if (stream->index < 3 || stream->index < (uint16_t)(stream->buffer[2] + 5)) {
+        return;
+    }
+
+    cmd = stream->buffer[1];
+    len = stream->buffer[2];
+    crc = (uint16_t)(stream->buffer[3 + len] | (stream->buffer[4 + len] << 8));
+    stream->index = 0;
+    if (crc != CMix_Trace_CRC16(stream->buffer, (uint16_t)(3 + len))) {
+        stream->bad_frames++;
+        return;
+    }
+    stream->frames++;
+
+    if (cmd == CMIX_CMD_TRACE) {
+        CMix_Trace_Decode_Frame(decoder, &stream->buffer[3], len, CMix_Trace_Print_Record, NULL);
+    } else if (cmd == CMIX_CMD_DEBUG_INFO) {
+        stream->debug_frames++;
+        printf("[  txt] %.*s\n", (int)len, (const char *)&stream->buffer[3]);
+    }
+}
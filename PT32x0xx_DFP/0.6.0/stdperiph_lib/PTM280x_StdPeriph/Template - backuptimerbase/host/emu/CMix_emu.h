@@ -0,0 +1,155 @@
+/******************************************************************************
+  * @file    CMix_emu.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix主机仿真器接口头文件
+  *          PT32x0xx寄存器文件仿真, 供主机运行程序驱动固件和注入激励
+  ******************************************************************************
+  * @attention
+  *
+  * CMix主机仿真器
+  * 固件源码按原样编译为主机程序, 外设寄存器地址 (APB/AHB/SCS) 映射为
+  * 无访问权限的页面. 每次寄存器访问触发缺页异常, 仿真器在异常中完成
+  * 外设读写语义并单步执行该指令, 随后评估中断并在固件上下文中调用
+  * 中断处理函数.
+  *
+  * 时间模型为确定性的周期计数: 每次寄存器访问计CMIX_EMU_BUS_CYCLES周期,
+  * __NOP计1周期, __WFI直接跳到下一个外设事件. 纯计算不计时, 处理函数的
+  * 实际开销以主机耗时单独统计.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_EMU_H
+#define __CMIX_EMU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_EMU_BUS_CYCLES         2           // 每次寄存器访问计入的周期数
+#define CMIX_EMU_IRQ_COUNT          32          // 外部中断数量
+#define CMIX_EMU_IRQ_SYSTICK        (-1)        // SysTick统计编号 (与SysTick_IRQn一致)
+#define CMIX_EMU_STALL_MS           2000        // 仿真时间停止推进超过该主机时间视为停滞
+#define CMIX_EMU_FLASH_SIZE         0x8000U     // 内部Flash容量 (主程序区)
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 运行停止原因 */
+typedef enum {
+    CMIX_EMU_STOP_TIME = 0,                 // 到达指定仿真时间
+    CMIX_EMU_STOP_RESET,                    // 固件请求系统复位 (NVIC_SystemReset)
+    CMIX_EMU_STOP_STALL,                    // 仿真时间停止推进 (死循环, 如assert_failed)
+    CMIX_EMU_STOP_FAULT,                    // 访问非法地址或触发无处理函数的中断
+    CMIX_EMU_STOP_EXIT                      // 固件主函数返回
+} CMix_Emu_Stop_t;
+
+/* 中断统计 */
+typedef struct {
+    uint32_t entries;                       // 进入次数
+    uint32_t latency_max;                   // 最大响应延迟 (周期, 标志置位到进入处理函数)
+    uint64_t latency_sum;                   // 响应延迟累计 (周期)
+    uint64_t busy_cycles;                   // 处理函数内仿真周期累计
+    uint64_t host_ns;                       // 处理函数内主机耗时累计 (ns)
+} CMix_Emu_IRQ_Stats_t;
+
+/* 仿真器全局统计 */
+typedef struct {
+    uint64_t reads;                         // 寄存器读次数
+    uint64_t writes;                        // 寄存器写次数
+    uint64_t nop_count;                     // __NOP次数
+    uint64_t wfi_count;                     // __WFI次数
+    uint64_t sleep_cycles;                  // __WFI休眠周期累计
+    uint64_t host_ns;                       // 固件上下文主机耗时累计 (ns)
+} CMix_Emu_Stats_t;
+
+/* Flash编程统计 (IFMC) */
+typedef struct {
+    uint32_t programs;                      // 字编程次数
+    uint32_t erases;                        // 页擦除次数
+    uint32_t overwrites;                    // 对未擦除的字编程次数
+    uint32_t errors;                        // 键/地址/命令错误次数
+} CMix_Emu_Flash_Stats_t;
+
+/* ADC采样值来源: 返回12位转换结果 */
+typedef uint16_t (*CMix_Emu_ADC_Source_t)(void *context, uint8_t channel, uint64_t cycle);
+
+/* 外设事件回调 (TIM1更新事件, UART发送字节等) */
+typedef void (*CMix_Emu_TIM_Hook_t)(void *context, uint64_t cycle);
+typedef void (*CMix_Emu_UART_Hook_t)(void *context, uint8_t byte, uint64_t cycle);
+
+/* ========================= 函数声明 ========================= */
+
+/* 仿真器控制 */
+int CMix_Emu_Main(int (*runner)(int argc, char **argv), int argc, char **argv);
+void CMix_Emu_Init(void);
+void CMix_Emu_Start(void (*entry)(void));
+CMix_Emu_Stop_t CMix_Emu_Run_Until(uint64_t cycle);
+CMix_Emu_Stop_t CMix_Emu_Run_For_us(uint64_t us);
+const char *CMix_Emu_Stop_Reason(void);
+
+/* 时间 */
+uint64_t CMix_Emu_Cycle(void);
+uint32_t CMix_Emu_Core_Clock(void);
+uint32_t CMix_Emu_Periph_Clock(void);
+uint64_t CMix_Emu_us_To_Cycles(uint64_t us);
+double CMix_Emu_Cycles_To_us(uint64_t cycles);
+
+/* 统计 */
+const CMix_Emu_IRQ_Stats_t *CMix_Emu_Get_IRQ_Stats(int irqn);
+void CMix_Emu_Get_Stats(CMix_Emu_Stats_t *stats);
+void CMix_Emu_Reset_Stats(void);
+
+/* ADC0 */
+void CMix_Emu_ADC_Set_Channel(uint8_t channel, uint16_t value);
+void CMix_Emu_ADC_Set_Source(CMix_Emu_ADC_Source_t source, void *context);
+uint32_t CMix_Emu_ADC_Scan_Count(void);
+uint32_t CMix_Emu_ADC_Overrun_Count(void);
+uint32_t CMix_Emu_ADC_Injected_Scan_Count(void);
+uint32_t CMix_Emu_ADC_Channel_Count(uint8_t channel);
+uint32_t CMix_Emu_ADC_Watchdog_Count(void);
+
+/* TIM1 */
+void CMix_Emu_TIM_Set_Update_Hook(CMix_Emu_TIM_Hook_t hook, void *context);
+uint16_t CMix_Emu_TIM_Get_Compare(uint8_t index);
+uint32_t CMix_Emu_TIM_Get_Period(void);
+uint32_t CMix_Emu_TIM_Counts_To_Update(void);
+uint32_t CMix_Emu_TIM_Update_Count(void);
+bool CMix_Emu_TIM_Output_Enabled(void);
+uint64_t CMix_Emu_TIM_Break_Cycle(void);
+
+/* UART0 */
+void CMix_Emu_UART_Inject(const uint8_t *data, uint16_t length);
+uint32_t CMix_Emu_UART_RX_Pending(void);
+uint64_t CMix_Emu_UART_RX_Last_Cycle(void);
+uint32_t CMix_Emu_UART_RX_Overrun_Count(void);
+void CMix_Emu_UART_Set_TX_Hook(CMix_Emu_UART_Hook_t hook, void *context);
+void CMix_Emu_UART_Set_Output(int fd);
+uint32_t CMix_Emu_UART_Byte_Cycles(void);
+
+/* CMP0/CMP1 */
+void CMix_Emu_CMP_Set_Input(uint8_t unit, uint32_t input_mv);
+
+/* GPIO (port: 0=GPIOA, 1=GPIOB) */
+uint16_t CMix_Emu_GPIO_Get_Output(uint8_t port);
+void CMix_Emu_GPIO_Set_Input(uint8_t port, uint16_t pins, bool level);
+
+/* 内部Flash (IFMC) */
+void CMix_Emu_Flash_Erase(uint32_t address, uint32_t size);
+uint32_t CMix_Emu_Flash_Read(uint32_t address);
+uint32_t CMix_Emu_Flash_Erase_Count(uint32_t address);
+void CMix_Emu_Flash_Get_Stats(CMix_Emu_Flash_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_EMU_H */
@@ -0,0 +1,106 @@
+/******************************************************************************
+  * @file    CMix_emu_cmsis.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix主机仿真编译前置头文件
+  *          替代CMSIS编译器适配层和PT32_Type.h, 由Makefile以-include强制包含
+  ******************************************************************************
+  * @attention
+  *
+  * 主机编译时固件源码、FWLib和core_cm0.h均不修改:
+  *   1. 预先定义__CMSIS_COMPILER_H, core_cm0.h不再包含ARM内联汇编版本的
+  *      cmsis_compiler.h, 内核指令 (__WFI/__enable_irq等) 改由仿真器实现
+  *   2. 预先定义PT32_Type_H, u32/s32改为32位类型. PT32_Type.h中u32为
+  *      unsigned long, 在LP64主机上是64位, 会使全部寄存器结构体偏移错误
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_EMU_CMSIS_H
+#define __CMIX_EMU_CMSIS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/* ========================= PT32_Type.h (主机宽度) ========================= */
+
+#define PT32_Type_H
+
+typedef int32_t  s32;
+typedef int16_t  s16;
+typedef int8_t   s8;
+
+typedef uint64_t u64;
+typedef uint32_t u32;
+typedef uint16_t u16;
+typedef uint8_t  u8;
+typedef uint8_t  BOOL;
+
+#ifndef NULL
+#define NULL  0
+#endif
+
+#ifndef TRUE
+#define TRUE  1
+#endif
+
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus, RemapStatus, ProtectStatus, BitAction;
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+#define IS_FUNCTIONAL_STATE(STATE)                  ((STATE) == DISABLE || (STATE) == ENABLE)
+
+/* ========================= cmsis_compiler.h (主机) ========================= */
+
+#define __CMSIS_COMPILER_H
+
+#define __ASM                       __asm
+#define __INLINE                    inline
+#define __STATIC_INLINE             static inline
+#define __STATIC_FORCEINLINE        __attribute__((always_inline)) static inline
+#define __NO_RETURN                 __attribute__((__noreturn__))
+#define __USED                      __attribute__((used))
+#define __WEAK                      __attribute__((weak))
+#define __PACKED                    __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT             struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION              union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)                __attribute__((aligned(x)))
+#define __RESTRICT                  __restrict
+#define __COMPILER_BARRIER()        __asm volatile("" ::: "memory")
+
+/* 仿真器提供的内核行为 (CMix_emu_core.c) */
+void     CMix_Emu_Core_NOP(void);
+void     CMix_Emu_Core_WFI(void);
+void     CMix_Emu_Core_Enable_IRQ(void);
+void     CMix_Emu_Core_Disable_IRQ(void);
+uint32_t CMix_Emu_Core_Get_PRIMASK(void);
+void     CMix_Emu_Core_Set_PRIMASK(uint32_t primask);
+
+#define __NOP()                     CMix_Emu_Core_NOP()
+#define __WFI()                     CMix_Emu_Core_WFI()
+#define __WFE()                     CMix_Emu_Core_WFI()
+#define __SEV()                     ((void)0)
+#define __ISB()                     __COMPILER_BARRIER()
+#define __DSB()                     __COMPILER_BARRIER()
+#define __DMB()                     __COMPILER_BARRIER()
+
+#define __enable_irq()              CMix_Emu_Core_Enable_IRQ()
+#define __disable_irq()             CMix_Emu_Core_Disable_IRQ()
+#define __get_PRIMASK()             CMix_Emu_Core_Get_PRIMASK()
+#define __set_PRIMASK(x)            CMix_Emu_Core_Set_PRIMASK(x)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_EMU_CMSIS_H */
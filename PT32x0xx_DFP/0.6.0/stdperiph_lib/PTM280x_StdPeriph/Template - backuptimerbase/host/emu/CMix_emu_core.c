@@ -0,0 +1,1398 @@
+/******************************************************************************
+  * @file    CMix_emu_core.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix主机仿真器内核
+  *          寄存器窗口陷入, 周期计数, NVIC/SysTick/SCB仿真, 中断分发
+  ******************************************************************************
+  * @attention
+  *
+  * 寄存器访问陷入流程:
+  *   1. 寄存器窗口 (APB/AHB/SCS) 以memfd映射两次: 固件地址处PROT_NONE,
+  *      另一处可读写作为影子页供仿真器使用
+  *   2. 固件访问寄存器触发SIGSEGV: 同步外设事件, 刷新读出值, 记录写前值
+  *   3. 常见的mov/movzx/movsx访问指令在处理函数中直接对影子页完成并跳过,
+  *      随后调用外设写/读后处理并分发中断
+  *   4. 其余指令临时开放该页并置位TF单步执行, 单步完成触发SIGTRAP时
+  *      恢复页保护, 再完成第3步的后处理
+  *
+  * 内部Flash (主机上低地址通常不允许映射) 不建立映射, 其内容保存在共享
+  * 匿名映射中 (fork出的子进程之间共享, 相当于掉电保持). 固件经IFMC_ReadWord
+  * 等直接读取Flash时同样触发SIGSEGV, 按解码结果从Flash内容读出; 直接写入
+  * 和无法解码的访问视为非法访问. 编程和擦除由IFMC模型完成.
+  *
+  * 中断处理函数在信号处理上下文中调用, 在固件栈上运行, 与硬件上中断
+  * 抢占线程代码的效果一致. 固件与运行程序各自运行在独立上下文中,
+  * 栈位于低4GB, 固件中以u32保存的栈地址 (DMA源地址等) 可直接使用.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "CMix_emu_internal.h"
+#include "PT32x0xx.h"
+#include "PT32x0xx_config.h"
+
+#include <dlfcn.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+/* ========================= 私有常量定义 ========================= */
+
+#define CMIX_EMU_PAGE_SIZE          4096U
+#define CMIX_EMU_STACK_SIZE         (1024U * 1024U)
+#define CMIX_EMU_WINDOW_COUNT       3
+#define CMIX_EMU_REGION_MAX         32
+#define CMIX_EMU_IRQ_ENTRY_CYCLES   16          // Cortex-M0异常进入周期
+#define CMIX_EMU_THREAD_PRIORITY    4           // 线程模式优先级 (低于全部中断)
+#define CMIX_EMU_WATCH_PERIOD_MS    100         // 停滞检测周期
+#define CMIX_EMU_EFLAGS_TF          0x100       // x86单步标志
+#define CMIX_EMU_PF_WRITE           0x2         // 缺页错误码写访问位
+#define CMIX_EMU_FLASH_GUARD        0x1000U     // Flash前4KB不可直接读 (保留空指针访问检测)
+
+#define CMIX_EMU_SLOT_COUNT         (CMIX_EMU_IRQ_COUNT + 1)    // SysTick + 外部中断
+#define CMIX_EMU_SLOT(irqn)         ((irqn) + 1)
+
+/* ========================= 私有数据结构 ========================= */
+
+/* 寄存器窗口 */
+typedef struct {
+    uint32_t base;                          // 固件地址
+    uint32_t size;                          // 窗口大小
+    uint8_t *shadow;                        // 影子映射
+} CMix_Emu_Window_t;
+
+/* 直接执行的访问指令 */
+typedef struct {
+    uint8_t length;                         // 指令长度
+    uint8_t width;                          // 访问宽度 (字节)
+    uint8_t write;
+    uint8_t sign_extend;
+    uint8_t immediate;                      // 写入值来自立即数
+    uint8_t reg;                            // 寄存器编号 (0-15)
+    uint8_t reg_width;                      // 目的寄存器宽度 (读访问)
+    uint32_t value;                         // 立即数
+} CMix_Emu_Insn_t;
+
+/* 进行中的寄存器访问 (SIGSEGV到SIGTRAP之间) */
+typedef struct {
+    uint8_t active;
+    uint8_t write;
+    uint32_t address;
+    uint32_t old_value;
+    const CMix_Emu_Region_t *region;
+} CMix_Emu_Access_t;
+
+/* SysTick状态 */
+typedef struct {
+    uint64_t epoch;                         // 计数器从LOAD开始计数的时刻
+    uint64_t next_wrap;                     // 下一次计到0的时刻
+} CMix_Emu_SysTick_t;
+
+/* 内核状态 */
+typedef struct {
+    uint64_t cycle;                         // 当前仿真周期
+    uint64_t next_event;                    // 最近的外设/SysTick事件
+    uint64_t stop_cycle;                    // 本次运行的停止时刻
+    CMix_Emu_Stop_t stop;                   // 最近一次停止原因
+    uint8_t finished;                       // 固件已终止 (不可继续运行)
+    uint8_t started;
+    uint8_t in_firmware;                    // 当前在固件上下文中执行
+    uint8_t primask;
+    uint8_t active_priority;                // 当前执行优先级
+    uint8_t reset_request;
+    uint32_t nvic_enabled;
+    uint32_t nvic_pending;                  // 软件挂起 (ISPR)
+    uint32_t irq_active;                    // 正在处理的外部中断
+    uint8_t systick_pending;
+    uint8_t stamp_valid[CMIX_EMU_SLOT_COUNT];
+    uint64_t stamp[CMIX_EMU_SLOT_COUNT];    // 中断请求时刻
+    char reason[256];
+} CMix_Emu_Core_t;
+
+/* ========================= 私有变量 ========================= */
+
+static CMix_Emu_Window_t g_windows[CMIX_EMU_WINDOW_COUNT] = {
+    {APB_BASE, 0x40000, NULL},
+    {AHB_BASE, 0x6000, NULL},
+    {SCS_BASE, 0x1000, NULL}
+};
+
+static uint8_t *g_flash = NULL;             // Flash内容 (共享映射)
+
+static CMix_Emu_Region_t g_regions[CMIX_EMU_REGION_MAX];
+static uint32_t g_region_count = 0;
+
+static CMix_Emu_Core_t g_core;
+static CMix_Emu_Access_t g_access;
+static CMix_Emu_SysTick_t g_systick;
+static CMix_Emu_Stats_t g_stats;
+static CMix_Emu_IRQ_Stats_t g_irq_stats[CMIX_EMU_SLOT_COUNT];
+
+/* 上下文 */
+static ucontext_t g_main_context;
+static ucontext_t g_runner_context;
+static ucontext_t g_firmware_context;
+static void (*g_firmware_entry)(void) = NULL;
+static int (*g_runner)(int argc, char **argv) = NULL;
+static int g_runner_argc;
+static char **g_runner_argv;
+static int g_runner_result;
+
+/* 停滞检测 */
+static volatile uint64_t g_watch_cycle;
+static volatile uint32_t g_watch_ticks;
+
+/* ========================= 中断向量 ========================= */
+
+/* 启动文件中的处理函数名, 固件未实现的保持为空 */
+extern void SysTick_Handler(void) __attribute__((weak));
+extern void PVD_Handler(void) __attribute__((weak));
+extern void IFMC_Handler(void) __attribute__((weak));
+extern void DMA_Handler(void) __attribute__((weak));
+extern void EXTIA_Handler(void) __attribute__((weak));
+extern void EXTIB_Handler(void) __attribute__((weak));
+extern void CMP1_Handler(void) __attribute__((weak));
+extern void ADC0_Handler(void) __attribute__((weak));
+extern void TIM1_Handler(void) __attribute__((weak));
+extern void TIM4_Handler(void) __attribute__((weak));
+extern void TIM3_Handler(void) __attribute__((weak));
+extern void TIM2_Handler(void) __attribute__((weak));
+extern void ALU_Handler(void) __attribute__((weak));
+extern void CMP0_Handler(void) __attribute__((weak));
+extern void TIM8_Handler(void) __attribute__((weak));
+extern void I2C0_Handler(void) __attribute__((weak));
+extern void SPI0_Handler(void) __attribute__((weak));
+extern void UART0_Handler(void) __attribute__((weak));
+
+static void (*const g_vectors[CMIX_EMU_IRQ_COUNT])(void) = {
+    [PVD_IRQn]   = PVD_Handler,
+    [IFMC_IRQn]  = IFMC_Handler,
+    [DMA_IRQn]   = DMA_Handler,
+    [EXTIA_IRQn] = EXTIA_Handler,
+    [EXTIB_IRQn] = EXTIB_Handler,
+    [CMP1_IRQn]  = CMP1_Handler,
+    [ADC0_IRQn]  = ADC0_Handler,
+    [TIM1_IRQn]  = TIM1_Handler,
+    [TIM4_IRQn]  = TIM4_Handler,
+    [TIM3_IRQn]  = TIM3_Handler,
+    [TIM2_IRQn]  = TIM2_Handler,
+    [ALU_IRQn]   = ALU_Handler,
+    [CMP0_IRQn]  = CMP0_Handler,
+    [TIM8_IRQn]  = TIM8_Handler,
+    [I2C0_IRQn]  = I2C0_Handler,
+    [SPI0_IRQn]  = SPI0_Handler,
+    [UART0_IRQn] = UART0_Handler
+};
+
+/* ========================= 私有函数声明 ========================= */
+
+static uint64_t CMix_Emu_Host_ns(void);
+static CMix_Emu_Window_t *CMix_Emu_Find_Window(uintptr_t address);
+static const CMix_Emu_Region_t *CMix_Emu_Find_Region(uint32_t address);
+static void CMix_Emu_Protect_All(void);
+static void CMix_Emu_Describe(char *buffer, size_t size, const char *what, uintptr_t pc, uintptr_t address);
+static void CMix_Emu_Finish(CMix_Emu_Stop_t stop);
+static void CMix_Emu_Yield(void);
+static void CMix_Emu_Sync(void);
+static void CMix_Emu_Checkpoint(void);
+static void CMix_Emu_Dispatch(void);
+static int CMix_Emu_Highest_Pending(void);
+static uint8_t CMix_Emu_Slot_Priority(int slot);
+static bool CMix_Emu_Slot_Asserted(int slot);
+static void CMix_Emu_Enter(int slot);
+static bool CMix_Emu_Decode(const uint8_t *code, CMix_Emu_Insn_t *insn);
+static void CMix_Emu_Execute(ucontext_t *uc, const CMix_Emu_Insn_t *insn, volatile uint8_t *shadow);
+static bool CMix_Emu_Flash_Access(ucontext_t *uc, uintptr_t address);
+static void CMix_Emu_Complete(void);
+static void CMix_Emu_Segv_Handler(int sig, siginfo_t *info, void *context);
+static void CMix_Emu_Trap_Handler(int sig, siginfo_t *info, void *context);
+static void CMix_Emu_Alarm_Handler(int sig, siginfo_t *info, void *context);
+static void CMix_Emu_Firmware_Trampoline(void);
+static void CMix_Emu_Runner_Trampoline(void);
+static void *CMix_Emu_Alloc_Stack(void);
+
+/* SCS寄存器模型 */
+static void CMix_Emu_SysTick_Read(uint32_t offset);
+static void CMix_Emu_SysTick_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_SysTick_After_Read(uint32_t offset);
+static void CMix_Emu_SysTick_Schedule(void);
+static void CMix_Emu_NVIC_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_SCB_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+
+static const CMix_Emu_Region_t g_scs_regions[] = {
+    {SysTick_BASE, sizeof(SysTick_Type), CMix_Emu_SysTick_Read, CMix_Emu_SysTick_Write, CMix_Emu_SysTick_After_Read},
+    {NVIC_BASE, sizeof(NVIC_Type), NULL, CMix_Emu_NVIC_Write, NULL},
+    {SCB_BASE, sizeof(SCB_Type), NULL, CMix_Emu_SCB_Write, NULL}
+};
+
+/* ========================= 仿真器控制 ========================= */
+
+/**
+ * @brief 在低地址栈上运行主机运行程序
+ * @param runner: 运行程序入口
+ * @param argc: 参数个数
+ * @param argv: 参数表
+ * @retval 运行程序返回值
+ * @note  运行程序也可直接调用固件函数, 其栈同样需位于低4GB
+ */
+int CMix_Emu_Main(int (*runner)(int argc, char **argv), int argc, char **argv)
+{
+    g_runner = runner;
+    g_runner_argc = argc;
+    g_runner_argv = argv;
+
+    getcontext(&g_runner_context);
+    g_runner_context.uc_stack.ss_sp = CMix_Emu_Alloc_Stack();
+    g_runner_context.uc_stack.ss_size = CMIX_EMU_STACK_SIZE;
+    g_runner_context.uc_link = &g_main_context;
+    makecontext(&g_runner_context, CMix_Emu_Runner_Trampoline, 0);
+    swapcontext(&g_main_context, &g_runner_context);
+
+    return g_runner_result;
+}
+
+/**
+ * @brief 仿真器初始化: 映射寄存器窗口, 安装信号处理, 复位全部模型
+ * @param None
+ * @retval None
+ */
+void CMix_Emu_Init(void)
+{
+    static uint8_t mapped = 0;
+    const CMix_Emu_Region_t *periph;
+    struct sigaction action;
+    uint32_t count, i;
+
+    if (!mapped) {
+        for (i = 0; i < CMIX_EMU_WINDOW_COUNT; i++) {
+            CMix_Emu_Window_t *window = &g_windows[i];
+            int fd = memfd_create("cmix_emu_window", MFD_CLOEXEC);
+            void *target;
+
+            if (fd < 0 || ftruncate(fd, window->size) != 0) {
+                perror("cmix_emu: memfd");
+                exit(2);
+            }
+            target = mmap((void *)(uintptr_t)window->base, window->size, PROT_NONE,
+                          MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+            if (target != (void *)(uintptr_t)window->base) {
+                fprintf(stderr, "cmix_emu: cannot map register window 0x%08X\n", (unsigned)window->base);
+                exit(2);
+            }
+            window->shadow = mmap(NULL, window->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (window->shadow == MAP_FAILED) {
+                perror("cmix_emu: shadow");
+                exit(2);
+            }
+            close(fd);
+        }
+
+        /* Flash内容在本进程内跨CMix_Emu_Init保持, 初始为已擦除 */
+        g_flash = mmap(NULL, CMIX_EMU_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (g_flash == MAP_FAILED) {
+            perror("cmix_emu: flash");
+            exit(2);
+        }
+        memset(g_flash, 0xFF, CMIX_EMU_FLASH_SIZE);
+        mapped = 1;
+    }
+
+    /* 信号处理: 中断处理函数内的寄存器访问需要嵌套陷入 */
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    action.sa_sigaction = CMix_Emu_Segv_Handler;
+    sigaction(SIGSEGV, &action, NULL);
+    action.sa_sigaction = CMix_Emu_Trap_Handler;
+    sigaction(SIGTRAP, &action, NULL);
+    action.sa_flags = SA_SIGINFO;
+    action.sa_sigaction = CMix_Emu_Alarm_Handler;
+    sigaction(SIGALRM, &action, NULL);
+
+    /* 复位状态 */
+    for (i = 0; i < CMIX_EMU_WINDOW_COUNT; i++) {
+        memset(g_windows[i].shadow, 0, g_windows[i].size);
+    }
+    memset(&g_core, 0, sizeof(g_core));
+    memset(&g_access, 0, sizeof(g_access));
+    g_core.active_priority = CMIX_EMU_THREAD_PRIORITY;
+    g_core.stop_cycle = 0;
+    g_systick.epoch = 0;
+    g_systick.next_wrap = CMIX_EMU_NEVER;
+    CMix_Emu_Reset_Stats();
+
+    /* 地址区域表 */
+    g_region_count = 0;
+    for (i = 0; i < sizeof(g_scs_regions) / sizeof(g_scs_regions[0]); i++) {
+        g_regions[g_region_count++] = g_scs_regions[i];
+    }
+    periph = CMix_Emu_Periph_Regions(&count);
+    for (i = 0; i < count && g_region_count < CMIX_EMU_REGION_MAX; i++) {
+        g_regions[g_region_count++] = periph[i];
+    }
+
+    CMix_Emu_Periph_Reset();
+    CMix_Emu_Schedule_Changed();
+}
+
+/**
+ * @brief 准备固件上下文 (首次运行时从entry开始执行)
+ * @param entry: 固件入口 (相当于Reset_Handler)
+ * @retval None
+ */
+void CMix_Emu_Start(void (*entry)(void))
+{
+    g_firmware_entry = entry;
+
+    getcontext(&g_firmware_context);
+    g_firmware_context.uc_stack.ss_sp = CMix_Emu_Alloc_Stack();
+    g_firmware_context.uc_stack.ss_size = CMIX_EMU_STACK_SIZE;
+    g_firmware_context.uc_link = NULL;
+    makecontext(&g_firmware_context, CMix_Emu_Firmware_Trampoline, 0);
+    g_core.started = 1;
+}
+
+/**
+ * @brief 运行固件直到指定周期
+ * @param cycle: 停止时刻 (绝对周期)
+ * @retval 停止原因
+ */
+CMix_Emu_Stop_t CMix_Emu_Run_Until(uint64_t cycle)
+{
+    struct itimerval timer;
+    uint64_t start_ns;
+
+    if (!g_core.started || g_core.finished) {
+        return g_core.finished ? g_core.stop : CMIX_EMU_STOP_EXIT;
+    }
+    if (cycle <= g_core.cycle) {
+        return CMIX_EMU_STOP_TIME;
+    }
+
+    g_core.stop_cycle = cycle;
+    g_watch_cycle = g_core.cycle;
+    g_watch_ticks = 0;
+
+    memset(&timer, 0, sizeof(timer));
+    timer.it_interval.tv_usec = CMIX_EMU_WATCH_PERIOD_MS * 1000;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    start_ns = CMix_Emu_Host_ns();
+    swapcontext(&g_runner_context, &g_firmware_context);
+    g_stats.host_ns += CMix_Emu_Host_ns() - start_ns;
+
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    return g_core.stop;
+}
+
+/**
+ * @brief 运行固件指定时长
+ * @param us: 时长 (us)
+ * @retval 停止原因
+ */
+CMix_Emu_Stop_t CMix_Emu_Run_For_us(uint64_t us)
+{
+    return CMix_Emu_Run_Until(g_core.cycle + CMix_Emu_us_To_Cycles(us));
+}
+
+/**
+ * @brief 获取停止原因描述 (复位/停滞/故障时的位置)
+ * @param None
+ * @retval 描述字符串
+ */
+const char *CMix_Emu_Stop_Reason(void)
+{
+    return g_core.reason;
+}
+
+/* ========================= 时间和统计 ========================= */
+
+uint64_t CMix_Emu_Cycle(void)
+{
+    return g_core.cycle;
+}
+
+/**
+ * @brief 获取HCLK频率 (按影子RCC->CFGR计算, 与GetClockFreq一致)
+ * @param None
+ * @retval HCLK频率 (Hz)
+ */
+uint32_t CMix_Emu_Core_Clock(void)
+{
+    uint32_t cfgr = CMIX_EMU_REG(RCC_BASE, RCC_TypeDef, CFGR);
+
+    return (uint32_t)(HSI_VALUE / (((cfgr & RCC_CFGR_HPRE) >> 16) + 1));
+}
+
+/**
+ * @brief 获取PCLK频率
+ * @param None
+ * @retval PCLK频率 (Hz)
+ */
+uint32_t CMix_Emu_Periph_Clock(void)
+{
+    uint32_t cfgr = CMIX_EMU_REG(RCC_BASE, RCC_TypeDef, CFGR);
+
+    return CMix_Emu_Core_Clock() / (((cfgr & RCC_CFGR_PPRE) >> 24) + 1);
+}
+
+uint64_t CMix_Emu_us_To_Cycles(uint64_t us)
+{
+    return us * (CMix_Emu_Core_Clock() / 1000000U);
+}
+
+double CMix_Emu_Cycles_To_us(uint64_t cycles)
+{
+    return (double)cycles * 1e6 / CMix_Emu_Core_Clock();
+}
+
+/**
+ * @brief 获取中断统计
+ * @param irqn: 中断号 (CMIX_EMU_IRQ_SYSTICK或0..31)
+ * @retval 统计结构体指针, 中断号无效时返回NULL
+ */
+const CMix_Emu_IRQ_Stats_t *CMix_Emu_Get_IRQ_Stats(int irqn)
+{
+    if (irqn < CMIX_EMU_IRQ_SYSTICK || irqn >= CMIX_EMU_IRQ_COUNT) {
+        return NULL;
+    }
+    return &g_irq_stats[CMIX_EMU_SLOT(irqn)];
+}
+
+void CMix_Emu_Get_Stats(CMix_Emu_Stats_t *stats)
+{
+    *stats = g_stats;
+}
+
+void CMix_Emu_Reset_Stats(void)
+{
+    memset(&g_stats, 0, sizeof(g_stats));
+    memset(g_irq_stats, 0, sizeof(g_irq_stats));
+}
+
+/* ========================= 内部接口 ========================= */
+
+/**
+ * @brief 获取寄存器影子地址
+ * @param address: 固件寄存器地址
+ * @retval 影子地址, 不在寄存器窗口内时程序退出
+ */
+volatile uint32_t *CMix_Emu_Reg(uint32_t address)
+{
+    CMix_Emu_Window_t *window = CMix_Emu_Find_Window(address);
+
+    if (window == NULL) {
+        fprintf(stderr, "cmix_emu: 0x%08X is not a register address\n", (unsigned)address);
+        abort();
+    }
+    return (volatile uint32_t *)(window->shadow + ((address - window->base) & ~3U));
+}
+
+bool CMix_Emu_Is_Register(uint32_t address)
+{
+    return CMix_Emu_Find_Window(address) != NULL;
+}
+
+/**
+ * @brief 获取Flash内容地址
+ * @param address: Flash地址
+ * @retval 内容地址, 超出Flash或仿真器未初始化时返回NULL
+ */
+uint8_t *CMix_Emu_Flash(uint32_t address)
+{
+    if (g_flash == NULL || address - FLASH_BASE >= CMIX_EMU_FLASH_SIZE) {
+        return NULL;
+    }
+    return g_flash + (address - FLASH_BASE);
+}
+
+/**
+ * @brief 总线停顿: CPU在外设操作完成前不能继续执行 (如Flash编程/擦除期间取指停顿)
+ * @param cycles: 停顿周期数
+ * @retval None
+ * @note  在外设写处理中调用, 停顿期间到期的事件和中断在本次访问完成后按时间顺序处理
+ */
+void CMix_Emu_Bus_Stall(uint32_t cycles)
+{
+    g_core.cycle += cycles;
+}
+
+/**
+ * @brief 总线读 (DMA等主设备访问寄存器, 带读副作用)
+ * @param address: 寄存器地址
+ * @retval 读出值
+ */
+uint32_t CMix_Emu_Bus_Read(uint32_t address)
+{
+    const CMix_Emu_Region_t *region = CMix_Emu_Find_Region(address);
+    uint32_t value;
+
+    if (region != NULL && region->read != NULL) {
+        region->read((address & ~3U) - region->base);
+    }
+    value = *CMix_Emu_Reg(address);
+    if (region != NULL && region->after_read != NULL) {
+        region->after_read((address & ~3U) - region->base);
+    }
+    return value;
+}
+
+/**
+ * @brief 总线写 (DMA等主设备访问寄存器, 带写副作用)
+ * @param address: 寄存器地址
+ * @param value: 写入值
+ * @retval None
+ */
+void CMix_Emu_Bus_Write(uint32_t address, uint32_t value)
+{
+    const CMix_Emu_Region_t *region = CMix_Emu_Find_Region(address);
+    volatile uint32_t *reg = CMix_Emu_Reg(address);
+    uint32_t old_value = *reg;
+
+    *reg = value;
+    if (region != NULL && region->write != NULL) {
+        region->write((address & ~3U) - region->base, old_value, value);
+    }
+}
+
+/**
+ * @brief 记录中断请求时刻 (外设置位中断标志时调用, 用于响应延迟统计)
+ * @param irqn: 中断号
+ * @param cycle: 标志置位时刻
+ * @retval None
+ */
+void CMix_Emu_IRQ_Touch(int irqn, uint64_t cycle)
+{
+    int slot = CMIX_EMU_SLOT(irqn);
+
+    if (!g_core.stamp_valid[slot] && CMix_Emu_Slot_Asserted(slot)) {
+        g_core.stamp[slot] = cycle;
+        g_core.stamp_valid[slot] = 1;
+    }
+}
+
+/**
+ * @brief 外设事件时刻变化后重新计算最近事件
+ * @param None
+ * @retval None
+ */
+void CMix_Emu_Schedule_Changed(void)
+{
+    uint64_t next = CMix_Emu_Periph_Next_Event();
+
+    g_core.next_event = (g_systick.next_wrap < next) ? g_systick.next_wrap : next;
+}
+
+/* ========================= 内核指令 ========================= */
+
+void CMix_Emu_Core_NOP(void)
+{
+    g_core.cycle++;
+    g_stats.nop_count++;
+    if (g_core.cycle >= g_core.next_event || g_core.cycle >= g_core.stop_cycle) {
+        CMix_Emu_Checkpoint();
+    }
+}
+
+/**
+ * @brief __WFI: 休眠到有中断挂起 (不受PRIMASK屏蔽, 与硬件一致)
+ * @param None
+ * @retval None
+ */
+void CMix_Emu_Core_WFI(void)
+{
+    g_stats.wfi_count++;
+
+    for (;;) {
+        uint64_t target;
+
+        CMix_Emu_Sync();
+        if (CMix_Emu_Highest_Pending() >= 0) {
+            break;
+        }
+        if (g_core.cycle >= g_core.stop_cycle) {
+            CMix_Emu_Yield();
+            continue;
+        }
+
+        target = (g_core.next_event < g_core.stop_cycle) ? g_core.next_event : g_core.stop_cycle;
+        g_stats.sleep_cycles += target - g_core.cycle;
+        g_core.cycle = target;
+    }
+
+    g_core.cycle++;
+    CMix_Emu_Checkpoint();
+}
+
+void CMix_Emu_Core_Enable_IRQ(void)
+{
+    g_core.primask = 0;
+    CMix_Emu_Checkpoint();
+}
+
+void CMix_Emu_Core_Disable_IRQ(void)
+{
+    g_core.primask = 1;
+}
+
+uint32_t CMix_Emu_Core_Get_PRIMASK(void)
+{
+    return g_core.primask;
+}
+
+void CMix_Emu_Core_Set_PRIMASK(uint32_t primask)
+{
+    g_core.primask = (uint8_t)(primask & 1U);
+    if (!g_core.primask) {
+        CMix_Emu_Checkpoint();
+    }
+}
+
+/* ========================= 时间推进和中断分发 ========================= */
+
+static uint64_t CMix_Emu_Host_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief 按时间顺序处理到当前周期为止的全部事件
+ * @param None
+ * @retval None
+ */
+static void CMix_Emu_Sync(void)
+{
+    while (g_core.next_event <= g_core.cycle) {
+        uint64_t t = g_core.next_event;
+
+        if (g_systick.next_wrap <= t) {
+            SysTick_Type *shadow = (SysTick_Type *)CMix_Emu_Reg(SysTick_BASE);
+            uint32_t period = (shadow->LOAD & SysTick_LOAD_RELOAD_Msk) + 1U;
+
+            *CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, CTRL)) |= SysTick_CTRL_COUNTFLAG_Msk;
+            if (shadow->CTRL & SysTick_CTRL_TICKINT_Msk) {
+                g_core.systick_pending = 1;
+                if (!g_core.stamp_valid[0]) {
+                    g_core.stamp[0] = t;
+                    g_core.stamp_valid[0] = 1;
+                }
+            }
+            g_systick.next_wrap = t + period;
+        }
+
+        CMix_Emu_Periph_Process(t);
+        CMix_Emu_Schedule_Changed();
+    }
+}
+
+/**
+ * @brief 检查点: 同步事件, 分发中断, 到达停止时刻时切回运行程序
+ * @param None
+ * @retval None
+ */
+static void CMix_Emu_Checkpoint(void)
+{
+    CMix_Emu_Sync();
+    if (!g_core.in_firmware) {
+        return;
+    }
+
+    CMix_Emu_Dispatch();
+
+    if (g_core.reset_request) {
+        g_core.reset_request = 0;
+        snprintf(g_core.reason, sizeof(g_core.reason), "system reset requested at cycle %llu",
+                 (unsigned long long)g_core.cycle);
+        CMix_Emu_Finish(CMIX_EMU_STOP_RESET);
+    }
+    if (g_core.cycle >= g_core.stop_cycle) {
+        CMix_Emu_Yield();
+        CMix_Emu_Dispatch();
+    }
+}
+
+static uint8_t CMix_Emu_Slot_Priority(int slot)
+{
+    if (slot == 0) {
+        uint32_t shp = *CMix_Emu_Reg(SCB_BASE + offsetof(SCB_Type, SHP) + 4U);
+        return (uint8_t)(shp >> 30);
+    } else {
+        int irqn = slot - 1;
+        uint32_t ip = *CMix_Emu_Reg(NVIC_BASE + offsetof(NVIC_Type, IP) + 4U * (uint32_t)(irqn >> 2));
+        return (uint8_t)((ip >> ((irqn & 3) * 8 + 6)) & 3U);
+    }
+}
+
+static bool CMix_Emu_Slot_Asserted(int slot)
+{
+    int irqn = slot - 1;
+
+    if (slot == 0) {
+        return g_core.systick_pending != 0;
+    }
+    if (!(g_core.nvic_enabled & (1UL << irqn))) {
+        return false;
+    }
+    return (g_core.nvic_pending & (1UL << irqn)) || CMix_Emu_Periph_IRQ_Level(irqn);
+}
+
+/**
+ * @brief 查找可抢占当前执行优先级的最高优先级中断
+ * @param None
+ * @retval 中断槽 (0=SysTick, irqn+1=外部中断), 无则返回-1
+ * @note  同优先级时异常号小者优先, SysTick (15) 先于全部外部中断
+ */
+static int CMix_Emu_Highest_Pending(void)
+{
+    uint8_t best_priority = g_core.active_priority;
+    uint32_t candidates = g_core.nvic_enabled & ~g_core.irq_active;
+    int best = -1;
+
+    if (g_core.systick_pending) {
+        uint8_t priority = CMix_Emu_Slot_Priority(0);
+        if (priority < best_priority) {
+            best = 0;
+            best_priority = priority;
+        }
+    }
+
+    while (candidates != 0) {
+        int irqn = __builtin_ctz(candidates);
+        int slot = CMIX_EMU_SLOT(irqn);
+
+        candidates &= candidates - 1U;
+        if (!CMix_Emu_Slot_Asserted(slot)) {
+            continue;
+        }
+        if (!g_core.stamp_valid[slot]) {
+            g_core.stamp[slot] = g_core.cycle;
+            g_core.stamp_valid[slot] = 1;
+        }
+        if (CMix_Emu_Slot_Priority(slot) < best_priority) {
+            best = slot;
+            best_priority = CMix_Emu_Slot_Priority(slot);
+        }
+    }
+
+    return best;
+}
+
+static void CMix_Emu_Dispatch(void)
+{
+    while (g_core.in_firmware && !g_core.primask && !g_core.finished) {
+        int slot = CMix_Emu_Highest_Pending();
+
+        if (slot < 0) {
+            break;
+        }
+        CMix_Emu_Enter(slot);
+    }
+}
+
+/**
+ * @brief 进入中断处理函数 (在当前固件栈上调用)
+ * @param slot: 中断槽
+ * @retval None
+ */
+static void CMix_Emu_Enter(int slot)
+{
+    CMix_Emu_IRQ_Stats_t *stats = &g_irq_stats[slot];
+    void (*handler)(void) = (slot == 0) ? SysTick_Handler : g_vectors[slot - 1];
+    uint8_t saved_priority = g_core.active_priority;
+    uint64_t start_cycle, start_ns;
+
+    if (handler == NULL) {
+        snprintf(g_core.reason, sizeof(g_core.reason), "IRQ %d enabled and pending but has no handler",
+                 slot - 1);
+        CMix_Emu_Finish(CMIX_EMU_STOP_FAULT);
+        return;
+    }
+
+    /* 清除挂起, 记录响应延迟 */
+    if (slot == 0) {
+        g_core.systick_pending = 0;
+    } else {
+        g_core.nvic_pending &= ~(1UL << (slot - 1));
+        g_core.irq_active |= 1UL << (slot - 1);
+    }
+    g_core.cycle += CMIX_EMU_IRQ_ENTRY_CYCLES;
+    if (g_core.stamp_valid[slot]) {
+        uint64_t latency = g_core.cycle - g_core.stamp[slot];
+        stats->latency_sum += latency;
+        if (latency > stats->latency_max) {
+            stats->latency_max = (uint32_t)latency;
+        }
+        g_core.stamp_valid[slot] = 0;
+    }
+    stats->entries++;
+
+    g_core.active_priority = CMix_Emu_Slot_Priority(slot);
+    start_cycle = g_core.cycle;
+    start_ns = CMix_Emu_Host_ns();
+
+    handler();
+
+    stats->host_ns += CMix_Emu_Host_ns() - start_ns;
+    stats->busy_cycles += g_core.cycle - start_cycle;
+    g_core.active_priority = saved_priority;
+    if (slot != 0) {
+        g_core.irq_active &= ~(1UL << (slot - 1));
+    }
+
+    /* 退出时请求仍有效则从此刻重新计时 */
+    if (!CMix_Emu_Slot_Asserted(slot)) {
+        g_core.stamp_valid[slot] = 0;
+    } else if (!g_core.stamp_valid[slot]) {
+        g_core.stamp[slot] = g_core.cycle;
+        g_core.stamp_valid[slot] = 1;
+    }
+}
+
+/* ========================= 上下文切换 ========================= */
+
+static void *CMix_Emu_Alloc_Stack(void)
+{
+    void *stack = mmap(NULL, CMIX_EMU_STACK_SIZE, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT | MAP_STACK, -1, 0);
+
+    if (stack == MAP_FAILED) {
+        perror("cmix_emu: stack");
+        exit(2);
+    }
+    return stack;
+}
+
+static void CMix_Emu_Runner_Trampoline(void)
+{
+    g_runner_result = g_runner(g_runner_argc, g_runner_argv);
+}
+
+static void CMix_Emu_Firmware_Trampoline(void)
+{
+    g_core.in_firmware = 1;
+    g_firmware_entry();
+
+    snprintf(g_core.reason, sizeof(g_core.reason), "firmware entry returned at cycle %llu",
+             (unsigned long long)g_core.cycle);
+    CMix_Emu_Finish(CMIX_EMU_STOP_EXIT);
+}
+
+/**
+ * @brief 从固件上下文切回运行程序
+ * @param None
+ * @retval None
+ */
+static void CMix_Emu_Yield(void)
+{
+    if (!g_core.finished) {
+        g_core.stop = CMIX_EMU_STOP_TIME;
+    }
+    g_core.in_firmware = 0;
+    swapcontext(&g_firmware_context, &g_runner_context);
+    g_core.in_firmware = 1;
+}
+
+/**
+ * @brief 终止固件运行 (复位/停滞/故障/返回), 之后不再切回固件
+ * @param stop: 停止原因
+ * @retval None
+ */
+static void CMix_Emu_Finish(CMix_Emu_Stop_t stop)
+{
+    g_core.stop = stop;
+    g_core.finished = 1;
+    for (;;) {
+        CMix_Emu_Yield();
+    }
+}
+
+/* ========================= 寄存器陷入 ========================= */
+
+static CMix_Emu_Window_t *CMix_Emu_Find_Window(uintptr_t address)
+{
+    uint32_t i;
+
+    for (i = 0; i < CMIX_EMU_WINDOW_COUNT; i++) {
+        if (address >= g_windows[i].base && address - g_windows[i].base < g_windows[i].size) {
+            return &g_windows[i];
+        }
+    }
+    return NULL;
+}
+
+static const CMix_Emu_Region_t *CMix_Emu_Find_Region(uint32_t address)
+{
+    static const CMix_Emu_Region_t *last = NULL;
+    uint32_t i;
+
+    if (last != NULL && address - last->base < last->size) {
+        return last;
+    }
+    for (i = 0; i < g_region_count; i++) {
+        if (address - g_regions[i].base < g_regions[i].size) {
+            last = &g_regions[i];
+            return last;
+        }
+    }
+    return NULL;
+}
+
+static void CMix_Emu_Protect_All(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < CMIX_EMU_WINDOW_COUNT; i++) {
+        mprotect((void *)(uintptr_t)g_windows[i].base, g_windows[i].size, PROT_NONE);
+    }
+    g_access.active = 0;
+}
+
+static void CMix_Emu_Describe(char *buffer, size_t size, const char *what, uintptr_t pc, uintptr_t address)
+{
+    Dl_info info;
+
+    if (dladdr((void *)pc, &info) && info.dli_sname != NULL) {
+        snprintf(buffer, size, "%s at %s+0x%lx (address 0x%lx, cycle %llu)", what, info.dli_sname,
+                 (unsigned long)(pc - (uintptr_t)info.dli_saddr), (unsigned long)address,
+                 (unsigned long long)g_core.cycle);
+    } else {
+        snprintf(buffer, size, "%s at pc 0x%lx (address 0x%lx, cycle %llu)", what, (unsigned long)pc,
+                 (unsigned long)address, (unsigned long long)g_core.cycle);
+    }
+}
+
+/**
+ * @brief 解码寄存器访问指令 (mov/movzx/movsx的内存操作数形式)
+ * @param code: 指令地址
+ * @param insn: 解码结果
+ * @retval true = 可直接执行, false = 需单步执行
+ */
+static bool CMix_Emu_Decode(const uint8_t *code, CMix_Emu_Insn_t *insn)
+{
+    const uint8_t *p = code;
+    uint8_t opsize16 = 0, rex = 0, opcode, modrm, mod, rm;
+    uint8_t imm_size = 0;
+
+    memset(insn, 0, sizeof(*insn));
+
+    /* 前缀 */
+    for (;;) {
+        if (*p == 0x66) {
+            opsize16 = 1;
+        } else if (*p == 0x2E || *p == 0x3E) {
+            /* 段前缀在64位模式下无效果 */
+        } else if (*p == 0x67) {
+            /* 地址长度前缀 (u32地址转换为指针): 有效地址已由si_addr给出 */
+        } else {
+            break;
+        }
+        p++;
+    }
+    if ((*p & 0xF0) == 0x40) {
+        rex = *p++;
+    }
+    if (rex & 0x08) {
+        return false;                       // 64位访问 (REX.W)
+    }
+
+    opcode = *p++;
+    insn->width = opsize16 ? 2 : 4;
+    insn->reg_width = insn->width;
+    switch (opcode) {
+        case 0x8B: break;                                                           // mov r, m
+        case 0x89: insn->write = 1; break;                                          // mov m, r
+        case 0x8A: insn->width = 1; insn->reg_width = 1; break;                     // mov r8, m8
+        case 0x88: insn->write = 1; insn->width = 1; insn->reg_width = 1; break;    // mov m8, r8
+        case 0xC7: insn->write = 1; insn->immediate = 1; imm_size = insn->width; break;
+        case 0xC6: insn->write = 1; insn->immediate = 1; insn->width = 1; imm_size = 1; break;
+        case 0x0F:
+            opcode = *p++;
+            if (opcode == 0xB6 || opcode == 0xBE) {
+                insn->width = 1;
+            } else if (opcode == 0xB7 || opcode == 0xBF) {
+                insn->width = 2;
+            } else {
+                return false;
+            }
+            insn->sign_extend = (opcode == 0xBE || opcode == 0xBF);
+            break;
+        default:
+            return false;
+    }
+
+    /* ModRM/SIB/位移: 有效地址已由si_addr给出, 只需计算长度 */
+    modrm = *p++;
+    mod = modrm >> 6;
+    rm = modrm & 7;
+    insn->reg = (uint8_t)(((modrm >> 3) & 7) | ((rex & 0x04) ? 8 : 0));
+    if (mod == 3 || (insn->immediate && insn->reg != 0)) {
+        return false;
+    }
+    if (insn->reg_width == 1 && rex == 0 && insn->reg >= 4) {
+        return false;                       // AH/CH/DH/BH
+    }
+    if (rm == 4) {
+        uint8_t sib = *p++;
+        if (mod == 0 && (sib & 7) == 5) {
+            p += 4;
+        }
+    } else if (mod == 0 && rm == 5) {
+        p += 4;                             // RIP相对
+    }
+    p += (mod == 1) ? 1 : (mod == 2) ? 4 : 0;
+
+    if (imm_size == 1) {
+        insn->value = *p;
+    } else if (imm_size == 2) {
+        insn->value = (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+    } else if (imm_size == 4) {
+        insn->value = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+    p += imm_size;
+
+    insn->length = (uint8_t)(p - code);
+    return true;
+}
+
+/**
+ * @brief 在影子页上执行已解码的访问指令并跳过该指令
+ * @param uc: 固件上下文
+ * @param insn: 解码结果
+ * @param address: 访问地址
+ * @retval None
+ */
+static void CMix_Emu_Execute(ucontext_t *uc, const CMix_Emu_Insn_t *insn, volatile uint8_t *shadow)
+{
+    static const int gregs[16] = {
+        REG_RAX, REG_RCX, REG_RDX, REG_RBX, REG_RSP, REG_RBP, REG_RSI, REG_RDI,
+        REG_R8, REG_R9, REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15
+    };
+    greg_t *reg = &uc->uc_mcontext.gregs[gregs[insn->reg]];
+    uint32_t value;
+
+    if (insn->write) {
+        value = insn->immediate ? insn->value : (uint32_t)*reg;
+        if (insn->width == 1) {
+            *shadow = (uint8_t)value;
+        } else if (insn->width == 2) {
+            *(volatile uint16_t *)shadow = (uint16_t)value;
+        } else {
+            *(volatile uint32_t *)shadow = value;
+        }
+    } else {
+        if (insn->width == 1) {
+            value = *shadow;
+            if (insn->sign_extend) value = (uint32_t)(int32_t)(int8_t)value;
+        } else if (insn->width == 2) {
+            value = *(volatile uint16_t *)shadow;
+            if (insn->sign_extend) value = (uint32_t)(int32_t)(int16_t)value;
+        } else {
+            value = *(volatile uint32_t *)shadow;
+        }
+
+        /* 写32位寄存器清零高32位, 写8/16位寄存器保留其余位 */
+        if (insn->reg_width == 1) {
+            *reg = (*reg & ~(greg_t)0xFF) | (greg_t)(value & 0xFF);
+        } else if (insn->reg_width == 2) {
+            *reg = (*reg & ~(greg_t)0xFFFF) | (greg_t)(value & 0xFFFF);
+        } else {
+            *reg = (greg_t)value;
+        }
+    }
+
+    uc->uc_mcontext.gregs[REG_RIP] += insn->length;
+}
+
+/**
+ * @brief SIGSEGV: 寄存器访问开始 (或真实的非法访问)
+ */
+static void CMix_Emu_Segv_Handler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    uintptr_t address = (uintptr_t)info->si_addr;
+    CMix_Emu_Window_t *window = CMix_Emu_Find_Window(address);
+    uint32_t aligned = (uint32_t)(address & ~(uintptr_t)3U);
+    const CMix_Emu_Region_t *region;
+    CMix_Emu_Insn_t insn;
+
+    (void)sig;
+
+    if (window == NULL && !g_access.active && CMix_Emu_Flash_Access(uc, address)) {
+        return;
+    }
+    if (window == NULL || g_access.active) {
+        /* 非寄存器地址: 运行程序崩溃按默认方式处理, 固件崩溃报告后终止 */
+        if (!g_core.in_firmware) {
+            signal(SIGSEGV, SIG_DFL);
+            return;
+        }
+        CMix_Emu_Protect_All();
+        CMix_Emu_Describe(g_core.reason, sizeof(g_core.reason), "invalid memory access",
+                          (uintptr_t)uc->uc_mcontext.gregs[REG_RIP], address);
+        CMix_Emu_Finish(CMIX_EMU_STOP_FAULT);
+        return;
+    }
+
+    g_core.cycle += CMIX_EMU_BUS_CYCLES;
+    CMix_Emu_Sync();
+
+    region = CMix_Emu_Find_Region(aligned);
+    if (region != NULL && region->read != NULL) {
+        region->read(aligned - region->base);
+    }
+
+    g_access.active = 1;
+    g_access.address = aligned;
+    g_access.region = region;
+    g_access.old_value = *CMix_Emu_Reg(aligned);
+    g_access.write = (uc->uc_mcontext.gregs[REG_ERR] & CMIX_EMU_PF_WRITE) ? 1 : 0;
+
+    if (CMix_Emu_Decode((const uint8_t *)uc->uc_mcontext.gregs[REG_RIP], &insn) &&
+        insn.write == g_access.write && (address & 3U) + insn.width <= 4U) {
+        CMix_Emu_Execute(uc, &insn, (volatile uint8_t *)CMix_Emu_Reg(aligned) + (address & 3U));
+        g_access.active = 0;
+        CMix_Emu_Complete();
+        return;
+    }
+
+    mprotect((void *)(address & ~(uintptr_t)(CMIX_EMU_PAGE_SIZE - 1U)), CMIX_EMU_PAGE_SIZE,
+             PROT_READ | PROT_WRITE);
+    uc->uc_mcontext.gregs[REG_EFL] |= CMIX_EMU_EFLAGS_TF;
+}
+
+/**
+ * @brief 固件直接读Flash: 按解码结果从Flash内容读出并跳过该指令
+ * @retval true = 已处理 (读出或报告非法访问), false = 不是Flash访问
+ */
+static bool CMix_Emu_Flash_Access(ucontext_t *uc, uintptr_t address)
+{
+    uintptr_t pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+    CMix_Emu_Insn_t insn;
+
+    if (!g_core.in_firmware || g_flash == NULL ||
+        address < FLASH_BASE + CMIX_EMU_FLASH_GUARD || address - FLASH_BASE >= CMIX_EMU_FLASH_SIZE) {
+        return false;
+    }
+
+    if (uc->uc_mcontext.gregs[REG_ERR] & CMIX_EMU_PF_WRITE) {
+        CMix_Emu_Describe(g_core.reason, sizeof(g_core.reason), "direct flash write", pc, address);
+    } else if (!CMix_Emu_Decode((const uint8_t *)pc, &insn) || insn.write ||
+               (address & 3U) + insn.width > 4U) {
+        CMix_Emu_Describe(g_core.reason, sizeof(g_core.reason), "unsupported flash access", pc, address);
+    } else {
+        g_core.cycle += CMIX_EMU_BUS_CYCLES;
+        CMix_Emu_Execute(uc, &insn, g_flash + (address - FLASH_BASE));
+        return true;
+    }
+
+    CMix_Emu_Protect_All();
+    CMix_Emu_Finish(CMIX_EMU_STOP_FAULT);
+    return true;
+}
+
+/**
+ * @brief SIGTRAP: 访问指令已执行, 完成外设语义并分发中断
+ */
+static void CMix_Emu_Trap_Handler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+
+    (void)sig;
+    (void)info;
+
+    if (!g_access.active) {
+        return;
+    }
+
+    uc->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)CMIX_EMU_EFLAGS_TF;
+    mprotect((void *)(uintptr_t)(g_access.address & ~(CMIX_EMU_PAGE_SIZE - 1U)), CMIX_EMU_PAGE_SIZE, PROT_NONE);
+    g_access.active = 0;
+    CMix_Emu_Complete();
+}
+
+/**
+ * @brief 访问完成: 外设写/读后处理, 重新计算事件并分发中断
+ */
+static void CMix_Emu_Complete(void)
+{
+    CMix_Emu_Access_t access = g_access;
+
+    if (access.write) {
+        g_stats.writes++;
+        if (access.region != NULL && access.region->write != NULL) {
+            access.region->write(access.address - access.region->base, access.old_value,
+                                 *CMix_Emu_Reg(access.address));
+        }
+    } else {
+        g_stats.reads++;
+        if (access.region != NULL && access.region->after_read != NULL) {
+            access.region->after_read(access.address - access.region->base);
+        }
+    }
+
+    CMix_Emu_Schedule_Changed();
+    CMix_Emu_Checkpoint();
+}
+
+/**
+ * @brief SIGALRM: 停滞检测 (仿真时间长时间不推进, 如assert_failed死循环)
+ */
+static void CMix_Emu_Alarm_Handler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    Dl_info symbol;
+
+    (void)sig;
+    (void)info;
+
+    if (!g_core.in_firmware) {
+        return;
+    }
+    if (g_core.cycle != g_watch_cycle) {
+        g_watch_cycle = g_core.cycle;
+        g_watch_ticks = 0;
+        return;
+    }
+    if (++g_watch_ticks * CMIX_EMU_WATCH_PERIOD_MS < CMIX_EMU_STALL_MS) {
+        return;
+    }
+
+    CMix_Emu_Protect_All();
+    CMix_Emu_Describe(g_core.reason, sizeof(g_core.reason), "firmware stalled",
+                      (uintptr_t)uc->uc_mcontext.gregs[REG_RIP], 0);
+
+    /* assert_failed(file, line)为空循环, 参数仍在RDI/RSI中 */
+    if (dladdr((void *)uc->uc_mcontext.gregs[REG_RIP], &symbol) && symbol.dli_sname != NULL &&
+        strcmp(symbol.dli_sname, "assert_failed") == 0) {
+        size_t used = strlen(g_core.reason);
+        snprintf(g_core.reason + used, sizeof(g_core.reason) - used, ": %s:%lu",
+                 (const char *)uc->uc_mcontext.gregs[REG_RDI], (unsigned long)uc->uc_mcontext.gregs[REG_RSI]);
+    }
+    CMix_Emu_Finish(CMIX_EMU_STOP_STALL);
+}
+
+/* ========================= SCS寄存器模型 ========================= */
+
+/**
+ * @brief SysTick读前刷新: VAL按时间计算
+ */
+static void CMix_Emu_SysTick_Read(uint32_t offset)
+{
+    volatile uint32_t *val = CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, VAL));
+    uint32_t ctrl = *CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, CTRL));
+    uint32_t load = *CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, LOAD)) & SysTick_LOAD_RELOAD_Msk;
+
+    if (offset == offsetof(SysTick_Type, VAL) && (ctrl & SysTick_CTRL_ENABLE_Msk)) {
+        *val = load - (uint32_t)((g_core.cycle - g_systick.epoch) % ((uint64_t)load + 1U));
+    }
+}
+
+static void CMix_Emu_SysTick_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    volatile uint32_t *ctrl = CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, CTRL));
+
+    if (offset == offsetof(SysTick_Type, CTRL)) {
+        /* COUNTFLAG只读 */
+        *ctrl = (value & ~SysTick_CTRL_COUNTFLAG_Msk) | (old_value & SysTick_CTRL_COUNTFLAG_Msk);
+        if ((value & SysTick_CTRL_ENABLE_Msk) && !(old_value & SysTick_CTRL_ENABLE_Msk)) {
+            g_systick.epoch = g_core.cycle;
+        }
+    } else if (offset == offsetof(SysTick_Type, VAL)) {
+        /* 写任意值清零计数器和COUNTFLAG */
+        *CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, VAL)) = 0;
+        *ctrl &= ~SysTick_CTRL_COUNTFLAG_Msk;
+        g_systick.epoch = g_core.cycle;
+    }
+    CMix_Emu_SysTick_Schedule();
+}
+
+static void CMix_Emu_SysTick_After_Read(uint32_t offset)
+{
+    if (offset == offsetof(SysTick_Type, CTRL)) {
+        *CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, CTRL)) &= ~SysTick_CTRL_COUNTFLAG_Msk;
+    }
+}
+
+static void CMix_Emu_SysTick_Schedule(void)
+{
+    uint32_t ctrl = *CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, CTRL));
+    uint32_t load = *CMix_Emu_Reg(SysTick_BASE + offsetof(SysTick_Type, LOAD)) & SysTick_LOAD_RELOAD_Msk;
+
+    if (!(ctrl & SysTick_CTRL_ENABLE_Msk) || load == 0) {
+        g_systick.next_wrap = CMIX_EMU_NEVER;
+        return;
+    }
+
+    /* 下一次计到0: epoch + k*(LOAD+1) 中第一个晚于当前时刻的 */
+    g_systick.next_wrap = g_systick.epoch + ((g_core.cycle - g_systick.epoch) / ((uint64_t)load + 1U) + 1U) *
+                          ((uint64_t)load + 1U);
+}
+
+/**
+ * @brief NVIC写: 使能/挂起寄存器为置位/清零对
+ */
+static void CMix_Emu_NVIC_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    (void)old_value;
+
+    switch (offset) {
+    case offsetof(NVIC_Type, ISER):
+        g_core.nvic_enabled |= value;
+        break;
+    case offsetof(NVIC_Type, ICER):
+        g_core.nvic_enabled &= ~value;
+        break;
+    case offsetof(NVIC_Type, ISPR):
+        g_core.nvic_pending |= value;
+        break;
+    case offsetof(NVIC_Type, ICPR):
+        g_core.nvic_pending &= ~value;
+        break;
+    default:
+        return;
+    }
+
+    *CMix_Emu_Reg(NVIC_BASE + offsetof(NVIC_Type, ISER)) = g_core.nvic_enabled;
+    *CMix_Emu_Reg(NVIC_BASE + offsetof(NVIC_Type, ICER)) = g_core.nvic_enabled;
+    *CMix_Emu_Reg(NVIC_BASE + offsetof(NVIC_Type, ISPR)) = g_core.nvic_pending;
+    *CMix_Emu_Reg(NVIC_BASE + offsetof(NVIC_Type, ICPR)) = g_core.nvic_pending;
+}
+
+/**
+ * @brief SCB写: AIRCR复位请求, ICSR挂起SysTick
+ */
+static void CMix_Emu_SCB_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    if (offset == offsetof(SCB_Type, AIRCR)) {
+        if ((value >> SCB_AIRCR_VECTKEY_Pos) == 0x5FAUL && (value & SCB_AIRCR_SYSRESETREQ_Msk)) {
+            g_core.reset_request = 1;
+        }
+        *CMix_Emu_Reg(SCB_BASE + offsetof(SCB_Type, AIRCR)) =
+            (0xFA05UL << SCB_AIRCR_VECTKEY_Pos) | (value & 0xFFFFU & ~SCB_AIRCR_SYSRESETREQ_Msk);
+    } else if (offset == offsetof(SCB_Type, ICSR)) {
+        if (value & SCB_ICSR_PENDSTSET_Msk) {
+            g_core.systick_pending = 1;
+        }
+        if (value & SCB_ICSR_PENDSTCLR_Msk) {
+            g_core.systick_pending = 0;
+        }
+        *CMix_Emu_Reg(SCB_BASE + offsetof(SCB_Type, ICSR)) = old_value;
+    }
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+  * @file    CMix_emu_internal.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix主机仿真器内部接口
+  *          内核 (CMix_emu_core.c) 与外设模型 (CMix_emu_periph.c) 之间的接口
+  ******************************************************************************
+  * @attention
+  *
+  * 外设模型以地址区域登记到内核. 寄存器值保存在区域的影子页中:
+  *   read:       读访问前调用, 刷新随时间变化的寄存器 (计数器等)
+  *   write:      写访问后调用, 参数为写前值和写入值, 可修改影子值
+  *               实现写1清零/自清零等语义
+  *   after_read: 读访问后调用, 实现读清零类副作用
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_EMU_INTERNAL_H
+#define __CMIX_EMU_INTERNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CMix_emu.h"
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_EMU_NEVER              UINT64_MAX  // 无待处理事件
+
+/* 影子寄存器访问: CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) */
+#define CMIX_EMU_REG(base, type, member) \
+    (*CMix_Emu_Reg((uint32_t)(base) + (uint32_t)offsetof(type, member)))
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 外设地址区域 */
+typedef struct {
+    uint32_t base;                          // 区域基地址
+    uint32_t size;                          // 区域大小 (字节)
+    void (*read)(uint32_t offset);
+    void (*write)(uint32_t offset, uint32_t old_value, uint32_t value);
+    void (*after_read)(uint32_t offset);
+} CMix_Emu_Region_t;
+
+/* ========================= 函数声明 ========================= */
+
+/* 内核提供 */
+volatile uint32_t *CMix_Emu_Reg(uint32_t address);
+bool CMix_Emu_Is_Register(uint32_t address);
+uint8_t *CMix_Emu_Flash(uint32_t address);
+void CMix_Emu_Bus_Stall(uint32_t cycles);
+uint32_t CMix_Emu_Bus_Read(uint32_t address);
+void CMix_Emu_Bus_Write(uint32_t address, uint32_t value);
+void CMix_Emu_IRQ_Touch(int irqn, uint64_t cycle);
+void CMix_Emu_Schedule_Changed(void);
+
+/* 外设模型提供 */
+void CMix_Emu_Periph_Reset(void);
+const CMix_Emu_Region_t *CMix_Emu_Periph_Regions(uint32_t *count);
+uint64_t CMix_Emu_Periph_Next_Event(void);
+void CMix_Emu_Periph_Process(uint64_t cycle);
+bool CMix_Emu_Periph_IRQ_Level(int irqn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_EMU_INTERNAL_H */
@@ -0,0 +1,1648 @@
+/******************************************************************************
+  * @file    CMix_emu_periph.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix主机仿真器外设模型
+  *          TIM1, ADC0, DMA0, CRC, UART0, CMP0/CMP1, LDAC0, GPIOA/GPIOB, IFMC
+  ******************************************************************************
+  * @attention
+  *
+  * 外设模型只覆盖CMix固件使用的功能, 寄存器位定义直接取自PT32x0xx.h.
+  * 未登记的寄存器 (RCC, PWR, SYSCFG, OPA, AFIO等) 作为普通存储.
+  *
+  * 时序约定 (周期均为HCLK周期):
+  *   TIM1:  边沿对齐: 向上计数, 每(ARR+1)个计数溢出一次, 每次溢出为更新事件;
+  *          中心对齐: 0 -> ARR (峰点) -> 0 (谷点), 周期2*ARR个计数, CMS模式1谷点更新,
+  *          模式2峰点更新, 模式3两处都更新, DIR只读指示计数方向;
+  *          一个计数为(PSC+1)*PCLK分频. 更新事件产生TRGO; 向上/向下计数溢出按TACR/JTACR
+  *          的UOAE/DOAE直接触发ADC规则组/注入组.
+  *          CR.CPC置位时OCR写入待生效, 更新事件时四路同时装载; 否则写入立即生效
+  *   ADC0:  每通道 (PSC+1)*(SETUP+SMP+14)*PCLK分频, 整次扫描在结束时刻一次完成;
+  *          注入组优先, 同时触发时规则组在注入组结束后开始;
+  *          模拟看门狗在所属扫描结束时刻判断 (单通道或全部通道, 窗口外置位AWD)
+  *   DMA0:  外设请求立即搬运; 存储器到存储器每个数据2周期
+  *   UART0: 每字节10位, 位时间为BRR分频系数
+  *   CMP:   正端电压与LDAC (VDDA*DR/32) 或1.0V基准比较, 结果经OPC极性和数字滤波
+  *          (DFC采样数*(CKD+1)个PCLK) 后更新输出; 下降沿COF, 上升沿COR
+  *   刹车:  比较器输出为BKP有效电平或软件刹车 (SWE且BKSC) 时立即关断输出并置位BIF;
+  *          锁存到BIF写1清零, 清零时刹车源全部无效才恢复输出
+  *   IFMC:  KR1/KR2按库函数的解锁顺序解锁AR和CR2, 错误键值置KERR. 写CR2.PG把DR1
+  *          按位与写入AR处的字 (只能1变0), 写CR2.PER擦除AR所在页为0xFF; 操作在写CR2时
+  *          完成, CPU停顿编程/擦除时间 (单Bank Flash, 取指等待), 其间到期的中断延后响应.
+  *          编程和擦除时间为假设值 (数据手册未给出), 见CMIX_EMU_IFMC_*_US
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_emu_internal.h"
+#include "PT32x0xx.h"
+
+#include <string.h>
+#include <unistd.h>
+
+/* ========================= 私有常量定义 ========================= */
+
+#define CMIX_EMU_DMA_CHANNELS       6
+#define CMIX_EMU_DMA_CH_ADC0        0x1E        // CHAPCR外设选择: ADC0
+#define CMIX_EMU_DMA_M2M_CYCLES     2           // 存储器到存储器每个数据周期
+#define CMIX_EMU_ADC_CHANNELS       32
+#define CMIX_EMU_ADC_FIXED_CLOCKS   14          // 逐次逼近和数据输出的固定时钟数
+#define CMIX_EMU_ADC_TRIG_TIMER     0x00040000  // ADC_RegularTriggerSource_Timer
+#define CMIX_EMU_ADC_TIMS_TIM1      0x00100000  // ADC_RegularTimerTriggerSource_TIM1
+#define CMIX_EMU_ADC_JTRIG_TIMER    0x00000040  // ADC_InjectedTriggerSource_Timer
+#define CMIX_EMU_ADC_JTIMS_TIM1     0x00000100  // ADC_InjectedTimerTriggerSource_TIM1
+#define CMIX_EMU_TIM_TOS_UPDATE     0x00002000  // TIM_MasterMode_Update
+#define CMIX_EMU_TIM_CMS_VALLEY     0x00020000  // 中心对齐模式1/3: 谷点更新
+#define CMIX_EMU_TIM_CMS_PEAK       0x00040000  // 中心对齐模式2/3: 峰点更新
+#define CMIX_EMU_UART_RX_SIZE       4096
+#define CMIX_EMU_UART_OUT_SIZE      1024
+#define CMIX_EMU_VDDA_MV            5000        // LDAC参考电压 (VDDA)
+#define CMIX_EMU_LDAC_STEPS         32          // LDAC级数 (5位)
+#define CMIX_EMU_CMP_BG_MV          1000        // 比较器负端内部1.0V基准
+#define CMIX_EMU_CMP_CNS_LDAC       0x00000010  // CMP_NegativeInput_LDAC
+#define CMIX_EMU_CMP_CNS_BG1V0      0x00000020  // CMP_NegativeInput_BG1V0
+
+#define CMIX_EMU_IFMC_PROGRAM_US    30          // 字编程时间 (假设值)
+#define CMIX_EMU_IFMC_ERASE_US      4000        // 页擦除时间 (假设值)
+#define CMIX_EMU_IFMC_PAGE_SIZE     512
+#define CMIX_EMU_IFMC_PAGES         (CMIX_EMU_FLASH_SIZE / CMIX_EMU_IFMC_PAGE_SIZE)
+#define CMIX_EMU_IFMC_KR1_UNLOCK    0x3B6A0000  // KR1解锁键 (库内私有定义)
+#define CMIX_EMU_IFMC_KR1_MAINCODE  0x0000ADEB  // 主程序区AR写键
+#define CMIX_EMU_IFMC_KR2_UNLOCK    0xB75C0000  // KR2解锁键
+#define CMIX_EMU_IFMC_KR2_CR2_KEY   0x0000D3A5  // CR2解锁键
+#define CMIX_EMU_IFMC_LOCK_KEY      0xEA2D0000  // KR1/KR2上锁键
+
+#define CMIX_EMU_DMA_CH_BASE(ch)    (DMA0_CH0_BASE + 0x20U * (ch))
+
+/* ========================= 私有数据结构 ========================= */
+
+typedef struct {
+    uint64_t epoch;                         // 本段计数开始的时刻 (向上从0, 向下从ARR)
+    uint64_t next_overflow;                 // 下一次计数溢出 (边沿对齐每次为更新事件, 中心对齐为峰点/谷点)
+    uint32_t period;                        // 每段计数时长 (HCLK周期)
+    uint8_t down;                           // 中心对齐: 当前向下计数
+    uint32_t updates;
+    uint16_t compare[4];                    // 生效的比较值 (CPC置位时更新事件从OCR装载)
+    uint8_t break_active;                   // 刹车已触发, 输出关闭
+    uint64_t break_cycle;                   // 刹车触发时刻
+    CMix_Emu_TIM_Hook_t hook;
+    void *hook_context;
+} CMix_Emu_TIM_t;
+
+typedef struct {
+    uint16_t value[CMIX_EMU_ADC_CHANNELS];  // 注入的转换值
+    CMix_Emu_ADC_Source_t source;
+    void *source_context;
+    uint64_t regular_done;                  // 规则组转换结束时刻
+    uint64_t injected_done;                 // 注入组转换结束时刻
+    uint8_t regular_scan;                   // 当前规则组转换为扫描
+    uint32_t scans;
+    uint32_t injected_scans;
+    uint32_t overruns;                      // 转换进行中又被触发
+    uint32_t watchdog_events;               // 模拟看门狗越限次数
+    uint32_t channel_conversions[CMIX_EMU_ADC_CHANNELS];  // 各通道转换次数 (规则组和注入组)
+} CMix_Emu_ADC_t;
+
+typedef struct {
+    uint32_t index[CMIX_EMU_DMA_CHANNELS];  // 当前传输序号
+    uint64_t m2m_done[CMIX_EMU_DMA_CHANNELS];
+} CMix_Emu_DMA_t;
+
+typedef struct {
+    uint16_t crc;                           // 内部CRC寄存器
+} CMix_Emu_CRC_t;
+
+typedef struct {
+    uint8_t rx_queue[CMIX_EMU_UART_RX_SIZE];
+    uint32_t rx_head;
+    uint32_t rx_tail;
+    uint64_t rx_next;                       // 下一个接收字节到达时刻
+    uint64_t rx_last;                       // 最近一个接收字节到达时刻
+    uint32_t rx_overruns;
+    uint64_t tx_done;                       // 移位寄存器发送完成时刻
+    uint8_t tx_shift;
+    uint8_t tx_shift_busy;
+    uint8_t tx_hold;
+    uint8_t tx_hold_valid;
+    uint8_t rx_data;                        // 接收数据寄存器
+    CMix_Emu_UART_Hook_t tx_hook;
+    void *tx_hook_context;
+    int out_fd;
+    uint8_t out_buffer[CMIX_EMU_UART_OUT_SIZE];
+    uint32_t out_length;
+} CMix_Emu_UART_t;
+
+typedef struct {
+    uint32_t input_mv[2];                   // 正端电压 (mV)
+    uint8_t level[2];                       // 滤波后的输出电平 (SR.CRS)
+    uint8_t pending[2];                     // 滤波中的新电平
+    uint64_t settle[2];                     // 滤波完成时刻
+} CMix_Emu_CMP_t;
+
+typedef struct {
+    uint32_t latch[2];                      // 输出锁存
+    uint32_t input[2];                      // 外部输入电平
+} CMix_Emu_GPIO_t;
+
+typedef struct {
+    uint8_t ar_unlocked;                    // KR1已写入主程序区键, 允许写AR
+    CMix_Emu_Flash_Stats_t stats;
+    uint32_t page_erases[CMIX_EMU_IFMC_PAGES];
+} CMix_Emu_IFMC_t;
+
+/* ========================= 私有变量 ========================= */
+
+static CMix_Emu_TIM_t g_tim;
+static CMix_Emu_ADC_t g_adc;
+static CMix_Emu_DMA_t g_dma;
+static CMix_Emu_CRC_t g_crc;
+static CMix_Emu_UART_t g_uart;
+static CMix_Emu_CMP_t g_cmp;
+static CMix_Emu_GPIO_t g_gpio;
+static CMix_Emu_IFMC_t g_ifmc;
+
+/* ========================= 私有函数声明 ========================= */
+
+static void CMix_Emu_TIM_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_TIM_Read(uint32_t offset);
+static uint32_t CMix_Emu_TIM_Tick(void);
+static uint32_t CMix_Emu_TIM_Segment(void);
+static void CMix_Emu_TIM_Start(uint64_t cycle);
+static void CMix_Emu_TIM_Load_Compare(void);
+static bool CMix_Emu_TIM_Is_Update(bool peak);
+static void CMix_Emu_TIM_Overflow(uint64_t cycle);
+static void CMix_Emu_TIM_Evaluate_Break(uint64_t cycle);
+static bool CMix_Emu_TIM_Break_Source_Active(void);
+static void CMix_Emu_ADC_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_ADC_Start(uint64_t cycle, bool scan);
+static void CMix_Emu_ADC_Start_Injected(uint64_t cycle);
+static void CMix_Emu_ADC_Regular_Done(uint64_t cycle);
+static void CMix_Emu_ADC_Injected_Done(uint64_t cycle);
+static uint32_t CMix_Emu_ADC_Conversion_Cycles(void);
+static uint16_t CMix_Emu_ADC_Sample(uint8_t channel, uint64_t cycle);
+static void CMix_Emu_ADC_Watchdog(uint8_t channel, uint16_t sample);
+static void CMix_Emu_DMA_Channel_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_DMA_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_DMA_Request(uint32_t peripheral, uint64_t cycle);
+static void CMix_Emu_DMA_Transfer(uint8_t ch, uint64_t cycle);
+static void CMix_Emu_CRC_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_CRC_Feed(uint32_t data, uint8_t bits);
+static void CMix_Emu_UART_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_UART_After_Read(uint32_t offset);
+static void CMix_Emu_UART_TX_Done(uint64_t cycle);
+static void CMix_Emu_UART_RX_Arrive(uint64_t cycle);
+static void CMix_Emu_UART_Flush(void);
+static void CMix_Emu_CMP0_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_CMP1_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_CMP_Write(uint8_t unit, uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_CMP_Evaluate(uint8_t unit, uint64_t cycle);
+static void CMix_Emu_CMP_Output(uint8_t unit, uint64_t cycle);
+static void CMix_Emu_LDAC_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_GPIOA_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_GPIOB_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_GPIOA_Read(uint32_t offset);
+static void CMix_Emu_GPIOB_Read(uint32_t offset);
+static void CMix_Emu_GPIO_Write(uint8_t port, uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_GPIO_Read(uint8_t port, uint32_t offset);
+static void CMix_Emu_GPIO_Refresh(uint8_t port);
+static void CMix_Emu_IFMC_Write(uint32_t offset, uint32_t old_value, uint32_t value);
+static void CMix_Emu_IFMC_Execute(uint32_t command);
+static void CMix_Emu_IFMC_Error(uint32_t flag);
+
+static const CMix_Emu_Region_t g_periph_regions[] = {
+    {TIM1_BASE, sizeof(TIM_TypeDef), CMix_Emu_TIM_Read, CMix_Emu_TIM_Write, NULL},
+    {ADC0_BASE, sizeof(ADC_TypeDef), NULL, CMix_Emu_ADC_Write, NULL},
+    {DMA0_CH0_BASE, 0x20U * CMIX_EMU_DMA_CHANNELS, NULL, CMix_Emu_DMA_Channel_Write, NULL},
+    {DMA0_BASE, sizeof(DMA_TypeDef), NULL, CMix_Emu_DMA_Write, NULL},
+    {CRC_BASE, sizeof(CRC_TypeDef), NULL, CMix_Emu_CRC_Write, NULL},
+    {UART0_BASE, sizeof(UART_TypeDef), NULL, CMix_Emu_UART_Write, CMix_Emu_UART_After_Read},
+    {CMP0_BASE, sizeof(CMP_TypeDef), NULL, CMix_Emu_CMP0_Write, NULL},
+    {CMP1_BASE, sizeof(CMP_TypeDef), NULL, CMix_Emu_CMP1_Write, NULL},
+    {LDAC0_BASE, sizeof(LDAC_TypeDef), NULL, CMix_Emu_LDAC_Write, NULL},
+    {GPIOA_BASE, sizeof(GPIO_TypeDef), CMix_Emu_GPIOA_Read, CMix_Emu_GPIOA_Write, NULL},
+    {GPIOB_BASE, sizeof(GPIO_TypeDef), CMix_Emu_GPIOB_Read, CMix_Emu_GPIOB_Write, NULL},
+    {IFMC_BASE, sizeof(IFMC_TypeDef), NULL, CMix_Emu_IFMC_Write, NULL}
+};
+
+/* ========================= 内核接口 ========================= */
+
+/**
+ * @brief 外设模型复位
+ * @param None
+ * @retval None
+ */
+void CMix_Emu_Periph_Reset(void)
+{
+    uint8_t i;
+
+    memset(&g_tim, 0, sizeof(g_tim));
+    memset(&g_adc, 0, sizeof(g_adc));
+    memset(&g_dma, 0, sizeof(g_dma));
+    memset(&g_crc, 0, sizeof(g_crc));
+    memset(&g_uart, 0, sizeof(g_uart));
+    memset(&g_cmp, 0, sizeof(g_cmp));
+    memset(&g_gpio, 0, sizeof(g_gpio));
+    memset(&g_ifmc, 0, sizeof(g_ifmc));
+
+    g_tim.next_overflow = CMIX_EMU_NEVER;
+    g_adc.regular_done = CMIX_EMU_NEVER;
+    g_adc.injected_done = CMIX_EMU_NEVER;
+    for (i = 0; i < CMIX_EMU_DMA_CHANNELS; i++) {
+        g_dma.m2m_done[i] = CMIX_EMU_NEVER;
+    }
+    g_uart.rx_next = CMIX_EMU_NEVER;
+    g_uart.tx_done = CMIX_EMU_NEVER;
+    g_uart.out_fd = -1;
+    for (i = 0; i < 2; i++) {
+        g_cmp.level[i] = 1;
+        g_cmp.settle[i] = CMIX_EMU_NEVER;
+    }
+
+    /* 复位值: UART发送空闲, 比较器输出空闲为高, 输入引脚上拉为高 */
+    CMIX_EMU_REG(UART0_BASE, UART_TypeDef, SR) = UART_SR_TXE | UART_SR_TXC;
+    CMIX_EMU_REG(CMP0_BASE, CMP_TypeDef, SR) = CMP_SR_CRS;
+    CMIX_EMU_REG(CMP1_BASE, CMP_TypeDef, SR) = CMP_SR_CRS;
+    CMIX_EMU_REG(CRC_BASE, CRC_TypeDef, POLYR) = 0x8005;
+    CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, KR1) = IFMC_KR1_LOCK;
+    CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, KR2) = IFMC_KR2_LOCK1 | IFMC_KR2_LOCK2;
+    g_gpio.input[0] = 0xFFFF;
+    g_gpio.input[1] = 0xFFFF;
+    CMix_Emu_GPIO_Refresh(0);
+    CMix_Emu_GPIO_Refresh(1);
+}
+
+const CMix_Emu_Region_t *CMix_Emu_Periph_Regions(uint32_t *count)
+{
+    *count = sizeof(g_periph_regions) / sizeof(g_periph_regions[0]);
+    return g_periph_regions;
+}
+
+/**
+ * @brief 最近的外设事件时刻
+ * @param None
+ * @retval 事件周期, 无事件时返回CMIX_EMU_NEVER
+ */
+uint64_t CMix_Emu_Periph_Next_Event(void)
+{
+    uint64_t next = g_tim.next_overflow;
+    uint8_t i;
+
+    if (g_adc.regular_done < next) next = g_adc.regular_done;
+    if (g_adc.injected_done < next) next = g_adc.injected_done;
+    if (g_uart.tx_done < next) next = g_uart.tx_done;
+    if (g_uart.rx_next < next) next = g_uart.rx_next;
+    for (i = 0; i < CMIX_EMU_DMA_CHANNELS; i++) {
+        if (g_dma.m2m_done[i] < next) next = g_dma.m2m_done[i];
+    }
+    for (i = 0; i < 2; i++) {
+        if (g_cmp.settle[i] < next) next = g_cmp.settle[i];
+    }
+    return next;
+}
+
+/**
+ * @brief 处理到期的外设事件
+ * @param cycle: 事件时刻 (内核保证为最近事件时刻)
+ * @retval None
+ */
+void CMix_Emu_Periph_Process(uint64_t cycle)
+{
+    uint8_t i;
+
+    /* 定时器更新先于由其触发的ADC转换 */
+    if (g_tim.next_overflow <= cycle) {
+        CMix_Emu_TIM_Overflow(g_tim.next_overflow);
+    }
+    if (g_adc.regular_done <= cycle) {
+        CMix_Emu_ADC_Regular_Done(g_adc.regular_done);
+    }
+    if (g_adc.injected_done <= cycle) {
+        CMix_Emu_ADC_Injected_Done(g_adc.injected_done);
+    }
+    for (i = 0; i < CMIX_EMU_DMA_CHANNELS; i++) {
+        if (g_dma.m2m_done[i] <= cycle) {
+            uint64_t done = g_dma.m2m_done[i];
+            uint32_t count = CMIX_EMU_REG(CMIX_EMU_DMA_CH_BASE(i), DMA_Channel_TypeDef, CNDTR) & 0xFFFF;
+
+            g_dma.m2m_done[i] = CMIX_EMU_NEVER;
+            while (g_dma.index[i] < count) {
+                CMix_Emu_DMA_Transfer(i, done);
+            }
+        }
+    }
+    if (g_uart.tx_done <= cycle) {
+        CMix_Emu_UART_TX_Done(g_uart.tx_done);
+    }
+    if (g_uart.rx_next <= cycle) {
+        CMix_Emu_UART_RX_Arrive(g_uart.rx_next);
+    }
+    for (i = 0; i < 2; i++) {
+        if (g_cmp.settle[i] <= cycle) {
+            CMix_Emu_CMP_Output(i, g_cmp.settle[i]);
+        }
+    }
+}
+
+/**
+ * @brief 外设中断请求电平 (状态标志与中断使能)
+ * @param irqn: 中断号
+ * @retval true=请求有效
+ */
+bool CMix_Emu_Periph_IRQ_Level(int irqn)
+{
+    switch (irqn) {
+    case TIM1_IRQn:
+        return ((CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, SR1) & CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, IER1)) |
+                (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, SR2) & CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, IER2))) != 0;
+    case ADC0_IRQn:
+        return (CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) & CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, IER) &
+                (ADC_SR_EOC | ADC_SR_JEOC | ADC_SR_EOS | ADC_SR_JEOS | ADC_SR_AWD)) != 0;
+    case DMA_IRQn:
+        return (CMIX_EMU_REG(DMA0_BASE, DMA_TypeDef, SR) & CMIX_EMU_REG(DMA0_BASE, DMA_TypeDef, IER)) != 0;
+    case UART0_IRQn:
+        return (CMIX_EMU_REG(UART0_BASE, UART_TypeDef, SR) & CMIX_EMU_REG(UART0_BASE, UART_TypeDef, IER) &
+                (UART_SR_RXNE | UART_SR_OVR | UART_SR_TXE | UART_SR_TXC)) != 0;
+    case CMP0_IRQn:
+        return (CMIX_EMU_REG(CMP0_BASE, CMP_TypeDef, SR) & CMIX_EMU_REG(CMP0_BASE, CMP_TypeDef, IER) &
+                (CMP_SR_COF | CMP_SR_COR)) != 0;
+    case CMP1_IRQn:
+        return (CMIX_EMU_REG(CMP1_BASE, CMP_TypeDef, SR) & CMIX_EMU_REG(CMP1_BASE, CMP_TypeDef, IER) &
+                (CMP_SR_COF | CMP_SR_COR)) != 0;
+    default:
+        return false;
+    }
+}
+
+/* ========================= TIM1 ========================= */
+
+static void CMix_Emu_TIM_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    volatile uint32_t *reg = CMix_Emu_Reg(TIM1_BASE + offset);
+    uint64_t now = CMix_Emu_Cycle();
+
+    if (offset >= offsetof(TIM_TypeDef, OCR) && offset < offsetof(TIM_TypeDef, OCR) + sizeof(((TIM_TypeDef *)0)->OCR)) {
+        /* 无预装载时写入立即生效, 否则等待更新事件 */
+        if (!(CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_CPC)) {
+            g_tim.compare[(offset - offsetof(TIM_TypeDef, OCR)) / 4U] = (uint16_t)(value & 0xFFFF);
+        }
+        return;
+    }
+
+    switch (offset) {
+    case offsetof(TIM_TypeDef, CR):
+        if (value & TIM_CR_UG) {
+            *reg &= ~TIM_CR_UG;
+            if (value & TIM_CR_EN) {
+                CMix_Emu_TIM_Start(now);
+            }
+        }
+        if ((value & TIM_CR_EN) && !(old_value & TIM_CR_EN)) {
+            CMix_Emu_TIM_Start(now);
+        } else if (!(value & TIM_CR_EN)) {
+            g_tim.next_overflow = CMIX_EMU_NEVER;
+        }
+        if (*reg & TIM_CR_CMS) {
+            /* 中心对齐时DIR只读 */
+            *reg = (*reg & ~TIM_CR_DIR) | (g_tim.down ? TIM_CR_DIR : 0);
+        }
+        break;
+    case offsetof(TIM_TypeDef, SR1):
+        /* 写1清零 */
+        *reg = old_value & ~value;
+        break;
+    case offsetof(TIM_TypeDef, SR2):
+        *reg = old_value & ~value;
+        if ((value & TIM_SR2_BIF) && g_tim.break_active && !CMix_Emu_TIM_Break_Source_Active()) {
+            g_tim.break_active = 0;
+        }
+        break;
+    case offsetof(TIM_TypeDef, BKICR):
+        CMix_Emu_TIM_Evaluate_Break(now);
+        break;
+    case offsetof(TIM_TypeDef, CNTR):
+        if (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_EN) {
+            CMix_Emu_TIM_Start(now);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief TIM1读前刷新: CNTR按时间和计数方向计算, 中心对齐时DIR为当前方向
+ */
+static void CMix_Emu_TIM_Read(uint32_t offset)
+{
+    if (offset == offsetof(TIM_TypeDef, CNTR) && g_tim.next_overflow != CMIX_EMU_NEVER) {
+        uint32_t arr = CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, ARR) & 0xFFFF;
+        uint32_t count = (uint32_t)((CMix_Emu_Cycle() - g_tim.epoch) / CMix_Emu_TIM_Tick());
+
+        CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CNTR) = g_tim.down ? arr - count : count;
+    } else if (offset == offsetof(TIM_TypeDef, CR) && (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_CMS)) {
+        CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) =
+            (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & ~TIM_CR_DIR) | (g_tim.down ? TIM_CR_DIR : 0);
+    }
+}
+
+/**
+ * @brief 一个计数的HCLK周期数
+ */
+static uint32_t CMix_Emu_TIM_Tick(void)
+{
+    return ((CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, PSCR) & 0xFFFF) + 1U) *
+           (CMix_Emu_Core_Clock() / CMix_Emu_Periph_Clock());
+}
+
+/**
+ * @brief 每段计数时长: 边沿对齐ARR+1个计数, 中心对齐单向ARR个计数
+ */
+static uint32_t CMix_Emu_TIM_Segment(void)
+{
+    uint32_t arr = CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, ARR) & 0xFFFF;
+
+    if (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_CMS) {
+        return arr * CMix_Emu_TIM_Tick();
+    }
+    return (arr + 1U) * CMix_Emu_TIM_Tick();
+}
+
+static void CMix_Emu_TIM_Start(uint64_t cycle)
+{
+    g_tim.down = 0;
+    g_tim.period = CMix_Emu_TIM_Segment();
+    g_tim.epoch = cycle;
+    g_tim.next_overflow = cycle + g_tim.period;
+    CMix_Emu_TIM_Load_Compare();
+    CMix_Emu_Schedule_Changed();
+}
+
+/**
+ * @brief 比较值从OCR装载到生效值 (启动、软件更新和预装载时的更新事件)
+ */
+static void CMix_Emu_TIM_Load_Compare(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < 4; i++) {
+        g_tim.compare[i] = (uint16_t)(*CMix_Emu_Reg(TIM1_BASE + offsetof(TIM_TypeDef, OCR) + 4U * i) & 0xFFFF);
+    }
+}
+
+/**
+ * @brief 溢出是否为更新事件
+ * @param peak: 中心对齐的峰点 (否则为谷点或边沿对齐溢出)
+ */
+static bool CMix_Emu_TIM_Is_Update(bool peak)
+{
+    uint32_t cms = CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_CMS;
+
+    if (cms == 0) {
+        return true;
+    }
+    return (cms & (peak ? CMIX_EMU_TIM_CMS_PEAK : CMIX_EMU_TIM_CMS_VALLEY)) != 0;
+}
+
+/**
+ * @brief TIM1计数溢出: 更新事件置位标志、调用钩子、产生TRGO; 按TACR/JTACR触发ADC
+ * @param cycle: 事件时刻
+ * @retval None
+ */
+static void CMix_Emu_TIM_Overflow(uint64_t cycle)
+{
+    uint32_t arr = CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, ARR) & 0xFFFF;
+    bool center = (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_CMS) != 0;
+    bool peak = center && !g_tim.down;
+    bool update = CMix_Emu_TIM_Is_Update(peak);
+    bool trgo = false;
+    uint32_t event = peak || !center ? TIM_TACR_UOAE : TIM_TACR_DOAE;
+    uint32_t cr1, cr2, cr3;
+    uint8_t i;
+
+    if (update) {
+        uint32_t flags = TIM_SR1_ARF;
+
+        if (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_CPC) {
+            CMix_Emu_TIM_Load_Compare();
+        }
+        for (i = 0; i < 4; i++) {
+            if (g_tim.compare[i] <= arr) {
+                flags |= TIM_SR1_OC1F << i;
+            }
+        }
+        CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, SR1) |= flags;
+        CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, SR2) |= TIM_SR2_UF;
+        g_tim.updates++;
+        CMix_Emu_IRQ_Touch(TIM1_IRQn, cycle);
+
+        if (g_tim.hook != NULL) {
+            g_tim.hook(g_tim.hook_context, cycle);
+        }
+        trgo = (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, MSCR) & TIM_MSCR_TOS) == CMIX_EMU_TIM_TOS_UPDATE;
+    }
+
+    /* TRGO或溢出触发 -> ADC注入组/规则组 (注入组优先) */
+    cr1 = CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR1);
+    cr2 = CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR2);
+    cr3 = CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR3);
+    if ((cr1 & ADC_CR1_EN) && (cr3 & ADC_CR3_JTRIGS) == CMIX_EMU_ADC_JTRIG_TIMER &&
+        (cr3 & ADC_CR3_JTIMS) == CMIX_EMU_ADC_JTIMS_TIM1 &&
+        (trgo || (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, JTACR) & event))) {
+        CMix_Emu_ADC_Start_Injected(cycle);
+    }
+    if ((cr1 & ADC_CR1_EN) && (cr2 & ADC_CR2_TRIGS) == CMIX_EMU_ADC_TRIG_TIMER &&
+        (cr2 & ADC_CR2_TIMS) == CMIX_EMU_ADC_TIMS_TIM1 &&
+        (trgo || (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, TACR) & event))) {
+        CMix_Emu_ADC_Start(cycle, (cr3 & ADC_CR3_SCANE) != 0);
+    }
+
+    if (center) {
+        g_tim.down = !g_tim.down;
+    }
+    g_tim.epoch = cycle;
+    g_tim.period = CMix_Emu_TIM_Segment();
+    g_tim.next_overflow = cycle + g_tim.period;
+}
+
+/**
+ * @brief 刹车源是否有效: 刹车使能且比较器源为有效电平或软件刹车
+ * @param None
+ * @retval true=有刹车源有效
+ */
+static bool CMix_Emu_TIM_Break_Source_Active(void)
+{
+    uint32_t bkicr = CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, BKICR);
+    uint8_t active = (bkicr & TIM_BKICR_BKP) ? 1 : 0;
+
+    if (!(bkicr & TIM_BKICR_BKE)) {
+        return false;
+    }
+    if ((bkicr & TIM_BKICR_CMP0E) && g_cmp.level[0] == active) return true;
+    if ((bkicr & TIM_BKICR_CMP1E) && g_cmp.level[1] == active) return true;
+    if ((bkicr & TIM_BKICR_SWE) && (bkicr & TIM_BKICR_BKSC)) return true;
+    return false;
+}
+
+/**
+ * @brief 刹车输入评估: 使能的比较器源为有效电平或软件刹车时关闭输出并置位BIF
+ * @param cycle: 当前时刻
+ * @retval None
+ */
+static void CMix_Emu_TIM_Evaluate_Break(uint64_t cycle)
+{
+    if (CMix_Emu_TIM_Break_Source_Active() && !g_tim.break_active) {
+        g_tim.break_active = 1;
+        g_tim.break_cycle = cycle;
+        CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, SR2) |= TIM_SR2_BIF;
+        CMix_Emu_IRQ_Touch(TIM1_IRQn, cycle);
+    }
+}
+
+void CMix_Emu_TIM_Set_Update_Hook(CMix_Emu_TIM_Hook_t hook, void *context)
+{
+    g_tim.hook = hook;
+    g_tim.hook_context = context;
+}
+
+/**
+ * @brief 获取生效的比较值 (向上计数比较值, 低16位)
+ * @param index: 比较通道序号 (0-3, 对应OCR[0..3])
+ * @retval 比较值 (预装载时为最近一次更新事件装载的值, 而非OCR中待生效的值)
+ */
+uint16_t CMix_Emu_TIM_Get_Compare(uint8_t index)
+{
+    if (index >= 4) {
+        return 0;
+    }
+    return g_tim.compare[index];
+}
+
+/**
+ * @brief PWM周期 (计数): 边沿对齐ARR+1, 中心对齐2*ARR
+ */
+uint32_t CMix_Emu_TIM_Get_Period(void)
+{
+    uint32_t arr = CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, ARR) & 0xFFFF;
+
+    return (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_CMS) ? 2U * arr : arr + 1U;
+}
+
+/**
+ * @brief 距下一更新事件的计数 (不足一个计数按一个计)
+ * @param None
+ * @retval 计数, 计数器未运行时返回0
+ */
+uint32_t CMix_Emu_TIM_Counts_To_Update(void)
+{
+    uint32_t tick = CMix_Emu_TIM_Tick();
+    uint32_t counts;
+
+    if (g_tim.next_overflow == CMIX_EMU_NEVER) {
+        return 0;
+    }
+    counts = (uint32_t)((g_tim.next_overflow - CMix_Emu_Cycle() + tick - 1) / tick);
+    if ((CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_CMS) && !CMix_Emu_TIM_Is_Update(!g_tim.down)) {
+        counts += CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, ARR) & 0xFFFF;
+    }
+    return counts;
+}
+
+uint32_t CMix_Emu_TIM_Update_Count(void)
+{
+    return g_tim.updates;
+}
+
+/**
+ * @brief PWM输出是否有效 (计数器使能且未刹车)
+ * @param None
+ * @retval true=输出有效
+ */
+bool CMix_Emu_TIM_Output_Enabled(void)
+{
+    return (CMIX_EMU_REG(TIM1_BASE, TIM_TypeDef, CR) & TIM_CR_EN) && !g_tim.break_active;
+}
+
+/**
+ * @brief 刹车触发时刻
+ * @param None
+ * @retval 周期, 未触发时返回CMIX_EMU_NEVER
+ */
+uint64_t CMix_Emu_TIM_Break_Cycle(void)
+{
+    return g_tim.break_active ? g_tim.break_cycle : CMIX_EMU_NEVER;
+}
+
+/* ========================= ADC0 ========================= */
+
+static void CMix_Emu_ADC_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    volatile uint32_t *reg = CMix_Emu_Reg(ADC0_BASE + offset);
+    uint64_t now = CMix_Emu_Cycle();
+
+    switch (offset) {
+    case offsetof(ADC_TypeDef, CR1):
+        if ((value & ADC_CR1_EN) && !(old_value & ADC_CR1_EN)) {
+            CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) |= ADC_SR_RDY;
+        } else if (!(value & ADC_CR1_EN)) {
+            CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) &= ~ADC_SR_RDY;
+            g_adc.regular_done = CMIX_EMU_NEVER;
+            g_adc.injected_done = CMIX_EMU_NEVER;
+        }
+        if ((value & ADC_CR1_EN) && (value & ADC_CR1_SOC)) {
+            CMix_Emu_ADC_Start(now, (CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR3) & ADC_CR3_SCANE) != 0);
+        }
+        if ((value & ADC_CR1_EN) && (value & ADC_CR1_JSOC)) {
+            CMix_Emu_ADC_Start_Injected(now);
+        }
+        *reg &= ~(ADC_CR1_SOC | ADC_CR1_JSOC);
+        CMix_Emu_Schedule_Changed();
+        break;
+    case offsetof(ADC_TypeDef, SR):
+        /* 写1清零, RDY只读 */
+        *reg = (old_value & ~value & ~ADC_SR_RDY) | (old_value & ADC_SR_RDY);
+        break;
+    default:
+        break;
+    }
+}
+
+static uint32_t CMix_Emu_ADC_Conversion_Cycles(void)
+{
+    uint32_t cfgr3 = CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CFGR3);
+    uint32_t psc = (cfgr3 & ADC_CFGR3_PSC) + 1U;
+    uint32_t setup = (cfgr3 & ADC_CFGR3_SETUP) >> 16;
+    uint32_t smp = (cfgr3 & ADC_CFGR3_SMP) >> 24;
+
+    return psc * (setup + smp + CMIX_EMU_ADC_FIXED_CLOCKS) * (CMix_Emu_Core_Clock() / CMix_Emu_Periph_Clock());
+}
+
+/**
+ * @brief 启动规则组转换
+ * @param cycle: 触发时刻
+ * @param scan: true=扫描全部规则通道, false=转换CFGR2选择的单通道
+ * @retval None
+ */
+static void CMix_Emu_ADC_Start(uint64_t cycle, bool scan)
+{
+    uint32_t count = scan ? ((CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR3) & ADC_CR3_SCNT) >> 16) + 1U : 1U;
+
+    if (g_adc.regular_done != CMIX_EMU_NEVER) {
+        g_adc.overruns++;
+        return;
+    }
+    /* 注入组转换进行中: 规则组等待其结束 */
+    if (g_adc.injected_done != CMIX_EMU_NEVER && g_adc.injected_done > cycle) {
+        cycle = g_adc.injected_done;
+    }
+    g_adc.regular_scan = scan ? 1 : 0;
+    g_adc.regular_done = cycle + (uint64_t)count * CMix_Emu_ADC_Conversion_Cycles();
+    CMix_Emu_Schedule_Changed();
+}
+
+/**
+ * @brief 启动注入组转换 (扫描JSCNT+1个通道)
+ * @param cycle: 触发时刻
+ * @retval None
+ */
+static void CMix_Emu_ADC_Start_Injected(uint64_t cycle)
+{
+    uint32_t count = ((CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR3) & ADC_CR3_JSCNT) >> 24) + 1U;
+
+    if (g_adc.injected_done != CMIX_EMU_NEVER) {
+        g_adc.overruns++;
+        return;
+    }
+    g_adc.injected_done = cycle + (uint64_t)count * CMix_Emu_ADC_Conversion_Cycles();
+    CMix_Emu_Schedule_Changed();
+}
+
+static uint16_t CMix_Emu_ADC_Sample(uint8_t channel, uint64_t cycle)
+{
+    channel &= CMIX_EMU_ADC_CHANNELS - 1U;
+    if (g_adc.source != NULL) {
+        return (uint16_t)(g_adc.source(g_adc.source_context, channel, cycle) & 0x0FFF);
+    }
+    return g_adc.value[channel];
+}
+
+/**
+ * @brief 模拟看门狗: 被监视通道的转换值在窗口 [LT, HT] 之外时置位AWD并记录通道号
+ * @param channel: 通道号
+ * @param sample: 转换值
+ * @retval None
+ */
+static void CMix_Emu_ADC_Watchdog(uint8_t channel, uint16_t sample)
+{
+    uint32_t awdcr = CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, AWDCR);
+    uint32_t awdtr = CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, AWDTR);
+
+    if (!(awdcr & ADC_AWDCR_AWDE)) {
+        return;
+    }
+    if ((awdcr & ADC_AWDCR_CHC) && channel != (uint8_t)((awdcr & ADC_AWDCR_CHS) >> 16)) {
+        return;
+    }
+    if (sample < (awdtr & ADC_AWDTR_LT) || sample > (awdtr >> 16)) {
+        CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) =
+            (CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) & ~ADC_SR_AWDCH) | ADC_SR_AWD | ((uint32_t)channel << 16);
+        g_adc.watchdog_events++;
+    }
+}
+
+/**
+ * @brief 规则组转换结束: 写结果寄存器, 逐次发出DMA请求
+ * @param cycle: 结束时刻
+ * @retval None
+ */
+static void CMix_Emu_ADC_Regular_Done(uint64_t cycle)
+{
+    uint32_t cr2 = CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR2);
+    uint32_t count, i;
+
+    g_adc.regular_done = CMIX_EMU_NEVER;
+
+    if (g_adc.regular_scan) {
+        count = ((CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR3) & ADC_CR3_SCNT) >> 16) + 1U;
+        for (i = 0; i < count; i++) {
+            uint32_t schr = *CMix_Emu_Reg(ADC0_BASE + offsetof(ADC_TypeDef, SCHR) + 4U * (i / 4U));
+            uint8_t channel = (uint8_t)((schr >> ((i % 4U) * 8U)) & 0x3F);
+            uint16_t sample = CMix_Emu_ADC_Sample(channel, cycle);
+
+            g_adc.channel_conversions[channel & (CMIX_EMU_ADC_CHANNELS - 1U)]++;
+            CMix_Emu_ADC_Watchdog(channel, sample);
+            *CMix_Emu_Reg(ADC0_BASE + offsetof(ADC_TypeDef, SCHDR) + 4U * i) = sample;
+            CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, DR) = sample;
+            if (cr2 & ADC_CR2_DMAE) {
+                CMix_Emu_DMA_Request(CMIX_EMU_DMA_CH_ADC0, cycle);
+            }
+        }
+        CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) |= ADC_SR_EOC | ADC_SR_EOS;
+        g_adc.scans++;
+    } else {
+        uint8_t channel = (uint8_t)((CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CFGR2) & ADC_CFGR2_CHS) >> 16);
+        uint16_t sample = CMix_Emu_ADC_Sample(channel, cycle);
+
+        g_adc.channel_conversions[channel & (CMIX_EMU_ADC_CHANNELS - 1U)]++;
+        CMix_Emu_ADC_Watchdog(channel, sample);
+        CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, DR) = sample;
+        CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) |= ADC_SR_EOC;
+        if (cr2 & ADC_CR2_DMAE) {
+            CMix_Emu_DMA_Request(CMIX_EMU_DMA_CH_ADC0, cycle);
+        }
+    }
+    CMix_Emu_IRQ_Touch(ADC0_IRQn, cycle);
+}
+
+static void CMix_Emu_ADC_Injected_Done(uint64_t cycle)
+{
+    uint32_t count = ((CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, CR3) & ADC_CR3_JSCNT) >> 24) + 1U;
+    uint32_t i;
+
+    g_adc.injected_done = CMIX_EMU_NEVER;
+    for (i = 0; i < count; i++) {
+        uint32_t jschr = *CMix_Emu_Reg(ADC0_BASE + offsetof(ADC_TypeDef, JSCHR) + 4U * (i / 4U));
+        uint8_t channel = (uint8_t)((jschr >> ((i % 4U) * 8U)) & 0x3F);
+        uint16_t sample = CMix_Emu_ADC_Sample(channel, cycle);
+
+        g_adc.channel_conversions[channel & (CMIX_EMU_ADC_CHANNELS - 1U)]++;
+        CMix_Emu_ADC_Watchdog(channel, sample);
+        *CMix_Emu_Reg(ADC0_BASE + offsetof(ADC_TypeDef, JSCHDR) + 4U * i) = sample;
+    }
+    CMIX_EMU_REG(ADC0_BASE, ADC_TypeDef, SR) |= ADC_SR_JEOC | ADC_SR_JEOS;
+    g_adc.injected_scans++;
+    CMix_Emu_IRQ_Touch(ADC0_IRQn, cycle);
+}
+
+void CMix_Emu_ADC_Set_Channel(uint8_t channel, uint16_t value)
+{
+    g_adc.value[channel & (CMIX_EMU_ADC_CHANNELS - 1U)] = value & 0x0FFF;
+}
+
+void CMix_Emu_ADC_Set_Source(CMix_Emu_ADC_Source_t source, void *context)
+{
+    g_adc.source = source;
+    g_adc.source_context = context;
+}
+
+uint32_t CMix_Emu_ADC_Scan_Count(void)
+{
+    return g_adc.scans;
+}
+
+uint32_t CMix_Emu_ADC_Overrun_Count(void)
+{
+    return g_adc.overruns;
+}
+
+uint32_t CMix_Emu_ADC_Injected_Scan_Count(void)
+{
+    return g_adc.injected_scans;
+}
+
+uint32_t CMix_Emu_ADC_Channel_Count(uint8_t channel)
+{
+    return g_adc.channel_conversions[channel & (CMIX_EMU_ADC_CHANNELS - 1U)];
+}
+
+uint32_t CMix_Emu_ADC_Watchdog_Count(void)
+{
+    return g_adc.watchdog_events;
+}
+
+/* ========================= DMA0 ========================= */
+
+static void CMix_Emu_DMA_Channel_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    uint8_t ch = (uint8_t)(offset / 0x20U);
+    uint32_t base = CMIX_EMU_DMA_CH_BASE(ch);
+    uint32_t count;
+
+    if (offset % 0x20U != offsetof(DMA_Channel_TypeDef, CCR)) {
+        return;
+    }
+
+    if ((value & DMA_CCR_EN) && !(old_value & DMA_CCR_EN)) {
+        count = CMIX_EMU_REG(base, DMA_Channel_TypeDef, CNDTR) & 0xFFFF;
+        g_dma.index[ch] = 0;
+        CMIX_EMU_REG(base, DMA_Channel_TypeDef, CCNTR) = count;
+        CMIX_EMU_REG(base, DMA_Channel_TypeDef, CCSAR) = CMIX_EMU_REG(base, DMA_Channel_TypeDef, CSBAR);
+        CMIX_EMU_REG(base, DMA_Channel_TypeDef, CCDAR) = CMIX_EMU_REG(base, DMA_Channel_TypeDef, CDBAR);
+        if ((value & DMA_CCR_DIR) == DMA_Direction_MemoryToMemory) {
+            g_dma.m2m_done[ch] = CMix_Emu_Cycle() + (uint64_t)count * CMIX_EMU_DMA_M2M_CYCLES;
+            CMix_Emu_Schedule_Changed();
+        }
+    } else if (!(value & DMA_CCR_EN)) {
+        g_dma.m2m_done[ch] = CMIX_EMU_NEVER;
+    }
+}
+
+static void CMix_Emu_DMA_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    if (offset == offsetof(DMA_TypeDef, SR)) {
+        /* 写1清零 */
+        CMIX_EMU_REG(DMA0_BASE, DMA_TypeDef, SR) = old_value & ~value;
+    }
+}
+
+/**
+ * @brief 外设DMA请求: 选择该外设且已使能的通道搬运一个数据
+ * @param peripheral: CHAPCR外设选择值
+ * @param cycle: 请求时刻
+ * @retval None
+ */
+static void CMix_Emu_DMA_Request(uint32_t peripheral, uint64_t cycle)
+{
+    uint8_t ch;
+
+    for (ch = 0; ch < CMIX_EMU_DMA_CHANNELS; ch++) {
+        uint32_t chapcr = *CMix_Emu_Reg(DMA0_BASE + offsetof(DMA_TypeDef, CHAPCR) + 4U * (ch / 4U));
+        uint32_t ccr = CMIX_EMU_REG(CMIX_EMU_DMA_CH_BASE(ch), DMA_Channel_TypeDef, CCR);
+
+        if (((chapcr >> ((ch % 4U) * 8U)) & 0x3F) == peripheral && (ccr & DMA_CCR_EN) &&
+            (ccr & DMA_CCR_DIR) != DMA_Direction_MemoryToMemory) {
+            CMix_Emu_DMA_Transfer(ch, cycle);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 搬运一个数据并更新计数和标志
+ * @param ch: 通道号
+ * @param cycle: 搬运时刻
+ * @retval None
+ * @note  寄存器窗口内的地址经总线读写 (带外设副作用), 其余按主机地址访问
+ */
+static void CMix_Emu_DMA_Transfer(uint8_t ch, uint64_t cycle)
+{
+    uint32_t base = CMIX_EMU_DMA_CH_BASE(ch);
+    uint32_t ccr = CMIX_EMU_REG(base, DMA_Channel_TypeDef, CCR);
+    uint32_t count = CMIX_EMU_REG(base, DMA_Channel_TypeDef, CNDTR) & 0xFFFF;
+    uint32_t ssize = 1U << ((ccr & DMA_CCR_SSIZE) >> 3);
+    uint32_t dsize = 1U << ((ccr & DMA_CCR_DSIZE) >> 8);
+    uint32_t index = g_dma.index[ch];
+    uint32_t source = CMIX_EMU_REG(base, DMA_Channel_TypeDef, CSBAR) + ((ccr & DMA_CCR_SINC) ? index * ssize : 0U);
+    uint32_t destination = CMIX_EMU_REG(base, DMA_Channel_TypeDef, CDBAR) + ((ccr & DMA_CCR_DINC) ? index * dsize : 0U);
+    uint32_t data = 0;
+    uint32_t flags = 0;
+
+    if (count == 0 || index >= count) {
+        return;
+    }
+
+    if (CMix_Emu_Is_Register(source)) {
+        data = CMix_Emu_Bus_Read(source);
+    } else {
+        memcpy(&data, (const void *)(uintptr_t)source, ssize);
+    }
+    if (CMix_Emu_Is_Register(destination)) {
+        CMix_Emu_Bus_Write(destination, data & (dsize == 4U ? 0xFFFFFFFFU : ((1U << (dsize * 8U)) - 1U)));
+    } else {
+        memcpy((void *)(uintptr_t)destination, &data, dsize);
+    }
+
+    index++;
+    CMIX_EMU_REG(base, DMA_Channel_TypeDef, CCSAR) = source;
+    CMIX_EMU_REG(base, DMA_Channel_TypeDef, CCDAR) = destination;
+    if (index == count / 2U) {
+        flags |= DMA_SR_TH0F << ch;
+    }
+    if (index == count) {
+        flags |= DMA_SR_TC0F << ch;
+        if (ccr & DMA_CCR_CIRC) {
+            index = 0;
+        }
+    }
+    g_dma.index[ch] = index;
+    CMIX_EMU_REG(base, DMA_Channel_TypeDef, CCNTR) = count - index;
+
+    if (flags != 0) {
+        CMIX_EMU_REG(DMA0_BASE, DMA_TypeDef, SR) |= flags;
+        CMix_Emu_IRQ_Touch(DMA_IRQn, cycle);
+    }
+}
+
+/* ========================= CRC ========================= */
+
+static void CMix_Emu_CRC_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    uint32_t cr = CMIX_EMU_REG(CRC_BASE, CRC_TypeDef, CR);
+    uint16_t out;
+
+    (void)old_value;
+
+    switch (offset) {
+    case offsetof(CRC_TypeDef, CR):
+        if (value & CRC_CR_RST) {
+            g_crc.crc = (uint16_t)CMIX_EMU_REG(CRC_BASE, CRC_TypeDef, SEEDR);
+            CMIX_EMU_REG(CRC_BASE, CRC_TypeDef, CR) = value & ~CRC_CR_RST;
+        }
+        break;
+    case offsetof(CRC_TypeDef, DINR):
+        if (!(cr & CRC_CR_EN)) {
+            return;
+        }
+        if (cr & CRC_CR_INS) {
+            uint32_t half = value & 0xFFFF;
+            if (cr & CRC_CR_IBYTER) {
+                half = ((half & 0xFF) << 8) | (half >> 8);
+            }
+            CMix_Emu_CRC_Feed(half >> 8, 8);
+            CMix_Emu_CRC_Feed(half & 0xFF, 8);
+        } else {
+            CMix_Emu_CRC_Feed(value & 0xFF, 8);
+        }
+        break;
+    default:
+        return;
+    }
+
+    /* 输出位反转 */
+    out = g_crc.crc;
+    if (CMIX_EMU_REG(CRC_BASE, CRC_TypeDef, CR) & CRC_CR_OBITR) {
+        uint16_t reversed = 0;
+        uint8_t i;
+        for (i = 0; i < 16; i++) {
+            reversed = (uint16_t)((reversed << 1) | ((out >> i) & 1U));
+        }
+        out = reversed;
+    }
+    CMIX_EMU_REG(CRC_BASE, CRC_TypeDef, DOUTR) = out;
+}
+
+/**
+ * @brief CRC移位 (高位先入, IBITR时每字节先位反转)
+ * @param data: 输入字节
+ * @param bits: 位数
+ * @retval None
+ */
+static void CMix_Emu_CRC_Feed(uint32_t data, uint8_t bits)
+{
+    uint16_t poly = (uint16_t)CMIX_EMU_REG(CRC_BASE, CRC_TypeDef, POLYR);
+    uint8_t i;
+
+    if (CMIX_EMU_REG(CRC_BASE, CRC_TypeDef, CR) & CRC_CR_IBITR) {
+        uint32_t reversed = 0;
+        for (i = 0; i < bits; i++) {
+            reversed = (reversed << 1) | ((data >> i) & 1U);
+        }
+        data = reversed;
+    }
+
+    for (i = 0; i < bits; i++) {
+        uint16_t bit = (uint16_t)((data >> (bits - 1U - i)) & 1U);
+        if (((g_crc.crc >> 15) ^ bit) & 1U) {
+            g_crc.crc = (uint16_t)((g_crc.crc << 1) ^ poly);
+        } else {
+            g_crc.crc = (uint16_t)(g_crc.crc << 1);
+        }
+    }
+}
+
+/* ========================= UART0 ========================= */
+
+uint32_t CMix_Emu_UART_Byte_Cycles(void)
+{
+    uint32_t brr = CMIX_EMU_REG(UART0_BASE, UART_TypeDef, BRR);
+    uint32_t divider = (brr & 0xFFFF) << ((brr & 0x70000) >> 16);
+
+    if (divider == 0) {
+        divider = 1;
+    }
+    return 10U * divider * (CMix_Emu_Core_Clock() / CMix_Emu_Periph_Clock());
+}
+
+static void CMix_Emu_UART_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    volatile uint32_t *sr = CMix_Emu_Reg(UART0_BASE + offsetof(UART_TypeDef, SR));
+
+    switch (offset) {
+    case offsetof(UART_TypeDef, DR):
+        /* 数据寄存器读出的是接收数据 */
+        CMIX_EMU_REG(UART0_BASE, UART_TypeDef, DR) = g_uart.rx_data;
+        if (!(CMIX_EMU_REG(UART0_BASE, UART_TypeDef, CR) & UART_CR_EN)) {
+            return;
+        }
+        if (!g_uart.tx_shift_busy) {
+            g_uart.tx_shift = (uint8_t)value;
+            g_uart.tx_shift_busy = 1;
+            g_uart.tx_done = CMix_Emu_Cycle() + CMix_Emu_UART_Byte_Cycles();
+            *sr &= ~UART_SR_TXC;
+            CMix_Emu_Schedule_Changed();
+        } else if (!g_uart.tx_hold_valid) {
+            g_uart.tx_hold = (uint8_t)value;
+            g_uart.tx_hold_valid = 1;
+            *sr &= ~UART_SR_TXE;
+        }
+        break;
+    case offsetof(UART_TypeDef, SR):
+        /* 写1清零, TXE由发送状态决定 */
+        *sr = (old_value & ~(value & ~UART_SR_TXE)) | (old_value & UART_SR_TXE);
+        break;
+    case offsetof(UART_TypeDef, CR):
+        if ((value & UART_CR_RE) && g_uart.rx_head != g_uart.rx_tail && g_uart.rx_next == CMIX_EMU_NEVER) {
+            g_uart.rx_next = CMix_Emu_Cycle() + CMix_Emu_UART_Byte_Cycles();
+            CMix_Emu_Schedule_Changed();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void CMix_Emu_UART_After_Read(uint32_t offset)
+{
+    if (offset == offsetof(UART_TypeDef, DR)) {
+        CMIX_EMU_REG(UART0_BASE, UART_TypeDef, SR) &= ~UART_SR_RXNE;
+    }
+}
+
+static void CMix_Emu_UART_TX_Done(uint64_t cycle)
+{
+    volatile uint32_t *sr = CMix_Emu_Reg(UART0_BASE + offsetof(UART_TypeDef, SR));
+    uint8_t byte = g_uart.tx_shift;
+
+    if (g_uart.tx_hold_valid) {
+        g_uart.tx_shift = g_uart.tx_hold;
+        g_uart.tx_hold_valid = 0;
+        g_uart.tx_done = cycle + CMix_Emu_UART_Byte_Cycles();
+        *sr |= UART_SR_TXE;
+    } else {
+        g_uart.tx_shift_busy = 0;
+        g_uart.tx_done = CMIX_EMU_NEVER;
+        *sr |= UART_SR_TXC;
+    }
+    CMix_Emu_IRQ_Touch(UART0_IRQn, cycle);
+
+    if (g_uart.out_fd >= 0) {
+        g_uart.out_buffer[g_uart.out_length++] = byte;
+        if (g_uart.out_length == CMIX_EMU_UART_OUT_SIZE) {
+            CMix_Emu_UART_Flush();
+        }
+    }
+    if (g_uart.tx_hook != NULL) {
+        g_uart.tx_hook(g_uart.tx_hook_context, byte, cycle);
+    }
+}
+
+static void CMix_Emu_UART_RX_Arrive(uint64_t cycle)
+{
+    volatile uint32_t *sr = CMix_Emu_Reg(UART0_BASE + offsetof(UART_TypeDef, SR));
+    uint32_t cr = CMIX_EMU_REG(UART0_BASE, UART_TypeDef, CR);
+    uint8_t byte = g_uart.rx_queue[g_uart.rx_tail % CMIX_EMU_UART_RX_SIZE];
+
+    g_uart.rx_tail++;
+    g_uart.rx_last = cycle;
+
+    if ((cr & UART_CR_EN) && (cr & UART_CR_RE)) {
+        if (*sr & UART_SR_RXNE) {
+            *sr |= UART_SR_OVR;
+            g_uart.rx_overruns++;
+        } else {
+            g_uart.rx_data = byte;
+            CMIX_EMU_REG(UART0_BASE, UART_TypeDef, DR) = byte;
+            *sr |= UART_SR_RXNE;
+        }
+        CMix_Emu_IRQ_Touch(UART0_IRQn, cycle);
+    }
+
+    g_uart.rx_next = (g_uart.rx_tail != g_uart.rx_head) ? cycle + CMix_Emu_UART_Byte_Cycles() : CMIX_EMU_NEVER;
+}
+
+static void CMix_Emu_UART_Flush(void)
+{
+    uint32_t written = 0;
+
+    while (written < g_uart.out_length) {
+        ssize_t n = write(g_uart.out_fd, g_uart.out_buffer + written, g_uart.out_length - written);
+        if (n <= 0) {
+            break;
+        }
+        written += (uint32_t)n;
+    }
+    g_uart.out_length = 0;
+}
+
+/**
+ * @brief 注入接收数据, 按线路速率逐字节到达
+ * @param data: 数据
+ * @param length: 长度
+ * @retval None
+ */
+void CMix_Emu_UART_Inject(const uint8_t *data, uint16_t length)
+{
+    uint16_t i;
+
+    for (i = 0; i < length && g_uart.rx_head - g_uart.rx_tail < CMIX_EMU_UART_RX_SIZE; i++) {
+        g_uart.rx_queue[g_uart.rx_head % CMIX_EMU_UART_RX_SIZE] = data[i];
+        g_uart.rx_head++;
+    }
+    if (g_uart.rx_next == CMIX_EMU_NEVER && g_uart.rx_head != g_uart.rx_tail) {
+        g_uart.rx_next = CMix_Emu_Cycle() + CMix_Emu_UART_Byte_Cycles();
+        CMix_Emu_Schedule_Changed();
+    }
+}
+
+uint32_t CMix_Emu_UART_RX_Pending(void)
+{
+    return g_uart.rx_head - g_uart.rx_tail;
+}
+
+uint64_t CMix_Emu_UART_RX_Last_Cycle(void)
+{
+    return g_uart.rx_last;
+}
+
+uint32_t CMix_Emu_UART_RX_Overrun_Count(void)
+{
+    return g_uart.rx_overruns;
+}
+
+void CMix_Emu_UART_Set_TX_Hook(CMix_Emu_UART_Hook_t hook, void *context)
+{
+    g_uart.tx_hook = hook;
+    g_uart.tx_hook_context = context;
+}
+
+/**
+ * @brief 设置发送数据输出文件 (-1关闭), 切换前写出缓存
+ * @param fd: 文件描述符
+ * @retval None
+ */
+void CMix_Emu_UART_Set_Output(int fd)
+{
+    if (g_uart.out_fd >= 0) {
+        CMix_Emu_UART_Flush();
+    }
+    g_uart.out_fd = fd;
+}
+
+/* ========================= CMP0/CMP1 ========================= */
+
+static void CMix_Emu_CMP0_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    CMix_Emu_CMP_Write(0, offset, old_value, value);
+}
+
+static void CMix_Emu_CMP1_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    CMix_Emu_CMP_Write(1, offset, old_value, value);
+}
+
+static void CMix_Emu_CMP_Write(uint8_t unit, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    uint32_t base = unit ? CMP1_BASE : CMP0_BASE;
+
+    if (offset == offsetof(CMP_TypeDef, SR)) {
+        /* 写1清零, 输出状态只读 */
+        CMIX_EMU_REG(base, CMP_TypeDef, SR) = (old_value & ~value & ~CMP_SR_CRS) | (old_value & CMP_SR_CRS);
+    } else if (offset == offsetof(CMP_TypeDef, CR1)) {
+        CMix_Emu_CMP_Evaluate(unit, CMix_Emu_Cycle());
+    }
+}
+
+/**
+ * @brief LDAC写入: 阈值变化后重新评估两路比较器
+ */
+static void CMix_Emu_LDAC_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    uint64_t now = CMix_Emu_Cycle();
+
+    (void)offset;
+    (void)old_value;
+    (void)value;
+    CMix_Emu_CMP_Evaluate(0, now);
+    CMix_Emu_CMP_Evaluate(1, now);
+}
+
+/**
+ * @brief 比较器输入评估: 比较结果与当前输出不同时启动数字滤波
+ * @param unit: 比较器 (0=CMP0, 1=CMP1)
+ * @param cycle: 当前时刻
+ * @retval None
+ * @note  滤波期间结果回到原电平则取消, 与逐采样计数的滤波器一致
+ */
+static void CMix_Emu_CMP_Evaluate(uint8_t unit, uint64_t cycle)
+{
+    uint32_t base = unit ? CMP1_BASE : CMP0_BASE;
+    uint32_t cr1 = CMIX_EMU_REG(base, CMP_TypeDef, CR1);
+    uint32_t dfc = (cr1 & CMP_CR1_DFC) >> 8;
+    uint32_t ckd = (CMIX_EMU_REG(base, CMP_TypeDef, CR2) & CMP_CR2_CKD) >> 24;
+    uint32_t reference;
+    uint8_t result;
+
+    if (!(cr1 & CMP_CR1_EN)) {
+        g_cmp.settle[unit] = CMIX_EMU_NEVER;
+        return;
+    }
+    switch (cr1 & CMP_CR1_CNS) {
+    case CMIX_EMU_CMP_CNS_LDAC:
+        reference = (CMIX_EMU_REG(LDAC0_BASE, LDAC_TypeDef, CR) & LDAC_CR_EN) ?
+                    CMIX_EMU_VDDA_MV * (CMIX_EMU_REG(LDAC0_BASE, LDAC_TypeDef, DR) & LDAC_DR_DATA) /
+                    CMIX_EMU_LDAC_STEPS : 0;
+        break;
+    case CMIX_EMU_CMP_CNS_BG1V0:
+        reference = CMIX_EMU_CMP_BG_MV;
+        break;
+    default:
+        reference = CMIX_EMU_VDDA_MV;           // 外部负端未建模, 视为不越限
+        break;
+    }
+    result = (g_cmp.input_mv[unit] > reference) ? 1 : 0;
+    if (cr1 & CMP_CR1_OPC) {
+        result ^= 1;
+    }
+
+    if (result == g_cmp.level[unit]) {
+        g_cmp.settle[unit] = CMIX_EMU_NEVER;
+        return;
+    }
+    if (g_cmp.settle[unit] != CMIX_EMU_NEVER && g_cmp.pending[unit] == result) {
+        return;
+    }
+    g_cmp.pending[unit] = result;
+    g_cmp.settle[unit] = cycle + (uint64_t)(dfc ? (2U << dfc) : 0) * (ckd + 1U) *
+                                 (CMix_Emu_Core_Clock() / CMix_Emu_Periph_Clock());
+    if (g_cmp.settle[unit] == cycle) {
+        CMix_Emu_CMP_Output(unit, cycle);
+    } else {
+        CMix_Emu_Schedule_Changed();
+    }
+}
+
+/**
+ * @brief 比较器输出翻转: 更新CRS, 置位边沿标志, 评估刹车
+ * @param unit: 比较器 (0=CMP0, 1=CMP1)
+ * @param cycle: 翻转时刻
+ * @retval None
+ */
+static void CMix_Emu_CMP_Output(uint8_t unit, uint64_t cycle)
+{
+    uint32_t base = unit ? CMP1_BASE : CMP0_BASE;
+
+    g_cmp.settle[unit] = CMIX_EMU_NEVER;
+    g_cmp.level[unit] = g_cmp.pending[unit];
+    if (g_cmp.level[unit]) {
+        CMIX_EMU_REG(base, CMP_TypeDef, SR) |= CMP_SR_CRS | CMP_SR_COR;
+    } else {
+        CMIX_EMU_REG(base, CMP_TypeDef, SR) = (CMIX_EMU_REG(base, CMP_TypeDef, SR) & ~CMP_SR_CRS) | CMP_SR_COF;
+    }
+    CMix_Emu_IRQ_Touch(unit ? CMP1_IRQn : CMP0_IRQn, cycle);
+    CMix_Emu_TIM_Evaluate_Break(cycle);
+}
+
+/**
+ * @brief 设置比较器正端电压
+ * @param unit: 比较器 (0=CMP0, 1=CMP1)
+ * @param input_mv: 引脚电压 (mV, 分压后)
+ * @retval None
+ */
+void CMix_Emu_CMP_Set_Input(uint8_t unit, uint32_t input_mv)
+{
+    if (unit > 1) {
+        return;
+    }
+    g_cmp.input_mv[unit] = input_mv;
+    CMix_Emu_CMP_Evaluate(unit, CMix_Emu_Cycle());
+}
+
+/* ========================= GPIO ========================= */
+
+static void CMix_Emu_GPIOA_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    CMix_Emu_GPIO_Write(0, offset, old_value, value);
+}
+
+static void CMix_Emu_GPIOB_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    CMix_Emu_GPIO_Write(1, offset, old_value, value);
+}
+
+static void CMix_Emu_GPIOA_Read(uint32_t offset)
+{
+    CMix_Emu_GPIO_Read(0, offset);
+}
+
+static void CMix_Emu_GPIOB_Read(uint32_t offset)
+{
+    CMix_Emu_GPIO_Read(1, offset);
+}
+
+/**
+ * @brief GPIO写: 置位/清零寄存器对作用于输出锁存或对应的状态寄存器
+ */
+static void CMix_Emu_GPIO_Write(uint8_t port, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    uint32_t base = port ? GPIOB_BASE : GPIOA_BASE;
+    volatile uint32_t *reg = CMix_Emu_Reg(base + offset);
+
+    switch (offset) {
+    case offsetof(GPIO_TypeDef, DR):
+        g_gpio.latch[port] = value;
+        break;
+    case offsetof(GPIO_TypeDef, BSR):
+        g_gpio.latch[port] |= value;
+        *reg = 0;
+        break;
+    case offsetof(GPIO_TypeDef, BRR):
+        g_gpio.latch[port] &= ~value;
+        *reg = 0;
+        break;
+    case offsetof(GPIO_TypeDef, OESR):
+    case offsetof(GPIO_TypeDef, PUSR):
+    case offsetof(GPIO_TypeDef, PDSR):
+    case offsetof(GPIO_TypeDef, ODSR):
+    case offsetof(GPIO_TypeDef, SCSR):
+        *reg = old_value | value;
+        break;
+    case offsetof(GPIO_TypeDef, OECR):
+    case offsetof(GPIO_TypeDef, PUCR):
+    case offsetof(GPIO_TypeDef, PDCR):
+    case offsetof(GPIO_TypeDef, ODCR):
+    case offsetof(GPIO_TypeDef, SCCR):
+        /* 清零寄存器位于对应置位寄存器之后 */
+        *CMix_Emu_Reg(base + offset - 4U) &= ~value;
+        *reg = 0;
+        break;
+    default:
+        break;
+    }
+    CMix_Emu_GPIO_Refresh(port);
+}
+
+static void CMix_Emu_GPIO_Read(uint8_t port, uint32_t offset)
+{
+    if (offset == offsetof(GPIO_TypeDef, DR)) {
+        CMix_Emu_GPIO_Refresh(port);
+    }
+}
+
+/**
+ * @brief 刷新数据寄存器: 输出引脚读锁存值, 输入引脚读外部电平
+ */
+static void CMix_Emu_GPIO_Refresh(uint8_t port)
+{
+    uint32_t base = port ? GPIOB_BASE : GPIOA_BASE;
+    uint32_t oe = CMIX_EMU_REG(base, GPIO_TypeDef, OESR);
+
+    CMIX_EMU_REG(base, GPIO_TypeDef, DR) = ((g_gpio.latch[port] & oe) | (g_gpio.input[port] & ~oe)) & 0xFFFF;
+}
+
+/**
+ * @brief 获取输出锁存值 (仅输出使能的引脚)
+ * @param port: 0=GPIOA, 1=GPIOB
+ * @retval 输出电平
+ */
+uint16_t CMix_Emu_GPIO_Get_Output(uint8_t port)
+{
+    uint32_t base = port ? GPIOB_BASE : GPIOA_BASE;
+
+    return (uint16_t)(g_gpio.latch[port & 1U] & CMIX_EMU_REG(base, GPIO_TypeDef, OESR));
+}
+
+void CMix_Emu_GPIO_Set_Input(uint8_t port, uint16_t pins, bool level)
+{
+    if (port > 1) {
+        return;
+    }
+    if (level) {
+        g_gpio.input[port] |= pins;
+    } else {
+        g_gpio.input[port] &= ~(uint32_t)pins;
+    }
+    CMix_Emu_GPIO_Refresh(port);
+}
+
+/* ========================= IFMC ========================= */
+
+/**
+ * @brief IFMC写: 键寄存器状态机, AR写保护, CR2命令, SR1写1清零
+ */
+static void CMix_Emu_IFMC_Write(uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    volatile uint32_t *reg = CMix_Emu_Reg(IFMC_BASE + offset);
+
+    switch (offset) {
+    case offsetof(IFMC_TypeDef, KR1):
+        *reg = old_value;
+        if (value == CMIX_EMU_IFMC_KR1_UNLOCK) {
+            *reg = 0;
+        } else if (value == CMIX_EMU_IFMC_LOCK_KEY) {
+            *reg = IFMC_KR1_LOCK;
+            g_ifmc.ar_unlocked = 0;
+        } else if (value == CMIX_EMU_IFMC_KR1_MAINCODE && (old_value & IFMC_KR1_LOCK) == 0) {
+            g_ifmc.ar_unlocked = 1;
+        } else {
+            CMix_Emu_IFMC_Error(IFMC_SR1_KERR);
+        }
+        break;
+    case offsetof(IFMC_TypeDef, KR2):
+        *reg = old_value;
+        if (value == CMIX_EMU_IFMC_KR2_UNLOCK) {
+            *reg = old_value & ~IFMC_KR2_LOCK2;
+        } else if (value == CMIX_EMU_IFMC_LOCK_KEY) {
+            *reg = IFMC_KR2_LOCK1 | IFMC_KR2_LOCK2;
+        } else if (value == CMIX_EMU_IFMC_KR2_CR2_KEY && (old_value & IFMC_KR2_LOCK2) == 0) {
+            *reg = old_value & ~IFMC_KR2_LOCK1;
+        } else {
+            CMix_Emu_IFMC_Error(IFMC_SR1_KERR);
+        }
+        break;
+    case offsetof(IFMC_TypeDef, AR):
+        if (!g_ifmc.ar_unlocked) {
+            *reg = old_value;
+            CMix_Emu_IFMC_Error(IFMC_SR1_KERR);
+        }
+        break;
+    case offsetof(IFMC_TypeDef, CR2):
+        *reg = 0;
+        CMix_Emu_IFMC_Execute(value);
+        break;
+    case offsetof(IFMC_TypeDef, SR1):
+        *reg = old_value & ~value;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 执行CR2命令: 编程一个字或擦除一页, CPU停顿到操作完成
+ */
+static void CMix_Emu_IFMC_Execute(uint32_t command)
+{
+    uint32_t address = CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, AR);
+    uint8_t *flash = CMix_Emu_Flash(address);
+
+    if (CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, KR2) & IFMC_KR2_LOCK1) {
+        CMix_Emu_IFMC_Error(IFMC_SR1_KERR);
+        return;
+    }
+
+    if (command & IFMC_CR2_PG) {
+        uint32_t data = CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, DR1);
+        uint32_t word;
+
+        if (flash == NULL || (address & 3U) != 0) {
+            CMix_Emu_IFMC_Error(IFMC_SR1_AERR);
+            return;
+        }
+        memcpy(&word, flash, sizeof(word));
+        if (word != 0xFFFFFFFFU) {
+            g_ifmc.stats.overwrites++;
+        }
+        word &= data;
+        memcpy(flash, &word, sizeof(word));
+        if (CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, CR1) & IFMC_CR1_AINC) {
+            CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, AR) = address + 4U;
+        }
+        g_ifmc.stats.programs++;
+        CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, SR1) |= IFMC_SR1_WC;
+        CMix_Emu_Bus_Stall((uint32_t)CMix_Emu_us_To_Cycles(CMIX_EMU_IFMC_PROGRAM_US));
+    } else if (command & IFMC_CR2_PER) {
+        uint32_t page = address / CMIX_EMU_IFMC_PAGE_SIZE;
+
+        if (flash == NULL) {
+            CMix_Emu_IFMC_Error(IFMC_SR1_AERR);
+            return;
+        }
+        memset(CMix_Emu_Flash(page * CMIX_EMU_IFMC_PAGE_SIZE), 0xFF, CMIX_EMU_IFMC_PAGE_SIZE);
+        g_ifmc.page_erases[page]++;
+        g_ifmc.stats.erases++;
+        CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, SR1) |= IFMC_SR1_PEC;
+        CMix_Emu_Bus_Stall((uint32_t)CMix_Emu_us_To_Cycles(CMIX_EMU_IFMC_ERASE_US));
+    } else if (command != 0) {
+        /* 整片擦除会擦除固件本身, 不支持 */
+        CMix_Emu_IFMC_Error(IFMC_SR1_CERR);
+    }
+}
+
+static void CMix_Emu_IFMC_Error(uint32_t flag)
+{
+    CMIX_EMU_REG(IFMC_BASE, IFMC_TypeDef, SR1) |= flag;
+    g_ifmc.stats.errors++;
+}
+
+/**
+ * @brief 擦除Flash区域 (运行程序准备初始内容, 不计入擦除统计)
+ * @param address: 起始地址
+ * @param size: 字节数
+ * @retval None
+ * @note  Flash内容在CMix_Emu_Init之间保持, 由fork出的子进程共享
+ */
+void CMix_Emu_Flash_Erase(uint32_t address, uint32_t size)
+{
+    uint8_t *flash = CMix_Emu_Flash(address);
+
+    if (flash != NULL && CMix_Emu_Flash(address + size - 1U) != NULL) {
+        memset(flash, 0xFF, size);
+    }
+}
+
+uint32_t CMix_Emu_Flash_Read(uint32_t address)
+{
+    uint8_t *flash = CMix_Emu_Flash(address & ~3U);
+    uint32_t word = 0xFFFFFFFFU;
+
+    if (flash != NULL) {
+        memcpy(&word, flash, sizeof(word));
+    }
+    return word;
+}
+
+/**
+ * @brief 获取页擦除次数 (本次CMix_Emu_Init以来)
+ * @param address: 页内任意地址
+ * @retval 擦除次数
+ */
+uint32_t CMix_Emu_Flash_Erase_Count(uint32_t address)
+{
+    return (address - FLASH_BASE < CMIX_EMU_FLASH_SIZE) ? g_ifmc.page_erases[address / CMIX_EMU_IFMC_PAGE_SIZE] : 0;
+}
+
+void CMix_Emu_Flash_Get_Stats(CMix_Emu_Flash_Stats_t *stats)
+{
+    *stats = g_ifmc.stats;
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+  * @file    CMix_cosim.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix控制与功率级同步运行实现文件
+  ******************************************************************************
+  * @attention
+  *
+  * 相A = TIM1_CH1/CH1N, 相B = TIM1_CH2/CH2N; 比较值在下一周期生效 (预装载).
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_cosim.h"
+#include "CMix_plant_hw.h"
+#include "CMix_dcdc.h"
+#include "CMix_hardware.h"
+
+#include <string.h>
+#include <time.h>
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 初始化功率级与固件控制模块并使能DCDC
+ * @param cosim: 联合仿真上下文
+ * @param params: 功率级参数
+ * @param trace: 波形输出文件 (NULL = 不输出)
+ * @retval None
+ */
+void CMix_Cosim_Start(CMix_Cosim_t *cosim, const CMix_Plant_Params_t *params, FILE *trace)
+{
+    memset(cosim, 0, sizeof(*cosim));
+    cosim->fault_time_s = -1.0;
+    cosim->next_task_s = 1e-3;
+    cosim->trace = trace;
+    CMix_Plant_Init(&cosim->plant, params);
+
+    CMix_Plant_HW_Reset();
+    CMix_DCDC_Init();
+    CMix_DCDC_Enable(1);
+
+    if (trace != NULL) {
+        fprintf(trace, "time_s,vin,vout,il,ia,ib,compare1,compare2,state\n");
+    }
+}
+
+/**
+ * @brief 同步运行固件与功率级
+ * @param cosim: 联合仿真上下文
+ * @param duration_s: 运行时长
+ * @param metrics: 阶跃指标 (NULL = 不统计)
+ * @retval None
+ */
+void CMix_Cosim_Run(CMix_Cosim_t *cosim, double duration_s, CMix_Plant_Metrics_t *metrics)
+{
+    CMix_Plant_t *plant = &cosim->plant;
+    uint64_t periods = (uint64_t)(duration_s / plant->params.pwm_period_s + 0.5);
+    uint16_t raw[CMIX_PLANT_ADC_CHANNELS];
+    double host_start = CMix_Cosim_Host_Time();
+    uint64_t n;
+#if CMIX_CONTROL_ISR_ENABLE
+    uint8_t update;
+#endif
+
+    for (n = 0; n < periods; n++) {
+        CMix_Plant_Step(plant, CMix_Plant_HW_Get_Compare(1), CMix_Plant_HW_Get_Compare(2), CMIX_PWM_COMPARE_SCALE);
+        if (metrics != NULL) {
+            CMix_Plant_Metrics_Update(metrics, plant);
+        }
+
+        /* TIM1更新事件触发ADC扫描, 结果由DMA写入缓冲 */
+        CMix_Plant_Sample(plant, raw);
+        CMix_Plant_HW_Set_ADC(raw, CMIX_PLANT_ADC_CHANNELS);
+
+#if CMIX_CONTROL_ISR_ENABLE
+        /* 双更新: 峰点采样取同一周期结束值 (平均模型中两处电流相同) */
+        for (update = 0; update < CMIX_PWM_UPDATES_PER_PERIOD; update++) {
+            cosim->scans++;
+            if (cosim->scans % CMIX_CONTROL_DECIMATION == 0) {
+                CMix_Hardware_ADC_Conversion_Complete_Callback();
+                cosim->control_steps++;
+                if (cosim->trace != NULL) {
+                    fprintf(cosim->trace, "%.7f,%.4f,%.4f,%.4f,%.4f,%.4f,%u,%u,%u\n", plant->time_s, plant->vin,
+                            plant->vout, plant->il, plant->ia_avg, plant->ib_avg, CMix_Plant_HW_Get_Compare(1),
+                            CMix_Plant_HW_Get_Compare(2), (unsigned)CMix_DCDC_Get_Status()->state);
+                }
+            }
+        }
+#else
+        cosim->scans++;
+#endif
+
+        /* 1ms任务 */
+        if (plant->time_s >= cosim->next_task_s) {
+            cosim->next_task_s += 1e-3;
+            CMix_DCDC_Control_Task();
+            CMix_DCDC_State_Machine();
+            cosim->tasks++;
+#if !CMIX_CONTROL_ISR_ENABLE
+            cosim->control_steps++;
+#endif
+        }
+
+        if (cosim->fault_time_s < 0.0 && CMix_Plant_HW_Fault_LED()) {
+            cosim->fault_time_s = plant->time_s;
+        }
+    }
+
+    cosim->host_s += CMix_Cosim_Host_Time() - host_start;
+}
+
+/**
+ * @brief 主机单调时钟 (s)
+ * @param None
+ * @retval 时间 (s)
+ */
+double CMix_Cosim_Host_Time(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+  * @file    CMix_cosim.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix控制与功率级同步运行头文件
+  *          cmix_cosim场景和cmix_sweep参数扫描共用
+  ******************************************************************************
+  * @attention
+  *
+  * 同步方式 (与固件中断结构一致):
+  *   每个PWM周期: 功率级积分一个周期 -> 采样 -> 注入ADC扫描结果
+  *   每CMIX_CONTROL_DECIMATION次扫描: CMix_Hardware_ADC_Conversion_Complete_Callback()
+  *   每1ms: CMix_DCDC_Control_Task() + CMix_DCDC_State_Machine()
+  *
+  * 固件控制模块为单实例 (含函数内静态变量), 一个进程同时只能运行一个
+  * 联合仿真, 需要从初始状态开始时在子进程中运行.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_COSIM_H
+#define __CMIX_COSIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "CMix_plant.h"
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 联合仿真上下文 */
+typedef struct {
+    CMix_Plant_t plant;
+    double next_task_s;                     // 下一次1ms任务时刻
+    uint64_t scans;                         // ADC扫描次数
+    uint64_t control_steps;                 // 控制步次数
+    uint64_t tasks;                         // 1ms任务次数
+    double fault_time_s;                    // 故障LED点亮时刻 (-1 = 无)
+    double host_s;                          // 主机耗时
+    FILE *trace;                            // 每个控制步一行CSV (NULL = 不输出)
+} CMix_Cosim_t;
+
+/* ========================= 函数声明 ========================= */
+
+void CMix_Cosim_Start(CMix_Cosim_t *cosim, const CMix_Plant_Params_t *params, FILE *trace);
+void CMix_Cosim_Run(CMix_Cosim_t *cosim, double duration_s, CMix_Plant_Metrics_t *metrics);
+double CMix_Cosim_Host_Time(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_COSIM_H */
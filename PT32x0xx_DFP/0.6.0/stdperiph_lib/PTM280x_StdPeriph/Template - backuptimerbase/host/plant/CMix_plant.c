@@ -0,0 +1,526 @@
+/******************************************************************************
+  * @file    CMix_plant.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix功率级模型实现文件
+  *          半桥导通占比计算、显式中点积分、ADC采样换算、阶跃响应指标
+  ******************************************************************************
+  * @attention
+  *
+  * 状态方程 (fa/fb为相A/相B开关节点接高端的时间占比):
+  *   iin  = fa * iL                      Vin  = Vbat - Rbat * iin
+  *   iout = fb * iL                      Vout = (vc + ESR * (iout - Icc)) / (1 + ESR / Rload)
+  *   L  * diL/dt = fa * Vin - fb * Vout - DCR * iL
+  *   C  * dvc/dt = iout - Vout / Rload - Icc
+  *
+  * 两相交错 (两相电感电流iLa/iLb, 相B开关波形滞后phase_shift):
+  *   iin  = fa * iLa + fb * iLb          iout = iLa + iLb
+  *   L  * diLa/dt = fa * Vin - Vout - DCR * iLa
+  *   L  * diLb/dt = fb * Vin - Vout - DCR * iLb
+  *
+  * ADC换算使用CMix_config.h中的分压比、TP181A1参数和参考电压,
+  * 与固件CMix_DCDC_Convert_Voltage / CMix_Hardware_Convert_Current互逆.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_plant.h"
+#include "CMix_config.h"
+#include "PT32x0xx_config.h"            // HSI_VALUE
+
+#include <math.h>
+#include <string.h>
+
+/* ========================= 私有类型定义 ========================= */
+
+/* 端口量 (子步内开关占比不变) */
+typedef struct {
+    double iin;                             // 电池电流
+    double iout;                            // 流入输出节点的电流
+    double vin;                             // 输入端电压
+    double vout;                            // 输出端电压
+    double iload;                           // 负载电流
+} CMix_Plant_Ports_t;
+
+/* ========================= 私有函数声明 ========================= */
+
+static uint16_t CMix_Plant_Boundaries(double *bounds, uint16_t grid, double duty_a, double duty_b, double dead,
+                                      double shift);
+static double CMix_Plant_Overlap(double a0, double a1, double b0, double b1);
+static double CMix_Plant_High_Fraction(double duty, double dead, double u0, double u1, bool diode_high);
+static double CMix_Plant_Shifted_Fraction(double duty, double dead, double shift, double u0, double u1,
+                                          bool diode_high);
+static void CMix_Plant_Ports(const CMix_Plant_t *plant, double il, double il_b, double vc, double fa, double fb,
+                             CMix_Plant_Ports_t *ports);
+static void CMix_Plant_Derivative(const CMix_Plant_t *plant, double il, double il_b, double vc, double fa, double fb,
+                                  double *dil, double *dil_b, double *dvc);
+static uint16_t CMix_Plant_ADC_Code(CMix_Plant_t *plant, double volts_at_pin, double vref);
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 默认参数: 48V电池, 22uH/470uF, 4.8Ω负载, TIM1实际PWM频率
+ * @param params: 参数结构体
+ * @retval None
+ */
+void CMix_Plant_Default_Params(CMix_Plant_Params_t *params)
+{
+    memset(params, 0, sizeof(*params));
+    params->model = CMIX_PLANT_AVERAGED;
+    params->topology = CMIX_PWM_INTERLEAVE_ENABLE ? CMIX_PLANT_INTERLEAVED : CMIX_PLANT_FOUR_SWITCH;
+    params->substeps = 16;
+    params->pwm_period_s = (double)CMIX_PWM_PERIOD / (double)HSI_VALUE;    // TIM1: PSC=0, ARR=479
+    params->dead_time_s = 10.0 / (double)HSI_VALUE;                        // TIM_SetDeadTime(TIM1, 10)
+    params->inductance_h = 22e-6;
+    params->inductor_dcr_ohm = 0.010;
+    params->phase_shift = 0.5;
+    params->phase_b_duty_offset = 0.0;
+    params->capacitance_f = 470e-6;
+    params->capacitor_esr_ohm = 0.010;
+    params->battery_voltage = 48.0;
+    params->battery_resistance = 0.020;
+    params->load_resistance = 4.8;
+    params->load_current = 0.0;
+    params->initial_output_voltage = 0.0;
+    params->adc_noise_lsb = 0.0;
+    params->seed = 1;
+}
+
+/**
+ * @brief 初始化功率级状态
+ * @param plant: 功率级
+ * @param params: 参数
+ * @retval None
+ */
+void CMix_Plant_Init(CMix_Plant_t *plant, const CMix_Plant_Params_t *params)
+{
+    memset(plant, 0, sizeof(*plant));
+    plant->params = *params;
+    if (plant->params.substeps == 0) {
+        plant->params.substeps = 1;
+    } else if (plant->params.substeps > CMIX_PLANT_MAX_SUBSTEPS) {
+        plant->params.substeps = CMIX_PLANT_MAX_SUBSTEPS;
+    }
+    plant->vc = params->initial_output_voltage;
+    plant->vin = params->battery_voltage;
+    plant->vout = params->initial_output_voltage;
+    plant->vout_avg = plant->vout;
+    plant->vout_min = plant->vout;
+    plant->vout_max = plant->vout;
+    plant->noise_state = params->seed ? params->seed : 1;
+}
+
+/**
+ * @brief 仿真一个PWM周期
+ * @param plant: 功率级
+ * @param compare_a: 相A比较值 (TIM1->OCR[0])
+ * @param compare_b: 相B比较值 (TIM1->OCR[1]; 交错时为相B自身的导通计数, 相移由模型施加)
+ * @param period_counts: 周期计数 (ARR + 1)
+ * @retval None
+ */
+void CMix_Plant_Step(CMix_Plant_t *plant, uint16_t compare_a, uint16_t compare_b, uint16_t period_counts)
+{
+    const CMix_Plant_Params_t *p = &plant->params;
+    const bool interleaved = (p->topology == CMIX_PLANT_INTERLEAVED);
+    double bounds[CMIX_PLANT_MAX_SUBSTEPS + 12];
+    double period = p->pwm_period_s;
+    double duty_a = (double)compare_a / period_counts;
+    double duty_b = (double)compare_b / period_counts;
+    double shift = interleaved ? p->phase_shift - floor(p->phase_shift) : 0.0;
+    double dead = p->dead_time_s / period;
+    double ia_sum = 0.0, ib_sum = 0.0, vout_sum = 0.0;
+    uint16_t k, steps;
+
+    if (interleaved) {
+        duty_b += p->phase_b_duty_offset;
+    }
+    if (p->model == CMIX_PLANT_SWITCHING) {
+        steps = CMix_Plant_Boundaries(bounds, p->substeps, duty_a, duty_b, dead, shift);
+    } else {
+        bounds[0] = 0.0;
+        bounds[1] = 1.0;
+        steps = 1;
+    }
+
+    plant->vout_min = INFINITY;
+    plant->vout_max = -INFINITY;
+    plant->il_min = plant->il;
+    plant->il_max = plant->il;
+
+    for (k = 0; k < steps; k++) {
+        double u0 = bounds[k];
+        double u1 = bounds[k + 1];
+        double h = (u1 - u0) * period;
+        /* 死区内二极管: 四开关正向电流时相A下管、相B上管续流; 交错时各相按自身电流方向 */
+        double fa = CMix_Plant_High_Fraction(duty_a, dead, u0, u1, plant->il < 0.0) / (u1 - u0);
+        double fb = CMix_Plant_Shifted_Fraction(duty_b, dead, shift, u0, u1,
+                                                interleaved ? plant->il_b < 0.0 : plant->il > 0.0) / (u1 - u0);
+        double dil1, dilb1, dvc1, dil2, dilb2, dvc2;
+        double il_mid, ilb_mid, vc_mid, ic, ia, ib;
+        CMix_Plant_Ports_t ports;
+
+        /* 显式中点法 */
+        CMix_Plant_Derivative(plant, plant->il, plant->il_b, plant->vc, fa, fb, &dil1, &dilb1, &dvc1);
+        il_mid = plant->il + 0.5 * h * dil1;
+        ilb_mid = plant->il_b + 0.5 * h * dilb1;
+        vc_mid = plant->vc + 0.5 * h * dvc1;
+        CMix_Plant_Derivative(plant, il_mid, ilb_mid, vc_mid, fa, fb, &dil2, &dilb2, &dvc2);
+
+        /* 中点处的端口量用于能量统计 */
+        CMix_Plant_Ports(plant, il_mid, ilb_mid, vc_mid, fa, fb, &ports);
+        ic = ports.iout - ports.iload;
+        plant->energy_in_j += p->battery_voltage * ports.iin * h;
+        plant->energy_load_j += ports.vout * ports.iload * h;
+        plant->energy_loss_j += (p->battery_resistance * ports.iin * ports.iin +
+                                 p->inductor_dcr_ohm * (il_mid * il_mid + ilb_mid * ilb_mid) +
+                                 p->capacitor_esr_ohm * ic * ic) * h;
+
+        plant->il += h * dil2;
+        plant->il_b += h * dilb2;
+        plant->vc += h * dvc2;
+
+        /* 子步结束时的瞬时端电压 */
+        CMix_Plant_Ports(plant, plant->il, plant->il_b, plant->vc, fa, fb, &ports);
+        plant->vin = ports.vin;
+        plant->vout = ports.vout;
+
+        /* 电流采样量: 四开关为两个半桥的端口电流, 交错为两相电感电流 */
+        ia = interleaved ? plant->il : ports.iin;
+        ib = interleaved ? plant->il_b : ports.iout;
+        ia_sum += ia * (u1 - u0);
+        ib_sum += ib * (u1 - u0);
+        vout_sum += ports.vout * (u1 - u0);
+        if (ports.vout < plant->vout_min) plant->vout_min = ports.vout;
+        if (ports.vout > plant->vout_max) plant->vout_max = ports.vout;
+        if (plant->il < plant->il_min) plant->il_min = plant->il;
+        if (plant->il > plant->il_max) plant->il_max = plant->il;
+        if (fabs(plant->il) > plant->il_peak) plant->il_peak = fabs(plant->il);
+        if (fabs(plant->il_b) > plant->il_peak) plant->il_peak = fabs(plant->il_b);
+    }
+
+    plant->ia_avg = ia_sum;
+    plant->ib_avg = ib_sum;
+    plant->vout_avg = vout_sum;
+    plant->time_s += period;
+    plant->periods++;
+}
+
+/**
+ * @brief 生成ADC扫描结果 (按通道号索引, 与DMA缓冲布局一致)
+ * @param plant: 功率级
+ * @param raw: ADC原始值
+ * @retval None
+ */
+void CMix_Plant_Sample(CMix_Plant_t *plant, uint16_t raw[CMIX_PLANT_ADC_CHANNELS])
+{
+    const double divider = CMIX_VOLTAGE_SENSE_RATIO;
+    const double vref_voltage = CMIX_VOLTAGE_SENSE_VREF_MV / 1000.0;
+    const double sense = CMIX_CURRENT_SENSE_RS * CMIX_CURRENT_SENSE_GAIN;
+
+    raw[CMIX_ADC_VIN_CHANNEL] = CMix_Plant_ADC_Code(plant, plant->vin / divider, vref_voltage);
+    raw[CMIX_ADC_VOUT_CHANNEL] = CMix_Plant_ADC_Code(plant, plant->vout / divider, vref_voltage);
+    raw[CMIX_ADC_CURRENT_A_CHANNEL] = CMix_Plant_ADC_Code(plant, CMIX_CURRENT_SENSE_VREF + plant->ia_avg * sense,
+                                                          CMIX_ADC_VREF);
+    raw[CMIX_ADC_CURRENT_B_CHANNEL] = CMix_Plant_ADC_Code(plant, CMIX_CURRENT_SENSE_VREF + plant->ib_avg * sense,
+                                                          CMIX_ADC_VREF);
+}
+
+/**
+ * @brief 电感和电容储能
+ * @param plant: 功率级
+ * @retval 储能 (J)
+ */
+double CMix_Plant_Stored_Energy(const CMix_Plant_t *plant)
+{
+    return 0.5 * plant->params.inductance_h * (plant->il * plant->il + plant->il_b * plant->il_b) +
+           0.5 * plant->params.capacitance_f * plant->vc * plant->vc;
+}
+
+/**
+ * @brief 开始统计阶跃响应
+ * @param metrics: 指标
+ * @param t0: 阶跃时刻
+ * @param initial: 阶跃前值
+ * @param target: 目标值
+ * @param band: 稳定带 (相对阶跃幅度)
+ * @param ripple_start_s: 稳态统计开始时刻
+ * @retval None
+ */
+void CMix_Plant_Metrics_Start(CMix_Plant_Metrics_t *metrics, double t0, double initial, double target,
+                              double band, double ripple_start_s)
+{
+    memset(metrics, 0, sizeof(*metrics));
+    metrics->t0 = t0;
+    metrics->initial = initial;
+    metrics->target = target;
+    metrics->band = band;
+    metrics->ripple_start_s = ripple_start_s;
+    metrics->t10 = -1.0;
+    metrics->t90 = -1.0;
+    metrics->peak = initial;
+    metrics->last_outside = t0;
+    metrics->ripple_min = INFINITY;
+    metrics->ripple_max = -INFINITY;
+    metrics->finite = true;
+}
+
+/**
+ * @brief 每个PWM周期更新指标 (使用周期平均值判断上升/稳定, 周期极值统计纹波)
+ * @param metrics: 指标
+ * @param plant: 功率级
+ * @retval None
+ */
+void CMix_Plant_Metrics_Update(CMix_Plant_Metrics_t *metrics, const CMix_Plant_t *plant)
+{
+    double step = metrics->target - metrics->initial;
+    double value = plant->vout_avg;
+    double progress;
+
+    if (!isfinite(value) || !isfinite(plant->il)) {
+        metrics->finite = false;
+        return;
+    }
+    if (plant->time_s < metrics->t0 || step == 0.0) {
+        return;
+    }
+
+    progress = (value - metrics->initial) / step;
+    if (metrics->t10 < 0.0 && progress >= 0.1) {
+        metrics->t10 = plant->time_s;
+    }
+    if (metrics->t90 < 0.0 && progress >= 0.9) {
+        metrics->t90 = plant->time_s;
+    }
+    if ((step > 0.0 && value > metrics->peak) || (step < 0.0 && value < metrics->peak)) {
+        metrics->peak = value;
+    }
+    if (fabs(value - metrics->target) > metrics->band * fabs(step)) {
+        metrics->last_outside = plant->time_s;
+    }
+
+    if (plant->time_s >= metrics->ripple_start_s) {
+        if (plant->vout_min < metrics->ripple_min) metrics->ripple_min = plant->vout_min;
+        if (plant->vout_max > metrics->ripple_max) metrics->ripple_max = plant->vout_max;
+        metrics->final_sum += value;
+        metrics->final_count++;
+    }
+}
+
+/**
+ * @brief 汇总阶跃响应指标
+ * @param metrics: 指标
+ * @param result: 结果
+ * @retval None
+ */
+void CMix_Plant_Metrics_Result(const CMix_Plant_Metrics_t *metrics, CMix_Plant_Result_t *result)
+{
+    double step = metrics->target - metrics->initial;
+
+    result->rise_time_s = (metrics->t10 >= 0.0 && metrics->t90 >= 0.0) ? metrics->t90 - metrics->t10 : -1.0;
+    result->overshoot_pct = (step != 0.0) ? 100.0 * (metrics->peak - metrics->target) / step : 0.0;
+    if (result->overshoot_pct < 0.0) {
+        result->overshoot_pct = 0.0;
+    }
+    result->final_value = metrics->final_count ? metrics->final_sum / metrics->final_count : NAN;
+    result->steady_error = result->final_value - metrics->target;
+    result->ripple_pp = metrics->final_count ? metrics->ripple_max - metrics->ripple_min : NAN;
+
+    /* 统计窗口结束时仍在稳定带外视为未稳定 */
+    if (metrics->final_count == 0 || fabs(result->steady_error) > metrics->band * fabs(step) ||
+        metrics->last_outside >= metrics->ripple_start_s) {
+        result->settling_time_s = -1.0;
+    } else {
+        result->settling_time_s = metrics->last_outside - metrics->t0;
+    }
+}
+
+/* ========================= 私有函数实现 ========================= */
+
+/**
+ * @brief 开关模型子步边界: 等分网格与两相开关边沿的并集 (升序, 去重)
+ * @param bounds: 边界输出 (首项0, 末项1)
+ * @param grid: 等分子步数
+ * @param duty_a: 相A占空比
+ * @param duty_b: 相B占空比
+ * @param dead: 死区 (周期归一化)
+ * @param shift: 相B滞后 (周期归一化, [0,1))
+ * @retval 子步数
+ * @note  边沿处于子步边界上, 子步内开关状态不变, 周期内电流极值可被准确记录
+ */
+static uint16_t CMix_Plant_Boundaries(double *bounds, uint16_t grid, double duty_a, double duty_b, double dead,
+                                      double shift)
+{
+    const double edges[8] = {dead, duty_a, duty_a + dead, shift, shift + dead, shift + duty_b,
+                             shift + duty_b + dead, 1.0};
+    uint16_t count = 0, i, j;
+
+    for (i = 0; i <= grid; i++) {
+        bounds[count++] = (double)i / grid;
+    }
+    for (i = 0; i < 8; i++) {
+        /* 相B边沿超过周期末尾的部分落在下一周期的开头 */
+        double edge = (i >= 4 && shift > 0.0 && edges[i] >= 1.0) ? edges[i] - 1.0 : edges[i];
+
+        if (edge > 0.0 && edge < 1.0) {
+            bounds[count++] = edge;
+        }
+    }
+
+    /* 插入排序 (元素基本有序) */
+    for (i = 1; i < count; i++) {
+        double value = bounds[i];
+        for (j = i; j > 0 && bounds[j - 1] > value; j--) {
+            bounds[j] = bounds[j - 1];
+        }
+        bounds[j] = value;
+    }
+
+    /* 去除重合边界 */
+    for (i = 1, j = 0; i < count; i++) {
+        if (bounds[i] - bounds[j] > 1e-9) {
+            bounds[++j] = bounds[i];
+        }
+    }
+    bounds[j] = 1.0;
+    return j;
+}
+
+/**
+ * @brief 区间[a0,a1)与[b0,b1)的重叠长度
+ */
+static double CMix_Plant_Overlap(double a0, double a1, double b0, double b1)
+{
+    double lo = (a0 > b0) ? a0 : b0;
+    double hi = (a1 < b1) ? a1 : b1;
+
+    return (hi > lo) ? hi - lo : 0.0;
+}
+
+/**
+ * @brief 半桥开关节点在[u0,u1)内接高端的时间 (周期归一化)
+ * @param duty: 占空比 (比较值 / 周期计数)
+ * @param dead: 死区 (周期归一化)
+ * @param u0: 区间起点
+ * @param u1: 区间终点
+ * @param diode_high: 死区内由上管体二极管续流
+ * @retval 接高端时间
+ * @note  PWM1: [0,duty)上管有效, 死区延迟上升沿: 上管[dead,duty), 下管[duty+dead,1)
+ */
+static double CMix_Plant_High_Fraction(double duty, double dead, double u0, double u1, bool diode_high)
+{
+    double high;
+
+    if (duty <= 0.0) {
+        return 0.0;                                         // 下管常通
+    }
+    if (duty >= 1.0) {
+        return u1 - u0;                                     // 上管常通
+    }
+
+    high = CMix_Plant_Overlap(u0, u1, dead, duty);
+    if (diode_high) {
+        double dead_end = (duty + dead < 1.0) ? duty + dead : 1.0;
+        high += CMix_Plant_Overlap(u0, u1, 0.0, (dead < duty) ? dead : duty);
+        high += CMix_Plant_Overlap(u0, u1, duty, dead_end);
+    }
+    return high;
+}
+
+/**
+ * @brief 相移后的半桥接高端时间: 相B的开关波形在[shift, shift+1)上重复
+ * @param duty: 占空比
+ * @param dead: 死区 (周期归一化)
+ * @param shift: 滞后 (周期归一化, [0,1))
+ * @param u0: 区间起点
+ * @param u1: 区间终点
+ * @param diode_high: 死区内由上管体二极管续流
+ * @retval 接高端时间
+ */
+static double CMix_Plant_Shifted_Fraction(double duty, double dead, double shift, double u0, double u1,
+                                          bool diode_high)
+{
+    double v0 = u0 - shift;
+    double v1 = u1 - shift;
+
+    if (v0 < 0.0) {
+        v0 += 1.0;
+        v1 += 1.0;
+    }
+    if (v1 <= 1.0) {
+        return CMix_Plant_High_Fraction(duty, dead, v0, v1, diode_high);
+    }
+    return CMix_Plant_High_Fraction(duty, dead, v0, 1.0, diode_high) +
+           CMix_Plant_High_Fraction(duty, dead, 0.0, v1 - 1.0, diode_high);
+}
+
+/**
+ * @brief 端口量
+ */
+static void CMix_Plant_Ports(const CMix_Plant_t *plant, double il, double il_b, double vc, double fa, double fb,
+                             CMix_Plant_Ports_t *ports)
+{
+    const CMix_Plant_Params_t *p = &plant->params;
+
+    if (p->topology == CMIX_PLANT_INTERLEAVED) {
+        ports->iin = fa * il + fb * il_b;
+        ports->iout = il + il_b;
+    } else {
+        ports->iin = fa * il;
+        ports->iout = fb * il;
+    }
+    ports->vin = p->battery_voltage - p->battery_resistance * ports->iin;
+    ports->vout = vc + p->capacitor_esr_ohm * (ports->iout - p->load_current);
+    if (p->load_resistance > 0.0) {
+        ports->vout /= 1.0 + p->capacitor_esr_ohm / p->load_resistance;
+    }
+    ports->iload = p->load_current + ((p->load_resistance > 0.0) ? ports->vout / p->load_resistance : 0.0);
+}
+
+/**
+ * @brief 状态导数
+ */
+static void CMix_Plant_Derivative(const CMix_Plant_t *plant, double il, double il_b, double vc, double fa, double fb,
+                                  double *dil, double *dil_b, double *dvc)
+{
+    const CMix_Plant_Params_t *p = &plant->params;
+    CMix_Plant_Ports_t ports;
+
+    CMix_Plant_Ports(plant, il, il_b, vc, fa, fb, &ports);
+    if (p->topology == CMIX_PLANT_INTERLEAVED) {
+        *dil = (fa * ports.vin - ports.vout - p->inductor_dcr_ohm * il) / p->inductance_h;
+        *dil_b = (fb * ports.vin - ports.vout - p->inductor_dcr_ohm * il_b) / p->inductance_h;
+    } else {
+        *dil = (fa * ports.vin - fb * ports.vout - p->inductor_dcr_ohm * il) / p->inductance_h;
+        *dil_b = 0.0;
+    }
+    *dvc = (ports.iout - ports.iload) / p->capacitance_f;
+}
+
+/**
+ * @brief 引脚电压换算为12位ADC值
+ */
+static uint16_t CMix_Plant_ADC_Code(CMix_Plant_t *plant, double volts_at_pin, double vref)
+{
+    double code = volts_at_pin / vref * CMIX_ADC_RESOLUTION;
+
+    if (plant->params.adc_noise_lsb > 0.0) {
+        /* xorshift32, 均匀分布[-noise, +noise] */
+        uint32_t x = plant->noise_state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        plant->noise_state = x;
+        code += plant->params.adc_noise_lsb * ((double)x / 2147483648.0 - 1.0);
+    }
+
+    code = floor(code + 0.5);
+    if (code < 0.0) {
+        return 0;
+    }
+    if (code > CMIX_ADC_RESOLUTION) {
+        return CMIX_ADC_RESOLUTION;
+    }
+    return (uint16_t)code;
+}
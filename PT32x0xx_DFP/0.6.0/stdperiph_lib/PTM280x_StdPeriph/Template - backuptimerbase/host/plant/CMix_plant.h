@@ -0,0 +1,165 @@
+/******************************************************************************
+  * @file    CMix_plant.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix功率级模型头文件
+  *          双向四开关升降压变换器和两相交错BUCK的平均模型与开关模型, 供主机闭环联合仿真
+  ******************************************************************************
+  * @attention
+  *
+  * 拓扑 (与CMix_config.h引脚定义一致):
+  *
+  *   电池 ─Rbat─ Vin ─┬─ 相A上管 (TIM1_CH1)          相B上管 (TIM1_CH2) ─┬─ Vout ─┬─ Cout(ESR)
+  *                    │        ├─ L (DCR) ───────────────────┤            │        ├─ Rload
+  *                    └─ 相A下管 (TIM1_CH1N)          相B下管 (TIM1_CH2N) ─┘        └─ 恒流负载
+  *
+  *   每相为互补半桥, PWM1模式: 计数值小于比较值时上管导通, 两次换流各插入
+  *   一个死区, 死区内电感电流经体二极管续流. 电感电流以相A流向相B为正,
+  *   负值表示向电池回馈.
+  *
+  * 两相交错 (CMIX_PWM_INTERLEAVE_ENABLE, CMIX_PLANT_INTERLEAVED):
+  *
+  *   电池 ─Rbat─ Vin ─┬─ 相A半桥 (TIM1_CH1/CH1N) ─ La (DCR) ─┬─ Vout ─┬─ Cout(ESR)
+  *                    │                                      │        ├─ Rload
+  *                    └─ 相B半桥 (TIM1_CH2/CH2N) ─ Lb (DCR) ─┘        └─ 恒流负载
+  *
+  *   两相并联为同步BUCK, 相B开关波形滞后phase_shift个周期 (0.5 = 180°),
+  *   有效占空比另加phase_b_duty_offset (驱动延时失配). 电感电流流向Vout为正.
+  *
+  * 两种模型共用同一积分器:
+  *   平均模型: 每个PWM周期积分一步, 开关以导通占比计入
+  *   开关模型: 每个PWM周期按substeps等分, 并在两相开关边沿处再分割,
+  *             子步内开关状态不变, 可得到纹波
+  *
+  * 采样: Vin/Vout为周期结束 (即下一周期TRGO触发ADC) 时刻的瞬时值,
+  *       相A/相B电流为上一周期平均值 (TP181A1输出经RC滤波); 四开关时为
+  *       两个半桥的端口电流, 交错时为两相电感电流.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_PLANT_H
+#define __CMIX_PLANT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_PLANT_ADC_CHANNELS     4           // Vin, Ia, Vout, Ib (按通道号索引)
+#define CMIX_PLANT_MAX_SUBSTEPS     256         // 开关模型每周期最大等分子步数
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 模型类型 */
+typedef enum {
+    CMIX_PLANT_AVERAGED = 0,                // 平均模型
+    CMIX_PLANT_SWITCHING                    // 开关模型
+} CMix_Plant_Model_t;
+
+/* 拓扑 */
+typedef enum {
+    CMIX_PLANT_FOUR_SWITCH = 0,             // 单电感四开关升降压
+    CMIX_PLANT_INTERLEAVED                  // 两相交错BUCK
+} CMix_Plant_Topology_t;
+
+/* 功率级参数 */
+typedef struct {
+    CMix_Plant_Model_t model;
+    CMix_Plant_Topology_t topology;
+    uint16_t substeps;                      // 开关模型每周期子步数
+    double pwm_period_s;                    // PWM周期 (s)
+    double dead_time_s;                     // 死区时间 (s)
+    double inductance_h;                    // 电感 (H)
+    double inductor_dcr_ohm;                // 电感直流电阻 (Ω, 交错时每相)
+    double phase_shift;                     // 交错: 相B滞后相A (周期归一化)
+    double phase_b_duty_offset;             // 交错: 相B有效占空比偏差 (周期归一化)
+    double capacitance_f;                   // 输出电容 (F)
+    double capacitor_esr_ohm;               // 输出电容ESR (Ω)
+    double battery_voltage;                 // 电池开路电压 (V)
+    double battery_resistance;              // 电池内阻 (Ω)
+    double load_resistance;                 // 阻性负载 (Ω, 0 = 开路)
+    double load_current;                    // 恒流负载 (A)
+    double initial_output_voltage;          // 输出电容初始电压 (V)
+    double adc_noise_lsb;                   // ADC噪声幅度 (LSB, 均匀分布)
+    uint32_t seed;                          // 噪声种子
+} CMix_Plant_Params_t;
+
+/* 功率级状态 */
+typedef struct {
+    CMix_Plant_Params_t params;
+    double time_s;                          // 仿真时间
+    double il;                              // 电感电流 (A, 交错时为相A)
+    double il_b;                            // 交错: 相B电感电流 (A)
+    double vc;                              // 输出电容电压 (V)
+    double vin;                             // 输入端电压 (瞬时)
+    double vout;                            // 输出端电压 (瞬时)
+    double ia_avg;                          // 相A电流采样量周期平均 (四开关: 电池侧端口)
+    double ib_avg;                          // 相B电流采样量周期平均 (四开关: 输出侧端口)
+    double vout_avg;                        // 输出电压周期平均
+    double vout_min;                        // 本周期输出电压最小值
+    double vout_max;                        // 本周期输出电压最大值
+    double il_min;                          // 本周期电感电流最小值 (交错时为相A)
+    double il_max;                          // 本周期电感电流最大值
+    double il_peak;                         // 电感电流绝对值峰值 (交错时两相中较大者)
+    double energy_in_j;                     // 电池输出能量
+    double energy_load_j;                   // 负载消耗能量
+    double energy_loss_j;                   // DCR/ESR/电池内阻损耗
+    uint64_t periods;                       // 已仿真PWM周期数
+    uint32_t noise_state;
+} CMix_Plant_t;
+
+/* 阶跃响应指标 */
+typedef struct {
+    double t0;                              // 阶跃时刻 (s)
+    double initial;                         // 阶跃前值
+    double target;                          // 目标值
+    double band;                            // 稳定带 (相对阶跃幅度, 如0.02)
+    double ripple_start_s;                  // 从该时刻起统计纹波和稳态值
+    double t10;                             // 首次到达10%的时刻 (-1 = 未到达)
+    double t90;                             // 首次到达90%的时刻
+    double peak;                            // 阶跃方向上的极值
+    double last_outside;                    // 最后一次超出稳定带的时刻
+    double ripple_min;
+    double ripple_max;
+    double final_sum;
+    uint64_t final_count;
+    bool finite;                            // 全程无NaN/Inf
+} CMix_Plant_Metrics_t;
+
+/* 指标汇总结果 */
+typedef struct {
+    double rise_time_s;                     // 10%-90%上升时间 (-1 = 未到达)
+    double overshoot_pct;                   // 超调 (%)
+    double settling_time_s;                 // 进入并保持在稳定带内的时间 (-1 = 未稳定)
+    double final_value;                     // 稳态平均值
+    double steady_error;                    // 稳态误差 (final - target)
+    double ripple_pp;                       // 稳态峰峰值纹波
+} CMix_Plant_Result_t;
+
+/* ========================= 函数声明 ========================= */
+
+/* 功率级 */
+void CMix_Plant_Default_Params(CMix_Plant_Params_t *params);
+void CMix_Plant_Init(CMix_Plant_t *plant, const CMix_Plant_Params_t *params);
+void CMix_Plant_Step(CMix_Plant_t *plant, uint16_t compare_a, uint16_t compare_b, uint16_t period_counts);
+void CMix_Plant_Sample(CMix_Plant_t *plant, uint16_t raw[CMIX_PLANT_ADC_CHANNELS]);
+double CMix_Plant_Stored_Energy(const CMix_Plant_t *plant);
+
+/* 阶跃响应指标 */
+void CMix_Plant_Metrics_Start(CMix_Plant_Metrics_t *metrics, double t0, double initial, double target,
+                              double band, double ripple_start_s);
+void CMix_Plant_Metrics_Update(CMix_Plant_Metrics_t *metrics, const CMix_Plant_t *plant);
+void CMix_Plant_Metrics_Result(const CMix_Plant_Metrics_t *metrics, CMix_Plant_Result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_PLANT_H */
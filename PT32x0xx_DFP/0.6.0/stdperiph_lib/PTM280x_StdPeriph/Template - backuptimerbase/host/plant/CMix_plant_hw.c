@@ -0,0 +1,257 @@
+/******************************************************************************
+  * @file    CMix_plant_hw.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix联合仿真硬件绑定实现文件
+  ******************************************************************************
+  * @attention
+  *
+  * 各函数与CMix_hardware.c中的同名实现保持相同的换算, 修改固件换算时
+  * 需同步修改此处.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_plant_hw.h"
+#include "CMix_hardware.h"
+#include "CMix_protocol.h"
+#include "CMix_blackbox.h"
+#include "CMix_telemetry.h"
+#include "CMix_trace.h"
+
+#include <string.h>
+
+/* ========================= 私有变量 ========================= */
+
+static uint16_t g_plant_hw_adc[16];
+static uint16_t g_plant_hw_compare[CMIX_PLANT_HW_PWM_CHANNELS];
+static uint16_t g_plant_hw_staged[CMIX_PLANT_HW_PWM_CHANNELS];
+static bool g_plant_hw_fault_led = false;
+static uint32_t g_plant_hw_debug_messages = 0;
+static CMix_System_Status_t g_plant_hw_status;
+static CMix_ADC_Decimator_t g_plant_hw_decimator[CMIX_ADC_SCAN_COUNT];
+static uint32_t g_plant_hw_scans = 0;
+static uint32_t g_plant_hw_primask = 0;
+static const uint8_t g_plant_hw_osr_log2[CMIX_ADC_SCAN_COUNT] = CMIX_ADC_OSR_LOG2_INIT;
+
+static uint16_t g_plant_hw_dither[2];
+
+#if CMIX_ADC_CURRENT_TABLE_ENABLE
+/* 电流通道换算表 (编译期由CMIX_ADC_CURRENT_CURVE_MA生成, 位于flash) */
+const int16_t g_cmix_adc_current_table[4096] = {
+    CMIX_ADC_TABLE_4096(CMIX_ADC_CURRENT_TABLE_ENTRY)
+};
+#endif
+
+/* ========================= 绑定接口实现 ========================= */
+
+/**
+ * @brief 复位绑定状态
+ * @param None
+ * @retval None
+ */
+void CMix_Plant_HW_Reset(void)
+{
+    memset(g_plant_hw_adc, 0, sizeof(g_plant_hw_adc));
+    memset(g_plant_hw_compare, 0, sizeof(g_plant_hw_compare));
+    memset(g_plant_hw_staged, 0, sizeof(g_plant_hw_staged));
+    memset(&g_plant_hw_status, 0, sizeof(g_plant_hw_status));
+    memset(g_plant_hw_decimator, 0, sizeof(g_plant_hw_decimator));
+#if CMIX_PWM_INTERLEAVE_ENABLE
+    memset(g_plant_hw_dither, 0, sizeof(g_plant_hw_dither));
+#endif
+    g_plant_hw_scans = 0;
+    g_plant_hw_fault_led = false;
+    g_plant_hw_debug_messages = 0;
+}
+
+/**
+ * @brief 注入一次ADC扫描结果 (按通道号索引)
+ * @param raw: ADC原始值
+ * @param count: 通道数
+ * @retval None
+ * @note  扫描通道同时送入抽取器, 与ADC0_Handler/DMA_Handler相同
+ */
+void CMix_Plant_HW_Set_ADC(const uint16_t *raw, uint8_t count)
+{
+    uint8_t i;
+
+    if (count > 16) {
+        count = 16;
+    }
+    memcpy(g_plant_hw_adc, raw, count * sizeof(uint16_t));
+
+    for (i = 0; i < count && i < CMIX_ADC_SCAN_COUNT; i++) {
+#if CMIX_ADC_SEQUENCER_ENABLE
+        /* 多速率采样: Vin为慢速通道, 每CMIX_ADC_SLOW_COUNT次扫描转换一次 */
+        if (i == CMIX_ADC_VIN_CHANNEL && (g_plant_hw_scans % CMIX_ADC_SLOW_COUNT) != 0) {
+            continue;
+        }
+#endif
+        if (g_plant_hw_scans == 0) {
+            CMix_Hardware_ADC_Decimator_Seed(&g_plant_hw_decimator[i], raw[i]);
+        }
+        CMix_Hardware_ADC_Decimate(&g_plant_hw_decimator[i], raw[i], g_plant_hw_osr_log2[i]);
+    }
+    g_plant_hw_scans++;
+}
+
+/**
+ * @brief 读取PWM通道比较值
+ * @param channel: 通道 (1-4)
+ * @retval 比较值 (TIM1计数)
+ */
+uint16_t CMix_Plant_HW_Get_Compare(uint8_t channel)
+{
+    if (channel >= 1 && channel <= CMIX_PLANT_HW_PWM_CHANNELS) {
+        return g_plant_hw_compare[channel - 1];
+    }
+    return 0;
+}
+
+/**
+ * @brief 故障LED状态
+ */
+bool CMix_Plant_HW_Fault_LED(void)
+{
+    return g_plant_hw_fault_led;
+}
+
+/**
+ * @brief 固件写入的调试记录条数
+ */
+uint32_t CMix_Plant_HW_Debug_Messages(void)
+{
+    return g_plant_hw_debug_messages;
+}
+
+/* ========================= 固件接口实现 ========================= */
+
+void CMix_Hardware_Set_PWM_Duty(uint8_t channel, uint16_t duty_cycle)
+{
+    uint16_t pulse = (duty_cycle * CMIX_PWM_COMPARE_SCALE) / 10000;
+
+    if (channel >= 1 && channel <= CMIX_PLANT_HW_PWM_CHANNELS) {
+        g_plant_hw_compare[channel - 1] = pulse;
+    }
+}
+
+/* 两相交错时相B记录导通计数而非PWM2比较值, 半周期相移由对象模型施加 */
+void CMix_Hardware_PWM_Stage(uint8_t channel, uint16_t duty_cycle)
+{
+    if (channel < 1 || channel > CMIX_PLANT_HW_PWM_CHANNELS) {
+        return;
+    }
+    if (channel <= 2) {
+        uint32_t fine = ((uint32_t)duty_cycle * (CMIX_PWM_COMPARE_SCALE << CMIX_PWM_DITHER_BITS)) / 10000 +
+                        g_plant_hw_dither[channel - 1];
+        uint16_t pulse;
+
+        g_plant_hw_dither[channel - 1] = (uint16_t)(fine & ((1U << CMIX_PWM_DITHER_BITS) - 1));
+        pulse = (uint16_t)(fine >> CMIX_PWM_DITHER_BITS);
+        g_plant_hw_staged[channel - 1] = (pulse > CMIX_PWM_COMPARE_SCALE) ? CMIX_PWM_COMPARE_SCALE : pulse;
+        return;
+    }
+    g_plant_hw_staged[channel - 1] = (uint16_t)((duty_cycle * CMIX_PWM_COMPARE_SCALE) / 10000);
+}
+
+/* 对象模型每个PWM周期读取一次比较值, 提交即在下一周期生效, 不会错过 */
+bool CMix_Hardware_PWM_Commit(void)
+{
+    memcpy(g_plant_hw_compare, g_plant_hw_staged, sizeof(g_plant_hw_compare));
+    return true;
+}
+
+bool CMix_Hardware_PWM_Release_Break(void)
+{
+    return true;
+}
+
+void CMix_Hardware_GPIO_Write(GPIO_TypeDef *port, uint16_t pin, uint8_t state)
+{
+    if (port == CMIX_GPIO_FAULT_LED_PORT && pin == CMIX_GPIO_FAULT_LED_PIN) {
+        g_plant_hw_fault_led = (state != 0);
+    }
+}
+
+CMix_Voltage_Sensors_t CMix_Hardware_Get_Voltage_Sensors(void)
+{
+    CMix_Voltage_Sensors_t sensors;
+
+    sensors.input_voltage = g_plant_hw_decimator[CMIX_ADC_VIN_CHANNEL].output;
+    sensors.output_voltage = g_plant_hw_decimator[CMIX_ADC_VOUT_CHANNEL].output;
+    return sensors;
+}
+
+CMix_Current_Sensors_t CMix_Hardware_Get_Current_Sensors(void)
+{
+    CMix_Current_Sensors_t sensors;
+
+    sensors.input_current = CMix_Hardware_Convert_Current_Ext_mA(g_plant_hw_decimator[CMIX_ADC_CURRENT_A_CHANNEL].output);
+    sensors.output_current = CMix_Hardware_Convert_Current_Ext_mA(g_plant_hw_decimator[CMIX_ADC_CURRENT_B_CHANNEL].output);
+    return sensors;
+}
+
+float CMix_Hardware_Convert_Current(uint16_t adc_raw)
+{
+    return (float)CMix_Hardware_Convert_Current_mA(adc_raw) * 0.001f;
+}
+
+CMix_System_Status_t* CMix_Protocol_Get_System_Status(void)
+{
+    return &g_plant_hw_status;
+}
+
+/* 联合仿真单线程执行控制步, 没有可抢占的中断; 关中断临界区只记录PRIMASK */
+void CMix_Emu_Core_Disable_IRQ(void)
+{
+    g_plant_hw_primask = 1;
+}
+
+uint32_t CMix_Emu_Core_Get_PRIMASK(void)
+{
+    return g_plant_hw_primask;
+}
+
+void CMix_Emu_Core_Set_PRIMASK(uint32_t primask)
+{
+    g_plant_hw_primask = primask;
+}
+
+#if CMIX_DEBUG_ENABLE
+void CMix_Trace_Write(uint32_t header, const uint32_t *args)
+{
+    (void)header;
+    (void)args;
+    g_plant_hw_debug_messages++;
+}
+#endif
+
+#if CMIX_BLACKBOX_ENABLE
+/* 联合仿真不记录黑匣子 (无Flash) */
+void CMix_Blackbox_Capture(const CMix_DCDC_Status_t *status)
+{
+    (void)status;
+}
+
+void CMix_Blackbox_Trigger(uint8_t fault_code)
+{
+    (void)fault_code;
+}
+#endif
+
+#if CMIX_TELEMETRY_ENABLE
+/* 联合仿真直接读取控制器状态, 不需要遥测流 */
+void CMix_Telemetry_Capture(void)
+{
+}
+#endif
+
+#if CMIX_SCOPE_ENABLE
+/* 联合仿真直接读取控制器状态, 不需要片内示波器 */
+void CMix_Scope_Capture(void)
+{
+}
+#endif
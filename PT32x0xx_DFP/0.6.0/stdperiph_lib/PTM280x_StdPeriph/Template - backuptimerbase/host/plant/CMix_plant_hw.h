@@ -0,0 +1,50 @@
+/******************************************************************************
+  * @file    CMix_plant_hw.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix联合仿真硬件绑定头文件
+  *          以功率级模型替代CMix_hardware.c/CMix_protocol.c中被DCDC控制调用的接口
+  ******************************************************************************
+  * @attention
+  *
+  * 联合仿真只编译CMix_dcdc.c和CMix_pid.c, 外设不经过寄存器仿真,
+  * 因此可远快于实时运行. 本文件提供的绑定:
+  *   CMix_Hardware_Set_PWM_Duty      记录各通道比较值 (与TIM1_CCRx换算一致)
+  *   CMix_Hardware_Get_*_Sensors     注入的ADC扫描结果经过与固件相同的过采样抽取
+  *   CMix_Hardware_Convert_Current   TP181A1换算 (与CMix_hardware.c相同)
+  *   CMix_Hardware_GPIO_Write        记录故障LED
+  *   CMix_Protocol_*                 状态结构体
+  *   CMix_Trace_Write                调试记录计数
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_PLANT_HW_H
+#define __CMIX_PLANT_HW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_PLANT_HW_PWM_CHANNELS  4
+
+/* ========================= 函数声明 ========================= */
+
+void CMix_Plant_HW_Reset(void);
+void CMix_Plant_HW_Set_ADC(const uint16_t *raw, uint8_t count);
+uint16_t CMix_Plant_HW_Get_Compare(uint8_t channel);
+bool CMix_Plant_HW_Fault_LED(void);
+uint32_t CMix_Plant_HW_Debug_Messages(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_PLANT_HW_H */
@@ -0,0 +1,215 @@
+/******************************************************************************
+  * @file    CMix_trace_decode.c
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix跟踪记录解码实现文件
+  *          实现CMIX_CMD_TRACE帧拆分和格式串展开
+  ******************************************************************************
+  * @attention
+  *
+  * 每个转换说明取一个参数字, 重新组成单个转换的格式串交给snprintf:
+  *   d/i       int32_t
+  *   u/o/x/X/c uint32_t
+  *   f/e/g/a   参数字为float位模式, 转为double
+  *   s         参数字为CMIX_TRACE_STRING标识
+  * 标志、宽度和精度保留, 长度修饰符丢弃 (参数字固定为32位).
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#include "CMix_trace_decode.h"
+#include "CMix_trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* ========================= 格式串表 ========================= */
+
+static const char *const g_trace_formats[CMIX_TRACE_FORMAT_COUNT] = {
+#define CMIX_TRACE_FORMAT(id, format)   [id] = format,
+#define CMIX_TRACE_STRING(id, text)
+#include "CMix_trace_fmt.h"
+#undef CMIX_TRACE_FORMAT
+#undef CMIX_TRACE_STRING
+};
+
+static const char *const g_trace_strings[CMIX_TRACE_STRING_COUNT] = {
+#define CMIX_TRACE_FORMAT(id, format)
+#define CMIX_TRACE_STRING(id, text)     [id] = text,
+#include "CMix_trace_fmt.h"
+#undef CMIX_TRACE_FORMAT
+#undef CMIX_TRACE_STRING
+};
+
+#define CMIX_TRACE_DECODE_FORMATS   (sizeof(g_trace_formats) / sizeof(g_trace_formats[0]))
+#define CMIX_TRACE_DECODE_STRINGS   (sizeof(g_trace_strings) / sizeof(g_trace_strings[0]))
+
+/* ========================= 公共函数实现 ========================= */
+
+/**
+ * @brief 初始化解码器
+ * @param decoder: 解码器
+ * @retval None
+ */
+void CMix_Trace_Decoder_Init(CMix_Trace_Decoder_t *decoder)
+{
+    memset(decoder, 0, sizeof(*decoder));
+}
+
+/**
+ * @brief 解码一帧CMIX_CMD_TRACE数据
+ * @param decoder: 解码器
+ * @param data: 帧数据 (帧序号, 丢失记录数, 记录...)
+ * @param len: 帧数据长度
+ * @param callback: 每条记录的回调 (格式错误的记录也回调, 文本中标出)
+ * @param context: 回调参数
+ * @retval true = 帧序号连续且全部记录有效
+ */
+bool CMix_Trace_Decode_Frame(CMix_Trace_Decoder_t *decoder, const uint8_t *data, uint16_t len,
+                             CMix_Trace_Record_Callback_t callback, void *context)
+{
+    char text[CMIX_TRACE_DECODE_TEXT_MAX];
+    uint32_t args[256];
+    uint32_t header;
+    uint16_t pos = 2;
+    uint8_t argc, i;
+    bool ok = true;
+
+    if (len < 2) {
+        decoder->bad_records++;
+        return false;
+    }
+    if (decoder->synced && data[0] != decoder->next_sequence) {
+        decoder->sequence_gaps++;
+        ok = false;
+    }
+    decoder->synced = true;
+    decoder->next_sequence = (uint8_t)(data[0] + 1);
+    decoder->lost += data[1];
+    decoder->frames++;
+
+    while (pos + 4 <= len) {
+        memcpy(&header, &data[pos], 4);
+        argc = (uint8_t)(header >> 8);
+        pos += 4;
+        if (pos + (uint16_t)argc * 4 > len) {
+            decoder->bad_records++;
+            return false;
+        }
+        for (i = 0; i < argc; i++) {
+            memcpy(&args[i], &data[pos], 4);
+            pos += 4;
+        }
+        if (!CMix_Trace_Format_Record((uint8_t)(header & 0xFF), args, argc, text, sizeof(text))) {
+            decoder->bad_records++;
+            ok = false;
+        }
+        decoder->records++;
+        if (callback != NULL) {
+            callback(context, (uint16_t)(header >> 16), text);
+        }
+    }
+    if (pos != len) {
+        decoder->bad_records++;
+        ok = false;
+    }
+    return ok;
+}
+
+/**
+ * @brief 按格式表把一条记录还原为文本
+ * @param id: 格式ID
+ * @param args: 参数字
+ * @param argc: 参数个数
+ * @param text: 文本输出
+ * @param size: 文本缓冲大小
+ * @retval true = 格式ID有效且参数个数与转换说明一致
+ */
+bool CMix_Trace_Format_Record(uint8_t id, const uint32_t *args, uint8_t argc, char *text, size_t size)
+{
+    const char *format;
+    char spec[16];
+    size_t out = 0, spec_len;
+    uint8_t used = 0;
+    float value;
+    int written;
+
+    if (id >= CMIX_TRACE_DECODE_FORMATS || g_trace_formats[id] == NULL) {
+        snprintf(text, size, "<trace id %u, %u args>", (unsigned)id, (unsigned)argc);
+        return false;
+    }
+
+    for (format = g_trace_formats[id]; *format != '\0' && out + 1 < size; format++) {
+        if (*format != '%') {
+            text[out++] = *format;
+            continue;
+        }
+        if (format[1] == '%') {
+            text[out++] = '%';
+            format++;
+            continue;
+        }
+
+        /* 标志/宽度/精度原样保留, 长度修饰符丢弃 */
+        spec_len = 0;
+        spec[spec_len++] = *format++;
+        while (*format != '\0' && strchr("-+ #0123456789.", *format) != NULL && spec_len < sizeof(spec) - 2) {
+            spec[spec_len++] = *format++;
+        }
+        while (*format != '\0' && strchr("hlLqjzt", *format) != NULL) {
+            format++;
+        }
+        if (*format == '\0' || used >= argc) {
+            snprintf(text, size, "<trace id %u: %u args for \"%s\">", (unsigned)id, (unsigned)argc, g_trace_formats[id]);
+            return false;
+        }
+        spec[spec_len++] = *format;
+        spec[spec_len] = '\0';
+
+        switch (*format) {
+        case 'd':
+        case 'i':
+            written = snprintf(&text[out], size - out, spec, (int)(int32_t)args[used]);
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            written = snprintf(&text[out], size - out, spec, (unsigned)args[used]);
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            memcpy(&value, &args[used], sizeof(value));
+            written = snprintf(&text[out], size - out, spec, (double)value);
+            break;
+        case 's':
+            written = snprintf(&text[out], size - out, spec,
+                               (args[used] < CMIX_TRACE_DECODE_STRINGS) ? g_trace_strings[args[used]] : "<?>");
+            break;
+        default:
+            snprintf(text, size, "<trace id %u: bad conversion in \"%s\">", (unsigned)id, g_trace_formats[id]);
+            return false;
+        }
+        used++;
+        if (written < 0) {
+            break;
+        }
+        out += ((size_t)written < size - out) ? (size_t)written : size - out - 1;
+    }
+    text[out] = '\0';
+
+    if (used != argc) {
+        snprintf(text, size, "<trace id %u: %u args for \"%s\">", (unsigned)id, (unsigned)argc, g_trace_formats[id]);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+  * @file    CMix_trace_decode.h
+  * @author  CMix Development Team
+  * @version V1.0.0
+  * @date    2025/09/17
+  * @brief   CMix跟踪记录解码头文件
+  *          按CMix_trace_fmt.h把固件发送的二进制跟踪记录还原为文本
+  ******************************************************************************
+  * @attention
+  *
+  * 格式串表在编译时由CMix_trace_fmt.h展开, 与固件的格式ID枚举同源, 主机程序
+  * 与固件同一次构建时两边一致. 解码器检查帧序号连续、格式ID在表内、记录的
+  * 参数个数与格式串的转换说明个数相同.
+  *
+  * Copyright (C) 2025, CMix Team, all rights reserved
+  *
+  *****************************************************************************/
+
+#ifndef __CMIX_TRACE_DECODE_H
+#define __CMIX_TRACE_DECODE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ========================= 常量定义 ========================= */
+
+#define CMIX_TRACE_DECODE_TEXT_MAX  160         // 一条记录还原后的最大文本长度 (含结尾0)
+
+/* ========================= 数据结构定义 ========================= */
+
+/* 解码统计 */
+typedef struct {
+    uint32_t frames;                        // 解码的帧数
+    uint32_t records;                       // 解码的记录数
+    uint32_t lost;                          // 固件报告的丢失记录数 (环满)
+    uint32_t sequence_gaps;                 // 帧序号不连续的次数 (丢帧)
+    uint32_t bad_records;                   // 未知格式ID、参数个数不符或记录截断
+    uint8_t next_sequence;
+    bool synced;                            // 已收到第一帧
+} CMix_Trace_Decoder_t;
+
+/* 每条记录的回调: ms为固件系统时间低16位 */
+typedef void (*CMix_Trace_Record_Callback_t)(void *context, uint16_t ms, const char *text);
+
+/* ========================= 函数声明 ========================= */
+
+void CMix_Trace_Decoder_Init(CMix_Trace_Decoder_t *decoder);
+bool CMix_Trace_Decode_Frame(CMix_Trace_Decoder_t *decoder, const uint8_t *data, uint16_t len,
+                             CMix_Trace_Record_Callback_t callback, void *context);
+bool CMix_Trace_Format_Record(uint8_t id, const uint32_t *args, uint8_t argc, char *text, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMIX_TRACE_DECODE_H */
@@ -18,11 +18,23 @@
 #define CURR_SENSE_V_PER_A 0.2f
 #endif
 
+// 原始码 -> mV / mA 的Q12乘数, 由上面的参数在编译期算出; 每个采样只需一次乘法和移位
+// (满量程4095码乘以乘数不超过32位)
+#define ADC_Q12_SHIFT       12
+#define ADC_VOLT_MV_Q12     ((unsigned long)(ADC_VREF * VOLT_DIV_K * 1000.0f / ADC_RES * 4096.0f + 0.5f))
+#define ADC_CURR_MA_Q12     ((unsigned long)(ADC_VREF * 1000.0f / (ADC_RES * CURR_SENSE_V_PER_A) * 4096.0f + 0.5f))
+#define ADC_CODE_TO_MV(raw) ((long)(((unsigned long)(raw) * ADC_VOLT_MV_Q12) >> ADC_Q12_SHIFT))
+#define ADC_CODE_TO_MA(raw) ((long)(((unsigned long)(raw) * ADC_CURR_MA_Q12) >> ADC_Q12_SHIFT))
+
 // Legacy single-channel cache (kept for backward compatibility)
 static float voltage = 0.0f;
 static float current = 0.0f;
 
-// Preferred multi-channel cache
+// Preferred multi-channel cache (integer mV/mA, float copies for the V/A getters)
+static long s_vin_mv = 0;
+static long s_vout_mv = 0;
+static long s_iin_ma = 0;
+static long s_iout_ma = 0;
 static float s_vin = 0.0f;
 static float s_vout = 0.0f;
 static float s_iin = 0.0f;
@@ -113,10 +125,15 @@ void fun_ADC_Update(void)
     unsigned short ri_in  = fun_ADC_ReadIinRaw();
     unsigned short ri_out = fun_ADC_ReadIoutRaw();
 
-    if (rv_in)  { s_vin  = (rv_in  * ADC_VREF / ADC_RES) * VOLT_DIV_K;  } else { s_vin  = 24.0f; }
-    if (rv_out) { s_vout = (rv_out * ADC_VREF / ADC_RES) * VOLT_DIV_K; } else { s_vout = 12.0f; }
-    if (ri_in)  { s_iin  = (ri_in  * ADC_VREF / ADC_RES) / CURR_SENSE_V_PER_A;  } else { s_iin  = 2.0f; }
-    if (ri_out) { s_iout = (ri_out * ADC_VREF / ADC_RES) / CURR_SENSE_V_PER_A; } else { s_iout = 1.0f; }
+    s_vin_mv  = rv_in  ? ADC_CODE_TO_MV(rv_in)  : 24000;
+    s_vout_mv = rv_out ? ADC_CODE_TO_MV(rv_out) : 12000;
+    s_iin_ma  = ri_in  ? ADC_CODE_TO_MA(ri_in)  : 2000;
+    s_iout_ma = ri_out ? ADC_CODE_TO_MA(ri_out) : 1000;
+
+    s_vin  = (float)s_vin_mv  * 0.001f;
+    s_vout = (float)s_vout_mv * 0.001f;
+    s_iin  = (float)s_iin_ma  * 0.001f;
+    s_iout = (float)s_iout_ma * 0.001f;
 
     // Maintain legacy single-channel outputs mapped to Vout/Iout
     voltage = s_vout;
@@ -137,3 +154,8 @@ float fun_ADC_GetVin(void)  { return s_vin; }
 float fun_ADC_GetVout(void) { return s_vout; }
 float fun_ADC_GetIin(void)  { return s_iin; }
 float fun_ADC_GetIout(void) { return s_iout; }
+
+long fun_ADC_GetVin_mV(void)  { return s_vin_mv; }
+long fun_ADC_GetVout_mV(void) { return s_vout_mv; }
+long fun_ADC_GetIin_mA(void)  { return s_iin_ma; }
+long fun_ADC_GetIout_mA(void) { return s_iout_ma; }
@@ -24,4 +24,10 @@ float fun_ADC_GetVout(void);  // Output/battery voltage (V)
 float fun_ADC_GetIin(void);   // Input current (A)
 float fun_ADC_GetIout(void);  // Output current (A)
 
+/** Integer getters (mV / mA), converted with build-time Q12 constants: */
+long fun_ADC_GetVin_mV(void);
+long fun_ADC_GetVout_mV(void);
+long fun_ADC_GetIin_mA(void);
+long fun_ADC_GetIout_mA(void);
+
 #endif
\ No newline at end of file
@@ -15,34 +15,117 @@
 #define CMIX_DEADTIME_TICKS          80U
 #define CMIX_ADC_SAMPLE_TIME_CYCLES  31U
 #define CMIX_ADC_SETUP_TIME_CYCLES   30U
-#define CMIX_ADC_MAX_COUNTS          4095.0f
+#define CMIX_ADC_MAX_COUNTS          4095U
+/* Normalisation factor folded at build time: a sample costs one multiply, no divide. */
+#define CMIX_ADC_COUNTS_TO_UNIT      (1.0f / (float)CMIX_ADC_MAX_COUNTS)
 #define CMIX_ADC_TIMEOUT_ITERATIONS  1000U
+#define CMIX_PWM_COMMIT_GUARD_TICKS  48U    /* writing both OCRs must not straddle the update event */
+
+/*
+ * Center-aligned PWM: the counter runs 0 -> ARR -> 0 and TIM1 triggers the ADC
+ * at the valley, the middle of the high-side on time, where the inductor
+ * current equals its period average. With double update the compare values
+ * also load at the peak and the injected (control) group is sampled there
+ * too, so the loop can run twice per period; the regular group stays at the
+ * valley. Edge-aligned mode keeps the software-started conversions.
+ */
+#define CMIX_PWM_CENTER_ALIGNED      1
+#define CMIX_PWM_DOUBLE_UPDATE       0
+
+#if CMIX_PWM_DOUBLE_UPDATE && !CMIX_PWM_CENTER_ALIGNED
+#error "CMIX_PWM_DOUBLE_UPDATE requires CMIX_PWM_CENTER_ALIGNED"
+#endif
+
+#if CMIX_PWM_INTERLEAVE && !CMIX_PWM_CENTER_ALIGNED
+#error "CMIX_PWM_INTERLEAVE requires CMIX_PWM_CENTER_ALIGNED"
+#endif
+
+#if CMIX_PWM_CENTER_ALIGNED
+#define CMIX_PWM_COUNT_DIRECTIONS    2U     /* up and down counts per PWM period */
+#if CMIX_PWM_DOUBLE_UPDATE
+#define CMIX_PWM_ADC_JTRIGGER        (TIM_ADCTrigger_DOAE | TIM_ADCTrigger_UOAE)
+#define CMIX_PWM_CENTER_MODE         TIM_CenterAlignedMode3_Enable
+#else
+#define CMIX_PWM_ADC_JTRIGGER        TIM_ADCTrigger_DOAE
+#define CMIX_PWM_CENTER_MODE         TIM_CenterAlignedMode1_Enable
+#endif
+#define CMIX_PWM_ADC_TRIGGER         TIM_ADCTrigger_DOAE
+#else
+#define CMIX_PWM_COUNT_DIRECTIONS    1U
+#endif
+
+/*
+ * Oversampling: every conversion is added to a per-channel boxcar accumulator
+ * (first-order CIC); after 2^osr_log2 samples the sum is published and cleared.
+ * Outputs are extended codes in 1/16 LSB, so decimating by 4 / 16 adds about
+ * 1 / 2 bits of resolution on the fast / slow channels. Cost per sample is one
+ * add and one compare, independent of the ratio.
+ */
+#define CMIX_ADC_EXT_SHIFT           4U
+#define CMIX_ADC_FAST_OSR_LOG2       2U     /* currents and bus voltages (control) */
+#define CMIX_ADC_SLOW_OSR_LOG2       4U     /* cell taps and NTCs (monitoring) */
+#define CMIX_ADC_EXT_TO_UNIT         (CMIX_ADC_COUNTS_TO_UNIT / (float)(1U << CMIX_ADC_EXT_SHIFT))
+
+#if (CMIX_ADC_FAST_OSR_LOG2 > 8U) || (CMIX_ADC_SLOW_OSR_LOG2 > 8U)
+#error "CMIX_ADC_*_OSR_LOG2 must be 0..8 (accumulator and extended code are 16-bit scaled)"
+#endif
 
 typedef struct
 {
     const CMix_PinConfig *pin;
     u32 channel;
+    uint8_t osr_log2;
+    float *target;          /* NULL for the NTC mux output (target follows the mux) */
 } CMix_AdcSequenceEntry;
 
-static const CMix_AdcSequenceEntry s_adc_sequence[] =
-{
-    { &CMix_Pin_IBat_Sense,   ADC_Channel_0 },
-    { &CMix_Pin_IOut_Sense,   ADC_Channel_1 },
-    { &CMix_Pin_Cell1_Tap,    ADC_Channel_2 },
-    { &CMix_Pin_Cell2_Tap,    ADC_Channel_3 },
-    { &CMix_Pin_Cell3_Tap,    ADC_Channel_4 },
-    { &CMix_Pin_VOut_Bus,     ADC_Channel_5 },
-    { &CMix_Pin_VPack_Total,  ADC_Channel_6 },
-    { &CMix_Pin_NTC1,         ADC_Channel_9 },
-    { &CMix_Pin_NTC2,         ADC_Channel_8 },
-    { &CMix_Pin_NTC_Mux_Out,  ADC_Channel_10 }
+typedef struct
+{
+    uint32_t sum;
+    uint16_t count;
+    uint16_t output;
+    bool primed;
+} CMix_AdcDecimator;
+
+static CMix_AnalogMeasurements s_measurement_cache = {0};
+
+/*
+ * Multi-rate sequencing: the control channels form the injected group and are
+ * converted every cycle. The monitoring channels share the single regular
+ * slot, one per cycle in round-robin order, so a full pass takes
+ * CMIX_ADC_SLOW_LENGTH cycles. The PTM280x injected group holds at most four
+ * channels.
+ */
+static const CMix_AdcSequenceEntry s_adc_fast_sequence[] =
+{
+    { &CMix_Pin_IBat_Sense,   ADC_Channel_0,  CMIX_ADC_FAST_OSR_LOG2, &s_measurement_cache.i_bat },
+    { &CMix_Pin_IOut_Sense,   ADC_Channel_1,  CMIX_ADC_FAST_OSR_LOG2, &s_measurement_cache.i_out },
+    { &CMix_Pin_VOut_Bus,     ADC_Channel_5,  CMIX_ADC_FAST_OSR_LOG2, &s_measurement_cache.v_out_bus },
+    { &CMix_Pin_VPack_Total,  ADC_Channel_6,  CMIX_ADC_FAST_OSR_LOG2, &s_measurement_cache.v_pack_total }
+};
+
+static const CMix_AdcSequenceEntry s_adc_slow_sequence[] =
+{
+    { &CMix_Pin_Cell1_Tap,    ADC_Channel_2,  CMIX_ADC_SLOW_OSR_LOG2, &s_measurement_cache.cell_voltage[0] },
+    { &CMix_Pin_NTC_Mux_Out,  ADC_Channel_10, CMIX_ADC_SLOW_OSR_LOG2, NULL },
+    { &CMix_Pin_Cell2_Tap,    ADC_Channel_3,  CMIX_ADC_SLOW_OSR_LOG2, &s_measurement_cache.cell_voltage[1] },
+    { &CMix_Pin_NTC1,         ADC_Channel_9,  CMIX_ADC_SLOW_OSR_LOG2, &s_measurement_cache.ntc_temp[0] },
+    { &CMix_Pin_Cell3_Tap,    ADC_Channel_4,  CMIX_ADC_SLOW_OSR_LOG2, &s_measurement_cache.cell_voltage[2] },
+    { &CMix_Pin_NTC2,         ADC_Channel_8,  CMIX_ADC_SLOW_OSR_LOG2, &s_measurement_cache.ntc_temp[1] }
 };
 
+#define CMIX_ADC_FAST_LENGTH         (sizeof(s_adc_fast_sequence) / sizeof(s_adc_fast_sequence[0]))
+#define CMIX_ADC_SLOW_LENGTH         (sizeof(s_adc_slow_sequence) / sizeof(s_adc_slow_sequence[0]))
+#define CMIX_ADC_NTC_MUX_SLOT        1U
+
 static uint16_t s_pwm_period_ticks = 0;
+static CMix_DutyCommitStats s_duty_commit_stats = {0};
 static bool s_pwm_outputs_requested = false;
 static bool s_ntc_mux_selects_ntc4 = false;
-static float s_ntc_mux_cached[2] = {0.0f, 0.0f};
-static CMix_AnalogMeasurements s_measurement_cache = {0};
+static size_t s_adc_slow_slot = 0U;
+/* One decimator per sequence entry; the NTC mux output keeps one per mux position. */
+static CMix_AdcDecimator s_adc_fast_decimator[CMIX_ADC_FAST_LENGTH];
+static CMix_AdcDecimator s_adc_slow_decimator[CMIX_ADC_SLOW_LENGTH];
+static CMix_AdcDecimator s_ntc_mux_decimator[2];
 
 static GPIO_TypeDef *CMix_GetGpio(const CMix_PinConfig *pin);
 static AFIO_TypeDef *CMix_GetAfio(const CMix_PinConfig *pin);
@@ -56,6 +139,9 @@ static void CMix_ConfigDebugPins(void);
 static void CMix_ConfigMuxPins(void);
 static void CMix_WaitForAdcReady(void);
 static uint16_t CMix_ClampDutyTicks(uint16_t duty_ticks);
+static uint16_t CMix_PwmHeadroomTicks(void);
+static uint16_t CMix_AdcDecimatorPush(CMix_AdcDecimator *decimator, uint16_t raw_counts, uint8_t osr_log2);
+static void CMix_ReadSlowChannel(void);
 void CMix_InitIIC(void)
 {
 	I2C_InitTypeDef I2C_InitStruct;
@@ -143,28 +229,45 @@ void CMix_InitPWMTimers(void)
             continue;
         }
 
-        auto_reload = divided_clk / CMIX_PWM_FREQUENCY_HZ;
-        if (auto_reload > 1U && auto_reload <= 0x10000U)
+        auto_reload = divided_clk / (CMIX_PWM_FREQUENCY_HZ * CMIX_PWM_COUNT_DIRECTIONS);
+        if (auto_reload > 1U && auto_reload <= 0xFFFFU)
         {
             break;
         }
     }
 
-    if (auto_reload <= 1U || auto_reload > 0x10000U)
+    if (auto_reload <= 1U || auto_reload > 0xFFFFU)
     {
         prescaler = 63U;
-        auto_reload = 1000U;
+        auto_reload = 1000U / CMIX_PWM_COUNT_DIRECTIONS;
     }
 
+    /* Full-duty compare value: ARR in center-aligned mode, period - 1 in edge-aligned mode */
+#if CMIX_PWM_CENTER_ALIGNED
+    s_pwm_period_ticks = (uint16_t)auto_reload;
+#else
     s_pwm_period_ticks = (uint16_t)(auto_reload - 1U);
+#endif
 
     time_base.TIM_Prescaler = prescaler;
     time_base.TIM_AutoReloadValue = s_pwm_period_ticks;
     time_base.TIM_Direction = TIM_Direction_Up;
+#if CMIX_PWM_CENTER_ALIGNED
+    time_base.TIM_CenterAlignedMode = CMIX_PWM_CENTER_MODE;
+#else
     time_base.TIM_CenterAlignedMode = TIM_CenterAlignedMode_Disable;
+#endif
     TIM_TimeBaseInit(TIM1, &time_base);
     TIM_SetClockDivision(TIM1, TIM_ClockDiv_None);
 
+#if CMIX_PWM_CENTER_ALIGNED
+    TIM_ADCTrigger(TIM1, CMIX_PWM_ADC_JTRIGGER, TIM_ScanMode_Inject, ENABLE);
+    TIM_ADCTrigger(TIM1, CMIX_PWM_ADC_TRIGGER, TIM_ScanMode_Regular, ENABLE);
+#endif
+
+    /* Compare preload: OCR writes go to the shadow registers and both phases load together on the update event */
+    TIM1->CR |= TIM_CR_CPC;
+
     TIM_OCStructInit(&oc);
     oc.TIM_OCMode = TIM_OCMode_PWM1;
     oc.TIM_OCIdleState = TIM_OCIdleState_Low;
@@ -177,6 +280,13 @@ void CMix_InitPWMTimers(void)
     oc.TIM_Channel = TIM_Channel_1;
     TIM_OCInit(TIM1, &oc);
 
+#if CMIX_PWM_INTERLEAVE
+    /* PWM2 on phase B: active while the count is above the compare value, so
+       the on time is centred on the peak; a compare of ARR gives no output */
+    oc.TIM_OCMode = TIM_OCMode_PWM2;
+    oc.TIM_UpOCValue = s_pwm_period_ticks;
+    oc.TIM_DownOCValue = s_pwm_period_ticks;
+#endif
     oc.TIM_Channel = TIM_Channel_2;
     TIM_OCInit(TIM1, &oc);
 
@@ -201,13 +311,60 @@ uint16_t CMix_GetPwmPeriodTicks(void)
     return s_pwm_period_ticks;
 }
 
-void CMix_UpdateBridgeDuty(uint16_t phase_a_ticks, uint16_t phase_b_ticks)
+/*
+ * Stages both phases and commits them to the same period. With preload on,
+ * the pair only takes effect at the next update event, so a period never
+ * mixes old and new duties. A commit that lands within the guard window of
+ * the update could straddle it; it waits for the update to pass instead and
+ * is counted as missed (it takes effect one period late).
+ */
+bool CMix_UpdateBridgeDuty(uint16_t phase_a_ticks, uint16_t phase_b_ticks)
 {
     uint16_t safe_a = CMix_ClampDutyTicks(phase_a_ticks);
     uint16_t safe_b = CMix_ClampDutyTicks(phase_b_ticks);
+    uint32_t primask = __get_PRIMASK();
+    uint16_t headroom;
+    uint16_t last;
+    bool on_time = true;
+
+    __disable_irq();
+    headroom = CMix_PwmHeadroomTicks();
+    if (((TIM1->CR & TIM_CR_EN) != 0U) && (headroom < CMIX_PWM_COMMIT_GUARD_TICKS))
+    {
+        /* Headroom jumps back up once the update event has passed */
+        do
+        {
+            last = headroom;
+            headroom = CMix_PwmHeadroomTicks();
+        } while (headroom <= last);
+        on_time = false;
+        s_duty_commit_stats.missed++;
+    }
 
     TIM1->OCR[0] = ((u32)safe_a << 16) | safe_a;
+#if CMIX_PWM_INTERLEAVE
+    safe_b = (uint16_t)(s_pwm_period_ticks - safe_b);
+#endif
     TIM1->OCR[1] = ((u32)safe_b << 16) | safe_b;
+    s_duty_commit_stats.commits++;
+    __set_PRIMASK(primask);
+
+    return on_time;
+}
+
+void CMix_GetDutyCommitStats(CMix_DutyCommitStats *stats)
+{
+    uint32_t primask;
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = s_duty_commit_stats;
+    __set_PRIMASK(primask);
 }
 
 void CMix_EnablePWMOutputs(bool enable)
@@ -235,7 +392,7 @@ void CMix_InitADCSequence(void)
     ADC_InitTypeDef adc_init;
     size_t index;
 
-    adc_init.ADC_Channel = s_adc_sequence[0].channel;
+    adc_init.ADC_Channel = s_adc_slow_sequence[0].channel;
     adc_init.ADC_Mode = ADC_Mode_Single;
     adc_init.ADC_Prescaler = 30U;
     adc_init.ADC_RVSPS = ADC_RVSPS_VDDA;
@@ -245,22 +402,42 @@ void CMix_InitADCSequence(void)
 
     ADC_SampleTimeConfig(ADC0, CMIX_ADC_SAMPLE_TIME_CYCLES);
     ADC_ChannelSetupTimeConfig(ADC0, CMIX_ADC_SETUP_TIME_CYCLES);
-    ADC_RegularTriggerSource(ADC0, ADC_RegularTriggerSource_Software);
-    ADC_RegularScanCmd(ADC0, ENABLE);
-    ADC_RSCNTConfig(ADC0, (u32)(sizeof(s_adc_sequence) / sizeof(s_adc_sequence[0])));
 
-    for (index = 0U; index < (sizeof(s_adc_sequence) / sizeof(s_adc_sequence[0])); ++index)
+#if CMIX_PWM_CENTER_ALIGNED
+    ADC_InjectedTriggerSource(ADC0, ADC_InjectedTriggerSource_Timer);
+    ADC_InjectedTimerTriggerSource(ADC0, ADC_InjectedTimerTriggerSource_TIM1);
+#else
+    ADC_InjectedTriggerSource(ADC0, ADC_InjectedTriggerSource_Software);
+#endif
+    ADC_InjectedScanCmd(ADC0, ENABLE);
+    ADC_JSCNTConfig(ADC0, (u32)CMIX_ADC_FAST_LENGTH);
+    for (index = 0U; index < CMIX_ADC_FAST_LENGTH; ++index)
     {
-        ADC_ScanChannelConfig(ADC0, index, s_adc_sequence[index].channel);
+        ADC_InjectScanChannelConfig(ADC0, index, s_adc_fast_sequence[index].channel);
     }
 
+    s_adc_slow_slot = 0U;
+#if CMIX_PWM_CENTER_ALIGNED
+    ADC_RegularTriggerSource(ADC0, ADC_RegularTriggerSource_Timer);
+    ADC_RegularTimerTriggerSource(ADC0, ADC_RegularTimerTriggerSource_TIM1);
+#else
+    ADC_RegularTriggerSource(ADC0, ADC_RegularTriggerSource_Software);
+#endif
+    ADC_RegularScanCmd(ADC0, ENABLE);
+    ADC_RSCNTConfig(ADC0, 1U);
+    ADC_ScanChannelConfig(ADC0, 0U, s_adc_slow_sequence[s_adc_slow_slot].channel);
+
     ADC_Cmd(ADC0, ENABLE);
     CMix_WaitForAdcReady();
 }
 
 void CMix_ScheduleADCConversion(void)
 {
+#if !CMIX_PWM_CENTER_ALIGNED
+    /* Center-aligned mode: TIM1 triggers both groups at the valley, nothing to start here */
+    ADC_StartOfInjectedConversion(ADC0);
     ADC_StartOfRegularConversion(ADC0);
+#endif
 }
 
 void CMix_InitUART(uint32_t baudrate)
@@ -313,54 +490,26 @@ void CMix_ReadAnalogMeasurements(CMix_AnalogMeasurements *meas)
         return;
     }
 
-    if (ADC_GetFlagStatus(ADC0, ADC_FLAG_EOS) == RESET)
+    if (ADC_GetFlagStatus(ADC0, ADC_FLAG_JEOS) != RESET)
     {
-        *meas = s_measurement_cache;
-        return;
+        for (index = 0U; index < CMIX_ADC_FAST_LENGTH; ++index)
+        {
+            u16 raw_counts = ADC_GetInjectScanConversionValue(ADC0, index);
+            *s_adc_fast_sequence[index].target =
+                (float)CMix_AdcDecimatorPush(&s_adc_fast_decimator[index], raw_counts,
+                                             s_adc_fast_sequence[index].osr_log2) *
+                CMIX_ADC_EXT_TO_UNIT;
+        }
+        ADC_ClearFlag(ADC0, ADC_FLAG_JEOS | ADC_FLAG_JEOC);
     }
 
-    for (index = 0U; index < (sizeof(s_adc_sequence) / sizeof(s_adc_sequence[0])); ++index)
+    if (ADC_GetFlagStatus(ADC0, ADC_FLAG_EOS) != RESET)
     {
-        u16 raw_counts = ADC_GetRegularScanConversionValue(ADC0, index);
-        float normalized = (float)raw_counts / CMIX_ADC_MAX_COUNTS;
-
-        switch (index)
-        {
-            case 0:
-                s_measurement_cache.i_bat = normalized;
-                break;
-            case 1:
-                s_measurement_cache.i_out = normalized;
-                break;
-            case 2:
-            case 3:
-            case 4:
-                s_measurement_cache.cell_voltage[index - 2U] = normalized;
-                break;
-            case 5:
-                s_measurement_cache.v_out_bus = normalized;
-                break;
-            case 6:
-                s_measurement_cache.v_pack_total = normalized;
-                break;
-            case 7:
-                s_measurement_cache.ntc_temp[0] = normalized;
-                break;
-            case 8:
-                s_measurement_cache.ntc_temp[1] = normalized;
-                break;
-            case 9:
-                s_ntc_mux_cached[s_ntc_mux_selects_ntc4 ? 1U : 0U] = normalized;
-                s_measurement_cache.ntc_temp[2] = s_ntc_mux_cached[0];
-                s_measurement_cache.ntc_temp[3] = s_ntc_mux_cached[1];
-                break;
-            default:
-                break;
-        }
+        CMix_ReadSlowChannel();
+        ADC_ClearFlag(ADC0, ADC_FLAG_EOS | ADC_FLAG_EOC);
     }
 
     *meas = s_measurement_cache;
-    ADC_ClearFlag(ADC0, ADC_FLAG_EOS | ADC_FLAG_EOC);
 }
 
 void CMix_UpdateBoardStatus(CMix_BoardStatus *status)
@@ -480,9 +629,13 @@ static void CMix_ConfigPwmPins(void)
 
 static void CMix_ConfigAdcPins(void)
 {
-    for (size_t index = 0U; index < (sizeof(s_adc_sequence) / sizeof(s_adc_sequence[0])); ++index)
+    for (size_t index = 0U; index < CMIX_ADC_FAST_LENGTH; ++index)
+    {
+        CMix_EnableAnalogFunction(s_adc_fast_sequence[index].pin);
+    }
+    for (size_t index = 0U; index < CMIX_ADC_SLOW_LENGTH; ++index)
     {
-        CMix_EnableAnalogFunction(s_adc_sequence[index].pin);
+        CMix_EnableAnalogFunction(s_adc_slow_sequence[index].pin);
     }
 }
 
@@ -534,6 +687,59 @@ static uint16_t CMix_ClampDutyTicks(uint16_t duty_ticks)
     return duty_ticks;
 }
 
+/* Counter ticks left before the next update event (the valley, and the peak with double update). */
+static uint16_t CMix_PwmHeadroomTicks(void)
+{
+    uint16_t count = (uint16_t)TIM1->CNTR;
+
+#if CMIX_PWM_CENTER_ALIGNED
+    if ((TIM1->CR & TIM_CR_DIR) != 0U)
+    {
+        return count;
+    }
+#if CMIX_PWM_DOUBLE_UPDATE
+    return (uint16_t)(s_pwm_period_ticks - count);
+#else
+    return (uint16_t)(2U * s_pwm_period_ticks - count);
+#endif
+#else
+    return (uint16_t)(s_pwm_period_ticks - count);
+#endif
+}
+
+/*
+ * Adds one conversion and returns the latest decimated value (extended code).
+ * The first sample seeds the output so consumers never see zero before the
+ * first full window.
+ */
+static uint16_t CMix_AdcDecimatorPush(CMix_AdcDecimator *decimator, uint16_t raw_counts, uint8_t osr_log2)
+{
+    decimator->sum += raw_counts;
+    decimator->count++;
+
+    if (!decimator->primed)
+    {
+        decimator->output = (uint16_t)(raw_counts << CMIX_ADC_EXT_SHIFT);
+        decimator->primed = true;
+    }
+
+    if (decimator->count >= (1U << osr_log2))
+    {
+        if (osr_log2 <= CMIX_ADC_EXT_SHIFT)
+        {
+            decimator->output = (uint16_t)(decimator->sum << (CMIX_ADC_EXT_SHIFT - osr_log2));
+        }
+        else
+        {
+            decimator->output = (uint16_t)(decimator->sum >> (osr_log2 - CMIX_ADC_EXT_SHIFT));
+        }
+        decimator->sum = 0U;
+        decimator->count = 0U;
+    }
+
+    return decimator->output;
+}
+
 #ifdef USE_FULL_ASSERT
 void assert_failed(uint8_t *file, u32 line)
 {
@@ -546,3 +752,37 @@ void assert_failed(uint8_t *file, u32 line)
 }
 #endif /* USE_FULL_ASSERT */
 
+/*
+ * Stores the round-robin slot that just completed and points the regular slot
+ * at the next monitoring channel. The NTC mux is switched right after its own
+ * sample is taken, so the divider settles during the other slots' conversions
+ * and no conversion ever waits for it.
+ */
+static void CMix_ReadSlowChannel(void)
+{
+    const CMix_AdcSequenceEntry *entry = &s_adc_slow_sequence[s_adc_slow_slot];
+    u16 raw_counts = ADC_GetRegularScanConversionValue(ADC0, 0U);
+
+    if (s_adc_slow_slot == CMIX_ADC_NTC_MUX_SLOT)
+    {
+        uint8_t position = s_ntc_mux_selects_ntc4 ? 1U : 0U;
+
+        s_measurement_cache.ntc_temp[2U + position] =
+            (float)CMix_AdcDecimatorPush(&s_ntc_mux_decimator[position], raw_counts, entry->osr_log2) *
+            CMIX_ADC_EXT_TO_UNIT;
+        CMix_SelectNTCChannel(!s_ntc_mux_selects_ntc4);
+    }
+    else
+    {
+        *entry->target =
+            (float)CMix_AdcDecimatorPush(&s_adc_slow_decimator[s_adc_slow_slot], raw_counts, entry->osr_log2) *
+            CMIX_ADC_EXT_TO_UNIT;
+    }
+
+    s_adc_slow_slot++;
+    if (s_adc_slow_slot >= CMIX_ADC_SLOW_LENGTH)
+    {
+        s_adc_slow_slot = 0U;
+    }
+    ADC_ScanChannelConfig(ADC0, 0U, s_adc_slow_sequence[s_adc_slow_slot].channel);
+}
@@ -6,6 +6,16 @@
 
 #include "CMix_pinmap.h"
 
+/*
+ * Two-phase interleave: phase B (TIM1 CH2) is centred on the counter peak,
+ * 180 degrees from phase A (CH1) on the valley, and the control layer trims
+ * the two duties so the phases share the load current. The IBat / IOut sense
+ * points are then the phase A / phase B shunts. Needs center-aligned PWM.
+ */
+#ifndef CMIX_PWM_INTERLEAVE
+#define CMIX_PWM_INTERLEAVE          0
+#endif
+
 typedef struct
 {
     float v_pack_total;
@@ -16,6 +26,12 @@ typedef struct
     float ntc_temp[4];
 } CMix_AnalogMeasurements;
 
+typedef struct
+{
+    uint32_t commits;
+    uint32_t missed;        /* commits that fell inside the guard window and slipped one period */
+} CMix_DutyCommitStats;
+
 typedef struct
 {
     bool fault_bkin_triggered;
@@ -28,7 +44,8 @@ void CMix_InitClocks(void);
 void CMix_InitGPIO(void);
 void CMix_InitPWMTimers(void);
 uint16_t CMix_GetPwmPeriodTicks(void);
-void CMix_UpdateBridgeDuty(uint16_t phase_a_ticks, uint16_t phase_b_ticks);
+bool CMix_UpdateBridgeDuty(uint16_t phase_a_ticks, uint16_t phase_b_ticks);
+void CMix_GetDutyCommitStats(CMix_DutyCommitStats *stats);
 void CMix_EnablePWMOutputs(bool enable);
 void CMix_InitADCSequence(void);
 void CMix_ScheduleADCConversion(void);
@@ -1,5 +1,6 @@
 ﻿#include "CMix_control.h"
 
+#include <math.h>
 #include <string.h>
 
 static void CMix_ControlHandleIdle(CMix_ControlContext *ctx);
@@ -8,7 +9,11 @@ static void CMix_ControlHandleActive(CMix_ControlContext *ctx);
 static void CMix_ControlHandleFault(CMix_ControlContext *ctx);
 static void CMix_ControlApplyDuty(CMix_ControlContext *ctx);
 static float CMix_ClampFloat(float value, float min_value, float max_value);
-static float CMix_ComputeDutyFromMeasurements(const CMix_ControlContext *ctx);
+static float CMix_ComputeDutyFromMeasurements(CMix_ControlContext *ctx);
+static float CMix_ReciprocalSeed(float divisor);
+#if CMIX_PWM_INTERLEAVE
+static float CMix_ControlUpdateShare(CMix_ControlContext *ctx);
+#endif
 
 static const float CMIX_PRECHARGE_ENTRY_LEVEL = 0.05f;
 static const float CMIX_PRECHARGE_TARGET_DUTY = 0.10f;
@@ -16,6 +21,47 @@ static const float CMIX_PRECHARGE_STEP = 0.01f;
 static const float CMIX_MIN_ACTIVE_DUTY = 0.05f;
 static const float CMIX_MAX_ACTIVE_DUTY = 0.95f;
 
+#if CMIX_PWM_INTERLEAVE
+/*
+ * Phase current sharing: a pure integrator on i_a - i_b (normalised ADC full
+ * scale) moves duty from the phase carrying more current to the other one.
+ * Errors inside the deadband hold the trim, and each step's error is clamped
+ * so a load transient does not wind it up.
+ */
+static const float CMIX_SHARE_KI = 0.002f;
+static const float CMIX_SHARE_DEADBAND = 0.005f;
+static const float CMIX_SHARE_ERROR_MAX = 0.10f;
+static const float CMIX_SHARE_MAX_TRIM = 0.03f;
+#endif
+
+/*
+ * Feed-forward divisors below this level (normalised ADC full scale) are treated
+ * as "bus not present": the duty falls back to its limit and the reciprocal is
+ * clamped, so it stays finite for zero, negative or NaN readings.
+ */
+static const float CMIX_FEEDFORWARD_MIN_DIVISOR = 0.01f;
+
+/*
+ * Reciprocal estimate: a 16-entry seed table over the mantissa range [0.5, 1)
+ * (relative error <= 1/32), refined by Newton steps x += x * (1 - d * x).
+ * Each step squares the relative error, so a bus voltage that moved by less
+ * than CMIX_RECIP_RESEED_ERROR needs one or two steps from the previous value.
+ */
+#define CMIX_RECIP_SEED_ENTRIES      16U
+#define CMIX_RECIP_SEED(i)           (1.0f / (0.5f + ((float)(i) + 0.5f) / (2.0f * (float)CMIX_RECIP_SEED_ENTRIES)))
+#define CMIX_RECIP_MAX_NEWTON_STEPS  3U
+
+static const float CMIX_RECIP_RESEED_ERROR = 1.0f / 32.0f;
+static const float CMIX_RECIP_TOLERANCE = 1.0e-6f;
+
+static const float s_recip_seed[CMIX_RECIP_SEED_ENTRIES] =
+{
+    CMIX_RECIP_SEED(0),  CMIX_RECIP_SEED(1),  CMIX_RECIP_SEED(2),  CMIX_RECIP_SEED(3),
+    CMIX_RECIP_SEED(4),  CMIX_RECIP_SEED(5),  CMIX_RECIP_SEED(6),  CMIX_RECIP_SEED(7),
+    CMIX_RECIP_SEED(8),  CMIX_RECIP_SEED(9),  CMIX_RECIP_SEED(10), CMIX_RECIP_SEED(11),
+    CMIX_RECIP_SEED(12), CMIX_RECIP_SEED(13), CMIX_RECIP_SEED(14), CMIX_RECIP_SEED(15)
+};
+
 void CMix_ControlInit(CMix_ControlContext *ctx)
 {
     if (ctx == NULL)
@@ -26,6 +72,8 @@ void CMix_ControlInit(CMix_ControlContext *ctx)
     memset(ctx, 0, sizeof(*ctx));
     ctx->state = CMIX_STATE_IDLE;
     ctx->direction = CMIX_DIRECTION_BUCK;
+    CMix_ReciprocalReset(&ctx->ff_out_bus);
+    CMix_ReciprocalReset(&ctx->ff_pack_total);
 }
 
 void CMix_ControlSetDirection(CMix_ControlContext *ctx, CMix_PowerDirection direction)
@@ -43,6 +91,7 @@ void CMix_ControlSetDirection(CMix_ControlContext *ctx, CMix_PowerDirection dire
             ctx->state = CMIX_STATE_PRECHARGE;
             ctx->duty_cmd_phase_a = 0.0f;
             ctx->duty_cmd_phase_b = 0.0f;
+            ctx->phase_trim = 0.0f;
         }
     }
 }
@@ -94,11 +143,65 @@ void CMix_ControlNotifyFault(CMix_ControlContext *ctx)
     ctx->state = CMIX_STATE_FAULT;
 }
 
+void CMix_ReciprocalReset(CMix_Reciprocal *recip)
+{
+    if (recip == NULL)
+    {
+        return;
+    }
+
+    recip->divisor = 0.0f;
+    recip->reciprocal = 0.0f;
+}
+
+/*
+ * Returns 1 / divisor without a divide. An unchanged divisor costs one compare;
+ * a small change is tracked with Newton steps from the previous estimate, and a
+ * large change (or the first call) re-seeds from the table.
+ */
+float CMix_ReciprocalUpdate(CMix_Reciprocal *recip, float divisor)
+{
+    float error;
+    uint32_t step;
+
+    if (recip == NULL)
+    {
+        return 0.0f;
+    }
+
+    if (!(divisor > CMIX_FEEDFORWARD_MIN_DIVISOR))
+    {
+        divisor = CMIX_FEEDFORWARD_MIN_DIVISOR;
+    }
+
+    if (divisor == recip->divisor)
+    {
+        return recip->reciprocal;
+    }
+
+    error = 1.0f - divisor * recip->reciprocal;
+    if (fabsf(error) > CMIX_RECIP_RESEED_ERROR)
+    {
+        recip->reciprocal = CMix_ReciprocalSeed(divisor);
+        error = 1.0f - divisor * recip->reciprocal;
+    }
+
+    for (step = 0U; (step < CMIX_RECIP_MAX_NEWTON_STEPS) && (fabsf(error) > CMIX_RECIP_TOLERANCE); ++step)
+    {
+        recip->reciprocal += recip->reciprocal * error;
+        error = 1.0f - divisor * recip->reciprocal;
+    }
+
+    recip->divisor = divisor;
+    return recip->reciprocal;
+}
+
 static void CMix_ControlHandleIdle(CMix_ControlContext *ctx)
 {
     CMix_EnablePWMOutputs(false);
     ctx->duty_cmd_phase_a = 0.0f;
     ctx->duty_cmd_phase_b = 0.0f;
+    ctx->phase_trim = 0.0f;
 
     if (!ctx->board_status.fault_bkin_triggered)
     {
@@ -130,8 +233,15 @@ static void CMix_ControlHandleActive(CMix_ControlContext *ctx)
     CMix_EnablePWMOutputs(true);
 
     float duty = CMix_ComputeDutyFromMeasurements(ctx);
+#if CMIX_PWM_INTERLEAVE
+    float trim = CMix_ControlUpdateShare(ctx);
+
+    ctx->duty_cmd_phase_a = duty - trim;
+    ctx->duty_cmd_phase_b = duty + trim;
+#else
     ctx->duty_cmd_phase_a = duty;
     ctx->duty_cmd_phase_b = duty;
+#endif
 
     if ((ctx->measurements.v_pack_total <= CMIX_PRECHARGE_ENTRY_LEVEL) &&
         (ctx->measurements.v_out_bus <= CMIX_PRECHARGE_ENTRY_LEVEL))
@@ -145,6 +255,7 @@ static void CMix_ControlHandleFault(CMix_ControlContext *ctx)
     CMix_EnablePWMOutputs(false);
     ctx->duty_cmd_phase_a = 0.0f;
     ctx->duty_cmd_phase_b = 0.0f;
+    ctx->phase_trim = 0.0f;
 }
 
 static void CMix_ControlApplyDuty(CMix_ControlContext *ctx)
@@ -187,32 +298,69 @@ static float CMix_ClampFloat(float value, float min_value, float max_value)
     return value;
 }
 
-static float CMix_ComputeDutyFromMeasurements(const CMix_ControlContext *ctx)
+static float CMix_ComputeDutyFromMeasurements(CMix_ControlContext *ctx)
 {
     float duty;
 
     if (ctx->direction == CMIX_DIRECTION_BUCK)
     {
-        if (ctx->measurements.v_out_bus <= 0.01f)
+        if (!(ctx->measurements.v_out_bus > CMIX_FEEDFORWARD_MIN_DIVISOR))
         {
             duty = CMIX_MIN_ACTIVE_DUTY;
         }
         else
         {
-            duty = ctx->measurements.v_pack_total / ctx->measurements.v_out_bus;
+            duty = ctx->measurements.v_pack_total *
+                   CMix_ReciprocalUpdate(&ctx->ff_out_bus, ctx->measurements.v_out_bus);
         }
     }
     else
     {
-        if (ctx->measurements.v_pack_total <= 0.01f)
+        if (!(ctx->measurements.v_pack_total > CMIX_FEEDFORWARD_MIN_DIVISOR))
         {
             duty = CMIX_MAX_ACTIVE_DUTY;
         }
         else
         {
-            duty = ctx->measurements.v_out_bus / ctx->measurements.v_pack_total;
+            duty = ctx->measurements.v_out_bus *
+                   CMix_ReciprocalUpdate(&ctx->ff_pack_total, ctx->measurements.v_pack_total);
         }
     }
 
     return CMix_ClampFloat(duty, CMIX_MIN_ACTIVE_DUTY, CMIX_MAX_ACTIVE_DUTY);
 }
+
+static float CMix_ReciprocalSeed(float divisor)
+{
+    int exponent;
+    float mantissa = frexpf(divisor, &exponent);
+    uint32_t index = (uint32_t)((mantissa - 0.5f) * (2.0f * (float)CMIX_RECIP_SEED_ENTRIES));
+
+    if (index >= CMIX_RECIP_SEED_ENTRIES)
+    {
+        index = CMIX_RECIP_SEED_ENTRIES - 1U;
+    }
+
+    return ldexpf(s_recip_seed[index], -exponent);
+}
+
+#if CMIX_PWM_INTERLEAVE
+/*
+ * With interleave on, i_bat / i_out are the phase A / phase B currents. The
+ * signed difference works in both directions: more high-side duty on a phase
+ * always pushes its current towards the output bus.
+ */
+static float CMix_ControlUpdateShare(CMix_ControlContext *ctx)
+{
+    float error = ctx->measurements.i_bat - ctx->measurements.i_out;
+
+    if (fabsf(error) > CMIX_SHARE_DEADBAND)
+    {
+        error = CMix_ClampFloat(error, -CMIX_SHARE_ERROR_MAX, CMIX_SHARE_ERROR_MAX);
+        ctx->phase_trim = CMix_ClampFloat(ctx->phase_trim + CMIX_SHARE_KI * error,
+                                          -CMIX_SHARE_MAX_TRIM, CMIX_SHARE_MAX_TRIM);
+    }
+
+    return ctx->phase_trim;
+}
+#endif
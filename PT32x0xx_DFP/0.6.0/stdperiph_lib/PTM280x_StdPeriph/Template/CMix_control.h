@@ -20,6 +20,13 @@ typedef enum
     CMIX_STATE_FAULT
 } CMix_ControlState;
 
+/* Running reciprocal of a slowly varying divisor (see CMix_ReciprocalUpdate). */
+typedef struct
+{
+    float divisor;
+    float reciprocal;
+} CMix_Reciprocal;
+
 typedef struct
 {
     CMix_ControlState state;
@@ -28,6 +35,9 @@ typedef struct
     CMix_BoardStatus board_status;
     float duty_cmd_phase_a;
     float duty_cmd_phase_b;
+    float phase_trim;               /* interleave sharing: duty moved from phase A to phase B */
+    CMix_Reciprocal ff_out_bus;
+    CMix_Reciprocal ff_pack_total;
 } CMix_ControlContext;
 
 void CMix_ControlInit(CMix_ControlContext *ctx);
@@ -35,4 +45,7 @@ void CMix_ControlSetDirection(CMix_ControlContext *ctx, CMix_PowerDirection dire
 void CMix_ControlUpdate(CMix_ControlContext *ctx);
 void CMix_ControlNotifyFault(CMix_ControlContext *ctx);
 
+void CMix_ReciprocalReset(CMix_Reciprocal *recip);
+float CMix_ReciprocalUpdate(CMix_Reciprocal *recip, float divisor);
+
 #endif /* CMIX_CONTROL_H */
@@ -0,0 +1,416 @@
+/*
+ * Host tests for the Template control layer.
+ *
+ * CMix_control.c is compiled unchanged for Linux and linked against the stub
+ * board below, which feeds measurements in and captures the bridge duty
+ * written by CMix_ControlUpdate. Run with "make check"; the exit code is the
+ * number of failed checks.
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CMix_board.h"
+#include "CMix_control.h"
+
+#define TEST_PWM_PERIOD_TICKS   639U
+#define TEST_ADC_FULL_SCALE     4095.0
+#define TEST_MIN_DIVISOR        0.01
+#define TEST_MIN_DUTY           0.05
+#define TEST_MAX_DUTY           0.95
+#define TEST_RECIP_TOLERANCE    2.0e-6
+
+static CMix_AnalogMeasurements s_stub_measurements;
+static uint16_t s_stub_duty_a;
+static uint16_t s_stub_duty_b;
+static bool s_stub_outputs_enabled;
+static unsigned s_failures;
+
+static void Test_Check(bool condition, const char *format, ...) __attribute__((format(printf, 2, 3)));
+static void Test_SetBus(double v_pack_total, double v_out_bus);
+static void Test_RunToActive(CMix_ControlContext *ctx, CMix_PowerDirection direction);
+static double Test_RelativeError(float reciprocal, double divisor);
+static double Test_ReferenceDuty(CMix_PowerDirection direction, double v_pack_total, double v_out_bus);
+static void Test_ReciprocalRange(void);
+static void Test_ReciprocalTracking(void);
+static void Test_ReciprocalGuard(void);
+static void Test_FeedforwardDuty(CMix_PowerDirection direction, const char *name);
+static void Test_FeedforwardGuard(void);
+#if CMIX_PWM_INTERLEAVE
+static void Test_SetPhaseCurrents(double i_phase_a, double i_phase_b);
+static void Test_PhaseShare(void);
+#endif
+
+/* Board stubs */
+
+void CMix_ReadAnalogMeasurements(CMix_AnalogMeasurements *meas)
+{
+    *meas = s_stub_measurements;
+}
+
+void CMix_UpdateBoardStatus(CMix_BoardStatus *status)
+{
+    status->fault_bkin_triggered = false;
+    status->fault_over_temperature = false;
+    status->fault_comm_lost = false;
+}
+
+void CMix_ProcessFaults(void)
+{
+}
+
+void CMix_EnablePWMOutputs(bool enable)
+{
+    s_stub_outputs_enabled = enable;
+}
+
+uint16_t CMix_GetPwmPeriodTicks(void)
+{
+    return TEST_PWM_PERIOD_TICKS;
+}
+
+bool CMix_UpdateBridgeDuty(uint16_t phase_a_ticks, uint16_t phase_b_ticks)
+{
+    s_stub_duty_a = phase_a_ticks;
+    s_stub_duty_b = phase_b_ticks;
+    return true;
+}
+
+void CMix_ScheduleADCConversion(void)
+{
+}
+
+int main(void)
+{
+    printf("== reciprocal\n");
+    Test_ReciprocalRange();
+    Test_ReciprocalTracking();
+    Test_ReciprocalGuard();
+
+    printf("== feed-forward duty\n");
+    Test_FeedforwardDuty(CMIX_DIRECTION_BUCK, "buck");
+    Test_FeedforwardDuty(CMIX_DIRECTION_BOOST, "boost");
+    Test_FeedforwardGuard();
+
+#if CMIX_PWM_INTERLEAVE
+    printf("== interleave current sharing\n");
+    Test_PhaseShare();
+#endif
+
+    printf("%s: %u failed\n", (s_failures == 0U) ? "PASS" : "FAIL", s_failures);
+    return (int)s_failures;
+}
+
+static void Test_Check(bool condition, const char *format, ...)
+{
+    va_list args;
+
+    printf("  [%s] ", condition ? " OK " : "FAIL");
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+
+    if (!condition)
+    {
+        s_failures++;
+    }
+}
+
+static void Test_SetBus(double v_pack_total, double v_out_bus)
+{
+    s_stub_measurements.v_pack_total = (float)v_pack_total;
+    s_stub_measurements.v_out_bus = (float)v_out_bus;
+}
+
+static void Test_RunToActive(CMix_ControlContext *ctx, CMix_PowerDirection direction)
+{
+    unsigned i;
+
+    CMix_ControlInit(ctx);
+    CMix_ControlSetDirection(ctx, direction);
+    Test_SetBus(0.5, 0.5);
+    for (i = 0U; (i < 100U) && (ctx->state != CMIX_STATE_ACTIVE); ++i)
+    {
+        CMix_ControlUpdate(ctx);
+    }
+}
+
+static double Test_RelativeError(float reciprocal, double divisor)
+{
+    return fabs((double)reciprocal * divisor - 1.0);
+}
+
+static double Test_ReferenceDuty(CMix_PowerDirection direction, double v_pack_total, double v_out_bus)
+{
+    double duty;
+
+    if (direction == CMIX_DIRECTION_BUCK)
+    {
+        duty = (v_out_bus <= TEST_MIN_DIVISOR) ? TEST_MIN_DUTY : v_pack_total / v_out_bus;
+    }
+    else
+    {
+        duty = (v_pack_total <= TEST_MIN_DIVISOR) ? TEST_MAX_DUTY : v_out_bus / v_pack_total;
+    }
+
+    return fmin(fmax(duty, TEST_MIN_DUTY), TEST_MAX_DUTY);
+}
+
+/* Fresh estimate (table seed + Newton) across the guard level up to well past full scale. */
+static void Test_ReciprocalRange(void)
+{
+    const unsigned points = 20000U;
+    CMix_Reciprocal recip;
+    double worst = 0.0, worst_at = 0.0;
+    unsigned i;
+
+    for (i = 0U; i <= points; ++i)
+    {
+        double divisor = TEST_MIN_DIVISOR * pow(4096.0 / TEST_MIN_DIVISOR, (double)i / points);
+        double error;
+
+        CMix_ReciprocalReset(&recip);
+        error = Test_RelativeError(CMix_ReciprocalUpdate(&recip, (float)divisor), (float)divisor);
+        if (error > worst)
+        {
+            worst = error;
+            worst_at = divisor;
+        }
+    }
+    Test_Check(worst <= TEST_RECIP_TOLERANCE, "seeded 0.01 .. 4096: worst relative error %.2e at %.5g",
+               worst, worst_at);
+
+    for (i = 0U; i <= 4095U; ++i)
+    {
+        double divisor = (double)(float)(i / TEST_ADC_FULL_SCALE);
+        double expected = 1.0 / fmax(divisor, TEST_MIN_DIVISOR);
+        double error;
+
+        CMix_ReciprocalReset(&recip);
+        error = fabs(CMix_ReciprocalUpdate(&recip, (float)divisor) * (1.0 / expected) - 1.0);
+        if (error > worst)
+        {
+            worst = error;
+            worst_at = divisor;
+        }
+    }
+    Test_Check(worst <= TEST_RECIP_TOLERANCE, "every ADC code 0 .. 4095: worst relative error %.2e at %.5g",
+               worst, worst_at);
+}
+
+/* Incremental updates: slow ramps, ADC noise and large steps that force a re-seed. */
+static void Test_ReciprocalTracking(void)
+{
+    CMix_Reciprocal recip;
+    double worst = 0.0;
+    float previous, divisor = 0.5f;
+    unsigned i, unchanged_mismatch = 0U;
+
+    srand(12345);
+    CMix_ReciprocalReset(&recip);
+    for (i = 0U; i < 200000U; ++i)
+    {
+        int code = (int)(divisor * TEST_ADC_FULL_SCALE);
+        double error;
+
+        if ((i % 5000U) == 0U)
+        {
+            code = rand() % 4096;
+        }
+        else
+        {
+            code += (rand() % 7) - 3;
+        }
+        if (code < 41)
+        {
+            code = 41;
+        }
+        if (code > 4095)
+        {
+            code = 4095;
+        }
+        divisor = (float)(code / TEST_ADC_FULL_SCALE);
+
+        error = Test_RelativeError(CMix_ReciprocalUpdate(&recip, divisor), divisor);
+        if (error > worst)
+        {
+            worst = error;
+        }
+
+        previous = recip.reciprocal;
+        if (CMix_ReciprocalUpdate(&recip, divisor) != previous)
+        {
+            unchanged_mismatch++;
+        }
+    }
+    Test_Check(worst <= TEST_RECIP_TOLERANCE, "random walk with steps, 200000 updates: worst relative error %.2e",
+               worst);
+    Test_Check(unchanged_mismatch == 0U, "unchanged divisor returns the cached estimate (%u mismatches)",
+               unchanged_mismatch);
+}
+
+/* Readings at or below the guard level (including zero, negative and NaN) clamp to the guard. */
+static void Test_ReciprocalGuard(void)
+{
+    const float inputs[] = {0.0f, -0.0f, -1.0f, 1.0e-30f, 0.005f, 0.01f, NAN, -INFINITY};
+    CMix_Reciprocal recip;
+    unsigned i, bad = 0U;
+
+    for (i = 0U; i < sizeof(inputs) / sizeof(inputs[0]); ++i)
+    {
+        float result;
+
+        CMix_ReciprocalReset(&recip);
+        result = CMix_ReciprocalUpdate(&recip, inputs[i]);
+        if (!isfinite(result) || Test_RelativeError(result, (float)TEST_MIN_DIVISOR) > TEST_RECIP_TOLERANCE)
+        {
+            printf("         input %g -> %g\n", (double)inputs[i], (double)result);
+            bad++;
+        }
+    }
+    Test_Check(bad == 0U, "zero/negative/NaN/sub-guard divisors give 1 / 0.01 (%u bad)", bad);
+}
+
+/* Duty written to the bridge across the normalised input range, against a double-precision divide. */
+static void Test_FeedforwardDuty(CMix_PowerDirection direction, const char *name)
+{
+    CMix_ControlContext ctx;
+    unsigned pack, out, points = 0U, mismatches = 0U;
+    long worst = 0;
+
+    Test_RunToActive(&ctx, direction);
+    Test_Check(ctx.state == CMIX_STATE_ACTIVE && s_stub_outputs_enabled, "%s: precharge reaches ACTIVE", name);
+
+    for (pack = 0U; pack <= 4095U; pack += 31U)
+    {
+        for (out = 0U; out <= 4095U; out += 37U)
+        {
+            double v_pack = (float)(pack / TEST_ADC_FULL_SCALE);
+            double v_out = (float)(out / TEST_ADC_FULL_SCALE);
+            long expected;
+            long diff;
+
+            if ((v_pack <= 0.05) && (v_out <= 0.05))
+            {
+                continue;
+            }
+            Test_SetBus(v_pack, v_out);
+            CMix_ControlUpdate(&ctx);
+            expected = (long)(Test_ReferenceDuty(direction, v_pack, v_out) * (TEST_PWM_PERIOD_TICKS + 1U));
+            diff = labs((long)s_stub_duty_a - expected);
+            if (diff > worst)
+            {
+                worst = diff;
+            }
+            if ((diff > 1) || (s_stub_duty_a != s_stub_duty_b) || (ctx.state != CMIX_STATE_ACTIVE))
+            {
+                mismatches++;
+            }
+            points++;
+        }
+    }
+    Test_Check(mismatches == 0U, "%s: %u input pairs, worst duty error %ld tick (%u over 1 tick)", name, points,
+               worst, mismatches);
+}
+
+/* Divisor channel absent: buck falls back to the minimum duty, boost to the maximum. */
+static void Test_FeedforwardGuard(void)
+{
+    const uint16_t min_ticks = (uint16_t)(TEST_MIN_DUTY * (TEST_PWM_PERIOD_TICKS + 1U));
+    const uint16_t max_ticks = (uint16_t)(TEST_MAX_DUTY * (TEST_PWM_PERIOD_TICKS + 1U));
+    CMix_ControlContext ctx;
+
+    Test_RunToActive(&ctx, CMIX_DIRECTION_BUCK);
+    Test_SetBus(0.5, 0.0);
+    CMix_ControlUpdate(&ctx);
+    Test_Check(s_stub_duty_a == min_ticks, "buck, v_out_bus = 0: duty %u ticks (minimum %u)",
+               (unsigned)s_stub_duty_a, (unsigned)min_ticks);
+    Test_SetBus(0.5, 0.01);
+    CMix_ControlUpdate(&ctx);
+    Test_Check(s_stub_duty_a == min_ticks, "buck, v_out_bus at guard level: duty %u ticks (minimum %u)",
+               (unsigned)s_stub_duty_a, (unsigned)min_ticks);
+    Test_SetBus(0.5, NAN);
+    CMix_ControlUpdate(&ctx);
+    Test_Check(s_stub_duty_a == min_ticks, "buck, v_out_bus NaN: duty %u ticks (minimum %u)",
+               (unsigned)s_stub_duty_a, (unsigned)min_ticks);
+
+    Test_RunToActive(&ctx, CMIX_DIRECTION_BOOST);
+    Test_SetBus(0.0, 0.5);
+    CMix_ControlUpdate(&ctx);
+    Test_Check(s_stub_duty_a == max_ticks, "boost, v_pack_total = 0: duty %u ticks (maximum %u)",
+               (unsigned)s_stub_duty_a, (unsigned)max_ticks);
+    Test_SetBus(0.011, 0.5);
+    CMix_ControlUpdate(&ctx);
+    Test_Check(s_stub_duty_a == max_ticks, "boost, v_pack_total just above guard: duty clamps to %u ticks",
+               (unsigned)s_stub_duty_a);
+}
+
+#if CMIX_PWM_INTERLEAVE
+static void Test_SetPhaseCurrents(double i_phase_a, double i_phase_b)
+{
+    s_stub_measurements.i_bat = (float)i_phase_a;
+    s_stub_measurements.i_out = (float)i_phase_b;
+}
+
+/*
+ * Phase A carries more current: duty moves to phase B up to the trim limit.
+ * Against a resistive phase model the trim settles the imbalance inside the
+ * deadband, a difference inside the deadband leaves the duties equal, and a
+ * fault clears the trim.
+ */
+static void Test_PhaseShare(void)
+{
+    const double imbalance = 0.04;
+    const double gain = 2.0;
+    CMix_ControlContext ctx;
+    double i_phase_a = 0.0;
+    double i_phase_b = 0.0;
+    unsigned i;
+
+    Test_RunToActive(&ctx, CMIX_DIRECTION_BUCK);
+    Test_SetBus(0.25, 0.5);
+    Test_SetPhaseCurrents(0.30, 0.20);
+    for (i = 0U; i < 200U; ++i)
+    {
+        CMix_ControlUpdate(&ctx);
+    }
+    Test_Check((s_stub_duty_a < s_stub_duty_b) && (fabs(ctx.phase_trim - 0.03) < 1.0e-6),
+               "phase A high: duty %u / %u ticks, trim %.4f at the limit", (unsigned)s_stub_duty_a,
+               (unsigned)s_stub_duty_b, (double)ctx.phase_trim);
+
+    Test_RunToActive(&ctx, CMIX_DIRECTION_BUCK);
+    Test_SetBus(0.25, 0.5);
+    for (i = 0U; i < 2000U; ++i)
+    {
+        i_phase_a = 0.25 + imbalance / 2.0 - gain * ctx.phase_trim;
+        i_phase_b = 0.25 - imbalance / 2.0 + gain * ctx.phase_trim;
+        Test_SetPhaseCurrents(i_phase_a, i_phase_b);
+        CMix_ControlUpdate(&ctx);
+    }
+    Test_Check(fabs(i_phase_a - i_phase_b) <= 0.005 + 1.0e-6, "resistive phases, %.2f imbalance: settles to %.4f",
+               imbalance, i_phase_a - i_phase_b);
+
+    Test_RunToActive(&ctx, CMIX_DIRECTION_BUCK);
+    Test_SetBus(0.25, 0.5);
+    Test_SetPhaseCurrents(0.252, 0.248);
+    for (i = 0U; i < 200U; ++i)
+    {
+        CMix_ControlUpdate(&ctx);
+    }
+    Test_Check(s_stub_duty_a == s_stub_duty_b, "difference inside the deadband: duty %u / %u ticks",
+               (unsigned)s_stub_duty_a, (unsigned)s_stub_duty_b);
+
+    Test_SetPhaseCurrents(0.30, 0.20);
+    for (i = 0U; i < 20U; ++i)
+    {
+        CMix_ControlUpdate(&ctx);
+    }
+    CMix_ControlNotifyFault(&ctx);
+    CMix_ControlUpdate(&ctx);
+    Test_Check(ctx.phase_trim == 0.0f, "fault clears the trim (%.4f)", (double)ctx.phase_trim);
+    Test_SetPhaseCurrents(0.0, 0.0);
+}
+#endif